@@ -0,0 +1,559 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+class AnimationBatch::BatchAnimator final : public Animator::Impl
+{
+public:
+    explicit BatchAnimator (AnimationBatch& b) : batch (&b) {}
+
+    void onStart (double) override {}
+    void onComplete() override {}
+
+    Animator::Status internalUpdate (double timestampMs) override
+    {
+        if (batch == nullptr)
+            return Animator::Status::finished;
+
+        batch->update (timestampMs);
+        return batch->isAnimating() ? Animator::Status::inProgress : Animator::Status::finished;
+    }
+
+    AnimationBatch* batch;
+};
+
+//==============================================================================
+struct AnimationBatch::RunningAnimations
+{
+    void add (int valueIndex, float startValue, float targetValue, double durationMs,
+              Point<float> controlPoint1, Point<float> controlPoint2)
+    {
+        // The x axis represents time, it's important this always stays in the range 0 - 1
+        jassert (isPositiveAndNotGreaterThan (controlPoint1.x, 1.0f));
+        jassert (isPositiveAndNotGreaterThan (controlPoint2.x, 1.0f));
+
+        valueIndices.push_back (valueIndex);
+        startTimes.push_back (std::numeric_limits<double>::quiet_NaN());
+        progressPerMs.push_back (durationMs > 0.0 ? 1.0 / durationMs : std::numeric_limits<double>::infinity());
+        startValues.push_back (startValue);
+        targetValues.push_back (targetValue);
+        progress.push_back (0.0f);
+        eased.push_back (0.0f);
+
+        // The same polynomial coefficients as chromium::gfx::CubicBezier
+        const auto addCoefficients = [] (auto& a, auto& b, auto& c, float p1, float p2)
+        {
+            c.push_back (3.0f * p1);
+            b.push_back (3.0f * (p2 - p1) - c.back());
+            a.push_back (1.0f - c.back() - b.back());
+        };
+
+        addCoefficients (ax, bx, cx, controlPoint1.x, controlPoint2.x);
+        addCoefficients (ay, by, cy, controlPoint1.y, controlPoint2.y);
+    }
+
+    void remove (size_t index)
+    {
+        forEachArray ([index] (auto& array)
+        {
+            array[index] = array.back();
+            array.pop_back();
+        });
+    }
+
+    void clear()
+    {
+        forEachArray ([] (auto& array) { array.clear(); });
+    }
+
+    size_t size() const noexcept     { return valueIndices.size(); }
+
+    void updateProgress (double timestampMs)
+    {
+        const auto num = size();
+
+        for (size_t i = 0; i < num; ++i)
+            if (std::isnan (startTimes[i]))
+                startTimes[i] = timestampMs;
+
+        for (size_t i = 0; i < num; ++i)
+            progress[i] = (float) std::clamp ((timestampMs - startTimes[i]) * progressPerMs[i], 0.0, 1.0);
+
+        ease (num);
+    }
+
+    template <typename Fn>
+    void forEachArray (Fn&& fn)
+    {
+        fn (valueIndices);
+        fn (startTimes); fn (progressPerMs);
+        fn (startValues); fn (targetValues); fn (progress); fn (eased);
+        fn (ax); fn (bx); fn (cx);
+        fn (ay); fn (by); fn (cy);
+    }
+
+    std::vector<int> valueIndices;
+    std::vector<double> startTimes, progressPerMs;
+    std::vector<float> startValues, targetValues, progress, eased;
+    std::vector<float> ax, bx, cx, ay, by, cy;
+
+private:
+    using Lanes = detail::SIMDFloat4;
+    static constexpr auto numLanes = (size_t) Lanes::size;
+
+    // Finds the point on each curve whose x is the progress, and returns its y. Rather than
+    // iterating until each one converges, every curve gets a fixed number of bisection steps
+    // followed by a couple of Newton-Raphson steps, so that several curves can be worked out
+    // together without any branches. GCC won't vectorise a loop like this by itself, because
+    // of the comparisons, so easeLanes() does it explicitly.
+    void ease (size_t num)
+    {
+        size_t i = 0;
+
+        for (; i + numLanes <= num; i += numLanes)
+            easeLanes (progress.data() + i, ax.data() + i, bx.data() + i, cx.data() + i,
+                       ay.data() + i, by.data() + i, cy.data() + i, eased.data() + i);
+
+        if (i == num)
+            return;
+
+        // The last few curves are copied into a full set of lanes, and the spare lanes are
+        // left as flat curves with no progress, which ease to zero
+        std::array<std::array<float, numLanes>, 8> padded{};
+        const std::vector<float>* sources[] { &progress, &ax, &bx, &cx, &ay, &by, &cy };
+
+        for (size_t s = 0; s < std::size (sources); ++s)
+            std::copy (sources[s]->begin() + (ptrdiff_t) i, sources[s]->begin() + (ptrdiff_t) num, padded[s].begin());
+
+        easeLanes (padded[0].data(), padded[1].data(), padded[2].data(), padded[3].data(),
+                   padded[4].data(), padded[5].data(), padded[6].data(), padded[7].data());
+
+        std::copy (padded[7].begin(), padded[7].begin() + (ptrdiff_t) (num - i), eased.begin() + (ptrdiff_t) i);
+    }
+
+    static void easeLanes (const float* px, const float* pax, const float* pbx, const float* pcx,
+                           const float* pay, const float* pby, const float* pcy, float* out) noexcept
+    {
+        const auto x = Lanes::load (px), a = Lanes::load (pax), b = Lanes::load (pbx), c = Lanes::load (pcx);
+        auto low = Lanes::expand (0.0f), high = Lanes::expand (1.0f);
+
+        for (int step = 0; step < 8; ++step)
+        {
+            const auto t = (low + high) * 0.5f;
+            const auto curveX = ((a * t + b) * t + c) * t;
+            low  = selectWhereLess (curveX, x, t, low);
+            high = selectWhereLess (curveX, x, high, t);
+        }
+
+        auto t = (low + high) * 0.5f;
+        const auto minSlope = Lanes::expand (1.0e-6f);
+
+        for (int step = 0; step < 2; ++step)
+        {
+            const auto error = ((a * t + b) * t + c) * t - x;
+            const auto slope = (3.0f * a * t + 2.0f * b) * t + c;
+            const auto newT = t - error / selectWhereLess (minSlope, abs (slope), slope, Lanes::expand (1.0f));
+            t = min (max (selectWhereLess (minSlope, abs (slope), newT, t), low), high);
+        }
+
+        const auto y = ((Lanes::load (pay) * t + Lanes::load (pby)) * t + Lanes::load (pcy)) * t;
+        const auto zero = Lanes::expand (0.0f), one = Lanes::expand (1.0f);
+        selectWhereLess (x, one, selectWhereLess (zero, x, y, zero), one).store (out);
+    }
+};
+
+//==============================================================================
+AnimationBatch::AnimationBatch (Component* componentToRepaint)
+    : component (componentToRepaint),
+      running (std::make_unique<RunningAnimations>()),
+      animatorImpl (std::make_shared<BatchAnimator> (*this)),
+      animator (animatorImpl)
+{
+}
+
+AnimationBatch::~AnimationBatch()
+{
+    animatorImpl->batch = nullptr;
+}
+
+int AnimationBatch::addValue (float initialValue, Rectangle<int> areaToRepaint)
+{
+    values.push_back (initialValue);
+    areas.push_back (areaToRepaint);
+    runningIndexForValue.push_back (-1);
+    return (int) values.size() - 1;
+}
+
+int AnimationBatch::getNumValues() const noexcept
+{
+    return (int) values.size();
+}
+
+void AnimationBatch::clear()
+{
+    values.clear();
+    areas.clear();
+    runningIndexForValue.clear();
+    running->clear();
+}
+
+void AnimationBatch::setAreaToRepaint (int index, Rectangle<int> areaToRepaint)
+{
+    jassert (isPositiveAndBelow (index, getNumValues()));
+    areas[(size_t) index] = areaToRepaint;
+}
+
+float AnimationBatch::getValue (int index) const noexcept
+{
+    jassert (isPositiveAndBelow (index, getNumValues()));
+    return values[(size_t) index];
+}
+
+float AnimationBatch::getTargetValue (int index) const noexcept
+{
+    jassert (isPositiveAndBelow (index, getNumValues()));
+
+    if (const auto runningIndex = runningIndexForValue[(size_t) index]; runningIndex >= 0)
+        return running->targetValues[(size_t) runningIndex];
+
+    return values[(size_t) index];
+}
+
+void AnimationBatch::setValue (int index, float newValue)
+{
+    jassert (isPositiveAndBelow (index, getNumValues()));
+    stopAnimating (index);
+
+    if (exactlyEqual (std::exchange (values[(size_t) index], newValue), newValue))
+        return;
+
+    if (component != nullptr)
+        component->repaint (getAreaToRepaint (index));
+}
+
+void AnimationBatch::animateTo (int index, float targetValue, double durationMs)
+{
+    animateTo (index, targetValue, durationMs, { 0.25f, 0.1f }, { 0.25f, 1.0f });
+}
+
+void AnimationBatch::animateTo (int index, float targetValue, double durationMs,
+                                Point<float> controlPoint1, Point<float> controlPoint2)
+{
+    jassert (isPositiveAndBelow (index, getNumValues()));
+    stopAnimating (index);
+
+    runningIndexForValue[(size_t) index] = (int) running->size();
+    running->add (index, values[(size_t) index], targetValue, durationMs, controlPoint1, controlPoint2);
+    animator.start();
+}
+
+bool AnimationBatch::isAnimating (int index) const noexcept
+{
+    jassert (isPositiveAndBelow (index, getNumValues()));
+    return runningIndexForValue[(size_t) index] >= 0;
+}
+
+bool AnimationBatch::isAnimating() const noexcept
+{
+    return running->size() > 0;
+}
+
+Rectangle<int> AnimationBatch::update (double timestampMs)
+{
+    Rectangle<int> areaToRepaint;
+
+    if (running->size() == 0)
+        return areaToRepaint;
+
+    running->updateProgress (timestampMs);
+
+    // Going backwards, so that removing a finished animation only moves one that's been done already
+    for (auto i = running->size(); i-- > 0;)
+    {
+        const auto index = (size_t) running->valueIndices[i];
+        const auto start = running->startValues[i];
+        const auto finished = running->progress[i] >= 1.0f;
+
+        const auto newValue = finished ? running->targetValues[i]
+                                       : start + (running->targetValues[i] - start) * running->eased[i];
+
+        if (! exactlyEqual (std::exchange (values[index], newValue), newValue))
+            areaToRepaint = areaToRepaint.getUnion (getAreaToRepaint ((int) index));
+
+        if (finished)
+        {
+            runningIndexForValue[index] = -1;
+            running->remove (i);
+
+            if (i < running->size())
+                runningIndexForValue[(size_t) running->valueIndices[i]] = (int) i;
+        }
+    }
+
+    if (component != nullptr && ! areaToRepaint.isEmpty())
+        component->repaint (areaToRepaint);
+
+    return areaToRepaint;
+}
+
+Animator AnimationBatch::getAnimator() const
+{
+    return animator;
+}
+
+void AnimationBatch::stopAnimating (int index)
+{
+    const auto runningIndex = std::exchange (runningIndexForValue[(size_t) index], -1);
+
+    if (runningIndex < 0)
+        return;
+
+    running->remove ((size_t) runningIndex);
+
+    if ((size_t) runningIndex < running->size())
+        runningIndexForValue[(size_t) running->valueIndices[(size_t) runningIndex]] = runningIndex;
+}
+
+Rectangle<int> AnimationBatch::getAreaToRepaint (int index) const
+{
+    const auto& area = areas[(size_t) index];
+
+    if (area.isEmpty() && component != nullptr)
+        return component->getLocalBounds();
+
+    return area;
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct AnimationBatchTests final : public UnitTest
+{
+    AnimationBatchTests()
+        : UnitTest ("AnimationBatch", UnitTestCategories::gui)
+    {
+    }
+
+    void runTest() override
+    {
+        beginTest ("Eased values follow Easings::createCubicBezier");
+        {
+            const std::vector<std::pair<Point<float>, Point<float>>> curves { { { 0.25f, 0.1f }, { 0.25f, 1.0f } },
+                                                                                { { 0.42f, 0.0f }, { 1.0f, 1.0f } },
+                                                                                { { 0.0f, 0.0f }, { 0.58f, 1.0f } },
+                                                                                { { 0.34f, 1.56f }, { 0.64f, 1.0f } },
+                                                                                { { 0.65f, 0.0f }, { 0.35f, 1.0f } },
+                                                                                { { 0.0f, 1.0f }, { 1.0f, 0.0f } } };
+
+            for (const auto& [cp1, cp2] : curves)
+            {
+                AnimationBatch batch;
+                const auto easing = Easings::createCubicBezier (cp1, cp2);
+
+                for (int i = 0; i <= 100; ++i)
+                {
+                    batch.addValue (0.0f);
+                    batch.animateTo (i, 1000.0f, 1000.0, cp1, cp2);
+                }
+
+                batch.update (0.0);
+
+                for (int i = 0; i <= 100; ++i)
+                    expectEquals (batch.getValue (i), 0.0f);
+
+                for (double time = 10.0; time < 1000.0; time += 10.0)
+                {
+                    batch.update (time);
+                    const auto expected = 1000.0f * easing ((float) time / 1000.0f);
+
+                    for (int i = 0; i <= 100; ++i)
+                        expectWithinAbsoluteError (batch.getValue (i), expected, 0.05f);
+                }
+
+                batch.update (1000.0);
+                expect (! batch.isAnimating());
+
+                for (int i = 0; i <= 100; ++i)
+                    expectEquals (batch.getValue (i), 1000.0f);
+            }
+        }
+
+        beginTest ("Animations can be replaced and stopped while others are running");
+        {
+            AnimationBatch batch;
+
+            for (int i = 0; i < 10; ++i)
+            {
+                batch.addValue ((float) i);
+                batch.animateTo (i, (float) i + 10.0f, 100.0 * (i + 1), {}, { 1.0f, 1.0f });
+            }
+
+            batch.update (0.0);
+            batch.update (50.0);
+            expectWithinAbsoluteError (batch.getValue (0), 5.0f, 0.001f);
+            expectWithinAbsoluteError (batch.getValue (9), 9.5f, 0.001f);
+
+            batch.setValue (3, -1.0f);
+            expect (! batch.isAnimating (3));
+            expectEquals (batch.getTargetValue (3), -1.0f);
+
+            batch.animateTo (5, 0.0f, 100.0, {}, { 1.0f, 1.0f });
+            expectEquals (batch.getTargetValue (5), 0.0f);
+
+            batch.update (100.0);
+            expect (! batch.isAnimating (0));
+            expectEquals (batch.getValue (0), 10.0f);
+            expectEquals (batch.getValue (3), -1.0f);
+            expectWithinAbsoluteError (batch.getValue (5), 5.0f + 10.0f * 50.0f / 600.0f, 0.001f);
+
+            for (auto time = 150.0; batch.isAnimating(); time += 50.0)
+                batch.update (time);
+
+            for (int i = 0; i < 10; ++i)
+                expectEquals (batch.getValue (i), i == 3 ? -1.0f : (i == 5 ? 0.0f : (float) i + 10.0f));
+        }
+
+        beginTest ("Changed values are repainted as a single region");
+        {
+            AnimationBatch batch;
+
+            for (int i = 0; i < 4; ++i)
+                batch.addValue (0.0f, { i * 10, 0, 10, 10 });
+
+            batch.animateTo (1, 1.0f, 100.0);
+            batch.animateTo (2, 1.0f, 100.0);
+            expect (batch.update (0.0).isEmpty());
+            expect (batch.update (50.0) == Rectangle<int> (10, 0, 20, 10));
+
+            batch.setValue (1, 0.0f);
+            expect (batch.update (60.0) == Rectangle<int> (20, 0, 10, 10));
+        }
+
+        beginTest ("The animator runs until all the values have finished");
+        {
+            AnimationBatch batch;
+            AnimatorUpdater updater;
+            updater.addAnimator (batch.getAnimator());
+
+            batch.addValue (0.0f);
+            updater.update (0.0);
+            expect (! batch.isAnimating());
+
+            batch.animateTo (0, 1.0f, 100.0);
+            updater.update (10.0);
+            updater.update (60.0);
+            expect (batch.isAnimating());
+            expect (batch.getValue (0) > 0.0f);
+
+            updater.update (110.0);
+            expect (! batch.isAnimating());
+            expectEquals (batch.getValue (0), 1.0f);
+
+            batch.animateTo (0, 0.0f, 100.0);
+            updater.update (200.0);
+            updater.update (250.0);
+            expect (batch.getValue (0) < 1.0f);
+        }
+    }
+};
+
+static AnimationBatchTests animationBatchTests;
+
+//==============================================================================
+class AnimationBatchBenchmarks final : public UnitTest
+{
+public:
+    AnimationBatchBenchmarks()
+        : UnitTest ("AnimationBatch benchmarks", UnitTestCategories::benchmarks)
+    {
+    }
+
+    void runTest() override
+    {
+        beginTest ("Updating many animations");
+
+        constexpr int numAnimations = 2000;
+        constexpr int numFrames = 60;
+        std::vector<float> targets (numAnimations);
+
+        {
+            AnimatorUpdater updater;
+            std::vector<Animator> animators;
+
+            for (int i = 0; i < numAnimations; ++i)
+            {
+                animators.push_back (ValueAnimatorBuilder{}.withDurationMs (10000.0)
+                                                           .withValueChangedCallback ([&targets, i] (float v) { targets[(size_t) i] = v; })
+                                                           .build());
+                updater.addAnimator (animators.back());
+                animators.back().start();
+            }
+
+            logMessage ("ValueAnimators: " + String (timeFrames (numFrames, [&] (double t) { updater.update (t); }), 2) + " us per frame");
+        }
+
+        {
+            AnimationBatch batch;
+
+            for (int i = 0; i < numAnimations; ++i)
+            {
+                batch.addValue (0.0f);
+                batch.animateTo (i, 1.0f, 10000.0);
+            }
+
+            logMessage ("AnimationBatch: " + String (timeFrames (numFrames, [&] (double t) { batch.update (t); }), 2) + " us per frame");
+        }
+    }
+
+private:
+    template <typename Fn>
+    static double timeFrames (int numFrames, Fn&& updateFrame)
+    {
+        const auto start = Time::getMillisecondCounterHiRes();
+
+        for (int frame = 0; frame < numFrames; ++frame)
+            updateFrame (frame * 16.667);
+
+        return (Time::getMillisecondCounterHiRes() - start) * 1000.0 / numFrames;
+    }
+};
+
+static AnimationBatchBenchmarks animationBatchBenchmarks;
+
+#endif
+
+} // namespace juce
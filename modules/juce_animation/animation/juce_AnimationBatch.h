@@ -0,0 +1,193 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Animates a large number of float values together, keeping their state in contiguous arrays
+    and easing all of them in a single pass.
+
+    Each Animator built by a ValueAnimatorBuilder calls its own easing function and value-changed
+    callback, and will usually trigger its own repaint. That's fine for a handful of animations,
+    but when hundreds of them run at once, say for a grid of LEDs or meters that are all drawn by
+    one component, most of the time goes into those calls. An AnimationBatch instead stores the
+    state of its animations side by side, evaluates their easing curves several at a time with
+    SIMD instructions, and then makes a single call to Component::repaint() with the
+    union of the areas of all the values that changed.
+
+    The easing of each animation is a cubic Bezier curve, in the same form as those returned by
+    Easings::createCubicBezier(). The default is the curve used by Easings::createEase().
+
+    To drive the animations, register the Animator returned by getAnimator() with an
+    AnimatorUpdater or VBlankAnimatorUpdater, or call update() yourself.
+
+    @code
+    struct LedGrid : public Component
+    {
+        LedGrid()
+        {
+            for (int i = 0; i < 256; ++i)
+                brightness.addValue (0.0f, getLedArea (i));
+
+            updater.addAnimator (brightness.getAnimator());
+        }
+
+        void flash (int led)
+        {
+            brightness.setValue (led, 1.0f);
+            brightness.animateTo (led, 0.0f, 500.0);
+        }
+
+        void paint (Graphics& g) override
+        {
+            for (int i = 0; i < brightness.getNumValues(); ++i)
+            {
+                g.setColour (Colours::red.withAlpha (brightness.getValue (i)));
+                g.fillEllipse (getLedArea (i).toFloat());
+            }
+        }
+
+        AnimationBatch brightness { this };
+        VBlankAnimatorUpdater updater { this };
+    };
+    @endcode
+
+    @see ValueAnimatorBuilder, AnimatorUpdater
+
+    @tags{Animations}
+*/
+class JUCE_API  AnimationBatch
+{
+public:
+    /** Creates an empty batch.
+
+        If a component is supplied, each call to update() will repaint the areas of it that belong
+        to the values that changed.
+    */
+    explicit AnimationBatch (Component* componentToRepaint = nullptr);
+
+    /** Destructor. */
+    ~AnimationBatch();
+
+    //==============================================================================
+    /** Adds a value to the batch, and returns its index.
+
+        When the value changes, the given area of the component is repainted. If the area is
+        empty, the whole component is repainted.
+    */
+    int addValue (float initialValue, Rectangle<int> areaToRepaint = {});
+
+    /** Returns the number of values that have been added. */
+    int getNumValues() const noexcept;
+
+    /** Removes all the values, stopping any animations. */
+    void clear();
+
+    /** Changes the area that's repainted when a value changes. */
+    void setAreaToRepaint (int index, Rectangle<int> areaToRepaint);
+
+    //==============================================================================
+    /** Returns the current value at the given index. */
+    float getValue (int index) const noexcept;
+
+    /** Returns the value that an animation is heading towards, or the current value if it isn't
+        being animated.
+    */
+    float getTargetValue (int index) const noexcept;
+
+    /** Stops any animation of a value, and jumps straight to a new one. */
+    void setValue (int index, float newValue);
+
+    /** Starts animating a value from wherever it is now towards a new target.
+
+        The animation starts at the next update, and takes the given time to reach the target,
+        following the curve used by Easings::createEase(). If the value was already being
+        animated, the new animation replaces the old one.
+    */
+    void animateTo (int index, float targetValue, double durationMs);
+
+    /** Starts animating a value from wherever it is now towards a new target, following a cubic
+        Bezier curve with the given control points.
+
+        @see Easings::createCubicBezier
+    */
+    void animateTo (int index, float targetValue, double durationMs,
+                    Point<float> controlPoint1, Point<float> controlPoint2);
+
+    /** Returns true if the value at this index is being animated. */
+    bool isAnimating (int index) const noexcept;
+
+    /** Returns true if any of the values are being animated. */
+    bool isAnimating() const noexcept;
+
+    //==============================================================================
+    /** Moves all of the running animations on to the given time.
+
+        If the batch has a component, this repaints the area belonging to any of the values that
+        changed. The area is also returned, so that you can repaint it yourself.
+
+        The timestamps must be monotonically increasing. When the batch is being driven by an
+        AnimatorUpdater you don't need to call this yourself.
+    */
+    Rectangle<int> update (double timestampMs);
+
+    /** Returns an Animator which updates this batch.
+
+        The Animator only holds a weak reference to the batch, and it starts itself whenever
+        animateTo() is called, so it can be added to an AnimatorUpdater once and left there.
+    */
+    Animator getAnimator() const;
+
+private:
+    //==============================================================================
+    class BatchAnimator;
+    struct RunningAnimations;
+
+    void stopAnimating (int index);
+    Rectangle<int> getAreaToRepaint (int index) const;
+
+    Component::SafePointer<Component> component;
+    std::vector<float> values;
+    std::vector<Rectangle<int>> areas;
+    std::vector<int> runningIndexForValue;
+    std::unique_ptr<RunningAnimations> running;
+    std::shared_ptr<BatchAnimator> animatorImpl;
+    Animator animator;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AnimationBatch)
+};
+
+} // namespace juce
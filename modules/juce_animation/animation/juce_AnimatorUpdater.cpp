@@ -61,6 +61,12 @@ void AnimatorUpdater::removeAnimator (const Animator& animator)
     }
 }
 
+void AnimatorUpdater::setFrameTimeBudgetMs (double budgetMs)
+{
+    jassert (budgetMs >= 0.0);
+    frameTimeBudgetMs = jmax (0.0, budgetMs);
+}
+
 void AnimatorUpdater::update()
 {
     update (Time::getMillisecondCounterHiRes());
@@ -78,14 +84,43 @@ void AnimatorUpdater::update (double timestampMs)
     }
 
     const ScopedValueSetter setter { reentrancyGuard, true };
+    const auto frameStartMs = Time::getMillisecondCounterHiRes();
+    auto numUpdated = 0;
+    auto overBudget = false;
+
+    // If the previous frame ran out of time, start with the Animators that it didn't get to,
+    // then wrap around to the ones before them.
+    const auto firstKey = std::exchange (nextKeyToUpdate, nullptr);
+    auto wrapped = firstKey == nullptr;
 
-    for (currentIterator = animators.begin(); currentIterator != animators.end();)
+    for (currentIterator = animators.lower_bound (firstKey);;)
     {
+        if (currentIterator == animators.end())
+        {
+            if (std::exchange (wrapped, true))
+                break;
+
+            currentIterator = animators.begin();
+            continue;
+        }
+
+        if (wrapped && firstKey != nullptr && ! std::less<void*>{} (currentIterator->first, firstKey))
+            break;
+
+        if (frameTimeBudgetMs > 0.0 && numUpdated > 0
+             && Time::getMillisecondCounterHiRes() - frameStartMs > frameTimeBudgetMs)
+        {
+            nextKeyToUpdate = currentIterator->first;
+            overBudget = true;
+            break;
+        }
+
         auto& current = *currentIterator;
 
         if (const auto locked = current.second.animator.lock())
         {
             iteratorServiced = true;
+            ++numUpdated;
 
             if (locked->update (timestampMs) == Animator::Status::finished)
                 NullCheckedInvocation::invoke (current.second.onComplete);
@@ -98,6 +133,78 @@ void AnimatorUpdater::update (double timestampMs)
             currentIterator = animators.erase (currentIterator);
         }
     }
+
+    const auto frameMs = Time::getMillisecondCounterHiRes() - frameStartMs;
+
+    ++statistics.numFrames;
+    statistics.numFramesOverBudget += overBudget ? 1 : 0;
+    statistics.numAnimatorsUpdated = numUpdated;
+    statistics.lastFrameMs = frameMs;
+    statistics.maxFrameMs = jmax (statistics.maxFrameMs, frameMs);
+    statistics.totalFrameMs += frameMs;
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct AnimatorUpdaterTests final : public UnitTest
+{
+    AnimatorUpdaterTests()
+        : UnitTest ("AnimatorUpdater", UnitTestCategories::gui)
+    {
+    }
+
+    void runTest() override
+    {
+        beginTest ("Animators left over when the frame budget runs out are updated first in the next frame");
+        {
+            constexpr int numAnimators = 5;
+            std::vector<int> numUpdates (numAnimators);
+            std::vector<Animator> animators;
+            AnimatorUpdater updater;
+
+            for (int i = 0; i < numAnimators; ++i)
+            {
+                animators.push_back (ValueAnimatorBuilder{}.runningInfinitely()
+                                                           .withValueChangedCallback ([&numUpdates, i] (float)
+                                                           {
+                                                               ++numUpdates[(size_t) i];
+                                                               Thread::sleep (2);
+                                                           })
+                                                           .build());
+                updater.addAnimator (animators.back());
+                animators.back().start();
+            }
+
+            updater.update (0.0);
+            expectEquals (updater.getFrameStatistics().numAnimatorsUpdated, numAnimators);
+            expectEquals (updater.getFrameStatistics().numFramesOverBudget, (int64) 0);
+
+            updater.setFrameTimeBudgetMs (0.5);
+
+            for (int frame = 1; frame <= 2 * numAnimators; ++frame)
+            {
+                updater.update (frame * 16.0);
+                expectEquals (updater.getFrameStatistics().numAnimatorsUpdated, 1);
+            }
+
+            for (auto n : numUpdates)
+                expectEquals (n, 3);
+
+            const auto& stats = updater.getFrameStatistics();
+            expectEquals (stats.numFrames, (int64) (2 * numAnimators + 1));
+            expectEquals (stats.numFramesOverBudget, (int64) (2 * numAnimators));
+            expect (stats.maxFrameMs >= stats.getAverageFrameMs());
+            expect (stats.getAverageFrameMs() > 0.0);
+
+            updater.resetFrameStatistics();
+            expectEquals (updater.getFrameStatistics().numFrames, (int64) 0);
+        }
+    }
+};
+
+static AnimatorUpdaterTests animatorUpdaterTests;
+
+#endif
+
 } // namespace juce
@@ -98,6 +98,60 @@ public:
     */
     void update (double timestampMs);
 
+    //==============================================================================
+    /** Sets the longest time that a call to update() should spend updating Animators.
+
+        If updating takes longer than this, the remaining Animators are left until the next
+        update, which will start with them, so that when there are more Animators than can be
+        updated in a single frame each one still gets updated regularly. Animators work out their
+        progress from the timestamp, so one that misses a frame just jumps a little further at the
+        next one.
+
+        A budget of zero, which is the default, means that every Animator is always updated.
+
+        @see getFrameStatistics
+    */
+    void setFrameTimeBudgetMs (double budgetMs);
+
+    /** Returns the budget set by setFrameTimeBudgetMs(). */
+    double getFrameTimeBudgetMs() const noexcept            { return frameTimeBudgetMs; }
+
+    /** Timing information about the calls that have been made to update().
+
+        @see getFrameStatistics
+    */
+    struct FrameStatistics
+    {
+        /** The number of calls to update(). */
+        int64 numFrames = 0;
+
+        /** The number of calls to update() that ran out of time before all the Animators had
+            been updated.
+        */
+        int64 numFramesOverBudget = 0;
+
+        /** The number of Animators that were updated by the most recent call to update(). */
+        int numAnimatorsUpdated = 0;
+
+        /** The time in milliseconds that the most recent call to update() took. */
+        double lastFrameMs = 0.0;
+
+        /** The time in milliseconds of the slowest call to update(). */
+        double maxFrameMs = 0.0;
+
+        /** The total time in milliseconds spent in update(). */
+        double totalFrameMs = 0.0;
+
+        /** Returns the average time in milliseconds that each call to update() took. */
+        double getAverageFrameMs() const noexcept           { return numFrames > 0 ? totalFrameMs / (double) numFrames : 0.0; }
+    };
+
+    /** Returns timing information about the calls that have been made to update(). */
+    const FrameStatistics& getFrameStatistics() const noexcept { return statistics; }
+
+    /** Clears the information returned by getFrameStatistics(). */
+    void resetFrameStatistics() noexcept                    { statistics = {}; }
+
 private:
     struct JUCE_API  Entry
     {
@@ -117,6 +171,10 @@ private:
 
     bool iteratorServiced = false;
     bool reentrancyGuard = false;
+
+    double frameTimeBudgetMs = 0.0;
+    void* nextKeyToUpdate = nullptr;
+    FrameStatistics statistics;
 };
 
 } // namespace juce
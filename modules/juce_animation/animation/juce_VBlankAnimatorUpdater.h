@@ -55,6 +55,8 @@ public:
     }
 
     using AnimatorUpdater::addAnimator, AnimatorUpdater::removeAnimator;
+    using AnimatorUpdater::setFrameTimeBudgetMs, AnimatorUpdater::getFrameTimeBudgetMs;
+    using AnimatorUpdater::FrameStatistics, AnimatorUpdater::getFrameStatistics, AnimatorUpdater::resetFrameStatistics;
 
 private:
     VBlankAttachment vBlankAttachment;
@@ -43,6 +43,7 @@
 
 //==============================================================================
 #include "juce_animation.h"
+#include <juce_graphics/detail/juce_SIMDFloat4.h>
 
 //==============================================================================
 namespace chromium
@@ -64,6 +65,7 @@ JUCE_END_IGNORE_WARNINGS_GCC_LIKE
 
 //==============================================================================
 #include "animation/juce_Animator.cpp"
+#include "animation/juce_AnimationBatch.cpp"
 #include "animation/juce_AnimatorSetBuilder.cpp"
 #include "animation/juce_AnimatorUpdater.cpp"
 #include "animation/juce_Easings.cpp"
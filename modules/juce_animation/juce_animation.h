@@ -68,6 +68,7 @@
 
 //==============================================================================
 #include "animation/juce_Animator.h"
+#include "animation/juce_AnimationBatch.h"
 #include "animation/juce_AnimatorSetBuilder.h"
 #include "animation/juce_AnimatorUpdater.h"
 #include "animation/juce_Easings.h"
@@ -1180,6 +1180,51 @@ namespace
        #endif
     }
 
+    forcedinline int convertFloatToFixed (float sample) noexcept
+    {
+        if (sample >= 1.0f)
+            return std::numeric_limits<int>::max();
+
+        if (! (sample > -1.0f))
+            return std::numeric_limits<int>::min();
+
+        return roundToInt ((double) sample * 2147483648.0);
+    }
+
+    template <typename Size>
+    void convertFloatToFixed (int* dest, const float* src, Size num) noexcept
+    {
+        // Scaling by 2^31 is exact, and every version rounds halves to even as roundToInt()
+        // does, so the vector and scalar versions give the same results
+       #if JUCE_USE_SSE_INTRINSICS
+        const auto lowest = _mm_set1_ps (-1.0f);
+        const auto scale = _mm_set1_ps (2147483648.0f);
+
+        for (; num >= 4; num -= 4, src += 4, dest += 4)
+        {
+            const auto scaled = _mm_mul_ps (_mm_max_ps (_mm_loadu_ps (src), lowest), scale);
+
+            // Anything that's out of range converts to 0x80000000, so flip the bits of
+            // the positive ones to get 0x7fffffff instead
+            const auto tooHigh = _mm_castps_si128 (_mm_cmpge_ps (scaled, scale));
+            _mm_storeu_si128 (reinterpret_cast<__m128i*> (dest), _mm_xor_si128 (_mm_cvtps_epi32 (scaled), tooHigh));
+        }
+       #elif JUCE_USE_ARM_NEON && JUCE_64BIT
+        // 32-bit ARM has no conversion that rounds to nearest, so it uses the scalar loop
+        const auto lowest = vdupq_n_f32 (-1.0f);
+
+        for (; num >= 4; num -= 4, src += 4, dest += 4)
+        {
+            // The conversion saturates, so anything that's out of range becomes 0x7fffffff
+            const auto scaled = vmulq_n_f32 (vmaxq_f32 (vld1q_f32 (src), lowest), 2147483648.0f);
+            vst1q_s32 (dest, vcvtnq_s32_f32 (scaled));
+        }
+       #endif
+
+        for (; num > 0; --num)
+            *dest++ = convertFloatToFixed (*src++);
+    }
+
 } // namespace
 } // namespace FloatVectorHelpers
 
@@ -1435,6 +1480,16 @@ void JUCE_CALLTYPE FloatVectorOperations::convertFixedToFloat (float* dest, cons
     FloatVectorHelpers::convertFixedToFloat (dest, src, multiplier, num);
 }
 
+void JUCE_CALLTYPE FloatVectorOperations::convertFloatToFixed (int* dest, const float* src, size_t num) noexcept
+{
+    FloatVectorHelpers::convertFloatToFixed (dest, src, num);
+}
+
+void JUCE_CALLTYPE FloatVectorOperations::convertFloatToFixed (int* dest, const float* src, int num) noexcept
+{
+    FloatVectorHelpers::convertFloatToFixed (dest, src, num);
+}
+
 intptr_t JUCE_CALLTYPE FloatVectorOperations::getFpStatusRegister() noexcept
 {
     intptr_t fpsr = 0;
@@ -1663,6 +1718,31 @@ public:
             FloatVectorOperations::convertFixedToFloat (data1, int1, 2.0f, num);
             convertFixed (data2, int1, 2.0f, num);
             u.expect (buffersMatch (data1, data2, num));
+
+            // Values from -2 to 2, so that some of them need clipping
+            FloatVectorOperations::convertFixedToFloat (data1, int1, 1.0f / (float) (1 << 30), num);
+            data1[0] = 1.0f;
+            data1[num - 1] = -1.0f;
+
+            HeapBlock<int> int2 (num), int3 (num);
+            FloatVectorOperations::convertFloatToFixed (int2, data1, num);
+
+            for (int i = 0; i < num; ++i)
+                int3[i] = data1[i] >= 1.0f ? std::numeric_limits<int>::max()
+                                           : (data1[i] <= -1.0f ? std::numeric_limits<int>::min()
+                                                                : roundToInt ((double) data1[i] * 2147483648.0));
+
+            u.expect (std::equal (int2.get(), int2 + num, int3.get()));
+
+            // Each of these lands exactly half-way between two ints once it's scaled
+            static constexpr auto halfStep = 1.0f / 4294967296.0f;
+            static constexpr float ties[] { halfStep, 3 * halfStep, 5 * halfStep, 7 * halfStep,
+                                            -halfStep, -3 * halfStep, -5 * halfStep, -7 * halfStep };
+            static constexpr int roundedTies[] { 0, 2, 2, 4, 0, -2, -2, -4 };
+            int converted[std::size (ties)];
+
+            FloatVectorOperations::convertFloatToFixed (converted, ties, (int) std::size (ties));
+            u.expect (std::equal (std::begin (converted), std::end (converted), std::begin (roundedTies)));
         }
 
         static void doConversionTest (UnitTest&, double*, double*, int*, int) {}
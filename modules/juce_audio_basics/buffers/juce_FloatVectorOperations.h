@@ -199,6 +199,16 @@ public:
 
     static void JUCE_CALLTYPE convertFixedToFloat (float* dest, const int* src, float multiplier, size_t num) noexcept;
 
+    /** Converts floating-point samples to 32-bit fixed-point, clipping them to the range
+        -1.0 to 1.0 and then scaling that to the full range of an int.
+    */
+    static void JUCE_CALLTYPE convertFloatToFixed (int* dest, const float* src, int num) noexcept;
+
+    /** Converts floating-point samples to 32-bit fixed-point, clipping them to the range
+        -1.0 to 1.0 and then scaling that to the full range of an int.
+    */
+    static void JUCE_CALLTYPE convertFloatToFixed (int* dest, const float* src, size_t num) noexcept;
+
     /** This method enables or disables the SSE/NEON flush-to-zero mode. */
     static void JUCE_CALLTYPE enableFlushToZeroMode (bool shouldEnable) noexcept;
 
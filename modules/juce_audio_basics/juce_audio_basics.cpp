@@ -99,6 +99,7 @@
 #include "sources/juce_ReverbAudioSource.cpp"
 #include "sources/juce_ToneGeneratorAudioSource.cpp"
 #include "sources/juce_PositionableAudioSource.cpp"
+#include "sources/juce_ReadAheadScheduler.cpp"
 #include "synthesisers/juce_Synthesiser.cpp"
 #include "audio_play_head/juce_AudioPlayHead.cpp"
 #include "utilities/juce_AudioWorkgroup.cpp"
@@ -124,6 +124,7 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "mpe/juce_MPEUtils.h"
 #include "sources/juce_AudioSource.h"
 #include "sources/juce_PositionableAudioSource.h"
+#include "sources/juce_ReadAheadScheduler.h"
 #include "sources/juce_BufferingAudioSource.h"
 #include "sources/juce_ChannelRemappingAudioSource.h"
 #include "sources/juce_IIRFilterAudioSource.h"
@@ -41,8 +41,32 @@ BufferingAudioSource::BufferingAudioSource (PositionableAudioSource* s,
                                             int bufferSizeSamples,
                                             int numChannels,
                                             bool prefillBufferOnPrepareToPlay)
+    : BufferingAudioSource (s, &thread, nullptr, deleteSourceWhenDeleted,
+                            bufferSizeSamples, numChannels, prefillBufferOnPrepareToPlay)
+{
+}
+
+BufferingAudioSource::BufferingAudioSource (PositionableAudioSource* s,
+                                            ReadAheadScheduler& readAheadScheduler,
+                                            bool deleteSourceWhenDeleted,
+                                            int bufferSizeSamples,
+                                            int numChannels,
+                                            bool prefillBufferOnPrepareToPlay)
+    : BufferingAudioSource (s, nullptr, &readAheadScheduler, deleteSourceWhenDeleted,
+                            bufferSizeSamples, numChannels, prefillBufferOnPrepareToPlay)
+{
+}
+
+BufferingAudioSource::BufferingAudioSource (PositionableAudioSource* s,
+                                            TimeSliceThread* thread,
+                                            ReadAheadScheduler* readAheadScheduler,
+                                            bool deleteSourceWhenDeleted,
+                                            int bufferSizeSamples,
+                                            int numChannels,
+                                            bool prefillBufferOnPrepareToPlay)
     : source (s, deleteSourceWhenDeleted),
       backgroundThread (thread),
+      scheduler (readAheadScheduler),
       numberOfSamplesToBuffer (jmax (1024, bufferSizeSamples)),
       numberOfChannels (numChannels),
       prefillBuffer (prefillBufferOnPrepareToPlay)
@@ -67,7 +91,7 @@ void BufferingAudioSource::prepareToPlay (int samplesPerBlockExpected, double ne
          || bufferSizeNeeded != buffer.getNumSamples()
          || ! isPrepared)
     {
-        backgroundThread.removeTimeSliceClient (this);
+        stopBackgroundReading();
 
         isPrepared = true;
         sampleRate = newSampleRate;
@@ -82,13 +106,13 @@ void BufferingAudioSource::prepareToPlay (int samplesPerBlockExpected, double ne
         bufferValidStart = 0;
         bufferValidEnd = 0;
 
-        backgroundThread.addTimeSliceClient (this);
+        startBackgroundReading();
 
         do
         {
             const ScopedUnlock ul (bufferRangeLock);
 
-            backgroundThread.moveToFrontOfQueue (this);
+            prioritiseBackgroundReading();
             Thread::sleep (5);
         }
         while (prefillBuffer
@@ -99,7 +123,7 @@ void BufferingAudioSource::prepareToPlay (int samplesPerBlockExpected, double ne
 void BufferingAudioSource::releaseResources()
 {
     isPrepared = false;
-    backgroundThread.removeTimeSliceClient (this);
+    stopBackgroundReading();
 
     buffer.setSize (numberOfChannels, 0);
 
@@ -114,6 +138,9 @@ void BufferingAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& info
 {
     const auto bufferRange = getValidBufferRange (info.numSamples);
 
+    if (isPrepared)
+        reportUnderrun (info.numSamples - bufferRange.getLength());
+
     if (bufferRange.isEmpty())
     {
         // total cache miss
@@ -227,7 +254,7 @@ void BufferingAudioSource::setNextReadPosition (int64 newPosition)
     const ScopedLock sl (bufferRangeLock);
 
     nextPlayPos = newPosition;
-    backgroundThread.moveToFrontOfQueue (this);
+    prioritiseBackgroundReading();
 }
 
 Range<int> BufferingAudioSource::getValidBufferRange (int numSamples) const
@@ -240,7 +267,7 @@ Range<int> BufferingAudioSource::getValidBufferRange (int numSamples) const
              (int) (jlimit (bufferValidStart, bufferValidEnd, pos + numSamples) - pos) };
 }
 
-bool BufferingAudioSource::readNextBufferChunk()
+int BufferingAudioSource::readNextBufferChunk (int maxChunkSize)
 {
     int64 newBVS, newBVE, sectionToReadStart, sectionToReadEnd;
 
@@ -259,8 +286,6 @@ bool BufferingAudioSource::readNextBufferChunk()
         sectionToReadStart = 0;
         sectionToReadEnd = 0;
 
-        constexpr int maxChunkSize = 2048;
-
         if (newBVS < bufferValidStart || newBVS >= bufferValidEnd)
         {
             newBVE = jmin (newBVE, newBVS + maxChunkSize);
@@ -285,7 +310,7 @@ bool BufferingAudioSource::readNextBufferChunk()
     }
 
     if (sectionToReadStart == sectionToReadEnd)
-        return false;
+        return 0;
 
     jassert (buffer.getNumSamples() > 0);
 
@@ -319,7 +344,7 @@ bool BufferingAudioSource::readNextBufferChunk()
     }
 
     bufferReadyEvent.signal();
-    return true;
+    return (int) (sectionToReadEnd - sectionToReadStart);
 }
 
 void BufferingAudioSource::readBufferSection (int64 start, int length, int bufferOffset)
@@ -335,7 +360,58 @@ void BufferingAudioSource::readBufferSection (int64 start, int length, int buffe
 
 int BufferingAudioSource::useTimeSlice()
 {
-    return readNextBufferChunk() ? 1 : 100;
+    return readNextBufferChunk (2048) > 0 ? 1 : 100;
+}
+
+int BufferingAudioSource::readAhead (int maxSamplesToRead)
+{
+    return readNextBufferChunk (maxSamplesToRead);
+}
+
+double BufferingAudioSource::getSecondsUntilUnderrun()
+{
+    const ScopedLock sl (bufferRangeLock);
+
+    if (! isPrepared || sampleRate <= 0 || buffer.getNumSamples() == 0)
+        return -1.0;
+
+    const auto newBVS = jmax ((int64) 0, nextPlayPos.load());
+    const auto newBVE = newBVS + buffer.getNumSamples() - 4;
+
+    if (wasSourceLooping != isLooping() || newBVS < bufferValidStart || newBVS >= bufferValidEnd)
+        return 0.0;
+
+    // This has to match the point at which readNextBufferChunk() decides there's
+    // nothing worth reading, otherwise the scheduler would keep coming back
+    if (std::abs ((int) (newBVS - bufferValidStart)) <= 512
+         && std::abs ((int) (newBVE - bufferValidEnd)) <= 512)
+        return -1.0;
+
+    return (double) (bufferValidEnd - newBVS) / sampleRate;
+}
+
+void BufferingAudioSource::startBackgroundReading()
+{
+    if (scheduler != nullptr)
+        scheduler->addClient (this);
+    else
+        backgroundThread->addTimeSliceClient (this);
+}
+
+void BufferingAudioSource::stopBackgroundReading()
+{
+    if (scheduler != nullptr)
+        scheduler->removeClient (this);
+    else
+        backgroundThread->removeTimeSliceClient (this);
+}
+
+void BufferingAudioSource::prioritiseBackgroundReading()
+{
+    if (scheduler != nullptr)
+        scheduler->notify();
+    else
+        backgroundThread->moveToFrontOfQueue (this);
 }
 
 } // namespace juce
@@ -48,7 +48,8 @@ namespace juce
     @tags{Audio}
 */
 class JUCE_API  BufferingAudioSource  : public PositionableAudioSource,
-                                        private TimeSliceClient
+                                        private TimeSliceClient,
+                                        private ReadAheadScheduler::Client
 {
 public:
     //==============================================================================
@@ -73,6 +74,19 @@ public:
                           int numberOfChannels = 2,
                           bool prefillBufferOnPrepareToPlay = true);
 
+    /** Creates a BufferingAudioSource that does its reading with a ReadAheadScheduler.
+
+        The parameters are the same as for the other constructor, except that the scheduler
+        must not be deleted until after any BufferingAudioSources that are using it have
+        been deleted.
+    */
+    BufferingAudioSource (PositionableAudioSource* source,
+                          ReadAheadScheduler& scheduler,
+                          bool deleteSourceWhenDeleted,
+                          int numberOfSamplesToBuffer,
+                          int numberOfChannels = 2,
+                          bool prefillBufferOnPrepareToPlay = true);
+
     /** Destructor.
 
         The input source may be deleted depending on whether the deleteSourceWhenDeleted
@@ -109,16 +123,34 @@ public:
     */
     bool waitForNextAudioBlockReady (const AudioSourceChannelInfo& info, uint32 timeout);
 
+    /** Returns the number of times that playback has run out of buffered data, and
+        some other figures about the background reading.
+    */
+    using ReadAheadScheduler::Client::getStatistics;
+
+    /** Resets the values returned by getStatistics(). */
+    using ReadAheadScheduler::Client::resetStatistics;
+
 private:
     //==============================================================================
+    BufferingAudioSource (PositionableAudioSource*, TimeSliceThread*, ReadAheadScheduler*,
+                          bool, int, int, bool);
+
     Range<int> getValidBufferRange (int numSamples) const;
-    bool readNextBufferChunk();
+    int readNextBufferChunk (int maxChunkSize);
     void readBufferSection (int64 start, int length, int bufferOffset);
     int useTimeSlice() override;
+    double getSecondsUntilUnderrun() override;
+    int readAhead (int maxSamplesToRead) override;
+
+    void startBackgroundReading();
+    void stopBackgroundReading();
+    void prioritiseBackgroundReading();
 
     //==============================================================================
     OptionalScopedPointer<PositionableAudioSource> source;
-    TimeSliceThread& backgroundThread;
+    TimeSliceThread* const backgroundThread;
+    ReadAheadScheduler* const scheduler;
     int numberOfSamplesToBuffer, numberOfChannels;
     AudioBuffer<float> buffer;
     CriticalSection callbackLock, bufferRangeLock;
@@ -0,0 +1,252 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+ReadAheadScheduler::Statistics ReadAheadScheduler::Client::getStatistics() const
+{
+    Statistics s;
+    s.numUnderruns          = numUnderruns.load();
+    s.numSamplesMissed      = numSamplesMissed.load();
+    s.numReads              = numReads.load();
+    s.numSamplesRead        = numSamplesRead.load();
+    s.lowestSecondsBuffered = lowestSecondsBuffered.load();
+    return s;
+}
+
+void ReadAheadScheduler::Client::resetStatistics()
+{
+    numUnderruns = 0;
+    numSamplesMissed = 0;
+    numReads = 0;
+    numSamplesRead = 0;
+    lowestSecondsBuffered = std::numeric_limits<double>::infinity();
+}
+
+void ReadAheadScheduler::Client::reportUnderrun (int numSamplesMissing) noexcept
+{
+    if (numSamplesMissing > 0)
+    {
+        ++numUnderruns;
+        numSamplesMissed += numSamplesMissing;
+    }
+}
+
+//==============================================================================
+class ReadAheadScheduler::Worker final : public Thread
+{
+public:
+    Worker (ReadAheadScheduler& s, int index)
+        : Thread ("Read-ahead " + String (index)), scheduler (s)
+    {
+    }
+
+    ~Worker() override
+    {
+        signalThreadShouldExit();
+        scheduler.workAvailable.signal();
+        stopThread (-1);
+    }
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            if (auto* client = scheduler.takeMostUrgentClient())
+            {
+                const auto numRead = client->readAhead (scheduler.maxSamplesPerRead);
+
+                if (numRead > 0)
+                {
+                    ++client->numReads;
+                    client->numSamplesRead += numRead;
+                }
+
+                scheduler.finishedReading (client);
+            }
+            else
+            {
+                // Playback doesn't always call notify() as it consumes data, so this
+                // also checks the clients again every few milliseconds
+                scheduler.workAvailable.wait (10);
+            }
+        }
+    }
+
+private:
+    ReadAheadScheduler& scheduler;
+
+    JUCE_DECLARE_NON_COPYABLE (Worker)
+};
+
+//==============================================================================
+ReadAheadScheduler::ReadAheadScheduler (int maxConcurrentReads, int maxSamples, Thread::Priority priority)
+    : maxSamplesPerRead (jmax (1024, maxSamples))
+{
+    for (int i = 0; i < jmax (1, maxConcurrentReads); ++i)
+    {
+        workers.push_back (std::make_unique<Worker> (*this, i));
+        workers.back()->startThread (priority);
+    }
+}
+
+ReadAheadScheduler::~ReadAheadScheduler()
+{
+    // All the clients should have been removed before deleting the scheduler!
+    jassert (clients.empty());
+
+    workers.clear();
+}
+
+//==============================================================================
+void ReadAheadScheduler::addClient (Client* clientToAdd)
+{
+    if (clientToAdd == nullptr)
+        return;
+
+    {
+        const ScopedLock sl (lock);
+
+        if (std::find (clients.begin(), clients.end(), clientToAdd) != clients.end())
+            return;
+
+        clients.push_back (clientToAdd);
+    }
+
+    notify();
+}
+
+void ReadAheadScheduler::removeClient (Client* clientToRemove)
+{
+    const ScopedLock sl (lock);
+
+    clients.erase (std::remove (clients.begin(), clients.end(), clientToRemove), clients.end());
+
+    while (std::find (clientsBeingRead.begin(), clientsBeingRead.end(), clientToRemove) != clientsBeingRead.end())
+    {
+        const ScopedUnlock ul (lock);
+        readFinished.wait (5);
+    }
+}
+
+bool ReadAheadScheduler::contains (const Client* client) const
+{
+    const ScopedLock sl (lock);
+    return std::find (clients.begin(), clients.end(), client) != clients.end();
+}
+
+int ReadAheadScheduler::getNumClients() const
+{
+    const ScopedLock sl (lock);
+    return (int) clients.size();
+}
+
+void ReadAheadScheduler::notify() noexcept
+{
+    workAvailable.signal();
+}
+
+ReadAheadScheduler::Statistics ReadAheadScheduler::getTotalStatistics() const
+{
+    const ScopedLock sl (lock);
+    Statistics total;
+
+    for (auto* c : clients)
+    {
+        const auto s = c->getStatistics();
+        total.numUnderruns += s.numUnderruns;
+        total.numSamplesMissed += s.numSamplesMissed;
+        total.numReads += s.numReads;
+        total.numSamplesRead += s.numSamplesRead;
+        total.lowestSecondsBuffered = jmin (total.lowestSecondsBuffered, s.lowestSecondsBuffered);
+    }
+
+    return total;
+}
+
+//==============================================================================
+ReadAheadScheduler::Client* ReadAheadScheduler::takeMostUrgentClient()
+{
+    const ScopedLock sl (lock);
+
+    Client* best = nullptr;
+    auto bestSeconds = std::numeric_limits<double>::max();
+    auto numWaiting = 0;
+
+    for (auto* c : clients)
+    {
+        if (std::find (clientsBeingRead.begin(), clientsBeingRead.end(), c) != clientsBeingRead.end())
+            continue;
+
+        const auto seconds = c->getSecondsUntilUnderrun();
+
+        if (seconds < 0)
+            continue;
+
+        ++numWaiting;
+
+        if (seconds < bestSeconds)
+        {
+            best = c;
+            bestSeconds = seconds;
+        }
+    }
+
+    if (best == nullptr)
+        return nullptr;
+
+    clientsBeingRead.push_back (best);
+
+    if (bestSeconds < best->lowestSecondsBuffered.load())
+        best->lowestSecondsBuffered = bestSeconds;
+
+    // If there's more to do, get another thread started on it
+    if (numWaiting > 1)
+        workAvailable.signal();
+
+    return best;
+}
+
+void ReadAheadScheduler::finishedReading (Client* client)
+{
+    {
+        const ScopedLock sl (lock);
+        clientsBeingRead.erase (std::find (clientsBeingRead.begin(), clientsBeingRead.end(), client));
+    }
+
+    readFinished.signal();
+}
+
+} // namespace juce
@@ -0,0 +1,185 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Runs the background reading for a set of streaming audio objects, always
+    serving the stream that's closest to running out of data first.
+
+    A TimeSliceThread gives its clients turns in a fixed order, so with a lot of
+    streams, some can run dry while others are buffered well ahead. This class
+    instead asks each client how long its buffered audio will last, and gives
+    the next read to the one with the least. Each read can cover as much of a
+    client's missing data as possible, up to a limit, so that adjacent sections
+    are fetched with one large read instead of lots of small ones. The number of
+    reads that can be in progress at once is fixed, which stops a lot of streams
+    flooding the disk with requests.
+
+    BufferingAudioSource and BufferingAudioReader can both use one of these in
+    place of a TimeSliceThread.
+
+    @see BufferingAudioSource, BufferingAudioReader
+
+    @tags{Audio}
+*/
+class JUCE_API  ReadAheadScheduler
+{
+public:
+    //==============================================================================
+    /** Counters that describe how well a stream has been kept supplied with data. */
+    struct Statistics
+    {
+        /** The number of times that playback needed data that wasn't ready. */
+        int numUnderruns = 0;
+
+        /** The total number of samples that weren't ready when they were needed. */
+        int64 numSamplesMissed = 0;
+
+        /** The number of background reads done for the stream. */
+        int numReads = 0;
+
+        /** The total number of samples read in the background. */
+        int64 numSamplesRead = 0;
+
+        /** The least amount of buffered audio, in seconds, that the stream had when
+            it was chosen for a read.
+        */
+        double lowestSecondsBuffered = std::numeric_limits<double>::infinity();
+    };
+
+    //==============================================================================
+    /**
+        An object that reads ahead using a ReadAheadScheduler.
+
+        Make sure you call removeClient() before deleting one of these.
+    */
+    class JUCE_API  Client
+    {
+    public:
+        /** Destructor. */
+        virtual ~Client() = default;
+
+        /** Returns how many seconds of buffered audio the client has left before it'll
+            run out, or a negative value if it doesn't need to read anything at the moment.
+
+            This is called often, and while the scheduler holds a lock, so it must be quick.
+        */
+        virtual double getSecondsUntilUnderrun() = 0;
+
+        /** Reads the next section of missing data, which should be at most the given
+            number of samples, returning the number of samples that were read.
+        */
+        virtual int readAhead (int maxSamplesToRead) = 0;
+
+        /** Returns the client's statistics. This can be called from any thread. */
+        Statistics getStatistics() const;
+
+        /** Resets the client's statistics. */
+        void resetStatistics();
+
+    protected:
+        /** Clients should call this when playback wants some data that hasn't been read yet.
+            This doesn't block or allocate, so it can be called on the audio thread.
+        */
+        void reportUnderrun (int numSamplesMissing) noexcept;
+
+    private:
+        friend class ReadAheadScheduler;
+
+        std::atomic<int> numUnderruns { 0 }, numReads { 0 };
+        std::atomic<int64> numSamplesMissed { 0 }, numSamplesRead { 0 };
+        std::atomic<double> lowestSecondsBuffered { std::numeric_limits<double>::infinity() };
+    };
+
+    //==============================================================================
+    /** Creates a scheduler.
+
+        @param maxConcurrentReads   the number of background threads, and so the most
+                                    reads that can be in progress at the same time. On a
+                                    spinning disk, reads that are interleaved cause a lot
+                                    of seeking, so only use more than one for storage that
+                                    handles parallel requests well
+        @param maxSamplesPerRead    the most samples that a client is asked to read at once
+        @param threadPriority       the priority of the background threads
+    */
+    explicit ReadAheadScheduler (int maxConcurrentReads = 1,
+                                 int maxSamplesPerRead = 65536,
+                                 Thread::Priority threadPriority = Thread::Priority::high);
+
+    /** Destructor. All clients must have been removed before the scheduler is deleted. */
+    ~ReadAheadScheduler();
+
+    //==============================================================================
+    /** Adds a client. Reads may start before this method returns. */
+    void addClient (Client* clientToAdd);
+
+    /** Removes a client, waiting for any read that's in progress for it to finish. */
+    void removeClient (Client* clientToRemove);
+
+    /** Returns true if the client has been added. */
+    bool contains (const Client* client) const;
+
+    /** Returns the number of clients. */
+    int getNumClients() const;
+
+    /** Makes the threads look for work straight away. Clients should call this when
+        they've consumed data or jumped to a new position, so that they don't have to
+        wait for the scheduler to notice.
+    */
+    void notify() noexcept;
+
+    /** Returns the combined statistics of all the current clients. */
+    Statistics getTotalStatistics() const;
+
+private:
+    //==============================================================================
+    class Worker;
+
+    Client* takeMostUrgentClient();
+    void finishedReading (Client*);
+
+    const int maxSamplesPerRead;
+
+    CriticalSection lock;
+    std::vector<Client*> clients, clientsBeingRead;
+    WaitableEvent workAvailable, readFinished;
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ReadAheadScheduler)
+};
+
+} // namespace juce
@@ -201,15 +201,297 @@ static const char* const flacFormatName = "FLAC file";
 template <typename Item>
 auto emptyRange (Item item) { return Range<Item>::emptyRange (item); }
 
+//==============================================================================
+/*  These helpers deal with the raw layout of a FLAC stream. They're used to split
+    an encoded stream into runs of whole frames, so that the frames can be encoded
+    or decoded on several threads at once and then stitched back together.
+*/
+namespace FlacStreamHelpers
+{
+    static void configureEncoder (FlacNamespace::FLAC__StreamEncoder* encoder, double sampleRate,
+                                  uint32 numChannels, uint32 bitsPerSample, int qualityOptionIndex)
+    {
+        if (qualityOptionIndex > 0)
+            FLAC__stream_encoder_set_compression_level (encoder, (uint32) jmin (8, qualityOptionIndex));
+
+        FLAC__stream_encoder_set_do_mid_side_stereo (encoder, numChannels == 2);
+        FLAC__stream_encoder_set_loose_mid_side_stereo (encoder, numChannels == 2);
+        FLAC__stream_encoder_set_channels (encoder, numChannels);
+        FLAC__stream_encoder_set_bits_per_sample (encoder, jmin ((unsigned int) 24, bitsPerSample));
+        FLAC__stream_encoder_set_sample_rate (encoder, (unsigned int) sampleRate);
+        FLAC__stream_encoder_set_blocksize (encoder, 0);
+        FLAC__stream_encoder_set_do_escape_coding (encoder, true);
+    }
+
+    static void packUint32 (FlacNamespace::FLAC__uint32 val, FlacNamespace::FLAC__byte* b, const int bytes)
+    {
+        b += bytes;
+
+        for (int i = 0; i < bytes; ++i)
+        {
+            *(--b) = (FlacNamespace::FLAC__byte) (val & 0xff);
+            val >>= 8;
+        }
+    }
+
+    static void packUint64 (uint64 val, uint8* b)
+    {
+        packUint32 ((FlacNamespace::FLAC__uint32) (val >> 32), b, 4);
+        packUint32 ((FlacNamespace::FLAC__uint32) val, b + 4, 4);
+    }
+
+    /*  Writes the body of a STREAMINFO metadata block. */
+    static void packStreamInfo (const FlacNamespace::FLAC__StreamMetadata_StreamInfo& info, uint8* buffer)
+    {
+        using namespace FlacNamespace;
+        const unsigned int channelsMinus1 = info.channels - 1;
+        const unsigned int bitsMinus1 = info.bits_per_sample - 1;
+
+        packUint32 (info.min_blocksize, buffer, 2);
+        packUint32 (info.max_blocksize, buffer + 2, 2);
+        packUint32 (info.min_framesize, buffer + 4, 3);
+        packUint32 (info.max_framesize, buffer + 7, 3);
+        buffer[10] = (uint8) ((info.sample_rate >> 12) & 0xff);
+        buffer[11] = (uint8) ((info.sample_rate >> 4) & 0xff);
+        buffer[12] = (uint8) (((info.sample_rate & 0x0f) << 4) | (channelsMinus1 << 1) | (bitsMinus1 >> 4));
+        buffer[13] = (FLAC__byte) (((bitsMinus1 & 0x0f) << 4) | (unsigned int) ((info.total_samples >> 32) & 0x0f));
+        packUint32 ((FLAC__uint32) info.total_samples, buffer + 14, 4);
+        memcpy (buffer + 18, info.md5sum, 16);
+    }
+
+    //==============================================================================
+    /*  The checksums used in frame headers and footers. (These are implemented here
+        rather than borrowed from libFLAC, as its versions aren't part of its public API).
+    */
+    struct Checksums
+    {
+        Checksums()
+        {
+            for (int i = 0; i < 256; ++i)
+            {
+                auto c8  = (uint8) i;
+                auto c16 = (uint16) (i << 8);
+
+                for (int bit = 0; bit < 8; ++bit)
+                {
+                    c8  = (uint8)  ((c8  & 0x80)   != 0 ? (c8  << 1) ^ 0x07   : c8  << 1);
+                    c16 = (uint16) ((c16 & 0x8000) != 0 ? (c16 << 1) ^ 0x8005 : c16 << 1);
+                }
+
+                crc8Table[i] = c8;
+                crc16Table[i] = c16;
+            }
+        }
+
+        static const Checksums& get()
+        {
+            static const Checksums instance;
+            return instance;
+        }
+
+        static uint8 crc8 (const uint8* data, size_t numBytes) noexcept
+        {
+            auto& tables = get();
+            uint8 crc = 0;
+
+            for (size_t i = 0; i < numBytes; ++i)
+                crc = tables.crc8Table[crc ^ data[i]];
+
+            return crc;
+        }
+
+        static uint16 crc16 (const uint8* data, size_t numBytes) noexcept
+        {
+            auto& tables = get();
+            uint16 crc = 0;
+
+            for (size_t i = 0; i < numBytes; ++i)
+                crc = (uint16) ((crc << 8) ^ tables.crc16Table[(crc >> 8) ^ data[i]]);
+
+            return crc;
+        }
+
+        uint8 crc8Table[256];
+        uint16 crc16Table[256];
+    };
+
+    //==============================================================================
+    /*  The parts of a frame header that are needed to find and renumber frames. */
+    struct FrameHeader
+    {
+        uint64 number = 0;        // the frame number, or the first sample if the stream uses variable block sizes
+        uint32 blockSize = 0;
+        size_t numberStart = 4, numberEnd = 0, size = 0;
+        bool hasVariableBlockSize = false;
+
+        uint64 getFirstSample (uint32 fixedBlockSize) const noexcept
+        {
+            return hasVariableBlockSize ? number : number * fixedBlockSize;
+        }
+
+        /*  Returns a header if the data starts with a frame sync code followed by a
+            well-formed header with a matching CRC.
+        */
+        static std::optional<FrameHeader> parse (const uint8* data, size_t numBytes) noexcept
+        {
+            if (numBytes < 6 || data[0] != 0xff || (data[1] & 0xfe) != 0xf8)
+                return {};
+
+            const auto blockSizeCode  = data[2] >> 4;
+            const auto sampleRateCode = data[2] & 0x0f;
+
+            if (blockSizeCode == 0 || sampleRateCode == 0x0f || (data[3] >> 4) > 10 || (data[3] & 1) != 0)
+                return {};
+
+            FrameHeader header;
+            header.hasVariableBlockSize = (data[1] & 1) != 0;
+
+            // The frame or sample number is stored with the same variable-length coding as UTF-8
+            const auto first = data[4];
+            int numExtraBytes = 0;
+
+            if ((first & 0x80) == 0)            { header.number = first; }
+            else if ((first & 0xe0) == 0xc0)    { header.number = first & 0x1f; numExtraBytes = 1; }
+            else if ((first & 0xf0) == 0xe0)    { header.number = first & 0x0f; numExtraBytes = 2; }
+            else if ((first & 0xf8) == 0xf0)    { header.number = first & 0x07; numExtraBytes = 3; }
+            else if ((first & 0xfc) == 0xf8)    { header.number = first & 0x03; numExtraBytes = 4; }
+            else if ((first & 0xfe) == 0xfc)    { header.number = first & 0x01; numExtraBytes = 5; }
+            else if (first == 0xfe)             { header.number = 0;            numExtraBytes = 6; }
+            else                                { return {}; }
+
+            size_t pos = 5;
+
+            for (int i = 0; i < numExtraBytes; ++i, ++pos)
+            {
+                if (pos >= numBytes || (data[pos] & 0xc0) != 0x80)
+                    return {};
+
+                header.number = (header.number << 6) | (uint64) (data[pos] & 0x3f);
+            }
+
+            header.numberEnd = pos;
+
+            if (pos + 3 > numBytes)
+                return {};
+
+            if (blockSizeCode == 1)         header.blockSize = 192;
+            else if (blockSizeCode <= 5)    header.blockSize = 576u << (blockSizeCode - 2);
+            else if (blockSizeCode == 6)    header.blockSize = (uint32) data[pos++] + 1;
+            else if (blockSizeCode == 7)    { header.blockSize = (((uint32) data[pos] << 8) | data[pos + 1]) + 1; pos += 2; }
+            else                            header.blockSize = 256u << (blockSizeCode - 8);
+
+            if (sampleRateCode == 12)                               pos += 1;
+            else if (sampleRateCode == 13 || sampleRateCode == 14)  pos += 2;
+
+            if (pos >= numBytes || Checksums::crc8 (data, pos) != data[pos])
+                return {};
+
+            header.size = pos + 1;
+            return header;
+        }
+    };
+
+    /*  Writes a frame number using FLAC's UTF-8-style coding, returning the number of bytes used. */
+    static size_t writeCodedNumber (uint8* dest, uint64 value) noexcept
+    {
+        if (value < 0x80)
+        {
+            dest[0] = (uint8) value;
+            return 1;
+        }
+
+        const int numExtraBytes = value < 0x800 ? 1 : value < 0x10000 ? 2 : value < 0x200000 ? 3
+                                : value < 0x4000000 ? 4 : value < 0x80000000 ? 5 : 6;
+
+        static constexpr uint8 prefixes[] = { 0x00, 0xc0, 0xe0, 0xf0, 0xf8, 0xfc, 0xfe };
+        dest[0] = (uint8) (prefixes[numExtraBytes] | (uint8) (value >> (6 * numExtraBytes)));
+
+        for (int i = 1; i <= numExtraBytes; ++i)
+            dest[i] = (uint8) (0x80 | ((value >> (6 * (numExtraBytes - i))) & 0x3f));
+
+        return (size_t) numExtraBytes + 1;
+    }
+
+    /*  Copies a complete frame into the destination block, replacing its frame number
+        and recalculating both of its checksums. Returns the size of the new frame.
+    */
+    static size_t renumberFrame (const uint8* frame, size_t frameSize, const FrameHeader& header,
+                                 uint64 newNumber, MemoryBlock& dest)
+    {
+        dest.ensureSize (frameSize + 8);
+        auto* d = static_cast<uint8*> (dest.getData());
+
+        memcpy (d, frame, header.numberStart);
+        auto pos = header.numberStart + writeCodedNumber (d + header.numberStart, newNumber);
+
+        const auto restOfHeader = header.size - 1 - header.numberEnd;
+        memcpy (d + pos, frame + header.numberEnd, restOfHeader);
+        pos += restOfHeader;
+        d[pos] = Checksums::crc8 (d, pos);
+        ++pos;
+
+        const auto bodySize = frameSize - header.size - 2;
+        memcpy (d + pos, frame + header.size, bodySize);
+        pos += bodySize;
+
+        const auto crc = Checksums::crc16 (d, pos);
+        d[pos++] = (uint8) (crc >> 8);
+        d[pos++] = (uint8) (crc & 0xff);
+        return pos;
+    }
+
+    //==============================================================================
+    /*  Runs a set of tasks on the pool, with the calling thread also picking up tasks
+        rather than just waiting for them. Returns when all of the tasks have finished.
+    */
+    template <typename TaskFn>
+    static void runInParallel (ThreadPool& pool, int numTasks, TaskFn&& task)
+    {
+        if (numTasks <= 0)
+            return;
+
+        struct State
+        {
+            std::atomic<int> nextTask { 0 }, numRemaining { 0 };
+            WaitableEvent finished { true };
+        };
+
+        auto state = std::make_shared<State>();
+        state->numRemaining = numTasks;
+
+        auto worker = [state, numTasks, &task]
+        {
+            for (int i; (i = state->nextTask++) < numTasks;)
+            {
+                task (i);
+
+                if (--state->numRemaining == 0)
+                    state->finished.signal();
+            }
+        };
+
+        for (int i = jmin (numTasks, pool.getNumThreads() + 1); --i > 0;)
+            pool.addJob (worker);
+
+        worker();
+        state->finished.wait();
+    }
+}
+
 //==============================================================================
 class FlacReader final : public AudioFormatReader
 {
 public:
-    FlacReader (InputStream* in)  : AudioFormatReader (in, flacFormatName)
+    FlacReader (InputStream* in, ThreadPool* poolForParallelReads = nullptr)
+        : AudioFormatReader (in, flacFormatName),
+          threadPool (poolForParallelReads)
     {
         lengthInSamples = 0;
         decoder = FlacNamespace::FLAC__stream_decoder_new();
 
+        if (threadPool != nullptr)
+            FLAC__stream_decoder_set_metadata_respond (decoder, FlacNamespace::FLAC__METADATA_TYPE_SEEKTABLE);
+
         ok = FLAC__stream_decoder_init_stream (decoder,
                                                readCallback_, seekCallback_, tellCallback_, lengthCallback_,
                                                eofCallback_, writeCallback_, metadataCallback_, errorCallback_,
@@ -232,6 +514,9 @@ public:
                 FLAC__stream_decoder_process_until_end_of_metadata (decoder);
                 lengthInSamples = tempLength;
             }
+
+            if (threadPool != nullptr)
+                initialiseParallelReading();
         }
     }
 
@@ -246,16 +531,50 @@ public:
         bitsPerSample = info.bits_per_sample;
         lengthInSamples = (unsigned int) info.total_samples;
         numChannels = info.channels;
+        streamInfo = info;
 
         reservoir.setSize ((int) numChannels, 2 * (int) info.max_blocksize, false, false, true);
     }
 
+    void useSeekTable (const FlacNamespace::FLAC__StreamMetadata_SeekTable& table)
+    {
+        knownFramePositions.clearQuick();
+
+        for (uint32 i = 0; i < table.num_points; ++i)
+        {
+            const auto& point = table.points[i];
+
+            if (point.sample_number != FlacNamespace::FLAC__STREAM_METADATA_SEEKPOINT_PLACEHOLDER)
+                knownFramePositions.add ({ (int64) point.sample_number, (int64) point.stream_offset });
+        }
+    }
+
+    void initialiseParallelReading()
+    {
+        FlacNamespace::FLAC__uint64 position = 0;
+
+        if (! FLAC__stream_decoder_get_decode_position (decoder, &position))
+            return;
+
+        // Seek points are stored relative to the first frame
+        firstFramePosition = (int64) position;
+
+        for (auto& pos : knownFramePositions)
+            pos.byteOffset += firstFramePosition;
+
+        knownFramePositions.add ({ 0, firstFramePosition });
+    }
+
     bool readSamples (int* const* destSamples, int numDestChannels, int startOffsetInDestBuffer,
                       int64 startSampleInFile, int numSamples) override
     {
         if (! ok)
             return false;
 
+        if (threadPool != nullptr
+             && readSamplesInParallel (destSamples, numDestChannels, startOffsetInDestBuffer, startSampleInFile, numSamples))
+            return true;
+
         const auto getBufferedRange = [this] { return bufferedRange; };
 
         const auto readFromReservoir = [this, &destSamples, &numDestChannels, &startOffsetInDestBuffer, &startSampleInFile] (const Range<int64> rangeToRead)
@@ -353,7 +672,7 @@ public:
 
     static FlacNamespace::FLAC__StreamDecoderSeekStatus seekCallback_ (const FlacNamespace::FLAC__StreamDecoder*, FlacNamespace::FLAC__uint64 absolute_byte_offset, void* client_data)
     {
-        static_cast<const FlacReader*> (client_data)->input->setPosition ((int) absolute_byte_offset);
+        static_cast<const FlacReader*> (client_data)->input->setPosition ((int64) absolute_byte_offset);
         return FlacNamespace::FLAC__STREAM_DECODER_SEEK_STATUS_OK;
     }
 
@@ -387,7 +706,12 @@ public:
                                    const FlacNamespace::FLAC__StreamMetadata* metadata,
                                    void* client_data)
     {
-        static_cast<FlacReader*> (client_data)->useMetadata (metadata->data.stream_info);
+        auto* reader = static_cast<FlacReader*> (client_data);
+
+        if (metadata->type == FlacNamespace::FLAC__METADATA_TYPE_STREAMINFO)
+            reader->useMetadata (metadata->data.stream_info);
+        else if (metadata->type == FlacNamespace::FLAC__METADATA_TYPE_SEEKTABLE)
+            reader->useSeekTable (metadata->data.seek_table);
     }
 
     static void errorCallback_ (const FlacNamespace::FLAC__StreamDecoder*, FlacNamespace::FLAC__StreamDecoderErrorStatus, void*)
@@ -395,126 +719,393 @@ public:
     }
 
 private:
-    FlacNamespace::FLAC__StreamDecoder* decoder;
-    AudioBuffer<float> reservoir;
-    Range<int64> bufferedRange;
-    bool ok = false, scanningForLength = false;
-
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlacReader)
-};
-
+    //==============================================================================
+    /*  Large reads are split into runs of whole frames which are decoded on the thread
+        pool. The reader starts from a frame whose position is already known (one of
+        the seek points, or the frame that followed the previous parallel read), loads
+        the compressed data from there, and finds the frames in it by their sync codes.
+        If anything looks wrong, it returns false and the normal serial path is used.
+    */
+    struct FramePosition
+    {
+        int64 sample = -1, byteOffset = -1;
+    };
 
-//==============================================================================
-class FlacWriter final : public AudioFormatWriter
-{
-public:
-    FlacWriter (OutputStream* out, double rate, uint32 numChans, uint32 bits, int qualityOptionIndex)
-        : AudioFormatWriter (out, flacFormatName, rate, numChans, bits),
-          streamStartPos (output != nullptr ? jmax (output->getPosition(), 0ll) : 0ll)
+    struct FrameInfo
     {
-        encoder = FlacNamespace::FLAC__stream_encoder_new();
+        size_t offset;
+        int64 firstSample;
+    };
 
-        if (qualityOptionIndex > 0)
-            FLAC__stream_encoder_set_compression_level (encoder, (uint32) jmin (8, qualityOptionIndex));
+    FramePosition findStartingFrame (int64 sample) const
+    {
+        auto best = continuationFrame.sample <= sample ? continuationFrame : FramePosition{};
 
-        FLAC__stream_encoder_set_do_mid_side_stereo (encoder, numChannels == 2);
-        FLAC__stream_encoder_set_loose_mid_side_stereo (encoder, numChannels == 2);
-        FLAC__stream_encoder_set_channels (encoder, numChannels);
-        FLAC__stream_encoder_set_bits_per_sample (encoder, jmin ((unsigned int) 24, bitsPerSample));
-        FLAC__stream_encoder_set_sample_rate (encoder, (unsigned int) sampleRate);
-        FLAC__stream_encoder_set_blocksize (encoder, 0);
-        FLAC__stream_encoder_set_do_escape_coding (encoder, true);
+        for (auto& pos : knownFramePositions)
+            if (pos.sample <= sample && pos.sample > best.sample)
+                best = pos;
 
-        ok = FLAC__stream_encoder_init_stream (encoder,
-                                               encodeWriteCallback, encodeSeekCallback,
-                                               encodeTellCallback, encodeMetadataCallback,
-                                               this) == FlacNamespace::FLAC__STREAM_ENCODER_INIT_STATUS_OK;
+        return best;
     }
 
-    ~FlacWriter() override
+    bool readSamplesInParallel (int* const* destSamples, int numDestChannels, int startOffsetInDestBuffer,
+                                int64 startSampleInFile, int numSamples)
     {
-        if (ok)
+        const auto blockSize = (int64) streamInfo.max_blocksize;
+
+        if (threadPool == nullptr || firstFramePosition < 0 || blockSize == 0
+             || streamInfo.min_blocksize != streamInfo.max_blocksize
+             || numSamples < minFramesForParallelRead * blockSize || startSampleInFile < 0)
+            return false;
+
+        const auto endSample = jmin (startSampleInFile + numSamples, lengthInSamples);
+        const auto totalLength = input->getTotalLength();
+        const auto start = findStartingFrame (startSampleInFile);
+
+        if (endSample <= startSampleInFile || totalLength <= firstFramePosition || start.sample < 0
+             || startSampleInFile - start.sample > jmax ((int64) numSamples, minFramesForParallelRead * blockSize))
+            return false;
+
+        // Guess how much data is needed from the average compression ratio, and keep
+        // reading more until the frame containing the last sample has been found
+        const auto maxFrameSize = streamInfo.max_framesize > 0 ? (int64) streamInfo.max_framesize
+                                                               : blockSize * (int64) numChannels * 4 + 64;
+        const auto averageBytesPerSample = (double) (totalLength - firstFramePosition) / (double) jmax ((int64) 1, lengthInSamples);
+        auto bytesToRead = (int64) (averageBytesPerSample * (double) (endSample - start.sample) * 1.1) + 2 * maxFrameSize;
+        size_t dataSize = 0;
+
+        for (;;)
         {
-            FlacNamespace::FLAC__stream_encoder_finish (encoder);
-            output->flush();
+            bytesToRead = jmin (bytesToRead, totalLength - start.byteOffset);
+
+            if (bytesToRead <= 0 || bytesToRead > std::numeric_limits<int>::max())
+                return false;
+
+            compressedData.ensureSize ((size_t) bytesToRead);
+            invalidateSerialDecoder();
+
+            if (! input->setPosition (start.byteOffset))
+                return false;
+
+            dataSize = (size_t) input->read (compressedData.getData(), (int) bytesToRead);
+            const auto reachedEndOfStream = start.byteOffset + (int64) dataSize >= totalLength;
+
+            if (findFrames (dataSize, start.sample, endSample, reachedEndOfStream))
+                break;
+
+            if (reachedEndOfStream || (int64) dataSize < bytesToRead)
+                return false;
+
+            bytesToRead *= 2;
         }
-        else
+
+        // Skip any frames that end before the first sample that's needed
+        auto firstFrame = 0;
+
+        while (firstFrame + 1 < frames.size() && frames.getReference (firstFrame + 1).firstSample <= startSampleInFile)
+            ++firstFrame;
+
+        auto lastFrame = frames.size() - 1;
+
+        while (lastFrame > firstFrame && frames.getReference (lastFrame).firstSample >= endSample)
+            --lastFrame;
+
+        const auto numFrames = lastFrame - firstFrame + 1;
+        const auto numParts = jmin (numFrames, (threadPool->getNumThreads() + 1) * 2);
+        std::atomic<bool> allPartsOk { true };
+
+        FlacStreamHelpers::runInParallel (*threadPool, numParts, [&] (int part)
         {
-            output = nullptr; // to stop the base class deleting this, as it needs to be returned
-                              // to the caller of createWriter()
+            const auto partStart = firstFrame + (numFrames * part) / numParts;
+            const auto partEnd   = firstFrame + (numFrames * (part + 1)) / numParts;
+            const auto dataEnd   = partEnd < frames.size() ? frames.getReference (partEnd).offset : dataSize;
+            const auto& first    = frames.getReference (partStart);
+
+            PartDecoder partDecoder { *this, static_cast<const uint8*> (compressedData.getData()) + first.offset, dataEnd - first.offset,
+                                  destSamples, numDestChannels, startOffsetInDestBuffer - startSampleInFile,
+                                  Range<int64> (jmax (startSampleInFile, first.firstSample),
+                                                jmin (endSample, partEnd < frames.size() ? frames.getReference (partEnd).firstSample : endSample)) };
+
+            if (! partDecoder.decode())
+                allPartsOk = false;
+        });
+
+        if (! allPartsOk)
+            return false;
+
+        if (lastFrame + 1 < frames.size())
+        {
+            const auto& next = frames.getReference (lastFrame + 1);
+            continuationFrame = { next.firstSample, start.byteOffset + (int64) next.offset };
         }
 
-        FlacNamespace::FLAC__stream_encoder_delete (encoder);
+        if (endSample < startSampleInFile + numSamples)
+            for (int i = numDestChannels; --i >= 0;)
+                if (destSamples[i] != nullptr)
+                    zeromem (destSamples[i] + startOffsetInDestBuffer + (endSample - startSampleInFile),
+                             (size_t) (startSampleInFile + numSamples - endSample) * sizeof (int));
+
+        return true;
     }
 
-    //==============================================================================
-    bool write (const int** samplesToWrite, int numSamples) override
+    /*  Finds the chain of frames that begins at the start of the loaded data, stopping at the
+        first frame that starts at or after the end sample. Returns false if the data ran out
+        before reaching that point.
+    */
+    bool findFrames (size_t dataSize, int64 firstSample, int64 endSample, bool dataReachesEndOfStream)
     {
-        if (! ok)
-            return false;
-
-        HeapBlock<int*> channels;
-        HeapBlock<int> temp;
-        auto bitsToShift = 32 - (int) bitsPerSample;
+        const auto* data = static_cast<const uint8*> (compressedData.getData());
+        auto expectedSample = firstSample;
+        frames.clearQuick();
 
-        if (bitsToShift > 0)
+        for (size_t pos = 0; pos + 1 < dataSize;)
         {
-            temp.malloc (numChannels * (size_t) numSamples);
-            channels.calloc (numChannels + 1);
+            auto* sync = static_cast<const uint8*> (std::memchr (data + pos, 0xff, dataSize - pos - 1));
 
-            for (unsigned int i = 0; i < numChannels; ++i)
+            if (sync == nullptr)
+                break;
+
+            pos = (size_t) (sync - data);
+
+            if (const auto header = FlacStreamHelpers::FrameHeader::parse (sync, dataSize - pos))
             {
-                if (samplesToWrite[i] == nullptr)
-                    break;
+                if ((int64) header->getFirstSample (streamInfo.max_blocksize) == expectedSample)
+                {
+                    frames.add ({ pos, expectedSample });
 
-                auto* destData = temp.get() + i * (size_t) numSamples;
-                channels[i] = destData;
+                    if (expectedSample >= endSample)
+                        return true;
 
-                for (int j = 0; j < numSamples; ++j)
-                    destData[j] = (samplesToWrite[i][j] >> bitsToShift);
+                    expectedSample += header->blockSize;
+                    pos += header->size;
+                    continue;
+                }
             }
 
-            samplesToWrite = const_cast<const int**> (channels.get());
+            ++pos;
         }
 
-        return FLAC__stream_encoder_process (encoder, (const FlacNamespace::FLAC__int32**) samplesToWrite, (unsigned) numSamples) != 0;
+        // Unless this is the end of the stream, the last frame may have been cut off
+        return dataReachesEndOfStream && ! frames.isEmpty() && expectedSample >= endSample;
     }
 
-    bool writeData (const void* const data, const int size) const
+    // The serial decoder's view of the input stream is lost when the stream is moved,
+    // so this flushes it and forces it to seek before it next decodes anything.
+    void invalidateSerialDecoder()
     {
-        return output->write (data, (size_t) size);
+        FLAC__stream_decoder_flush (decoder);
+        bufferedRange = emptyRange (lengthInSamples + 1);
     }
 
-    static void packUint32 (FlacNamespace::FLAC__uint32 val, FlacNamespace::FLAC__byte* b, const int bytes)
+    //==============================================================================
+    /*  Decodes a run of frames from memory, by handing libFLAC a copy of the stream's
+        STREAMINFO block followed by the frame data.
+    */
+    struct PartDecoder
     {
-        b += bytes;
-
-        for (int i = 0; i < bytes; ++i)
+        const FlacReader& owner;
+        const uint8* data;
+        size_t dataSize;
+        int* const* destSamples;
+        int numDestChannels;
+        int64 destOffset;
+        Range<int64> rangeToWrite;
+
+        uint8 header[4 + 4 + FLAC__STREAM_METADATA_STREAMINFO_LENGTH] {};
+        size_t headerPos = 0, dataPos = 0;
+        int64 numWritten = 0;
+        bool failed = false;
+
+        bool decode()
         {
-            *(--b) = (FlacNamespace::FLAC__byte) (val & 0xff);
-            val >>= 8;
-        }
-    }
+            using namespace FlacNamespace;
 
-    void writeMetaData (const FlacNamespace::FLAC__StreamMetadata* metadata)
-    {
-        using namespace FlacNamespace;
-        auto& info = metadata->data.stream_info;
+            memcpy (header, "fLaC", 4);
+            header[4] = 0x80; // last metadata block, STREAMINFO
+            FlacStreamHelpers::packUint32 (FLAC__STREAM_METADATA_STREAMINFO_LENGTH, header + 5, 3);
+            FlacStreamHelpers::packStreamInfo (owner.streamInfo, header + 8);
 
-        unsigned char buffer[FLAC__STREAM_METADATA_STREAMINFO_LENGTH];
-        const unsigned int channelsMinus1 = info.channels - 1;
-        const unsigned int bitsMinus1 = info.bits_per_sample - 1;
+            auto* decoder = FLAC__stream_decoder_new();
 
-        packUint32 (info.min_blocksize, buffer, 2);
-        packUint32 (info.max_blocksize, buffer + 2, 2);
-        packUint32 (info.min_framesize, buffer + 4, 3);
-        packUint32 (info.max_framesize, buffer + 7, 3);
-        buffer[10] = (uint8) ((info.sample_rate >> 12) & 0xff);
-        buffer[11] = (uint8) ((info.sample_rate >> 4) & 0xff);
-        buffer[12] = (uint8) (((info.sample_rate & 0x0f) << 4) | (channelsMinus1 << 1) | (bitsMinus1 >> 4));
-        buffer[13] = (FLAC__byte) (((bitsMinus1 & 0x0f) << 4) | (unsigned int) ((info.total_samples >> 32) & 0x0f));
-        packUint32 ((FLAC__uint32) info.total_samples, buffer + 14, 4);
-        memcpy (buffer + 18, info.md5sum, 16);
+            if (decoder == nullptr)
+                return false;
+
+            const auto initOk = FLAC__stream_decoder_init_stream (decoder, readCallback, nullptr, nullptr, nullptr, eofCallback,
+                                                                  writeCallback, nullptr, errorCallback, this)
+                                  == FLAC__STREAM_DECODER_INIT_STATUS_OK;
+
+            const auto decodeOk = initOk && FLAC__stream_decoder_process_until_end_of_stream (decoder);
+            FLAC__stream_decoder_delete (decoder);
+
+            return decodeOk && ! failed && numWritten == rangeToWrite.getLength();
+        }
+
+        void useSamples (const FlacNamespace::FLAC__Frame& frame, const FlacNamespace::FLAC__int32* const buffer[])
+        {
+            const auto frameRange = Range<int64>::withStartAndLength ((int64) frame.header.number.sample_number,
+                                                                      (int64) frame.header.blocksize);
+            const auto range = frameRange.getIntersectionWith (rangeToWrite);
+
+            if (range.isEmpty())
+                return;
+
+            const auto bitsToShift = 32 - (int) owner.bitsPerSample;
+            const auto numToCopy = (int) range.getLength();
+
+            for (int i = jmin (numDestChannels, (int) frame.header.channels); --i >= 0;)
+            {
+                if (auto* dest = destSamples[i])
+                {
+                    dest += destOffset + range.getStart();
+                    auto* src = buffer[i] + (range.getStart() - frameRange.getStart());
+
+                    for (int j = 0; j < numToCopy; ++j)
+                        dest[j] = src[j] << bitsToShift;
+                }
+            }
+
+            numWritten += range.getLength();
+        }
+
+        static FlacNamespace::FLAC__StreamDecoderReadStatus readCallback (const FlacNamespace::FLAC__StreamDecoder*, FlacNamespace::FLAC__byte buffer[], size_t* bytes, void* client_data)
+        {
+            auto& d = *static_cast<PartDecoder*> (client_data);
+            size_t numRead = 0;
+
+            if (d.headerPos < sizeof (d.header))
+            {
+                numRead = jmin (*bytes, sizeof (d.header) - d.headerPos);
+                memcpy (buffer, d.header + d.headerPos, numRead);
+                d.headerPos += numRead;
+            }
+
+            const auto numFromData = jmin (*bytes - numRead, d.dataSize - d.dataPos);
+            memcpy (buffer + numRead, d.data + d.dataPos, numFromData);
+            d.dataPos += numFromData;
+            *bytes = numRead + numFromData;
+
+            return *bytes > 0 ? FlacNamespace::FLAC__STREAM_DECODER_READ_STATUS_CONTINUE
+                              : FlacNamespace::FLAC__STREAM_DECODER_READ_STATUS_END_OF_STREAM;
+        }
+
+        static FlacNamespace::FLAC__bool eofCallback (const FlacNamespace::FLAC__StreamDecoder*, void* client_data)
+        {
+            auto& d = *static_cast<PartDecoder*> (client_data);
+            return d.headerPos == sizeof (d.header) && d.dataPos == d.dataSize;
+        }
+
+        static FlacNamespace::FLAC__StreamDecoderWriteStatus writeCallback (const FlacNamespace::FLAC__StreamDecoder*,
+                                                                            const FlacNamespace::FLAC__Frame* frame,
+                                                                            const FlacNamespace::FLAC__int32* const buffer[],
+                                                                            void* client_data)
+        {
+            static_cast<PartDecoder*> (client_data)->useSamples (*frame, buffer);
+            return FlacNamespace::FLAC__STREAM_DECODER_WRITE_STATUS_CONTINUE;
+        }
+
+        static void errorCallback (const FlacNamespace::FLAC__StreamDecoder*, FlacNamespace::FLAC__StreamDecoderErrorStatus, void* client_data)
+        {
+            static_cast<PartDecoder*> (client_data)->failed = true;
+        }
+    };
+
+    //==============================================================================
+    static constexpr int64 minFramesForParallelRead = 16;
+
+    FlacNamespace::FLAC__StreamDecoder* decoder;
+    AudioBuffer<float> reservoir;
+    Range<int64> bufferedRange;
+    bool ok = false, scanningForLength = false;
+
+    ThreadPool* threadPool = nullptr;
+    FlacNamespace::FLAC__StreamMetadata_StreamInfo streamInfo {};
+    int64 firstFramePosition = -1;
+    Array<FramePosition> knownFramePositions;
+    FramePosition continuationFrame;
+    MemoryBlock compressedData;
+    Array<FrameInfo> frames;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlacReader)
+};
+
+
+//==============================================================================
+class FlacWriter final : public AudioFormatWriter
+{
+public:
+    FlacWriter (OutputStream* out, double rate, uint32 numChans, uint32 bits, int qualityOptionIndex)
+        : AudioFormatWriter (out, flacFormatName, rate, numChans, bits),
+          streamStartPos (output != nullptr ? jmax (output->getPosition(), 0ll) : 0ll)
+    {
+        encoder = FlacNamespace::FLAC__stream_encoder_new();
+        FlacStreamHelpers::configureEncoder (encoder, sampleRate, numChannels, bitsPerSample, qualityOptionIndex);
+
+        ok = FLAC__stream_encoder_init_stream (encoder,
+                                               encodeWriteCallback, encodeSeekCallback,
+                                               encodeTellCallback, encodeMetadataCallback,
+                                               this) == FlacNamespace::FLAC__STREAM_ENCODER_INIT_STATUS_OK;
+    }
+
+    ~FlacWriter() override
+    {
+        if (ok)
+        {
+            FlacNamespace::FLAC__stream_encoder_finish (encoder);
+            output->flush();
+        }
+        else
+        {
+            output = nullptr; // to stop the base class deleting this, as it needs to be returned
+                              // to the caller of createWriter()
+        }
+
+        FlacNamespace::FLAC__stream_encoder_delete (encoder);
+    }
+
+    //==============================================================================
+    bool write (const int** samplesToWrite, int numSamples) override
+    {
+        if (! ok)
+            return false;
+
+        HeapBlock<int*> channels;
+        HeapBlock<int> temp;
+        auto bitsToShift = 32 - (int) bitsPerSample;
+
+        if (bitsToShift > 0)
+        {
+            temp.malloc (numChannels * (size_t) numSamples);
+            channels.calloc (numChannels + 1);
+
+            for (unsigned int i = 0; i < numChannels; ++i)
+            {
+                if (samplesToWrite[i] == nullptr)
+                    break;
+
+                auto* destData = temp.get() + i * (size_t) numSamples;
+                channels[i] = destData;
+
+                for (int j = 0; j < numSamples; ++j)
+                    destData[j] = (samplesToWrite[i][j] >> bitsToShift);
+            }
+
+            samplesToWrite = const_cast<const int**> (channels.get());
+        }
+
+        return FLAC__stream_encoder_process (encoder, (const FlacNamespace::FLAC__int32**) samplesToWrite, (unsigned) numSamples) != 0;
+    }
+
+    bool writeData (const void* const data, const int size) const
+    {
+        return output->write (data, (size_t) size);
+    }
+
+    void writeMetaData (const FlacNamespace::FLAC__StreamMetadata* metadata)
+    {
+        using namespace FlacNamespace;
+
+        unsigned char buffer[FLAC__STREAM_METADATA_STREAMINFO_LENGTH];
+        FlacStreamHelpers::packStreamInfo (metadata->data.stream_info, buffer);
 
         [[maybe_unused]] const bool seekOk = output->setPosition (streamStartPos + 4);
 
@@ -567,6 +1158,404 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlacWriter)
 };
 
+//==============================================================================
+/*  Splits the incoming audio into chunks of whole frames, and gives each chunk to
+    its own libFLAC encoder on a thread pool. The encoded chunks are written out in
+    order, with their frame numbers patched to run on from the previous chunk, and
+    the STREAMINFO and SEEKTABLE blocks are filled in once the stream is complete.
+*/
+class ParallelFlacWriter final : public AudioFormatWriter
+{
+public:
+    ParallelFlacWriter (OutputStream* out, double rate, uint32 numChans, uint32 bits,
+                        int qualityOptionIndex, ThreadPool& pool)
+        : AudioFormatWriter (out, flacFormatName, rate, numChans, bits),
+          threadPool (pool),
+          quality (qualityOptionIndex),
+          streamStartPos (output != nullptr ? jmax (output->getPosition(), 0ll) : 0ll),
+          maxChunksInFlight ((size_t) jmax (2, 2 * pool.getNumThreads()))
+    {
+        using namespace FlacNamespace;
+
+        // Ask a throwaway encoder which block size these settings will produce
+        if (auto* encoder = FLAC__stream_encoder_new())
+        {
+            FlacStreamHelpers::configureEncoder (encoder, sampleRate, numChannels, bitsPerSample, quality);
+
+            if (FLAC__stream_encoder_init_stream (encoder, discardingWriteCallback, nullptr, nullptr, nullptr, nullptr)
+                  == FLAC__STREAM_ENCODER_INIT_STATUS_OK)
+                blockSize = (int) FLAC__stream_encoder_get_blocksize (encoder);
+
+            FLAC__stream_encoder_delete (encoder);
+        }
+
+       #if JUCE_INCLUDE_FLAC_CODE || ! defined (JUCE_INCLUDE_FLAC_CODE)
+        FLAC__MD5Init (&md5);
+       #endif
+
+        ok = blockSize > 0 && numChannels > 0 && numChannels <= FLAC__MAX_CHANNELS && writeHeader();
+    }
+
+    ~ParallelFlacWriter() override
+    {
+        if (ok)
+        {
+            if (currentChunk != nullptr && currentChunk->numSamples > 0)
+                submitCurrentChunk();
+
+            while (! pendingChunks.empty())
+                writeNextChunk();
+
+            writeStreamInfoAndSeekTable();
+            output->flush();
+        }
+        else
+        {
+            output = nullptr; // to stop the base class deleting this, as it needs to be returned
+                              // to the caller of createWriter()
+        }
+    }
+
+    //==============================================================================
+    bool write (const int** samplesToWrite, int numSamples) override
+    {
+        if (! ok || failed)
+            return false;
+
+        const auto bitsToShift = 32 - (int) bitsPerSample;
+        const auto samplesPerChunk = blockSize * framesPerChunk;
+
+        for (int done = 0; done < numSamples;)
+        {
+            if (currentChunk == nullptr)
+                currentChunk = getSpareChunk();
+
+            auto& chunk = *currentChunk;
+            const auto num = jmin (numSamples - done, samplesPerChunk - chunk.numSamples);
+
+            for (uint32 i = 0; i < numChannels; ++i)
+            {
+                auto* dest = chunk.getChannel ((int) i) + chunk.numSamples;
+
+                if (auto* src = samplesToWrite[i])
+                {
+                    for (int j = 0; j < num; ++j)
+                        dest[j] = src[done + j] >> bitsToShift;
+                }
+                else
+                {
+                    zeromem (dest, (size_t) num * sizeof (FlacNamespace::FLAC__int32));
+                }
+            }
+
+            chunk.numSamples += num;
+            done += num;
+
+            if (chunk.numSamples == samplesPerChunk)
+                submitCurrentChunk();
+        }
+
+        return ! failed;
+    }
+
+    bool ok = false;
+
+private:
+    //==============================================================================
+    struct Chunk
+    {
+        Chunk (int channels, int samplesPerChannel)
+            : samples ((size_t) channels * (size_t) samplesPerChannel),
+              channelSize (samplesPerChannel)
+        {}
+
+        FlacNamespace::FLAC__int32* getChannel (int channel) const noexcept     { return samples + (size_t) channel * (size_t) channelSize; }
+
+        HeapBlock<FlacNamespace::FLAC__int32> samples;
+        int channelSize, numSamples = 0;
+
+        MemoryOutputStream encodedFrames;
+        Array<int> frameSizes;
+        std::atomic<bool> claimed { false };
+        bool succeeded = false;
+        WaitableEvent finished { true };
+    };
+
+    std::shared_ptr<Chunk> getSpareChunk()
+    {
+        if (spareChunks.empty())
+            return std::make_shared<Chunk> ((int) numChannels, blockSize * framesPerChunk);
+
+        auto chunk = std::move (spareChunks.back());
+        spareChunks.pop_back();
+        return chunk;
+    }
+
+    void submitCurrentChunk()
+    {
+        auto chunk = std::move (currentChunk);
+        pendingChunks.push_back (chunk);
+
+        // Whichever of the pool and the writing thread gets to a chunk first encodes it,
+        // so that the writer can't get stuck waiting for a pool that's busy elsewhere.
+        threadPool.addJob ([this, chunk]
+        {
+            if (! chunk->claimed.exchange (true))
+            {
+                encodeChunk (*chunk);
+                chunk->finished.signal();
+            }
+        });
+
+        // Write out anything that's ready, and if too many chunks are queued up, block until
+        // the oldest one is done, so that the amount of memory in use stays bounded.
+        while (! pendingChunks.empty()
+                && (pendingChunks.size() > maxChunksInFlight || pendingChunks.front()->finished.wait (0)))
+            writeNextChunk();
+    }
+
+    // Called on a pool thread
+    void encodeChunk (Chunk& chunk) const
+    {
+        using namespace FlacNamespace;
+
+        chunk.encodedFrames.reset();
+        chunk.frameSizes.clearQuick();
+        chunk.succeeded = false;
+
+        auto* encoder = FLAC__stream_encoder_new();
+
+        if (encoder == nullptr)
+            return;
+
+        FlacStreamHelpers::configureEncoder (encoder, sampleRate, numChannels, bitsPerSample, quality);
+        FLAC__stream_encoder_set_do_md5 (encoder, false);
+
+        const FLAC__int32* channels[FLAC__MAX_CHANNELS] = {};
+
+        for (int i = 0; i < (int) numChannels; ++i)
+            channels[i] = chunk.getChannel (i);
+
+        chunk.succeeded = FLAC__stream_encoder_init_stream (encoder, chunkWriteCallback, nullptr, nullptr, nullptr, &chunk)
+                            == FLAC__STREAM_ENCODER_INIT_STATUS_OK
+                          && FLAC__stream_encoder_process (encoder, channels, (unsigned) chunk.numSamples)
+                          && FLAC__stream_encoder_finish (encoder);
+
+        FLAC__stream_encoder_delete (encoder);
+    }
+
+    void writeNextChunk()
+    {
+        auto chunk = std::move (pendingChunks.front());
+        pendingChunks.erase (pendingChunks.begin());
+
+        if (! chunk->claimed.exchange (true))
+            encodeChunk (*chunk);
+        else
+            chunk->finished.wait();
+
+        if (! chunk->succeeded)
+            failed = true;
+
+        if (! failed)
+        {
+           #if JUCE_INCLUDE_FLAC_CODE || ! defined (JUCE_INCLUDE_FLAC_CODE)
+            const FlacNamespace::FLAC__int32* channels[FLAC__MAX_CHANNELS] = {};
+
+            for (int i = 0; i < (int) numChannels; ++i)
+                channels[i] = chunk->getChannel (i);
+
+            FlacNamespace::FLAC__MD5Accumulate (&md5, channels, numChannels, (uint32_t) chunk->numSamples, (bitsPerSample + 7) / 8);
+           #endif
+
+            auto* frame = static_cast<const uint8*> (chunk->encodedFrames.getData());
+
+            for (auto frameSize : chunk->frameSizes)
+            {
+                if (! writeFrame (frame, (size_t) frameSize))
+                {
+                    failed = true;
+                    break;
+                }
+
+                frame += frameSize;
+            }
+
+            totalSamples += chunk->numSamples;
+        }
+
+        // A chunk can only be reused once the pool has let go of it
+        if (chunk.use_count() == 1)
+        {
+            chunk->numSamples = 0;
+            chunk->claimed = false;
+            chunk->finished.reset();
+            spareChunks.push_back (std::move (chunk));
+        }
+    }
+
+    bool writeFrame (const uint8* frame, size_t frameSize)
+    {
+        const auto header = FlacStreamHelpers::FrameHeader::parse (frame, frameSize);
+
+        if (! header.has_value() || header->hasVariableBlockSize)
+        {
+            jassertfalse; // the encoder produced something that doesn't look like a frame!
+            return false;
+        }
+
+        const auto frameNumber = (uint64) frameOffsets.size();
+
+        if (header->number != frameNumber)
+        {
+            frameSize = FlacStreamHelpers::renumberFrame (frame, frameSize, *header, frameNumber, renumberedFrame);
+            frame = static_cast<const uint8*> (renumberedFrame.getData());
+        }
+
+        frameOffsets.add (output->getPosition() - firstFramePos);
+        minFrameSize = jmin (minFrameSize, (uint32) frameSize);
+        maxFrameSize = jmax (maxFrameSize, (uint32) frameSize);
+
+        return output->write (frame, frameSize);
+    }
+
+    //==============================================================================
+    static constexpr uint32 streamInfoBlockType = 0, seekTableBlockType = 3;
+    static constexpr int seekPointSize = 18;
+
+    bool writeHeader()
+    {
+        using namespace FlacNamespace;
+        MemoryOutputStream header;
+
+        // The STREAMINFO body and the seek points are placeholders until the stream is finished
+        header.write ("fLaC", 4);
+        header.writeIntBigEndian ((int) ((streamInfoBlockType << 24) | FLAC__STREAM_METADATA_STREAMINFO_LENGTH));
+        header.writeRepeatedByte (0, FLAC__STREAM_METADATA_STREAMINFO_LENGTH);
+        header.writeIntBigEndian ((int) ((0x80u << 24) | (seekTableBlockType << 24) | (uint32) (numSeekPoints * seekPointSize)));
+
+        for (int i = 0; i < numSeekPoints; ++i)
+        {
+            header.writeInt64BigEndian ((int64) FLAC__STREAM_METADATA_SEEKPOINT_PLACEHOLDER);
+            header.writeRepeatedByte (0, seekPointSize - 8);
+        }
+
+        firstFramePos = streamStartPos + (int64) header.getDataSize();
+        return output->write (header.getData(), header.getDataSize());
+    }
+
+    void writeStreamInfoAndSeekTable()
+    {
+        using namespace FlacNamespace;
+
+        FLAC__StreamMetadata_StreamInfo info {};
+        info.min_blocksize = info.max_blocksize = (uint32_t) blockSize;
+        info.min_framesize = frameOffsets.isEmpty() ? 0 : minFrameSize;
+        info.max_framesize = maxFrameSize;
+        info.sample_rate = (uint32_t) sampleRate;
+        info.channels = numChannels;
+        info.bits_per_sample = bitsPerSample;
+        info.total_samples = (FLAC__uint64) totalSamples;
+
+       #if JUCE_INCLUDE_FLAC_CODE || ! defined (JUCE_INCLUDE_FLAC_CODE)
+        FLAC__MD5Final (info.md5sum, &md5);
+       #endif
+
+        uint8 streamInfo[FLAC__STREAM_METADATA_STREAMINFO_LENGTH];
+        FlacStreamHelpers::packStreamInfo (info, streamInfo);
+
+        // Spread the seek points evenly across the frames, leaving any spare ones as placeholders
+        HeapBlock<uint8> seekTable ((size_t) (numSeekPoints * seekPointSize));
+        const auto numFrames = frameOffsets.size();
+        const auto framesPerPoint = jmax (1, (numFrames + numSeekPoints - 1) / numSeekPoints);
+        int numPoints = 0;
+
+        for (int frame = 0; frame < numFrames; frame += framesPerPoint, ++numPoints)
+        {
+            auto* point = seekTable + numPoints * seekPointSize;
+            const auto firstSample = (int64) frame * blockSize;
+
+            FlacStreamHelpers::packUint64 ((uint64) firstSample, point);
+            FlacStreamHelpers::packUint64 ((uint64) frameOffsets.getUnchecked (frame), point + 8);
+            FlacStreamHelpers::packUint32 ((FLAC__uint32) jmin ((int64) blockSize, totalSamples - firstSample), point + 16, 2);
+        }
+
+        for (int i = numPoints; i < numSeekPoints; ++i)
+        {
+            auto* point = seekTable + i * seekPointSize;
+            FlacStreamHelpers::packUint64 (FLAC__STREAM_METADATA_SEEKPOINT_PLACEHOLDER, point);
+            zeromem (point + 8, seekPointSize - 8);
+        }
+
+        const auto endPos = output->getPosition();
+
+        // if this fails, you've given it an output stream that can't seek! It needs
+        // to be able to seek back to write the header
+        [[maybe_unused]] const bool seekOk = output->setPosition (streamStartPos + 8);
+        jassert (seekOk);
+
+        output->write (streamInfo, sizeof (streamInfo));
+        output->setPosition (firstFramePos - numSeekPoints * seekPointSize);
+        output->write (seekTable, (size_t) (numSeekPoints * seekPointSize));
+        output->setPosition (endPos);
+    }
+
+    //==============================================================================
+    static FlacNamespace::FLAC__StreamEncoderWriteStatus chunkWriteCallback (const FlacNamespace::FLAC__StreamEncoder*,
+                                                                             const FlacNamespace::FLAC__byte buffer[],
+                                                                             size_t bytes,
+                                                                             unsigned int samples,
+                                                                             unsigned int /*current_frame*/,
+                                                                             void* client_data)
+    {
+        // The "fLaC" marker and metadata are passed through here with a sample count of
+        // zero. Only the frames are needed, so those other bits get dropped.
+        if (samples > 0)
+        {
+            auto& chunk = *static_cast<Chunk*> (client_data);
+
+            if (! chunk.encodedFrames.write (buffer, bytes))
+                return FlacNamespace::FLAC__STREAM_ENCODER_WRITE_STATUS_FATAL_ERROR;
+
+            chunk.frameSizes.add ((int) bytes);
+        }
+
+        return FlacNamespace::FLAC__STREAM_ENCODER_WRITE_STATUS_OK;
+    }
+
+    static FlacNamespace::FLAC__StreamEncoderWriteStatus discardingWriteCallback (const FlacNamespace::FLAC__StreamEncoder*,
+                                                                                  const FlacNamespace::FLAC__byte[], size_t,
+                                                                                  unsigned int, unsigned int, void*)
+    {
+        return FlacNamespace::FLAC__STREAM_ENCODER_WRITE_STATUS_OK;
+    }
+
+    //==============================================================================
+    static constexpr int framesPerChunk = 16;
+    static constexpr int numSeekPoints = 256;
+
+    ThreadPool& threadPool;
+    const int quality;
+    const int64 streamStartPos;
+    const size_t maxChunksInFlight;
+    int blockSize = 0;
+    int64 firstFramePos = 0, totalSamples = 0;
+
+    std::shared_ptr<Chunk> currentChunk;
+    std::vector<std::shared_ptr<Chunk>> pendingChunks, spareChunks;
+
+    MemoryBlock renumberedFrame;
+    Array<int64> frameOffsets;
+    uint32 minFrameSize = std::numeric_limits<uint32>::max(), maxFrameSize = 0;
+    bool failed = false;
+
+   #if JUCE_INCLUDE_FLAC_CODE || ! defined (JUCE_INCLUDE_FLAC_CODE)
+    FlacNamespace::FLAC__MD5Context md5;
+   #endif
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParallelFlacWriter)
+};
+
 
 //==============================================================================
 FlacAudioFormat::FlacAudioFormat()  : AudioFormat (flacFormatName, ".flac") {}
@@ -618,11 +1607,331 @@ std::unique_ptr<AudioFormatWriter> FlacAudioFormat::createWriterFor (std::unique
     return writer;
 }
 
+std::unique_ptr<AudioFormatWriter> FlacAudioFormat::createParallelWriterFor (std::unique_ptr<OutputStream>& streamToWriteTo,
+                                                                             const AudioFormatWriterOptions& options,
+                                                                             ThreadPool& threadPool)
+{
+    if (streamToWriteTo == nullptr || ! getPossibleBitDepths().contains (options.getBitsPerSample()))
+        return nullptr;
+
+    auto writer = std::make_unique<ParallelFlacWriter> (streamToWriteTo.get(),
+                                                        options.getSampleRate(),
+                                                        (uint32) options.getNumChannels(),
+                                                        (uint32) options.getBitsPerSample(),
+                                                        options.getQualityOptionIndex(),
+                                                        threadPool);
+
+    if (! writer->ok)
+        return nullptr;
+
+    streamToWriteTo.release();
+    return writer;
+}
+
+std::unique_ptr<AudioFormatReader> FlacAudioFormat::createParallelReaderFor (std::unique_ptr<InputStream> sourceStream,
+                                                                             ThreadPool& threadPool)
+{
+    if (sourceStream == nullptr)
+        return nullptr;
+
+    auto reader = std::make_unique<FlacReader> (sourceStream.release(), &threadPool);
+
+    if (reader->sampleRate > 0)
+        return reader;
+
+    return nullptr;
+}
+
 StringArray FlacAudioFormat::getQualityOptions()
 {
     return { "0 (Fastest)", "1", "2", "3", "4", "5 (Default)","6", "7", "8 (Highest quality)" };
 }
 
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct FlacTestSignal
+{
+    FlacTestSignal (int numChannelsIn, int numSamplesIn, int bitsPerSample, Random& random)
+        : numChannels (numChannelsIn), numSamples (numSamplesIn),
+          data ((size_t) (numChannels * jmax (1, numSamples)))
+    {
+        // A few tones with some noise on top, so that the encoder has something
+        // realistic to chew on, left-aligned the same way that the readers return them
+        const auto maxValue = (1 << (bitsPerSample - 1)) - 1;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto* dest = getChannel (ch);
+            const auto frequency = 0.01 + 0.003 * ch;
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const auto value = 0.6 * std::sin (frequency * i) + 0.2 * std::sin (0.0007 * i * (ch + 1))
+                                     + 0.05 * (random.nextDouble() - 0.5);
+                dest[i] = roundToInt (value * maxValue) * (1 << (32 - bitsPerSample));
+            }
+        }
+    }
+
+    int* getChannel (int channel) const noexcept    { return data + channel * jmax (1, numSamples); }
+
+    Array<const int*> getChannels (int offset) const
+    {
+        Array<const int*> channels;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            channels.add (getChannel (ch) + offset);
+
+        channels.add (nullptr);
+        return channels;
+    }
+
+    int numChannels, numSamples;
+    HeapBlock<int> data;
+};
+
+static MemoryBlock writeFlacTestFile (const FlacTestSignal& signal, int bitsPerSample, ThreadPool* pool, Random& random)
+{
+    FlacAudioFormat format;
+    MemoryBlock block;
+
+    {
+        const auto options = AudioFormatWriterOptions{}.withSampleRate (48000.0)
+                                                       .withNumChannels (signal.numChannels)
+                                                       .withBitsPerSample (bitsPerSample);
+
+        std::unique_ptr<OutputStream> stream = std::make_unique<MemoryOutputStream> (block, false);
+        auto writer = pool != nullptr ? format.createParallelWriterFor (stream, options, *pool)
+                                      : format.createWriterFor (stream, options);
+
+        if (writer == nullptr)
+            return {};
+
+        for (int pos = 0; pos < signal.numSamples;)
+        {
+            const auto num = jmin (signal.numSamples - pos, 1 + random.nextInt (20000));
+            writer->write (signal.getChannels (pos).getRawDataPointer(), num);
+            pos += num;
+        }
+    }
+
+    return block;
+}
+
+static bool readerMatchesFlacTestSignal (AudioFormatReader& reader, const FlacTestSignal& signal, int64 start, int numSamples)
+{
+    HeapBlock<int> buffer ((size_t) (signal.numChannels * numSamples));
+    Array<int*> channels;
+
+    for (int ch = 0; ch < signal.numChannels; ++ch)
+        channels.add (buffer + ch * numSamples);
+
+    if (! reader.read (channels.getRawDataPointer(), signal.numChannels, start, numSamples, false))
+        return false;
+
+    for (int ch = 0; ch < signal.numChannels; ++ch)
+        for (int i = 0; i < numSamples; ++i)
+            if (channels[ch][i] != (start + i < signal.numSamples ? signal.getChannel (ch)[start + i] : 0))
+                return false;
+
+    return true;
+}
+
+class FlacAudioFormatTests final : public UnitTest
+{
+public:
+    FlacAudioFormatTests()
+        : UnitTest ("FLAC audio format tests", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+        ThreadPool pool (3);
+        FlacAudioFormat format;
+
+        struct Setup { int numChannels, bitsPerSample, numSamples; };
+
+        for (auto setup : { Setup { 1, 16, 1000 }, Setup { 2, 24, 300000 }, Setup { 8, 24, 70001 }, Setup { 2, 16, 0 } })
+        {
+            const FlacTestSignal signal (setup.numChannels, setup.numSamples, setup.bitsPerSample, random);
+            const auto serialFile   = writeFlacTestFile (signal, setup.bitsPerSample, nullptr, random);
+            const auto parallelFile = writeFlacTestFile (signal, setup.bitsPerSample, &pool, random);
+
+            const auto description = String (setup.numChannels) + " channels, " + String (setup.bitsPerSample)
+                                        + " bits, " + String (setup.numSamples) + " samples";
+
+            beginTest ("Parallel writer output is lossless (" + description + ")");
+            {
+                expect (! parallelFile.isEmpty());
+
+                std::unique_ptr<AudioFormatReader> reader (format.createReaderFor (new MemoryInputStream (parallelFile, false), true));
+                expect (reader != nullptr);
+                expectEquals (reader->lengthInSamples, (int64) signal.numSamples);
+                expectEquals ((int) reader->numChannels, signal.numChannels);
+                expectEquals ((int) reader->bitsPerSample, setup.bitsPerSample);
+                expect (readerMatchesFlacTestSignal (*reader, signal, 0, signal.numSamples + 10));
+                expect (readerMatchesFlacTestSignal (*reader, signal, signal.numSamples / 3, signal.numSamples / 2));
+            }
+
+            beginTest ("Parallel writer fills in the stream info and seek table (" + description + ")");
+            {
+                auto* data = static_cast<const uint8*> (parallelFile.getData());
+
+                // The MD5 signature of the audio should match the one libFLAC generates itself
+                expect (memcmp (data + 8 + 18, static_cast<const uint8*> (serialFile.getData()) + 8 + 18, 16) == 0);
+
+                const auto seekTableHeader = ByteOrder::bigEndianInt (data + 8 + 34);
+                expectEquals ((int) (seekTableHeader >> 24), 0x83);
+
+                const auto numPoints = (int) (seekTableHeader & 0xffffff) / 18;
+                const auto firstFrame = (size_t) (8 + 34 + 4 + numPoints * 18);
+                int64 lastSample = -1;
+
+                for (int i = 0; i < numPoints; ++i)
+                {
+                    const auto* point = data + 8 + 34 + 4 + i * 18;
+                    const auto sample = (int64) ByteOrder::bigEndianInt64 (point);
+
+                    if (sample == -1)
+                        break;
+
+                    const auto frameStart = firstFrame + (size_t) ByteOrder::bigEndianInt64 (point + 8);
+                    expect (frameStart < parallelFile.getSize());
+
+                    if (frameStart >= parallelFile.getSize())
+                        break;
+
+                    const auto header = FlacStreamHelpers::FrameHeader::parse (data + frameStart, parallelFile.getSize() - frameStart);
+
+                    expect (sample > lastSample);
+                    expect (header.has_value() && (int64) header->number * 4096 == sample);
+                    lastSample = sample;
+                }
+
+                expect (setup.numSamples == 0 || lastSample >= 0);
+            }
+
+            beginTest ("Parallel reader matches the source (" + description + ")");
+            {
+                for (auto* file : { &serialFile, &parallelFile })
+                {
+                    auto reader = format.createParallelReaderFor (std::make_unique<MemoryInputStream> (*file, false), pool);
+                    expect (reader != nullptr);
+
+                    expect (readerMatchesFlacTestSignal (*reader, signal, 0, signal.numSamples + 100));
+
+                    for (int pos = 0; pos < signal.numSamples; pos += 100000)
+                        expect (readerMatchesFlacTestSignal (*reader, signal, pos, 100000));
+
+                    for (int i = 0; i < 20; ++i)
+                    {
+                        const auto start = random.nextInt (jmax (1, signal.numSamples));
+                        expect (readerMatchesFlacTestSignal (*reader, signal, start, 1 + random.nextInt (150000)));
+                    }
+                }
+            }
+        }
+
+        beginTest ("Frame numbers can be rewritten");
+        {
+            for (auto number : { (uint64) 0, (uint64) 0x7f, (uint64) 0x80, (uint64) 0x7ff, (uint64) 0x800,
+                                 (uint64) 0xffff, (uint64) 0x10000, (uint64) 0x1fffff, (uint64) 0x7fffffff })
+            {
+                uint8 frame[32] = { 0xff, 0xf8, 0xc9, 0x18 };
+                auto pos = 4 + FlacStreamHelpers::writeCodedNumber (frame + 4, 5);
+                frame[pos] = FlacStreamHelpers::Checksums::crc8 (frame, pos);
+                pos += 1 + 4;
+                const auto crc = FlacStreamHelpers::Checksums::crc16 (frame, pos);
+                frame[pos++] = (uint8) (crc >> 8);
+                frame[pos++] = (uint8) crc;
+
+                const auto header = FlacStreamHelpers::FrameHeader::parse (frame, pos);
+                expect (header.has_value() && header->number == 5 && header->blockSize == 4096);
+
+                MemoryBlock renumbered;
+                const auto newSize = FlacStreamHelpers::renumberFrame (frame, pos, *header, number, renumbered);
+                const auto* newFrame = static_cast<const uint8*> (renumbered.getData());
+                const auto newHeader = FlacStreamHelpers::FrameHeader::parse (newFrame, newSize);
+
+                expect (newHeader.has_value() && newHeader->number == number);
+                expectEquals ((int) FlacStreamHelpers::Checksums::crc16 (newFrame, newSize), 0);
+            }
+        }
+    }
+};
+
+static FlacAudioFormatTests flacAudioFormatTests;
+
+//==============================================================================
+class FlacAudioFormatBenchmarks final : public UnitTest
+{
+public:
+    FlacAudioFormatBenchmarks()
+        : UnitTest ("FLAC audio format benchmarks", UnitTestCategories::benchmarks)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Serial vs parallel encoding and decoding");
+
+        // An hour of 8-channel audio is several gigabytes, so this times a minute of it
+        // and scales the results up.
+        constexpr int numChannels = 8, bitsPerSample = 24, sampleRate = 48000, numSeconds = 60;
+        auto random = getRandom();
+        ThreadPool pool (jmax (1, SystemStats::getNumCpus() - 1));
+        FlacAudioFormat format;
+
+        const FlacTestSignal signal (numChannels, sampleRate * numSeconds, bitsPerSample, random);
+
+        const auto report = [this] (const String& what, double seconds)
+        {
+            logMessage (what + ": " + String (seconds, 2) + " s, " + String (numSeconds / seconds, 1)
+                          + "x real time, about " + String (roundToInt (seconds * 60.0)) + " s for a 1 hour file");
+        };
+
+        MemoryBlock serialFile, parallelFile;
+
+        {
+            const auto start = Time::getMillisecondCounterHiRes();
+            serialFile = writeFlacTestFile (signal, bitsPerSample, nullptr, random);
+            report ("Serial encode", (Time::getMillisecondCounterHiRes() - start) / 1000.0);
+        }
+
+        {
+            const auto start = Time::getMillisecondCounterHiRes();
+            parallelFile = writeFlacTestFile (signal, bitsPerSample, &pool, random);
+            report ("Parallel encode (" + String (pool.getNumThreads() + 1) + " threads)",
+                    (Time::getMillisecondCounterHiRes() - start) / 1000.0);
+        }
+
+        logMessage ("Sizes: serial " + File::descriptionOfSizeInBytes ((int64) serialFile.getSize())
+                      + ", parallel " + File::descriptionOfSizeInBytes ((int64) parallelFile.getSize()));
+
+        const auto timeReading = [&] (std::unique_ptr<AudioFormatReader> reader)
+        {
+            constexpr int blockSize = 1 << 18;
+            AudioBuffer<float> buffer (numChannels, blockSize);
+            const auto start = Time::getMillisecondCounterHiRes();
+
+            for (int64 pos = 0; pos < reader->lengthInSamples; pos += blockSize)
+                reader->read (&buffer, 0, blockSize, pos, true, true);
+
+            return (Time::getMillisecondCounterHiRes() - start) / 1000.0;
+        };
+
+        report ("Serial decode", timeReading (std::unique_ptr<AudioFormatReader> (format.createReaderFor (new MemoryInputStream (parallelFile, false), true))));
+        report ("Parallel decode", timeReading (format.createParallelReaderFor (std::make_unique<MemoryInputStream> (parallelFile, false), pool)));
+    }
+};
+
+static FlacAudioFormatBenchmarks flacAudioFormatBenchmarks;
+
+#endif
+
 #endif
 
 } // namespace juce
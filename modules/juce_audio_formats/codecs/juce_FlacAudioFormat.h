@@ -71,6 +71,37 @@ public:
 
     using AudioFormat::createWriterFor;
 
+    //==============================================================================
+    /** Creates a writer that encodes on the threads of a ThreadPool.
+
+        The audio is split into chunks of whole frames, each of which is encoded by its
+        own encoder on the pool, and the results are written out in order on the thread
+        that calls write(). The file also gets a seek table, which the reader returned
+        by createParallelReaderFor() uses to split up its work.
+
+        The stream must be seekable, as the header is filled in when the writer is
+        deleted. The pool must outlive the writer.
+
+        If the writer can't be created, this returns nullptr and leaves the stream
+        in streamToWriteTo, otherwise the writer takes ownership of it.
+    */
+    std::unique_ptr<AudioFormatWriter> createParallelWriterFor (std::unique_ptr<OutputStream>& streamToWriteTo,
+                                                                const AudioFormatWriterOptions& options,
+                                                                ThreadPool& threadPool);
+
+    /** Creates a reader that decodes large reads on the threads of a ThreadPool.
+
+        Reads of more than a few frames are split into runs of frames, which are found
+        using the file's seek table or by scanning for frame headers, and decoded in
+        parallel. Small reads, and any reads that can't be split up, are decoded on the
+        calling thread as normal. The calling thread also helps with the decoding, so
+        it's safe to use the reader from one of the pool's own threads.
+
+        The pool must outlive the reader. Returns nullptr if the stream isn't a FLAC file.
+    */
+    std::unique_ptr<AudioFormatReader> createParallelReaderFor (std::unique_ptr<InputStream> sourceStream,
+                                                                ThreadPool& threadPool);
+
 private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlacAudioFormat)
 };
@@ -1588,6 +1588,28 @@ struct MP3Stream
         return true;
     }
 
+    /** Parses the rest of the frame headers without decoding any audio, so that the
+        position of every stored frame is known.
+    */
+    void scanToEnd()
+    {
+        for (int attemptsWithoutProgress = 0; attemptsWithoutProgress < 10;)
+        {
+            const auto oldPos = stream.getPosition();
+            int dummy = 0;
+
+            if (decodeNextBlock (nullptr, nullptr, dummy) < 0 || stream.isExhausted())
+                break;
+
+            attemptsWithoutProgress = stream.getPosition() > oldPos ? 0 : attemptsWithoutProgress + 1;
+        }
+    }
+
+    const Array<int64>& getFrameStreamPositions() const noexcept    { return frameStreamPositions; }
+    void setFrameStreamPositions (const Array<int64>& positions)    { frameStreamPositions = positions; }
+
+    static constexpr int getNumFramesPerStreamPosition() noexcept   { return storedStartPosInterval; }
+
     MP3Frame frame;
     VBRTagData vbrTagData;
     BufferedInputStream stream;
@@ -2966,7 +2988,7 @@ static const char* const mp3FormatName = "MP3 file";
 class MP3Reader final : public AudioFormatReader
 {
 public:
-    MP3Reader (InputStream* const in)
+    MP3Reader (InputStream* const in, std::shared_ptr<const AudioSeekIndex> index = nullptr)
         : AudioFormatReader (in, mp3FormatName),
           stream (*in), currentPosition (0),
           decodedStart (0), decodedEnd (0)
@@ -2981,9 +3003,28 @@ public:
             sampleRate = stream.frame.getFrequency();
             numChannels = (unsigned int) stream.frame.numChannels;
             lengthInSamples = findLength (streamPos);
+
+            if (index != nullptr && index->getFormatName() == mp3FormatName && index->matchesStream (*input))
+                loadFramePositions (*index);
         }
     }
 
+    std::unique_ptr<AudioSeekIndex> createSeekIndex()
+    {
+        stream.scanToEnd();
+
+        const auto& positions = stream.getFrameStreamPositions();
+        const auto samplesPerPosition = (int64) MP3Stream::getNumFramesPerStreamPosition() * 1152;
+
+        std::vector<AudioSeekIndex::Point> points;
+        points.reserve ((size_t) positions.size());
+
+        for (int i = 0; i < positions.size(); ++i)
+            points.push_back ({ i * samplesPerPosition, positions.getUnchecked (i) });
+
+        return std::make_unique<AudioSeekIndex> (mp3FormatName, std::move (points), *input);
+    }
+
     bool readSamples (int* const* destSamples, int numDestChannels, int startOffsetInDestBuffer,
                       int64 startSampleInFile, int numSamples) override
     {
@@ -3064,6 +3105,25 @@ private:
     float decoded0[decodedDataSize], decoded1[decodedDataSize];
     int decodedStart, decodedEnd;
 
+    void loadFramePositions (const AudioSeekIndex& index)
+    {
+        // The stream only searches forward for frames it hasn't stored a position for,
+        // so with the whole table loaded, a seek goes straight to the right frame.
+        const auto samplesPerPosition = (int64) MP3Stream::getNumFramesPerStreamPosition() * 1152;
+        Array<int64> positions;
+
+        for (const auto& point : index.getPoints())
+        {
+            if (point.sample != positions.size() * samplesPerPosition)
+                return;
+
+            positions.add (point.byteOffset);
+        }
+
+        if (positions.size() > stream.getFrameStreamPositions().size())
+            stream.setFrameStreamPositions (positions);
+    }
+
     void createEmptyDecodedData() noexcept
     {
         zeromem (decoded0, sizeof (decoded0));
@@ -3173,6 +3233,34 @@ AudioFormatReader* MP3AudioFormat::createReaderFor (InputStream* sourceStream, c
     return nullptr;
 }
 
+AudioFormatReader* MP3AudioFormat::createReaderWithSeekIndex (InputStream* sourceStream, bool deleteStreamIfOpeningFails,
+                                                              std::shared_ptr<const AudioSeekIndex> index)
+{
+    std::unique_ptr<MP3Decoder::MP3Reader> r (new MP3Decoder::MP3Reader (sourceStream, std::move (index)));
+
+    if (r->lengthInSamples > 0)
+        return r.release();
+
+    if (! deleteStreamIfOpeningFails)
+        r->input = nullptr;
+
+    return nullptr;
+}
+
+std::unique_ptr<AudioSeekIndex> MP3AudioFormat::createSeekIndex (InputStream& sourceStream)
+{
+    const auto startPosition = sourceStream.getPosition();
+    MP3Decoder::MP3Reader reader (&sourceStream);
+    std::unique_ptr<AudioSeekIndex> index;
+
+    if (reader.lengthInSamples > 0)
+        index = reader.createSeekIndex();
+
+    reader.input = nullptr;
+    sourceStream.setPosition (startPosition);
+    return index;
+}
+
 std::unique_ptr<AudioFormatWriter> MP3AudioFormat::createWriterFor (std::unique_ptr<OutputStream>&,
                                                                     const AudioFormatWriterOptions&)
 {
@@ -3180,6 +3268,176 @@ std::unique_ptr<AudioFormatWriter> MP3AudioFormat::createWriterFor (std::unique_
     return nullptr;
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class MP3SeekIndexTests final : public UnitTest
+{
+public:
+    MP3SeekIndexTests()
+        : UnitTest ("MP3 seek index tests", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        // A stream of silent 128kbps stereo frames, which are all 417 bytes long
+        constexpr int numFrames = 4000, frameSize = 417;
+        MemoryBlock file ((size_t) (numFrames * frameSize), true);
+
+        for (int i = 0; i < numFrames; ++i)
+        {
+            auto* frame = static_cast<uint8*> (file.getData()) + i * frameSize;
+            frame[0] = 0xff;
+            frame[1] = 0xfb;
+            frame[2] = 0x90;
+        }
+
+        MP3AudioFormat format;
+
+        beginTest ("Index has the position of every fourth frame");
+        {
+            MemoryInputStream source (file, false);
+            const auto index = format.createSeekIndex (source);
+
+            expect (index != nullptr);
+            expect (source.getPosition() == 0);
+            expect (index->getPoints().size() >= (size_t) (numFrames / 4 - 1));
+
+            for (size_t i = 0; i < index->getPoints().size(); ++i)
+            {
+                expect (index->getPoints()[i].sample == (int64) i * 4 * 1152);
+                expect (index->getPoints()[i].byteOffset == (int64) i * 4 * frameSize);
+            }
+        }
+
+        beginTest ("Reads after an indexed seek match a linear read");
+        {
+            // These frames have random Huffman data, so that they don't decode to silence. The
+            // side information of each granule says to read 100 bits of it with table 1, which
+            // any sequence of bits is valid for. main_data_begin is left as zero, so each frame
+            // only uses its own bits rather than data left in the bit reservoir by earlier
+            // frames. The data never contains 0xff, so it can't be mistaken for a frame header.
+            constexpr int numNoisyFrames = 200, sideInfoSize = 32;
+            MemoryBlock noisyFile ((size_t) (numNoisyFrames * frameSize));
+            auto random = getRandom();
+
+            for (int i = 0; i < numNoisyFrames; ++i)
+            {
+                auto* frame = static_cast<uint8*> (noisyFile.getData()) + i * frameSize;
+                frame[0] = 0xff;
+                frame[1] = 0xfb;
+                frame[2] = 0x90;
+                frame[3] = 0x00;
+
+                std::fill (frame + 4, frame + 4 + sideInfoSize, (uint8) 0);
+
+                for (int j = 4 + sideInfoSize; j < frameSize; ++j)
+                    frame[j] = (uint8) random.nextInt (255);
+
+                // main_data_begin, private_bits and scfsi take up the first 20 bits
+                auto bitPosition = 20;
+
+                const auto writeBits = [&] (int value, int numBits)
+                {
+                    for (auto bit = numBits; --bit >= 0; ++bitPosition)
+                        if (((value >> bit) & 1) != 0)
+                            frame[4 + bitPosition / 8] |= (uint8) (0x80 >> (bitPosition % 8));
+                };
+
+                for (int granuleAndChannel = 0; granuleAndChannel < 4; ++granuleAndChannel)
+                {
+                    writeBits (100, 12);    // part2_3_length
+                    writeBits (10, 9);      // big_values
+                    writeBits (210, 8);     // global_gain, which gives a gain of 1
+                    writeBits (0, 5);       // scalefac_compress and window_switching_flag
+                    writeBits (1, 5);       // table_select for each region
+                    writeBits (1, 5);
+                    writeBits (1, 5);
+                    writeBits (0, 10);      // region counts, preflag, scalefac_scale and count1table_select
+                }
+            }
+
+            MemoryInputStream indexSource (noisyFile, false);
+            std::shared_ptr<const AudioSeekIndex> index = format.createSeekIndex (indexSource);
+
+            std::unique_ptr<AudioFormatReader> linear (format.createReaderFor (new MemoryInputStream (noisyFile, false), true));
+            std::unique_ptr<AudioFormatReader> indexed (format.createReaderWithSeekIndex (new MemoryInputStream (noisyFile, false), true, index));
+
+            expect (index != nullptr && linear != nullptr && indexed != nullptr);
+            expect (indexed->lengthInSamples == linear->lengthInSamples);
+
+            const auto length = (int) linear->lengthInSamples;
+            AudioBuffer<float> expected (2, length);
+            expect (linear->read (&expected, 0, length, 0, true, true));
+            expect (expected.getMagnitude (0, length) > 0.0f);
+
+            for (int i = 0; i < 50; ++i)
+            {
+                const auto numSamples = 1 + random.nextInt (3000);
+                const auto start = random.nextInt (length - numSamples);
+
+                AudioBuffer<float> actual (2, numSamples);
+                expect (indexed->read (&actual, 0, numSamples, start, true, true));
+
+                auto matches = true;
+
+                for (int ch = 0; ch < 2; ++ch)
+                    for (int s = 0; s < numSamples; ++s)
+                        matches = matches && exactlyEqual (actual.getSample (ch, s), expected.getSample (ch, start + s));
+
+                expect (matches, "Mismatch reading from " + String (start));
+            }
+        }
+
+        beginTest ("Readers with an index seek without scanning");
+        {
+            struct CountingStream final : public MemoryInputStream
+            {
+                using MemoryInputStream::MemoryInputStream;
+
+                int read (void* destBuffer, int maxBytesToRead) override
+                {
+                    const auto numRead = MemoryInputStream::read (destBuffer, maxBytesToRead);
+                    numBytesRead += numRead;
+                    return numRead;
+                }
+
+                int64 numBytesRead = 0;
+            };
+
+            MemoryInputStream indexSource (file, false);
+            std::shared_ptr<const AudioSeekIndex> index = format.createSeekIndex (indexSource);
+
+            auto* plainStream = new CountingStream (file, false);
+            auto* indexedStream = new CountingStream (file, false);
+            std::unique_ptr<AudioFormatReader> plain (format.createReaderFor (plainStream, true));
+            std::unique_ptr<AudioFormatReader> indexed (format.createReaderWithSeekIndex (indexedStream, true, index));
+
+            expect (plain != nullptr && indexed != nullptr);
+            expect (plain->lengthInSamples == indexed->lengthInSamples);
+
+            AudioBuffer<float> buffer (2, 1000);
+            const auto nearEnd = indexed->lengthInSamples - 5000;
+
+            const auto countBytesRead = [&] (AudioFormatReader& reader, CountingStream& stream)
+            {
+                stream.numBytesRead = 0;
+                expect (reader.read (&buffer, 0, 1000, nearEnd, true, true));
+                return stream.numBytesRead;
+            };
+
+            // Without an index, the reader has to find every frame before the one it wants.
+            // With one, it only reads from the stored position just before that frame.
+            expect (countBytesRead (*plain, *plainStream) > (int64) file.getSize() / 2);
+            expect (countBytesRead (*indexed, *indexedStream) <= 32 * frameSize);
+        }
+    }
+};
+
+static MP3SeekIndexTests mp3SeekIndexTests;
+
+#endif
+
 #endif
 
 } // namespace juce
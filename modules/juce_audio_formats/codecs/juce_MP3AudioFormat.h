@@ -71,6 +71,15 @@ public:
     //==============================================================================
     AudioFormatReader* createReaderFor (InputStream*, bool deleteStreamIfOpeningFails) override;
 
+    /** Records where every few frames begin, so that the reader can go straight to a
+        frame instead of parsing all the frames before it.
+    */
+    std::unique_ptr<AudioSeekIndex> createSeekIndex (InputStream& sourceStream) override;
+
+    AudioFormatReader* createReaderWithSeekIndex (InputStream* sourceStream,
+                                                  bool deleteStreamIfOpeningFails,
+                                                  std::shared_ptr<const AudioSeekIndex> index) override;
+
     std::unique_ptr<AudioFormatWriter> createWriterFor (std::unique_ptr<OutputStream>& streamToWriteTo,
                                                         const AudioFormatWriterOptions& options) override;
 
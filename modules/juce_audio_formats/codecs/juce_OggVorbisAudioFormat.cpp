@@ -124,7 +124,8 @@ const char* const OggVorbisAudioFormat::id3trackNumber = "id3trackNumber";
 class OggReader final : public AudioFormatReader
 {
 public:
-    OggReader (InputStream* inp)  : AudioFormatReader (inp, oggFormatName)
+    OggReader (InputStream* inp, std::shared_ptr<const AudioSeekIndex> index = nullptr)
+        : AudioFormatReader (inp, oggFormatName)
     {
         sampleRate = 0;
         usesFloatingPointData = true;
@@ -156,6 +157,9 @@ public:
             sampleRate = (double) info->rate;
 
             reservoir.setSize ((int) numChannels, (int) jmin (lengthInSamples, (int64) 4096));
+
+            if (index != nullptr && index->getFormatName() == oggFormatName && index->matchesStream (*input))
+                seekIndex = std::move (index);
         }
     }
 
@@ -194,7 +198,7 @@ public:
             bufferedRange = Range<int64> { newStart, newStart + reservoir.getNumSamples() };
 
             if (bufferedRange.getStart() != ov_pcm_tell (&ovFile))
-                ov_pcm_seek (&ovFile, bufferedRange.getStart());
+                seekTo (bufferedRange.getStart());
 
             int bitStream = 0;
             int offset = 0;
@@ -235,6 +239,83 @@ public:
         return true;
     }
 
+    //==============================================================================
+    void seekTo (int64 sample)
+    {
+        // The index gives the search a page just before the target to start from, so
+        // it doesn't have to bisect the file. If the hint turns out to be wrong, the
+        // search fails and this falls back to a normal seek.
+        if (seekIndex != nullptr)
+            if (auto* point = seekIndex->findPointBefore (sample - 1))
+                if (juce_ov_pcm_seek_hinted (&ovFile, sample, point->byteOffset, point->sample) == 0)
+                    return;
+
+        ov_pcm_seek (&ovFile, sample);
+    }
+
+    /*  Walks through the pages of the stream, and records the position of each page that
+        ends a packet, along with its granule position.
+    */
+    static std::unique_ptr<AudioSeekIndex> createSeekIndex (InputStream& source)
+    {
+        constexpr int headerSize = 27;
+
+        const auto startPosition = source.getPosition();
+        std::vector<AudioSeekIndex::Point> points;
+        uint8 header[headerSize + 255];
+        std::optional<uint32> streamSerialNumber;
+
+        for (auto pagePosition = startPosition;;)
+        {
+            source.setPosition (pagePosition);
+
+            if (source.read (header, headerSize) != headerSize)
+                break;
+
+            if (memcmp (header, "OggS", 4) != 0)
+            {
+                // Lost sync, so look for the next capture pattern
+                ++pagePosition;
+                continue;
+            }
+
+            const auto numSegments = (int) header[26];
+
+            if (source.read (header + headerSize, numSegments) != numSegments)
+                break;
+
+            const auto granule = (int64) ByteOrder::littleEndianInt64 (header + 6);
+            const auto serialNumber = ByteOrder::littleEndianInt (header + 14);
+            const auto isFirstPageOfStream = (header[5] & 2) != 0;
+
+            if (! streamSerialNumber.has_value())
+                streamSerialNumber = serialNumber;
+
+            if (serialNumber == *streamSerialNumber)
+            {
+                if (granule > 0 && (points.empty() || granule > points.back().sample))
+                    points.push_back ({ granule, pagePosition });
+            }
+            else if (isFirstPageOfStream)
+            {
+                // Chained streams restart their positions at each link, which a simple
+                // table can't represent
+                source.setPosition (startPosition);
+                return nullptr;
+            }
+
+            auto bodySize = 0;
+
+            for (int i = 0; i < numSegments; ++i)
+                bodySize += header[headerSize + i];
+
+            pagePosition += headerSize + numSegments + bodySize;
+        }
+
+        source.setPosition (startPosition);
+        return std::make_unique<AudioSeekIndex> (oggFormatName, std::move (points), source);
+    }
+
     //==============================================================================
     static size_t oggReadCallback (void* ptr, size_t size, size_t nmemb, void* datasource)
     {
@@ -269,6 +350,7 @@ private:
     OggVorbisNamespace::ov_callbacks callbacks;
     AudioBuffer<float> reservoir;
     Range<int64> bufferedRange;
+    std::shared_ptr<const AudioSeekIndex> seekIndex;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OggReader)
 };
@@ -463,6 +545,25 @@ AudioFormatReader* OggVorbisAudioFormat::createReaderFor (InputStream* in, bool
     return nullptr;
 }
 
+AudioFormatReader* OggVorbisAudioFormat::createReaderWithSeekIndex (InputStream* in, bool deleteStreamIfOpeningFails,
+                                                                    std::shared_ptr<const AudioSeekIndex> index)
+{
+    std::unique_ptr<OggReader> r (new OggReader (in, std::move (index)));
+
+    if (r->sampleRate > 0)
+        return r.release();
+
+    if (! deleteStreamIfOpeningFails)
+        r->input = nullptr;
+
+    return nullptr;
+}
+
+std::unique_ptr<AudioSeekIndex> OggVorbisAudioFormat::createSeekIndex (InputStream& sourceStream)
+{
+    return OggReader::createSeekIndex (sourceStream);
+}
+
 std::unique_ptr<AudioFormatWriter> OggVorbisAudioFormat::createWriterFor (std::unique_ptr<OutputStream>& streamToWriteTo,
                                                                           const AudioFormatWriterOptions& options)
 {
@@ -522,6 +623,274 @@ int OggVorbisAudioFormat::estimateOggFileQuality (const File& source)
     return 0;
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+static MemoryBlock writeOggTestFile (int numChannels, int numSamples, Random& random)
+{
+    AudioBuffer<float> signal (numChannels, numSamples);
+
+    for (int ch = 0; ch < numChannels; ++ch)
+        for (int i = 0; i < numSamples; ++i)
+            signal.setSample (ch, i, 0.5f * std::sin (0.02f * (float) i * (float) (ch + 1))
+                                       + 0.1f * (random.nextFloat() - 0.5f));
+
+    OggVorbisAudioFormat format;
+    MemoryBlock block;
+
+    {
+        std::unique_ptr<OutputStream> stream = std::make_unique<MemoryOutputStream> (block, false);
+        auto writer = format.createWriterFor (stream, AudioFormatWriterOptions{}.withSampleRate (44100.0)
+                                                                                 .withNumChannels (numChannels));
+
+        if (writer == nullptr || ! writer->writeFromAudioSampleBuffer (signal, 0, numSamples))
+            return {};
+    }
+
+    return block;
+}
+
+class OggVorbisSeekIndexTests final : public UnitTest
+{
+public:
+    OggVorbisSeekIndexTests()
+        : UnitTest ("Ogg-Vorbis seek index tests", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+        OggVorbisAudioFormat format;
+        const auto file = writeOggTestFile (2, 44100 * 20, random);
+
+        beginTest ("Index covers the stream");
+        {
+            MemoryInputStream source (file, false);
+            const auto index = format.createSeekIndex (source);
+
+            expect (index != nullptr);
+            expect (source.getPosition() == 0);
+            expect (index->getPoints().size() > 10);
+
+            for (size_t i = 1; i < index->getPoints().size(); ++i)
+            {
+                expect (index->getPoints()[i].sample > index->getPoints()[i - 1].sample);
+                expect (index->getPoints()[i].byteOffset > index->getPoints()[i - 1].byteOffset);
+            }
+
+            expect (index->findPointBefore (-1) == nullptr);
+            expect (index->findPointBefore (index->getPoints().back().sample) == &index->getPoints().back());
+        }
+
+        beginTest ("Indexes can be saved and checked against their streams");
+        {
+            MemoryInputStream source (file, false);
+            const auto index = format.createSeekIndex (source);
+
+            MemoryOutputStream saved;
+            expect (index->writeToStream (saved));
+
+            MemoryInputStream savedIn (saved.getData(), saved.getDataSize(), false);
+            const auto loaded = AudioSeekIndex::readFromStream (savedIn);
+
+            expect (loaded != nullptr);
+            expect (loaded->getFormatName() == format.getFormatName());
+            expect (loaded->getPoints().size() == index->getPoints().size());
+
+            for (size_t i = 0; i < index->getPoints().size(); ++i)
+            {
+                expect (loaded->getPoints()[i].sample == index->getPoints()[i].sample);
+                expect (loaded->getPoints()[i].byteOffset == index->getPoints()[i].byteOffset);
+            }
+
+            expect (loaded->matchesStream (source));
+
+            auto changed = file;
+            changed[changed.getSize() - 10] ^= 1;
+            MemoryInputStream changedSource (changed, false);
+            expect (! loaded->matchesStream (changedSource));
+
+            MemoryInputStream garbage ("not an index", 12, false);
+            expect (AudioSeekIndex::readFromStream (garbage) == nullptr);
+
+            // An empty index ends with its number of points, which is replaced here by a
+            // count that's far bigger than the data that follows it
+            MemoryOutputStream empty;
+            expect (AudioSeekIndex (format.getFormatName(), {}, source).writeToStream (empty));
+
+            MemoryOutputStream corrupt;
+            corrupt.write (empty.getData(), empty.getDataSize() - 1);
+            corrupt.writeCompressedInt (std::numeric_limits<int>::max());
+            corrupt.writeCompressedInt (0);
+
+            MemoryInputStream corruptIn (corrupt.getData(), corrupt.getDataSize(), false);
+            expect (AudioSeekIndex::readFromStream (corruptIn) == nullptr);
+        }
+
+        beginTest ("Random reads with an index match a sequential decode");
+        {
+            MemoryInputStream indexSource (file, false);
+            std::shared_ptr<const AudioSeekIndex> index = format.createSeekIndex (indexSource);
+
+            std::unique_ptr<AudioFormatReader> sequential (format.createReaderFor (new MemoryInputStream (file, false), true));
+            std::unique_ptr<AudioFormatReader> indexed (format.createReaderWithSeekIndex (new MemoryInputStream (file, false), true, index));
+
+            expect (sequential != nullptr && indexed != nullptr);
+            expect (indexed->lengthInSamples == sequential->lengthInSamples);
+
+            const auto length = (int) sequential->lengthInSamples;
+            AudioBuffer<float> expected (2, length);
+            sequential->read (&expected, 0, length, 0, true, true);
+
+            for (int i = 0; i < 200; ++i)
+            {
+                const auto numSamples = 1 + random.nextInt (5000);
+                const auto start = random.nextInt (length - numSamples);
+
+                AudioBuffer<float> actual (2, numSamples);
+                indexed->read (&actual, 0, numSamples, start, true, true);
+
+                auto maxDifference = 0.0f;
+
+                for (int ch = 0; ch < 2; ++ch)
+                    for (int s = 0; s < numSamples; ++s)
+                        maxDifference = jmax (maxDifference, std::abs (actual.getSample (ch, s) - expected.getSample (ch, start + s)));
+
+                expect (maxDifference < 1.0e-6f, "Mismatch reading from " + String (start));
+            }
+        }
+
+        beginTest ("Readers ignore indexes for other streams");
+        {
+            const auto otherFile = writeOggTestFile (1, 44100 * 3, random);
+            MemoryInputStream otherSource (otherFile, false);
+            std::shared_ptr<const AudioSeekIndex> otherIndex = format.createSeekIndex (otherSource);
+
+            std::unique_ptr<AudioFormatReader> sequential (format.createReaderFor (new MemoryInputStream (file, false), true));
+            std::unique_ptr<AudioFormatReader> reader (format.createReaderWithSeekIndex (new MemoryInputStream (file, false), true, otherIndex));
+
+            AudioBuffer<float> expected (2, 1000), actual (2, 1000);
+            sequential->read (&expected, 0, 1000, 300000, true, true);
+            reader->read (&actual, 0, 1000, 300000, true, true);
+
+            for (int ch = 0; ch < 2; ++ch)
+                expect (exactlyEqual (FloatVectorOperations::findMaximum (actual.getReadPointer (ch), 1000),
+                                      FloatVectorOperations::findMaximum (expected.getReadPointer (ch), 1000)));
+        }
+
+        beginTest ("Cache builds, saves and reloads indexes");
+        {
+            const TemporaryFile tempFolder;
+            const auto folder = tempFolder.getFile();
+            expect (folder.createDirectory());
+
+            const auto audioFile = folder.getChildFile ("test.ogg");
+            expect (audioFile.replaceWithData (file.getData(), file.getSize()));
+
+            ThreadPool pool (1);
+
+            {
+                AudioSeekIndexCache cache (pool);
+                expect (cache.getIndexFor (audioFile) == nullptr);
+
+                WaitableEvent finished;
+                std::shared_ptr<const AudioSeekIndex> built;
+
+                cache.buildIndex (audioFile, format, [&] (auto index)
+                {
+                    built = index;
+                    finished.signal();
+                });
+
+                expect (finished.wait (10000));
+                expect (built != nullptr);
+                expect (cache.getIndexFor (audioFile) == built);
+            }
+
+            expect (AudioSeekIndex::getDefaultIndexFileFor (audioFile).existsAsFile());
+
+            AudioSeekIndexCache reloaded (pool);
+            expect (reloaded.getIndexFor (audioFile) != nullptr);
+
+            const auto reader = reloaded.createReaderFor (audioFile, format);
+            expect (reader != nullptr);
+
+            // Changing the audio file makes the saved index stale
+            expect (audioFile.appendText ("x"));
+            expect (reloaded.getIndexFor (audioFile) == nullptr);
+
+            folder.deleteRecursively();
+        }
+    }
+};
+
+static OggVorbisSeekIndexTests oggVorbisSeekIndexTests;
+
+//==============================================================================
+class OggVorbisSeekIndexBenchmarks final : public UnitTest
+{
+public:
+    OggVorbisSeekIndexBenchmarks()
+        : UnitTest ("Ogg-Vorbis seek index benchmarks", UnitTestCategories::benchmarks)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Random access with and without an index");
+
+        constexpr int numSeconds = 300, numReads = 500, blockSize = 2048;
+        auto random = getRandom();
+        OggVorbisAudioFormat format;
+        const auto file = writeOggTestFile (2, 44100 * numSeconds, random);
+
+        std::shared_ptr<const AudioSeekIndex> index;
+
+        {
+            MemoryInputStream source (file, false);
+            const auto start = Time::getMillisecondCounterHiRes();
+            index = format.createSeekIndex (source);
+            logMessage ("Indexing " + String (numSeconds) + " s of audio: "
+                          + String (Time::getMillisecondCounterHiRes() - start, 1) + " ms, "
+                          + String ((int) index->getPoints().size()) + " points");
+        }
+
+        // Counts the I/O that each read causes, which is what dominates on slow storage
+        struct CountingStream final : public MemoryInputStream
+        {
+            using MemoryInputStream::MemoryInputStream;
+
+            int read (void* dest, int numBytes) override    { bytesRead += numBytes; return MemoryInputStream::read (dest, numBytes); }
+            bool setPosition (int64 pos) override           { ++numSeeks; return MemoryInputStream::setPosition (pos); }
+
+            int64 bytesRead = 0, numSeeks = 0;
+        };
+
+        const auto timeRandomReads = [&] (const String& description, std::shared_ptr<const AudioSeekIndex> indexToUse)
+        {
+            auto* stream = new CountingStream (file, false);
+            std::unique_ptr<AudioFormatReader> reader (format.createReaderWithSeekIndex (stream, true, indexToUse));
+            AudioBuffer<float> buffer (2, blockSize);
+            Random positions (1234);
+            stream->bytesRead = stream->numSeeks = 0;
+            const auto start = Time::getMillisecondCounterHiRes();
+
+            for (int i = 0; i < numReads; ++i)
+                reader->read (&buffer, 0, blockSize, positions.nextInt ((int) reader->lengthInSamples - blockSize), true, true);
+
+            logMessage ("Random read " + description + ": " + String ((Time::getMillisecondCounterHiRes() - start) / numReads, 3) + " ms, "
+                          + String (stream->numSeeks / numReads) + " seeks and "
+                          + File::descriptionOfSizeInBytes (stream->bytesRead / numReads) + " read per access");
+        };
+
+        timeRandomReads ("without index", nullptr);
+        timeRandomReads ("with index", index);
+    }
+};
+
+static OggVorbisSeekIndexBenchmarks oggVorbisSeekIndexBenchmarks;
+
+#endif
+
 #endif
 
 } // namespace juce
@@ -93,6 +93,15 @@ public:
     AudioFormatReader* createReaderFor (InputStream* sourceStream,
                                         bool deleteStreamIfOpeningFails) override;
 
+    /** Builds a table of the stream's pages, which the reader uses to jump close to
+        a sample instead of searching the file for it.
+    */
+    std::unique_ptr<AudioSeekIndex> createSeekIndex (InputStream& sourceStream) override;
+
+    AudioFormatReader* createReaderWithSeekIndex (InputStream* sourceStream,
+                                                  bool deleteStreamIfOpeningFails,
+                                                  std::shared_ptr<const AudioSeekIndex> index) override;
+
     std::unique_ptr<AudioFormatWriter> createWriterFor (std::unique_ptr<OutputStream>& streamToWriteTo,
                                                         const AudioFormatWriterOptions& options) override;
 
@@ -1418,7 +1418,20 @@ int ov_raw_seek(OggVorbis_File *vf,ogg_int64_t pos){
    Seek to the last [granule marked] page preceding the specified pos
    location, such that decoding past the returned point will quickly
    arrive at the requested position. */
+// JUCE CHANGE STARTS HERE
+/* The hint is a page that's known to have a granulepos before pos, which
+   lets the search start right next to the target instead of bisecting
+   the whole stream. */
+static int juce_ov_pcm_seek_page_hinted(OggVorbis_File *vf,ogg_int64_t pos,
+                                        ogg_int64_t hintOffset,ogg_int64_t hintGranulepos);
+
 int ov_pcm_seek_page(OggVorbis_File *vf,ogg_int64_t pos){
+  return juce_ov_pcm_seek_page_hinted(vf,pos,-1,-1);
+}
+
+static int juce_ov_pcm_seek_page_hinted(OggVorbis_File *vf,ogg_int64_t pos,
+                                        ogg_int64_t hintOffset,ogg_int64_t hintGranulepos){
+// JUCE CHANGE ENDS HERE
   int link=-1;
   ogg_int64_t result=0;
   ogg_int64_t total=ov_pcm_total(vf,-1);
@@ -1462,6 +1475,12 @@ int ov_pcm_seek_page(OggVorbis_File *vf,ogg_int64_t pos){
         begin = pos;
       
     ogg_int64_t initialBegin = begin;
+
+    if(hintOffset>=begin && hintOffset<end &&
+       hintGranulepos>=begintime && hintGranulepos<target){
+      begin=hintOffset;
+      begintime=hintGranulepos;
+    }
     // JUCE CHANGE ENDS HERE
 
     /* if we have only one page, there will be no bisection.  Grab the page here */
@@ -1702,9 +1721,19 @@ int ov_pcm_seek_page(OggVorbis_File *vf,ogg_int64_t pos){
 /* seek to a sample offset relative to the decompressed pcm stream
    returns zero on success, nonzero on failure */
 
+// JUCE CHANGE STARTS HERE
+static int juce_ov_pcm_seek_hinted(OggVorbis_File *vf,ogg_int64_t pos,
+                                   ogg_int64_t hintOffset,ogg_int64_t hintGranulepos);
+
 int ov_pcm_seek(OggVorbis_File *vf,ogg_int64_t pos){
+  return juce_ov_pcm_seek_hinted(vf,pos,-1,-1);
+}
+
+static int juce_ov_pcm_seek_hinted(OggVorbis_File *vf,ogg_int64_t pos,
+                                   ogg_int64_t hintOffset,ogg_int64_t hintGranulepos){
   int thisblock,lastblock=0;
-  int ret=ov_pcm_seek_page(vf,pos);
+  int ret=juce_ov_pcm_seek_page_hinted(vf,pos,hintOffset,hintGranulepos);
+// JUCE CHANGE ENDS HERE
   if(ret<0)return(ret);
   if((ret=_make_decode_ready(vf)))return ret;
 
@@ -74,6 +74,18 @@ MemoryMappedAudioFormatReader* AudioFormat::createMemoryMappedReader (FileInputS
     return nullptr;
 }
 
+std::unique_ptr<AudioSeekIndex> AudioFormat::createSeekIndex (InputStream&)
+{
+    return nullptr;
+}
+
+AudioFormatReader* AudioFormat::createReaderWithSeekIndex (InputStream* sourceStream,
+                                                           bool deleteStreamIfOpeningFails,
+                                                           std::shared_ptr<const AudioSeekIndex>)
+{
+    return createReaderFor (sourceStream, deleteStreamIfOpeningFails);
+}
+
 bool AudioFormat::isChannelLayoutSupported (const AudioChannelSet& channelSet)
 {
     if (channelSet == AudioChannelSet::mono())      return canDoMono();
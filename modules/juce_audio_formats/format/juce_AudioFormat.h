@@ -125,6 +125,27 @@ public:
     virtual MemoryMappedAudioFormatReader* createMemoryMappedReader (const File& file);
     virtual MemoryMappedAudioFormatReader* createMemoryMappedReader (FileInputStream* fin);
 
+    /** Scans a stream and builds an index that a reader can use to seek quickly.
+
+        This reads through the whole stream, so may take a while for long files. If the
+        format doesn't need or support an index, this returns nullptr, which is what the
+        default implementation does.
+
+        @see createReaderWithSeekIndex, AudioSeekIndexCache
+    */
+    virtual std::unique_ptr<AudioSeekIndex> createSeekIndex (InputStream& sourceStream);
+
+    /** Tries to create a reader that uses an index created by createSeekIndex() to seek.
+
+        The parameters are the same as for createReaderFor(). If the index is null or was
+        made from a different stream, the reader works without it. Formats that don't
+        support an index just return a normal reader, which is what the default
+        implementation does.
+    */
+    virtual AudioFormatReader* createReaderWithSeekIndex (InputStream* sourceStream,
+                                                          bool deleteStreamIfOpeningFails,
+                                                          std::shared_ptr<const AudioSeekIndex> index);
+
     /** Tries to create an object that can write to a stream with this audio format.
 
         If the writer can't be created for some reason (e.g. the parameters passed in
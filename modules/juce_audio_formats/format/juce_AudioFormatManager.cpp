@@ -141,6 +141,27 @@ AudioFormatReader* AudioFormatManager::createReaderFor (const File& file)
     return nullptr;
 }
 
+AudioFormatReader* AudioFormatManager::createReaderFor (const File& file, AsyncFileReader& fileReader)
+{
+    // you need to actually register some formats before the manager can
+    // use them to open a file!
+    jassert (getNumKnownFormats() > 0);
+
+    for (auto* af : knownFormats)
+    {
+        if (af->canHandleFile (file))
+        {
+            auto in = std::make_unique<ReadAheadFileInputStream> (fileReader, file);
+
+            if (in->openedOk())
+                if (auto* r = af->createReaderFor (in.release(), true))
+                    return r;
+        }
+    }
+
+    return nullptr;
+}
+
 AudioFormatReader* AudioFormatManager::createReaderFor (std::unique_ptr<InputStream> audioFileStream)
 {
     // you need to actually register some formats before the manager can
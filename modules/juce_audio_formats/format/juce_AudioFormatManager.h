@@ -134,6 +134,20 @@ public:
     */
     AudioFormatReader* createReaderFor (const File& audioFile);
 
+    /** Searches through the known formats to try to create a suitable reader for
+        this file, reading it through a ReadAheadFileInputStream.
+
+        The reader's data is then fetched ahead of time in the background by the
+        AsyncFileReader, which must outlive the reader that is returned. This suits
+        a lot of files being streamed at once, particularly when the reader is
+        wrapped in a BufferingAudioReader, because the file reads are batched
+        together rather than each one blocking a thread.
+
+        If none of the registered formats can open the file, it'll return nullptr.
+        It's the caller's responsibility to delete the reader that is returned.
+    */
+    AudioFormatReader* createReaderFor (const File& audioFile, AsyncFileReader& fileReader);
+
     /** Searches through the known formats to try to create a suitable reader for
         this stream.
 
@@ -220,24 +220,33 @@ bool AudioFormatWriter::flush()
 }
 
 //==============================================================================
-class AudioFormatWriter::ThreadedWriter::Buffer final : private TimeSliceClient
+class AudioFormatWriter::ThreadedWriter::Buffer final : private TimeSliceClient,
+                                                        public MultiFileRecorder::Client
 {
 public:
-    Buffer (TimeSliceThread& tst, AudioFormatWriter* w, int channels, int numSamples)
+    Buffer (TimeSliceThread* tst, MultiFileRecorder* r, AudioFormatWriter* w, int channels, int numSamples)
         : fifo (numSamples),
           buffer (channels, numSamples),
           timeSliceThread (tst),
+          recorder (r),
           writer (w)
     {
-        timeSliceThread.addTimeSliceClient (this);
+        if (timeSliceThread != nullptr)
+            timeSliceThread->addTimeSliceClient (this);
+        else
+            recorder->addClient (this);
     }
 
     ~Buffer() override
     {
         isRunning = false;
-        timeSliceThread.removeTimeSliceClient (this);
 
-        while (writePendingData() == 0)
+        if (timeSliceThread != nullptr)
+            timeSliceThread->removeTimeSliceClient (this);
+        else
+            recorder->removeClient (this);
+
+        while (writePendingData (fifo.getTotalSize() / 4) > 0)
         {}
     }
 
@@ -246,13 +255,16 @@ public:
         if (numSamples <= 0 || ! isRunning)
             return true;
 
-        jassert (timeSliceThread.isThreadRunning());  // you need to get your thread running before pumping data into this!
+        jassert (timeSliceThread == nullptr || timeSliceThread->isThreadRunning());  // you need to get your thread running before pumping data into this!
 
         int start1, size1, start2, size2;
         fifo.prepareToWrite (numSamples, start1, size1, start2, size2);
 
         if (size1 + size2 < numSamples)
+        {
+            updateFifoStatistics (fifo.getNumReady(), fifo.getTotalSize(), true);
             return false;
+        }
 
         for (int i = buffer.getNumChannels(); --i >= 0;)
         {
@@ -261,24 +273,45 @@ public:
         }
 
         fifo.finishedWrite (size1 + size2);
-        timeSliceThread.notify();
+
+        const auto numWaiting = fifo.getNumReady();
+        updateFifoStatistics (numWaiting, fifo.getTotalSize(), false);
+
+        if (timeSliceThread != nullptr)
+            timeSliceThread->notify();
+        else if (numWaiting >= fifo.getTotalSize() / 2)
+            recorder->notify();
+
         return true;
     }
 
     int useTimeSlice() override
     {
-        return writePendingData();
+        return writePendingData (fifo.getTotalSize() / 4) > 0 ? 0 : 10;
+    }
+
+    int getNumSamplesWaiting() override
+    {
+        return fifo.getNumReady();
     }
 
-    int writePendingData()
+    int getFifoSize() override
     {
-        auto numToDo = fifo.getTotalSize() / 4;
+        return fifo.getTotalSize();
+    }
+
+    int writeWaitingSamples() override
+    {
+        return writePendingData (fifo.getNumReady());
+    }
 
+    int writePendingData (int numToDo)
+    {
         int start1, size1, start2, size2;
         fifo.prepareToRead (numToDo, start1, size1, start2, size2);
 
         if (size1 <= 0)
-            return 10;
+            return 0;
 
         writer->writeFromAudioSampleBuffer (buffer, start1, size1);
 
@@ -312,7 +345,7 @@ public:
             }
         }
 
-        return 0;
+        return size1 + size2;
     }
 
     void setDataReceiver (IncomingDataReceiver* newReceiver)
@@ -333,7 +366,8 @@ public:
 private:
     AbstractFifo fifo;
     AudioBuffer<float> buffer;
-    TimeSliceThread& timeSliceThread;
+    TimeSliceThread* const timeSliceThread;
+    MultiFileRecorder* const recorder;
     std::unique_ptr<AudioFormatWriter> writer;
     CriticalSection thumbnailLock;
     IncomingDataReceiver* receiver = {};
@@ -345,7 +379,12 @@ private:
 };
 
 AudioFormatWriter::ThreadedWriter::ThreadedWriter (AudioFormatWriter* writer, TimeSliceThread& backgroundThread, int numSamplesToBuffer)
-    : buffer (new AudioFormatWriter::ThreadedWriter::Buffer (backgroundThread, writer, (int) writer->numChannels, numSamplesToBuffer))
+    : buffer (new AudioFormatWriter::ThreadedWriter::Buffer (&backgroundThread, nullptr, writer, (int) writer->numChannels, numSamplesToBuffer))
+{
+}
+
+AudioFormatWriter::ThreadedWriter::ThreadedWriter (AudioFormatWriter* writer, MultiFileRecorder& recorder, int numSamplesToBuffer)
+    : buffer (new AudioFormatWriter::ThreadedWriter::Buffer (nullptr, &recorder, writer, (int) writer->numChannels, numSamplesToBuffer))
 {
 }
 
@@ -368,4 +407,9 @@ void AudioFormatWriter::ThreadedWriter::setFlushInterval (int numSamplesPerFlush
     buffer->setFlushInterval (numSamplesPerFlush);
 }
 
+MultiFileRecorder::Statistics AudioFormatWriter::ThreadedWriter::getStatistics() const
+{
+    return buffer->getStatistics();
+}
+
 } // namespace juce
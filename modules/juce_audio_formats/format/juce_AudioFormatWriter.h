@@ -205,6 +205,21 @@ public:
                         TimeSliceThread& backgroundThread,
                         int numSamplesToBuffer);
 
+        /** Creates a ThreadedWriter whose data is written to disk by a MultiFileRecorder.
+
+            This is a better choice than a TimeSliceThread when a lot of files are being
+            recorded at once. For the biggest benefit, the writer should be writing to
+            a stream that was created by MultiFileRecorder::createOutputStream().
+
+            The writer object which is passed in here will be owned and deleted by
+            the ThreadedWriter when it is no longer needed.
+
+            To stop the writer and flush the buffer to disk, simply delete this object.
+        */
+        ThreadedWriter (AudioFormatWriter* writer,
+                        MultiFileRecorder& recorder,
+                        int numSamplesToBuffer);
+
         /** Destructor. */
         ~ThreadedWriter();
 
@@ -248,6 +263,11 @@ public:
         */
         void setFlushInterval (int numSamplesPerFlush) noexcept;
 
+        /** Returns the statistics for this writer's FIFO, which show how close it has come
+            to overflowing.
+        */
+        MultiFileRecorder::Statistics getStatistics() const;
+
     private:
         class Buffer;
         std::unique_ptr<Buffer> buffer;
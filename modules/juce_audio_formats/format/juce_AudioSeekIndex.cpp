@@ -0,0 +1,299 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+static constexpr int seekIndexMagicNumber = 0x58494b53; // "SKIX"
+static constexpr int seekIndexVersion = 1;
+
+AudioSeekIndex::AudioSeekIndex (const String& format, std::vector<Point> newPoints, InputStream& source)
+    : formatName (format),
+      points (std::move (newPoints)),
+      sourceLength (source.getTotalLength()),
+      sourceFingerprint (getFingerprint (source))
+{
+    jassert (std::is_sorted (points.begin(), points.end(), [] (const Point& a, const Point& b) { return a.sample < b.sample; }));
+}
+
+const AudioSeekIndex::Point* AudioSeekIndex::findPointBefore (int64 sample) const noexcept
+{
+    auto it = std::upper_bound (points.begin(), points.end(), sample,
+                                [] (int64 s, const Point& p) { return s < p.sample; });
+
+    return it == points.begin() ? nullptr : &*std::prev (it);
+}
+
+bool AudioSeekIndex::matchesStream (InputStream& source) const
+{
+    return source.getTotalLength() == sourceLength && getFingerprint (source) == sourceFingerprint;
+}
+
+uint64 AudioSeekIndex::getFingerprint (InputStream& source)
+{
+    // Hashes the length and the data at either end of the stream. The headers of most
+    // formats are at the start, so this catches a file being re-encoded or edited.
+    constexpr int blockSize = 4096;
+    const auto originalPosition = source.getPosition();
+    const auto length = source.getTotalLength();
+
+    auto hash = (uint64) 0xcbf29ce484222325ull;
+
+    const auto addBytes = [&hash] (const void* data, size_t numBytes)
+    {
+        for (size_t i = 0; i < numBytes; ++i)
+            hash = (hash ^ static_cast<const uint8*> (data)[i]) * 0x100000001b3ull;
+    };
+
+    addBytes (&length, sizeof (length));
+
+    uint8 buffer[blockSize];
+
+    for (auto start : { (int64) 0, jmax ((int64) 0, length - blockSize) })
+    {
+        if (source.setPosition (start))
+            addBytes (buffer, (size_t) jmax (0, source.read (buffer, blockSize)));
+    }
+
+    source.setPosition (originalPosition);
+    return hash;
+}
+
+//==============================================================================
+bool AudioSeekIndex::writeToStream (OutputStream& output) const
+{
+    output.writeInt (seekIndexMagicNumber);
+    output.writeInt (seekIndexVersion);
+    output.writeString (formatName);
+    output.writeInt64 (sourceLength);
+    output.writeInt64 ((int64) sourceFingerprint);
+    output.writeCompressedInt ((int) points.size());
+
+    // The points are stored as differences from the previous one, which are small
+    Point last { 0, 0 };
+
+    for (auto& p : points)
+    {
+        output.writeCompressedInt ((int) (p.sample - last.sample));
+
+        if (! output.writeCompressedInt ((int) (p.byteOffset - last.byteOffset)))
+            return false;
+
+        last = p;
+    }
+
+    return true;
+}
+
+std::unique_ptr<AudioSeekIndex> AudioSeekIndex::readFromStream (InputStream& input)
+{
+    if (input.readInt() != seekIndexMagicNumber || input.readInt() != seekIndexVersion)
+        return nullptr;
+
+    std::unique_ptr<AudioSeekIndex> index (new AudioSeekIndex());
+    index->formatName = input.readString();
+    index->sourceLength = input.readInt64();
+    index->sourceFingerprint = (uint64) input.readInt64();
+
+    const auto numPoints = input.readCompressedInt();
+
+    // Each point takes at least two bytes, so a count that's too big for what's left of
+    // the stream means the file is corrupt, and mustn't be used to allocate anything
+    constexpr int64 minBytesPerPoint = 2;
+    const auto numBytesRemaining = input.getNumBytesRemaining();
+
+    if (numPoints < 0 || (numBytesRemaining >= 0 && numPoints > numBytesRemaining / minBytesPerPoint))
+        return nullptr;
+
+    if (numBytesRemaining >= 0)
+        index->points.reserve ((size_t) numPoints);
+    Point last { 0, 0 };
+
+    for (int i = 0; i < numPoints; ++i)
+    {
+        const auto sampleDelta = input.readCompressedInt();
+        const auto offsetDelta = input.readCompressedInt();
+
+        if (sampleDelta < 0 || offsetDelta < 0 || (input.isExhausted() && i < numPoints - 1))
+            return nullptr;
+
+        last = { last.sample + sampleDelta, last.byteOffset + offsetDelta };
+        index->points.push_back (last);
+    }
+
+    return index;
+}
+
+File AudioSeekIndex::getDefaultIndexFileFor (const File& audioFile)
+{
+    return audioFile.getSiblingFile (audioFile.getFileName() + ".seekindex");
+}
+
+//==============================================================================
+AudioSeekIndexCache::AudioSeekIndexCache (ThreadPool& pool, const File& directory)
+    : threadPool (pool), cacheDirectory (directory)
+{
+    allJobsFinished.signal();
+}
+
+AudioSeekIndexCache::~AudioSeekIndexCache()
+{
+    allJobsFinished.wait();
+
+    // The last job signals while holding the lock, so this makes sure it's let go of it
+    const ScopedLock sl (lock);
+}
+
+File AudioSeekIndexCache::getIndexFileFor (const File& audioFile) const
+{
+    if (! cacheDirectory.isDirectory())
+        return AudioSeekIndex::getDefaultIndexFileFor (audioFile);
+
+    // Files with the same name in different folders need different cache entries
+    const auto hash = String::toHexString (audioFile.getFullPathName().hashCode64());
+    return cacheDirectory.getChildFile (audioFile.getFileName() + "-" + hash + ".seekindex");
+}
+
+std::shared_ptr<const AudioSeekIndex> AudioSeekIndexCache::getIndexFor (const File& audioFile)
+{
+    const auto key = audioFile.getFullPathName();
+
+    auto source = audioFile.createInputStream();
+
+    if (source == nullptr)
+        return nullptr;
+
+    {
+        const ScopedLock sl (lock);
+        auto found = indexes.find (key);
+
+        if (found != indexes.end())
+        {
+            if (found->second->matchesStream (*source))
+                return found->second;
+
+            indexes.erase (found);
+        }
+    }
+
+    if (auto stored = getIndexFileFor (audioFile).createInputStream())
+    {
+        if (std::shared_ptr<const AudioSeekIndex> index = AudioSeekIndex::readFromStream (*stored))
+        {
+            if (index->matchesStream (*source))
+            {
+                const ScopedLock sl (lock);
+                indexes[key] = index;
+                return index;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+void AudioSeekIndexCache::buildIndex (const File& audioFile, AudioFormat& format,
+                                      std::function<void (std::shared_ptr<const AudioSeekIndex>)> onFinished)
+{
+    const auto key = audioFile.getFullPathName();
+
+    {
+        const ScopedLock sl (lock);
+
+        if (filesBeingIndexed.count (key) != 0)
+            return;
+
+        if (filesBeingIndexed.empty())
+            allJobsFinished.reset();
+
+        filesBeingIndexed.insert (key);
+    }
+
+    threadPool.addJob ([this, audioFile, key, &format, onFinished = std::move (onFinished)]
+    {
+        auto index = getIndexFor (audioFile);
+
+        if (index == nullptr)
+        {
+            if (auto source = audioFile.createInputStream())
+            {
+                index = format.createSeekIndex (*source);
+
+                if (index != nullptr)
+                {
+                    const auto indexFile = getIndexFileFor (audioFile);
+                    TemporaryFile temp (indexFile);
+
+                    if (auto out = temp.getFile().createOutputStream())
+                    {
+                        const auto written = index->writeToStream (*out);
+                        out.reset();
+
+                        if (written)
+                            temp.overwriteTargetFileWithTemporary();
+                    }
+
+                    const ScopedLock sl (lock);
+                    indexes[key] = index;
+                }
+            }
+        }
+
+        if (onFinished != nullptr)
+            onFinished (index);
+
+        const ScopedLock sl (lock);
+        filesBeingIndexed.erase (key);
+
+        if (filesBeingIndexed.empty())
+            allJobsFinished.signal();
+    });
+}
+
+std::unique_ptr<AudioFormatReader> AudioSeekIndexCache::createReaderFor (const File& audioFile, AudioFormat& format)
+{
+    auto index = getIndexFor (audioFile);
+
+    if (index == nullptr)
+        buildIndex (audioFile, format);
+
+    auto source = audioFile.createInputStream();
+
+    if (source == nullptr)
+        return nullptr;
+
+    return std::unique_ptr<AudioFormatReader> (format.createReaderWithSeekIndex (source.release(), true, index));
+}
+
+} // namespace juce
@@ -0,0 +1,185 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class AudioFormat;
+
+//==============================================================================
+/**
+    A table of positions in a compressed audio stream, which lets a reader jump
+    straight to the right part of the stream instead of searching for it.
+
+    Each point maps a sample position to the byte offset of the data for that
+    position. What the points actually refer to depends on the format: for
+    Ogg-Vorbis they're pages, and for MP3 they're frames. An index is created by AudioFormat::createSeekIndex(), and is used by
+    passing it to AudioFormat::createReaderWithSeekIndex().
+
+    Building an index means scanning the whole file, so for long files you'll
+    probably want to do that on a background thread, and keep the result on disk
+    so that it only needs doing once. AudioSeekIndexCache will do both of these
+    things for you.
+
+    @see AudioSeekIndexCache, AudioFormat::createSeekIndex
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioSeekIndex
+{
+public:
+    //==============================================================================
+    /** A position that decoding can start from. */
+    struct Point
+    {
+        int64 sample;       /**< The sample position that this point refers to. */
+        int64 byteOffset;   /**< The position in the stream of the data for this sample. */
+    };
+
+    /** Creates an index from a set of points, which must be sorted by sample position.
+
+        The source stream is needed so that the index can check whether it's still
+        valid for the stream later on. Its position is left unchanged.
+    */
+    AudioSeekIndex (const String& formatName, std::vector<Point> points, InputStream& source);
+
+    //==============================================================================
+    /** Returns the name of the format whose reader can use this index. */
+    const String& getFormatName() const noexcept                    { return formatName; }
+
+    /** Returns all of the points in the index. */
+    const std::vector<Point>& getPoints() const noexcept            { return points; }
+
+    /** Returns the last point at or before the given sample, or nullptr if there isn't one. */
+    const Point* findPointBefore (int64 sample) const noexcept;
+
+    /** Checks whether this index was built from a stream with the same contents as the
+        given one. This compares the lengths and some of the data of the two streams,
+        so it's quick, but won't detect every possible change to a file.
+        The stream's position is left unchanged.
+    */
+    bool matchesStream (InputStream& source) const;
+
+    //==============================================================================
+    /** Writes the index to a stream in a compact binary form. */
+    bool writeToStream (OutputStream& output) const;
+
+    /** Reads an index that was written by writeToStream(), returning nullptr if the
+        data isn't valid.
+    */
+    static std::unique_ptr<AudioSeekIndex> readFromStream (InputStream& input);
+
+    /** Returns the file that AudioSeekIndexCache uses for an audio file's index when it's
+        kept next to the audio file.
+    */
+    static File getDefaultIndexFileFor (const File& audioFile);
+
+private:
+    AudioSeekIndex() = default;
+
+    static uint64 getFingerprint (InputStream&);
+
+    String formatName;
+    std::vector<Point> points;
+    int64 sourceLength = 0;
+    uint64 sourceFingerprint = 0;
+
+    JUCE_LEAK_DETECTOR (AudioSeekIndex)
+};
+
+//==============================================================================
+/**
+    Builds AudioSeekIndex objects on a thread pool, and keeps them in memory and
+    on disk so that they're available immediately next time.
+
+    The indexes are saved either next to their audio files, or in a cache directory,
+    and any index whose audio file has changed since it was built is ignored.
+
+    @see AudioSeekIndex
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioSeekIndexCache
+{
+public:
+    /** Creates a cache that builds indexes using the given pool.
+
+        If the cache directory is a non-existent file, the indexes are saved next to
+        their audio files, otherwise they're saved in that directory. The pool must
+        outlive the cache.
+    */
+    explicit AudioSeekIndexCache (ThreadPool& pool, const File& cacheDirectory = {});
+
+    /** Destructor. This waits for any indexes that are being built to finish. */
+    ~AudioSeekIndexCache();
+
+    //==============================================================================
+    /** Returns the index for a file if it's in memory or can be loaded from disk.
+        If it isn't available, this returns nullptr, and you can call buildIndex() to
+        create it.
+    */
+    std::shared_ptr<const AudioSeekIndex> getIndexFor (const File& audioFile);
+
+    /** Starts building an index for a file on the pool, unless one is already available
+        or being built.
+
+        When the index is ready, it's saved, and the callback (if there is one) is called
+        on a pool thread. The callback is passed nullptr if the format doesn't support
+        indexing or the file couldn't be read. The format object must stay valid until
+        the callback has been called.
+    */
+    void buildIndex (const File& audioFile, AudioFormat& format,
+                     std::function<void (std::shared_ptr<const AudioSeekIndex>)> onFinished = {});
+
+    /** Creates a reader for a file, using its index if there's one available.
+        If there isn't an index, one is built in the background for next time.
+    */
+    std::unique_ptr<AudioFormatReader> createReaderFor (const File& audioFile, AudioFormat& format);
+
+    /** Returns the file in which an audio file's index is kept. */
+    File getIndexFileFor (const File& audioFile) const;
+
+private:
+    ThreadPool& threadPool;
+    const File cacheDirectory;
+
+    CriticalSection lock;
+    std::map<String, std::shared_ptr<const AudioSeekIndex>> indexes;
+    std::set<String> filesBeingIndexed;
+    WaitableEvent allJobsFinished { true };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioSeekIndexCache)
+};
+
+} // namespace juce
@@ -38,8 +38,23 @@ namespace juce
 BufferingAudioReader::BufferingAudioReader (AudioFormatReader* sourceReader,
                                             TimeSliceThread& timeSliceThread,
                                             int samplesToBuffer)
+    : BufferingAudioReader (sourceReader, &timeSliceThread, nullptr, samplesToBuffer)
+{
+}
+
+BufferingAudioReader::BufferingAudioReader (AudioFormatReader* sourceReader,
+                                            ReadAheadScheduler& readAheadScheduler,
+                                            int samplesToBuffer)
+    : BufferingAudioReader (sourceReader, nullptr, &readAheadScheduler, samplesToBuffer)
+{
+}
+
+BufferingAudioReader::BufferingAudioReader (AudioFormatReader* sourceReader,
+                                            TimeSliceThread* timeSliceThread,
+                                            ReadAheadScheduler* readAheadScheduler,
+                                            int samplesToBuffer)
     : AudioFormatReader (nullptr, sourceReader->getFormatName()),
-      source (sourceReader), thread (timeSliceThread),
+      source (sourceReader), thread (timeSliceThread), scheduler (readAheadScheduler),
       numBlocks (1 + (samplesToBuffer / samplesPerBlock))
 {
     sampleRate            = source->sampleRate;
@@ -49,12 +64,18 @@ BufferingAudioReader::BufferingAudioReader (AudioFormatReader* sourceReader,
     bitsPerSample         = 32;
     usesFloatingPointData = true;
 
-    timeSliceThread.addTimeSliceClient (this);
+    if (scheduler != nullptr)
+        scheduler->addClient (this);
+    else
+        thread->addTimeSliceClient (this);
 }
 
 BufferingAudioReader::~BufferingAudioReader()
 {
-    thread.removeTimeSliceClient (this);
+    if (scheduler != nullptr)
+        scheduler->removeClient (this);
+    else
+        thread->removeTimeSliceClient (this);
 }
 
 void BufferingAudioReader::setReadTimeout (int timeoutMilliseconds) noexcept
@@ -108,12 +129,17 @@ bool BufferingAudioReader::readSamples (int* const* destSamples, int numDestChan
                     if (auto* dest = (float*) destSamples[j])
                         FloatVectorOperations::clear (dest + startOffsetInDestBuffer, numSamples);
 
+                reportUnderrun (numSamples);
                 allSamplesRead = false;
                 break;
             }
             else
             {
                 ScopedUnlock ul (lock);
+
+                if (scheduler != nullptr)
+                    scheduler->notify();
+
                 Thread::yield();
             }
         }
@@ -129,6 +155,16 @@ BufferingAudioReader::BufferedBlock::BufferedBlock (AudioFormatReader& reader, i
 {
 }
 
+BufferingAudioReader::BufferedBlock::BufferedBlock (const AudioBuffer<float>& sourceBuffer, int sourceOffset,
+                                                    int64 pos, int numSamples, bool allRead)
+    : range (pos, pos + numSamples),
+      buffer (sourceBuffer.getNumChannels(), numSamples),
+      allSamplesRead (allRead)
+{
+    for (int i = 0; i < buffer.getNumChannels(); ++i)
+        buffer.copyFrom (i, 0, sourceBuffer, i, sourceOffset, numSamples);
+}
+
 BufferingAudioReader::BufferedBlock* BufferingAudioReader::getBlockContaining (int64 pos) const noexcept
 {
     for (auto* b : blocks)
@@ -140,10 +176,30 @@ BufferingAudioReader::BufferedBlock* BufferingAudioReader::getBlockContaining (i
 
 int BufferingAudioReader::useTimeSlice()
 {
-    return readNextBufferChunk() ? 1 : 100;
+    return readNextBufferChunk (1) > 0 ? 1 : 100;
 }
 
-bool BufferingAudioReader::readNextBufferChunk()
+int BufferingAudioReader::readAhead (int maxSamplesToRead)
+{
+    return readNextBufferChunk (jmax (1, maxSamplesToRead / samplesPerBlock));
+}
+
+double BufferingAudioReader::getSecondsUntilUnderrun()
+{
+    // The scheduler never calls this while a read is in progress, and reads are the only
+    // thing that modify the block list, so it's safe to look at it without the lock
+    const auto readPos = nextReadPosition.load();
+    const auto pos = (readPos / samplesPerBlock) * samplesPerBlock;
+    const auto endPos = jmin (lengthInSamples, pos + numBlocks * samplesPerBlock);
+
+    for (auto p = pos; p < endPos; p += samplesPerBlock)
+        if (getBlockContaining (p) == nullptr)
+            return (double) jmax ((int64) 0, p - readPos) / sampleRate;
+
+    return -1.0;
+}
+
+int BufferingAudioReader::readNextBufferChunk (int maxBlocksToRead)
 {
     auto pos = (nextReadPosition.load() / samplesPerBlock) * samplesPerBlock;
     auto endPos = jmin (lengthInSamples, pos + numBlocks * samplesPerBlock);
@@ -157,15 +213,38 @@ bool BufferingAudioReader::readNextBufferChunk()
     if (newBlocks.size() == numBlocks)
     {
         newBlocks.clear (false);
-        return false;
+        return 0;
     }
 
+    int numSamplesFetched = 0;
+
     for (auto p = pos; p < endPos; p += samplesPerBlock)
     {
         if (getBlockContaining (p) == nullptr)
         {
-            newBlocks.add (new BufferedBlock (*source, p, samplesPerBlock));
-            break; // just do one block
+            // Any missing blocks that follow this one are fetched with the same read
+            int numToRead = 1;
+
+            while (numToRead < maxBlocksToRead
+                    && p + numToRead * samplesPerBlock < endPos
+                    && getBlockContaining (p + numToRead * samplesPerBlock) == nullptr)
+                ++numToRead;
+
+            if (numToRead == 1)
+            {
+                newBlocks.add (new BufferedBlock (*source, p, samplesPerBlock));
+            }
+            else
+            {
+                AudioBuffer<float> data ((int) numChannels, numToRead * samplesPerBlock);
+                const auto allRead = source->read (&data, 0, data.getNumSamples(), p, true, true);
+
+                for (int i = 0; i < numToRead; ++i)
+                    newBlocks.add (new BufferedBlock (data, i * samplesPerBlock, p + i * samplesPerBlock, samplesPerBlock, allRead));
+            }
+
+            numSamplesFetched = numToRead * samplesPerBlock;
+            break;
         }
     }
 
@@ -177,7 +256,7 @@ bool BufferingAudioReader::readNextBufferChunk()
     for (int i = blocks.size(); --i >= 0;)
         newBlocks.removeObject (blocks.getUnchecked (i), false);
 
-    return true;
+    return numSamplesFetched;
 }
 
 
@@ -321,6 +400,140 @@ public:
                 expect (source == destination);
             }
         }
+
+        ReadAheadScheduler scheduler (2);
+
+        beginTest ("Reading samples via a scheduler should produce the same samples as the source");
+        {
+            Random random { getRandom() };
+
+            for (auto i = 4; i < 20; i += 3)
+            {
+                const auto bufferSize = 1 << i;
+                const auto source = generateTestBuffer (random, bufferSize);
+
+                BufferingAudioReader reader (new TestAudioFormatReader (&source), scheduler, bufferSize);
+                reader.setReadTimeout (-1);
+
+                auto destination = generateTestBuffer (random, bufferSize);
+                read (reader, destination);
+                expect (source == destination);
+            }
+        }
+
+        beginTest ("Missing data is counted as an underrun");
+        {
+            Random random { getRandom() };
+            const auto source = generateTestBuffer (random, 1024);
+
+            struct BlockingReader final : public TestAudioFormatReader
+            {
+                using TestAudioFormatReader::TestAudioFormatReader;
+
+                bool readSamples (int* const* destChannels, int numDestChannels, int startOffsetInDestBuffer,
+                                  int64 startSampleInFile, int numSamples) override
+                {
+                    unblock.wait();
+                    return TestAudioFormatReader::readSamples (destChannels, numDestChannels, startOffsetInDestBuffer, startSampleInFile, numSamples);
+                }
+
+                WaitableEvent unblock;
+            };
+
+            auto* blockingReader = new BlockingReader (&source);
+            BufferingAudioReader reader (blockingReader, scheduler, 1024);
+
+            AudioBuffer<float> destination (2, 100);
+            reader.read (&destination, 0, 100, 0, true, true);
+
+            expectEquals (reader.getStatistics().numUnderruns, 1);
+            expectEquals (reader.getStatistics().numSamplesMissed, (int64) 100);
+
+            blockingReader->unblock.signal();
+        }
+
+        beginTest ("A BufferingAudioSource using a scheduler plays its source");
+        {
+            Random random { getRandom() };
+            const auto source = generateTestBuffer (random, 100000);
+
+            BufferingAudioSource buffering (new AudioFormatReaderSource (new TestAudioFormatReader (&source), true),
+                                            scheduler, true, 8192, 2, false);
+            buffering.prepareToPlay (512, 44100.0);
+
+            AudioBuffer<float> block (2, 512);
+            auto matches = true;
+
+            for (int pos = 0; pos + 512 <= source.getNumSamples(); pos += 512)
+            {
+                const AudioSourceChannelInfo info (block);
+                expect (buffering.waitForNextAudioBlockReady (info, 5000));
+                buffering.getNextAudioBlock (info);
+
+                for (int ch = 0; ch < 2; ++ch)
+                    matches = matches && std::equal (block.getReadPointer (ch), block.getReadPointer (ch) + 512,
+                                                     source.getReadPointer (ch, pos));
+            }
+
+            expect (matches);
+            expectEquals (buffering.getStatistics().numUnderruns, 0);
+            buffering.releaseResources();
+        }
+
+        beginTest ("The client closest to running out is read first");
+        {
+            struct OrderedClient final : public ReadAheadScheduler::Client
+            {
+                OrderedClient (double s, Array<double>& o, CriticalSection& l, WaitableEvent* g)
+                    : seconds (s), order (o), orderLock (l), gate (g) {}
+
+                double getSecondsUntilUnderrun() override   { return hasBeenRead ? -1.0 : seconds; }
+
+                int readAhead (int) override
+                {
+                    if (gate != nullptr)
+                        gate->wait();
+
+                    const ScopedLock sl (orderLock);
+                    order.add (seconds);
+                    hasBeenRead = true;
+                    return 1;
+                }
+
+                const double seconds;
+                Array<double>& order;
+                CriticalSection& orderLock;
+                WaitableEvent* gate;
+                std::atomic<bool> hasBeenRead { false };
+            };
+
+            ReadAheadScheduler singleThreadScheduler (1);
+            Array<double> order;
+            CriticalSection orderLock;
+            WaitableEvent gate;
+
+            // This one holds up the only thread until all the others have been added
+            OrderedClient first (0.0, order, orderLock, &gate);
+            singleThreadScheduler.addClient (&first);
+
+            OwnedArray<OrderedClient> others;
+
+            for (auto seconds : { 3.0, 0.5, 2.0, 0.1, 1.0 })
+                singleThreadScheduler.addClient (others.add (new OrderedClient (seconds, order, orderLock, nullptr)));
+
+            gate.signal();
+
+            for (int i = 0; i < 500 && ! std::all_of (others.begin(), others.end(), [] (auto* c) { return c->hasBeenRead.load(); }); ++i)
+                Thread::sleep (2);
+
+            singleThreadScheduler.removeClient (&first);
+
+            for (auto* c : others)
+                singleThreadScheduler.removeClient (c);
+
+            const ScopedLock sl (orderLock);
+            expect (order == Array<double> { 0.0, 0.1, 0.5, 1.0, 2.0, 3.0 });
+        }
     }
 
 private:
@@ -345,6 +558,181 @@ private:
 
 static BufferingAudioReaderTests bufferingAudioReaderTests;
 
+//==============================================================================
+class ReadAheadSchedulerBenchmarks final : public UnitTest
+{
+public:
+    ReadAheadSchedulerBenchmarks()  : UnitTest ("ReadAheadScheduler benchmarks", UnitTestCategories::benchmarks)  {}
+
+    void runTest() override
+    {
+        beginTest ("Streaming many tracks from a slow disk");
+
+        const TemporaryFile tempFile (".wav");
+        const auto file = tempFile.getFile();
+        writeTestFile (file);
+
+        {
+            logMessage ("TimeSliceThread:");
+            TimeSliceThread thread ("Streaming");
+            thread.startThread (Thread::Priority::high);
+
+            runStreams (file, [&] (PositionableAudioSource* s) { return std::make_unique<BufferingAudioSource> (s, thread, true, bufferSize, 2, false); });
+        }
+
+        for (auto numConcurrentReads : { 1, 2 })
+        {
+            logMessage ("ReadAheadScheduler with " + String (numConcurrentReads) + " concurrent reads:");
+            ReadAheadScheduler scheduler (numConcurrentReads);
+
+            runStreams (file, [&] (PositionableAudioSource* s) { return std::make_unique<BufferingAudioSource> (s, scheduler, true, bufferSize, 2, false); });
+        }
+    }
+
+private:
+    static constexpr int numTracks = 200, sampleRate = 44100, blockSize = 512, bufferSize = sampleRate * 2;
+    static constexpr double secondsToWarmUp = 2.0, secondsToPlay = 5.0;
+
+    // Behaves like a disk that can only do one thing at a time, with a limited transfer
+    // rate, and a cost for each seek whenever a read doesn't follow on from the last one
+    struct SlowDisk
+    {
+        void access (const void* stream, int64 position, int numBytes)
+        {
+            double finishTime;
+
+            {
+                const ScopedLock sl (lock);
+                const auto isSeek = stream != lastStream || position != lastPosition;
+                lastStream = stream;
+                lastPosition = position + numBytes;
+
+                finishTime = jmax (Time::getMillisecondCounterHiRes(), busyUntil)
+                               + (isSeek ? millisecondsPerSeek : 0.0) + numBytes / bytesPerMillisecond;
+                busyUntil = finishTime;
+            }
+
+            // Short waits are left to build up, as sleeps can't be that precise
+            const auto msToWait = finishTime - Time::getMillisecondCounterHiRes();
+
+            if (msToWait >= 1.0)
+                Thread::sleep ((int) msToWait);
+        }
+
+        static constexpr double millisecondsPerSeek = 2.0, bytesPerMillisecond = 60000.0;
+        CriticalSection lock;
+        double busyUntil = 0;
+        const void* lastStream = nullptr;
+        int64 lastPosition = 0;
+    };
+
+    struct ThrottledInputStream final : public InputStream
+    {
+        ThrottledInputStream (std::unique_ptr<InputStream> s, SlowDisk& d)
+            : source (std::move (s)), disk (d) {}
+
+        int64 getTotalLength() override              { return source->getTotalLength(); }
+        bool isExhausted() override                  { return source->isExhausted(); }
+        int64 getPosition() override                 { return source->getPosition(); }
+        bool setPosition (int64 pos) override        { return source->setPosition (pos); }
+
+        int read (void* dest, int numBytes) override
+        {
+            disk.access (this, source->getPosition(), numBytes);
+            return source->read (dest, numBytes);
+        }
+
+        std::unique_ptr<InputStream> source;
+        SlowDisk& disk;
+    };
+
+    static void writeTestFile (const File& file)
+    {
+        WavAudioFormat wav;
+        std::unique_ptr<OutputStream> out = file.createOutputStream();
+        auto writer = wav.createWriterFor (out, AudioFormatWriterOptions{}.withSampleRate (sampleRate)
+                                                                         .withNumChannels (2)
+                                                                         .withBitsPerSample (16));
+
+        AudioBuffer<float> buffer (2, sampleRate);
+        Random random;
+
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample (ch, i, random.nextFloat() * 0.5f - 0.25f);
+
+        for (int i = 0; i < 30; ++i)
+            writer->writeFromAudioSampleBuffer (buffer, 0, buffer.getNumSamples());
+    }
+
+    template <typename CreateSource>
+    void runStreams (const File& file, CreateSource&& createSource)
+    {
+        SlowDisk disk;
+        WavAudioFormat wav;
+        Random random;
+        std::vector<std::unique_ptr<BufferingAudioSource>> sources;
+
+        for (int i = 0; i < numTracks; ++i)
+        {
+            auto stream = std::make_unique<ThrottledInputStream> (file.createInputStream(), disk);
+            auto* readerSource = new AudioFormatReaderSource (wav.createReaderFor (stream.release(), true), true);
+            readerSource->setLooping (true);
+
+            sources.push_back (createSource (readerSource));
+            sources.back()->setNextReadPosition (random.nextInt (sampleRate * 20));
+            sources.back()->prepareToPlay (blockSize, sampleRate);
+        }
+
+        // Plays all the tracks in real time, like an audio callback would
+        AudioBuffer<float> block (2, blockSize);
+        const auto blockMs = 1000.0 * blockSize / sampleRate;
+        const auto startTime = Time::getMillisecondCounterHiRes();
+        auto nextBlockTime = startTime;
+        auto hasWarmedUp = false;
+
+        while (nextBlockTime < startTime + 1000.0 * (secondsToWarmUp + secondsToPlay))
+        {
+            if (! hasWarmedUp && nextBlockTime >= startTime + 1000.0 * secondsToWarmUp)
+            {
+                hasWarmedUp = true;
+
+                for (auto& s : sources)
+                    s->resetStatistics();
+            }
+
+            for (auto& s : sources)
+                s->getNextAudioBlock (AudioSourceChannelInfo (block));
+
+            nextBlockTime += blockMs;
+
+            while (Time::getMillisecondCounterHiRes() < nextBlockTime)
+                Thread::sleep (1);
+        }
+
+        auto numStarved = 0, numUnderruns = 0;
+        int64 samplesMissed = 0;
+
+        for (auto& s : sources)
+        {
+            const auto stats = s->getStatistics();
+            numStarved += stats.numUnderruns > 0 ? 1 : 0;
+            numUnderruns += stats.numUnderruns;
+            samplesMissed += stats.numSamplesMissed;
+        }
+
+        logMessage ("  " + String (numStarved) + " of " + String (numTracks) + " tracks had underruns, "
+                      + String (numUnderruns) + " underruns in total, "
+                      + String (100.0 * (double) samplesMissed / ((double) numTracks * sampleRate * secondsToPlay), 1)
+                      + "% of samples missed");
+
+        for (auto& s : sources)
+            s->releaseResources();
+    }
+};
+
+static ReadAheadSchedulerBenchmarks readAheadSchedulerBenchmarks;
+
 #endif
 
 } // namespace juce
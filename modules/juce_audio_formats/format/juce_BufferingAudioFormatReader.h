@@ -40,12 +40,17 @@ namespace juce
     An AudioFormatReader that uses a background thread to pre-read data from
     another reader.
 
-    @see AudioFormatReader
+    If the source reader was created with AudioFormatManager::createReaderFor()
+    using an AsyncFileReader, its file data will also be fetched ahead in the
+    background, so the reads done by this class rarely have to wait for the disk.
+
+    @see AudioFormatReader, AsyncFileReader
 
     @tags{Audio}
 */
 class JUCE_API  BufferingAudioReader  : public AudioFormatReader,
-                                        private TimeSliceClient
+                                        private TimeSliceClient,
+                                        private ReadAheadScheduler::Client
 {
 public:
     /** Creates a reader.
@@ -62,6 +67,19 @@ public:
                           TimeSliceThread& timeSliceThread,
                           int samplesToBuffer);
 
+    /** Creates a reader that does its background reading with a ReadAheadScheduler.
+
+        @param sourceReader     the source reader to wrap. This BufferingAudioReader
+                                takes ownership of this object and will delete it later
+                                when no longer needed
+        @param scheduler        the scheduler to use, which mustn't be deleted while the
+                                reader object still exists
+        @param samplesToBuffer  the total number of samples to buffer ahead.
+    */
+    BufferingAudioReader (AudioFormatReader* sourceReader,
+                          ReadAheadScheduler& scheduler,
+                          int samplesToBuffer);
+
     ~BufferingAudioReader() override;
 
     /** Sets a number of milliseconds that the reader can block for in its readSamples()
@@ -71,6 +89,14 @@ public:
     */
     void setReadTimeout (int timeoutMilliseconds) noexcept;
 
+    /** Returns the number of times that a read had to return silence because the data
+        wasn't ready in time, and some other figures about the background reading.
+    */
+    using ReadAheadScheduler::Client::getStatistics;
+
+    /** Resets the values returned by getStatistics(). */
+    using ReadAheadScheduler::Client::resetStatistics;
+
     //==============================================================================
     bool readSamples (int* const* destSamples, int numDestChannels, int startOffsetInDestBuffer,
                       int64 startSampleInFile, int numSamples) override;
@@ -79,20 +105,26 @@ private:
     struct BufferedBlock
     {
         BufferedBlock (AudioFormatReader& reader, int64 pos, int numSamples);
+        BufferedBlock (const AudioBuffer<float>& source, int sourceOffset, int64 pos, int numSamples, bool allSamplesRead);
 
         Range<int64> range;
         AudioBuffer<float> buffer;
         bool allSamplesRead = false;
     };
 
+    BufferingAudioReader (AudioFormatReader*, TimeSliceThread*, ReadAheadScheduler*, int);
+
     int useTimeSlice() override;
+    double getSecondsUntilUnderrun() override;
+    int readAhead (int maxSamplesToRead) override;
     BufferedBlock* getBlockContaining (int64 pos) const noexcept;
-    bool readNextBufferChunk();
+    int readNextBufferChunk (int maxBlocksToRead);
 
     static constexpr int samplesPerBlock = 32768;
 
     std::unique_ptr<AudioFormatReader> source;
-    TimeSliceThread& thread;
+    TimeSliceThread* const thread;
+    ReadAheadScheduler* const scheduler;
     std::atomic<int64> nextReadPosition { 0 };
     const int numBlocks;
     int timeoutMs = 0;
@@ -0,0 +1,812 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+MultiFileRecorder::Statistics MultiFileRecorder::Client::getStatistics() const
+{
+    Statistics s;
+    s.worstFifoFill     = worstFifoFill.load();
+    s.numOverflows      = numOverflows.load();
+    s.numWrites         = numWrites.load();
+    s.numSamplesWritten = numSamplesWritten.load();
+    return s;
+}
+
+void MultiFileRecorder::Client::resetStatistics()
+{
+    worstFifoFill = 0.0f;
+    numOverflows = 0;
+    numWrites = 0;
+    numSamplesWritten = 0;
+}
+
+void MultiFileRecorder::Client::updateFifoStatistics (int numSamplesWaiting, int fifoSize, bool overflowed) noexcept
+{
+    if (overflowed)
+        ++numOverflows;
+
+    const auto fill = overflowed ? 1.0f : (float) numSamplesWaiting / (float) jmax (1, fifoSize);
+
+    if (fill > worstFifoFill.load())
+        worstFifoFill = fill;
+}
+
+//==============================================================================
+class MultiFileRecorder::Worker final : public Thread
+{
+public:
+    explicit Worker (MultiFileRecorder& r)
+        : Thread ("Recorder FIFOs"), recorder (r)
+    {
+    }
+
+    ~Worker() override
+    {
+        signalThreadShouldExit();
+        recorder.workAvailable.signal();
+        stopThread (-1);
+    }
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            if (auto* client = recorder.takeFullestClient())
+            {
+                const auto numWritten = client->writeWaitingSamples();
+
+                if (numWritten > 0)
+                {
+                    ++client->numWrites;
+                    client->numSamplesWritten += numWritten;
+                }
+
+                recorder.finishedWriting (client);
+            }
+            else
+            {
+                // Clients only call notify() when they're getting full, so this
+                // also checks them again every few milliseconds
+                recorder.workAvailable.wait (10);
+            }
+        }
+    }
+
+private:
+    MultiFileRecorder& recorder;
+
+    JUCE_DECLARE_NON_COPYABLE (Worker)
+};
+
+//==============================================================================
+struct MultiFileRecorder::Block
+{
+    explicit Block (int size) : data ((size_t) size) {}
+
+    HeapBlock<char> data;
+    BlockStream* stream = nullptr;
+    int64 start = 0;
+    int numBytes = 0;
+};
+
+//==============================================================================
+class MultiFileRecorder::BlockStream final : public OutputStream
+{
+public:
+    BlockStream (MultiFileRecorder& r, std::unique_ptr<OutputStream> d)
+        : recorder (r), destination (std::move (d)), position (destination->getPosition())
+    {
+        const ScopedLock sl (recorder.blockLock);
+        ++recorder.numStreams;
+    }
+
+    ~BlockStream() override
+    {
+        finishWriting();
+
+        const ScopedLock sl (recorder.blockLock);
+        --recorder.numStreams;
+    }
+
+    void flush() override
+    {
+        finishWriting();
+        destination->flush();
+    }
+
+    int64 getPosition() override
+    {
+        return position;
+    }
+
+    bool setPosition (int64 newPosition) override
+    {
+        if (newPosition != position)
+        {
+            sendCurrentBlock();
+            position = newPosition;
+        }
+
+        return true;
+    }
+
+    bool write (const void* data, size_t numBytes) override
+    {
+        auto* source = static_cast<const char*> (data);
+        const auto size = (int64) recorder.blockSize;
+
+        while (numBytes > 0)
+        {
+            if (current == nullptr)
+            {
+                current = recorder.takeFreeBlock();
+                current->stream = this;
+                current->start = position;
+                current->numBytes = 0;
+            }
+
+            // Blocks end on multiples of the block size, so apart from the first,
+            // they're all aligned and the same size
+            const auto blockEnd = (current->start / size + 1) * size;
+            const auto num = (int) jmin ((int64) numBytes, blockEnd - position);
+
+            memcpy (current->data + current->numBytes, source, (size_t) num);
+            current->numBytes += num;
+            position += num;
+            source += num;
+            numBytes -= (size_t) num;
+
+            if (position == blockEnd)
+                sendCurrentBlock();
+        }
+
+        return ! writeFailed;
+    }
+
+    // Called on the disk thread
+    void writeBlock (const Block& block)
+    {
+        if (! (destination->setPosition (block.start) && destination->write (block.data, (size_t) block.numBytes)))
+            writeFailed = true;
+    }
+
+    int numBlocksPending = 0;   // protected by the recorder's blockLock
+
+private:
+    void sendCurrentBlock()
+    {
+        if (current == nullptr)
+            return;
+
+        if (current->numBytes > 0)
+        {
+            recorder.queueBlock (std::move (current));
+        }
+        else
+        {
+            current->stream = nullptr;
+            recorder.finishedWithBlock (std::move (current));
+        }
+    }
+
+    void finishWriting()
+    {
+        sendCurrentBlock();
+
+        for (;;)
+        {
+            {
+                const ScopedLock sl (recorder.blockLock);
+
+                if (numBlocksPending == 0)
+                    return;
+            }
+
+            recorder.blockWritten.wait (5);
+        }
+    }
+
+    MultiFileRecorder& recorder;
+    std::unique_ptr<OutputStream> destination;
+    std::unique_ptr<Block> current;
+    int64 position;
+    std::atomic<bool> writeFailed { false };
+
+    JUCE_DECLARE_NON_COPYABLE (BlockStream)
+};
+
+//==============================================================================
+class MultiFileRecorder::DiskWriter final : public Thread
+{
+public:
+    explicit DiskWriter (MultiFileRecorder& r)
+        : Thread ("Recorder disk writer"), recorder (r)
+    {
+    }
+
+    ~DiskWriter() override
+    {
+        signalThreadShouldExit();
+        recorder.blocksQueued.signal();
+        stopThread (-1);
+    }
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            if (auto block = recorder.takeQueuedBlock())
+            {
+                block->stream->writeBlock (*block);
+                recorder.finishedWithBlock (std::move (block));
+            }
+            else
+            {
+                recorder.blocksQueued.wait (10);
+            }
+        }
+    }
+
+private:
+    MultiFileRecorder& recorder;
+
+    JUCE_DECLARE_NON_COPYABLE (DiskWriter)
+};
+
+//==============================================================================
+MultiFileRecorder::MultiFileRecorder (int minSamples, int size, int64 maxQueued, Thread::Priority priority)
+    : minSamplesPerWrite (jmax (1, minSamples)),
+      blockSize (jmax (4096, size)),
+      maxBytesQueued (jmax ((int64) size, maxQueued))
+{
+    worker = std::make_unique<Worker> (*this);
+    worker->startThread (priority);
+
+    diskWriter = std::make_unique<DiskWriter> (*this);
+    diskWriter->startThread (priority);
+}
+
+MultiFileRecorder::~MultiFileRecorder()
+{
+    // All the clients should have been removed, and all the streams
+    // deleted, before deleting the recorder!
+    jassert (clients.empty() && numStreams == 0);
+
+    worker.reset();
+    diskWriter.reset();
+}
+
+//==============================================================================
+std::unique_ptr<OutputStream> MultiFileRecorder::createOutputStream (const File& file, int64 numBytesToPreallocate)
+{
+    // The blocks are already big, so the file doesn't need a buffer of its own
+    auto stream = std::make_unique<FileOutputStream> (file, 0);
+
+    if (stream->failedToOpen())
+        return {};
+
+    stream->setPosition (0);
+    stream->truncate();
+
+    if (numBytesToPreallocate > 0)
+        stream->preallocate (numBytesToPreallocate);
+
+    return createOutputStream (std::move (stream));
+}
+
+std::unique_ptr<OutputStream> MultiFileRecorder::createOutputStream (std::unique_ptr<OutputStream> destination)
+{
+    if (destination == nullptr)
+        return {};
+
+    return std::make_unique<BlockStream> (*this, std::move (destination));
+}
+
+std::unique_ptr<MultiFileRecorder::Block> MultiFileRecorder::takeFreeBlock()
+{
+    {
+        const ScopedLock sl (blockLock);
+
+        if (! freeBlocks.empty())
+        {
+            auto block = std::move (freeBlocks.back());
+            freeBlocks.pop_back();
+            return block;
+        }
+    }
+
+    return std::make_unique<Block> (blockSize);
+}
+
+void MultiFileRecorder::queueBlock (std::unique_ptr<Block> block)
+{
+    {
+        const ScopedLock sl (blockLock);
+
+        // Holding things up here stops the FIFOs being emptied, so if the disk can't
+        // keep up, it shows in the writers' statistics rather than using more memory
+        while (numBytesQueued >= maxBytesQueued)
+        {
+            const ScopedUnlock ul (blockLock);
+            blockWritten.wait (5);
+        }
+
+        numBytesQueued += block->numBytes;
+        ++block->stream->numBlocksPending;
+        queuedBlocks.push_back (std::move (block));
+    }
+
+    blocksQueued.signal();
+}
+
+std::unique_ptr<MultiFileRecorder::Block> MultiFileRecorder::takeQueuedBlock()
+{
+    const ScopedLock sl (blockLock);
+
+    if (queuedBlocks.empty())
+        return {};
+
+    auto block = std::move (queuedBlocks.front());
+    queuedBlocks.pop_front();
+    return block;
+}
+
+void MultiFileRecorder::finishedWithBlock (std::unique_ptr<Block> block)
+{
+    {
+        const ScopedLock sl (blockLock);
+
+        if (block->stream != nullptr)
+        {
+            numBytesQueued -= block->numBytes;
+            --block->stream->numBlocksPending;
+            block->stream = nullptr;
+        }
+
+        freeBlocks.push_back (std::move (block));
+    }
+
+    blockWritten.signal();
+}
+
+//==============================================================================
+void MultiFileRecorder::addClient (Client* clientToAdd)
+{
+    if (clientToAdd == nullptr)
+        return;
+
+    {
+        const ScopedLock sl (lock);
+
+        if (std::find (clients.begin(), clients.end(), clientToAdd) != clients.end())
+            return;
+
+        clients.push_back (clientToAdd);
+    }
+
+    notify();
+}
+
+void MultiFileRecorder::removeClient (Client* clientToRemove)
+{
+    const ScopedLock sl (lock);
+
+    clients.erase (std::remove (clients.begin(), clients.end(), clientToRemove), clients.end());
+
+    while (std::find (clientsBeingWritten.begin(), clientsBeingWritten.end(), clientToRemove) != clientsBeingWritten.end())
+    {
+        const ScopedUnlock ul (lock);
+        writeFinished.wait (5);
+    }
+}
+
+int MultiFileRecorder::getNumClients() const
+{
+    const ScopedLock sl (lock);
+    return (int) clients.size();
+}
+
+void MultiFileRecorder::notify() noexcept
+{
+    workAvailable.signal();
+}
+
+MultiFileRecorder::Statistics MultiFileRecorder::getTotalStatistics() const
+{
+    const ScopedLock sl (lock);
+    Statistics total;
+
+    for (auto* c : clients)
+    {
+        const auto s = c->getStatistics();
+        total.worstFifoFill = jmax (total.worstFifoFill, s.worstFifoFill);
+        total.numOverflows += s.numOverflows;
+        total.numWrites += s.numWrites;
+        total.numSamplesWritten += s.numSamplesWritten;
+    }
+
+    return total;
+}
+
+//==============================================================================
+MultiFileRecorder::Client* MultiFileRecorder::takeFullestClient()
+{
+    const ScopedLock sl (lock);
+
+    Client* best = nullptr;
+    auto bestFill = 0.0f;
+
+    for (auto* c : clients)
+    {
+        if (std::find (clientsBeingWritten.begin(), clientsBeingWritten.end(), c) != clientsBeingWritten.end())
+            continue;
+
+        const auto fifoSize = c->getFifoSize();
+        const auto numSamples = c->getNumSamplesWaiting();
+
+        if (numSamples <= 0 || numSamples < jmin (minSamplesPerWrite, fifoSize / 2))
+            continue;
+
+        const auto fill = (float) numSamples / (float) jmax (1, fifoSize);
+
+        if (fill > bestFill)
+        {
+            best = c;
+            bestFill = fill;
+        }
+    }
+
+    if (best == nullptr)
+        return nullptr;
+
+    clientsBeingWritten.push_back (best);
+    return best;
+}
+
+void MultiFileRecorder::finishedWriting (Client* client)
+{
+    {
+        const ScopedLock sl (lock);
+        clientsBeingWritten.erase (std::find (clientsBeingWritten.begin(), clientsBeingWritten.end(), client));
+    }
+
+    writeFinished.signal();
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class MultiFileRecorderTests final : public UnitTest
+{
+public:
+    MultiFileRecorderTests()  : UnitTest ("MultiFileRecorder", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        beginTest ("Recording with a MultiFileRecorder writes the right data");
+        {
+            MultiFileRecorder recorder (2048, 16384);
+            recordAndCheck ([&] (AudioFormatWriter* w) { return std::make_unique<AudioFormatWriter::ThreadedWriter> (w, recorder, 8192); },
+                            recorder);
+
+            expectEquals (recorder.getNumClients(), 0);
+        }
+
+        beginTest ("Recording with a TimeSliceThread writes the right data");
+        {
+            TimeSliceThread thread ("Recorder test");
+            thread.startThread();
+            MultiFileRecorder recorder;
+
+            recordAndCheck ([&] (AudioFormatWriter* w) { return std::make_unique<AudioFormatWriter::ThreadedWriter> (w, thread, 8192); },
+                            recorder);
+        }
+
+        beginTest ("Statistics");
+        {
+            MultiFileRecorder recorder;
+            std::unique_ptr<OutputStream> stream = std::make_unique<MemoryOutputStream>();
+            auto writer = WavAudioFormat().createWriterFor (stream, AudioFormatWriterOptions{}.withSampleRate (44100.0)
+                                                                                            .withNumChannels (1)
+                                                                                            .withBitsPerSample (16));
+            AudioFormatWriter::ThreadedWriter threadedWriter (writer.release(), recorder, 1000);
+
+            AudioBuffer<float> block (1, 400);
+            block.clear();
+
+            // The recorder won't write anything until the FIFO is half full
+            expect (threadedWriter.write (block.getArrayOfReadPointers(), 400));
+            expectWithinAbsoluteError (threadedWriter.getStatistics().worstFifoFill, 0.4f, 0.01f);
+
+            expect (threadedWriter.write (block.getArrayOfReadPointers(), 400));
+            expectWithinAbsoluteError (threadedWriter.getStatistics().worstFifoFill, 0.8f, 0.01f);
+
+            for (int i = 0; i < 200 && threadedWriter.getStatistics().numWrites == 0; ++i)
+                Thread::sleep (10);
+
+            const auto stats = threadedWriter.getStatistics();
+            expectEquals (stats.numWrites, 1);
+            expectEquals (stats.numSamplesWritten, (int64) 800);
+            expectEquals (stats.numOverflows, 0);
+        }
+    }
+
+private:
+    template <typename CreateWriter>
+    void recordAndCheck (CreateWriter&& createWriter, MultiFileRecorder& recorder)
+    {
+        constexpr int numTracks = 8, numChannels = 2, numSamples = 100000;
+
+        auto random = getRandom();
+        WavAudioFormat wav;
+        std::vector<std::unique_ptr<TemporaryFile>> files;
+        std::vector<AudioBuffer<float>> sources;
+        std::vector<std::unique_ptr<AudioFormatWriter::ThreadedWriter>> writers;
+
+        for (int t = 0; t < numTracks; ++t)
+        {
+            files.push_back (std::make_unique<TemporaryFile> (".wav"));
+            sources.emplace_back (numChannels, numSamples);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                for (int i = 0; i < numSamples; ++i)
+                    sources.back().setSample (ch, i, random.nextFloat() * 1.8f - 0.9f);
+
+            std::unique_ptr<OutputStream> stream = recorder.createOutputStream (files.back()->getFile(), numSamples * numChannels * 3);
+            expect (stream != nullptr);
+
+            auto writer = wav.createWriterFor (stream, AudioFormatWriterOptions{}.withSampleRate (48000.0)
+                                                                                .withNumChannels (numChannels)
+                                                                                .withBitsPerSample (24));
+            writers.push_back (createWriter (writer.release()));
+        }
+
+        std::vector<int> positions ((size_t) numTracks, 0);
+
+        for (auto finished = false; ! finished;)
+        {
+            finished = true;
+
+            for (int t = 0; t < numTracks; ++t)
+            {
+                auto& pos = positions[(size_t) t];
+                const auto num = jmin (numSamples - pos, 1 + random.nextInt (2000));
+
+                if (num <= 0)
+                    continue;
+
+                finished = false;
+                const float* chans[] = { sources[(size_t) t].getReadPointer (0, pos), sources[(size_t) t].getReadPointer (1, pos) };
+
+                if (writers[(size_t) t]->write (chans, num))
+                    pos += num;
+                else
+                    Thread::sleep (1);
+            }
+        }
+
+        writers.clear();
+
+        for (int t = 0; t < numTracks; ++t)
+        {
+            std::unique_ptr<AudioFormatReader> reader (wav.createReaderFor (files[(size_t) t]->getFile().createInputStream().release(), true));
+            expect (reader != nullptr);
+            expectEquals (reader->lengthInSamples, (int64) numSamples);
+
+            AudioBuffer<float> result (numChannels, numSamples);
+            reader->read (&result, 0, numSamples, 0, true, true);
+
+            auto maxError = 0.0f;
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                for (int i = 0; i < numSamples; ++i)
+                    maxError = jmax (maxError, std::abs (result.getSample (ch, i) - sources[(size_t) t].getSample (ch, i)));
+
+            expectLessThan (maxError, 1.0f / (1 << 22));
+        }
+    }
+};
+
+static MultiFileRecorderTests multiFileRecorderTests;
+
+//==============================================================================
+class MultiFileRecorderBenchmarks final : public UnitTest
+{
+public:
+    MultiFileRecorderBenchmarks()  : UnitTest ("MultiFileRecorder benchmarks", UnitTestCategories::benchmarks)  {}
+
+    void runTest() override
+    {
+        beginTest ("Recording many tracks to a slow disk");
+
+        {
+            logMessage ("TimeSliceThread, 16 KB stream buffers:");
+            TimeSliceThread thread ("Recording");
+            thread.startThread (Thread::Priority::high);
+
+            record ([&] (SlowDisk& disk) { return std::make_unique<SlowDiskStream> (disk, 16384); },
+                    [&] (AudioFormatWriter* w) { return std::make_unique<AudioFormatWriter::ThreadedWriter> (w, thread, fifoSize); });
+        }
+
+        {
+            logMessage ("MultiFileRecorder, 256 KB blocks:");
+            MultiFileRecorder recorder;
+
+            record ([&] (SlowDisk& disk) { return recorder.createOutputStream (std::make_unique<SlowDiskStream> (disk, 0)); },
+                    [&] (AudioFormatWriter* w) { return std::make_unique<AudioFormatWriter::ThreadedWriter> (w, recorder, fifoSize); });
+        }
+    }
+
+private:
+    static constexpr int numTracks = 128, sampleRate = 48000, blockSize = 512, fifoSize = sampleRate;
+    static constexpr double secondsToRecord = 10.0;
+
+    // Behaves like a disk that can only do one thing at a time, with a limited transfer
+    // rate, and a cost for each seek whenever a write doesn't follow on from the last one
+    struct SlowDisk
+    {
+        void access (const void* stream, int64 position, int numBytes)
+        {
+            double finishTime;
+
+            {
+                const ScopedLock sl (lock);
+                const auto isSeek = stream != lastStream || position != lastPosition;
+                lastStream = stream;
+                lastPosition = position + numBytes;
+
+                finishTime = jmax (Time::getMillisecondCounterHiRes(), busyUntil)
+                               + (isSeek ? millisecondsPerSeek : 0.0) + numBytes / bytesPerMillisecond;
+                busyUntil = finishTime;
+                ++numWrites;
+            }
+
+            // Short waits are left to build up, as sleeps can't be that precise
+            const auto msToWait = finishTime - Time::getMillisecondCounterHiRes();
+
+            if (msToWait >= 1.0)
+                Thread::sleep ((int) msToWait);
+        }
+
+        static constexpr double millisecondsPerSeek = 2.0, bytesPerMillisecond = 100000.0;
+        CriticalSection lock;
+        double busyUntil = 0;
+        const void* lastStream = nullptr;
+        int64 lastPosition = 0;
+        int numWrites = 0;
+    };
+
+    // Discards the data, but buffers it like a FileOutputStream, sending each
+    // full buffer to the disk in one go
+    struct SlowDiskStream final : public OutputStream
+    {
+        SlowDiskStream (SlowDisk& d, int size) : disk (d), bufferSize (size) {}
+        ~SlowDiskStream() override      { flush(); }
+
+        void flush() override
+        {
+            if (numBuffered > 0)
+                disk.access (this, position - numBuffered, numBuffered);
+
+            numBuffered = 0;
+        }
+
+        int64 getPosition() override    { return position; }
+
+        bool setPosition (int64 newPosition) override
+        {
+            flush();
+            position = newPosition;
+            return true;
+        }
+
+        bool write (const void*, size_t numBytes) override
+        {
+            position += (int64) numBytes;
+            numBuffered += (int) numBytes;
+
+            if (numBuffered >= bufferSize)
+                flush();
+
+            return true;
+        }
+
+        SlowDisk& disk;
+        const int bufferSize;
+        int64 position = 0;
+        int numBuffered = 0;
+    };
+
+    template <typename CreateStream, typename CreateWriter>
+    void record (CreateStream&& createStream, CreateWriter&& createWriter)
+    {
+        SlowDisk disk;
+        WavAudioFormat wav;
+        std::vector<std::unique_ptr<AudioFormatWriter::ThreadedWriter>> writers;
+
+        for (int i = 0; i < numTracks; ++i)
+        {
+            std::unique_ptr<OutputStream> stream = createStream (disk);
+            auto writer = wav.createWriterFor (stream, AudioFormatWriterOptions{}.withSampleRate (sampleRate)
+                                                                                .withNumChannels (1)
+                                                                                .withBitsPerSample (24));
+            writers.push_back (createWriter (writer.release()));
+        }
+
+        // Records all the tracks in real time, like an audio callback would
+        AudioBuffer<float> block (1, blockSize);
+        block.clear();
+
+        const auto blockMs = 1000.0 * blockSize / sampleRate;
+        const auto startTime = Time::getMillisecondCounterHiRes();
+        auto nextBlockTime = startTime;
+
+        while (nextBlockTime < startTime + 1000.0 * secondsToRecord)
+        {
+            for (auto& w : writers)
+                w->write (block.getArrayOfReadPointers(), blockSize);
+
+            nextBlockTime += blockMs;
+
+            while (Time::getMillisecondCounterHiRes() < nextBlockTime)
+                Thread::sleep (1);
+        }
+
+        auto worstFill = 0.0f;
+        auto numOverflows = 0, numTracksWithOverflows = 0;
+
+        for (auto& w : writers)
+        {
+            const auto stats = w->getStatistics();
+            worstFill = jmax (worstFill, stats.worstFifoFill);
+            numOverflows += stats.numOverflows;
+            numTracksWithOverflows += stats.numOverflows > 0 ? 1 : 0;
+        }
+
+        logMessage ("  worst FIFO fill " + String (roundToInt (worstFill * 100.0f)) + "%, "
+                      + String (numOverflows) + " blocks dropped on " + String (numTracksWithOverflows) + " tracks, "
+                      + String (disk.numWrites) + " disk writes");
+
+        writers.clear();
+    }
+};
+
+static MultiFileRecorderBenchmarks multiFileRecorderBenchmarks;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,230 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Does the disk writing for a lot of AudioFormatWriter::ThreadedWriter objects
+    at once, such as when recording many tracks together.
+
+    A TimeSliceThread gives each of its writers a turn in a fixed order, and each
+    turn writes a small part of the writer's FIFO. With many tracks, this means a
+    steady stream of small writes that are spread across lots of files, and a slow
+    write to one file holds up all the others.
+
+    This class splits the work in two. One thread empties the writers' FIFOs,
+    always dealing with the fullest first, and waiting until a writer has a
+    sizeable amount of audio before giving it a turn. The writers' output goes to
+    streams made by createOutputStream(), which collect the data into large
+    blocks that line up with multiples of the block size in the file. A second
+    thread then writes the finished blocks from all the files to disk. So the disk
+    sees a few big writes per file, and the FIFOs keep being emptied even while
+    the disk is busy.
+
+    @code
+    MultiFileRecorder recorder;
+    WavAudioFormat wav;
+
+    auto stream = recorder.createOutputStream (file, expectedLengthInBytes);
+    auto writer = wav.createWriterFor (stream, AudioFormatWriterOptions{}.withSampleRate (48000.0)
+                                                                        .withNumChannels (1)
+                                                                        .withBitsPerSample (24));
+
+    AudioFormatWriter::ThreadedWriter threadedWriter (writer.release(), recorder, 65536);
+    @endcode
+
+    @see AudioFormatWriter::ThreadedWriter
+
+    @tags{Audio}
+*/
+class JUCE_API  MultiFileRecorder
+{
+public:
+    //==============================================================================
+    /** Counters that describe how well a writer's FIFO has been kept drained. */
+    struct Statistics
+    {
+        /** The highest proportion of the FIFO that has been full, from 0 to 1. */
+        float worstFifoFill = 0.0f;
+
+        /** The number of blocks that were rejected because the FIFO was full. */
+        int numOverflows = 0;
+
+        /** The number of background writes. */
+        int numWrites = 0;
+
+        /** The total number of samples written in the background. */
+        int64 numSamplesWritten = 0;
+    };
+
+    //==============================================================================
+    /**
+        An object with a FIFO of audio that a MultiFileRecorder writes to disk.
+
+        Make sure you call removeClient() before deleting one of these.
+    */
+    class JUCE_API  Client
+    {
+    public:
+        /** Destructor. */
+        virtual ~Client() = default;
+
+        /** Returns the number of samples that are waiting to be written. This is called
+            often, and while the recorder holds a lock, so it must be quick.
+        */
+        virtual int getNumSamplesWaiting() = 0;
+
+        /** Returns the total size of the client's FIFO, in samples. */
+        virtual int getFifoSize() = 0;
+
+        /** Writes all the samples that are waiting, returning the number written. */
+        virtual int writeWaitingSamples() = 0;
+
+        /** Returns the client's statistics. This can be called from any thread. */
+        Statistics getStatistics() const;
+
+        /** Resets the client's statistics. */
+        void resetStatistics();
+
+    protected:
+        /** Clients should call this after adding data to their FIFO, or failing to, so
+            that the statistics are kept up to date. This doesn't block or allocate, so
+            it can be called on the audio thread.
+        */
+        void updateFifoStatistics (int numSamplesWaiting, int fifoSize, bool overflowed) noexcept;
+
+    private:
+        friend class MultiFileRecorder;
+
+        std::atomic<float> worstFifoFill { 0.0f };
+        std::atomic<int> numOverflows { 0 }, numWrites { 0 };
+        std::atomic<int64> numSamplesWritten { 0 };
+    };
+
+    //==============================================================================
+    /** Creates a recorder.
+
+        @param minSamplesPerWrite   a writer isn't given a turn until it has at least this
+                                    many samples waiting, or its FIFO is half full
+        @param blockSize            the size of the blocks that are written to disk, in
+                                    bytes. Each stream made by createOutputStream() keeps
+                                    one of these in memory while it's being filled
+        @param maxBytesQueued       the most data that can be waiting to be written to disk.
+                                    If the disk can't keep up, the writers' FIFOs stop being
+                                    emptied when this is reached
+        @param threadPriority       the priority of the background threads
+    */
+    explicit MultiFileRecorder (int minSamplesPerWrite = 16384,
+                                int blockSize = 256 * 1024,
+                                int64 maxBytesQueued = 64 * 1024 * 1024,
+                                Thread::Priority threadPriority = Thread::Priority::high);
+
+    /** Destructor. All clients must have been removed, and all the streams that were
+        created by this recorder deleted, before the recorder is deleted.
+    */
+    ~MultiFileRecorder();
+
+    //==============================================================================
+    /** Creates a stream to write a new file, replacing any file that's already there.
+
+        The data written to the stream is collected into blocks, which are written to
+        the file by the recorder's disk thread. If a size is given, space is reserved
+        for the file up front, which helps to keep it in one piece on disk; the file's
+        length isn't affected. Returns nullptr if the file can't be opened.
+    */
+    std::unique_ptr<OutputStream> createOutputStream (const File& file,
+                                                      int64 numBytesToPreallocate = 0);
+
+    /** Creates a stream that collects the data written to it into blocks, which are
+        written to the destination stream by the recorder's disk thread. The destination
+        must be able to change its position.
+    */
+    std::unique_ptr<OutputStream> createOutputStream (std::unique_ptr<OutputStream> destination);
+
+    //==============================================================================
+    /** Adds a client. Writes may start before this method returns. */
+    void addClient (Client* clientToAdd);
+
+    /** Removes a client, waiting for any write that's in progress for it to finish. */
+    void removeClient (Client* clientToRemove);
+
+    /** Returns the number of clients. */
+    int getNumClients() const;
+
+    /** Makes the threads look for work straight away. */
+    void notify() noexcept;
+
+    /** Returns the combined statistics of all the current clients, with the worst
+        FIFO fill being the highest of any of them.
+    */
+    Statistics getTotalStatistics() const;
+
+private:
+    //==============================================================================
+    class Worker;
+    class DiskWriter;
+    class BlockStream;
+    struct Block;
+
+    Client* takeFullestClient();
+    void finishedWriting (Client*);
+
+    std::unique_ptr<Block> takeFreeBlock();
+    void queueBlock (std::unique_ptr<Block>);
+    std::unique_ptr<Block> takeQueuedBlock();
+    void finishedWithBlock (std::unique_ptr<Block>);
+
+    const int minSamplesPerWrite, blockSize;
+    const int64 maxBytesQueued;
+
+    CriticalSection lock;
+    std::vector<Client*> clients, clientsBeingWritten;
+    WaitableEvent workAvailable, writeFinished;
+
+    CriticalSection blockLock;
+    std::vector<std::unique_ptr<Block>> freeBlocks;
+    std::deque<std::unique_ptr<Block>> queuedBlocks;
+    int64 numBytesQueued = 0;
+    int numStreams = 0;
+    WaitableEvent blocksQueued, blockWritten;
+
+    std::unique_ptr<Worker> worker;
+    std::unique_ptr<DiskWriter> diskWriter;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MultiFileRecorder)
+};
+
+} // namespace juce
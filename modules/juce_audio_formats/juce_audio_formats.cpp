@@ -66,8 +66,10 @@
 #include "format/juce_AudioFormatReader.cpp"
 #include "format/juce_AudioFormatReaderSource.cpp"
 #include "format/juce_AudioFormatWriter.cpp"
+#include "format/juce_AudioSeekIndex.cpp"
 #include "format/juce_AudioSubsectionReader.cpp"
 #include "format/juce_BufferingAudioFormatReader.cpp"
+#include "format/juce_MultiFileRecorder.cpp"
 #include "sampler/juce_Sampler.cpp"
 #include "codecs/juce_AiffAudioFormat.cpp"
 #include "codecs/juce_CoreAudioFormat.cpp"
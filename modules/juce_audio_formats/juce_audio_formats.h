@@ -122,8 +122,10 @@
 //==============================================================================
 #include "format/juce_AudioFormatReader.h"
 #include "format/juce_AudioFormatWriterOptions.h"
+#include "format/juce_MultiFileRecorder.h"
 #include "format/juce_AudioFormatWriter.h"
 #include "format/juce_MemoryMappedAudioFormatReader.h"
+#include "format/juce_AudioSeekIndex.h"
 #include "format/juce_AudioFormat.h"
 #include "format/juce_AudioFormatManager.h"
 #include "format/juce_AudioFormatReaderSource.h"
@@ -466,32 +466,33 @@ public:
 
                 auto* cacheData = getData (channelNum, clip.getX() - area.getX());
 
-                RectangleList<float> waveform;
-                waveform.ensureStorageAllocated (clip.getWidth());
+                const auto numColumns = (size_t) clip.getWidth();
+                spanTops.resize (numColumns);
+                spanBottoms.resize (numColumns);
 
-                auto x = (float) clip.getX();
-
-                for (int w = clip.getWidth(); --w >= 0;)
+                for (size_t i = 0; i < numColumns; ++i)
                 {
                     if (cacheData->isNonZero())
                     {
-                        auto top    = jmax (midY - cacheData->getMaxValue() * vscale - 0.3f, topY);
-                        auto bottom = jmin (midY - cacheData->getMinValue() * vscale + 0.3f, bottomY);
-
-                        waveform.addWithoutMerging (Rectangle<float> (x, top, 1.0f, bottom - top));
+                        spanTops[i]    = jmax (midY - cacheData->getMaxValue() * vscale - 0.3f, topY);
+                        spanBottoms[i] = jmin (midY - cacheData->getMinValue() * vscale + 0.3f, bottomY);
+                    }
+                    else
+                    {
+                        spanTops[i] = spanBottoms[i] = midY;
                     }
 
-                    x += 1.0f;
                     ++cacheData;
                 }
 
-                g.fillRectList (waveform);
+                g.fillVerticalSpans ((float) clip.getX(), 1.0f, spanTops, spanBottoms);
             }
         }
     }
 
 private:
     Array<MinMaxValue> data;
+    std::vector<float> spanTops, spanBottoms;
     double cachedStart = 0, cachedTimePerPixel = 0;
     int numChannelsCached = 0, numSamplesCached = 0;
     bool cacheNeedsRefilling = true;
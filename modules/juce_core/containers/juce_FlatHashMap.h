@@ -0,0 +1,1016 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#if JUCE_INTEL && (defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2))
+ #define JUCE_FLAT_HASH_TABLE_USE_SSE2 1
+ #if ! JUCE_MSVC
+  #include <emmintrin.h>
+ #endif
+#elif JUCE_ARM && (defined (__ARM_NEON) || defined (__ARM_NEON__) || defined (_M_ARM64)) && ! JUCE_32BIT
+ #define JUCE_FLAT_HASH_TABLE_USE_NEON 1
+ #if JUCE_MSVC
+  #include <arm64_neon.h>
+ #else
+  #include <arm_neon.h>
+ #endif
+#endif
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Generates 64-bit hashes for the FlatHashMap and FlatHashSet classes.
+
+    Unlike DefaultHashFunctions, the values returned here aren't reduced to a number
+    of slots: the table does that itself, and also uses some of the hash bits to
+    filter out most non-matching keys before comparing them.
+
+    Strings, StringRefs, C strings and Identifiers all produce the same hash for the
+    same text (the one that StringPool::getHash() returns), which is what lets a map
+    with String or Identifier keys be searched using a StringRef.
+
+    @see FlatHashMap, FlatHashSet, DefaultHashFunctions
+
+    @tags{Core}
+*/
+struct DefaultFlatHashFunctions
+{
+    /** Generates a hash from a uint64. */
+    static uint64 generateHash (uint64 key) noexcept              { return key; }
+    /** Generates a hash from an int64. */
+    static uint64 generateHash (int64 key) noexcept               { return (uint64) key; }
+    /** Generates a hash from an unsigned int. */
+    static uint64 generateHash (uint32 key) noexcept              { return key; }
+    /** Generates a hash from an integer. */
+    static uint64 generateHash (int32 key) noexcept               { return (uint32) key; }
+    /** Generates a hash from a string. */
+    static uint64 generateHash (const String& key) noexcept       { return StringPool::getHash (key); }
+    /** Generates a hash from a StringRef, matching the hash of an equivalent String. */
+    static uint64 generateHash (StringRef key) noexcept           { return StringPool::getHash (key); }
+    /** Generates a hash from a C string, matching the hash of an equivalent String. */
+    static uint64 generateHash (const char* key) noexcept         { return StringPool::getHash (key); }
+    /** Generates a hash from an Identifier, using the hash that it stores. */
+    static uint64 generateHash (const Identifier& key) noexcept   { return key.getHash(); }
+    /** Generates a hash from a void ptr. */
+    static uint64 generateHash (const void* key) noexcept         { return (uint64) (pointer_sized_uint) key; }
+    /** Generates a hash from a UUID. */
+    static uint64 generateHash (const Uuid& key) noexcept         { return key.hash(); }
+};
+
+#ifndef DOXYGEN
+namespace detail
+{
+
+//==============================================================================
+/*  The open-addressing table that FlatHashMap and FlatHashSet are built on.
+
+    This follows the "SwissTable" layout: as well as the array of elements, there's
+    an array with one control byte per slot, which is either empty, deleted, or holds
+    the low 7 bits of the hash of the key in that slot. Lookups load a whole group of
+    control bytes at once and compare them all against the hash of the key being
+    searched for, so only the slots whose bytes match need their keys compared, and a
+    search can stop as soon as a group contains an empty slot.
+
+    The control array has an extra group's worth of bytes at the end which mirror
+    the first ones, so that a group can be loaded from any position without wrapping.
+*/
+template <typename Traits, typename HashFunctionType>
+class FlatHashTable
+{
+public:
+    using KeyType     = typename Traits::Key;
+    using ElementType = typename Traits::Element;
+
+    explicit FlatHashTable (HashFunctionType hashFunction)  : hashFunctionToUse (hashFunction) {}
+
+    FlatHashTable (const FlatHashTable& other)
+        : hashFunctionToUse (other.hashFunctionToUse)
+    {
+        if (other.numItems == 0)
+            return;
+
+        allocate (other.capacity);
+        std::memcpy (control.get(), other.control.get(), (size_t) (capacity + Group::width));
+
+        for (int i = 0; i < capacity; ++i)
+            if (isFull (control[i]))
+                new (elements + i) ElementType (other.elements[i]);
+
+        numItems = other.numItems;
+        growthLeft = other.growthLeft;
+    }
+
+    FlatHashTable (FlatHashTable&& other) noexcept
+        : hashFunctionToUse (other.hashFunctionToUse)
+    {
+        swapWith (other);
+    }
+
+    FlatHashTable& operator= (const FlatHashTable& other)
+    {
+        if (this != &other)
+        {
+            auto copy (other);
+            swapWith (copy);
+        }
+
+        return *this;
+    }
+
+    FlatHashTable& operator= (FlatHashTable&& other) noexcept
+    {
+        auto moved (std::move (other));
+        swapWith (moved);
+        return *this;
+    }
+
+    ~FlatHashTable()
+    {
+        destroyElements();
+    }
+
+    //==============================================================================
+    void clear() noexcept
+    {
+        if (numItems > 0)
+        {
+            destroyElements();
+            resetControlBytes();
+        }
+    }
+
+    void swapWith (FlatHashTable& other) noexcept
+    {
+        control.swapWith (other.control);
+        std::swap (elements, other.elements);
+        std::swap (elementStorage, other.elementStorage);
+        std::swap (capacity, other.capacity);
+        std::swap (numItems, other.numItems);
+        std::swap (growthLeft, other.growthLeft);
+        std::swap (hashFunctionToUse, other.hashFunctionToUse);
+    }
+
+    void reserve (int numItemsToAllocate)
+    {
+        auto newCapacity = getCapacityNeededFor (numItemsToAllocate);
+
+        if (newCapacity > capacity)
+            rehash (newCapacity);
+    }
+
+    void shrinkToFit()
+    {
+        if (numItems == 0)
+        {
+            destroyElements();
+            control.free();
+            elementStorage.free();
+            elements = nullptr;
+            capacity = growthLeft = 0;
+        }
+        else
+        {
+            auto newCapacity = getCapacityNeededFor (numItems);
+
+            if (newCapacity < capacity)
+                rehash (newCapacity);
+        }
+    }
+
+    int size() const noexcept                               { return numItems; }
+    int getCapacity() const noexcept                        { return capacity; }
+
+    //==============================================================================
+    template <typename LookupType>
+    int findIndex (const LookupType& key) const
+    {
+        if (numItems == 0)
+            return -1;
+
+        // String literals are looked up as StringRefs, which can be compared unambiguously
+        // with both Strings and Identifiers
+        if constexpr (std::is_convertible_v<const LookupType&, const char*> && ! std::is_pointer_v<KeyType>)
+            return findIndex (StringRef (key), mixHash (hashFunctionToUse.generateHash (StringRef (key))));
+        else
+            return findIndex (key, mixHash (hashFunctionToUse.generateHash (key)));
+    }
+
+    template <typename ElementFactory>
+    std::pair<int, bool> findOrInsert (const KeyType& key, ElementFactory&& createElement)
+    {
+        auto hash = mixHash (hashFunctionToUse.generateHash (key));
+
+        if (numItems > 0)
+        {
+            auto existing = findIndex (key, hash);
+
+            if (existing >= 0)
+                return { existing, false };
+        }
+
+        auto index = capacity > 0 ? findFirstNonFull (hash) : -1;
+
+        if (index < 0 || (growthLeft == 0 && control[index] == emptyByte))
+        {
+            rehash (getCapacityNeededFor (numItems + 1));
+            index = findFirstNonFull (hash);
+        }
+
+        new (elements + index) ElementType (createElement());
+
+        if (control[index] == emptyByte)
+            --growthLeft;
+
+        setControlByte (index, getH2 (hash));
+        ++numItems;
+        return { index, true };
+    }
+
+    void removeAt (int index) noexcept
+    {
+        jassert (isPositiveAndBelow (index, capacity) && isFull (control[index]));
+
+        elements[index].~ElementType();
+        --numItems;
+
+        if (numItems == 0)
+            resetControlBytes();
+        else
+            setControlByte (index, deletedByte);
+    }
+
+    template <typename Predicate>
+    int removeIf (Predicate&& shouldRemove)
+    {
+        int numRemoved = 0;
+
+        for (int i = 0; i < capacity; ++i)
+        {
+            if (isFull (control[i]) && shouldRemove (elements[i]))
+            {
+                removeAt (i);
+                ++numRemoved;
+            }
+        }
+
+        return numRemoved;
+    }
+
+    //==============================================================================
+    bool isOccupied (int index) const noexcept              { return isFull (control[index]); }
+    ElementType& getElement (int index) noexcept            { return elements[index]; }
+    const ElementType& getElement (int index) const noexcept { return elements[index]; }
+
+    int getNextOccupiedIndex (int index) const noexcept
+    {
+        while (++index < capacity)
+            if (isFull (control[index]))
+                break;
+
+        return jmin (index, capacity);
+    }
+
+    int getFirstOccupiedIndex() const noexcept              { return getNextOccupiedIndex (-1); }
+
+    const HashFunctionType& getHashFunction() const noexcept { return hashFunctionToUse; }
+
+private:
+    //==============================================================================
+    static constexpr int8 emptyByte = -128, deletedByte = -2;
+
+    static bool isFull (int8 c) noexcept                    { return c >= 0; }
+
+    // Spreads the bits of hashes that aren't well distributed (e.g. small integers or
+    // pointers), so that both the slot position and the 7 bits stored in the control
+    // bytes depend on all of the input bits.
+    static uint64 mixHash (uint64 hash) noexcept
+    {
+        hash = (hash ^ (hash >> 31)) * 0x9e3779b97f4a7c15ull;
+        return hash ^ (hash >> 32);
+    }
+
+    static int8 getH2 (uint64 hash) noexcept                { return (int8) (hash & 0x7f); }
+    static uint64 getH1 (uint64 hash) noexcept              { return hash >> 7; }
+
+    static int countTrailingZeros (uint64 n) noexcept
+    {
+        jassert (n != 0);
+
+       #if JUCE_MSVC
+        unsigned long index;
+        #if JUCE_64BIT
+         _BitScanForward64 (&index, n);
+        #else
+         if (_BitScanForward (&index, (unsigned long) n))
+             return (int) index;
+
+         _BitScanForward (&index, (unsigned long) (n >> 32));
+         index += 32;
+        #endif
+        return (int) index;
+       #else
+        return __builtin_ctzll (n);
+       #endif
+    }
+
+    //==============================================================================
+    // A bitmask with one set bit per matching control byte, at bit (index << shift).
+    struct BitMask
+    {
+        uint64 bits;
+        int shift;
+
+        explicit operator bool() const noexcept             { return bits != 0; }
+        int getLowestIndex() const noexcept                 { return countTrailingZeros (bits) >> shift; }
+        void removeLowest() noexcept                        { bits &= bits - 1; }
+    };
+
+   #if JUCE_FLAT_HASH_TABLE_USE_SSE2
+    struct Group
+    {
+        static constexpr int width = 16;
+
+        explicit Group (const int8* c) noexcept  : bytes (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (c))) {}
+
+        BitMask match (int8 h2) const noexcept              { return { (uint64) (uint32) _mm_movemask_epi8 (_mm_cmpeq_epi8 (_mm_set1_epi8 (h2), bytes)), 0 }; }
+        BitMask matchEmpty() const noexcept                 { return match (emptyByte); }
+        BitMask matchEmptyOrDeleted() const noexcept        { return { (uint64) (uint32) _mm_movemask_epi8 (bytes), 0 }; }
+
+        __m128i bytes;
+    };
+   #elif JUCE_FLAT_HASH_TABLE_USE_NEON
+    struct Group
+    {
+        static constexpr int width = 8;
+
+        explicit Group (const int8* c) noexcept  : bytes (vld1_s8 (c)) {}
+
+        BitMask match (int8 h2) const noexcept              { return toMask (vceq_s8 (vdup_n_s8 (h2), bytes)); }
+        BitMask matchEmpty() const noexcept                 { return match (emptyByte); }
+        BitMask matchEmptyOrDeleted() const noexcept        { return toMask (vcltz_s8 (bytes)); }
+
+        static BitMask toMask (uint8x8_t m) noexcept        { return { vget_lane_u64 (vreinterpret_u64_u8 (m), 0) & 0x8080808080808080ull, 3 }; }
+
+        int8x8_t bytes;
+    };
+   #else
+    // A portable version that compares 8 control bytes at a time inside a uint64.
+    struct Group
+    {
+        static constexpr int width = 8;
+        static constexpr uint64 lsbs = 0x0101010101010101ull, msbs = 0x8080808080808080ull;
+
+        explicit Group (const int8* c) noexcept  : bytes (ByteOrder::littleEndianInt64 (c)) {}
+
+        // This can report false positives for bytes next to a real match, but they're
+        // weeded out when the keys are compared.
+        BitMask match (int8 h2) const noexcept
+        {
+            auto x = bytes ^ (lsbs * (uint8) h2);
+            return { (x - lsbs) & ~x & msbs, 3 };
+        }
+
+        // Empty bytes are the only ones with the top bit set and bit 1 clear.
+        BitMask matchEmpty() const noexcept                 { return { bytes & ~(bytes << 6) & msbs, 3 }; }
+        BitMask matchEmptyOrDeleted() const noexcept        { return { bytes & msbs, 3 }; }
+
+        uint64 bytes;
+    };
+   #endif
+
+    //==============================================================================
+    template <typename LookupType>
+    int findIndex (const LookupType& key, uint64 hash) const
+    {
+        const auto mask = (uint64) (capacity - 1);
+        const auto h2 = getH2 (hash);
+        auto position = getH1 (hash) & mask;
+
+        for (uint64 step = Group::width;; step += Group::width)
+        {
+            Group group (control + position);
+
+            for (auto m = group.match (h2); m; m.removeLowest())
+            {
+                auto index = (int) ((position + (uint64) m.getLowestIndex()) & mask);
+
+                if (Traits::getKey (elements[index]) == key)
+                    return index;
+            }
+
+            if (group.matchEmpty())
+                return -1;
+
+            position = (position + step) & mask;
+        }
+    }
+
+    int findFirstNonFull (uint64 hash) const noexcept
+    {
+        const auto mask = (uint64) (capacity - 1);
+        auto position = getH1 (hash) & mask;
+
+        for (uint64 step = Group::width;; step += Group::width)
+        {
+            if (auto m = Group (control + position).matchEmptyOrDeleted())
+                return (int) ((position + (uint64) m.getLowestIndex()) & mask);
+
+            position = (position + step) & mask;
+        }
+    }
+
+    void setControlByte (int index, int8 value) noexcept
+    {
+        control[index] = value;
+
+        if (index < Group::width)
+            control[capacity + index] = value;
+    }
+
+    static int getMaxItemsForCapacity (int cap) noexcept    { return cap - cap / 8; }
+
+    static int getCapacityNeededFor (int numItemsNeeded) noexcept
+    {
+        if (numItemsNeeded <= 0)
+            return 0;
+
+        auto cap = (int) Group::width;
+
+        while (getMaxItemsForCapacity (cap) < numItemsNeeded && cap < (1 << 30))
+            cap *= 2;
+
+        return cap;
+    }
+
+    void allocate (int newCapacity)
+    {
+        jassert (isPowerOfTwo (newCapacity) && newCapacity >= Group::width);
+
+        const auto numSlots = (size_t) jlimit ((int) Group::width, 1 << 30, newCapacity);
+
+        control.malloc (numSlots + Group::width);
+        elementStorage.malloc (numSlots * sizeof (ElementType) + alignof (ElementType));
+        elements = reinterpret_cast<ElementType*> (snapPointerToAlignment (elementStorage.get(), alignof (ElementType)));
+        capacity = newCapacity;
+        resetControlBytes();
+    }
+
+    void resetControlBytes() noexcept
+    {
+        if (capacity > 0)
+            std::memset (control.get(), (uint8) emptyByte, (size_t) (capacity + Group::width));
+
+        numItems = 0;
+        growthLeft = getMaxItemsForCapacity (capacity);
+    }
+
+    void destroyElements() noexcept
+    {
+        if constexpr (! std::is_trivially_destructible_v<ElementType>)
+            for (int i = 0; i < capacity && numItems > 0; ++i)
+                if (isFull (control[i]))
+                    elements[i].~ElementType();
+    }
+
+    void rehash (int newCapacity)
+    {
+        jassert (getMaxItemsForCapacity (newCapacity) >= numItems);
+
+        FlatHashTable newTable (hashFunctionToUse);
+        newTable.allocate (newCapacity);
+
+        for (int i = 0; i < capacity; ++i)
+        {
+            if (isFull (control[i]))
+            {
+                auto hash = mixHash (hashFunctionToUse.generateHash (Traits::getKey (elements[i])));
+                auto index = newTable.findFirstNonFull (hash);
+
+                new (newTable.elements + index) ElementType (std::move (elements[i]));
+                elements[i].~ElementType();
+                control[i] = deletedByte;
+
+                newTable.setControlByte (index, getH2 (hash));
+                --newTable.growthLeft;
+                ++newTable.numItems;
+            }
+        }
+
+        numItems = 0;
+        swapWith (newTable);
+    }
+
+    //==============================================================================
+    HashFunctionType hashFunctionToUse;
+    HeapBlock<int8> control;
+    HeapBlock<char> elementStorage;
+    ElementType* elements = nullptr;
+    int capacity = 0, numItems = 0, growthLeft = 0;
+};
+
+} // namespace detail
+#endif
+
+//==============================================================================
+/**
+    A map of key/value pairs stored in a single flat, open-addressed hash table.
+
+    This offers much the same operations as HashMap, but rather than allocating an
+    entry for every item and chaining them together, all the items are kept in one
+    contiguous array which is searched using a group of control bytes at a time (with
+    SSE2 or NEON instructions where they're available). That means that adding an item
+    doesn't need an allocation unless the table needs to grow, and lookups generally
+    only touch one or two cache lines.
+
+    The trade-off is that items are moved around when the table grows, so unlike
+    HashMap, references and pointers to the values (and iterators) are invalidated by
+    any operation that adds an item. Use reserve() if you know in advance how many
+    items will be added, to avoid reallocating as the map grows.
+
+    If the keys are Strings or Identifiers, you can look items up using any type of
+    string (e.g. a StringRef or a string literal) without having to create a
+    temporary key object.
+
+    @code
+    FlatHashMap<String, int> map;
+    map.set ("one", 1);
+    map.set ("two", 2);
+
+    DBG (map["one"]); // prints "1"
+
+    if (auto* value = map.find (StringRef ("two")))
+        *value += 10;
+
+    for (auto item : map)
+        DBG (item.key << " -> " << item.value);
+    @endcode
+
+    The HashFunctionType class must provide a generateHash() method that takes a key
+    (and any other type that you want to use for lookups) and returns a uint64. It
+    doesn't need to reduce the value to a range, but for lookups with other types
+    to work, the hash of a lookup value must be the same as that of an equal key.
+
+    This class isn't thread-safe, so if multiple threads need to use it you'll have
+    to provide your own locking.
+
+    @see FlatHashSet, HashMap, DefaultFlatHashFunctions
+
+    @tags{Core}
+*/
+template <typename KeyType,
+          typename ValueType,
+          class HashFunctionType = DefaultFlatHashFunctions>
+class FlatHashMap
+{
+private:
+    using KeyTypeParameter   = typename TypeHelpers::ParameterType<KeyType>::type;
+    using ValueTypeParameter = typename TypeHelpers::ParameterType<ValueType>::type;
+
+    struct Entry
+    {
+        KeyType key;
+        ValueType value;
+    };
+
+    struct Traits
+    {
+        using Key = KeyType;
+        using Element = Entry;
+
+        static const KeyType& getKey (const Entry& e) noexcept  { return e.key; }
+    };
+
+    using Table = detail::FlatHashTable<Traits, HashFunctionType>;
+
+public:
+    //==============================================================================
+    /** Creates an empty map.
+
+        This doesn't allocate any storage until the first item is added, or until
+        reserve() is called.
+    */
+    explicit FlatHashMap (HashFunctionType hashFunction = HashFunctionType())
+        : table (hashFunction)
+    {}
+
+    /** Creates a map, with enough space allocated to hold the given number of items. */
+    explicit FlatHashMap (int numItemsToReserve, HashFunctionType hashFunction = HashFunctionType())
+        : table (hashFunction)
+    {
+        reserve (numItemsToReserve);
+    }
+
+    /** Creates a map from a list of key/value pairs. */
+    FlatHashMap (std::initializer_list<std::pair<KeyType, ValueType>> items)
+        : table (HashFunctionType())
+    {
+        reserve ((int) items.size());
+
+        for (auto& item : items)
+            set (item.first, item.second);
+    }
+
+    FlatHashMap (const FlatHashMap&) = default;
+    FlatHashMap (FlatHashMap&&) noexcept = default;
+    FlatHashMap& operator= (const FlatHashMap&) = default;
+    FlatHashMap& operator= (FlatHashMap&&) noexcept = default;
+
+    //==============================================================================
+    /** Removes all values from the map.
+        This keeps the storage that was allocated, so use shrinkToFit() afterwards if
+        you want to release it.
+    */
+    void clear() noexcept                               { table.clear(); }
+
+    /** Returns the current number of items in the map. */
+    int size() const noexcept                           { return table.size(); }
+
+    /** Returns true if the map is empty. */
+    bool isEmpty() const noexcept                       { return size() == 0; }
+
+    /** Returns the number of slots that the table currently has allocated.
+        The map can hold up to 7/8 of this number of items before it needs to grow.
+    */
+    int getCapacity() const noexcept                    { return table.getCapacity(); }
+
+    /** Makes sure that the map has enough space allocated to hold the given number
+        of items without needing to reallocate.
+    */
+    void reserve (int numItemsToAllocate)               { table.reserve (numItemsToAllocate); }
+
+    /** Reduces the amount of storage being used by the map to the minimum needed
+        for the items that it currently contains.
+    */
+    void shrinkToFit()                                  { table.shrinkToFit(); }
+
+    //==============================================================================
+    /** Returns a pointer to the value corresponding to a given key, or nullptr if the
+        map doesn't contain the key.
+
+        The key can be any type that the hash function accepts and that can be compared
+        with the KeyType, e.g. a StringRef for a map with String or Identifier keys.
+
+        The pointer will be invalidated if any items are added to the map.
+    */
+    template <typename LookupType>
+    ValueType* find (const LookupType& keyToLookFor) noexcept
+    {
+        auto index = table.findIndex (keyToLookFor);
+        return index >= 0 ? &table.getElement (index).value : nullptr;
+    }
+
+    /** Returns a pointer to the value corresponding to a given key, or nullptr if the
+        map doesn't contain the key.
+        @see find
+    */
+    template <typename LookupType>
+    const ValueType* find (const LookupType& keyToLookFor) const noexcept
+    {
+        auto index = table.findIndex (keyToLookFor);
+        return index >= 0 ? &table.getElement (index).value : nullptr;
+    }
+
+    /** Returns true if the map contains an item with the specified key. */
+    template <typename LookupType>
+    bool contains (const LookupType& keyToLookFor) const noexcept
+    {
+        return table.findIndex (keyToLookFor) >= 0;
+    }
+
+    /** Returns the value corresponding to a given key.
+        If the map doesn't contain the key, a default instance of the value type is returned.
+    */
+    template <typename LookupType>
+    ValueType operator[] (const LookupType& keyToLookFor) const
+    {
+        if (auto* value = find (keyToLookFor))
+            return *value;
+
+        return ValueType();
+    }
+
+    /** Returns a reference to the value corresponding to a given key.
+        If the map doesn't contain the key, a default instance of the value type is
+        added to the map and a reference to this is returned.
+
+        The reference will be invalidated if any more items are added to the map.
+    */
+    ValueType& getReference (KeyTypeParameter keyToLookFor)
+    {
+        return table.getElement (table.findOrInsert (keyToLookFor, [&] { return Entry { keyToLookFor, ValueType() }; }).first).value;
+    }
+
+    /** Adds or replaces an element in the map.
+        If there's already an item with the given key, this will replace its value.
+        Otherwise, a new item will be added to the map.
+    */
+    void set (KeyTypeParameter newKey, ValueTypeParameter newValue)
+    {
+        auto result = table.findOrInsert (newKey, [&] { return Entry { newKey, newValue }; });
+
+        if (! result.second)
+            table.getElement (result.first).value = newValue;
+    }
+
+    /** Adds an item to the map if there isn't already one with the given key.
+        @returns true if the item was added, or false if the key was already present,
+                 in which case the existing value is left unchanged.
+    */
+    bool add (KeyTypeParameter newKey, ValueTypeParameter newValue)
+    {
+        return table.findOrInsert (newKey, [&] { return Entry { newKey, newValue }; }).second;
+    }
+
+    /** Removes the item with the given key, if there is one.
+        @returns true if an item was removed
+    */
+    template <typename LookupType>
+    bool remove (const LookupType& keyToRemove)
+    {
+        auto index = table.findIndex (keyToRemove);
+
+        if (index < 0)
+            return false;
+
+        table.removeAt (index);
+        return true;
+    }
+
+    /** Removes all items with the given value.
+        @returns the number of items that were removed
+    */
+    int removeValue (ValueTypeParameter valueToRemove)
+    {
+        return table.removeIf ([&] (const Entry& e) { return e.value == valueToRemove; });
+    }
+
+    /** Returns true if the map contains at least one occurrence of the given value. */
+    bool containsValue (ValueTypeParameter valueToLookFor) const noexcept
+    {
+        for (auto item : *this)
+            if (item.value == valueToLookFor)
+                return true;
+
+        return false;
+    }
+
+    /** Efficiently swaps the contents of two maps. */
+    void swapWith (FlatHashMap& other) noexcept         { table.swapWith (other.table); }
+
+    //==============================================================================
+    /** The type that iterating a FlatHashMap produces, which refers to an item's key and value. */
+    template <typename Value>
+    struct ItemReference
+    {
+        const KeyType& key;
+        Value& value;
+    };
+
+    /** Iterates over the items in a FlatHashMap.
+
+        The order of the items is unspecified, and any iterators are invalidated when
+        items are added to the map.
+    */
+    template <bool isConst>
+    struct IteratorBase
+    {
+        using TableType = std::conditional_t<isConst, const Table, Table>;
+        using Value = std::conditional_t<isConst, const ValueType, ValueType>;
+
+        IteratorBase (TableType& t, int i) noexcept  : table (&t), index (i) {}
+
+        /** Returns the current item's key. */
+        const KeyType& getKey() const noexcept          { return table->getElement (index).key; }
+
+        /** Returns a reference to the current item's value. */
+        Value& getValue() const noexcept                { return table->getElement (index).value; }
+
+        ItemReference<Value> operator*() const noexcept { return { getKey(), getValue() }; }
+
+        IteratorBase& operator++() noexcept             { index = table->getNextOccupiedIndex (index); return *this; }
+
+        bool operator== (const IteratorBase& other) const noexcept  { return index == other.index && table == other.table; }
+        bool operator!= (const IteratorBase& other) const noexcept  { return ! operator== (other); }
+
+    private:
+        TableType* table;
+        int index;
+    };
+
+    using Iterator      = IteratorBase<false>;
+    using ConstIterator = IteratorBase<true>;
+
+    /** Returns an iterator to the first item in the map. */
+    Iterator begin() noexcept                           { return { table, table.getFirstOccupiedIndex() }; }
+    /** Returns an iterator to the end of the map. */
+    Iterator end() noexcept                             { return { table, table.getCapacity() }; }
+    /** Returns an iterator to the first item in the map. */
+    ConstIterator begin() const noexcept                { return { table, table.getFirstOccupiedIndex() }; }
+    /** Returns an iterator to the end of the map. */
+    ConstIterator end() const noexcept                  { return { table, table.getCapacity() }; }
+
+private:
+    //==============================================================================
+    Table table;
+
+    JUCE_LEAK_DETECTOR (FlatHashMap)
+};
+
+//==============================================================================
+/**
+    A set of unique keys stored in a single flat, open-addressed hash table.
+
+    This works in the same way as FlatHashMap (see its description for the details),
+    but only stores keys. As with FlatHashMap, sets of Strings or Identifiers can be
+    searched using a StringRef.
+
+    @code
+    FlatHashSet<Identifier> seen;
+
+    if (seen.add (tree.getType()))
+        DBG ("first time we've seen this type");
+
+    jassert (seen.contains (StringRef ("PARAM")) == tree.hasType ("PARAM"));
+    @endcode
+
+    @see FlatHashMap, SortedSet, DefaultFlatHashFunctions
+
+    @tags{Core}
+*/
+template <typename KeyType,
+          class HashFunctionType = DefaultFlatHashFunctions>
+class FlatHashSet
+{
+private:
+    using KeyTypeParameter = typename TypeHelpers::ParameterType<KeyType>::type;
+
+    struct Traits
+    {
+        using Key = KeyType;
+        using Element = KeyType;
+
+        static const KeyType& getKey (const KeyType& k) noexcept  { return k; }
+    };
+
+    using Table = detail::FlatHashTable<Traits, HashFunctionType>;
+
+public:
+    //==============================================================================
+    /** Creates an empty set.
+
+        This doesn't allocate any storage until the first item is added, or until
+        reserve() is called.
+    */
+    explicit FlatHashSet (HashFunctionType hashFunction = HashFunctionType())
+        : table (hashFunction)
+    {}
+
+    /** Creates a set, with enough space allocated to hold the given number of items. */
+    explicit FlatHashSet (int numItemsToReserve, HashFunctionType hashFunction = HashFunctionType())
+        : table (hashFunction)
+    {
+        reserve (numItemsToReserve);
+    }
+
+    /** Creates a set from a list of keys. */
+    FlatHashSet (std::initializer_list<KeyType> items)
+        : table (HashFunctionType())
+    {
+        reserve ((int) items.size());
+
+        for (auto& item : items)
+            add (item);
+    }
+
+    FlatHashSet (const FlatHashSet&) = default;
+    FlatHashSet (FlatHashSet&&) noexcept = default;
+    FlatHashSet& operator= (const FlatHashSet&) = default;
+    FlatHashSet& operator= (FlatHashSet&&) noexcept = default;
+
+    //==============================================================================
+    /** Removes all items from the set, keeping the storage that was allocated. */
+    void clear() noexcept                               { table.clear(); }
+
+    /** Returns the number of items in the set. */
+    int size() const noexcept                           { return table.size(); }
+
+    /** Returns true if the set is empty. */
+    bool isEmpty() const noexcept                       { return size() == 0; }
+
+    /** Returns the number of slots that the table currently has allocated. */
+    int getCapacity() const noexcept                    { return table.getCapacity(); }
+
+    /** Makes sure that the set has enough space allocated to hold the given number
+        of items without needing to reallocate.
+    */
+    void reserve (int numItemsToAllocate)               { table.reserve (numItemsToAllocate); }
+
+    /** Reduces the amount of storage being used to the minimum needed for the items
+        that the set currently contains.
+    */
+    void shrinkToFit()                                  { table.shrinkToFit(); }
+
+    //==============================================================================
+    /** Returns true if the set contains the given key.
+
+        The key can be any type that the hash function accepts and that can be compared
+        with the KeyType, e.g. a StringRef for a set of Strings or Identifiers.
+    */
+    template <typename LookupType>
+    bool contains (const LookupType& keyToLookFor) const noexcept
+    {
+        return table.findIndex (keyToLookFor) >= 0;
+    }
+
+    /** Adds a key to the set.
+        @returns true if the key was added, or false if it was already present
+    */
+    bool add (KeyTypeParameter newKey)
+    {
+        return table.findOrInsert (newKey, [&] { return KeyType (newKey); }).second;
+    }
+
+    /** Removes a key from the set.
+        @returns true if the key was present and has been removed
+    */
+    template <typename LookupType>
+    bool remove (const LookupType& keyToRemove)
+    {
+        auto index = table.findIndex (keyToRemove);
+
+        if (index < 0)
+            return false;
+
+        table.removeAt (index);
+        return true;
+    }
+
+    /** Efficiently swaps the contents of two sets. */
+    void swapWith (FlatHashSet& other) noexcept         { table.swapWith (other.table); }
+
+    //==============================================================================
+    /** Iterates over the keys in a FlatHashSet, in an unspecified order.
+        Iterators are invalidated when items are added to the set.
+    */
+    struct Iterator
+    {
+        Iterator (const Table& t, int i) noexcept  : table (&t), index (i) {}
+
+        const KeyType& operator*() const noexcept       { return table->getElement (index); }
+        const KeyType* operator->() const noexcept      { return &table->getElement (index); }
+
+        Iterator& operator++() noexcept                 { index = table->getNextOccupiedIndex (index); return *this; }
+
+        bool operator== (const Iterator& other) const noexcept  { return index == other.index && table == other.table; }
+        bool operator!= (const Iterator& other) const noexcept  { return ! operator== (other); }
+
+    private:
+        const Table* table;
+        int index;
+    };
+
+    /** Returns an iterator to the first key in the set. */
+    Iterator begin() const noexcept                     { return { table, table.getFirstOccupiedIndex() }; }
+    /** Returns an iterator to the end of the set. */
+    Iterator end() const noexcept                       { return { table, table.getCapacity() }; }
+
+private:
+    //==============================================================================
+    Table table;
+
+    JUCE_LEAK_DETECTOR (FlatHashSet)
+};
+
+} // namespace juce
@@ -0,0 +1,375 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class FlatHashMapTests final : public UnitTest
+{
+public:
+    FlatHashMapTests()
+        : UnitTest ("FlatHashMap", UnitTestCategories::containers)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Random operations match std::map");
+        {
+            checkAgainstStdMap<int>();
+            checkAgainstStdMap<void*>();
+            checkAgainstStdMap<String>();
+            checkAgainstStdMap<Identifier>();
+        }
+
+        beginTest ("Keys with colliding hashes");
+        {
+            struct CollidingHash
+            {
+                static uint64 generateHash (int key) noexcept   { return (uint64) (key & 3); }
+            };
+
+            FlatHashMap<int, String, CollidingHash> map;
+
+            for (int i = 0; i < 200; ++i)
+                map.set (i, String (i));
+
+            for (int i = 0; i < 200; i += 2)
+                map.remove (i);
+
+            auto allFound = true;
+
+            for (int i = 0; i < 200; ++i)
+                allFound = allFound && (map.contains (i) == ((i & 1) != 0))
+                                    && (map[i] == ((i & 1) != 0 ? String (i) : String()));
+
+            expect (allFound);
+            expectEquals (map.size(), 100);
+        }
+
+        beginTest ("Lookups using StringRef");
+        {
+            FlatHashMap<String, int> strings;
+            FlatHashMap<Identifier, int> identifiers;
+            FlatHashSet<String> stringSet;
+
+            const auto accented = "caf" + String::charToString ((juce_wchar) 0xe9);
+
+            for (auto* key : { "alpha", "beta", "gamma" })
+            {
+                strings.set (key, (int) strlen (key));
+                identifiers.set (Identifier (key), (int) strlen (key));
+                stringSet.add (key);
+            }
+
+            strings.set (accented, 4);
+            identifiers.set (Identifier (accented), 4);
+
+            expectEquals (strings[StringRef ("beta")], 4);
+            expectEquals (strings["gamma"], 5);
+            expectEquals (strings[StringRef (accented)], 4);
+            expectEquals (identifiers[StringRef ("alpha")], 5);
+            expectEquals (identifiers[accented.toRawUTF8()], 4);
+            expect (stringSet.contains (StringRef ("alpha")));
+            expect (! stringSet.contains (StringRef ("delta")));
+            expect (! strings.contains (StringRef ("alph")));
+            expect (identifiers.find (StringRef ("delta")) == nullptr);
+
+            *strings.find (StringRef ("alpha")) = 10;
+            expectEquals (strings["alpha"], 10);
+
+            expect (strings.remove (StringRef ("alpha")));
+            expect (! strings.contains ("alpha"));
+        }
+
+        beginTest ("Reserve");
+        {
+            FlatHashMap<int, int> map;
+            expectEquals (map.getCapacity(), 0);
+
+            map.reserve (1000);
+            const auto capacity = map.getCapacity();
+            expect (capacity >= 1000);
+
+            for (int i = 0; i < 1000; ++i)
+                map.set (i * 7, i);
+
+            expectEquals (map.getCapacity(), capacity);
+            expectEquals (map.size(), 1000);
+
+            map.clear();
+            expectEquals (map.getCapacity(), capacity);
+            map.shrinkToFit();
+            expectEquals (map.getCapacity(), 0);
+        }
+
+        beginTest ("Repeated adding and removing doesn't grow the table");
+        {
+            FlatHashMap<int, int> map;
+
+            for (int i = 0; i < 100; ++i)
+                map.set (i, i);
+
+            const auto capacity = map.getCapacity();
+
+            for (int i = 100; i < 100000; ++i)
+            {
+                map.remove (i - 100);
+                map.set (i, i);
+            }
+
+            expectEquals (map.size(), 100);
+            expectEquals (map.getCapacity(), capacity);
+            expectEquals (map[99999], 99999);
+            expect (! map.contains (99899));
+        }
+
+        beginTest ("Iteration, copying and moving");
+        {
+            FlatHashMap<String, String> map;
+
+            for (int i = 0; i < 100; ++i)
+                map.set (String (i), "value" + String (i));
+
+            for (auto item : map)
+                item.value += "!";
+
+            auto copy = map;
+            copy.set ("extra", "x");
+            expectEquals (map.size(), 100);
+            expectEquals (copy.size(), 101);
+
+            int numVisited = 0;
+            auto allMatch = true;
+
+            for (auto item : map)
+            {
+                allMatch = allMatch && item.value == "value" + item.key + "!" && copy[item.key] == item.value;
+                ++numVisited;
+            }
+
+            expect (allMatch);
+            expectEquals (numVisited, 100);
+
+            auto moved = std::move (copy);
+            expectEquals (moved.size(), 101);
+            expectEquals (moved["extra"], String ("x"));
+
+            expectEquals (map.removeValue ("value7!"), 1);
+            expect (! map.containsValue ("value7!"));
+            expect (map.containsValue ("value8!"));
+        }
+
+        beginTest ("FlatHashSet");
+        {
+            FlatHashSet<int> set { 1, 2, 3, 2 };
+
+            expectEquals (set.size(), 3);
+            expect (! set.add (3));
+            expect (set.add (4));
+            expect (set.remove (1));
+            expect (! set.remove (1));
+
+            int total = 0;
+
+            for (auto i : set)
+                total += i;
+
+            expectEquals (total, 9);
+        }
+    }
+
+private:
+    template <typename KeyType>
+    void checkAgainstStdMap()
+    {
+        Random r (getRandom().nextInt());
+        std::vector<KeyType> keys;
+
+        for (int i = 0; i < 500; ++i)
+            keys.push_back (createKey<KeyType> (r, i));
+
+        std::map<KeyType, int> groundTruth;
+        FlatHashMap<KeyType, int> map;
+        auto allMatch = true;
+
+        for (int i = 0; i < 20000; ++i)
+        {
+            const auto& key = keys[(size_t) r.nextInt ((int) keys.size())];
+            const auto value = r.nextInt();
+
+            switch (r.nextInt (4))
+            {
+                case 0:
+                    allMatch = allMatch && map.remove (key) == (groundTruth.erase (key) != 0);
+                    break;
+
+                case 1:
+                    map.getReference (key) += value;
+                    groundTruth[key] += value;
+                    break;
+
+                default:
+                    map.set (key, value);
+                    groundTruth[key] = value;
+                    break;
+            }
+
+            allMatch = allMatch && map.size() == (int) groundTruth.size();
+        }
+
+        for (auto& key : keys)
+        {
+            auto found = groundTruth.find (key);
+            auto* value = map.find (key);
+
+            allMatch = allMatch && (found == groundTruth.end() ? value == nullptr
+                                                               : (value != nullptr && *value == found->second));
+        }
+
+        int numVisited = 0;
+
+        for (auto item : map)
+        {
+            allMatch = allMatch && groundTruth[item.key] == item.value;
+            ++numVisited;
+        }
+
+        expect (allMatch);
+        expectEquals (numVisited, (int) groundTruth.size());
+    }
+
+    template <typename KeyType>
+    static KeyType createKey (Random& r, int index)
+    {
+        if constexpr (std::is_same_v<KeyType, int>)
+            return index * 37 + r.nextInt (37);
+        else if constexpr (std::is_same_v<KeyType, void*>)
+            return reinterpret_cast<void*> ((pointer_sized_uint) (index + 1) * 16);
+        else
+            return KeyType ("key" + String (index) + "_" + String (r.nextInt (100)));
+    }
+};
+
+static FlatHashMapTests flatHashMapTests;
+
+//==============================================================================
+class FlatHashMapBenchmarks final : public UnitTest
+{
+public:
+    FlatHashMapBenchmarks()
+        : UnitTest ("FlatHashMap benchmarks", UnitTestCategories::benchmarks)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("FlatHashMap vs HashMap");
+
+        constexpr int numKeys = 20000;
+
+        std::vector<int> ints;
+        std::vector<String> strings;
+        std::vector<Identifier> identifiers;
+
+        for (int i = 0; i < numKeys; ++i)
+        {
+            ints.push_back (i * 7919);
+            strings.push_back ("parameter_" + String (i));
+            identifiers.emplace_back (strings.back());
+        }
+
+        compare ("int", ints);
+        compare ("String", strings);
+        compare ("Identifier", identifiers);
+
+        FlatHashMap<String, int> flat;
+
+        for (int i = 0; i < numKeys; ++i)
+            flat.set (strings[(size_t) i], i);
+
+        int total = 0;
+        const auto refLookup = nanosecondsPerItem (numKeys, [&] (int i) { total += flat[StringRef (strings[(size_t) i])]; });
+        const auto charLookup = nanosecondsPerItem (numKeys, [&] (int i) { total += flat[strings[(size_t) i].toRawUTF8()]; });
+        ignoreUnused (total);
+
+        logMessage ("FlatHashMap<String> lookup with StringRef: " + String (refLookup, 1) + " ns, with const char*: " + String (charLookup, 1) + " ns");
+    }
+
+private:
+    template <typename Fn>
+    static double nanosecondsPerItem (int numItems, Fn&& fn)
+    {
+        auto start = Time::getHighResolutionTicks();
+
+        for (int i = 0; i < numItems; ++i)
+            fn (i);
+
+        return Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start) * 1.0e9 / numItems;
+    }
+
+    template <typename MapType, typename KeyType>
+    static std::array<double, 3> time (const std::vector<KeyType>& keys)
+    {
+        const auto numKeys = (int) keys.size();
+        const auto half = numKeys / 2;
+        int total = 0;
+        std::array<double, 3> result;
+
+        MapType map;
+        result[0] = nanosecondsPerItem (half, [&] (int i) { map.set (keys[(size_t) i], i); });
+        result[1] = nanosecondsPerItem (half, [&] (int i) { total += map[keys[(size_t) ((i * 7) % half)]]; });
+        result[2] = nanosecondsPerItem (half, [&] (int i) { total += map.contains (keys[(size_t) (half + i)]) ? 1 : 0; });
+
+        ignoreUnused (total);
+        return result;
+    }
+
+    template <typename KeyType>
+    void compare (const String& keyName, const std::vector<KeyType>& keys)
+    {
+        auto hashMap = time<HashMap<KeyType, int>> (keys);
+        auto flatMap = time<FlatHashMap<KeyType, int>> (keys);
+
+        auto describe = [] (const std::array<double, 3>& t)
+        {
+            return "insert " + String (t[0], 1) + " ns, hit " + String (t[1], 1) + " ns, miss " + String (t[2], 1) + " ns";
+        };
+
+        logMessage (keyName + " keys, HashMap:     " + describe (hashMap));
+        logMessage (keyName + " keys, FlatHashMap: " + describe (flatMap));
+    }
+};
+
+static FlatHashMapBenchmarks flatHashMapBenchmarks;
+
+} // namespace juce
@@ -47,14 +47,135 @@ bool NamedValue::operator!= (const NamedValue& other) const noexcept
 }
 
 //==============================================================================
+// Below this size, a linear scan comparing Identifier pointers beats hashing
+static constexpr int minNumValuesForHashIndex = 16;
+
 NamedValueSet::NamedValueSet (std::initializer_list<NamedValue> list)
    : values (std::move (list))
 {
+    updateHashIndex();
 }
 
 void NamedValueSet::clear()
 {
     values.clear();
+    hashIndex.clear();
+    hashIndexNeedsChecking = false;
+}
+
+int NamedValueSet::findIndex (const Identifier& name) const noexcept
+{
+    // Until checkHashIndex() has been called, the names may not match the index. That
+    // can only be called from a non-const method, so that const lookups never modify
+    // the set and can still be made from several threads at once.
+    if (hashIndex.isEmpty() || hashIndexNeedsChecking)
+    {
+        auto numValues = values.size();
+
+        for (int i = 0; i < numValues; ++i)
+            if (values.getReference (i).name == name)
+                return i;
+
+        return -1;
+    }
+
+    // The index holds (position + 1) of each value, with 0 marking an empty slot
+    const auto mask = (uint32) hashIndex.size() - 1;
+
+    for (auto slot = name.getHash() & mask;; slot = (slot + 1) & mask)
+    {
+        auto position = hashIndex.getUnchecked ((int) slot) - 1;
+
+        if (position < 0 || values.getReference (position).name == name)
+            return position;
+    }
+}
+
+void NamedValueSet::addToHashIndex (int index) noexcept
+{
+    const auto mask = (uint32) hashIndex.size() - 1;
+    auto& name = values.getReference (index).name;
+
+    for (auto slot = name.getHash() & mask;; slot = (slot + 1) & mask)
+    {
+        auto& entry = hashIndex.getReference ((int) slot);
+
+        if (entry == 0)
+        {
+            entry = index + 1;
+            return;
+        }
+
+        if (values.getReference (entry - 1).name == name)
+            return;
+    }
+}
+
+void NamedValueSet::removeFromHashIndex (int index) noexcept
+{
+    const auto mask = (uint32) hashIndex.size() - 1;
+    auto slot = values.getReference (index).name.getHash() & mask;
+
+    while (hashIndex.getUnchecked ((int) slot) != index + 1)
+        slot = (slot + 1) & mask;
+
+    // Move any later entries in the same run back into the gap, if that's no further
+    // from their natural slot, so that a search never reaches an empty slot too early
+    for (auto next = (slot + 1) & mask;; next = (next + 1) & mask)
+    {
+        const auto entry = hashIndex.getUnchecked ((int) next);
+
+        if (entry == 0)
+            break;
+
+        const auto natural = values.getReference (entry - 1).name.getHash() & mask;
+
+        if (((next - natural) & mask) >= ((next - slot) & mask))
+        {
+            hashIndex.set ((int) slot, entry);
+            slot = next;
+        }
+    }
+
+    hashIndex.set ((int) slot, 0);
+
+    // The values after the removed one are about to move down by one
+    for (auto& entry : hashIndex)
+        if (entry > index + 1)
+            --entry;
+}
+
+void NamedValueSet::checkHashIndex()
+{
+    if (! std::exchange (hashIndexNeedsChecking, false))
+        return;
+
+    for (int i = 0; i < values.size(); ++i)
+    {
+        if (findIndex (values.getReference (i).name) != i)
+        {
+            updateHashIndex();
+            return;
+        }
+    }
+}
+
+void NamedValueSet::updateHashIndex()
+{
+    hashIndexNeedsChecking = false;
+    auto numValues = values.size();
+
+    if (numValues < minNumValuesForHashIndex)
+    {
+        hashIndex.clear();
+        return;
+    }
+
+    hashIndex.clearQuick();
+    hashIndex.insertMultiple (0, 0, nextPowerOfTwo (numValues * 2));
+
+    for (int i = 0; i < numValues; ++i)
+        addToHashIndex (i);
 }
 
 bool NamedValueSet::operator== (const NamedValueSet& other) const noexcept
@@ -120,20 +241,13 @@ var NamedValueSet::getWithDefault (const Identifier& name, const var& defaultRet
 
 var* NamedValueSet::getVarPointer (const Identifier& name) noexcept
 {
-    for (auto& i : values)
-        if (i.name == name)
-            return &(i.value);
-
-    return {};
+    checkHashIndex();
+    return getVarPointerAt (findIndex (name));
 }
 
 const var* NamedValueSet::getVarPointer (const Identifier& name) const noexcept
 {
-    for (auto& i : values)
-        if (i.name == name)
-            return &(i.value);
-
-    return {};
+    return getVarPointerAt (findIndex (name));
 }
 
 bool NamedValueSet::set (const Identifier& name, var&& newValue)
@@ -148,6 +262,15 @@ bool NamedValueSet::set (const Identifier& name, var&& newValue)
     }
 
     values.add ({ name, std::move (newValue) });
+
+    if (values.size() >= minNumValuesForHashIndex)
+    {
+        if (values.size() * 2 >= hashIndex.size())
+            updateHashIndex();
+        else
+            addToHashIndex (values.size() - 1);
+    }
+
     return true;
 }
 
@@ -163,6 +286,15 @@ bool NamedValueSet::set (const Identifier& name, const var& newValue)
     }
 
     values.add ({ name, newValue });
+
+    if (values.size() >= minNumValuesForHashIndex)
+    {
+        if (values.size() * 2 >= hashIndex.size())
+            updateHashIndex();
+        else
+            addToHashIndex (values.size() - 1);
+    }
+
     return true;
 }
 
@@ -173,29 +305,24 @@ bool NamedValueSet::contains (const Identifier& name) const noexcept
 
 int NamedValueSet::indexOf (const Identifier& name) const noexcept
 {
-    auto numValues = values.size();
-
-    for (int i = 0; i < numValues; ++i)
-        if (values.getReference (i).name == name)
-            return i;
-
-    return -1;
+    return findIndex (name);
 }
 
 bool NamedValueSet::remove (const Identifier& name)
 {
-    auto numValues = values.size();
+    checkHashIndex();
+    auto index = findIndex (name);
 
-    for (int i = 0; i < numValues; ++i)
-    {
-        if (values.getReference (i).name == name)
-        {
-            values.remove (i);
-            return true;
-        }
-    }
+    if (index < 0)
+        return false;
+
+    if (values.size() <= minNumValuesForHashIndex)
+        hashIndex.clear();
+    else if (! hashIndex.isEmpty())
+        removeFromHashIndex (index);
 
-    return false;
+    values.remove (index);
+    return true;
 }
 
 Identifier NamedValueSet::getName (const int index) const noexcept
@@ -251,6 +378,8 @@ void NamedValueSet::setFromXmlAttributes (const XmlElement& xml)
 
         values.add ({ name, var (value) });
     }
+
+    updateHashIndex();
 }
 
 void NamedValueSet::copyToXmlAttributes (XmlElement& xml) const
@@ -52,6 +52,11 @@ public:
     This can be used as a basic structure to hold a set of var object, which can
     be retrieved by using their identifier.
 
+    Small sets are searched linearly, which is the quickest approach when there are
+    only a few items. Once a set grows beyond a handful of items, it also maintains a
+    hash index using the hash stored in each Identifier, so that lookups by name
+    don't have to scan all the values.
+
     @tags{Core}
 */
 class JUCE_API  NamedValueSet
@@ -75,7 +80,7 @@ public:
     const NamedValue* begin() const noexcept     { return values.begin(); }
     const NamedValue* end() const noexcept       { return values.end();   }
 
-    Span<NamedValue> asSpan() & { return { values.data(), (size_t) values.size() }; }
+    Span<NamedValue> asSpan() & { hashIndexNeedsChecking = ! hashIndex.isEmpty(); return { values.data(), (size_t) values.size() }; }
     Span<const NamedValue> asSpan() const& { return { values.data(), (size_t) values.size() }; }
 
     /*  These functions are deleted to help avoid accidentally forming a span over a temporary. */
@@ -182,6 +187,14 @@ public:
 private:
     //==============================================================================
     Array<NamedValue> values;
+    Array<int> hashIndex;
+    bool hashIndexNeedsChecking = false;
+
+    int findIndex (const Identifier&) const noexcept;
+    void addToHashIndex (int index) noexcept;
+    void removeFromHashIndex (int index) noexcept;
+    void updateHashIndex();
+    void checkHashIndex();
 };
 
 } // namespace juce
@@ -0,0 +1,175 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+class NamedValueSetTests final : public UnitTest
+{
+public:
+    NamedValueSetTests()
+        : UnitTest ("NamedValueSet", UnitTestCategories::containers)
+    {}
+
+    static Identifier getName (int i)    { return "name" + String (i); }
+
+    void runTest() override
+    {
+        auto r = getRandom();
+
+        beginTest ("Lookups match a reference map as the set grows and shrinks");
+        {
+            NamedValueSet set;
+            std::map<int, int> expected;
+            auto allMatch = true;
+
+            for (int i = 0; i < 5000; ++i)
+            {
+                auto key = r.nextInt (100);
+
+                if (r.nextInt (3) == 0)
+                {
+                    expect (set.remove (getName (key)) == (expected.erase (key) != 0));
+                }
+                else
+                {
+                    set.set (getName (key), i);
+                    expected[key] = i;
+                }
+
+                expectEquals (set.size(), (int) expected.size());
+
+                for (int k = 0; k < 100; ++k)
+                {
+                    auto found = expected.find (k);
+                    auto* v = set.getVarPointer (getName (k));
+
+                    allMatch = allMatch && (found == expected.end() ? v == nullptr
+                                                                    : (v != nullptr && (int) *v == found->second
+                                                                        && set.getName (set.indexOf (getName (k))) == getName (k)));
+                }
+            }
+
+            expect (allMatch);
+        }
+
+        beginTest ("Copies, XML and spans keep lookups consistent");
+        {
+            NamedValueSet set;
+
+            for (int i = 0; i < 40; ++i)
+                set.set (getName (i), i);
+
+            auto copy = set;
+            expect (copy == set);
+            expectEquals ((int) copy[getName (39)], 39);
+
+            XmlElement xml ("test");
+            set.copyToXmlAttributes (xml);
+
+            NamedValueSet fromXml;
+            fromXml.setFromXmlAttributes (xml);
+            expectEquals (fromXml[getName (25)].toString(), String (25));
+
+            for (auto& nv : set.asSpan())
+                if (nv.name == getName (10))
+                    nv.name = "renamed";
+
+            expect (set.contains ("renamed"));
+            expect (! set.contains (getName (10)));
+
+            set.set ("another", 1);
+            expect (set.contains ("renamed"));
+            expectEquals ((int) set["renamed"], 10);
+
+            for (auto& nv : set.asSpan())
+                nv.value = (int) nv.value + 1;
+
+            expect (set.remove ("renamed"));
+            expect (! set.contains ("renamed"));
+
+            auto allFound = true;
+
+            for (int i = 0; i < 40; ++i)
+                if (i != 10)
+                    allFound = allFound && (int) set[getName (i)] == i + 1 && set.getName (set.indexOf (getName (i))) == getName (i);
+
+            expect (allFound);
+        }
+    }
+};
+
+static NamedValueSetTests namedValueSetTests;
+
+//==============================================================================
+class NamedValueSetBenchmarks final : public UnitTest
+{
+public:
+    NamedValueSetBenchmarks()
+        : UnitTest ("NamedValueSet benchmarks", UnitTestCategories::benchmarks)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("getVarPointer");
+
+        for (auto numValues : { 4, 16, 64, 256, 1024 })
+        {
+            NamedValueSet set;
+            std::vector<Identifier> names;
+
+            for (int i = 0; i < numValues; ++i)
+            {
+                names.push_back ("property_" + String (i));
+                set.set (names.back(), i);
+            }
+
+            constexpr int numLookups = 1000000;
+            int64 total = 0;
+            auto start = Time::getHighResolutionTicks();
+
+            for (int i = 0; i < numLookups; ++i)
+                total += (int) *set.getVarPointer (names[(size_t) (i % numValues)]);
+
+            auto ns = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start) * 1.0e9 / numLookups;
+            logMessage (String (numValues) + " values: " + String (ns, 2) + " ns per lookup");
+            expect (total > 0);
+        }
+    }
+};
+
+static NamedValueSetBenchmarks namedValueSetBenchmarks;
+
+} // namespace juce
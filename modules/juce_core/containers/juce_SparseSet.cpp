@@ -208,6 +208,44 @@ public:
             expect (! set.overlapsRange (Range<int> (10, 12)));
             expect (  set.overlapsRange (Range<int> (0, 12)));
         }
+
+        beginTest ("lookups in a set with many ranges");
+        {
+            auto random = getRandom();
+            SparseSet<int> set;
+            std::vector<bool> values (1000);
+
+            for (int i = 0; i < 200; ++i)
+            {
+                const auto start = random.nextInt (990);
+                const Range<int> range (start, start + 1 + random.nextInt (10));
+                const auto add = random.nextBool();
+
+                if (add)
+                    set.addRange (range);
+                else
+                    set.removeRange (range);
+
+                for (auto v = range.getStart(); v < range.getEnd(); ++v)
+                    values[(size_t) v] = add;
+            }
+
+            for (int i = 1; i < set.getNumRanges(); ++i)
+                expect (set.getRange (i - 1).getEnd() < set.getRange (i).getStart());
+
+            for (int v = 0; v < (int) values.size(); ++v)
+                expect (set.contains (v) == values[(size_t) v]);
+
+            for (int i = 0; i < 500; ++i)
+            {
+                const auto start = random.nextInt (990);
+                const Range<int> range (start, start + 1 + random.nextInt (10));
+                const auto begin = values.begin() + range.getStart(), end = values.begin() + range.getEnd();
+
+                expect (set.containsRange (range) == std::all_of (begin, end, [] (bool b) { return b; }));
+                expect (set.overlapsRange (range) == std::any_of (begin, end, [] (bool b) { return b; }));
+            }
+        }
     }
 };
 
@@ -108,19 +108,13 @@ public:
         return {};
     }
 
-    /** Checks whether a particular value is in the set. */
+    /** Checks whether a particular value is in the set.
+        The ranges are kept sorted, so this takes O(log n) time in the number of ranges.
+    */
     bool contains (Type valueToLookFor) const noexcept
     {
-        for (auto& r : ranges)
-        {
-            if (r.getStart() > valueToLookFor)
-                break;
-
-            if (r.getEnd() > valueToLookFor)
-                return true;
-        }
-
-        return false;
+        const auto* r = findLastRangeStartingAtOrBefore (valueToLookFor);
+        return r != nullptr && r->getEnd() > valueToLookFor;
     }
 
     //==============================================================================
@@ -157,9 +151,11 @@ public:
         if (! range.isEmpty())
         {
             removeRange (range);
-            ranges.add (range);
-            std::sort (ranges.begin(), ranges.end(),
-                       [] (Range<Type> a, Range<Type> b) { return a.getStart() < b.getStart(); });
+
+            const auto insertPos = std::upper_bound (ranges.begin(), ranges.end(), range.getStart(),
+                                                     [] (Type value, Range<Type> r) { return value < r.getStart(); });
+
+            ranges.insert ((int) std::distance (ranges.begin(), insertPos), range);
             simplify();
         }
     }
@@ -231,23 +227,26 @@ public:
     /** Checks whether any part of a given range overlaps any part of this set. */
     bool overlapsRange (Range<Type> range) const noexcept
     {
-        if (! range.isEmpty())
-            for (auto& r : ranges)
-                if (r.intersects (range))
-                    return true;
+        if (range.isEmpty())
+            return false;
+
+        const auto firstAfter = std::upper_bound (ranges.begin(), ranges.end(), range.getStart(),
+                                                  [] (Type value, Range<Type> r) { return value < r.getStart(); });
 
-        return false;
+        if (firstAfter != ranges.begin() && std::prev (firstAfter)->intersects (range))
+            return true;
+
+        return firstAfter != ranges.end() && firstAfter->intersects (range);
     }
 
     /** Checks whether the whole of a given range is contained within this one. */
     bool containsRange (Range<Type> range) const noexcept
     {
-        if (! range.isEmpty())
-            for (auto& r : ranges)
-                if (r.contains (range))
-                    return true;
+        if (range.isEmpty())
+            return false;
 
-        return false;
+        const auto* r = findLastRangeStartingAtOrBefore (range.getStart());
+        return r != nullptr && r->contains (range);
     }
 
     /** Returns the set as a list of ranges, which you may want to iterate over. */
@@ -261,6 +260,14 @@ private:
     //==============================================================================
     Array<Range<Type>> ranges;
 
+    const Range<Type>* findLastRangeStartingAtOrBefore (Type value) const noexcept
+    {
+        const auto firstAfter = std::upper_bound (ranges.begin(), ranges.end(), value,
+                                                  [] (Type v, Range<Type> r) { return v < r.getStart(); });
+
+        return firstAfter != ranges.begin() ? std::prev (firstAfter) : nullptr;
+    }
+
     void simplify()
     {
         for (int i = ranges.size(); --i > 0;)
@@ -663,7 +663,7 @@ Span<NamedValue> var::getObjectElements() &
 Span<const NamedValue> var::getObjectElements() const&
 {
     if (auto* obj = getDynamicObject())
-        return obj->getProperties().asSpan();
+        return std::as_const (obj->getProperties()).asSpan();
 
     return {};
 }
@@ -0,0 +1,224 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+AsyncFileReader::FileHandle::FileHandle (const File& f)
+    : file (f), size (f.getSize())
+{
+   #if JUCE_WINDOWS
+    stream = std::make_unique<FileInputStream> (file);
+   #else
+    const auto fd = open (file.getFullPathName().toUTF8(), O_RDONLY);
+
+    if (fd != -1)
+        handle.set (fd);
+   #endif
+}
+
+AsyncFileReader::FileHandle::~FileHandle()
+{
+   #if ! JUCE_WINDOWS
+    if (handle.isValid())
+        close (handle.get());
+   #endif
+}
+
+bool AsyncFileReader::FileHandle::openedOk() const noexcept
+{
+   #if JUCE_WINDOWS
+    return stream->openedOk();
+   #else
+    return handle.isValid();
+   #endif
+}
+
+int AsyncFileReader::FileHandle::readAt (int64 position, void* destination, int numBytes)
+{
+   #if JUCE_WINDOWS
+    const ScopedLock sl (streamLock);
+
+    if (! stream->setPosition (position))
+        return -1;
+
+    return stream->read (destination, numBytes);
+   #else
+    int total = 0;
+
+    while (total < numBytes)
+    {
+        const auto result = pread (handle.get(), static_cast<char*> (destination) + total,
+                                   (size_t) (numBytes - total), (off_t) (position + total));
+
+        if (result < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            return -1;
+        }
+
+        if (result == 0)
+            break;
+
+        total += (int) result;
+    }
+
+    return total;
+   #endif
+}
+
+//==============================================================================
+class ThreadPoolReadBackend final : public AsyncFileReader::Backend
+{
+public:
+    explicit ThreadPoolReadBackend (int numThreads)
+        : pool (ThreadPoolOptions{}.withThreadName ("Async file reader")
+                                   .withNumberOfThreads (numThreads)
+                                   .withDesiredThreadPriority (Thread::Priority::high))
+    {
+    }
+
+    void submit (Span<AsyncFileReader::Request> requests) override
+    {
+        for (auto& r : requests)
+        {
+            pool.addJob ([request = std::move (r)]
+            {
+                request.onComplete (request.file->readAt (request.position, request.destination, request.numBytes));
+            });
+        }
+    }
+
+    bool isKernelAsyncIO() const noexcept override   { return false; }
+
+private:
+    ThreadPool pool;
+
+    JUCE_DECLARE_NON_COPYABLE (ThreadPoolReadBackend)
+};
+
+//==============================================================================
+AsyncFileReader::AsyncFileReader (int maxRequestsInFlight, bool allowKernelAsyncIO)
+{
+    maxRequestsInFlight = jmax (1, maxRequestsInFlight);
+
+   #if JUCE_LINUX
+    if (allowKernelAsyncIO)
+        backend = createNativeAsyncFileReaderBackend (maxRequestsInFlight);
+   #else
+    ignoreUnused (allowKernelAsyncIO);
+   #endif
+
+    if (backend == nullptr)
+        backend = std::make_unique<ThreadPoolReadBackend> (jmin (maxRequestsInFlight, 4));
+}
+
+AsyncFileReader::~AsyncFileReader()
+{
+    waitUntilIdle();
+}
+
+std::shared_ptr<AsyncFileReader::FileHandle> AsyncFileReader::openFile (const File& fileToOpen)
+{
+    std::shared_ptr<FileHandle> handle (new FileHandle (fileToOpen));
+
+    if (handle->openedOk())
+        return handle;
+
+    return {};
+}
+
+void AsyncFileReader::submit (Span<Request> requests)
+{
+    for (auto& r : requests)
+    {
+        // Every request needs a file that was opened by this class!
+        jassert (r.file != nullptr && r.numBytes >= 0);
+
+        r.onComplete = [this, callback = std::move (r.onComplete)] (int numBytesRead)
+        {
+            if (callback != nullptr)
+                callback (numBytesRead);
+
+            requestFinished();
+        };
+    }
+
+    numOutstanding += (int) requests.size();
+    backend->submit (requests);
+}
+
+void AsyncFileReader::submit (Request request)
+{
+    submit (Span<Request> (&request, 1));
+}
+
+void AsyncFileReader::requestFinished()
+{
+    if (--numOutstanding == 0)
+        requestsFinished.signal();
+}
+
+bool AsyncFileReader::waitUntilIdle (int timeoutMilliseconds)
+{
+    const auto start = Time::getMillisecondCounter();
+
+    while (numOutstanding.load() > 0)
+    {
+        auto timeToWait = 10;
+
+        if (timeoutMilliseconds >= 0)
+        {
+            const auto remaining = timeoutMilliseconds - (int) (Time::getMillisecondCounter() - start);
+
+            if (remaining <= 0)
+                return false;
+
+            timeToWait = jmin (timeToWait, remaining);
+        }
+
+        requestsFinished.wait (timeToWait);
+    }
+
+    return true;
+}
+
+bool AsyncFileReader::isUsingKernelAsyncIO() const noexcept
+{
+    return backend->isKernelAsyncIO();
+}
+
+} // namespace juce
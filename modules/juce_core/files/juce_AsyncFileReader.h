@@ -0,0 +1,197 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Reads from files in the background, delivering the results to callbacks.
+
+    Reads are submitted in batches, and each one calls its completion callback
+    when its data has arrived. On Linux, this uses the kernel's io_uring
+    interface when it's available, so that a whole batch of reads costs a single
+    system call and no threads are blocked waiting for the disk. Everywhere
+    else, or if io_uring has been disabled or blocked, the reads are carried out
+    by a small pool of threads instead.
+
+    @code
+    AsyncFileReader reader;
+
+    if (auto file = reader.openFile (myFile))
+    {
+        HeapBlock<char> data (1024);
+        WaitableEvent done;
+
+        reader.submit (AsyncFileReader::Request { file, 4096, data, 1024, [&] (int) { done.signal(); } });
+        done.wait();
+    }
+    @endcode
+
+    @see ReadAheadFileInputStream
+
+    @tags{Core}
+*/
+class JUCE_API  AsyncFileReader
+{
+public:
+    //==============================================================================
+    /** A file that has been opened for reading by an AsyncFileReader.
+
+        Requests hold a shared pointer to the file, so it stays open until all the
+        reads that use it have finished.
+    */
+    class JUCE_API  FileHandle
+    {
+    public:
+        /** Destructor. */
+        ~FileHandle();
+
+        /** Returns the file that this handle reads from. */
+        const File& getFile() const noexcept            { return file; }
+
+        /** Returns the size of the file, in bytes, when it was opened. */
+        int64 getSize() const noexcept                  { return size; }
+
+    private:
+        friend class AsyncFileReader;
+        friend class IoUringReadBackend;
+        friend class ThreadPoolReadBackend;
+        explicit FileHandle (const File&);
+
+        bool openedOk() const noexcept;
+        int readAt (int64 position, void* destination, int numBytes);
+
+        const File file;
+        int64 size = 0;
+
+       #if JUCE_WINDOWS
+        std::unique_ptr<FileInputStream> stream;
+        CriticalSection streamLock;
+       #else
+        detail::NativeFileHandle handle{};
+       #endif
+
+        JUCE_DECLARE_NON_COPYABLE (FileHandle)
+    };
+
+    //==============================================================================
+    /** Describes a single read. */
+    struct Request
+    {
+        /** The file to read from. */
+        std::shared_ptr<FileHandle> file;
+
+        /** The position in the file to start reading from. */
+        int64 position = 0;
+
+        /** The memory that the data will be written to. This must stay valid until
+            the completion callback has been called.
+        */
+        void* destination = nullptr;
+
+        /** The number of bytes to read. */
+        int numBytes = 0;
+
+        /** Called when the read has finished, with the number of bytes that were read.
+            This will be less than the number requested if the end of the file was
+            reached, and negative if there was an error.
+
+            The callback is made on a background thread, and should return quickly,
+            because other completions will be waiting behind it.
+        */
+        std::function<void (int numBytesRead)> onComplete;
+    };
+
+    //==============================================================================
+    /** Creates a reader.
+
+        @param maxRequestsInFlight  the most reads that will be handed to the operating
+                                    system at once. Any others that are submitted are
+                                    queued until earlier ones finish
+        @param allowKernelAsyncIO   if false, a thread pool is always used, even where
+                                    io_uring is available
+    */
+    explicit AsyncFileReader (int maxRequestsInFlight = 64, bool allowKernelAsyncIO = true);
+
+    /** Destructor. This waits for all the outstanding requests to finish. */
+    ~AsyncFileReader();
+
+    //==============================================================================
+    /** Opens a file for reading, returning nullptr if it can't be opened. */
+    std::shared_ptr<FileHandle> openFile (const File& fileToOpen);
+
+    /** Submits a batch of reads. The requests' callbacks may be called before this
+        method returns, and the contents of the requests are moved from.
+    */
+    void submit (Span<Request> requests);
+
+    /** Submits a single read. */
+    void submit (Request request);
+
+    /** Waits until there are no reads in progress or queued.
+
+        @returns true if all the reads finished, or false if the timeout expired first
+    */
+    bool waitUntilIdle (int timeoutMilliseconds = -1);
+
+    /** Returns the number of reads that have been submitted but haven't finished yet. */
+    int getNumOutstandingRequests() const noexcept      { return numOutstanding.load(); }
+
+    /** Returns true if the reads are being handled by io_uring, or false if they're
+        being carried out by a thread pool.
+    */
+    bool isUsingKernelAsyncIO() const noexcept;
+
+    //==============================================================================
+    /** @internal */
+    struct Backend
+    {
+        virtual ~Backend() = default;
+        virtual void submit (Span<Request>) = 0;
+        virtual bool isKernelAsyncIO() const noexcept = 0;
+    };
+
+private:
+    //==============================================================================
+    void requestFinished();
+
+    std::atomic<int> numOutstanding { 0 };
+    WaitableEvent requestsFinished;
+    std::unique_ptr<Backend> backend;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AsyncFileReader)
+};
+
+} // namespace juce
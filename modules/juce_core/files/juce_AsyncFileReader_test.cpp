@@ -0,0 +1,258 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class AsyncFileReaderTests final : public UnitTest
+{
+public:
+    AsyncFileReaderTests()
+        : UnitTest ("AsyncFileReader", UnitTestCategories::files)
+    {}
+
+    void runTest() override
+    {
+        const TemporaryFile temp;
+        const auto data = createTestData (getRandom(), 1000003);
+        temp.getFile().replaceWithData (data.getData(), data.getSize());
+
+        for (const auto allowKernelAsyncIO : { true, false })
+        {
+            AsyncFileReader reader (16, allowKernelAsyncIO);
+            const String suffix (reader.isUsingKernelAsyncIO() ? " (io_uring)" : " (thread pool)");
+
+           #if ! JUCE_LINUX
+            expect (! reader.isUsingKernelAsyncIO());
+           #endif
+
+            if (! allowKernelAsyncIO)
+                expect (! reader.isUsingKernelAsyncIO());
+
+            beginTest ("Opening files" + suffix);
+            {
+                expect (reader.openFile (temp.getFile().getNonexistentSibling()) == nullptr);
+
+                const auto file = reader.openFile (temp.getFile());
+                expect (file != nullptr);
+                expectEquals (file->getSize(), (int64) data.getSize());
+            }
+
+            beginTest ("A batch of reads delivers the right data" + suffix);
+            {
+                auto file = reader.openFile (temp.getFile());
+
+                // More requests than can be in flight at once, so some are queued
+                constexpr int numRequests = 100;
+                std::vector<MemoryBlock> buffers;
+                std::vector<AsyncFileReader::Request> requests;
+                std::vector<int64> positions;
+                std::vector<int> results ((size_t) numRequests, -2);
+                std::atomic<int> numCompleted { 0 };
+
+                for (int i = 0; i < numRequests; ++i)
+                {
+                    const auto numBytes = 1 + getRandom().nextInt (20000);
+                    positions.push_back (getRandom().nextInt ((int) data.getSize() - numBytes));
+                    buffers.emplace_back ((size_t) numBytes);
+                }
+
+                for (int i = 0; i < numRequests; ++i)
+                {
+                    requests.push_back ({ file, positions[(size_t) i], buffers[(size_t) i].getData(), (int) buffers[(size_t) i].getSize(),
+                                          [&, i] (int numRead)
+                                          {
+                                              results[(size_t) i] = numRead;
+                                              ++numCompleted;
+                                          } });
+                }
+
+                reader.submit (requests);
+                expect (reader.waitUntilIdle (10000));
+                expectEquals (numCompleted.load(), numRequests);
+                expectEquals (reader.getNumOutstandingRequests(), 0);
+
+                auto allCorrect = true;
+
+                for (int i = 0; i < numRequests; ++i)
+                {
+                    const auto& buffer = buffers[(size_t) i];
+                    allCorrect = allCorrect && results[(size_t) i] == (int) buffer.getSize()
+                                   && memcmp (buffer.getData(), addBytesToPointer (data.getData(), positions[(size_t) i]), buffer.getSize()) == 0;
+                }
+
+                expect (allCorrect);
+            }
+
+            beginTest ("Reads past the end of the file are truncated" + suffix);
+            {
+                HeapBlock<char> buffer (1000);
+                int result = -2;
+
+                reader.submit (AsyncFileReader::Request { reader.openFile (temp.getFile()), (int64) data.getSize() - 10, buffer, 1000,
+                                                          [&] (int numRead) { result = numRead; } });
+
+                expect (reader.waitUntilIdle (10000));
+                expectEquals (result, 10);
+                expect (memcmp (buffer, addBytesToPointer (data.getData(), data.getSize() - 10), 10) == 0);
+
+                reader.submit (AsyncFileReader::Request { reader.openFile (temp.getFile()), (int64) data.getSize() + 10, buffer, 1000,
+                                                          [&] (int numRead) { result = numRead; } });
+
+                expect (reader.waitUntilIdle (10000));
+                expectEquals (result, 0);
+            }
+
+            beginTest ("ReadAheadFileInputStream" + suffix);
+            {
+                ReadAheadFileInputStream stream (reader, temp.getFile(), 4096, 3);
+                expect (stream.openedOk());
+                expectEquals (stream.getTotalLength(), (int64) data.getSize());
+
+                MemoryBlock result;
+                HeapBlock<char> buffer (10000);
+
+                while (! stream.isExhausted())
+                {
+                    const auto numRead = stream.read (buffer, 1 + getRandom().nextInt (10000));
+
+                    if (numRead <= 0)
+                        break;
+
+                    result.append (buffer, (size_t) numRead);
+                }
+
+                expect (result == data);
+                expectEquals (stream.read (buffer, 100), 0);
+
+                auto allCorrect = true;
+
+                for (int i = 0; i < 200; ++i)
+                {
+                    const auto pos = getRandom().nextInt ((int) data.getSize());
+                    const auto num = getRandom().nextInt (10000);
+                    stream.setPosition (pos);
+
+                    const auto numRead = stream.read (buffer, num);
+                    allCorrect = allCorrect && numRead == jmin (num, (int) data.getSize() - pos)
+                                   && memcmp (buffer, addBytesToPointer (data.getData(), pos), (size_t) numRead) == 0
+                                   && stream.getPosition() == pos + numRead;
+                }
+
+                expect (allCorrect);
+
+                expect (ReadAheadFileInputStream (reader, temp.getFile().getNonexistentSibling()).failedToOpen());
+            }
+        }
+    }
+
+    static MemoryBlock createTestData (Random r, size_t size)
+    {
+        MemoryBlock block (size);
+
+        for (size_t i = 0; i < size; ++i)
+            static_cast<uint8*> (block.getData())[i] = (uint8) r.nextInt (256);
+
+        return block;
+    }
+};
+
+static AsyncFileReaderTests asyncFileReaderTests;
+
+//==============================================================================
+class AsyncFileReaderBenchmarks final : public UnitTest
+{
+public:
+    AsyncFileReaderBenchmarks()
+        : UnitTest ("AsyncFileReader benchmarks", UnitTestCategories::benchmarks)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Scattered reads");
+
+        const TemporaryFile temp;
+        const auto data = AsyncFileReaderTests::createTestData (getRandom(), 64 * 1024 * 1024);
+        temp.getFile().replaceWithData (data.getData(), data.getSize());
+
+        constexpr int numReads = 20000, readSize = 4096;
+        HeapBlock<char> buffer ((size_t) numReads * readSize);
+        std::vector<int64> positions;
+
+        for (int i = 0; i < numReads; ++i)
+            positions.push_back ((int64) getRandom().nextInt ((int) data.getSize() / readSize) * readSize);
+
+        {
+            FileInputStream in (temp.getFile());
+            const auto start = Time::getHighResolutionTicks();
+
+            for (int i = 0; i < numReads; ++i)
+            {
+                in.setPosition (positions[(size_t) i]);
+                in.read (buffer + (size_t) i * readSize, readSize);
+            }
+
+            logMessage ("FileInputStream: " + describe (start, numReads));
+        }
+
+        for (const auto allowKernelAsyncIO : { false, true })
+        {
+            AsyncFileReader reader (64, allowKernelAsyncIO);
+            auto file = reader.openFile (temp.getFile());
+            std::vector<AsyncFileReader::Request> requests;
+
+            const auto start = Time::getHighResolutionTicks();
+
+            for (int i = 0; i < numReads; ++i)
+                requests.push_back ({ file, positions[(size_t) i], buffer + (size_t) i * readSize, readSize, nullptr });
+
+            reader.submit (requests);
+            reader.waitUntilIdle();
+
+            logMessage (String (reader.isUsingKernelAsyncIO() ? "AsyncFileReader (io_uring): " : "AsyncFileReader (thread pool): ")
+                          + describe (start, numReads));
+        }
+    }
+
+private:
+    static String describe (int64 startTicks, int numReads)
+    {
+        const auto seconds = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - startTicks);
+        return String (seconds * 1.0e6 / numReads, 2) + " us per read";
+    }
+};
+
+static AsyncFileReaderBenchmarks asyncFileReaderBenchmarks;
+
+} // namespace juce
@@ -1222,6 +1222,15 @@ public:
             expect (tempFile.getSize() == 10);
         }
 
+        {
+            FileOutputStream fo (tempFile);
+            expect (fo.openedOk());
+
+            // Preallocating isn't supported everywhere, but it must never change the file's length
+            fo.preallocate (1024 * 1024);
+            expect (tempFile.getSize() == 10);
+        }
+
         beginTest ("Memory-mapped files");
 
         {
@@ -108,6 +108,16 @@ public:
     */
     Result truncate();
 
+    /** Asks the file system to reserve enough space for the file to grow to the given
+        size, without changing the file's length.
+
+        Doing this before writing a long recording helps to keep the file in one piece
+        on disk, and means that a lack of space is reported straight away rather than
+        part of the way through. It isn't supported on all platforms and file systems,
+        so a failure here doesn't mean that writing to the file will fail.
+    */
+    Result preallocate (int64 totalNumBytes);
+
     //==============================================================================
     void flush() override;
     int64 getPosition() override;
@@ -0,0 +1,178 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct ReadAheadFileInputStream::Block
+{
+    explicit Block (int size) : data ((size_t) size) {}
+
+    HeapBlock<char> data;
+    int64 index = -1;
+    std::atomic<int> numBytes { 0 };
+    WaitableEvent loaded { true };
+};
+
+//==============================================================================
+ReadAheadFileInputStream::ReadAheadFileInputStream (AsyncFileReader& r, const File& f,
+                                                    int size, int numBlocksToReadAhead)
+    : reader (r), file (f), handle (r.openFile (f)), blockSize (jmax (512, size))
+{
+    for (int i = 0; i <= jmax (1, numBlocksToReadAhead); ++i)
+    {
+        blocks.push_back (std::make_unique<Block> (blockSize));
+        blocks.back()->loaded.signal();
+    }
+
+    requests.reserve (blocks.size());
+}
+
+ReadAheadFileInputStream::~ReadAheadFileInputStream()
+{
+    for (auto& b : blocks)
+        b->loaded.wait();
+}
+
+ReadAheadFileInputStream::Block& ReadAheadFileInputStream::getBlock (int64 blockIndex) noexcept
+{
+    return *blocks[(size_t) (blockIndex % (int64) blocks.size())];
+}
+
+void ReadAheadFileInputStream::readAheadFrom (int64 firstBlock)
+{
+    lastReadAheadBlock = firstBlock;
+
+    const auto totalLength = handle->getSize();
+    const auto lastBlock = jmin (firstBlock + (int64) blocks.size(), (totalLength + blockSize - 1) / blockSize);
+
+    for (auto i = firstBlock; i < lastBlock; ++i)
+    {
+        auto& block = getBlock (i);
+
+        if (block.index == i)
+            continue;
+
+        // A block that's still loading can't be reused until its read has finished
+        block.loaded.wait();
+
+        const auto start = i * blockSize;
+        block.index = i;
+        block.numBytes = 0;
+        block.loaded.reset();
+
+        requests.push_back ({ handle, start, block.data.get(), (int) jmin ((int64) blockSize, totalLength - start),
+                              [&block] (int numRead)
+                              {
+                                  block.numBytes = numRead;
+                                  block.loaded.signal();
+                              } });
+    }
+
+    if (! requests.empty())
+    {
+        reader.submit (requests);
+        requests.clear();
+    }
+}
+
+//==============================================================================
+int64 ReadAheadFileInputStream::getTotalLength()
+{
+    return handle != nullptr ? handle->getSize() : 0;
+}
+
+int ReadAheadFileInputStream::read (void* destBuffer, int maxBytesToRead)
+{
+    // The buffer should never be null, and a negative size is probably a
+    // sign that something is broken!
+    jassert (destBuffer != nullptr && maxBytesToRead >= 0);
+
+    if (handle == nullptr)
+        return 0;
+
+    auto* dest = static_cast<char*> (destBuffer);
+    auto numToRead = (int) jmin ((int64) maxBytesToRead, jmax ((int64) 0, handle->getSize() - position));
+    auto numRead = 0;
+
+    while (numToRead > 0)
+    {
+        const auto blockIndex = position / blockSize;
+
+        if (blockIndex != lastReadAheadBlock)
+            readAheadFrom (blockIndex);
+
+        auto& block = getBlock (blockIndex);
+        block.loaded.wait();
+
+        const auto offset = (int) (position - blockIndex * blockSize);
+        const auto numAvailable = block.numBytes.load() - offset;
+
+        if (numAvailable <= 0)
+        {
+            // If the read failed, forget the block so that it's tried again next time
+            block.index = -1;
+            lastReadAheadBlock = -1;
+            break;
+        }
+
+        const auto num = jmin (numAvailable, numToRead);
+        memcpy (dest, block.data + offset, (size_t) num);
+
+        dest += num;
+        numRead += num;
+        numToRead -= num;
+        position += num;
+    }
+
+    return numRead;
+}
+
+bool ReadAheadFileInputStream::isExhausted()
+{
+    return position >= getTotalLength();
+}
+
+int64 ReadAheadFileInputStream::getPosition()
+{
+    return position;
+}
+
+bool ReadAheadFileInputStream::setPosition (int64 newPosition)
+{
+    position = jlimit ((int64) 0, getTotalLength(), newPosition);
+    return true;
+}
+
+} // namespace juce
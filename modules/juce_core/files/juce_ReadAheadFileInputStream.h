@@ -0,0 +1,110 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    An input stream that reads a file in blocks, fetching the blocks ahead of
+    the current position in the background with an AsyncFileReader.
+
+    When a stream is read sequentially, as audio files usually are, the next few
+    blocks will normally already be in memory by the time they're needed. The
+    blocks are requested as a batch, so a lot of these streams can share one
+    AsyncFileReader without needing a thread each.
+
+    Like any other stream, a single instance must only be used by one thread at
+    a time.
+
+    @see AsyncFileReader, FileInputStream, BufferedInputStream
+
+    @tags{Core}
+*/
+class JUCE_API  ReadAheadFileInputStream  : public InputStream
+{
+public:
+    //==============================================================================
+    /** Creates a stream to read from the given file.
+
+        @param reader               the reader to use. This must outlive the stream
+        @param fileToRead           the file to read from
+        @param blockSize            the size of each block that is fetched from the file
+        @param numBlocksToReadAhead the number of blocks after the one containing the
+                                    current position that are kept loaded or loading
+    */
+    ReadAheadFileInputStream (AsyncFileReader& reader,
+                              const File& fileToRead,
+                              int blockSize = 65536,
+                              int numBlocksToReadAhead = 4);
+
+    /** Destructor. This waits for any reads that are in progress to finish. */
+    ~ReadAheadFileInputStream() override;
+
+    //==============================================================================
+    /** Returns the file that this stream is reading from. */
+    const File& getFile() const noexcept                { return file; }
+
+    /** Returns true if the stream opened without problems. */
+    bool openedOk() const noexcept                      { return handle != nullptr; }
+
+    /** Returns true if the stream couldn't be opened for some reason. */
+    bool failedToOpen() const noexcept                  { return handle == nullptr; }
+
+    //==============================================================================
+    int64 getTotalLength() override;
+    int read (void*, int) override;
+    bool isExhausted() override;
+    int64 getPosition() override;
+    bool setPosition (int64) override;
+
+private:
+    //==============================================================================
+    struct Block;
+
+    void readAheadFrom (int64 firstBlock);
+    Block& getBlock (int64 blockIndex) noexcept;
+
+    AsyncFileReader& reader;
+    const File file;
+    std::shared_ptr<AsyncFileReader::FileHandle> handle;
+    const int blockSize;
+    std::vector<std::unique_ptr<Block>> blocks;
+    std::vector<AsyncFileReader::Request> requests;
+    int64 position = 0, lastReadAheadBlock = -1;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ReadAheadFileInputStream)
+};
+
+} // namespace juce
@@ -367,13 +367,34 @@ struct JSONFormatter
 {
     static void writeEscapedChar (OutputStream& out, const unsigned short value)
     {
-        out << "\\u" << String::toHexString ((int) value).paddedLeft ('0', 4);
+        constexpr auto hex = "0123456789abcdef";
+        const char escaped[] = { '\\', 'u', hex[(value >> 12) & 15], hex[(value >> 8) & 15],
+                                           hex[(value >> 4) & 15],  hex[value & 15] };
+        out.write (escaped, sizeof (escaped));
+    }
+
+    static bool needsEscaping (juce_wchar c, JSON::Encoding encoding) noexcept
+    {
+        return c == '\"' || c == '\\' || CharacterFunctions::isAsciiControlCharacter (c)
+                || (encoding == JSON::Encoding::ascii && ! CharacterFunctions::isAscii (c));
     }
 
     static void writeString (OutputStream& out, String::CharPointerType t, JSON::Encoding encoding)
     {
         for (;;)
         {
+           #if JUCE_STRING_UTF_TYPE == 8
+            // Runs of characters that don't need escaping are already in the right format,
+            // so can be written in one go
+            auto runStart = t.getAddress();
+
+            while (! needsEscaping (*t, encoding))
+                ++t;
+
+            if (t.getAddress() != runStart)
+                out.write (runStart, (size_t) (t.getAddress() - runStart));
+           #endif
+
             const auto c = t.getAndAdvance();
 
             switch (c)
@@ -503,13 +524,21 @@ void JSON::writeToStream (OutputStream& out, const var& v, const FormatOptions&
 
         if (juce_isfinite (d))
         {
-            out << serialiseDouble (d, opt.getMaxDecimalPlaces());
+            char buffer[NumberToStringConverters::charsNeededForDouble];
+            out.write (buffer, serialiseDouble (buffer, d, opt.getMaxDecimalPlaces()));
         }
         else
         {
             out << "null";
         }
     }
+    else if (v.isInt() || v.isInt64())
+    {
+        char buffer[NumberToStringConverters::charsNeededForInt];
+        auto* end = buffer + numElementsInArray (buffer);
+        auto* start = NumberToStringConverters::numberToString (end, static_cast<int64> (v));
+        out.write (start, (size_t) (end - start - 1));
+    }
     else if (v.isArray())
     {
         JSONFormatter::writeArray (out, *v.getArray(), opt);
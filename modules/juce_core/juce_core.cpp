@@ -49,6 +49,7 @@
 #include "juce_core.h"
 
 #include <cctype>
+#include <charconv>
 #include <cstdarg>
 #include <locale>
 #include <thread>
@@ -100,6 +101,13 @@
   #include <ifaddrs.h>
   #include <sys/resource.h>
 
+  #if JUCE_LINUX && __has_include (<linux/io_uring.h>)
+   #include <linux/io_uring.h>
+   #include <sys/syscall.h>
+   #include <sys/mman.h>
+   #include <sys/uio.h>
+  #endif
+
   #if JUCE_USE_CURL
    #include <curl/curl.h>
   #endif
@@ -129,6 +137,10 @@
  #include <android/log.h>
 #endif
 
+#if JUCE_USE_ZSTD
+ #include JUCE_ZSTD_INCLUDE_PATH
+#endif
+
 #undef check
 
 //==============================================================================
@@ -184,6 +196,7 @@
 #include "text/juce_String.cpp"
 #include "streams/juce_OutputStream.cpp"
 #include "text/juce_StringArray.cpp"
+#include "text/juce_StringBuilder.cpp"
 #include "text/juce_StringPairArray.cpp"
 #include "text/juce_StringPool.cpp"
 #include "text/juce_TextDiff.cpp"
@@ -204,6 +217,10 @@
 #include "xml/juce_XmlElement.cpp"
 #include "zip/juce_GZIPDecompressorInputStream.cpp"
 #include "zip/juce_GZIPCompressorOutputStream.cpp"
+#include "zip/juce_LZ4DecompressorInputStream.cpp"
+#include "zip/juce_LZ4CompressorOutputStream.cpp"
+#include "zip/juce_ZstdDecompressorInputStream.cpp"
+#include "zip/juce_ZstdCompressorOutputStream.cpp"
 #include "zip/juce_ZipFile.cpp"
 #include "files/juce_FileFilter.cpp"
 #include "files/juce_WildcardFileFilter.cpp"
@@ -239,6 +256,7 @@
 #elif JUCE_LINUX
  #include "native/juce_CommonFile_linux.cpp"
  #include "native/juce_Files_linux.cpp"
+ #include "native/juce_AsyncFileReader_linux.cpp"
  #include "native/juce_Network_linux.cpp"
  #if JUCE_USE_CURL
   #include "native/juce_Network_curl.cpp"
@@ -280,6 +298,8 @@
 
 #include "files/juce_common_MimeTypes.h"
 #include "files/juce_common_MimeTypes.cpp"
+#include "files/juce_AsyncFileReader.cpp"
+#include "files/juce_ReadAheadFileInputStream.cpp"
 #include "native/juce_AndroidDocument_android.cpp"
 #include "threads/juce_HighResolutionTimer.cpp"
 #include "threads/juce_WaitableEvent.cpp"
@@ -294,6 +314,9 @@
 //==============================================================================
 #if JUCE_UNIT_TESTS
  #include "containers/juce_HashMap_test.cpp"
+ #include "containers/juce_FlatHashMap_test.cpp"
+ #include "files/juce_AsyncFileReader_test.cpp"
+ #include "containers/juce_NamedValueSet_test.cpp"
  #include "containers/juce_Optional_test.cpp"
  #include "containers/juce_Enumerate_test.cpp"
  #include "containers/juce_ListenerList_test.cpp"
@@ -305,6 +328,8 @@
  #include "text/juce_CharPointer_UTF8_test.cpp"
  #include "text/juce_CharPointer_UTF16_test.cpp"
  #include "text/juce_CharPointer_UTF32_test.cpp"
+ #include "text/juce_Identifier_test.cpp"
+ #include "text/juce_StringBuilder_test.cpp"
  #if JUCE_MAC || JUCE_IOS
   #include "native/juce_ObjCHelpers_mac_test.mm"
  #endif
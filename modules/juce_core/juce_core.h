@@ -142,6 +142,32 @@
  #define JUCE_ZLIB_INCLUDE_PATH <zlib.h>
 #endif
 
+/** Config: JUCE_USE_ACCELERATED_ZLIB
+    Enables faster versions of some of the routines in Juce's embedded zlib code: a
+    CRC-32 that uses carry-less multiplication on Intel CPUs that support it, a vectorised
+    Adler-32, and word-at-a-time match comparison and copying in deflate and inflate.
+    The compressed data that's produced is exactly the same with or without this. It
+    has no effect if JUCE_INCLUDE_ZLIB_CODE is disabled.
+*/
+#ifndef JUCE_USE_ACCELERATED_ZLIB
+ #define JUCE_USE_ACCELERATED_ZLIB 1
+#endif
+
+/** Config: JUCE_USE_ZSTD
+    Enables the ZstdCompressorOutputStream and ZstdDecompressorInputStream classes.
+    JUCE doesn't contain a copy of the Zstandard library, so if you enable this, you'll
+    need to make its headers available and link your app to libzstd. You might also
+    want to set a value for JUCE_ZSTD_INCLUDE_PATH, to specify the path where the
+    zstd.h header lives.
+*/
+#ifndef JUCE_USE_ZSTD
+ #define JUCE_USE_ZSTD 0
+#endif
+
+#ifndef JUCE_ZSTD_INCLUDE_PATH
+ #define JUCE_ZSTD_INCLUDE_PATH <zstd.h>
+#endif
+
 /** Config: JUCE_USE_CURL
     Enables http/https support via libcurl (Linux only). Enabling this will add an additional
     run-time dynamic dependency to libcurl.
@@ -290,6 +316,7 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "containers/juce_AbstractFifo.h"
 #include "containers/juce_SingleThreadedAbstractFifo.h"
 #include "text/juce_NewLine.h"
+#include "text/juce_StringBuilder.h"
 #include "text/juce_StringPool.h"
 #include "text/juce_Identifier.h"
 #include "text/juce_StringArray.h"
@@ -307,6 +334,7 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "json/juce_JSON.h"
 #include "containers/juce_DynamicObject.h"
 #include "containers/juce_HashMap.h"
+#include "containers/juce_FlatHashMap.h"
 #include "containers/juce_FixedSizeFunction.h"
 #include "time/juce_TimeUnits.h"
 #include "time/juce_RelativeTime.h"
@@ -353,6 +381,8 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "threads/juce_ReadWriteLock.h"
 #include "threads/juce_ScopedReadLock.h"
 #include "threads/juce_ScopedWriteLock.h"
+#include "files/juce_AsyncFileReader.h"
+#include "files/juce_ReadAheadFileInputStream.h"
 #include "network/juce_IPAddress.h"
 #include "network/juce_MACAddress.h"
 #include "network/juce_NamedPipe.h"
@@ -367,6 +397,10 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "xml/juce_XmlElement.h"
 #include "zip/juce_GZIPCompressorOutputStream.h"
 #include "zip/juce_GZIPDecompressorInputStream.h"
+#include "zip/juce_LZ4CompressorOutputStream.h"
+#include "zip/juce_LZ4DecompressorInputStream.h"
+#include "zip/juce_ZstdCompressorOutputStream.h"
+#include "zip/juce_ZstdDecompressorInputStream.h"
 #include "zip/juce_ZipFile.h"
 #include "containers/juce_PropertySet.h"
 #include "memory/juce_SharedResourcePointer.h"
@@ -107,6 +107,19 @@ UnitTestAllocationChecker::~UnitTestAllocationChecker() noexcept
 
 void UnitTestAllocationChecker::newOrDeleteCalled() noexcept { ++calls; }
 
+//==============================================================================
+ScopedAllocationCounter::ScopedAllocationCounter()
+{
+    getAllocationHooksForThread().addListener (this);
+}
+
+ScopedAllocationCounter::~ScopedAllocationCounter() noexcept
+{
+    getAllocationHooksForThread().removeListener (this);
+}
+
+void ScopedAllocationCounter::newOrDeleteCalled() noexcept { ++calls; }
+
 }
 
 #endif
@@ -80,6 +80,25 @@ private:
     size_t calls = 0;
 };
 
+//==============================================================================
+/** Counts the calls to new/delete that are made on the current thread during the
+    lifetime of the ScopedAllocationCounter, e.g. for reporting in benchmarks.
+*/
+class ScopedAllocationCounter  : private AllocationHooks::Listener
+{
+public:
+    ScopedAllocationCounter();
+    ~ScopedAllocationCounter() noexcept override;
+
+    /** Returns the number of calls to new or delete so far. */
+    size_t getNumCalls() const noexcept     { return calls; }
+
+private:
+    void newOrDeleteCalled() noexcept override;
+
+    size_t calls = 0;
+};
+
 }
 
 #endif
@@ -0,0 +1,324 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+#if __has_include (<linux/io_uring.h>) && defined (__NR_io_uring_setup)
+
+//==============================================================================
+// This talks to io_uring with raw system calls, so that it doesn't need liburing.
+class IoUringReadBackend final : public AsyncFileReader::Backend,
+                                 private Thread
+{
+public:
+    static std::unique_ptr<AsyncFileReader::Backend> create (int maxRequestsInFlight)
+    {
+        std::unique_ptr<IoUringReadBackend> backend (new IoUringReadBackend (maxRequestsInFlight));
+
+        if (! backend->isValid())
+            return {};
+
+        backend->startThread (Priority::high);
+        return backend;
+    }
+
+    ~IoUringReadBackend() override
+    {
+        if (isThreadRunning())
+        {
+            signalThreadShouldExit();
+
+            {
+                const ScopedLock sl (lock);
+
+                // A no-op with a special tag wakes the completion thread up
+                if (auto* sqe = getNextSubmission())
+                {
+                    sqe->opcode = IORING_OP_NOP;
+                    sqe->user_data = wakeUpTag;
+                    submitQueued (1);
+                }
+            }
+
+            stopThread (-1);
+        }
+
+        if (sqes != nullptr)                            munmap (sqes, sqesSize);
+        if (cqRing != nullptr && cqRing != sqRing)      munmap (cqRing, cqRingSize);
+        if (sqRing != nullptr)                          munmap (sqRing, sqRingSize);
+        if (ringFd >= 0)                                close (ringFd);
+    }
+
+    void submit (Span<AsyncFileReader::Request> requests) override
+    {
+        const ScopedLock sl (lock);
+
+        for (auto& r : requests)
+            pending.push_back (std::move (r));
+
+        submitPending();
+    }
+
+    bool isKernelAsyncIO() const noexcept override   { return true; }
+
+private:
+    //==============================================================================
+    struct Slot
+    {
+        AsyncFileReader::Request request;
+        iovec buffer {};
+    };
+
+    static constexpr __u64 wakeUpTag = ~(__u64) 0;
+
+    explicit IoUringReadBackend (int maxRequestsInFlight)
+        : Thread ("io_uring completions")
+    {
+        io_uring_params params {};
+        ringFd = (int) syscall (__NR_io_uring_setup, (unsigned) jlimit (2, 4096, maxRequestsInFlight), &params);
+
+        if (ringFd < 0)
+            return;
+
+        sqRingSize = params.sq_off.array + params.sq_entries * sizeof (unsigned);
+        cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof (io_uring_cqe);
+        sqesSize = params.sq_entries * sizeof (io_uring_sqe);
+
+       #ifdef IORING_FEAT_SINGLE_MMAP
+        const auto singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+       #else
+        const auto singleMap = false;
+       #endif
+
+        if (singleMap)
+            sqRingSize = cqRingSize = jmax (sqRingSize, cqRingSize);
+
+        sqRing = mapRegion (sqRingSize, IORING_OFF_SQ_RING);
+        cqRing = singleMap ? sqRing : mapRegion (cqRingSize, IORING_OFF_CQ_RING);
+        sqes = static_cast<io_uring_sqe*> (mapRegion (sqesSize, IORING_OFF_SQES));
+
+        if (sqRing == nullptr || cqRing == nullptr || sqes == nullptr)
+            return;
+
+        auto* sq = static_cast<char*> (sqRing);
+        sqHead  = reinterpret_cast<unsigned*> (sq + params.sq_off.head);
+        sqTail  = reinterpret_cast<unsigned*> (sq + params.sq_off.tail);
+        sqMask  = *reinterpret_cast<unsigned*> (sq + params.sq_off.ring_mask);
+        sqArray = reinterpret_cast<unsigned*> (sq + params.sq_off.array);
+        numSqEntries = params.sq_entries;
+
+        auto* cq = static_cast<char*> (cqRing);
+        cqHead = reinterpret_cast<unsigned*> (cq + params.cq_off.head);
+        cqTail = reinterpret_cast<unsigned*> (cq + params.cq_off.tail);
+        cqMask = *reinterpret_cast<unsigned*> (cq + params.cq_off.ring_mask);
+        cqes   = reinterpret_cast<io_uring_cqe*> (cq + params.cq_off.cqes);
+
+        // The completion queue is at least as big as the submission queue, so
+        // limiting the reads in flight to this stops it from overflowing
+        slots.resize (numSqEntries);
+
+        for (int i = (int) numSqEntries; --i >= 0;)
+            freeSlots.push_back (i);
+    }
+
+    bool isValid() const noexcept
+    {
+        return sqRing != nullptr && cqRing != nullptr && sqes != nullptr;
+    }
+
+    void* mapRegion (size_t size, off_t offset) const
+    {
+        auto* p = mmap (nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, offset);
+        return p == MAP_FAILED ? nullptr : p;
+    }
+
+    //==============================================================================
+    io_uring_sqe* getNextSubmission() noexcept
+    {
+        const auto head = __atomic_load_n (sqHead, __ATOMIC_ACQUIRE);
+
+        if (localSqTail - head >= numSqEntries)
+            return nullptr;
+
+        const auto index = localSqTail & sqMask;
+        sqArray[index] = index;
+        ++localSqTail;
+
+        auto* sqe = sqes + index;
+        zerostruct (*sqe);
+        return sqe;
+    }
+
+    void submitQueued (unsigned numToSubmit)
+    {
+        __atomic_store_n (sqTail, localSqTail, __ATOMIC_RELEASE);
+
+        while (numToSubmit > 0)
+        {
+            const auto result = (int) syscall (__NR_io_uring_enter, ringFd, numToSubmit, 0, 0, nullptr, 0);
+
+            if (result >= 0)
+            {
+                numToSubmit -= (unsigned) result;
+            }
+            else if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+            {
+                jassertfalse;
+                break;
+            }
+        }
+    }
+
+    // Called with the lock held
+    void submitPending()
+    {
+        unsigned numQueued = 0;
+
+        while (! pending.empty() && ! freeSlots.empty())
+        {
+            auto* sqe = getNextSubmission();
+
+            if (sqe == nullptr)
+                break;
+
+            const auto slotIndex = freeSlots.back();
+            freeSlots.pop_back();
+
+            auto& slot = slots[(size_t) slotIndex];
+            slot.request = std::move (pending.front());
+            pending.pop_front();
+
+            slot.buffer.iov_base = slot.request.destination;
+            slot.buffer.iov_len = (size_t) slot.request.numBytes;
+
+            sqe->opcode = IORING_OP_READV;
+            sqe->fd = slot.request.file->handle.get();
+            sqe->off = (__u64) slot.request.position;
+            sqe->addr = (__u64) (pointer_sized_uint) &slot.buffer;
+            sqe->len = 1;
+            sqe->user_data = (__u64) slotIndex;
+
+            ++numQueued;
+        }
+
+        if (numQueued > 0)
+            submitQueued (numQueued);
+    }
+
+    //==============================================================================
+    void run() override
+    {
+        std::vector<std::pair<AsyncFileReader::Request, int>> finished;
+
+        while (! threadShouldExit())
+        {
+            if (syscall (__NR_io_uring_enter, ringFd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0) < 0
+                 && errno != EINTR)
+            {
+                jassertfalse;
+                break;
+            }
+
+            {
+                const ScopedLock sl (lock);
+
+                auto head = *cqHead;
+                const auto tail = __atomic_load_n (cqTail, __ATOMIC_ACQUIRE);
+
+                for (; head != tail; ++head)
+                {
+                    const auto& cqe = cqes[head & cqMask];
+
+                    if (cqe.user_data == wakeUpTag)
+                        continue;
+
+                    const auto slotIndex = (int) cqe.user_data;
+                    finished.emplace_back (std::move (slots[(size_t) slotIndex].request), cqe.res);
+                    freeSlots.push_back (slotIndex);
+                }
+
+                __atomic_store_n (cqHead, head, __ATOMIC_RELEASE);
+
+                // Keep the disk busy while the callbacks run
+                submitPending();
+            }
+
+            for (auto& [request, result] : finished)
+                request.onComplete (jmax (-1, result));
+
+            finished.clear();
+        }
+    }
+
+    //==============================================================================
+    int ringFd = -1;
+    void* sqRing = nullptr;
+    void* cqRing = nullptr;
+    io_uring_sqe* sqes = nullptr;
+    size_t sqRingSize = 0, cqRingSize = 0, sqesSize = 0;
+
+    unsigned* sqHead = nullptr;
+    unsigned* sqTail = nullptr;
+    unsigned* sqArray = nullptr;
+    unsigned sqMask = 0, numSqEntries = 0, localSqTail = 0;
+
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    io_uring_cqe* cqes = nullptr;
+    unsigned cqMask = 0;
+
+    CriticalSection lock;
+    std::vector<Slot> slots;
+    std::vector<int> freeSlots;
+    std::deque<AsyncFileReader::Request> pending;
+
+    JUCE_DECLARE_NON_COPYABLE (IoUringReadBackend)
+};
+
+static std::unique_ptr<AsyncFileReader::Backend> createNativeAsyncFileReaderBackend (int maxRequestsInFlight)
+{
+    return IoUringReadBackend::create (maxRequestsInFlight);
+}
+
+#else
+
+static std::unique_ptr<AsyncFileReader::Backend> createNativeAsyncFileReaderBackend (int)
+{
+    return {};
+}
+
+#endif
+
+} // namespace juce
@@ -482,6 +482,28 @@ Result FileOutputStream::truncate()
                                               : WindowsFileHelpers::getResultForLastError();
 }
 
+Result FileOutputStream::preallocate (int64 totalNumBytes)
+{
+    if (fileHandle == nullptr)
+        return status;
+
+    LARGE_INTEGER size;
+
+    if (! GetFileSizeEx ((HANDLE) fileHandle, &size))
+        return WindowsFileHelpers::getResultForLastError();
+
+    // Setting an allocation size that's smaller than the file would truncate it
+    if (totalNumBytes <= (int64) size.QuadPart)
+        return Result::ok();
+
+    FILE_ALLOCATION_INFO info;
+    info.AllocationSize.QuadPart = totalNumBytes;
+
+    return SetFileInformationByHandle ((HANDLE) fileHandle, FileAllocationInfo, &info, sizeof (info))
+             ? Result::ok()
+             : WindowsFileHelpers::getResultForLastError();
+}
+
 //==============================================================================
 void MemoryMappedFile::openInternal (const File& file, AccessMode mode, bool exclusive)
 {
@@ -554,6 +554,36 @@ Result FileOutputStream::truncate()
     return getResultForReturnValue (ftruncate (fileHandle.get(), (off_t) currentPosition));
 }
 
+Result FileOutputStream::preallocate (int64 totalNumBytes)
+{
+    if (! fileHandle.isValid())
+        return status;
+
+   #if (JUCE_LINUX || JUCE_ANDROID) && defined (FALLOC_FL_KEEP_SIZE)
+    return getResultForReturnValue (fallocate (fileHandle.get(), FALLOC_FL_KEEP_SIZE, 0, (off_t) totalNumBytes));
+   #elif JUCE_MAC || JUCE_IOS
+    struct stat info;
+
+    if (fstat (fileHandle.get(), &info) == -1)
+        return getResultForErrno();
+
+    if (totalNumBytes <= (int64) info.st_size)
+        return Result::ok();
+
+    // Try for a contiguous block first, and then settle for any space that's free
+    fstore_t store { F_ALLOCATECONTIG, F_PEOFPOSMODE, 0, (off_t) (totalNumBytes - (int64) info.st_size), 0 };
+
+    if (fcntl (fileHandle.get(), F_PREALLOCATE, &store) != -1)
+        return Result::ok();
+
+    store.fst_flags = F_ALLOCATEALL;
+    return getResultForReturnValue (fcntl (fileHandle.get(), F_PREALLOCATE, &store));
+   #else
+    ignoreUnused (totalNumBytes);
+    return Result::fail ("Preallocation isn't supported on this platform");
+   #endif
+}
+
 //==============================================================================
 String SystemStats::getEnvironmentVariable (const String& name, const String& defaultValue)
 {
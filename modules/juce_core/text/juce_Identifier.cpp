@@ -38,38 +38,46 @@ namespace juce
 Identifier::Identifier() noexcept {}
 Identifier::~Identifier() noexcept {}
 
-Identifier::Identifier (const Identifier& other) noexcept  : name (other.name) {}
+Identifier::Identifier (const Identifier& other) noexcept  : hash (other.hash), name (other.name) {}
 
-Identifier::Identifier (Identifier&& other) noexcept : name (std::move (other.name)) {}
+Identifier::Identifier (Identifier&& other) noexcept : hash (other.hash), name (std::move (other.name))
+{
+    other.hash = 0;
+}
 
 Identifier& Identifier::operator= (Identifier&& other) noexcept
 {
+    hash = std::exchange (other.hash, 0u);
     name = std::move (other.name);
     return *this;
 }
 
 Identifier& Identifier::operator= (const Identifier& other) noexcept
 {
+    hash = other.hash;
     name = other.name;
     return *this;
 }
 
 Identifier::Identifier (const String& nm)
-    : name (StringPool::getGlobalPool().getPooledString (nm))
+    : hash (nm.isNotEmpty() ? StringPool::getHash (nm) : 0),
+      name (nm.isNotEmpty() ? StringPool::getGlobalPool().getPooledString (nm, hash) : String())
 {
     // An Identifier cannot be created from an empty string!
     jassert (nm.isNotEmpty());
 }
 
 Identifier::Identifier (const char* nm)
-    : name (StringPool::getGlobalPool().getPooledString (nm))
+    : hash (nm != nullptr && nm[0] != 0 ? StringPool::getHash (nm) : 0),
+      name (nm != nullptr && nm[0] != 0 ? StringPool::getGlobalPool().getPooledString (CharPointer_UTF8 (nm), hash) : String())
 {
     // An Identifier cannot be created from an empty string!
     jassert (nm != nullptr && nm[0] != 0);
 }
 
 Identifier::Identifier (String::CharPointerType start, String::CharPointerType end)
-    : name (StringPool::getGlobalPool().getPooledString (start, end))
+    : hash (start < end ? StringPool::getHash (start, end) : 0),
+      name (start < end ? StringPool::getGlobalPool().getPooledString (start, end, hash) : String())
 {
     // An Identifier cannot be created from an empty string!
     jassert (start < end);
@@ -43,6 +43,9 @@ namespace juce
     them can be slower than just using a String directly, so the optimal way to use them
     is to keep some static Identifier objects for the things you use often.
 
+    Each Identifier also stores a hash of its name, which is computed once when it is
+    created, so Identifiers can be used as keys in hashed containers at no extra cost.
+
     @see NamedValueSet, ValueTree
 
     @tags{Core}
@@ -122,6 +125,12 @@ public:
     /** Returns this identifier as a StringRef. */
     operator StringRef() const noexcept                                 { return name; }
 
+    /** Returns a hash of this identifier's name.
+        This is the same value that StringPool::getHash() returns for the name, so it can
+        also be compared with the hash of a plain string. A null identifier has a hash of 0.
+    */
+    uint32 getHash() const noexcept                                     { return hash; }
+
     /** Returns true if this Identifier is not null */
     bool isValid() const noexcept                                       { return name.isNotEmpty(); }
 
@@ -138,6 +147,7 @@ public:
     static bool isValidIdentifier (const String& possibleIdentifier) noexcept;
 
 private:
+    uint32 hash = 0;
     String name;
 };
 
@@ -0,0 +1,281 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+class IdentifierTests final : public UnitTest
+{
+public:
+    IdentifierTests()
+        : UnitTest ("Identifier", UnitTestCategories::text)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Identifiers made from different string types are identical");
+        {
+            const String text ("someIdentifier");
+            const Identifier a (text), b ("someIdentifier"), c (StringRef ("someIdentifier").text, StringRef ("someIdentifier").text + 14);
+            const String padded ("xsomeIdentifierx");
+            const Identifier fromRange (padded.getCharPointer() + 1, padded.getCharPointer() + 15);
+
+            expect (a == b);
+            expect (a == c);
+            expect (a == fromRange);
+            expect (a.getCharPointer() == b.getCharPointer());
+            expectEquals (a.toString(), text);
+        }
+
+        beginTest ("Hashes");
+        {
+            const Identifier a ("hashMe"), b (String ("hashMe")), c ("hashMe2");
+
+            expect (a.getHash() == b.getHash());
+            expect (a.getHash() == StringPool::getHash ("hashMe"));
+            expect (a.getHash() != c.getHash());
+            expect (Identifier().getHash() == 0);
+
+            const auto accented = "caf" + String::charToString ((juce_wchar) 0xe9);
+            expect (Identifier (accented).getHash() == StringPool::getHash (accented));
+            expect (Identifier (accented) == Identifier (accented.toRawUTF8()));
+
+            auto copy = a;
+            expect (copy.getHash() == a.getHash());
+
+            auto moved = std::move (copy);
+            expect (moved.getHash() == a.getHash());
+        }
+
+        beginTest ("Pool grows and stays consistent");
+        {
+            StringPool pool;
+            StringArray originals;
+
+            for (int i = 0; i < 5000; ++i)
+                originals.add (pool.getPooledString ("string" + String (i)));
+
+            auto allSame = true;
+
+            for (int i = 0; i < 5000; ++i)
+            {
+                auto s = "string" + String (i);
+                allSame = allSame && pool.getPooledString (s).getCharPointer() == originals[i].getCharPointer()
+                                  && pool.getPooledString (s.toRawUTF8()).getCharPointer() == originals[i].getCharPointer()
+                                  && pool.getPooledString (StringRef (s)).getCharPointer() == originals[i].getCharPointer();
+            }
+
+            expect (allSame);
+            expect (pool.getPooledString (String()).isEmpty());
+        }
+
+        beginTest ("Garbage collection keeps strings that are still in use");
+        {
+            StringPool pool;
+            auto kept = pool.getPooledString ("kept");
+
+            for (int i = 0; i < 100; ++i)
+                pool.getPooledString ("temporary" + String (i));
+
+            pool.garbageCollect();
+
+            expect (pool.getPooledString ("kept").getCharPointer() == kept.getCharPointer());
+            expectEquals (kept.getReferenceCount(), 2);
+            expectEquals (pool.getPooledString ("temporary5"), String ("temporary5"));
+        }
+
+        beginTest ("Concurrent creation");
+        {
+            StringPool pool;
+            constexpr int numThreads = 4, numStrings = 2000;
+            std::vector<std::vector<String>> results (numThreads);
+
+            {
+                OwnedArray<Thread> threads;
+
+                for (int t = 0; t < numThreads; ++t)
+                {
+                    struct Creator final : public Thread
+                    {
+                        Creator (StringPool& p, std::vector<String>& r) : Thread ("creator"), pool (p), results (r) {}
+
+                        void run() override
+                        {
+                            for (int i = 0; i < numStrings; ++i)
+                            {
+                                results.push_back (pool.getPooledString ("name" + String (i)));
+
+                                if (i % 500 == 0)
+                                    pool.garbageCollect();
+                            }
+                        }
+
+                        StringPool& pool;
+                        std::vector<String>& results;
+                    };
+
+                    threads.add (new Creator (pool, results[(size_t) t]))->startThread();
+                }
+
+                for (auto* t : threads)
+                    t->stopThread (-1);
+            }
+
+            auto allSame = true;
+
+            for (int t = 1; t < numThreads; ++t)
+                for (size_t i = 0; i < (size_t) numStrings; ++i)
+                    allSame = allSame && results[(size_t) t][i].getCharPointer() == results[0][i].getCharPointer();
+
+            expect (allSame);
+        }
+
+        beginTest ("Lookups during garbage collection");
+        {
+            StringPool pool;
+            constexpr int numThreads = 4, numNames = 50, numLookups = 20000;
+            std::vector<String> held (numThreads * numNames);
+            std::atomic<bool> finished { false }, allMatched { true };
+
+            struct FunctionThread final : public Thread
+            {
+                explicit FunctionThread (std::function<void()> f) : Thread ("pool test"), fn (std::move (f)) {}
+                void run() override  { fn(); }
+                std::function<void()> fn;
+            };
+
+            {
+                OwnedArray<Thread> threads;
+
+                for (int t = 0; t < numThreads; ++t)
+                {
+                    threads.add (new FunctionThread ([&, t]
+                    {
+                        for (int i = 0; i < numLookups; ++i)
+                        {
+                            const auto index = i % numNames;
+                            const auto text = "name" + String (index);
+                            auto s = pool.getPooledString (text);
+
+                            if (s != text)
+                                allMatched = false;
+
+                            // Keep some strings referenced, and let others go
+                            if ((i / numNames) % 2 == t % 2)
+                                held[(size_t) (t * numNames + index)] = s;
+                            else
+                                held[(size_t) (t * numNames + index)] = {};
+                        }
+                    }))->startThread();
+                }
+
+                threads.add (new FunctionThread ([&]
+                {
+                    while (! finished)
+                        pool.garbageCollect();
+                }))->startThread();
+
+                for (int t = 0; t < numThreads; ++t)
+                    threads[t]->stopThread (-1);
+
+                finished = true;
+                threads.getLast()->stopThread (-1);
+            }
+
+            expect (allMatched);
+
+            auto allShared = true;
+
+            for (auto& s : held)
+                if (s.isNotEmpty())
+                    allShared = allShared && pool.getPooledString (s).getCharPointer() == s.getCharPointer();
+
+            expect (allShared);
+        }
+    }
+};
+
+static IdentifierTests identifierTests;
+
+//==============================================================================
+class IdentifierBenchmarks final : public UnitTest
+{
+public:
+    IdentifierBenchmarks()
+        : UnitTest ("Identifier benchmarks", UnitTestCategories::benchmarks)
+    {}
+
+    template <typename Fn>
+    static double nanosecondsPerCall (int numCalls, Fn&& fn)
+    {
+        auto start = Time::getHighResolutionTicks();
+
+        for (int i = 0; i < numCalls; ++i)
+            fn (i);
+
+        return Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start) * 1.0e9 / numCalls;
+    }
+
+    void runTest() override
+    {
+        beginTest ("Identifier creation");
+
+        StringArray names;
+
+        for (int i = 0; i < 1000; ++i)
+            names.add ("property_" + String (i));
+
+        for (auto& n : names)
+            Identifier keepAlive (n);
+
+        std::vector<Identifier> existing;
+        existing.reserve (1000);
+
+        for (auto& n : names)
+            existing.emplace_back (n);
+
+        const auto fromString = nanosecondsPerCall (200000, [&] (int i) { Identifier id (names.getReference (i % 1000)); ignoreUnused (id); });
+        const auto fromLiteral = nanosecondsPerCall (200000, [&] (int i) { Identifier id (names.getReference (i % 1000).toRawUTF8()); ignoreUnused (id); });
+        const auto fromNewString = nanosecondsPerCall (20000, [&] (int i) { Identifier id ("new_" + String (i)); ignoreUnused (id); });
+
+        logMessage ("Existing identifier from String: " + String (fromString, 1) + " ns");
+        logMessage ("Existing identifier from const char*: " + String (fromLiteral, 1) + " ns");
+        logMessage ("New identifier (including String construction): " + String (fromNewString, 1) + " ns");
+    }
+};
+
+static IdentifierBenchmarks identifierBenchmarks;
+
+} // namespace juce
@@ -208,6 +208,18 @@ public:
         return newText;
     }
 
+    // Used when appending, so that a string that's built up by repeatedly adding to
+    // it only needs to be reallocated a logarithmic number of times.
+    static CharPointerType makeUniqueWithByteSizeForAppending (const CharPointerType text, size_t numBytes)
+    {
+        auto* b = bufferFromText (text);
+
+        if (! isEmptyString (b) && b->refCount <= 0 && b->allocatedNumBytes < numBytes)
+            numBytes = jmax (numBytes, b->allocatedNumBytes + b->allocatedNumBytes / 2);
+
+        return makeUniqueWithByteSize (text, numBytes);
+    }
+
     static size_t getAllocatedNumBytes (const CharPointerType text) noexcept
     {
         return bufferFromText (text)->allocatedNumBytes;
@@ -496,8 +508,33 @@ namespace NumberToStringConverters
         }
     };
 
+   #if defined (__cpp_lib_to_chars)
+    // std::to_chars doesn't depend on the locale or need a stream to be constructed, so it's
+    // much quicker, and gives the same results as the stream-based version.
+    static bool writeDouble (char* buffer, double n, int numDecPlaces, bool useScientificNotation, size_t& len) noexcept
+    {
+        auto* end = buffer + charsNeededForDouble;
+
+        const auto result = numDecPlaces > 0
+                          ? std::to_chars (buffer, end, n, useScientificNotation ? std::chars_format::scientific
+                                                                                 : std::chars_format::fixed, numDecPlaces)
+                          : std::to_chars (buffer, end, n, std::chars_format::general, 6);
+
+        if (result.ec != std::errc())
+            return false;
+
+        len = (size_t) (result.ptr - buffer);
+        return true;
+    }
+   #endif
+
     static char* doubleToString (char* buffer, double n, int numDecPlaces, bool useScientificNotation, size_t& len) noexcept
     {
+       #if defined (__cpp_lib_to_chars)
+        if (writeDouble (buffer, n, numDecPlaces, useScientificNotation, len))
+            return buffer;
+       #endif
+
         StackArrayStream strm (buffer);
         len = strm.writeDouble (n, numDecPlaces, useScientificNotation);
         jassert (len <= charsNeededForDouble);
@@ -756,7 +793,8 @@ void String::appendCharPointer (const CharPointerType startOfTextToAppend,
     if (extraBytesNeeded > 0)
     {
         auto byteOffsetOfNull = getByteOffsetOfEnd();
-        preallocateBytes ((size_t) extraBytesNeeded + byteOffsetOfNull);
+        text = StringHolderUtils::makeUniqueWithByteSizeForAppending (text, (size_t) extraBytesNeeded + byteOffsetOfNull
+                                                                              + sizeof (CharPointerType::CharType));
 
         auto* newStringStart = addBytesToPointer (text.getAddress(), (int) byteOffsetOfNull);
         memcpy (newStringStart, startOfTextToAppend.getAddress(), (size_t) extraBytesNeeded);
@@ -790,7 +828,15 @@ String& String::operator+= (const String& other)
 
 String& String::operator+= (StringRef other)
 {
-    return operator+= (String (other));
+    // if the text is part of this string, it needs copying before our buffer gets reallocated
+    auto* start = text.getAddress();
+    auto* otherStart = other.text.getAddress();
+
+    if (otherStart >= start && otherStart <= addBytesToPointer (start, getByteOffsetOfEnd()))
+        return operator+= (String (other));
+
+    appendCharPointer (other.text);
+    return *this;
 }
 
 String& String::operator+= (char ch)
@@ -2211,16 +2257,17 @@ StringRef::StringRef (const String& string) noexcept   : text (string.getCharPoi
 StringRef::StringRef (const std::string& string)       : StringRef (string.c_str()) {}
 
 //==============================================================================
-static String reduceLengthOfFloatString (const String& input)
+/*  Removes any redundant trailing zeros and exponent padding from a number that has been
+    written into a buffer, returning the new end of the text.
+*/
+static char* reduceLengthOfFloatString (char* start, char* end) noexcept
 {
-    const auto start = input.getCharPointer();
-    const auto end = start + (int) input.length();
     auto trimStart = end;
     auto trimEnd = trimStart;
     auto exponentTrimStart = end;
     auto exponentTrimEnd = exponentTrimStart;
 
-    decltype (*start) currentChar = '\0';
+    char currentChar = '\0';
 
     for (auto c = end - 1; c > start; --c)
     {
@@ -2267,34 +2314,41 @@ static String reduceLengthOfFloatString (const String& input)
 
     if ((trimStart != trimEnd && currentChar == '.') || exponentTrimStart != exponentTrimEnd)
     {
-        if (trimStart == trimEnd)
-            return String (start, exponentTrimStart) + String (exponentTrimEnd, end);
+        auto numMantissaBytes = (size_t) (exponentTrimStart - trimEnd);
+        auto numExponentBytes = (size_t) (end - exponentTrimEnd);
 
-        if (exponentTrimStart == exponentTrimEnd)
-            return String (start, trimStart) + String (trimEnd, end);
+        std::memmove (trimStart, trimEnd, numMantissaBytes);
+        std::memmove (trimStart + numMantissaBytes, exponentTrimEnd, numExponentBytes);
 
-        if (trimEnd == exponentTrimStart)
-            return String (start, trimStart) + String (exponentTrimEnd, end);
-
-        return String (start, trimStart) + String (trimEnd, exponentTrimStart) + String (exponentTrimEnd, end);
+        return trimStart + numMantissaBytes + numExponentBytes;
     }
 
-    return input;
+    return end;
 }
 
-/*  maxDecimalPlaces <= 0 means "use as many decimal places as necessary"
+/*  Writes a number into a buffer of at least NumberToStringConverters::charsNeededForDouble
+    bytes, without allocating, and returns the number of bytes written.
+
+    maxDecimalPlaces <= 0 means "use as many decimal places as necessary"
 */
-static String serialiseDouble (double input, int maxDecimalPlaces = 0)
+static size_t serialiseDouble (char* buffer, double input, int maxDecimalPlaces) noexcept
 {
+    size_t length = 0;
     auto absInput = std::abs (input);
 
     if (absInput >= 1.0e6 || absInput <= 1.0e-5)
-        return reduceLengthOfFloatString ({ input, maxDecimalPlaces > 0 ? maxDecimalPlaces : 15, true });
+    {
+        NumberToStringConverters::doubleToString (buffer, input, maxDecimalPlaces > 0 ? maxDecimalPlaces : 15, true, length);
+        return (size_t) (reduceLengthOfFloatString (buffer, buffer + length) - buffer);
+    }
 
     int intInput = (int) input;
 
     if (exactlyEqual ((double) intInput, input))
-        return { input, 1 };
+    {
+        NumberToStringConverters::doubleToString (buffer, input, 1, false, length);
+        return length;
+    }
 
     auto numberOfDecimalPlaces = [absInput, maxDecimalPlaces]
     {
@@ -2326,7 +2380,15 @@ static String serialiseDouble (double input, int maxDecimalPlaces = 0)
         return 10;
     }();
 
-    return reduceLengthOfFloatString (String (input, numberOfDecimalPlaces));
+    NumberToStringConverters::doubleToString (buffer, input, numberOfDecimalPlaces, false, length);
+    return (size_t) (reduceLengthOfFloatString (buffer, buffer + length) - buffer);
+}
+
+static String serialiseDouble (double input, int maxDecimalPlaces = 0)
+{
+    char buffer[NumberToStringConverters::charsNeededForDouble];
+    auto length = serialiseDouble (buffer, input, maxDecimalPlaces);
+    return String (buffer, length);
 }
 
 //==============================================================================
@@ -2354,6 +2416,13 @@ public:
         : UnitTest ("String class", UnitTestCategories::text)
     {}
 
+    static String reduceLengthOfFloatString (const String& input)
+    {
+        auto utf8 = input.toStdString();
+        auto* start = utf8.data();
+        return String (start, (size_t) (juce::reduceLengthOfFloatString (start, start + utf8.size()) - start));
+    }
+
     template <class CharPointerType>
     struct TestUTFConversion
     {
@@ -0,0 +1,149 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+StringBuilder::StringBuilder (size_t numBytesToReserve)
+{
+    reserve (numBytesToReserve);
+}
+
+//==============================================================================
+char* StringBuilder::getSpaceFor (size_t numBytesToAdd)
+{
+    reserve (numBytes + numBytesToAdd);
+    return data + numBytes;
+}
+
+void StringBuilder::reserve (size_t numBytesNeeded)
+{
+    if (numBytesNeeded < capacity)
+        return;
+
+    auto newCapacity = jmax (numBytesNeeded + 1, capacity + capacity / 2);
+
+    HeapBlock<char> newData (newCapacity);
+    memcpy (newData, data, numBytes + 1);
+
+    heapData.swapWith (newData);
+    data = heapData;
+    capacity = newCapacity;
+}
+
+void StringBuilder::clear() noexcept
+{
+    numBytes = 0;
+    data[0] = 0;
+}
+
+//==============================================================================
+StringBuilder& StringBuilder::append (const char* utf8, size_t numBytesToAdd)
+{
+    if (numBytesToAdd > 0)
+    {
+        jassert (utf8 != nullptr);
+
+        auto* dest = getSpaceFor (numBytesToAdd);
+        memcpy (dest, utf8, numBytesToAdd);
+        numBytes += numBytesToAdd;
+        data[numBytes] = 0;
+    }
+
+    return *this;
+}
+
+StringBuilder& StringBuilder::append (StringRef text)
+{
+    if constexpr (std::is_same_v<String::CharPointerType, CharPointer_UTF8>)
+    {
+        auto* utf8 = text.text.getAddress();
+        return append (utf8, strlen (utf8));
+    }
+    else
+    {
+        auto numBytesToAdd = CharPointer_UTF8::getBytesRequiredFor (text.text);
+        CharPointer_UTF8 (getSpaceFor (numBytesToAdd)).writeAll (text.text);
+        numBytes += numBytesToAdd;
+        return *this;
+    }
+}
+
+StringBuilder& StringBuilder::appendCharacter (juce_wchar character)
+{
+    auto numBytesToAdd = CharPointer_UTF8::getBytesRequiredFor (character);
+    CharPointer_UTF8 dest (getSpaceFor (numBytesToAdd));
+    dest.write (character);
+    dest.writeNull();
+    numBytes += numBytesToAdd;
+    return *this;
+}
+
+//==============================================================================
+template <typename IntegerType>
+static StringBuilder& appendInteger (StringBuilder& builder, IntegerType number)
+{
+    char buffer[NumberToStringConverters::charsNeededForInt];
+    auto* end = buffer + numElementsInArray (buffer);
+    auto* start = NumberToStringConverters::numberToString (end, number);
+    return builder.append (start, (size_t) (end - start - 1));
+}
+
+StringBuilder& StringBuilder::operator<< (int number)             { return appendInteger (*this, number); }
+StringBuilder& StringBuilder::operator<< (unsigned int number)    { return appendInteger (*this, number); }
+StringBuilder& StringBuilder::operator<< (long number)            { return appendInteger (*this, number); }
+StringBuilder& StringBuilder::operator<< (unsigned long number)   { return appendInteger (*this, number); }
+StringBuilder& StringBuilder::operator<< (int64 number)           { return appendInteger (*this, number); }
+StringBuilder& StringBuilder::operator<< (uint64 number)          { return appendInteger (*this, number); }
+
+StringBuilder& StringBuilder::operator<< (double number)
+{
+    return append (number, 0, false);
+}
+
+StringBuilder& StringBuilder::append (double number, int numberOfDecimalPlaces, bool useScientificNotation)
+{
+    char buffer[NumberToStringConverters::charsNeededForDouble];
+    size_t length = 0;
+    auto* start = NumberToStringConverters::doubleToString (buffer, number, numberOfDecimalPlaces, useScientificNotation, length);
+    return append (start, length);
+}
+
+//==============================================================================
+String StringBuilder::toString() const
+{
+    return String (getCharPointer(), CharPointer_UTF8 (data + numBytes));
+}
+
+} // namespace juce
@@ -0,0 +1,164 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Builds up a UTF-8 string by appending text and numbers to a reusable buffer.
+
+    Appending to a String may reallocate it, and numbers have to be turned into
+    temporary Strings before they can be added to one. A StringBuilder instead writes
+    everything into its own buffer, the first inlineCapacity bytes of which live inside
+    the object itself, so short strings can be built without touching the heap. Numbers
+    are formatted straight into the buffer without any allocation.
+
+    Calling clear() keeps whatever storage has been allocated, so a builder that gets
+    reused (e.g. to format a label every time it's repainted) stops allocating once it
+    has grown big enough for the longest string that it's asked to build.
+
+    The text can be used in place with toRawUTF8() or getCharPointer(), or turned into
+    a String with toString(), which makes exactly one allocation.
+
+    @code
+    StringBuilder sb;
+    sb << "Gain: " << gainInDecibels << " dB";
+    label.setText (sb.toString(), dontSendNotification);
+    @endcode
+
+    @see String, MemoryOutputStream
+
+    @tags{Core}
+*/
+class JUCE_API StringBuilder
+{
+public:
+    //==============================================================================
+    /** The number of bytes (including a null terminator) that can be held without
+        allocating any memory.
+    */
+    static constexpr size_t inlineCapacity = 128;
+
+    /** Creates an empty builder. */
+    StringBuilder() noexcept = default;
+
+    /** Creates an empty builder, with space reserved for the given number of bytes. */
+    explicit StringBuilder (size_t numBytesToReserve);
+
+    //==============================================================================
+    /** Appends some text. */
+    StringBuilder& append (StringRef text);
+
+    /** Appends a block of UTF-8 encoded data, which doesn't need to be null-terminated. */
+    StringBuilder& append (const char* utf8, size_t numBytes);
+
+    /** Appends a single unicode character. */
+    StringBuilder& appendCharacter (juce_wchar character);
+
+    /** Appends a number, formatted in the same way as String (double, int, bool). */
+    StringBuilder& append (double number, int numberOfDecimalPlaces, bool useScientificNotation = false);
+
+    /** Appends some text. */
+    StringBuilder& operator<< (StringRef text)              { return append (text); }
+    /** Appends some text. */
+    StringBuilder& operator<< (const String& text)          { return append (StringRef (text)); }
+    /** Appends some text. */
+    StringBuilder& operator<< (const char* text)            { return append (StringRef (text)); }
+    /** Appends a character. */
+    StringBuilder& operator<< (char character)              { return appendCharacter ((juce_wchar) (uint8) character); }
+    /** Appends a decimal number. */
+    StringBuilder& operator<< (int number);
+    /** Appends a decimal number. */
+    StringBuilder& operator<< (unsigned int number);
+    /** Appends a decimal number. */
+    StringBuilder& operator<< (long number);
+    /** Appends a decimal number. */
+    StringBuilder& operator<< (unsigned long number);
+    /** Appends a decimal number. */
+    StringBuilder& operator<< (int64 number);
+    /** Appends a decimal number. */
+    StringBuilder& operator<< (uint64 number);
+    /** Appends a number, formatted in the same way as String (double). */
+    StringBuilder& operator<< (double number);
+    /** Appends a number, formatted in the same way as String (float). */
+    StringBuilder& operator<< (float number)                { return operator<< ((double) number); }
+
+    //==============================================================================
+    /** Removes all the text, but keeps any storage that has been allocated. */
+    void clear() noexcept;
+
+    /** Makes sure that there's enough space to hold the given number of bytes without
+        needing to reallocate.
+    */
+    void reserve (size_t numBytesNeeded);
+
+    /** Returns the number of bytes of text in the builder (not including the null terminator). */
+    size_t getNumBytes() const noexcept                     { return numBytes; }
+
+    /** Returns the number of bytes (including the null terminator) that the builder
+        can hold without reallocating.
+    */
+    size_t getCapacity() const noexcept                     { return capacity; }
+
+    /** Returns true if no text has been added. */
+    bool isEmpty() const noexcept                           { return numBytes == 0; }
+
+    //==============================================================================
+    /** Returns a pointer to the null-terminated UTF-8 text.
+        This is invalidated when any more text is added.
+    */
+    const char* toRawUTF8() const noexcept                  { return data; }
+
+    /** Returns a pointer to the null-terminated text.
+        This is invalidated when any more text is added.
+    */
+    CharPointer_UTF8 getCharPointer() const noexcept        { return CharPointer_UTF8 (data); }
+
+    /** Creates a String containing the text. */
+    String toString() const;
+
+private:
+    //==============================================================================
+    char* getSpaceFor (size_t numBytesToAdd);
+
+    size_t numBytes = 0, capacity = inlineCapacity;
+    HeapBlock<char> heapData;
+    char inlineData[inlineCapacity] = {};
+    char* data = inlineData;
+
+    JUCE_DECLARE_NON_COPYABLE (StringBuilder)
+};
+
+} // namespace juce
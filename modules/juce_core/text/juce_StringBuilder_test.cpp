@@ -0,0 +1,329 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#if JUCE_ENABLE_ALLOCATION_HOOKS
+#define JUCE_FAIL_ON_ALLOCATION_IN_SCOPE const UnitTestAllocationChecker checker (*this)
+#else
+#define JUCE_FAIL_ON_ALLOCATION_IN_SCOPE
+#endif
+
+namespace juce
+{
+
+class StringBuilderTests final : public UnitTest
+{
+public:
+    StringBuilderTests()
+        : UnitTest ("StringBuilder", UnitTestCategories::text)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Appending text and numbers");
+        {
+            StringBuilder sb;
+            expect (sb.isEmpty());
+            expectEquals (String (sb.toRawUTF8()), String());
+
+            sb << "abc" << String ("def") << StringRef ("ghi") << 'j';
+            sb.appendCharacter ((juce_wchar) 0x1f600);
+            sb << -123 << 456u << (int64) std::numeric_limits<int64>::min() << (uint64) std::numeric_limits<uint64>::max();
+            sb << ' ' << 1.5 << ' ' << 0.1f << ' ';
+            sb.append (3.14159, 2).append (" ", 1).append (12345.678, 3, true);
+
+            String expected;
+            expected << "abc" << "def" << "ghi" << 'j' << String::charToString ((juce_wchar) 0x1f600)
+                     << -123 << String (456u) << std::numeric_limits<int64>::min() << std::numeric_limits<uint64>::max()
+                     << ' ' << 1.5 << ' ' << 0.1f << ' ' << String (3.14159, 2) << " " << String (12345.678, 3, true);
+
+            expectEquals (sb.toString(), expected);
+            expectEquals ((int) sb.getNumBytes(), (int) expected.getNumBytesAsUTF8());
+            expect (sb.getCharPointer().compare (expected.getCharPointer()) == 0);
+        }
+
+        beginTest ("Growing and clearing");
+        {
+            StringBuilder sb;
+            String expected;
+
+            for (int i = 0; i < 1000; ++i)
+            {
+                sb << i << ",";
+                expected << i << ",";
+            }
+
+            expectEquals (sb.toString(), expected);
+            expect (sb.getCapacity() > StringBuilder::inlineCapacity);
+
+            const auto capacity = sb.getCapacity();
+            sb.clear();
+
+            expect (sb.isEmpty());
+            expectEquals (sb.toString(), String());
+            expectEquals ((int) sb.getCapacity(), (int) capacity);
+
+            StringBuilder reserved (5000);
+            expect (reserved.getCapacity() > 5000);
+        }
+
+        beginTest ("Building short strings doesn't allocate");
+        {
+            StringBuilder sb;
+
+            {
+                JUCE_FAIL_ON_ALLOCATION_IN_SCOPE;
+                sb << "Gain: " << -12.5 << " dB, " << 42 << " voices";
+                sb.append (0.123456, 3);
+            }
+
+            expectEquals (sb.toString(), String ("Gain: -12.5 dB, 42 voices0.123"));
+        }
+
+        beginTest ("Number formatting matches the stream-based formatting");
+        {
+            Random r (getRandom().nextInt());
+            auto allMatch = true;
+
+            for (int i = 0; i < 2000; ++i)
+            {
+                const auto n = (r.nextDouble() - 0.5) * std::pow (10.0, r.nextInt ({ -12, 12 }));
+                const auto decimalPlaces = r.nextInt (10);
+                const auto scientific = r.nextBool();
+
+                for (auto places : { 0, decimalPlaces })
+                {
+                    char buffer[NumberToStringConverters::charsNeededForDouble];
+                    size_t length = 0;
+                    NumberToStringConverters::doubleToString (buffer, n, places, scientific, length);
+
+                    char streamBuffer[NumberToStringConverters::charsNeededForDouble];
+                    const auto streamLength = NumberToStringConverters::StackArrayStream (streamBuffer).writeDouble (n, places, scientific);
+
+                    allMatch = allMatch && length == streamLength && memcmp (buffer, streamBuffer, length) == 0;
+                }
+            }
+
+            expect (allMatch);
+        }
+
+        beginTest ("String appending grows geometrically");
+        {
+            String s ("x");
+            int numReallocations = 0;
+
+            for (int i = 0; i < 10000; ++i)
+            {
+                auto* before = s.getCharPointer().getAddress();
+                s << 'y';
+
+                if (s.getCharPointer().getAddress() != before)
+                    ++numReallocations;
+            }
+
+            expectEquals (s.length(), 10001);
+            expect (numReallocations < 40);
+
+            String copy (s);
+            copy << "z";
+            expect (s.length() == 10001 && copy.length() == 10002);
+
+            String selfAppend ("abc");
+            selfAppend += StringRef (selfAppend);
+            selfAppend += StringRef (selfAppend.getCharPointer() + 1);
+            expectEquals (selfAppend, String ("abcabcbcabc"));
+        }
+
+        beginTest ("Writing JSON into a preallocated stream doesn't allocate");
+        {
+            auto object = std::make_unique<DynamicObject>();
+            object->setProperty ("double", 1.25);
+            object->setProperty ("int", 42);
+            object->setProperty ("int64", (int64) 1 << 40);
+            object->setProperty ("string", "some \"text\"\n" + String::charToString ((juce_wchar) 0xe9));
+            object->setProperty ("array", Array<var> { 1, -2.5e-9, "x" });
+            const var json (object.release());
+
+            const String expected ("{\"double\":1.25,\"int\":42,\"int64\":1099511627776,\"string\":\"some \\\"text\\\"\\n"
+                                   + String::charToString ((juce_wchar) 0xe9) + "\",\"array\":[1,-2.5e-9,\"x\"]}");
+
+            MemoryBlock block (1024);
+            MemoryOutputStream out (block, false);
+
+            {
+                JUCE_FAIL_ON_ALLOCATION_IN_SCOPE;
+                JSON::writeToStream (out, json, JSON::FormatOptions{}.withSpacing (JSON::Spacing::none));
+            }
+
+            expectEquals (out.toUTF8(), expected);
+            expectEquals (JSON::toString (json, JSON::FormatOptions{}.withSpacing (JSON::Spacing::none)), expected);
+            expectEquals (JSON::toString (var (String::fromUTF8 ("\x01\xc3\xa9")), JSON::FormatOptions{}.withEncoding (JSON::Encoding::ascii)),
+                          String ("\"\\u0001\\u00e9\""));
+        }
+    }
+};
+
+static StringBuilderTests stringBuilderTests;
+
+//==============================================================================
+class StringBuilderBenchmarks final : public UnitTest
+{
+public:
+    StringBuilderBenchmarks()
+        : UnitTest ("String building benchmarks", UnitTestCategories::benchmarks)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Building lines of text");
+        {
+            constexpr int numLines = 20000;
+            auto total = 0;
+
+            log ("String +=", numLines, [&] (int i)
+            {
+                String line;
+
+                for (int j = 0; j < 10; ++j)
+                    line << "item " << (i + j) << ", ";
+
+                total += line.length();
+            });
+
+            StringBuilder sb;
+
+            log ("StringBuilder (reused)", numLines, [&] (int i)
+            {
+                sb.clear();
+
+                for (int j = 0; j < 10; ++j)
+                    sb << "item " << (i + j) << ", ";
+
+                total += (int) sb.getNumBytes();
+            });
+
+            log ("StringBuilder + toString()", numLines, [&] (int i)
+            {
+                sb.clear();
+
+                for (int j = 0; j < 10; ++j)
+                    sb << "item " << (i + j) << ", ";
+
+                total += sb.toString().length();
+            });
+
+            ignoreUnused (total);
+        }
+
+        beginTest ("Formatting numbers");
+        {
+            constexpr int numValues = 50000;
+            std::vector<double> values;
+            Random r (1234);
+
+            for (int i = 0; i < numValues; ++i)
+                values.push_back ((r.nextDouble() - 0.5) * std::pow (10.0, r.nextInt ({ -8, 8 })));
+
+            size_t total = 0;
+            char buffer[NumberToStringConverters::charsNeededForDouble];
+
+            log ("double via std::ostream", numValues, [&] (int i)
+            {
+                total += NumberToStringConverters::StackArrayStream (buffer).writeDouble (values[(size_t) i], 0, false);
+            });
+
+            log ("double into a buffer", numValues, [&] (int i)
+            {
+                size_t length = 0;
+                NumberToStringConverters::doubleToString (buffer, values[(size_t) i], 0, false, length);
+                total += length;
+            });
+
+            log ("String (double)", numValues, [&] (int i) { total += (size_t) String (values[(size_t) i]).length(); });
+            log ("serialiseDouble", numValues, [&] (int i) { total += serialiseDouble (buffer, values[(size_t) i], 0); });
+
+            ignoreUnused (total);
+        }
+
+        beginTest ("Writing JSON");
+        {
+            Array<var> items;
+            Random r (4321);
+
+            for (int i = 0; i < 2000; ++i)
+            {
+                auto object = std::make_unique<DynamicObject>();
+                object->setProperty ("id", i);
+                object->setProperty ("name", "item " + String (i));
+                object->setProperty ("value", r.nextDouble() * 1000.0);
+                items.add (var (object.release()));
+            }
+
+            const var json (items);
+            size_t total = 0;
+
+            log ("JSON::toString", 20, [&] (int) { total += JSON::toString (json, true).getNumBytesAsUTF8(); });
+
+            ignoreUnused (total);
+        }
+    }
+
+private:
+    template <typename Fn>
+    void log (const String& operation, int numIterations, Fn&& fn)
+    {
+       #if JUCE_ENABLE_ALLOCATION_HOOKS
+        const ScopedAllocationCounter counter;
+       #endif
+
+        const auto start = Time::getHighResolutionTicks();
+
+        for (int i = 0; i < numIterations; ++i)
+            fn (i);
+
+        const auto seconds = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start);
+        auto message = operation + ": " + String (seconds * 1.0e9 / numIterations, 1) + " ns";
+
+       #if JUCE_ENABLE_ALLOCATION_HOOKS
+        message << ", " << String ((double) counter.getNumCalls() / numIterations, 2) << " new/delete calls";
+       #endif
+
+        logMessage (message);
+    }
+};
+
+static StringBuilderBenchmarks stringBuilderBenchmarks;
+
+} // namespace juce
+
+#undef JUCE_FAIL_ON_ALLOCATION_IN_SCOPE
@@ -38,9 +38,6 @@ namespace juce
 static const int minNumberOfStringsForGarbageCollection = 300;
 static const uint32 garbageCollectionInterval = 30000;
 
-
-StringPool::StringPool() noexcept  : lastGarbageCollectionTime (0) {}
-
 struct StartEndString
 {
     StartEndString (String::CharPointerType s, String::CharPointerType e) noexcept : start (s), end (e) {}
@@ -69,44 +66,231 @@ static int compareStrings (const StartEndString& string1, const String& string2)
     return 0;
 }
 
-template <typename NewStringType>
-static String addPooledString (Array<String>& strings, const NewStringType& newString)
+// 32-bit FNV-1a, applied to the code-points rather than the bytes so that
+// all the string types give the same result
+static constexpr uint32 fnvOffsetBasis = 2166136261u, fnvPrime = 16777619u;
+
+template <typename CharPointerType>
+static uint32 hashCharacters (CharPointerType text) noexcept
+{
+    auto hash = fnvOffsetBasis;
+
+    while (auto c = text.getAndAdvance())
+        hash = (hash ^ (uint32) c) * fnvPrime;
+
+    return hash;
+}
+
+//==============================================================================
+struct StringPool::Entry
+{
+    String text;
+    uint32 hash;
+    bool removed = false;
+};
+
+// An open-addressed table of entries. Once a slot has been filled it never changes,
+// so readers can probe it without locking while the writer adds to other slots.
+struct StringPool::Table
+{
+    explicit Table (uint32 numSlots)
+        : slots (new std::atomic<Entry*>[numSlots]), mask (numSlots - 1)
+    {
+        jassert (isPowerOfTwo (numSlots));
+
+        for (uint32 i = 0; i < numSlots; ++i)
+            slots[i].store (nullptr, std::memory_order_relaxed);
+    }
+
+    template <typename NewStringType>
+    Entry* find (const NewStringType& text, uint32 hash) const noexcept
+    {
+        for (auto i = hash & mask;; i = (i + 1) & mask)
+        {
+            auto* e = slots[i].load (std::memory_order_acquire);
+
+            if (e == nullptr)
+                return nullptr;
+
+            if (e->hash == hash && compareStrings (text, e->text) == 0)
+                return e;
+        }
+    }
+
+    void insert (Entry* e) noexcept
+    {
+        jassert ((int) (mask + 1) > numUsed * 2);
+
+        auto i = e->hash & mask;
+
+        while (slots[i].load (std::memory_order_relaxed) != nullptr)
+            i = (i + 1) & mask;
+
+        slots[i].store (e, std::memory_order_release);
+        ++numUsed;
+    }
+
+    bool hasSpaceFor (int numEntries) const noexcept     { return numEntries * 2 < (int) (mask + 1); }
+
+    std::unique_ptr<std::atomic<Entry*>[]> slots;
+    const uint32 mask;
+    int numUsed = 0;
+
+    JUCE_DECLARE_NON_COPYABLE (Table)
+};
+
+//==============================================================================
+StringPool::StringPool() noexcept  : lastGarbageCollectionTime (0) {}
+
+StringPool::~StringPool()
 {
-    int start = 0;
-    int end = strings.size();
+    jassert (numActiveReaders[0].load() == 0 && numActiveReaders[1].load() == 0);
+    delete table.exchange (nullptr);
+}
+
+uint32 StringPool::getHash (StringRef text) noexcept
+{
+    return hashCharacters (text.text);
+}
+
+uint32 StringPool::getHash (String::CharPointerType start, String::CharPointerType end) noexcept
+{
+    auto hash = fnvOffsetBasis;
 
     while (start < end)
+        hash = (hash ^ (uint32) start.getAndAdvance()) * fnvPrime;
+
+    return hash;
+}
+
+template <typename NewStringType>
+String StringPool::findOrAddString (const NewStringType& newString, uint32 hash)
+{
     {
-        const String& startString = strings.getReference (start);
-        const int startComp = compareStrings (newString, startString);
+        // This counter tells the writer that someone might still be looking at an
+        // old table or a removed entry, so they mustn't be deleted yet
+        auto& readers = numActiveReaders[epoch.load() & 1];
+        ++readers;
 
-        if (startComp == 0)
-            return startString;
+        String result;
 
-        const int halfway = (start + end) / 2;
+        if (auto* t = table.load())
+            if (auto* e = t->find (newString, hash))
+                result = e->text;
 
-        if (halfway == start)
-        {
-            if (startComp > 0)
-                ++start;
+        --readers;
+
+        if (result.isNotEmpty())
+            return result;
+    }
+
+    const ScopedLock sl (lock);
+    releaseRetiredObjectsIfPossible();
+    garbageCollectIfNeeded();
+
+    auto* t = table.load();
+
+    if (t != nullptr)
+        if (auto* e = t->find (newString, hash))
+            return e->text;
+
+    const String text (newString);
+
+    // If this string was recently garbage-collected, a lookup may already have picked up
+    // the old copy, so that has to be used rather than a new one.
+    if (auto* e = reviveRemovedEntry (text, hash))
+        return e->text;
 
-            break;
+    t = getOrCreateTable ((int) entries.size() + 1);
+    entries.push_back (std::make_unique<Entry> (Entry { text, hash }));
+    t->insert (entries.back().get());
+    return entries.back()->text;
+}
+
+StringPool::Entry* StringPool::reviveRemovedEntry (const String& text, uint32 hash)
+{
+    // A removed entry is still in the table that was retired when it was removed
+    for (auto* batch : { &retired, &awaitingRelease })
+    {
+        for (auto& t : batch->tables)
+        {
+            auto* e = t->find (text, hash);
+
+            if (e == nullptr || ! e->removed)
+                continue;
+
+            for (auto* list : { &retired.entries, &awaitingRelease.entries })
+            {
+                auto i = std::find_if (list->begin(), list->end(), [e] (auto& r) { return r.get() == e; });
+
+                if (i != list->end())
+                {
+                    e->removed = false;
+                    entries.push_back (std::move (*i));
+                    list->erase (i);
+                    getOrCreateTable ((int) entries.size())->insert (e);
+                    return e;
+                }
+            }
+
+            jassertfalse;
         }
+    }
 
-        const String& halfwayString = strings.getReference (halfway);
-        const int halfwayComp = compareStrings (newString, halfwayString);
+    return nullptr;
+}
 
-        if (halfwayComp == 0)
-            return halfwayString;
+StringPool::Table* StringPool::getOrCreateTable (int minNumEntries)
+{
+    auto* oldTable = table.load();
 
-        if (halfwayComp > 0)
-            start = halfway;
-        else
-            end = halfway;
+    if (oldTable != nullptr && oldTable->hasSpaceFor (minNumEntries))
+        return oldTable;
+
+    auto* newTable = new Table ((uint32) nextPowerOfTwo (jmax (64, minNumEntries * 4)));
+
+    for (auto& e : entries)
+        newTable->insert (e.get());
+
+    table.store (newTable);
+
+    if (oldTable != nullptr)
+        retired.tables.emplace_back (oldTable);
+
+    releaseRetiredObjectsIfPossible();
+    return newTable;
+}
+
+void StringPool::releaseRetiredObjectsIfPossible()
+{
+    // Lookups that registered in the previous epoch's slot may still be using the things
+    // that were retired before the current epoch began. No new lookups join that slot, so
+    // once it has emptied, those things can go. Starting a new epoch then separates the
+    // lookups that might be using what's been retired since from the ones that can't be.
+    if (numActiveReaders[(epoch.load() + 1) & 1].load() != 0)
+        return;
+
+    auto released = std::exchange (awaitingRelease, {});
+
+    if (! retired.tables.empty() || ! retired.entries.empty())
+    {
+        std::swap (awaitingRelease, retired);
+        ++epoch;
     }
 
-    strings.insert (start, newString);
-    return strings.getReference (start);
+    released.tables.clear();
+
+    // A lookup may have taken a reference to a removed string before it finished, in
+    // which case it has to go back in the table.
+    for (auto& e : released.entries)
+    {
+        if (e->text.getReferenceCount() > 1)
+        {
+            e->removed = false;
+            entries.push_back (std::move (e));
+            getOrCreateTable ((int) entries.size())->insert (entries.back().get());
+        }
+    }
 }
 
 String StringPool::getPooledString (const char* const newString)
@@ -114,9 +298,7 @@ String StringPool::getPooledString (const char* const newString)
     if (newString == nullptr || *newString == 0)
         return {};
 
-    const ScopedLock sl (lock);
-    garbageCollectIfNeeded();
-    return addPooledString (strings, CharPointer_UTF8 (newString));
+    return getPooledString (CharPointer_UTF8 (newString), hashCharacters (CharPointer_UTF8 (newString)));
 }
 
 String StringPool::getPooledString (String::CharPointerType start, String::CharPointerType end)
@@ -124,9 +306,7 @@ String StringPool::getPooledString (String::CharPointerType start, String::CharP
     if (start.isEmpty() || start == end)
         return {};
 
-    const ScopedLock sl (lock);
-    garbageCollectIfNeeded();
-    return addPooledString (strings, StartEndString (start, end));
+    return getPooledString (start, end, getHash (start, end));
 }
 
 String StringPool::getPooledString (StringRef newString)
@@ -134,9 +314,7 @@ String StringPool::getPooledString (StringRef newString)
     if (newString.isEmpty())
         return {};
 
-    const ScopedLock sl (lock);
-    garbageCollectIfNeeded();
-    return addPooledString (strings, newString.text);
+    return findOrAddString (newString.text, getHash (newString));
 }
 
 String StringPool::getPooledString (const String& newString)
@@ -144,14 +322,27 @@ String StringPool::getPooledString (const String& newString)
     if (newString.isEmpty())
         return {};
 
-    const ScopedLock sl (lock);
-    garbageCollectIfNeeded();
-    return addPooledString (strings, newString);
+    return getPooledString (newString, getHash (newString));
+}
+
+String StringPool::getPooledString (const String& newString, uint32 hash)
+{
+    return findOrAddString (newString, hash);
+}
+
+String StringPool::getPooledString (CharPointer_UTF8 newString, uint32 hash)
+{
+    return findOrAddString (newString, hash);
+}
+
+String StringPool::getPooledString (String::CharPointerType start, String::CharPointerType end, uint32 hash)
+{
+    return findOrAddString (StartEndString (start, end), hash);
 }
 
 void StringPool::garbageCollectIfNeeded()
 {
-    if (strings.size() > minNumberOfStringsForGarbageCollection
+    if (entries.size() > (size_t) minNumberOfStringsForGarbageCollection
          && Time::getApproximateMillisecondCounter() > lastGarbageCollectionTime + garbageCollectionInterval)
         garbageCollect();
 }
@@ -160,11 +351,37 @@ void StringPool::garbageCollect()
 {
     const ScopedLock sl (lock);
 
-    for (int i = strings.size(); --i >= 0;)
-        if (strings.getReference (i).getReferenceCount() == 1)
-            strings.remove (i);
-
     lastGarbageCollectionTime = Time::getApproximateMillisecondCounter();
+
+    const auto isUnused = [] (const std::unique_ptr<Entry>& e) { return e->text.getReferenceCount() == 1; };
+
+    if (std::none_of (entries.begin(), entries.end(), isUnused))
+        return;
+
+    // Publish a table without the unused strings, and retire the old table along with
+    // those strings. Lookups that started before this may have found one of them in the
+    // old table, so they're only deleted once all those lookups have finished.
+    auto* newTable = new Table ((uint32) nextPowerOfTwo (jmax (64, (int) entries.size() * 4)));
+
+    for (auto& e : entries)
+    {
+        if (isUnused (e))
+        {
+            e->removed = true;
+            retired.entries.push_back (std::move (e));
+        }
+        else
+        {
+            newTable->insert (e.get());
+        }
+    }
+
+    entries.erase (std::remove (entries.begin(), entries.end(), nullptr), entries.end());
+
+    if (auto* oldTable = table.exchange (newTable))
+        retired.tables.emplace_back (oldTable);
+
+    releaseRetiredObjectsIfPossible();
 }
 
 StringPool& StringPool::getGlobalPool() noexcept
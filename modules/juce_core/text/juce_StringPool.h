@@ -46,6 +46,12 @@ namespace juce
     compare two pooled strings for equality, as you can simply compare their pointers. It
     also cuts down on storage if you're using many copies of the same string.
 
+    The strings are kept in a hash table. Looking up a string that is already in the
+    pool doesn't take any locks, so many threads can do it at once; only adding a new
+    string or garbage-collecting has to lock the pool, and neither of those waits for
+    lookups on other threads to finish. Strings removed by garbage-collection are only
+    deleted after every lookup that might have seen them has finished.
+
     @tags{Core}
 */
 class JUCE_API  StringPool
@@ -55,6 +61,9 @@ public:
     /** Creates an empty pool. */
     StringPool() noexcept;
 
+    /** Destructor. */
+    ~StringPool();
+
     //==============================================================================
     /** Returns a pointer to a shared copy of the string that is passed in.
         The pool will always return the same String object when asked for a string that matches it.
@@ -86,13 +95,52 @@ public:
     /** Returns a shared global pool which is used for things like Identifiers, XML parsing. */
     static StringPool& getGlobalPool() noexcept;
 
+    /** Returns the hash that the pool uses for a string.
+        This is computed from the string's unicode code-points, so the result doesn't depend
+        on the encoding of the string that's passed in.
+    */
+    static uint32 getHash (StringRef text) noexcept;
+
 private:
-    Array<String> strings;
-    CriticalSection lock;
-    uint32 lastGarbageCollectionTime;
+    //==============================================================================
+    struct Entry;
+    struct Table;
+
+    friend class Identifier;
 
+    String getPooledString (const String&, uint32 hash);
+    String getPooledString (CharPointer_UTF8, uint32 hash);
+    String getPooledString (String::CharPointerType start, String::CharPointerType end, uint32 hash);
+    static uint32 getHash (String::CharPointerType start, String::CharPointerType end) noexcept;
+
+    template <typename NewStringType>
+    String findOrAddString (const NewStringType&, uint32 hash);
+
+    // Tables and strings that lookups might still be using when they're replaced
+    struct Retired
+    {
+        std::vector<std::unique_ptr<Table>> tables;
+        std::vector<std::unique_ptr<Entry>> entries;
+    };
+
+    Table* getOrCreateTable (int minNumEntries);
+    Entry* reviveRemovedEntry (const String& text, uint32 hash);
+    void releaseRetiredObjectsIfPossible();
     void garbageCollectIfNeeded();
 
+    std::atomic<Table*> table { nullptr };
+
+    // Lookups register in the counter chosen by the current epoch. Only the lookups that
+    // started before something was retired can be using it, and they're all counted in one
+    // slot, while the ones that started later use the other.
+    std::atomic<uint32> epoch { 0 };
+    mutable std::atomic<int> numActiveReaders[2] {};
+
+    std::vector<std::unique_ptr<Entry>> entries;
+    Retired retired, awaitingRelease;
+    CriticalSection lock;
+    uint32 lastGarbageCollectionTime;
+
     JUCE_DECLARE_NON_COPYABLE (StringPool)
 };
 
@@ -206,7 +206,15 @@ void UnitTestRunner::runTests (const Array<UnitTest*>& tests, int64 randomSeed)
 
 void UnitTestRunner::runAllTests (int64 randomSeed)
 {
-    runTests (UnitTest::getAllTests(), randomSeed);
+    auto tests = UnitTest::getAllTests();
+
+   #if JUCE_UNIT_TESTS
+    // Benchmarks are slow and their timings depend on the machine, so they only run when
+    // they're asked for by category or by name
+    tests.removeIf ([] (UnitTest* test) { return test->getCategory() == UnitTestCategories::benchmarks; });
+   #endif
+
+    runTests (tests, randomSeed);
 }
 
 void UnitTestRunner::runTestsInCategory (const String& category, int64 randomSeed)
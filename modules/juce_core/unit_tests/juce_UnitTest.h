@@ -407,7 +407,9 @@ public:
     void runTests (const Array<UnitTest*>& tests, int64 randomSeed = 0);
 
     /** Runs all the UnitTest objects that currently exist.
-        This calls runTests() for all the objects listed in UnitTest::getAllTests().
+        This calls runTests() for all the objects listed in UnitTest::getAllTests(), apart
+        from those in the UnitTestCategories::benchmarks category. To run the benchmarks,
+        use runTestsInCategory() or runTestsWithName().
 
         If you want to run the tests with a predetermined seed, you can pass that into
         the randomSeed argument, or pass 0 to have a randomly-generated seed chosen.
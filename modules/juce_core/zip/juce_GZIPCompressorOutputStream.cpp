@@ -216,11 +216,171 @@ struct GZIPTests final : public UnitTest
                                 original.getData(),
                                 original.getDataSize()) == 0);
         }
+
+        beginTest ("Compressible data");
+
+        for (int i = 20; --i >= 0;)
+        {
+            const auto original = createCompressibleData (rng, rng.nextInt (200000));
+            MemoryOutputStream compressed, uncompressed;
+
+            {
+                GZIPCompressorOutputStream zipper (compressed, rng.nextInt (10));
+                zipper << original;
+            }
+
+            {
+                MemoryInputStream compressedInput (compressed.getData(), compressed.getDataSize(), false);
+                GZIPDecompressorInputStream unzipper (compressedInput);
+                uncompressed << unzipper;
+            }
+
+            expect (uncompressed.getMemoryBlock() == original);
+        }
+
+        beginTest ("Checksums");
+
+        for (int i = 200; --i >= 0;)
+        {
+            const auto size = i < 10 ? rng.nextInt (300000) : rng.nextInt (5000);
+            const auto offset = rng.nextInt (16);
+            MemoryBlock data ((size_t) (size + offset));
+            rng.fillBitsRandomly (data.getData(), data.getSize());
+
+            const auto* bytes = static_cast<const uint8*> (data.getData()) + offset;
+            const auto crcStart = (uint32) rng.nextInt();
+            const auto adlerStart = (uint32) (rng.nextInt (65521) | (rng.nextInt (65521) << 16));
+
+            expectEquals ((int64) zlibNamespace::crc32 (crcStart, bytes, (unsigned int) size),
+                          (int64) referenceCrc32 (crcStart, bytes, size));
+            expectEquals ((int64) zlibNamespace::adler32 (adlerStart, bytes, (unsigned int) size),
+                          (int64) referenceAdler32 (adlerStart, bytes, size));
+        }
+    }
+
+    // Makes some text-like data with plenty of repeats at different distances
+    static MemoryBlock createCompressibleData (Random& rng, int size)
+    {
+        static const char* const words[] = { "the ", "quick ", "brown ", "fox ", "jumps ", "over ", "lazy ", "dog ",
+                                             "and ", "then ", "runs ", "away ", "\n", "12345 ", "JUCE ", "zlib " };
+        MemoryOutputStream out;
+
+        while ((int) out.getDataSize() < size)
+            out << words[rng.nextInt (numElementsInArray (words))];
+
+        auto block = out.getMemoryBlock();
+        block.setSize ((size_t) size);
+        return block;
+    }
+
+    static uint32 referenceCrc32 (uint32 crc, const uint8* data, int size)
+    {
+        crc = ~crc;
+
+        for (int i = 0; i < size; ++i)
+        {
+            crc ^= data[i];
+
+            for (int bit = 0; bit < 8; ++bit)
+                crc = (crc >> 1) ^ ((crc & 1) != 0 ? 0xedb88320 : 0);
+        }
+
+        return ~crc;
+    }
+
+    static uint32 referenceAdler32 (uint32 adler, const uint8* data, int size)
+    {
+        uint32 s1 = adler & 0xffff, s2 = adler >> 16;
+
+        for (int i = 0; i < size; ++i)
+        {
+            s1 = (s1 + data[i]) % 65521;
+            s2 = (s2 + s1) % 65521;
+        }
+
+        return s1 | (s2 << 16);
     }
 };
 
 static GZIPTests gzipTests;
 
+//==============================================================================
+class GZIPBenchmarks final : public UnitTest
+{
+public:
+    GZIPBenchmarks()  : UnitTest ("GZIP benchmarks", UnitTestCategories::benchmarks)  {}
+
+    void runTest() override
+    {
+        beginTest ("Checksums and streams");
+
+        auto rng = getRandom();
+        MemoryBlock randomData ((size_t) dataSize);
+        rng.fillBitsRandomly (randomData.getData(), randomData.getSize());
+
+        const auto* bytes = static_cast<const uint8*> (randomData.getData());
+        uint32 result = 0;
+
+        logMessage ("crc32: "   + time ([&] { result += (uint32) zlibNamespace::crc32 (0, bytes, (unsigned int) dataSize); }));
+        logMessage ("adler32: " + time ([&] { result += (uint32) zlibNamespace::adler32 (1, bytes, (unsigned int) dataSize); }));
+        expect (result != 0);
+
+        const auto text = GZIPTests::createCompressibleData (rng, dataSize);
+        MemoryOutputStream compressed;
+
+        logMessage ("GZIPCompressorOutputStream: " + time ([&]
+        {
+            GZIPCompressorOutputStream zipper (compressed, 6);
+            zipper << text;
+        }));
+
+        MemoryOutputStream uncompressed;
+
+        logMessage ("GZIPDecompressorInputStream: " + time ([&]
+        {
+            MemoryInputStream in (compressed.getData(), compressed.getDataSize(), false);
+            GZIPDecompressorInputStream unzipper (in);
+            uncompressed << unzipper;
+        }));
+
+        expect (uncompressed.getMemoryBlock() == text);
+
+        MemoryOutputStream zipData;
+
+        {
+            ZipFile::Builder builder;
+
+            for (int i = 0; i < 16; ++i)
+                builder.addEntry (std::make_unique<MemoryInputStream> (static_cast<const char*> (text.getData()) + i * (dataSize / 16),
+                                                                       (size_t) (dataSize / 16), false),
+                                  6, "entry" + String (i), Time());
+
+            builder.writeToStream (zipData, nullptr);
+        }
+
+        TemporaryFile dir;
+        MemoryInputStream zipInput (zipData.getData(), zipData.getDataSize(), false);
+        ZipFile zip (zipInput);
+
+        logMessage ("ZipFile::uncompressTo: " + time ([&] { expect (zip.uncompressTo (dir.getFile()).wasOk()); }));
+    }
+
+private:
+    static constexpr int dataSize = 32 * 1024 * 1024;
+
+    template <typename Fn>
+    static String time (Fn&& fn)
+    {
+        const auto start = Time::getMillisecondCounterHiRes();
+        fn();
+        const auto elapsed = Time::getMillisecondCounterHiRes() - start;
+
+        return String (elapsed, 1) + " ms (" + String (roundToInt (dataSize / (1024.0 * 1024.0) / (elapsed / 1000.0))) + " MB/s)";
+    }
+};
+
+static GZIPBenchmarks gzipBenchmarks;
+
 #endif
 
 } // namespace juce
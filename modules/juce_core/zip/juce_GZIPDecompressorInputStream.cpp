@@ -32,6 +32,26 @@
   ==============================================================================
 */
 
+#if JUCE_INCLUDE_ZLIB_CODE && JUCE_USE_ACCELERATED_ZLIB
+ #if JUCE_INTEL && (defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2))
+  #define JUCE_ZLIB_USE_SSE2 1
+  #if JUCE_MSVC
+   #include <intrin.h>
+  #else
+   #include <emmintrin.h>
+   #include <wmmintrin.h>
+   #include <cpuid.h>
+  #endif
+ #elif JUCE_ARM && (defined (__ARM_NEON) || defined (__ARM_NEON__) || defined (_M_ARM64)) && ! JUCE_32BIT
+  #define JUCE_ZLIB_USE_NEON 1
+  #if JUCE_MSVC
+   #include <arm64_neon.h>
+  #else
+   #include <arm_neon.h>
+  #endif
+ #endif
+#endif
+
 namespace juce
 {
 
@@ -69,6 +89,8 @@ namespace zlibNamespace
   #undef fdopen
   #define ZLIB_INTERNAL
   #define NO_DUMMY_DECL
+  #include "zlib/zutil.h"
+  #include "juce_zlib_acceleration.h"
   #include "zlib/adler32.c"
   #include "zlib/compress.c"
   #undef DO1
@@ -0,0 +1,844 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+// Finds the matches for LZ4 blocks, using a hash table of the positions where each
+// five-byte sequence was last seen. Above level 1, each position is also linked back
+// to the previous one with the same hash, so that more candidates can be tried.
+//
+// Positions are offsets into the caller's buffer, which holds some history followed
+// by the block to compress. When the caller discards the start of the buffer, it calls
+// discardHistory() so that the positions can be adjusted and kept for the next block.
+class LZ4BlockCompressor
+{
+public:
+    explicit LZ4BlockCompressor (int level)
+        : maxAttempts (level <= 1 ? 1 : 1 << jmin (level - 1, 11)),
+          hashBits (level <= 1 ? 12 : 15),
+          head ((size_t) 1 << hashBits, -1),
+          chain (maxAttempts > 1 ? (size_t) LZ4Helpers::historySize : 0)
+    {
+    }
+
+    static int getMaxCompressedSize (int numBytes) noexcept     { return numBytes + numBytes / 255 + 32; }
+
+    // Compresses the block that follows historyLength bytes of history at the start of
+    // data. The result can be bigger than the original, if it doesn't compress.
+    int compress (const uint8* data, int historyLength, int blockLength, uint8* dest) noexcept
+    {
+        using namespace LZ4Helpers;
+
+        const auto end = historyLength + blockLength;
+        const auto matchLimit = end - numLastLiterals;
+        const auto lastMatchStart = end - minMatchStartFromEnd;
+
+        for (; indexedUpTo < historyLength && indexedUpTo + minMatch < end; ++indexedUpTo)
+            insert (data, indexedUpTo);
+
+        auto* op = dest;
+        auto pos = historyLength, anchor = pos, numMisses = 0;
+
+        while (pos <= lastMatchStart)
+        {
+            int matchPos = 0;
+            const auto candidate = insert (data, pos);
+            auto matchLength = findMatch (data, pos, candidate, matchLimit, matchPos);
+
+            if (matchLength == 0)
+            {
+                // At level 1, move faster through data that isn't compressing
+                pos += maxAttempts == 1 ? 1 + (numMisses++ >> 6) : 1;
+                continue;
+            }
+
+            numMisses = 0;
+            const auto matchStart = pos, matchEnd = pos + matchLength;
+
+            while (pos > anchor && matchPos > 0 && data[pos - 1] == data[matchPos - 1])
+            {
+                --pos;
+                --matchPos;
+                ++matchLength;
+            }
+
+            op = writeSequence (op, data + anchor, pos - anchor, pos - matchPos, matchLength);
+
+            if (maxAttempts > 1)
+            {
+                for (auto i = matchStart + 1; i < matchEnd; ++i)
+                    insert (data, i);
+            }
+            else
+            {
+                insert (data, matchEnd - 2);
+            }
+
+            pos = anchor = indexedUpTo = matchEnd;
+        }
+
+        indexedUpTo = jmax (indexedUpTo, jmin (pos, end));
+        return (int) (writeLiterals (op, data + anchor, end - anchor) - dest);
+    }
+
+    void discardHistory (int numBytes) noexcept
+    {
+        for (auto& position : head)
+            position = position >= numBytes ? position - numBytes : -1;
+
+        positionOffset += (uint32) numBytes;
+        indexedUpTo = jmax (0, indexedUpTo - numBytes);
+    }
+
+private:
+    uint32 hash (const uint8* p) const noexcept
+    {
+        const auto sequence = (uint64) LZ4Helpers::read32 (p) | ((uint64) p[4] << 32);
+        return (uint32) ((sequence * 889523592379ull) >> (64 - hashBits));
+    }
+
+    // Adds a position to the table, returning the previous one with the same hash
+    int insert (const uint8* data, int pos) noexcept
+    {
+        auto& entry = head[hash (data + pos)];
+        const auto previous = entry;
+
+        if (! chain.empty())
+        {
+            const auto distance = pos - previous;
+            chain[((uint32) pos + positionOffset) & 0xffff] = (uint16) (previous >= 0 && distance <= LZ4Helpers::maxMatchDistance ? distance : 0);
+        }
+
+        entry = pos;
+        return previous;
+    }
+
+    int findMatch (const uint8* data, int pos, int candidate, int matchLimit, int& matchPos) const noexcept
+    {
+        using namespace LZ4Helpers;
+
+        const auto sequence = read32 (data + pos);
+        auto bestLength = 0;
+
+        for (auto attempts = maxAttempts; candidate >= 0 && pos - candidate <= maxMatchDistance;)
+        {
+            if (read32 (data + candidate) == sequence)
+            {
+                const auto length = minMatch + countMatchingBytes (data + candidate + minMatch, data + pos + minMatch, data + matchLimit);
+
+                if (length > bestLength)
+                {
+                    bestLength = length;
+                    matchPos = candidate;
+
+                    if (pos + length >= matchLimit)
+                        break;
+                }
+            }
+
+            if (--attempts == 0)
+                break;
+
+            const auto distance = chain[((uint32) candidate + positionOffset) & 0xffff];
+
+            if (distance == 0)
+                break;
+
+            candidate -= distance;
+        }
+
+        return bestLength;
+    }
+
+    static int countMatchingBytes (const uint8* earlier, const uint8* p, const uint8* limit) noexcept
+    {
+        const auto* start = p;
+
+        while (p + 8 <= limit)
+        {
+            uint64 a, b;
+            memcpy (&a, earlier, 8);
+            memcpy (&b, p, 8);
+
+            if (a != b)
+                break;
+
+            earlier += 8;
+            p += 8;
+        }
+
+        while (p < limit && *earlier == *p)
+        {
+            ++earlier;
+            ++p;
+        }
+
+        return (int) (p - start);
+    }
+
+    static uint8* writeLength (uint8* op, int length) noexcept
+    {
+        if (length >= 15)
+        {
+            for (length -= 15; length >= 255; length -= 255)
+                *op++ = 255;
+
+            *op++ = (uint8) length;
+        }
+
+        return op;
+    }
+
+    static uint8* writeSequence (uint8* op, const uint8* literals, int numLiterals, int offset, int matchLength) noexcept
+    {
+        const auto encodedMatchLength = matchLength - LZ4Helpers::minMatch;
+        *op++ = (uint8) ((jmin (numLiterals, 15) << 4) | jmin (encodedMatchLength, 15));
+
+        op = writeLength (op, numLiterals);
+
+        // These literals come before a match, so there's always data to read past the end
+        // of them, and room in the output for the extra bytes
+        const auto literalsEnd = op + numLiterals;
+
+        for (; op < literalsEnd; op += 8, literals += 8)
+            memcpy (op, literals, 8);
+
+        op = literalsEnd;
+        *op++ = (uint8) offset;
+        *op++ = (uint8) (offset >> 8);
+        return writeLength (op, encodedMatchLength);
+    }
+
+    static uint8* writeLiterals (uint8* op, const uint8* literals, int numLiterals) noexcept
+    {
+        *op++ = (uint8) (jmin (numLiterals, 15) << 4);
+        op = writeLength (op, numLiterals);
+        memcpy (op, literals, (size_t) numLiterals);
+        return op + numLiterals;
+    }
+
+    const int maxAttempts;
+    const int hashBits;
+    std::vector<int> head;
+    std::vector<uint16> chain;
+    uint32 positionOffset = 0;
+    int indexedUpTo = 0;
+
+    JUCE_DECLARE_NON_COPYABLE (LZ4BlockCompressor)
+};
+
+//==============================================================================
+class LZ4CompressorOutputStream::LZ4CompressorHelper
+{
+public:
+    explicit LZ4CompressorHelper (const Options& o)
+        : options (o),
+          pool (o.getThreadPool()),
+          blockSize (LZ4Helpers::getBlockSizeForID ((int) o.getBlockSize())),
+          dictionaryLength ((int) jmin ((size_t) LZ4Helpers::historySize, o.getDictionary().getSize()))
+    {
+        buffer.malloc ((size_t) (LZ4Helpers::historySize + blockSize));
+
+        // The end of the dictionary is the history for the first block, or for every
+        // block if they're independent
+        const auto& dictionary = options.getDictionary();
+        memcpy (buffer, static_cast<const uint8*> (dictionary.getData()) + dictionary.getSize() - (size_t) dictionaryLength,
+                (size_t) dictionaryLength);
+        historyLength = dictionaryLength;
+
+        if (pool != nullptr)
+        {
+            maxJobsInFlight = jmax (2, pool->getNumThreads() * 2);
+        }
+        else
+        {
+            compressor = std::make_unique<LZ4BlockCompressor> (options.getCompressionLevel());
+            compressed.malloc ((size_t) LZ4BlockCompressor::getMaxCompressedSize (blockSize));
+        }
+    }
+
+    ~LZ4CompressorHelper()
+    {
+        for (auto& job : jobs)
+            job->finished.wait();
+    }
+
+    bool write (const uint8* data, size_t dataSize, OutputStream& out)
+    {
+        // When the stream has been finished, no more data can be written to it
+        jassert (! finished);
+
+        if (finished || ! writeHeaderIfNeeded (out))
+            return false;
+
+        if (options.getContentChecksum())
+            contentHash.update (data, dataSize);
+
+        while (dataSize > 0)
+        {
+            const auto num = (int) jmin (dataSize, (size_t) (blockSize - blockLength));
+            memcpy (buffer + historyLength + blockLength, data, (size_t) num);
+            blockLength += num;
+            data += num;
+            dataSize -= (size_t) num;
+
+            if (blockLength == blockSize && ! writeBlock (out))
+                return false;
+        }
+
+        return true;
+    }
+
+    bool flush (OutputStream& out)
+    {
+        return writeHeaderIfNeeded (out)
+                && (blockLength == 0 || writeBlock (out))
+                && writeFinishedJobs (out, 0);
+    }
+
+    void finish (OutputStream& out)
+    {
+        if (! finished && flush (out))
+        {
+            finished = true;
+            out.writeInt (0);
+
+            if (options.getContentChecksum())
+                out.writeInt ((int) contentHash.getResult());
+        }
+    }
+
+private:
+    //==============================================================================
+    struct Job
+    {
+        HeapBlock<uint8> data, compressed;
+        int dataLength = 0, compressedSize = 0;
+        WaitableEvent finished { true };
+    };
+
+    bool writeHeaderIfNeeded (OutputStream& out)
+    {
+        using namespace LZ4Helpers;
+
+        if (headerWritten)
+            return true;
+
+        headerWritten = true;
+
+        uint8 descriptor[7];
+        int length = 0;
+
+        descriptor[length++] = (uint8) (flagVersion
+                                         | (pool != nullptr ? flagIndependentBlocks : 0)
+                                         | (options.getContentChecksum() ? flagContentChecksum : 0)
+                                         | (dictionaryLength > 0 ? flagDictionaryID : 0));
+        descriptor[length++] = (uint8) ((int) options.getBlockSize() << 4);
+
+        if (dictionaryLength > 0)
+        {
+            const auto& dictionary = options.getDictionary();
+            const auto dictionaryID = XXHash32::calculate (dictionary.getData(), dictionary.getSize());
+
+            for (int i = 0; i < 4; ++i)
+                descriptor[length++] = (uint8) (dictionaryID >> (8 * i));
+        }
+
+        const auto headerChecksum = (uint8) (XXHash32::calculate (descriptor, (size_t) length) >> 8);
+        descriptor[length++] = headerChecksum;
+
+        return out.writeInt ((int) frameMagic)
+                && out.write (descriptor, (size_t) length);
+    }
+
+    static bool writeCompressedBlock (OutputStream& out, const uint8* original, int originalSize,
+                                      const uint8* compressedData, int compressedSize)
+    {
+        // Blocks that don't get smaller are stored as they are
+        if (compressedSize >= originalSize)
+            return out.writeInt ((int) ((uint32) originalSize | LZ4Helpers::uncompressedBlockFlag))
+                    && out.write (original, (size_t) originalSize);
+
+        return out.writeInt (compressedSize)
+                && out.write (compressedData, (size_t) compressedSize);
+    }
+
+    bool writeBlock (OutputStream& out)
+    {
+        if (pool != nullptr)
+            return startJob (out);
+
+        const auto compressedSize = compressor->compress (buffer, historyLength, blockLength, compressed);
+        const auto ok = writeCompressedBlock (out, buffer + historyLength, blockLength, compressed, compressedSize);
+
+        // Keep the end of this block as the history for the next one
+        const auto total = historyLength + blockLength;
+        const auto numToDiscard = total - jmin (LZ4Helpers::historySize, total);
+
+        if (numToDiscard > 0)
+        {
+            memmove (buffer, buffer + numToDiscard, (size_t) (total - numToDiscard));
+            compressor->discardHistory (numToDiscard);
+        }
+
+        historyLength = total - numToDiscard;
+        blockLength = 0;
+        return ok;
+    }
+
+    bool startJob (OutputStream& out)
+    {
+        auto job = std::make_unique<Job>();
+        job->dataLength = blockLength;
+        job->data.malloc ((size_t) (dictionaryLength + blockLength));
+        job->compressed.malloc ((size_t) LZ4BlockCompressor::getMaxCompressedSize (blockLength));
+        memcpy (job->data, buffer, (size_t) (dictionaryLength + blockLength));
+
+        pool->addJob ([j = job.get(), level = options.getCompressionLevel(), dictSize = dictionaryLength]
+        {
+            LZ4BlockCompressor blockCompressor (level);
+            j->compressedSize = blockCompressor.compress (j->data, dictSize, j->dataLength, j->compressed);
+            j->finished.signal();
+        });
+
+        jobs.push_back (std::move (job));
+        blockLength = 0;
+
+        return writeFinishedJobs (out, maxJobsInFlight);
+    }
+
+    // Writes out the finished blocks in order, waiting until no more than
+    // maxJobsToLeave are still running
+    bool writeFinishedJobs (OutputStream& out, int maxJobsToLeave)
+    {
+        while (! jobs.empty())
+        {
+            auto& job = *jobs.front();
+
+            if ((int) jobs.size() <= maxJobsToLeave && ! job.finished.wait (0))
+                break;
+
+            job.finished.wait();
+
+            const auto ok = writeCompressedBlock (out, job.data + dictionaryLength, job.dataLength,
+                                                  job.compressed, job.compressedSize);
+            jobs.pop_front();
+
+            if (! ok)
+                return false;
+        }
+
+        return true;
+    }
+
+    //==============================================================================
+    const Options options;
+    ThreadPool* const pool;
+    const int blockSize, dictionaryLength;
+
+    HeapBlock<uint8> buffer, compressed;
+    int historyLength = 0, blockLength = 0;
+    std::unique_ptr<LZ4BlockCompressor> compressor;
+
+    std::deque<std::unique_ptr<Job>> jobs;
+    int maxJobsInFlight = 0;
+
+    LZ4Helpers::XXHash32 contentHash;
+    bool headerWritten = false, finished = false;
+
+    JUCE_DECLARE_NON_COPYABLE (LZ4CompressorHelper)
+};
+
+//==============================================================================
+LZ4CompressorOutputStream::LZ4CompressorOutputStream (OutputStream& s, const Options& options)
+   : LZ4CompressorOutputStream (&s, false, options)
+{
+}
+
+LZ4CompressorOutputStream::LZ4CompressorOutputStream (OutputStream* out, bool deleteDestStream, const Options& options)
+   : destStream (out, deleteDestStream),
+     helper (new LZ4CompressorHelper (options))
+{
+    jassert (out != nullptr);
+}
+
+LZ4CompressorOutputStream::~LZ4CompressorOutputStream()
+{
+    helper->finish (*destStream);
+    destStream->flush();
+}
+
+void LZ4CompressorOutputStream::flush()
+{
+    helper->flush (*destStream);
+    destStream->flush();
+}
+
+bool LZ4CompressorOutputStream::write (const void* destBuffer, size_t howMany)
+{
+    jassert (destBuffer != nullptr && (ssize_t) howMany >= 0);
+
+    return helper->write (static_cast<const uint8*> (destBuffer), howMany, *destStream);
+}
+
+int64 LZ4CompressorOutputStream::getPosition()
+{
+    return destStream->getPosition();
+}
+
+bool LZ4CompressorOutputStream::setPosition (int64 /*newPosition*/)
+{
+    jassertfalse; // can't do it!
+    return false;
+}
+
+MemoryBlock LZ4CompressorOutputStream::compress (const void* data, size_t numBytes, const Options& options)
+{
+    MemoryOutputStream out;
+
+    {
+        LZ4CompressorOutputStream lz4 (out, options);
+        lz4.write (data, numBytes);
+    }
+
+    return out.getMemoryBlock();
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct LZ4Tests final : public UnitTest
+{
+    LZ4Tests()
+        : UnitTest ("LZ4", UnitTestCategories::compression)
+    {}
+
+    void runTest() override
+    {
+        auto rng = getRandom();
+
+        beginTest ("Checksums");
+        {
+            expectEquals ((int64) LZ4Helpers::XXHash32::calculate ("", 0), (int64) 0x02cc5d05);
+            expectEquals ((int64) LZ4Helpers::XXHash32::calculate ("abc", 3), (int64) 0x32d153ff);
+
+            const auto data = createRandomData (rng, 1000);
+            LZ4Helpers::XXHash32 hash;
+
+            for (size_t pos = 0; pos < data.getSize();)
+            {
+                const auto num = jmin (data.getSize() - pos, (size_t) rng.nextInt (40));
+                hash.update (static_cast<const char*> (data.getData()) + pos, num);
+                pos += num;
+            }
+
+            expectEquals ((int64) hash.getResult(), (int64) LZ4Helpers::XXHash32::calculate (data.getData(), data.getSize()));
+        }
+
+        beginTest ("Round trip");
+
+        for (int i = 60; --i >= 0;)
+        {
+            const auto original = rng.nextBool() ? GZIPTests::createCompressibleData (rng, rng.nextInt (300000))
+                                                 : createRandomData (rng, rng.nextInt (100000));
+            const auto options = LZ4CompressorOutputStream::Options{}.withCompressionLevel (1 + rng.nextInt (12))
+                                                                     .withBlockSize (rng.nextBool() ? LZ4CompressorOutputStream::BlockSize::kb64
+                                                                                                    : LZ4CompressorOutputStream::BlockSize::kb256)
+                                                                     .withContentChecksum (rng.nextBool());
+            MemoryOutputStream compressed;
+
+            {
+                LZ4CompressorOutputStream lz4 (compressed, options);
+                writeInRandomChunks (lz4, original, rng);
+            }
+
+            expect (LZ4DecompressorInputStream::decompress (compressed.getData(), compressed.getDataSize()) == original);
+        }
+
+        beginTest ("Compression levels");
+        {
+            const auto original = GZIPTests::createCompressibleData (rng, 500000);
+            const auto fast = LZ4CompressorOutputStream::compress (original.getData(), original.getSize());
+            const auto small = LZ4CompressorOutputStream::compress (original.getData(), original.getSize(),
+                                                                    LZ4CompressorOutputStream::Options{}.withCompressionLevel (12));
+
+            expect (fast.getSize() < original.getSize() / 2);
+            expect (small.getSize() < fast.getSize());
+            expect (LZ4DecompressorInputStream::decompress (small.getData(), small.getSize()) == original);
+        }
+
+        beginTest ("Reading and seeking");
+        {
+            const auto original = GZIPTests::createCompressibleData (rng, 200000);
+            const auto compressed = LZ4CompressorOutputStream::compress (original.getData(), original.getSize());
+
+            MemoryInputStream in (compressed, false);
+            LZ4DecompressorInputStream lz4 (in);
+            HeapBlock<char> buffer (original.getSize());
+
+            for (int i = 20; --i >= 0;)
+            {
+                const auto start = rng.nextInt ((int) original.getSize());
+                const auto num = rng.nextInt ((int) original.getSize() - start);
+
+                expect (lz4.setPosition (start));
+                expectEquals (lz4.read (buffer, num), num);
+                expect (memcmp (buffer, static_cast<const char*> (original.getData()) + start, (size_t) num) == 0);
+            }
+
+            expect (lz4.setPosition ((int64) original.getSize()));
+            expect (lz4.isExhausted());
+            expect (! lz4.hasError());
+        }
+
+        beginTest ("Thread pool");
+        {
+            ThreadPool pool (3);
+            const auto original = GZIPTests::createCompressibleData (rng, 3000000);
+
+            for (auto level : { 1, 9 })
+            {
+                const auto options = LZ4CompressorOutputStream::Options{}.withCompressionLevel (level)
+                                                                         .withBlockSize (LZ4CompressorOutputStream::BlockSize::kb256)
+                                                                         .withThreadPool (&pool);
+                MemoryOutputStream compressed;
+
+                {
+                    LZ4CompressorOutputStream lz4 (compressed, options);
+                    writeInRandomChunks (lz4, original, rng);
+                }
+
+                expect (compressed.getDataSize() < original.getSize() / 2);
+                expect (LZ4DecompressorInputStream::decompress (compressed.getData(), compressed.getDataSize()) == original);
+            }
+        }
+
+        beginTest ("Dictionary");
+        {
+            ThreadPool pool (2);
+            const auto dictionary = GZIPTests::createCompressibleData (rng, 100000);
+            const auto message = GZIPTests::createCompressibleData (rng, 300);
+            const auto without = LZ4CompressorOutputStream::compress (message.getData(), message.getSize());
+
+            for (auto* threadPool : { (ThreadPool*) nullptr, &pool })
+            {
+                const auto options = LZ4CompressorOutputStream::Options{}.withDictionary (dictionary)
+                                                                         .withThreadPool (threadPool);
+                const auto withDictionary = LZ4CompressorOutputStream::compress (message.getData(), message.getSize(), options);
+
+                expect (withDictionary.getSize() < without.getSize());
+                expect (LZ4DecompressorInputStream::decompress (withDictionary.getData(), withDictionary.getSize(), dictionary) == message);
+                expect (LZ4DecompressorInputStream::decompress (withDictionary.getData(), withDictionary.getSize()).isEmpty());
+            }
+        }
+
+        beginTest ("Frames from other encoders");
+        {
+            // Made by the reference LZ4 library: one with default settings, and one with
+            // linked blocks, the content size, and block and content checksums
+            const uint8 simpleFrame[] = { 0x04, 0x22, 0x4d, 0x18, 0x60, 0x40, 0x82, 0x1e, 0x00, 0x00, 0x00, 0xff, 0x00, 0x4a, 0x55,
+                                          0x43, 0x45, 0x20, 0x4c, 0x5a, 0x34, 0x20, 0x74, 0x65, 0x73, 0x74, 0x2e, 0x20, 0x0f, 0x00,
+                                          0xff, 0x0b, 0x80, 0x54, 0x68, 0x65, 0x20, 0x65, 0x6e, 0x64, 0x2e, 0x00, 0x00, 0x00, 0x00 };
+
+            const uint8 checkedFrame[] = { 0x04, 0x22, 0x4d, 0x18, 0x7c, 0x40, 0x34, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05,
+                                           0x1e, 0x00, 0x00, 0x00, 0xff, 0x00, 0x4a, 0x55, 0x43, 0x45, 0x20, 0x4c, 0x5a, 0x34, 0x20,
+                                           0x74, 0x65, 0x73, 0x74, 0x2e, 0x20, 0x0f, 0x00, 0xff, 0x0b, 0x80, 0x54, 0x68, 0x65, 0x20,
+                                           0x65, 0x6e, 0x64, 0x2e, 0xc4, 0xcf, 0xb8, 0xcf, 0x00, 0x00, 0x00, 0x00, 0x23, 0x61, 0x2a, 0x3f };
+
+            String expected;
+
+            for (int i = 0; i < 20; ++i)
+                expected << "JUCE LZ4 test. ";
+
+            expected << "The end.";
+
+            expect (LZ4DecompressorInputStream::decompress (simpleFrame, sizeof (simpleFrame)).toString() == expected);
+
+            MemoryInputStream in (checkedFrame, sizeof (checkedFrame), false);
+            LZ4DecompressorInputStream lz4 (in);
+            expect (lz4.readEntireStreamAsString() == expected);
+            expectEquals (lz4.getTotalLength(), (int64) expected.length());
+            expect (! lz4.hasError());
+
+            // Frames that follow each other are read as one stream
+            MemoryOutputStream twoFrames;
+            twoFrames.write (simpleFrame, sizeof (simpleFrame));
+            twoFrames.write (checkedFrame, sizeof (checkedFrame));
+            expect (LZ4DecompressorInputStream::decompress (twoFrames.getData(), twoFrames.getDataSize()).toString() == expected + expected);
+        }
+
+        beginTest ("Corrupt and truncated data");
+        {
+            const auto original = GZIPTests::createCompressibleData (rng, 100000);
+            const auto compressed = LZ4CompressorOutputStream::compress (original.getData(), original.getSize());
+
+            MemoryInputStream truncated (compressed.getData(), compressed.getSize() / 2, false);
+            LZ4DecompressorInputStream lz4 (truncated);
+            MemoryOutputStream out;
+            out << lz4;
+            expect (lz4.hasError());
+
+            for (int i = 200; --i >= 0;)
+            {
+                auto corrupt = compressed;
+                corrupt[rng.nextInt ((int) corrupt.getSize())] ^= (char) (1 + rng.nextInt (255));
+
+                const auto result = LZ4DecompressorInputStream::decompress (corrupt.getData(), corrupt.getSize());
+                expect (result.isEmpty() || result == original);
+            }
+        }
+    }
+
+    static MemoryBlock createRandomData (Random& rng, int size)
+    {
+        MemoryBlock block ((size_t) size);
+        rng.fillBitsRandomly (block.getData(), block.getSize());
+        return block;
+    }
+
+    static void writeInRandomChunks (OutputStream& out, const MemoryBlock& data, Random& rng)
+    {
+        for (size_t pos = 0; pos < data.getSize();)
+        {
+            const auto num = jmin (data.getSize() - pos, (size_t) rng.nextInt (70000) + 1);
+            out.write (static_cast<const char*> (data.getData()) + pos, num);
+            pos += num;
+
+            if (rng.nextInt (10) == 0)
+                out.flush();
+        }
+    }
+};
+
+static LZ4Tests lz4Tests;
+
+//==============================================================================
+class CompressionBenchmarks final : public UnitTest
+{
+public:
+    CompressionBenchmarks()  : UnitTest ("Compression benchmarks", UnitTestCategories::benchmarks)  {}
+
+    void runTest() override
+    {
+        beginTest ("LZ4 and Zstd compared with GZIP");
+
+        auto rng = getRandom();
+        const auto data = GZIPTests::createCompressibleData (rng, dataSize);
+        ThreadPool pool (jmax (2, SystemStats::getNumCpus()));
+
+        for (auto level : { 1, 6, 9 })
+            measure ("GZIP level " + String (level), data,
+                     [level] (OutputStream& out) { return std::make_unique<GZIPCompressorOutputStream> (out, level); },
+                     [] (InputStream& in) { return std::make_unique<GZIPDecompressorInputStream> (in); });
+
+        for (auto level : { 1, 6, 12 })
+            measure ("LZ4 level " + String (level), data,
+                     [level] (OutputStream& out)
+                     {
+                         return std::make_unique<LZ4CompressorOutputStream> (out, LZ4CompressorOutputStream::Options{}.withCompressionLevel (level));
+                     },
+                     [] (InputStream& in) { return std::make_unique<LZ4DecompressorInputStream> (in); });
+
+        measure ("LZ4 level 6, pooled", data,
+                 [&pool] (OutputStream& out)
+                 {
+                     return std::make_unique<LZ4CompressorOutputStream> (out, LZ4CompressorOutputStream::Options{}.withCompressionLevel (6)
+                                                                                                                   .withBlockSize (LZ4CompressorOutputStream::BlockSize::mb1)
+                                                                                                                   .withThreadPool (&pool));
+                 },
+                 [] (InputStream& in) { return std::make_unique<LZ4DecompressorInputStream> (in); });
+
+       #if JUCE_USE_ZSTD
+        for (auto level : { 1, 3, 19 })
+            measure ("Zstd level " + String (level), data,
+                     [level] (OutputStream& out)
+                     {
+                         return std::make_unique<ZstdCompressorOutputStream> (out, ZstdCompressorOutputStream::Options{}.withCompressionLevel (level));
+                     },
+                     [] (InputStream& in) { return std::make_unique<ZstdDecompressorInputStream> (in); });
+
+        measure ("Zstd level 3, threaded", data,
+                 [] (OutputStream& out)
+                 {
+                     return std::make_unique<ZstdCompressorOutputStream> (out, ZstdCompressorOutputStream::Options{}.withNumThreads (SystemStats::getNumCpus()));
+                 },
+                 [] (InputStream& in) { return std::make_unique<ZstdDecompressorInputStream> (in); });
+       #endif
+    }
+
+private:
+    static constexpr int dataSize = 16 * 1024 * 1024;
+
+    template <typename CreateCompressor, typename CreateDecompressor>
+    void measure (const String& format, const MemoryBlock& data, CreateCompressor&& createCompressor, CreateDecompressor&& createDecompressor)
+    {
+        MemoryOutputStream compressed, decompressed;
+
+        const auto compressTime = time ([&]
+        {
+            auto stream = createCompressor (compressed);
+            stream->write (data.getData(), data.getSize());
+        });
+
+        const auto decompressTime = time ([&]
+        {
+            MemoryInputStream in (compressed.getData(), compressed.getDataSize(), false);
+            auto stream = createDecompressor (in);
+            decompressed << *stream;
+        });
+
+        expect (decompressed.getMemoryBlock() == data);
+
+        logMessage (format + ": ratio " + String ((double) data.getSize() / (double) compressed.getDataSize(), 2)
+                      + ", compression " + compressTime + ", decompression " + decompressTime);
+    }
+
+    template <typename Fn>
+    static String time (Fn&& fn)
+    {
+        const auto start = Time::getMillisecondCounterHiRes();
+        fn();
+        const auto elapsed = Time::getMillisecondCounterHiRes() - start;
+
+        return String (roundToInt (dataSize / (1024.0 * 1024.0) / (elapsed / 1000.0))) + " MB/s";
+    }
+};
+
+static CompressionBenchmarks compressionBenchmarks;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,175 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Settings for an LZ4CompressorOutputStream.
+
+    @see LZ4CompressorOutputStream
+
+    @tags{Core}
+*/
+class JUCE_API  LZ4CompressorOptions
+{
+public:
+    /** The block sizes that an LZ4 frame can use. */
+    enum class BlockSize
+    {
+        kb64  = 4,
+        kb256 = 5,
+        mb1   = 6,
+        mb4   = 7
+    };
+
+    /** Sets the compression level, from 1 (the fastest) to 12 (the smallest output).
+        Level 1 is LZ4's usual fast mode; the higher levels search further for matches.
+    */
+    [[nodiscard]] LZ4CompressorOptions withCompressionLevel (int x) const            { return withMember (*this, &LZ4CompressorOptions::compressionLevel, jlimit (1, 12, x)); }
+
+    /** Sets the size of the blocks that the data is compressed in. */
+    [[nodiscard]] LZ4CompressorOptions withBlockSize (BlockSize x) const             { return withMember (*this, &LZ4CompressorOptions::blockSize, x); }
+
+    /** Sets a dictionary: data like that which will be compressed, which helps small
+        amounts of data to compress well. The same dictionary must be given to the
+        LZ4DecompressorInputStream. Only the last 64KB of it is used.
+    */
+    [[nodiscard]] LZ4CompressorOptions withDictionary (const MemoryBlock& x) const   { return withMember (*this, &LZ4CompressorOptions::dictionary, x); }
+
+    /** Sets a ThreadPool to compress blocks on. The pool must outlive the stream. */
+    [[nodiscard]] LZ4CompressorOptions withThreadPool (ThreadPool* x) const          { return withMember (*this, &LZ4CompressorOptions::threadPool, x); }
+
+    /** Sets whether a checksum of all the data is added to the end of the frame. */
+    [[nodiscard]] LZ4CompressorOptions withContentChecksum (bool x) const            { return withMember (*this, &LZ4CompressorOptions::contentChecksum, x); }
+
+    int getCompressionLevel() const noexcept                                         { return compressionLevel; }
+    BlockSize getBlockSize() const noexcept                                          { return blockSize; }
+    const MemoryBlock& getDictionary() const noexcept                                { return dictionary; }
+    ThreadPool* getThreadPool() const noexcept                                       { return threadPool; }
+    bool getContentChecksum() const noexcept                                         { return contentChecksum; }
+
+private:
+    int compressionLevel = 1;
+    BlockSize blockSize = BlockSize::kb64;
+    MemoryBlock dictionary;
+    ThreadPool* threadPool = nullptr;
+    bool contentChecksum = true;
+};
+
+//==============================================================================
+/**
+    A stream which compresses the data written into it using LZ4.
+
+    LZ4 compresses less tightly than zlib, but it's many times faster at both ends,
+    which makes it a good fit for things like cache files, undo histories and data
+    that's sent between processes. The output is a standard LZ4 frame, so it can be
+    read by any other LZ4 implementation, as well as by LZ4DecompressorInputStream.
+
+    The data is compressed in blocks. Unlike a GZIPCompressorOutputStream, calling
+    flush() compresses and writes out whatever has been written so far without ending
+    the frame, so more data can follow; the frame is finished when the stream is deleted.
+
+    If the Options give a ThreadPool, each block is compressed independently by the
+    pool's threads while the stream carries on accepting data. Larger blocks work
+    best for this.
+
+    @code
+    MemoryOutputStream out;
+
+    {
+        LZ4CompressorOutputStream lz4 (out, LZ4CompressorOutputStream::Options{}.withCompressionLevel (6));
+        tree.writeToStream (lz4);
+    }
+    @endcode
+
+    @see LZ4DecompressorInputStream, GZIPCompressorOutputStream
+
+    @tags{Core}
+*/
+class JUCE_API  LZ4CompressorOutputStream  : public OutputStream
+{
+public:
+    //==============================================================================
+    using Options = LZ4CompressorOptions;
+    using BlockSize = LZ4CompressorOptions::BlockSize;
+
+    //==============================================================================
+    /** Creates a compression stream.
+        @param destStream   the stream into which the compressed data will be written
+        @param options      the compression settings to use
+    */
+    explicit LZ4CompressorOutputStream (OutputStream& destStream,
+                                        const Options& options = {});
+
+    /** Creates a compression stream.
+        @param destStream                       the stream into which the compressed data will be written.
+                                                Ownership of this object depends on the value of deleteDestStreamWhenDestroyed
+        @param deleteDestStreamWhenDestroyed    whether or not the LZ4CompressorOutputStream will delete the
+                                                destStream object when it is destroyed
+        @param options                          the compression settings to use
+    */
+    LZ4CompressorOutputStream (OutputStream* destStream,
+                               bool deleteDestStreamWhenDestroyed,
+                               const Options& options = {});
+
+    /** Destructor. This finishes the frame. */
+    ~LZ4CompressorOutputStream() override;
+
+    //==============================================================================
+    /** Compresses and writes out all the data that has been written so far. More data
+        can be written afterwards.
+    */
+    void flush() override;
+
+    int64 getPosition() override;
+    bool setPosition (int64) override;
+    bool write (const void*, size_t) override;
+
+    //==============================================================================
+    /** Compresses a block of data into a single LZ4 frame. */
+    static MemoryBlock compress (const void* data, size_t numBytes, const Options& options = {});
+
+private:
+    //==============================================================================
+    OptionalScopedPointer<OutputStream> destStream;
+
+    class LZ4CompressorHelper;
+    std::unique_ptr<LZ4CompressorHelper> helper;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LZ4CompressorOutputStream)
+};
+
+} // namespace juce
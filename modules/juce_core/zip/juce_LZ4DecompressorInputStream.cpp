@@ -0,0 +1,575 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+// Things that the LZ4 compressor and decompressor have in common
+namespace LZ4Helpers
+{
+    constexpr uint32 frameMagic = 0x184d2204, skippableFrameMagic = 0x184d2a50, skippableFrameMask = 0xfffffff0;
+    constexpr uint32 uncompressedBlockFlag = 0x80000000;
+
+    constexpr int historySize = 65536, maxMatchDistance = 65535;
+    constexpr int minMatch = 4, numLastLiterals = 5, minMatchStartFromEnd = 12;
+
+    enum FrameFlags
+    {
+        flagVersion             = 0x40,
+        flagIndependentBlocks   = 0x20,
+        flagBlockChecksums      = 0x10,
+        flagContentSize         = 0x08,
+        flagContentChecksum     = 0x04,
+        flagReserved            = 0x02,
+        flagDictionaryID        = 0x01
+    };
+
+    static int getBlockSizeForID (int id) noexcept     { return 1 << (8 + 2 * id); }
+    static uint32 read32 (const uint8* p) noexcept     { return ByteOrder::littleEndianInt (p); }
+
+    //==============================================================================
+    // The xxHash32 checksum, which LZ4 frames use for their header, block and content checksums
+    class XXHash32
+    {
+    public:
+        XXHash32() noexcept     { reset(); }
+
+        void reset() noexcept
+        {
+            accumulators[0] = prime1 + prime2;
+            accumulators[1] = prime2;
+            accumulators[2] = 0;
+            accumulators[3] = 0 - prime1;
+            totalLength = 0;
+            numBuffered = 0;
+        }
+
+        void update (const void* data, size_t numBytes) noexcept
+        {
+            auto* p = static_cast<const uint8*> (data);
+            totalLength += numBytes;
+
+            if (numBuffered + numBytes < stripeSize)
+            {
+                memcpy (buffer + numBuffered, p, numBytes);
+                numBuffered += numBytes;
+                return;
+            }
+
+            if (numBuffered > 0)
+            {
+                const auto num = stripeSize - numBuffered;
+                memcpy (buffer + numBuffered, p, num);
+                processStripe (buffer);
+                p += num;
+                numBytes -= num;
+                numBuffered = 0;
+            }
+
+            for (; numBytes >= stripeSize; numBytes -= stripeSize, p += stripeSize)
+                processStripe (p);
+
+            memcpy (buffer, p, numBytes);
+            numBuffered = numBytes;
+        }
+
+        uint32 getResult() const noexcept
+        {
+            auto h = totalLength >= stripeSize ? rotate (accumulators[0], 1) + rotate (accumulators[1], 7)
+                                                  + rotate (accumulators[2], 12) + rotate (accumulators[3], 18)
+                                               : prime5;
+            h += (uint32) totalLength;
+
+            const uint8* p = buffer;
+            auto n = numBuffered;
+
+            for (; n >= 4; n -= 4, p += 4)
+                h = rotate (h + read32 (p) * prime3, 17) * prime4;
+
+            for (; n > 0; --n, ++p)
+                h = rotate (h + *p * prime5, 11) * prime1;
+
+            h ^= h >> 15;
+            h *= prime2;
+            h ^= h >> 13;
+            h *= prime3;
+            h ^= h >> 16;
+            return h;
+        }
+
+        static uint32 calculate (const void* data, size_t numBytes) noexcept
+        {
+            XXHash32 hash;
+            hash.update (data, numBytes);
+            return hash.getResult();
+        }
+
+    private:
+        static constexpr uint32 prime1 = 2654435761u, prime2 = 2246822519u, prime3 = 3266489917u,
+                                prime4 = 668265263u,  prime5 = 374761393u;
+        static constexpr size_t stripeSize = 16;
+
+        static uint32 rotate (uint32 x, int bits) noexcept   { return (x << bits) | (x >> (32 - bits)); }
+
+        void processStripe (const uint8* p) noexcept
+        {
+            for (int i = 0; i < 4; ++i)
+                accumulators[i] = rotate (accumulators[i] + read32 (p + 4 * i) * prime2, 13) * prime1;
+        }
+
+        uint32 accumulators[4];
+        uint64 totalLength;
+        uint8 buffer[stripeSize];
+        size_t numBuffered;
+    };
+
+    //==============================================================================
+    static bool readLength (const uint8*& ip, const uint8* ipEnd, int& length) noexcept
+    {
+        for (;;)
+        {
+            if (ip >= ipEnd || length > (1 << 30))
+                return false;
+
+            const auto b = *ip++;
+            length += b;
+
+            if (b != 255)
+                return true;
+        }
+    }
+
+    // Copies forwards 8 bytes at a time, going past the end when there's room, as most
+    // of the runs of literals and matches are short
+    static inline void copyBytes (uint8* dest, const uint8* src, int numBytes, ptrdiff_t srcSpace, ptrdiff_t destSpace) noexcept
+    {
+        if (numBytes + 8 <= srcSpace && numBytes + 8 <= destSpace)
+        {
+            for (auto* end = dest + numBytes; dest < end; dest += 8, src += 8)
+                memcpy (dest, src, 8);
+        }
+        else
+        {
+            for (; numBytes >= 8; numBytes -= 8, dest += 8, src += 8)
+                memcpy (dest, src, 8);
+
+            while (--numBytes >= 0)
+                *dest++ = *src++;
+        }
+    }
+
+    // Decodes a block into dest, where the historyLength bytes before dest hold the
+    // earlier output that matches can refer to. Returns the number of bytes produced,
+    // or -1 if the block isn't valid.
+    static int decodeBlock (const uint8* src, int srcLength, uint8* dest, int destCapacity, int historyLength) noexcept
+    {
+        const auto* ip = src;
+        const auto* const ipEnd = src + srcLength;
+        auto* op = dest;
+        const auto* const opEnd = dest + destCapacity;
+        const auto* const lowestMatch = dest - historyLength;
+
+        for (;;)
+        {
+            if (ip >= ipEnd)
+                return -1;
+
+            const auto token = *ip++;
+            auto numLiterals = token >> 4;
+
+            if (numLiterals == 15 && ! readLength (ip, ipEnd, numLiterals))
+                return -1;
+
+            if (numLiterals > ipEnd - ip || numLiterals > opEnd - op)
+                return -1;
+
+            copyBytes (op, ip, numLiterals, ipEnd - ip, opEnd - op);
+            op += numLiterals;
+            ip += numLiterals;
+
+            // The last sequence is just literals
+            if (ip == ipEnd)
+                break;
+
+            if (ipEnd - ip < 2)
+                return -1;
+
+            const auto offset = (int) ip[0] | ((int) ip[1] << 8);
+            ip += 2;
+
+            if (offset == 0 || offset > op - lowestMatch)
+                return -1;
+
+            auto matchLength = token & 15;
+
+            if (matchLength == 15 && ! readLength (ip, ipEnd, matchLength))
+                return -1;
+
+            matchLength += minMatch;
+
+            if (matchLength > opEnd - op)
+                return -1;
+
+            const auto* match = op - offset;
+
+            if (offset >= 8)
+            {
+                // Each 8 bytes that are read have already been written
+                copyBytes (op, match, matchLength, opEnd - match, opEnd - op);
+                op += matchLength;
+            }
+            else
+            {
+                // The match overlaps the data it produces, so it has to be copied forwards
+                for (auto* end = op + matchLength; op < end;)
+                    *op++ = *match++;
+            }
+        }
+
+        return (int) (op - dest);
+    }
+}
+
+//==============================================================================
+// Holds the state of the frame that's being decoded
+class LZ4DecompressorInputStream::LZ4DecompressHelper
+{
+public:
+    explicit LZ4DecompressHelper (const MemoryBlock& dict)  : dictionary (dict) {}
+
+    int read (uint8* dest, int numBytes, InputStream& source)
+    {
+        int numRead = 0;
+
+        while (numRead < numBytes)
+        {
+            if (blockPos >= blockLength && ! readNextBlock (source))
+                break;
+
+            const auto num = jmin (numBytes - numRead, blockLength - blockPos);
+            memcpy (dest + numRead, window + blockStart + blockPos, (size_t) num);
+            blockPos += num;
+            numRead += num;
+        }
+
+        return numRead;
+    }
+
+    bool isExhausted (InputStream& source)
+    {
+        return blockPos >= blockLength && ! readNextBlock (source);
+    }
+
+    int64 contentSize = -1;
+    bool error = false;
+
+private:
+    bool fail() noexcept
+    {
+        error = true;
+        return false;
+    }
+
+    static bool readUint32 (InputStream& source, uint32& result)
+    {
+        uint8 bytes[4];
+
+        if (source.read (bytes, 4) != 4)
+            return false;
+
+        result = LZ4Helpers::read32 (bytes);
+        return true;
+    }
+
+    bool readFrameHeader (InputStream& source)
+    {
+        using namespace LZ4Helpers;
+
+        for (;;)
+        {
+            uint32 magic;
+
+            if (! readUint32 (source, magic))
+            {
+                finished = true;
+                return false;
+            }
+
+            if ((magic & skippableFrameMask) == skippableFrameMagic)
+            {
+                uint32 size;
+
+                if (! readUint32 (source, size))
+                    return fail();
+
+                source.skipNextBytes ((int64) size);
+                continue;
+            }
+
+            if (magic != frameMagic)
+                return fail();
+
+            // The descriptor is the flags, the block size, an optional content size
+            // and dictionary ID, and then a checksum of all that
+            uint8 descriptor[14];
+
+            if (source.read (descriptor, 2) != 2)
+                return fail();
+
+            const auto flags = descriptor[0];
+
+            if ((flags & 0xc0) != flagVersion || (flags & flagReserved) != 0 || (descriptor[1] & 0x8f) != 0)
+                return fail();
+
+            const auto length = 2 + ((flags & flagContentSize) != 0 ? 8 : 0) + ((flags & flagDictionaryID) != 0 ? 4 : 0);
+            uint8 headerChecksum;
+
+            if (source.read (descriptor + 2, length - 2) != length - 2
+                 || source.read (&headerChecksum, 1) != 1
+                 || headerChecksum != (uint8) (XXHash32::calculate (descriptor, (size_t) length) >> 8))
+                return fail();
+
+            const auto blockSizeID = descriptor[1] >> 4;
+
+            if (blockSizeID < 4)
+                return fail();
+
+            auto* p = descriptor + 2;
+
+            if ((flags & flagContentSize) != 0)
+            {
+                if (contentSize < 0)
+                    contentSize = (int64) ByteOrder::littleEndianInt64 (p);
+
+                p += 8;
+            }
+
+            if ((flags & flagDictionaryID) != 0
+                 && read32 (p) != XXHash32::calculate (dictionary.getData(), dictionary.getSize()))
+                return fail();
+
+            independentBlocks = (flags & flagIndependentBlocks) != 0;
+            blockChecksums    = (flags & flagBlockChecksums) != 0;
+            contentChecksum   = (flags & flagContentChecksum) != 0;
+
+            const auto newMaxBlockSize = getBlockSizeForID (blockSizeID);
+
+            if (newMaxBlockSize > maxBlockSize)
+            {
+                maxBlockSize = newMaxBlockSize;
+                windowSize = historySize + maxBlockSize + spareWindowSpace;
+                window.malloc ((size_t) windowSize);
+                compressed.malloc ((size_t) maxBlockSize);
+            }
+
+            // The end of the dictionary is the history for the first block, or for every
+            // block if they're independent
+            historyLength = (int) jmin ((size_t) historySize, dictionary.getSize());
+            memcpy (window, static_cast<const uint8*> (dictionary.getData()) + dictionary.getSize() - (size_t) historyLength,
+                    (size_t) historyLength);
+
+            blockStart = historyLength;
+            blockLength = blockPos = 0;
+            contentHash.reset();
+            inFrame = true;
+            return true;
+        }
+    }
+
+    bool readNextBlock (InputStream& source)
+    {
+        using namespace LZ4Helpers;
+
+        while (! (finished || error))
+        {
+            if (! inFrame && ! readFrameHeader (source))
+                return false;
+
+            uint32 blockSizeWord;
+
+            if (! readUint32 (source, blockSizeWord))
+                return fail();
+
+            if (blockSizeWord == 0)
+            {
+                inFrame = false;
+                uint32 checksum;
+
+                if (contentChecksum && (! readUint32 (source, checksum) || checksum != contentHash.getResult()))
+                    return fail();
+
+                continue;
+            }
+
+            const auto isCompressed = (blockSizeWord & uncompressedBlockFlag) == 0;
+            const auto size = (int) (blockSizeWord & ~uncompressedBlockFlag);
+
+            if (size > maxBlockSize)
+                return fail();
+
+            if (! independentBlocks)
+            {
+                // Each block follows on from the previous one, until there's no room left
+                // and the last 64KB has to be moved down to the start of the window
+                historyLength = blockStart + blockLength;
+
+                if (historyLength + maxBlockSize > windowSize)
+                {
+                    memmove (window, window + historyLength - historySize, (size_t) historySize);
+                    historyLength = historySize;
+                }
+            }
+
+            blockStart = historyLength;
+            blockPos = 0;
+
+            auto* blockData = isCompressed ? compressed.get() : window + blockStart;
+
+            if (source.read (blockData, size) != size)
+                return fail();
+
+            uint32 checksum;
+
+            if (blockChecksums && (! readUint32 (source, checksum) || checksum != XXHash32::calculate (blockData, (size_t) size)))
+                return fail();
+
+            blockLength = isCompressed ? decodeBlock (compressed, size, window + blockStart, maxBlockSize, historyLength)
+                                       : size;
+
+            if (blockLength < 0)
+            {
+                blockLength = 0;
+                return fail();
+            }
+
+            if (contentChecksum)
+                contentHash.update (window + blockStart, (size_t) blockLength);
+
+            if (blockLength > 0)
+                return true;
+        }
+
+        return false;
+    }
+
+    const MemoryBlock& dictionary;
+
+    // The window holds the history, followed by the current block
+    static constexpr int spareWindowSpace = 4 * LZ4Helpers::historySize;
+    HeapBlock<uint8> window, compressed;
+    int windowSize = 0, maxBlockSize = 0, historyLength = 0, blockStart = 0, blockLength = 0, blockPos = 0;
+    bool inFrame = false, finished = false;
+    bool independentBlocks = false, blockChecksums = false, contentChecksum = false;
+    LZ4Helpers::XXHash32 contentHash;
+
+    JUCE_DECLARE_NON_COPYABLE (LZ4DecompressHelper)
+};
+
+//==============================================================================
+LZ4DecompressorInputStream::LZ4DecompressorInputStream (InputStream* source, bool deleteSourceWhenDestroyed,
+                                                        const MemoryBlock& dict)
+  : sourceStream (source, deleteSourceWhenDestroyed),
+    dictionary (dict),
+    originalSourcePos (source->getPosition()),
+    helper (new LZ4DecompressHelper (dictionary))
+{
+}
+
+LZ4DecompressorInputStream::LZ4DecompressorInputStream (InputStream& source)
+  : LZ4DecompressorInputStream (&source, false)
+{
+}
+
+LZ4DecompressorInputStream::~LZ4DecompressorInputStream()
+{
+}
+
+bool LZ4DecompressorInputStream::hasError() const noexcept
+{
+    return helper->error;
+}
+
+int64 LZ4DecompressorInputStream::getTotalLength()
+{
+    return helper->contentSize;
+}
+
+int LZ4DecompressorInputStream::read (void* destBuffer, int howMany)
+{
+    jassert (destBuffer != nullptr && howMany >= 0);
+
+    const auto numRead = helper->read (static_cast<uint8*> (destBuffer), howMany, *sourceStream);
+    currentPos += numRead;
+    return numRead;
+}
+
+bool LZ4DecompressorInputStream::isExhausted()
+{
+    return helper->isExhausted (*sourceStream);
+}
+
+int64 LZ4DecompressorInputStream::getPosition()
+{
+    return currentPos;
+}
+
+bool LZ4DecompressorInputStream::setPosition (int64 newPos)
+{
+    if (newPos < currentPos)
+    {
+        // to go backwards, reset the stream and start again
+        currentPos = 0;
+        helper.reset (new LZ4DecompressHelper (dictionary));
+
+        sourceStream->setPosition (originalSourcePos);
+    }
+
+    skipNextBytes (newPos - currentPos);
+    return true;
+}
+
+MemoryBlock LZ4DecompressorInputStream::decompress (const void* data, size_t numBytes, const MemoryBlock& dictionary)
+{
+    MemoryInputStream in (data, numBytes, false);
+    LZ4DecompressorInputStream lz4 (&in, false, dictionary);
+    MemoryOutputStream out;
+    out << lz4;
+
+    if (lz4.hasError())
+        return {};
+
+    return out.getMemoryBlock();
+}
+
+} // namespace juce
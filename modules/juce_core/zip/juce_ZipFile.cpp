@@ -169,6 +169,9 @@ struct ZipFile::ZipInputStream final : public InputStream
 
         char buffer[30];
 
+        // The stream may be shared with other entries that are being read on other threads
+        const ScopedLock sl (zf.lock);
+
         if (inputStream != nullptr
              && inputStream->setPosition (zei.streamOffset)
              && inputStream->read (buffer, 30) == 30
@@ -279,6 +282,13 @@ ZipFile::ZipFile (InputStream& stream)
 ZipFile::ZipFile (const File& file)
     : inputSource (new FileInputSource (file))
 {
+    // With the archive mapped into memory, any number of entries can be read at
+    // once without each one needing its own file handle
+    mappedFile = std::make_unique<MemoryMappedFile> (file, MemoryMappedFile::readOnly);
+
+    if (mappedFile->getData() == nullptr)
+        mappedFile.reset();
+
     init();
 }
 
@@ -343,13 +353,48 @@ const ZipFile::ZipEntry* ZipFile::getEntry (const String& fileName, bool ignoreC
     return getEntry (getIndexOfFileName (fileName, ignoreCase));
 }
 
+std::optional<Span<const char>> ZipFile::getMappedData (const ZipEntryHolder& zei) const
+{
+    if (mappedFile == nullptr)
+        return {};
+
+    auto* data = static_cast<const char*> (mappedFile->getData());
+    const auto size = (int64) mappedFile->getSize();
+
+    if (zei.streamOffset < 0
+         || zei.streamOffset + 30 > size
+         || readUnalignedLittleEndianInt (data + zei.streamOffset) != 0x04034b50)
+        return {};
+
+    const auto start = zei.streamOffset + 30
+                         + readUnalignedLittleEndianShort (data + zei.streamOffset + 26)
+                         + readUnalignedLittleEndianShort (data + zei.streamOffset + 28);
+
+    if (start + zei.compressedSize > size)
+        return {};
+
+    return Span<const char> (data + start, (size_t) zei.compressedSize);
+}
+
+std::optional<Span<const char>> ZipFile::getStoredEntryData (int index) const
+{
+    if (auto* zei = entries[index])
+        if (! zei->isCompressed)
+            return getMappedData (*zei);
+
+    return {};
+}
+
 InputStream* ZipFile::createStreamForEntry (const int index)
 {
     InputStream* stream = nullptr;
 
     if (auto* zei = entries[index])
     {
-        stream = new ZipInputStream (*this, *zei);
+        if (const auto mapped = getMappedData (*zei))
+            stream = new MemoryInputStream (mapped->data(), mapped->size(), false);
+        else
+            stream = new ZipInputStream (*this, *zei);
 
         if (zei->isCompressed)
         {
@@ -444,6 +489,72 @@ Result ZipFile::uncompressTo (const File& targetDirectory,
     return Result::ok();
 }
 
+Result ZipFile::uncompressTo (const File& targetDirectory,
+                              const bool shouldOverwriteFiles,
+                              ThreadPool& threadPool)
+{
+    // Symbolic links change where the later entries end up, and entries that share
+    // a file overwrite each other, so archives with either have to be done in order
+    std::set<String> targetPaths;
+
+    for (auto* zei : entries)
+    {
+        if (zei->entry.isSymbolicLink
+             || ! targetPaths.insert (zei->entry.filename.replaceCharacter ('\\', '/').toLowerCase()).second)
+            return uncompressTo (targetDirectory, shouldOverwriteFiles);
+    }
+
+    // Starting the biggest entries first keeps all the threads busy until the end
+    std::vector<int> order ((size_t) entries.size());
+    std::iota (order.begin(), order.end(), 0);
+    std::stable_sort (order.begin(), order.end(), [this] (int a, int b)
+    {
+        return entries.getUnchecked (a)->compressedSize > entries.getUnchecked (b)->compressedSize;
+    });
+
+    struct State
+    {
+        std::atomic<int> nextTask { 0 }, numRemaining { 0 };
+        WaitableEvent finished { true };
+    };
+
+    auto state = std::make_shared<State>();
+    const auto numTasks = (int) order.size();
+    state->numRemaining = numTasks;
+
+    std::vector<Result> results ((size_t) numTasks, Result::ok());
+    CriticalSection folderLock;
+
+    const auto overwriteFiles = shouldOverwriteFiles ? OverwriteFiles::yes : OverwriteFiles::no;
+
+    auto worker = [this, state, numTasks, &order, &results, &folderLock, &targetDirectory, overwriteFiles]
+    {
+        for (int i; (i = state->nextTask++) < numTasks;)
+        {
+            const auto index = order[(size_t) i];
+            results[(size_t) index] = uncompressEntry (index, targetDirectory, overwriteFiles, FollowSymlinks::no, folderLock);
+
+            if (--state->numRemaining == 0)
+                state->finished.signal();
+        }
+    };
+
+    for (int i = jmin (numTasks, threadPool.getNumThreads() + 1); --i > 0;)
+        threadPool.addJob (worker);
+
+    if (numTasks > 0)
+    {
+        worker();
+        state->finished.wait();
+    }
+
+    for (auto& r : results)
+        if (r.failed())
+            return r;
+
+    return Result::ok();
+}
+
 Result ZipFile::uncompressEntry (int index, const File& targetDirectory, bool shouldOverwriteFiles)
 {
     return uncompressEntry (index,
@@ -453,6 +564,13 @@ Result ZipFile::uncompressEntry (int index, const File& targetDirectory, bool sh
 }
 
 Result ZipFile::uncompressEntry (int index, const File& targetDirectory, OverwriteFiles overwriteFiles, FollowSymlinks followSymlinks)
+{
+    CriticalSection folderLock;
+    return uncompressEntry (index, targetDirectory, overwriteFiles, followSymlinks, folderLock);
+}
+
+Result ZipFile::uncompressEntry (int index, const File& targetDirectory, OverwriteFiles overwriteFiles,
+                                 FollowSymlinks followSymlinks, CriticalSection& folderLock)
 {
     auto* zei = entries.getUnchecked (index);
 
@@ -470,6 +588,10 @@ Result ZipFile::uncompressEntry (int index, const File& targetDirectory, Overwri
     if (! targetFile.isAChildOf (targetDirectory))
         return Result::fail ("Entry " + entryPath + " is outside the target directory");
 
+    // Entries that are being expanded at the same time may share folders, which
+    // mustn't be created twice
+    const ScopedLock sl (folderLock);
+
     if (entryPath.endsWithChar ('/') || entryPath.endsWithChar ('\\'))
         return targetFile.createDirectory(); // (entry is a directory, not a file)
 
@@ -493,6 +615,8 @@ Result ZipFile::uncompressEntry (int index, const File& targetDirectory, Overwri
     if (! targetFile.getParentDirectory().createDirectory())
         return Result::fail ("Failed to create target folder: " + targetFile.getParentDirectory().getFullPathName());
 
+    const ScopedUnlock ul (folderLock);
+
     if (zei->entry.isSymbolicLink)
     {
         String originalFilePath (in->readEntireStreamAsString()
@@ -536,9 +660,12 @@ struct ZipFile::Builder::Item
         symbolicLink = (file.exists() && file.isSymbolicLink());
     }
 
-    bool writeData (OutputStream& target, const int64 overallStartPosition)
+    // This doesn't touch anything that's shared with other items, so the items
+    // can be compressed on different threads
+    bool compress()
     {
-        MemoryOutputStream compressedData ((size_t) file.getSize());
+        MemoryOutputStream out (compressedData, false);
+        out.preallocate ((size_t) file.getSize());
 
         if (symbolicLink)
         {
@@ -547,22 +674,28 @@ struct ZipFile::Builder::Item
             uncompressedSize = relativePath.length();
 
             checksum = zlibNamespace::crc32 (0, (uint8_t*) relativePath.toRawUTF8(), (unsigned int) uncompressedSize);
-            compressedData << relativePath;
+            out << relativePath;
         }
         else if (compressionLevel > 0)
         {
-            GZIPCompressorOutputStream compressor (compressedData, compressionLevel,
+            GZIPCompressorOutputStream compressor (out, compressionLevel,
                                                    GZIPCompressorOutputStream::windowBitsRaw);
             if (! writeSource (compressor))
                 return false;
         }
         else
         {
-            if (! writeSource (compressedData))
+            if (! writeSource (out))
                 return false;
         }
 
-        compressedSize = (int64) compressedData.getDataSize();
+        out.flush();
+        compressedSize = (int64) compressedData.getSize();
+        return true;
+    }
+
+    bool writeData (OutputStream& target, const int64 overallStartPosition)
+    {
         headerStart = target.getPosition() - overallStartPosition;
 
         target.writeInt (0x04034b50);
@@ -570,6 +703,7 @@ struct ZipFile::Builder::Item
         target << storedPathname
                << compressedData;
 
+        compressedData.reset();
         return true;
     }
 
@@ -593,6 +727,7 @@ private:
     std::unique_ptr<InputStream> stream;
     String storedPathname;
     Time fileTime;
+    MemoryBlock compressedData;
     int64 compressedSize = 0, uncompressedSize = 0, headerStart = 0;
     int compressionLevel = 0;
     unsigned long checksum = 0;
@@ -686,10 +821,71 @@ bool ZipFile::Builder::writeToStream (OutputStream& target, double* const progre
         if (progress != nullptr)
             *progress = (i + 0.5) / items.size();
 
-        if (! items.getUnchecked (i)->writeData (target, fileStart))
+        auto* item = items.getUnchecked (i);
+
+        if (! (item->compress() && item->writeData (target, fileStart)))
             return false;
     }
 
+    if (! writeCentralDirectory (target, fileStart))
+        return false;
+
+    if (progress != nullptr)
+        *progress = 1.0;
+
+    return true;
+}
+
+bool ZipFile::Builder::writeToStream (OutputStream& target, double* const progress, ThreadPool& threadPool) const
+{
+    auto fileStart = target.getPosition();
+
+    struct Job
+    {
+        WaitableEvent finished { true };
+        bool ok = false;
+    };
+
+    const auto numItems = items.size();
+    const auto numToCompressAhead = jmax (1, threadPool.getNumThreads()) * 2;
+    std::vector<Job> jobs ((size_t) numItems);
+    int numStarted = 0;
+    bool ok = true;
+
+    for (int i = 0; i < numItems && ok; ++i)
+    {
+        for (; numStarted < jmin (numItems, i + numToCompressAhead); ++numStarted)
+        {
+            threadPool.addJob ([item = items.getUnchecked (numStarted), &job = jobs[(size_t) numStarted]]
+                               {
+                                   job.ok = item->compress();
+                                   job.finished.signal();
+                               });
+        }
+
+        if (progress != nullptr)
+            *progress = (i + 0.5) / numItems;
+
+        jobs[(size_t) i].finished.wait();
+        ok = jobs[(size_t) i].ok && items.getUnchecked (i)->writeData (target, fileStart);
+    }
+
+    // If something went wrong, the jobs that are still running must finish before
+    // their items can be touched again
+    for (int i = 0; i < numStarted; ++i)
+        jobs[(size_t) i].finished.wait();
+
+    if (! (ok && writeCentralDirectory (target, fileStart)))
+        return false;
+
+    if (progress != nullptr)
+        *progress = 1.0;
+
+    return true;
+}
+
+bool ZipFile::Builder::writeCentralDirectory (OutputStream& target, int64 fileStart) const
+{
     auto directoryStart = target.getPosition();
 
     for (auto* item : items)
@@ -707,9 +903,6 @@ bool ZipFile::Builder::writeToStream (OutputStream& target, double* const progre
     target.writeInt ((int) (directoryStart - fileStart));
     target.writeShort (0);
 
-    if (progress != nullptr)
-        *progress = 1.0;
-
     return true;
 }
 
@@ -812,11 +1005,201 @@ struct ZIPTests final : public UnitTest
 
         beginTest ("ZipSlip");
         runZipSlipTest();
+
+        beginTest ("Parallel Builder");
+        runParallelBuilderTest();
+
+        beginTest ("Parallel extraction and stored entries");
+        runParallelExtractionTest();
+    }
+
+    // Makes some data that compresses, but not too easily
+    static MemoryBlock createTestData (Random& random, int size)
+    {
+        MemoryBlock block ((size_t) size);
+
+        for (auto& b : block)
+            b = (char) ('a' + random.nextInt (16));
+
+        return block;
+    }
+
+    static std::unique_ptr<ZipFile::Builder> createBuilder (const std::vector<MemoryBlock>& blocks)
+    {
+        auto builder = std::make_unique<ZipFile::Builder>();
+
+        for (size_t i = 0; i < blocks.size(); ++i)
+            builder->addEntry (std::make_unique<MemoryInputStream> (blocks[i], false),
+                               (i % 3) == 0 ? 0 : 6,
+                               "folder" + String (i % 4) + "/entry" + String (i),
+                               Time (2024, 1, 2, 3, 4, 6));
+
+        return builder;
+    }
+
+    void runParallelBuilderTest()
+    {
+        auto random = getRandom();
+        std::vector<MemoryBlock> blocks;
+
+        for (int i = 0; i < 20; ++i)
+            blocks.push_back (createTestData (random, random.nextInt (100000)));
+
+        MemoryOutputStream serial, parallel;
+        ThreadPool pool (3);
+
+        expect (createBuilder (blocks)->writeToStream (serial, nullptr));
+        expect (createBuilder (blocks)->writeToStream (parallel, nullptr, pool));
+        expect (serial.getMemoryBlock() == parallel.getMemoryBlock());
+    }
+
+    void runParallelExtractionTest()
+    {
+        auto random = getRandom();
+        std::vector<MemoryBlock> blocks;
+
+        for (int i = 0; i < 20; ++i)
+            blocks.push_back (createTestData (random, random.nextInt (100000)));
+
+        TemporaryFile zipFile (".zip");
+
+        {
+            FileOutputStream out (zipFile.getFile());
+            expect (createBuilder (blocks)->writeToStream (out, nullptr));
+        }
+
+        TemporaryFile tmpDir;
+        ThreadPool pool (3);
+        ZipFile zip (zipFile.getFile());
+
+        expect (zip.uncompressTo (tmpDir.getFile(), true, pool).wasOk());
+
+        for (int i = 0; i < zip.getNumEntries(); ++i)
+        {
+            MemoryBlock extracted;
+            expect (tmpDir.getFile().getChildFile (zip.getEntry (i)->filename).loadFileAsData (extracted));
+            expect (extracted == blocks[(size_t) i]);
+
+            const auto stored = zip.getStoredEntryData (i);
+            expect (stored.has_value() == ((i % 3) == 0));
+
+            if (stored.has_value())
+                expect (MemoryBlock (stored->data(), stored->size()) == blocks[(size_t) i]);
+        }
     }
 };
 
 static ZIPTests zipTests;
 
+//==============================================================================
+class ZIPBenchmarks final : public UnitTest
+{
+public:
+    ZIPBenchmarks()  : UnitTest ("ZIP benchmarks", UnitTestCategories::benchmarks)  {}
+
+    void runTest() override
+    {
+        beginTest ("Building and extracting an archive");
+
+        auto random = getRandom();
+        std::vector<MemoryBlock> blocks;
+
+        for (int i = 0; i < numEntries; ++i)
+            blocks.push_back (ZIPTests::createTestData (random, entrySize));
+
+        ThreadPool pool (jmax (1, SystemStats::getNumCpus() - 1));
+        TemporaryFile zipFile (".zip");
+
+        {
+            MemoryOutputStream out;
+            logMessage ("Builder, one thread: " + time ([&] { ZIPTests::createBuilder (blocks)->writeToStream (out, nullptr); }));
+        }
+
+        {
+            FileOutputStream out (zipFile.getFile());
+            logMessage ("Builder, " + String (pool.getNumThreads()) + " pool threads: "
+                          + time ([&] { ZIPTests::createBuilder (blocks)->writeToStream (out, nullptr, pool); }));
+        }
+
+        {
+            TemporaryFile dir;
+            ZipFile zip (zipFile.getFile());
+            logMessage ("uncompressTo, one thread: " + time ([&] { zip.uncompressTo (dir.getFile()); }));
+        }
+
+        {
+            TemporaryFile dir;
+            ZipFile zip (zipFile.getFile());
+            logMessage ("uncompressTo, " + String (pool.getNumThreads()) + " pool threads: "
+                          + time ([&] { zip.uncompressTo (dir.getFile(), true, pool); }));
+        }
+
+        // Every third entry is stored without compression
+        const auto numBytesStored = (double) entrySize * ((numEntries + 2) / 3);
+
+        {
+            FileInputStream in (zipFile.getFile());
+            ZipFile zip (in);
+            logMessage ("Reading stored entries from a stream: "
+                          + time ([&] { readStoredEntries (zip, [&] (int i) { return readChecksum (zip, i); }); }, numBytesStored));
+        }
+
+        {
+            ZipFile zip (zipFile.getFile());
+            logMessage ("Reading stored entries with getStoredEntryData(): "
+                          + time ([&] { readStoredEntries (zip, [&] (int i) { return checksum (*zip.getStoredEntryData (i)); }); }, numBytesStored));
+        }
+    }
+
+private:
+    static constexpr int numEntries = 48, entrySize = 2 * 1024 * 1024;
+
+    static uint64 checksum (Span<const char> data)
+    {
+        uint64 sum = 0;
+
+        for (auto c : data)
+            sum += (uint8) c;
+
+        return sum;
+    }
+
+    static uint64 readChecksum (ZipFile& zip, int index)
+    {
+        std::unique_ptr<InputStream> in (zip.createStreamForEntry (index));
+        HeapBlock<char> buffer (65536);
+        uint64 sum = 0;
+
+        for (int num; (num = in->read (buffer, 65536)) > 0;)
+            sum += checksum (Span<const char> (buffer.get(), (size_t) num));
+
+        return sum;
+    }
+
+    template <typename ReadEntry>
+    void readStoredEntries (ZipFile& zip, ReadEntry&& readEntry)
+    {
+        uint64 total = 0;
+
+        for (int i = 0; i < zip.getNumEntries(); i += 3)
+            total += readEntry (i);
+
+        expect (total > 0);
+    }
+
+    template <typename Fn>
+    static String time (Fn&& fn, double numBytes = (double) numEntries * entrySize)
+    {
+        const auto start = Time::getMillisecondCounterHiRes();
+        fn();
+        const auto elapsed = Time::getMillisecondCounterHiRes() - start;
+
+        return String (elapsed, 1) + " ms (" + String (roundToInt (numBytes / (1024.0 * 1024.0) / (elapsed / 1000.0))) + " MB/s)";
+    }
+};
+
+static ZIPBenchmarks zipBenchmarks;
+
 #endif
 
 } // namespace juce
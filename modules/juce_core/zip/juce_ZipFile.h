@@ -172,6 +172,18 @@ public:
     */
     InputStream* createStreamForEntry (const ZipEntry& entry);
 
+    /** Returns the contents of an entry that's stored without compression, without
+        copying it.
+
+        This only works when the ZipFile was created from a File, in which case the
+        archive is mapped into memory, and the span that's returned points into that
+        mapping. It remains valid for as long as the ZipFile exists.
+
+        Returns an empty optional if the entry is compressed, the index is out of range,
+        or the archive couldn't be mapped.
+    */
+    std::optional<Span<const char>> getStoredEntryData (int index) const;
+
     //==============================================================================
     /** Uncompresses all of the files in the zip file.
 
@@ -185,6 +197,28 @@ public:
     Result uncompressTo (const File& targetDirectory,
                          bool shouldOverwriteFiles = true);
 
+    /** Uncompresses all of the files in the zip file, using the threads of a ThreadPool
+        to expand several entries at once.
+
+        The files that are created are the same as with the single-threaded version.
+        Archives that contain symbolic links, or more than one entry for the same file,
+        have to be expanded in order, so for those this does the same as the
+        single-threaded version.
+
+        For this to be much faster, the entries need to be read independently, so the
+        ZipFile should be created from a File or an InputSource rather than a stream.
+
+        @param targetDirectory      the root folder to uncompress to
+        @param shouldOverwriteFiles whether to overwrite existing files with similarly-named ones
+        @param threadPool           the pool to use. The calling thread also expands entries
+                                    while it waits
+        @returns success if the file is successfully unzipped, or the first error, in the
+                 order of the entries, if it isn't
+    */
+    Result uncompressTo (const File& targetDirectory,
+                         bool shouldOverwriteFiles,
+                         ThreadPool& threadPool);
+
     /** Uncompresses one of the entries from the zip file.
 
         This will expand the entry and write it in a target directory. The entry's path is used to
@@ -274,11 +308,24 @@ public:
         */
         bool writeToStream (OutputStream& target, double* progress) const;
 
+        /** Generates the zip file, compressing the entries on the threads of a ThreadPool.
+
+            The data that's written is the same as with the single-threaded version. Only a
+            few entries are compressed ahead of the one being written, so the amount of
+            memory needed doesn't depend on the size of the archive.
+
+            If the progress parameter is non-null, it will be updated with an approximate
+            progress status between 0 and 1.0
+        */
+        bool writeToStream (OutputStream& target, double* progress, ThreadPool& threadPool) const;
+
         //==============================================================================
     private:
         struct Item;
         OwnedArray<Item> items;
 
+        bool writeCentralDirectory (OutputStream& target, int64 fileStart) const;
+
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Builder)
     };
 
@@ -294,6 +341,7 @@ private:
     InputStream* inputStream = nullptr;
     std::unique_ptr<InputStream> streamToDelete;
     std::unique_ptr<InputSource> inputSource;
+    std::unique_ptr<MemoryMappedFile> mappedFile;
 
    #if JUCE_DEBUG
     struct OpenStreamCounter
@@ -301,13 +349,15 @@ private:
         OpenStreamCounter() = default;
         ~OpenStreamCounter();
 
-        int numOpenStreams = 0;
+        std::atomic<int> numOpenStreams { 0 };
     };
 
     OpenStreamCounter streamCounter;
    #endif
 
     void init();
+    std::optional<Span<const char>> getMappedData (const ZipEntryHolder&) const;
+    Result uncompressEntry (int, const File&, OverwriteFiles, FollowSymlinks, CriticalSection&);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ZipFile)
 };
@@ -0,0 +1,244 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+#if JUCE_USE_ZSTD
+
+class ZstdCompressorOutputStream::ZstdCompressorHelper
+{
+public:
+    explicit ZstdCompressorHelper (const Options& options)
+        : context (ZSTD_createCCtx()),
+          buffer (ZSTD_CStreamOutSize())
+    {
+        const auto& dictionary = options.getDictionary();
+
+        streamIsValid = context != nullptr
+                         && ! ZSTD_isError (ZSTD_CCtx_setParameter (context, ZSTD_c_compressionLevel, options.getCompressionLevel()))
+                         && ! ZSTD_isError (ZSTD_CCtx_setParameter (context, ZSTD_c_checksumFlag, options.getContentChecksum() ? 1 : 0))
+                         && (dictionary.isEmpty()
+                              || ! ZSTD_isError (ZSTD_CCtx_loadDictionary (context, dictionary.getData(), dictionary.getSize())));
+
+        // If libzstd was built without multithreading, this fails and the data is
+        // compressed on the calling thread instead
+        if (streamIsValid && options.getNumThreads() > 0)
+            ZSTD_CCtx_setParameter (context, ZSTD_c_nbWorkers, options.getNumThreads());
+    }
+
+    ~ZstdCompressorHelper()
+    {
+        ZSTD_freeCCtx (context);
+    }
+
+    bool write (const void* data, size_t dataSize, OutputStream& out)
+    {
+        return compress (data, dataSize, ZSTD_e_continue, out);
+    }
+
+    bool flush (OutputStream& out)
+    {
+        return compress (nullptr, 0, ZSTD_e_flush, out);
+    }
+
+    bool finish (OutputStream& out)
+    {
+        return compress (nullptr, 0, ZSTD_e_end, out);
+    }
+
+private:
+    bool compress (const void* data, size_t dataSize, ZSTD_EndDirective mode, OutputStream& out)
+    {
+        if (! streamIsValid)
+            return false;
+
+        ZSTD_inBuffer input { data, dataSize, 0 };
+
+        for (;;)
+        {
+            ZSTD_outBuffer output { buffer.getData(), buffer.getSize(), 0 };
+            const auto numBytesLeft = ZSTD_compressStream2 (context, &output, &input, mode);
+
+            if (ZSTD_isError (numBytesLeft))
+            {
+                streamIsValid = false;
+                return false;
+            }
+
+            if (output.pos > 0 && ! out.write (buffer.getData(), output.pos))
+                return false;
+
+            // When flushing or ending the frame, zstd says how much it still has to write
+            if (mode == ZSTD_e_continue ? input.pos == input.size : numBytesLeft == 0)
+                return true;
+        }
+    }
+
+    ZSTD_CCtx* context;
+    MemoryBlock buffer;
+    bool streamIsValid = false;
+
+    JUCE_DECLARE_NON_COPYABLE (ZstdCompressorHelper)
+};
+
+//==============================================================================
+ZstdCompressorOutputStream::ZstdCompressorOutputStream (OutputStream& s, const Options& options)
+   : ZstdCompressorOutputStream (&s, false, options)
+{
+}
+
+ZstdCompressorOutputStream::ZstdCompressorOutputStream (OutputStream* out, bool deleteDestStream, const Options& options)
+   : destStream (out, deleteDestStream),
+     helper (new ZstdCompressorHelper (options))
+{
+    jassert (out != nullptr);
+}
+
+ZstdCompressorOutputStream::~ZstdCompressorOutputStream()
+{
+    helper->finish (*destStream);
+    destStream->flush();
+}
+
+void ZstdCompressorOutputStream::flush()
+{
+    helper->flush (*destStream);
+    destStream->flush();
+}
+
+bool ZstdCompressorOutputStream::write (const void* destBuffer, size_t howMany)
+{
+    jassert (destBuffer != nullptr && (ssize_t) howMany >= 0);
+
+    return helper->write (destBuffer, howMany, *destStream);
+}
+
+int64 ZstdCompressorOutputStream::getPosition()
+{
+    return destStream->getPosition();
+}
+
+bool ZstdCompressorOutputStream::setPosition (int64 /*newPosition*/)
+{
+    jassertfalse; // can't do it!
+    return false;
+}
+
+MemoryBlock ZstdCompressorOutputStream::compress (const void* data, size_t numBytes, const Options& options)
+{
+    MemoryOutputStream out;
+
+    {
+        ZstdCompressorOutputStream zstd (out, options);
+        zstd.write (data, numBytes);
+    }
+
+    return out.getMemoryBlock();
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct ZstdTests final : public UnitTest
+{
+    ZstdTests()
+        : UnitTest ("Zstd", UnitTestCategories::compression)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Round trip");
+        auto rng = getRandom();
+
+        for (int i = 40; --i >= 0;)
+        {
+            const auto original = GZIPTests::createCompressibleData (rng, rng.nextInt (300000));
+            const auto options = ZstdCompressorOutputStream::Options{}.withCompressionLevel (rng.nextInt (Range<int> (-3, 20)))
+                                                                      .withNumThreads (rng.nextBool() ? 2 : 0);
+            MemoryOutputStream compressed;
+
+            {
+                ZstdCompressorOutputStream zstd (compressed, options);
+                LZ4Tests::writeInRandomChunks (zstd, original, rng);
+            }
+
+            expect (ZstdDecompressorInputStream::decompress (compressed.getData(), compressed.getDataSize()) == original);
+        }
+
+        beginTest ("Dictionary");
+        {
+            const auto dictionary = GZIPTests::createCompressibleData (rng, 32768);
+            const auto message = GZIPTests::createCompressibleData (rng, 300);
+            const auto options = ZstdCompressorOutputStream::Options{}.withDictionary (dictionary);
+
+            const auto withDictionary = ZstdCompressorOutputStream::compress (message.getData(), message.getSize(), options);
+            const auto without = ZstdCompressorOutputStream::compress (message.getData(), message.getSize());
+
+            expect (withDictionary.getSize() < without.getSize());
+            expect (ZstdDecompressorInputStream::decompress (withDictionary.getData(), withDictionary.getSize(), dictionary) == message);
+            expect (ZstdDecompressorInputStream::decompress (withDictionary.getData(), withDictionary.getSize()).isEmpty());
+        }
+
+        beginTest ("Corrupt and truncated data");
+        {
+            const auto original = GZIPTests::createCompressibleData (rng, 100000);
+            const auto compressed = ZstdCompressorOutputStream::compress (original.getData(), original.getSize());
+
+            MemoryInputStream truncated (compressed.getData(), compressed.getSize() / 2, false);
+            ZstdDecompressorInputStream zstd (truncated);
+            MemoryOutputStream out;
+            out << zstd;
+            expect (zstd.hasError());
+
+            for (int i = 50; --i >= 0;)
+            {
+                auto corrupt = compressed;
+                corrupt[rng.nextInt ((int) corrupt.getSize())] ^= (char) (1 + rng.nextInt (255));
+
+                const auto result = ZstdDecompressorInputStream::decompress (corrupt.getData(), corrupt.getSize());
+                expect (result.isEmpty() || result == original);
+            }
+        }
+    }
+};
+
+static ZstdTests zstdTests;
+
+#endif
+
+#endif
+
+} // namespace juce
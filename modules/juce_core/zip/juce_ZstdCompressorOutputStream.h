@@ -0,0 +1,154 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+#if JUCE_USE_ZSTD || DOXYGEN
+
+//==============================================================================
+/**
+    Settings for a ZstdCompressorOutputStream.
+
+    @see ZstdCompressorOutputStream
+
+    @tags{Core}
+*/
+class JUCE_API  ZstdCompressorOptions
+{
+public:
+    /** Sets the compression level. The usual range is 1 (the fastest) to 19, with
+        levels up to 22 using more memory, and negative levels being faster still.
+    */
+    [[nodiscard]] ZstdCompressorOptions withCompressionLevel (int x) const            { return withMember (*this, &ZstdCompressorOptions::compressionLevel, x); }
+
+    /** Sets the number of threads that zstd uses to compress the data. With 0, the
+        data is compressed on the thread that writes it. This only has an effect if
+        libzstd was built with multithreading support.
+    */
+    [[nodiscard]] ZstdCompressorOptions withNumThreads (int x) const                  { return withMember (*this, &ZstdCompressorOptions::numThreads, jmax (0, x)); }
+
+    /** Sets a dictionary: data like that which will be compressed, or a dictionary
+        trained by zstd, which helps small amounts of data to compress well. The same
+        dictionary must be given to the ZstdDecompressorInputStream.
+    */
+    [[nodiscard]] ZstdCompressorOptions withDictionary (const MemoryBlock& x) const   { return withMember (*this, &ZstdCompressorOptions::dictionary, x); }
+
+    /** Sets whether a checksum of the data is added to the end of each frame. */
+    [[nodiscard]] ZstdCompressorOptions withContentChecksum (bool x) const            { return withMember (*this, &ZstdCompressorOptions::contentChecksum, x); }
+
+    int getCompressionLevel() const noexcept                                          { return compressionLevel; }
+    int getNumThreads() const noexcept                                                { return numThreads; }
+    const MemoryBlock& getDictionary() const noexcept                                 { return dictionary; }
+    bool getContentChecksum() const noexcept                                          { return contentChecksum; }
+
+private:
+    int compressionLevel = 3;
+    int numThreads = 0;
+    MemoryBlock dictionary;
+    bool contentChecksum = true;
+};
+
+//==============================================================================
+/**
+    A stream which compresses the data written into it using Zstandard.
+
+    Zstandard compresses about as tightly as zlib at its fast levels, and much more
+    tightly at its higher levels, while being several times quicker to decompress.
+    JUCE doesn't contain a copy of the library, so to use this class you'll need to
+    enable JUCE_USE_ZSTD, make the zstd headers available and link to libzstd.
+
+    Calling flush() writes out all the data that has been written so far without
+    ending the frame, so more data can follow; the frame is finished when the stream
+    is deleted.
+
+    @see ZstdDecompressorInputStream, LZ4CompressorOutputStream, GZIPCompressorOutputStream
+
+    @tags{Core}
+*/
+class JUCE_API  ZstdCompressorOutputStream  : public OutputStream
+{
+public:
+    //==============================================================================
+    using Options = ZstdCompressorOptions;
+
+    //==============================================================================
+    /** Creates a compression stream.
+        @param destStream   the stream into which the compressed data will be written
+        @param options      the compression settings to use
+    */
+    explicit ZstdCompressorOutputStream (OutputStream& destStream,
+                                         const Options& options = {});
+
+    /** Creates a compression stream.
+        @param destStream                       the stream into which the compressed data will be written.
+                                                Ownership of this object depends on the value of deleteDestStreamWhenDestroyed
+        @param deleteDestStreamWhenDestroyed    whether or not the ZstdCompressorOutputStream will delete the
+                                                destStream object when it is destroyed
+        @param options                          the compression settings to use
+    */
+    ZstdCompressorOutputStream (OutputStream* destStream,
+                                bool deleteDestStreamWhenDestroyed,
+                                const Options& options = {});
+
+    /** Destructor. This finishes the frame. */
+    ~ZstdCompressorOutputStream() override;
+
+    //==============================================================================
+    /** Compresses and writes out all the data that has been written so far. More data
+        can be written afterwards.
+    */
+    void flush() override;
+
+    int64 getPosition() override;
+    bool setPosition (int64) override;
+    bool write (const void*, size_t) override;
+
+    //==============================================================================
+    /** Compresses a block of data into a single zstd frame. */
+    static MemoryBlock compress (const void* data, size_t numBytes, const Options& options = {});
+
+private:
+    //==============================================================================
+    OptionalScopedPointer<OutputStream> destStream;
+
+    class ZstdCompressorHelper;
+    std::unique_ptr<ZstdCompressorHelper> helper;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ZstdCompressorOutputStream)
+};
+
+#endif
+
+} // namespace juce
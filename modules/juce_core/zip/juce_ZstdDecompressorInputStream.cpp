@@ -0,0 +1,193 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+#if JUCE_USE_ZSTD
+
+//==============================================================================
+// internal helper object that holds the zstd structures so they don't have to be
+// included publicly.
+class ZstdDecompressorInputStream::ZstdDecompressHelper
+{
+public:
+    explicit ZstdDecompressHelper (const MemoryBlock& dictionary)
+        : context (ZSTD_createDCtx()),
+          buffer (ZSTD_DStreamInSize())
+    {
+        error = context == nullptr
+                 || (! dictionary.isEmpty()
+                      && ZSTD_isError (ZSTD_DCtx_loadDictionary (context, dictionary.getData(), dictionary.getSize())));
+    }
+
+    ~ZstdDecompressHelper()
+    {
+        ZSTD_freeDCtx (context);
+    }
+
+    int read (uint8* dest, int numBytes, InputStream& source)
+    {
+        ZSTD_outBuffer output { dest, (size_t) numBytes, 0 };
+
+        while (output.pos < output.size && ! error)
+        {
+            // Between frames, there's nothing to do until more data arrives
+            if (input.pos < input.size || ! frameFinished)
+            {
+                const auto previousPos = output.pos;
+                const auto result = ZSTD_decompressStream (context, &output, &input);
+
+                if (ZSTD_isError (result))
+                {
+                    error = true;
+                    break;
+                }
+
+                frameFinished = (result == 0);
+
+                if (output.pos > previousPos || input.pos < input.size)
+                    continue;
+            }
+
+            const auto numRead = source.read (buffer.getData(), (int) buffer.getSize());
+
+            if (numRead <= 0)
+            {
+                // The data ended part of the way through a frame
+                error = ! frameFinished;
+                break;
+            }
+
+            input = { buffer.getData(), (size_t) numRead, 0 };
+        }
+
+        return (int) output.pos;
+    }
+
+    bool isExhausted (InputStream& source)
+    {
+        return error || (frameFinished && input.pos == input.size && source.isExhausted());
+    }
+
+    bool error = false;
+
+private:
+    ZSTD_DCtx* context;
+    MemoryBlock buffer;
+    ZSTD_inBuffer input { nullptr, 0, 0 };
+    bool frameFinished = true;
+
+    JUCE_DECLARE_NON_COPYABLE (ZstdDecompressHelper)
+};
+
+//==============================================================================
+ZstdDecompressorInputStream::ZstdDecompressorInputStream (InputStream* source, bool deleteSourceWhenDestroyed,
+                                                          const MemoryBlock& dict)
+  : sourceStream (source, deleteSourceWhenDestroyed),
+    dictionary (dict),
+    originalSourcePos (source->getPosition()),
+    helper (new ZstdDecompressHelper (dictionary))
+{
+}
+
+ZstdDecompressorInputStream::ZstdDecompressorInputStream (InputStream& source)
+  : ZstdDecompressorInputStream (&source, false)
+{
+}
+
+ZstdDecompressorInputStream::~ZstdDecompressorInputStream()
+{
+}
+
+bool ZstdDecompressorInputStream::hasError() const noexcept
+{
+    return helper->error;
+}
+
+int64 ZstdDecompressorInputStream::getTotalLength()
+{
+    return -1;
+}
+
+int ZstdDecompressorInputStream::read (void* destBuffer, int howMany)
+{
+    jassert (destBuffer != nullptr && howMany >= 0);
+
+    const auto numRead = helper->read (static_cast<uint8*> (destBuffer), howMany, *sourceStream);
+    currentPos += numRead;
+    return numRead;
+}
+
+bool ZstdDecompressorInputStream::isExhausted()
+{
+    return helper->isExhausted (*sourceStream);
+}
+
+int64 ZstdDecompressorInputStream::getPosition()
+{
+    return currentPos;
+}
+
+bool ZstdDecompressorInputStream::setPosition (int64 newPos)
+{
+    if (newPos < currentPos)
+    {
+        // to go backwards, reset the stream and start again
+        currentPos = 0;
+        helper.reset (new ZstdDecompressHelper (dictionary));
+
+        sourceStream->setPosition (originalSourcePos);
+    }
+
+    skipNextBytes (newPos - currentPos);
+    return true;
+}
+
+MemoryBlock ZstdDecompressorInputStream::decompress (const void* data, size_t numBytes, const MemoryBlock& dictionary)
+{
+    MemoryInputStream in (data, numBytes, false);
+    ZstdDecompressorInputStream zstd (&in, false, dictionary);
+    MemoryOutputStream out;
+    out << zstd;
+
+    if (zstd.hasError())
+        return {};
+
+    return out.getMemoryBlock();
+}
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,110 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+#if JUCE_USE_ZSTD || DOXYGEN
+
+//==============================================================================
+/**
+    This stream will decompress a source-stream of Zstandard frames.
+
+    To use this class you'll need to enable JUCE_USE_ZSTD, make the zstd headers
+    available and link to libzstd. If the source holds several frames one after
+    another, they're read as one continuous stream.
+
+    @see ZstdCompressorOutputStream
+
+    @tags{Core}
+*/
+class JUCE_API  ZstdDecompressorInputStream  : public InputStream
+{
+public:
+    //==============================================================================
+    /** Creates a decompressor stream.
+
+        @param sourceStream                 the stream to read from
+        @param deleteSourceWhenDestroyed    whether or not to delete the source stream
+                                            when this object is destroyed
+        @param dictionary                   the dictionary that the data was compressed with,
+                                            if any
+    */
+    ZstdDecompressorInputStream (InputStream* sourceStream,
+                                 bool deleteSourceWhenDestroyed,
+                                 const MemoryBlock& dictionary = {});
+
+    /** Creates a decompressor stream.
+
+        @param sourceStream     the stream to read from - the source stream must not be
+                                deleted until this object has been destroyed
+    */
+    explicit ZstdDecompressorInputStream (InputStream& sourceStream);
+
+    /** Destructor. */
+    ~ZstdDecompressorInputStream() override;
+
+    //==============================================================================
+    /** Returns true if the data that has been read so far was found to be corrupt or
+        incomplete, or if it needs a different dictionary.
+    */
+    bool hasError() const noexcept;
+
+    //==============================================================================
+    int64 getPosition() override;
+    bool setPosition (int64 pos) override;
+    int64 getTotalLength() override;
+    bool isExhausted() override;
+    int read (void* destBuffer, int maxBytesToRead) override;
+
+    //==============================================================================
+    /** Decompresses a block of zstd data, returning an empty block if it's not valid. */
+    static MemoryBlock decompress (const void* data, size_t numBytes, const MemoryBlock& dictionary = {});
+
+private:
+    //==============================================================================
+    OptionalScopedPointer<InputStream> sourceStream;
+    const MemoryBlock dictionary;
+    const int64 originalSourcePos;
+    int64 currentPos = 0;
+
+    class ZstdDecompressHelper;
+    std::unique_ptr<ZstdDecompressHelper> helper;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ZstdDecompressorInputStream)
+};
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,259 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+// Faster versions of some of the embedded zlib's routines, used when
+// JUCE_USE_ACCELERATED_ZLIB is enabled. This is included inside the zlib
+// namespace by juce_GZIPDecompressorInputStream.cpp, just before the zlib
+// sources, which call these functions where they're available. None of them
+// change the data that zlib produces.
+
+#if JUCE_ZLIB_USE_SSE2 || JUCE_ZLIB_USE_NEON
+
+//==============================================================================
+// Adler-32 is two running sums: s1 of the bytes, and s2 of the values of s1. Over a
+// block of 16 bytes, s1 grows by the sum of the bytes, and s2 by 16 times the old s1
+// plus the bytes weighted 16, 15 ... 1, so whole blocks can be done with vectors.
+// Up to 5552 bytes can be summed before the totals need reducing modulo 65521.
+#define JUCE_ZLIB_ADLER32_SIMD 1
+
+static uLong juce_adler32_simd (uLong adler, const Bytef* buf, z_size_t len)
+{
+    constexpr uint32_t base = 65521, maxBytesBeforeModulo = 5552 & ~15;
+
+    uint64_t s1 = adler & 0xffff;
+    uint64_t s2 = (adler >> 16) & 0xffff;
+
+   #if JUCE_ZLIB_USE_SSE2
+    const auto zero        = _mm_setzero_si128();
+    const auto weightsLow  = _mm_set_epi16 (9, 10, 11, 12, 13, 14, 15, 16);
+    const auto weightsHigh = _mm_set_epi16 (1, 2, 3, 4, 5, 6, 7, 8);
+
+    const auto sumLanes = [] (__m128i v)
+    {
+        alignas (16) uint32_t lanes[4];
+        _mm_store_si128 ((__m128i*) lanes, v);
+        return (uint64_t) lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    };
+   #else
+    static const uint8_t weightData[16] = { 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 };
+    const auto weightsLow  = vld1_u8 (weightData);
+    const auto weightsHigh = vld1_u8 (weightData + 8);
+
+    const auto sumLanes = [] (uint32x4_t v)
+    {
+        return (uint64_t) vgetq_lane_u32 (v, 0) + vgetq_lane_u32 (v, 1)
+                        + vgetq_lane_u32 (v, 2) + vgetq_lane_u32 (v, 3);
+    };
+   #endif
+
+    while (len >= 16)
+    {
+        const auto numBytes = (uint32_t) (len < maxBytesBeforeModulo ? len & ~(z_size_t) 15 : maxBytesBeforeModulo);
+        len -= numBytes;
+
+       #if JUCE_ZLIB_USE_SSE2
+        auto byteSums = zero, weightedSums = zero, previousByteSums = zero;
+
+        for (auto n = numBytes; n > 0; n -= 16, buf += 16)
+        {
+            const auto v = _mm_loadu_si128 ((const __m128i*) buf);
+
+            previousByteSums = _mm_add_epi32 (previousByteSums, byteSums);
+            byteSums         = _mm_add_epi32 (byteSums, _mm_sad_epu8 (v, zero));
+            weightedSums     = _mm_add_epi32 (weightedSums, _mm_madd_epi16 (_mm_unpacklo_epi8 (v, zero), weightsLow));
+            weightedSums     = _mm_add_epi32 (weightedSums, _mm_madd_epi16 (_mm_unpackhi_epi8 (v, zero), weightsHigh));
+        }
+       #else
+        auto byteSums = vdupq_n_u32 (0), weightedSums = vdupq_n_u32 (0), previousByteSums = vdupq_n_u32 (0);
+
+        for (auto n = numBytes; n > 0; n -= 16, buf += 16)
+        {
+            const auto v = vld1q_u8 (buf);
+
+            previousByteSums = vaddq_u32 (previousByteSums, byteSums);
+            byteSums         = vpadalq_u16 (byteSums, vpaddlq_u8 (v));
+
+            const auto weighted = vmlal_u8 (vmull_u8 (vget_low_u8 (v), weightsLow), vget_high_u8 (v), weightsHigh);
+            weightedSums = vpadalq_u16 (weightedSums, weighted);
+        }
+       #endif
+
+        s2 = (s2 + s1 * numBytes + 16 * sumLanes (previousByteSums) + sumLanes (weightedSums)) % base;
+        s1 = (s1 + sumLanes (byteSums)) % base;
+    }
+
+    while (len-- > 0)
+    {
+        s1 += *buf++;
+        s2 += s1;
+    }
+
+    return (uLong) ((s1 % base) | ((s2 % base) << 16));
+}
+
+#endif
+
+//==============================================================================
+#if JUCE_ZLIB_USE_SSE2
+
+// This folds the data into a 128-bit remainder with carry-less multiplications, as
+// described in Intel's "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ
+// Instruction" paper, and then reduces that to 32 bits. The constants are powers of
+// x modulo the bit-reflected CRC-32 polynomial.
+#define JUCE_ZLIB_CRC32_PCLMUL 1
+
+#if JUCE_GCC || JUCE_CLANG
+ #define JUCE_ZLIB_PCLMUL_TARGET __attribute__ ((target ("pclmul")))
+#else
+ #define JUCE_ZLIB_PCLMUL_TARGET
+#endif
+
+static bool juce_crc32_pclmul_available() noexcept
+{
+    static const bool available = []
+    {
+       #if JUCE_MSVC
+        int info[4] = {};
+        __cpuid (info, 1);
+        return (info[2] & (1 << 1)) != 0;
+       #else
+        unsigned int a = 0, b = 0, c = 0, d = 0;
+        return __get_cpuid (1, &a, &b, &c, &d) != 0 && (c & (1u << 1)) != 0;
+       #endif
+    }();
+
+    return available;
+}
+
+JUCE_ZLIB_PCLMUL_TARGET
+static inline __m128i juce_crc32_fold (__m128i x, __m128i constants, __m128i data) noexcept
+{
+    return _mm_xor_si128 (_mm_xor_si128 (_mm_clmulepi64_si128 (x, constants, 0x00),
+                                         _mm_clmulepi64_si128 (x, constants, 0x11)),
+                          data);
+}
+
+// The length must be a multiple of 16, and at least 64. The CRC is passed in and
+// returned without zlib's inversion.
+JUCE_ZLIB_PCLMUL_TARGET
+static uint32_t juce_crc32_pclmul (uint32_t crc, const unsigned char* buf, z_size_t len) noexcept
+{
+    const auto fourBlocks = _mm_set_epi64x (0x01c6e41596, 0x0154442bd4);
+    const auto oneBlock   = _mm_set_epi64x (0x00ccaa009e, 0x01751997d0);
+    const auto to32Bits   = _mm_set_epi64x (0, 0x0163cd6124);
+    const auto barrett    = _mm_set_epi64x (0x01f7011641, 0x01db710641);
+    const auto low32Bits  = _mm_set_epi32 (0, 0, 0, -1);
+
+    const auto* p = reinterpret_cast<const __m128i*> (buf);
+
+    auto x1 = _mm_xor_si128 (_mm_loadu_si128 (p), _mm_cvtsi32_si128 ((int) crc));
+    auto x2 = _mm_loadu_si128 (p + 1);
+    auto x3 = _mm_loadu_si128 (p + 2);
+    auto x4 = _mm_loadu_si128 (p + 3);
+    p += 4;
+    len -= 64;
+
+    for (; len >= 64; len -= 64, p += 4)
+    {
+        x1 = juce_crc32_fold (x1, fourBlocks, _mm_loadu_si128 (p));
+        x2 = juce_crc32_fold (x2, fourBlocks, _mm_loadu_si128 (p + 1));
+        x3 = juce_crc32_fold (x3, fourBlocks, _mm_loadu_si128 (p + 2));
+        x4 = juce_crc32_fold (x4, fourBlocks, _mm_loadu_si128 (p + 3));
+    }
+
+    x1 = juce_crc32_fold (x1, oneBlock, x2);
+    x1 = juce_crc32_fold (x1, oneBlock, x3);
+    x1 = juce_crc32_fold (x1, oneBlock, x4);
+
+    for (; len >= 16; len -= 16, ++p)
+        x1 = juce_crc32_fold (x1, oneBlock, _mm_loadu_si128 (p));
+
+    // 128 bits to 64
+    x1 = _mm_xor_si128 (_mm_clmulepi64_si128 (x1, oneBlock, 0x10), _mm_srli_si128 (x1, 8));
+
+    // 64 bits to 32
+    x1 = _mm_xor_si128 (_mm_clmulepi64_si128 (_mm_and_si128 (x1, low32Bits), to32Bits, 0x00), _mm_srli_si128 (x1, 4));
+
+    // Barrett reduction
+    auto t = _mm_clmulepi64_si128 (_mm_and_si128 (x1, low32Bits), barrett, 0x10);
+    t = _mm_clmulepi64_si128 (_mm_and_si128 (t, low32Bits), barrett, 0x00);
+
+    return (uint32_t) _mm_cvtsi128_si32 (_mm_srli_si128 (_mm_xor_si128 (x1, t), 4));
+}
+
+#endif
+
+//==============================================================================
+#if JUCE_USE_ACCELERATED_ZLIB
+
+// Used by deflate's longest_match() to find how far two strings match, comparing
+// a word at a time rather than a byte at a time.
+#define JUCE_ZLIB_FAST_COMPARE 1
+
+static inline int juce_zlib_match_length (const unsigned char* a, const unsigned char* b, int maxLength) noexcept
+{
+    int n = 0;
+
+    for (; n + 8 <= maxLength; n += 8)
+    {
+        uint64_t x, y;
+        memcpy (&x, a + n, 8);
+        memcpy (&y, b + n, 8);
+
+        if (x != y)
+            break;
+    }
+
+    while (n < maxLength && a[n] == b[n])
+        ++n;
+
+    return n;
+}
+
+// Used by inflate_fast() to copy a match from earlier in the output. When the match
+// starts at least 8 bytes back, each word that's read has already been written.
+#define JUCE_ZLIB_FAST_COPY 1
+
+static inline unsigned char* juce_zlib_copy_match (unsigned char* out, const unsigned char* from, unsigned len) noexcept
+{
+    for (; len >= 8; len -= 8, out += 8, from += 8)
+        memcpy (out, from, 8);
+
+    while (len-- > 0)
+        *out++ = *from++;
+
+    return out;
+}
+
+#endif
@@ -62,6 +62,11 @@ uLong ZEXPORT adler32_z(uLong adler, const Bytef *buf, z_size_t len) {
     unsigned long sum2;
     unsigned n;
 
+#ifdef JUCE_ZLIB_ADLER32_SIMD
+    if (buf != Z_NULL && len >= 64)
+        return juce_adler32_simd(adler, buf, len);
+#endif
+
     /* split Adler-32 into component sums */
     sum2 = (adler >> 16) & 0xffff;
     adler &= 0xffff;
@@ -703,6 +703,15 @@ unsigned long ZEXPORT crc32_z(unsigned long crc, const unsigned char FAR *buf,
     /* Pre-condition the CRC */
     crc = (~crc) & 0xffffffff;
 
+#ifdef JUCE_ZLIB_CRC32_PCLMUL
+    if (len >= 64 && juce_crc32_pclmul_available()) {
+        z_size_t num = len & ~(z_size_t)15;
+        crc = juce_crc32_pclmul((uint32_t)crc, buf, num);
+        buf += num;
+        len -= num;
+    }
+#endif
+
 #ifdef W
 
     /* If provided enough bytes, do a braided CRC calculation. */
@@ -1452,6 +1452,11 @@ local uInt longest_match(deflate_state *s, IPos cur_match) {
         scan += 2, match++;
         Assert(*scan == *match, "match[2]?");
 
+#ifdef JUCE_ZLIB_FAST_COMPARE
+        len = 3 + juce_zlib_match_length(scan + 1, match + 1, MAX_MATCH - 3);
+        scan -= 2;
+        (void)strend;
+#else
         /* We check for insufficient lookahead only every 8th comparison;
          * the 256th check will be made at strstart + 258.
          */
@@ -1467,6 +1472,7 @@ local uInt longest_match(deflate_state *s, IPos cur_match) {
 
         len = MAX_MATCH - (int)(strend - scan);
         scan = strend - MAX_MATCH;
+#endif
 
 #endif /* UNALIGNED_OK */
 
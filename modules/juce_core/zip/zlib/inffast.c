@@ -247,16 +247,23 @@ void ZLIB_INTERNAL inflate_fast(z_streamp strm, unsigned start) {
                 }
                 else {
                     from = out - dist;          /* copy direct from output */
-                    do {                        /* minimum length is three */
-                        *out++ = *from++;
-                        *out++ = *from++;
-                        *out++ = *from++;
-                        len -= 3;
-                    } while (len > 2);
-                    if (len) {
-                        *out++ = *from++;
-                        if (len > 1)
+#ifdef JUCE_ZLIB_FAST_COPY
+                    if (dist >= 8)
+                        out = juce_zlib_copy_match(out, from, len);
+                    else
+#endif
+                    {
+                        do {                    /* minimum length is three */
+                            *out++ = *from++;
+                            *out++ = *from++;
                             *out++ = *from++;
+                            len -= 3;
+                        } while (len > 2);
+                        if (len) {
+                            *out++ = *from++;
+                            if (len > 1)
+                                *out++ = *from++;
+                        }
                     }
                 }
             }
@@ -1101,6 +1101,22 @@ ValueTree ValueTree::readFromGZIPData (const void* data, size_t numBytes)
     return readFromStream (gzipStream);
 }
 
+ValueTree ValueTree::readFromLZ4Data (const void* data, size_t numBytes)
+{
+    MemoryInputStream in (data, numBytes, false);
+    LZ4DecompressorInputStream lz4Stream (in);
+    return readFromStream (lz4Stream);
+}
+
+#if JUCE_USE_ZSTD
+ValueTree ValueTree::readFromZstdData (const void* data, size_t numBytes)
+{
+    MemoryInputStream in (data, numBytes, false);
+    ZstdDecompressorInputStream zstdStream (in);
+    return readFromStream (zstdStream);
+}
+#endif
+
 void ValueTree::Listener::valueTreePropertyChanged   (ValueTree&, const Identifier&) {}
 void ValueTree::Listener::valueTreeChildAdded        (ValueTree&, ValueTree&)        {}
 void ValueTree::Listener::valueTreeChildRemoved      (ValueTree&, ValueTree&, int)   {}
@@ -1211,6 +1227,22 @@ public:
                 }
                 expect (v1.isEquivalentTo (ValueTree::readFromGZIPData (zipped.getData(), zipped.getDataSize())));
 
+                MemoryOutputStream lz4;
+                {
+                    LZ4CompressorOutputStream lz4Out (lz4);
+                    v1.writeToStream (lz4Out);
+                }
+                expect (v1.isEquivalentTo (ValueTree::readFromLZ4Data (lz4.getData(), lz4.getDataSize())));
+
+               #if JUCE_USE_ZSTD
+                MemoryOutputStream zstd;
+                {
+                    ZstdCompressorOutputStream zstdOut (zstd);
+                    v1.writeToStream (zstdOut);
+                }
+                expect (v1.isEquivalentTo (ValueTree::readFromZstdData (zstd.getData(), zstd.getDataSize())));
+               #endif
+
                 auto xml1 = v1.createXml();
                 auto xml2 = v2.createCopy().createXml();
                 expect (xml1->isEquivalentTo (xml2.get(), false));
@@ -480,6 +480,18 @@ public:
     */
     static ValueTree readFromGZIPData (const void* data, size_t numBytes);
 
+    /** Reloads a tree from a data block that was written with writeToStream() and
+        then compressed using LZ4CompressorOutputStream.
+    */
+    static ValueTree readFromLZ4Data (const void* data, size_t numBytes);
+
+   #if JUCE_USE_ZSTD || DOXYGEN
+    /** Reloads a tree from a data block that was written with writeToStream() and
+        then compressed using ZstdCompressorOutputStream.
+    */
+    static ValueTree readFromZstdData (const void* data, size_t numBytes);
+   #endif
+
     //==============================================================================
     /** Listener class for events that happen to a ValueTree.
 
@@ -628,6 +640,7 @@ public:
 private:
     //==============================================================================
     friend class SharedObject;
+    friend class ValueTreeSnapshotPublisher;
 
     ReferenceCountedObjectPtr<SharedObject> object;
     ListenerList<Listener> listeners;
@@ -0,0 +1,656 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/*  A persistent, size-balanced AVL tree holding the children of a node by index.
+    Updates copy the O (log n) nodes on the path to the changed element, and share
+    everything else with the previous version.
+*/
+class ValueTreeSnapshot::ChildList final : public ReferenceCountedObject
+{
+public:
+    using Ptr = ReferenceCountedObjectPtr<ChildList>;
+    using NodePtr = ReferenceCountedObjectPtr<Node>;
+
+    ChildList (Ptr l, NodePtr v, Ptr r) noexcept
+        : left (std::move (l)), right (std::move (r)), value (std::move (v)),
+          size (sizeOf (left) + sizeOf (right) + 1),
+          height (jmax (heightOf (left), heightOf (right)) + 1)
+    {}
+
+    static int sizeOf (const Ptr& t) noexcept     { return t != nullptr ? t->size : 0; }
+    static int heightOf (const Ptr& t) noexcept   { return t != nullptr ? t->height : 0; }
+
+    static Ptr build (const NodePtr* items, int num)
+    {
+        if (num <= 0)
+            return {};
+
+        auto mid = num / 2;
+        return new ChildList (build (items, mid), items[mid], build (items + mid + 1, num - mid - 1));
+    }
+
+    static Node* get (const ChildList* t, int index) noexcept
+    {
+        while (t != nullptr)
+        {
+            auto leftSize = sizeOf (t->left);
+
+            if (index < leftSize)
+            {
+                t = t->left.get();
+            }
+            else if (index == leftSize)
+            {
+                return t->value.get();
+            }
+            else
+            {
+                index -= leftSize + 1;
+                t = t->right.get();
+            }
+        }
+
+        return nullptr;
+    }
+
+    static Ptr set (const ChildList& t, int index, NodePtr newValue)
+    {
+        auto leftSize = sizeOf (t.left);
+
+        if (index < leftSize)   return new ChildList (set (*t.left, index, std::move (newValue)), t.value, t.right);
+        if (index == leftSize)  return new ChildList (t.left, std::move (newValue), t.right);
+
+        return new ChildList (t.left, t.value, set (*t.right, index - leftSize - 1, std::move (newValue)));
+    }
+
+    static Ptr insert (const ChildList* t, int index, NodePtr newValue)
+    {
+        if (t == nullptr)
+            return new ChildList (nullptr, std::move (newValue), nullptr);
+
+        auto leftSize = sizeOf (t->left);
+
+        if (index <= leftSize)
+            return balance (insert (t->left.get(), index, std::move (newValue)), t->value, t->right);
+
+        return balance (t->left, t->value, insert (t->right.get(), index - leftSize - 1, std::move (newValue)));
+    }
+
+    static Ptr remove (const ChildList& t, int index)
+    {
+        auto leftSize = sizeOf (t.left);
+
+        if (index < leftSize)
+            return balance (remove (*t.left, index), t.value, t.right);
+
+        if (index > leftSize)
+            return balance (t.left, t.value, remove (*t.right, index - leftSize - 1));
+
+        if (t.left == nullptr)   return t.right;
+        if (t.right == nullptr)  return t.left;
+
+        auto* successor = get (t.right.get(), 0);
+        return balance (t.left, successor, remove (*t.right, 0));
+    }
+
+    template <typename Callback>
+    static void forEach (const ChildList* t, Callback&& callback)
+    {
+        while (t != nullptr)
+        {
+            forEach (t->left.get(), callback);
+            callback (*t->value);
+            t = t->right.get();
+        }
+    }
+
+    const Ptr left, right;
+    const NodePtr value;
+    const int size, height;
+
+private:
+    static Ptr balance (Ptr l, NodePtr v, Ptr r)
+    {
+        auto hl = heightOf (l), hr = heightOf (r);
+
+        if (hl > hr + 1)
+        {
+            if (heightOf (l->left) >= heightOf (l->right))
+                return new ChildList (l->left, l->value, new ChildList (l->right, std::move (v), std::move (r)));
+
+            return new ChildList (new ChildList (l->left, l->value, l->right->left),
+                                  l->right->value,
+                                  new ChildList (l->right->right, std::move (v), std::move (r)));
+        }
+
+        if (hr > hl + 1)
+        {
+            if (heightOf (r->right) >= heightOf (r->left))
+                return new ChildList (new ChildList (std::move (l), std::move (v), r->left), r->value, r->right);
+
+            return new ChildList (new ChildList (std::move (l), std::move (v), r->left->left),
+                                  r->left->value,
+                                  new ChildList (r->left->right, r->value, r->right));
+        }
+
+        return new ChildList (std::move (l), std::move (v), std::move (r));
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (ChildList)
+};
+
+//==============================================================================
+class ValueTreeSnapshot::Node final : public ReferenceCountedObject
+{
+public:
+    using Ptr = ReferenceCountedObjectPtr<Node>;
+
+    Node (const Identifier& t, NamedValueSet p, ChildList::Ptr c) noexcept
+        : type (t), properties (std::move (p)), children (std::move (c))
+    {}
+
+    static Ptr create (const ValueTree& source)
+    {
+        Array<Ptr> childNodes;
+        childNodes.ensureStorageAllocated (source.getNumChildren());
+
+        for (const auto& child : source)
+            childNodes.add (create (child));
+
+        NamedValueSet props;
+
+        for (int i = 0; i < source.getNumProperties(); ++i)
+        {
+            auto name = source.getPropertyName (i);
+            props.set (name, source.getProperty (name));
+        }
+
+        return new Node (source.getType(), std::move (props),
+                         ChildList::build (childNodes.begin(), childNodes.size()));
+    }
+
+    ValueTree createValueTree() const
+    {
+        ValueTree result (type);
+
+        for (int i = 0; i < properties.size(); ++i)
+            result.setProperty (properties.getName (i), properties.getValueAt (i), nullptr);
+
+        ChildList::forEach (children.get(), [&] (const Node& child)
+        {
+            result.appendChild (child.createValueTree(), nullptr);
+        });
+
+        return result;
+    }
+
+    int getNumChildren() const noexcept     { return ChildList::sizeOf (children); }
+
+    bool isEquivalentTo (const Node& other) const
+    {
+        if (this == &other)
+            return true;
+
+        if (type != other.type
+             || properties != other.properties
+             || getNumChildren() != other.getNumChildren())
+            return false;
+
+        for (int i = 0; i < getNumChildren(); ++i)
+            if (! ChildList::get (children.get(), i)->isEquivalentTo (*ChildList::get (other.children.get(), i)))
+                return false;
+
+        return true;
+    }
+
+    bool isEquivalentTo (const ValueTree& other) const
+    {
+        if (type != other.getType()
+             || properties.size() != other.getNumProperties()
+             || getNumChildren() != other.getNumChildren())
+            return false;
+
+        for (int i = 0; i < properties.size(); ++i)
+        {
+            auto* otherValue = other.getPropertyPointer (properties.getName (i));
+
+            if (otherValue == nullptr || *otherValue != properties.getValueAt (i))
+                return false;
+        }
+
+        auto index = 0;
+        auto result = true;
+
+        ChildList::forEach (children.get(), [&] (const Node& child)
+        {
+            result = result && child.isEquivalentTo (other.getChild (index++));
+        });
+
+        return result;
+    }
+
+    const Identifier type;
+    const NamedValueSet properties;
+    const ChildList::Ptr children;
+
+private:
+    JUCE_DECLARE_NON_COPYABLE (Node)
+};
+
+//==============================================================================
+ValueTreeSnapshot::ValueTreeSnapshot() noexcept = default;
+
+ValueTreeSnapshot::ValueTreeSnapshot (const Identifier& type)
+    : node (new Node (type, {}, {}))
+{
+    jassert (type.toString().isNotEmpty()); // All objects must be given a sensible type name!
+}
+
+ValueTreeSnapshot::ValueTreeSnapshot (const ValueTree& source)
+    : node (source.isValid() ? Node::create (source) : nullptr)
+{
+}
+
+ValueTreeSnapshot::ValueTreeSnapshot (Node* n) noexcept : node (n) {}
+
+ValueTreeSnapshot::ValueTreeSnapshot (const ValueTreeSnapshot&) noexcept = default;
+ValueTreeSnapshot::ValueTreeSnapshot (ValueTreeSnapshot&&) noexcept = default;
+ValueTreeSnapshot& ValueTreeSnapshot::operator= (const ValueTreeSnapshot&) noexcept = default;
+ValueTreeSnapshot& ValueTreeSnapshot::operator= (ValueTreeSnapshot&&) noexcept = default;
+ValueTreeSnapshot::~ValueTreeSnapshot() = default;
+
+bool ValueTreeSnapshot::operator== (const ValueTreeSnapshot& other) const noexcept  { return node == other.node; }
+bool ValueTreeSnapshot::operator!= (const ValueTreeSnapshot& other) const noexcept  { return node != other.node; }
+
+bool ValueTreeSnapshot::isEquivalentTo (const ValueTreeSnapshot& other) const
+{
+    return node == other.node
+            || (node != nullptr && other.node != nullptr && node->isEquivalentTo (*other.node));
+}
+
+bool ValueTreeSnapshot::isEquivalentTo (const ValueTree& other) const
+{
+    if (node == nullptr || ! other.isValid())
+        return node == nullptr && ! other.isValid();
+
+    return node->isEquivalentTo (other);
+}
+
+ValueTree ValueTreeSnapshot::createValueTree() const
+{
+    return node != nullptr ? node->createValueTree() : ValueTree();
+}
+
+//==============================================================================
+Identifier ValueTreeSnapshot::getType() const noexcept
+{
+    return node != nullptr ? node->type : Identifier();
+}
+
+bool ValueTreeSnapshot::hasType (const Identifier& typeName) const noexcept
+{
+    return node != nullptr && node->type == typeName;
+}
+
+const var& ValueTreeSnapshot::getProperty (const Identifier& name) const noexcept
+{
+    if (auto* v = getPropertyPointer (name))
+        return *v;
+
+    return getNullVarRef();
+}
+
+var ValueTreeSnapshot::getProperty (const Identifier& name, const var& defaultReturnValue) const
+{
+    if (auto* v = getPropertyPointer (name))
+        return *v;
+
+    return defaultReturnValue;
+}
+
+const var* ValueTreeSnapshot::getPropertyPointer (const Identifier& name) const noexcept
+{
+    return node != nullptr ? node->properties.getVarPointer (name) : nullptr;
+}
+
+const var& ValueTreeSnapshot::operator[] (const Identifier& name) const noexcept
+{
+    return getProperty (name);
+}
+
+bool ValueTreeSnapshot::hasProperty (const Identifier& name) const noexcept
+{
+    return getPropertyPointer (name) != nullptr;
+}
+
+int ValueTreeSnapshot::getNumProperties() const noexcept
+{
+    return node != nullptr ? node->properties.size() : 0;
+}
+
+Identifier ValueTreeSnapshot::getPropertyName (int index) const noexcept
+{
+    return node != nullptr ? node->properties.getName (index) : Identifier();
+}
+
+//==============================================================================
+int ValueTreeSnapshot::getNumChildren() const noexcept
+{
+    return node != nullptr ? node->getNumChildren() : 0;
+}
+
+ValueTreeSnapshot ValueTreeSnapshot::getChild (int index) const
+{
+    if (isPositiveAndBelow (index, getNumChildren()))
+        return ValueTreeSnapshot (ChildList::get (node->children.get(), index));
+
+    return {};
+}
+
+void ValueTreeSnapshot::visitChildren (void (*callback) (void*, const ValueTreeSnapshot&), void* context) const
+{
+    if (node != nullptr)
+        ChildList::forEach (node->children.get(), [=] (const Node& child)
+        {
+            callback (context, ValueTreeSnapshot (const_cast<Node*> (&child)));
+        });
+}
+
+ValueTreeSnapshot ValueTreeSnapshot::getChildWithName (const Identifier& type) const
+{
+    for (int i = 0; i < getNumChildren(); ++i)
+        if (auto* child = ChildList::get (node->children.get(), i); child->type == type)
+            return ValueTreeSnapshot (child);
+
+    return {};
+}
+
+ValueTreeSnapshot ValueTreeSnapshot::getChildWithProperty (const Identifier& propertyName, const var& propertyValue) const
+{
+    for (int i = 0; i < getNumChildren(); ++i)
+    {
+        auto* child = ChildList::get (node->children.get(), i);
+
+        if (auto* v = child->properties.getVarPointer (propertyName); v != nullptr && *v == propertyValue)
+            return ValueTreeSnapshot (child);
+    }
+
+    return {};
+}
+
+//==============================================================================
+ValueTreeSnapshot ValueTreeSnapshot::withProperty (const Identifier& name, const var& newValue) const
+{
+    jassert (node != nullptr);        // Trying to change an invalid snapshot?
+    jassert (name.toString().isNotEmpty());
+
+    if (node == nullptr)
+        return {};
+
+    if (auto* existing = node->properties.getVarPointer (name); existing != nullptr && existing->equalsWithSameType (newValue))
+        return *this;
+
+    auto props = node->properties;
+    props.set (name, newValue);
+    return ValueTreeSnapshot (new Node (node->type, std::move (props), node->children));
+}
+
+ValueTreeSnapshot ValueTreeSnapshot::withoutProperty (const Identifier& name) const
+{
+    if (! hasProperty (name))
+        return *this;
+
+    auto props = node->properties;
+    props.remove (name);
+    return ValueTreeSnapshot (new Node (node->type, std::move (props), node->children));
+}
+
+ValueTreeSnapshot ValueTreeSnapshot::withChild (int index, const ValueTreeSnapshot& newChild) const
+{
+    jassert (newChild.isValid());
+    jassert (isPositiveAndBelow (index, getNumChildren()));
+
+    if (! (newChild.isValid() && isPositiveAndBelow (index, getNumChildren())))
+        return *this;
+
+    if (ChildList::get (node->children.get(), index) == newChild.node.get())
+        return *this;
+
+    return ValueTreeSnapshot (new Node (node->type, node->properties,
+                                        ChildList::set (*node->children, index, newChild.node)));
+}
+
+ValueTreeSnapshot ValueTreeSnapshot::withChildInserted (const ValueTreeSnapshot& newChild, int index) const
+{
+    jassert (node != nullptr && newChild.isValid());
+
+    if (node == nullptr || ! newChild.isValid())
+        return *this;
+
+    if (! isPositiveAndNotGreaterThan (index, getNumChildren()))
+        index = getNumChildren();
+
+    return ValueTreeSnapshot (new Node (node->type, node->properties,
+                                        ChildList::insert (node->children.get(), index, newChild.node)));
+}
+
+ValueTreeSnapshot ValueTreeSnapshot::withChildRemoved (int index) const
+{
+    if (! isPositiveAndBelow (index, getNumChildren()))
+        return *this;
+
+    return ValueTreeSnapshot (new Node (node->type, node->properties,
+                                        ChildList::remove (*node->children, index)));
+}
+
+ValueTreeSnapshot ValueTreeSnapshot::withChildMoved (int currentIndex, int newIndex) const
+{
+    auto numChildren = getNumChildren();
+
+    if (currentIndex == newIndex || ! isPositiveAndBelow (currentIndex, numChildren))
+        return *this;
+
+    if (! isPositiveAndBelow (newIndex, numChildren))
+        newIndex = numChildren - 1;
+
+    Node::Ptr child (ChildList::get (node->children.get(), currentIndex));
+    auto removed = ChildList::remove (*node->children, currentIndex);
+
+    return ValueTreeSnapshot (new Node (node->type, node->properties,
+                                        ChildList::insert (removed.get(), newIndex, std::move (child))));
+}
+
+//==============================================================================
+ValueTreeSnapshotPublisher::ValueTreeSnapshotPublisher (const ValueTree& treeToTrack, bool publishAutomatically)
+    : tree (treeToTrack), pending (treeToTrack), autoPublish (publishAutomatically)
+{
+    publish();
+    tree.addListener (this);
+}
+
+ValueTreeSnapshotPublisher::~ValueTreeSnapshotPublisher()
+{
+    tree.removeListener (this);
+
+    if (auto* last = published.exchange (nullptr))
+        retired.push_back (last);
+
+    // Make sure nobody is still reading from this object before it goes away
+    while (numActiveReaders[0].load() != 0 || numActiveReaders[1].load() != 0)
+        Thread::yield();
+
+    for (auto* n : awaitingRelease)
+        n->decReferenceCount();
+
+    for (auto* n : retired)
+        n->decReferenceCount();
+}
+
+ValueTreeSnapshot ValueTreeSnapshotPublisher::getSnapshot() const noexcept
+{
+    // The reader count stops the writer from releasing its reference to the
+    // published node while we're between loading the pointer and taking our own.
+    auto& readers = numActiveReaders[epoch.load() & 1];
+    ++readers;
+    ValueTreeSnapshot result (published.load());
+    --readers;
+    return result;
+}
+
+void ValueTreeSnapshotPublisher::publish()
+{
+    auto* newNode = pending.node.get();
+
+    if (newNode != nullptr)
+        newNode->incReferenceCount();
+
+    if (auto* old = published.exchange (newNode))
+        retired.push_back (old);
+
+    releaseRetiredSnapshots();
+}
+
+void ValueTreeSnapshotPublisher::releaseRetiredSnapshots()
+{
+    // Readers that registered in the previous epoch's slot may have loaded a pointer that
+    // was retired before the current epoch began. No new readers join that slot, so once it
+    // has emptied, those nodes can go. Starting a new epoch then separates the readers that
+    // might have seen the nodes retired since from the ones that can't have.
+    if (numActiveReaders[(epoch.load() + 1) & 1].load() != 0)
+        return;
+
+    for (auto* n : awaitingRelease)
+        n->decReferenceCount();
+
+    awaitingRelease.clear();
+
+    if (! retired.empty())
+    {
+        std::swap (awaitingRelease, retired);
+        ++epoch;
+    }
+}
+
+void ValueTreeSnapshotPublisher::changed()
+{
+    if (autoPublish)
+        publish();
+}
+
+template <typename Function>
+void ValueTreeSnapshotPublisher::applyChange (const ValueTree& changedTree, Function&& function)
+{
+    Array<int> path;
+
+    for (auto t = changedTree; t != tree; t = t.getParent())
+    {
+        auto parent = t.getParent();
+        jassert (parent.isValid()); // the change must have happened somewhere inside our tree
+
+        if (! parent.isValid())
+            return;
+
+        path.insert (0, getIndexInParent (parent, t));
+    }
+
+    Array<ValueTreeSnapshot> nodesOnPath { pending };
+
+    for (auto index : path)
+        nodesOnPath.add (nodesOnPath.getReference (nodesOnPath.size() - 1).getChild (index));
+
+    auto result = function (nodesOnPath.getLast());
+
+    for (auto i = path.size(); --i >= 0;)
+        result = nodesOnPath.getReference (i).withChild (path.getUnchecked (i), result);
+
+    pending = std::move (result);
+    changed();
+}
+
+int ValueTreeSnapshotPublisher::getIndexInParent (const ValueTree& parent, const ValueTree& child)
+{
+    // Checking a remembered position is O (1), so the parent's children only need to be
+    // searched if the child hasn't been seen before, or has moved since.
+    auto& index = childIndexes[child.object.get()];
+
+    if (parent.getChild (index) != child)
+        index = parent.indexOf (child);
+
+    return index;
+}
+
+void ValueTreeSnapshotPublisher::forgetChildIndexes (const ValueTree& removedTree)
+{
+    childIndexes.erase (removedTree.object.get());
+
+    for (const auto& child : removedTree)
+        forgetChildIndexes (child);
+}
+
+void ValueTreeSnapshotPublisher::valueTreePropertyChanged (ValueTree& t, const Identifier& property)
+{
+    applyChange (t, [&] (const ValueTreeSnapshot& s)
+    {
+        if (auto* v = t.getPropertyPointer (property))
+            return s.withProperty (property, *v);
+
+        return s.withoutProperty (property);
+    });
+}
+
+void ValueTreeSnapshotPublisher::valueTreeChildAdded (ValueTree& parent, ValueTree& child)
+{
+    applyChange (parent, [&] (const ValueTreeSnapshot& s)
+    {
+        return s.withChildInserted (ValueTreeSnapshot (child), parent.indexOf (child));
+    });
+}
+
+void ValueTreeSnapshotPublisher::valueTreeChildRemoved (ValueTree& parent, ValueTree& child, int index)
+{
+    forgetChildIndexes (child);
+    applyChange (parent, [&] (const ValueTreeSnapshot& s) { return s.withChildRemoved (index); });
+}
+
+void ValueTreeSnapshotPublisher::valueTreeChildOrderChanged (ValueTree& parent, int oldIndex, int newIndex)
+{
+    applyChange (parent, [&] (const ValueTreeSnapshot& s) { return s.withChildMoved (oldIndex, newIndex); });
+}
+
+} // namespace juce
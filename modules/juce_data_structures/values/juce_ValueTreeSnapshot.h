@@ -0,0 +1,333 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    An immutable copy of a ValueTree, which can safely be shared between threads.
+
+    A ValueTreeSnapshot holds the same type, properties and children as the
+    ValueTree that it was created from, but it can never be modified. Instead,
+    methods such as withProperty() or withChildRemoved() return a new snapshot
+    containing the change. The new snapshot shares every node that wasn't touched
+    by the change with the original, so an edit to a deeply-nested node only
+    re-creates the nodes on the path from the root down to that node, and the
+    children of each node are kept in a balanced tree so that each step of that
+    path costs O (log numChildren).
+
+    Because nothing inside a snapshot ever changes after it has been created, it's
+    safe to read the same snapshot from any number of threads without locking.
+    Note that properties holding reference-counted objects (e.g. a DynamicObject
+    or an Array inside a var) are shared rather than copied, so you shouldn't
+    modify those objects once they've been put into a snapshot.
+
+    To keep a snapshot in sync with a live ValueTree and make it available to other
+    threads, use a ValueTreeSnapshotPublisher.
+
+    @see ValueTreeSnapshotPublisher, ValueTree
+
+    @tags{DataStructures}
+*/
+class JUCE_API  ValueTreeSnapshot  final
+{
+public:
+    //==============================================================================
+    /** Creates an invalid snapshot. */
+    ValueTreeSnapshot() noexcept;
+
+    /** Creates a snapshot with the given type, and no properties or children. */
+    explicit ValueTreeSnapshot (const Identifier& type);
+
+    /** Creates a snapshot of the current state of a ValueTree and all its sub-trees.
+        This must be called on the thread that owns the ValueTree, and takes O (n) time.
+        If the tree is invalid, this will create an invalid snapshot.
+    */
+    explicit ValueTreeSnapshot (const ValueTree& source);
+
+    /** Creates another reference to the same immutable data. */
+    ValueTreeSnapshot (const ValueTreeSnapshot&) noexcept;
+
+    /** Move constructor. */
+    ValueTreeSnapshot (ValueTreeSnapshot&&) noexcept;
+
+    /** Makes this refer to the same immutable data as another snapshot. */
+    ValueTreeSnapshot& operator= (const ValueTreeSnapshot&) noexcept;
+
+    /** Move assignment operator. */
+    ValueTreeSnapshot& operator= (ValueTreeSnapshot&&) noexcept;
+
+    /** Destructor. */
+    ~ValueTreeSnapshot();
+
+    //==============================================================================
+    /** Returns true if both snapshots refer to the same shared node.
+        Because unchanged nodes are shared between snapshots, this is a very quick way of
+        finding out whether a sub-tree was left untouched by an edit. Two independently
+        created snapshots holding the same data are not considered equal.
+        @see isEquivalentTo
+    */
+    bool operator== (const ValueTreeSnapshot&) const noexcept;
+
+    /** Returns true if the snapshots refer to different nodes.
+        @see isEquivalentTo
+    */
+    bool operator!= (const ValueTreeSnapshot&) const noexcept;
+
+    /** Performs a deep comparison between the properties and children of two snapshots.
+        Any shared sub-trees are skipped without being compared.
+    */
+    bool isEquivalentTo (const ValueTreeSnapshot&) const;
+
+    /** Performs a deep comparison between this snapshot and a ValueTree. */
+    bool isEquivalentTo (const ValueTree&) const;
+
+    /** Returns true if this snapshot refers to some valid data. */
+    bool isValid() const noexcept                           { return node != nullptr; }
+
+    /** Creates a new, independent ValueTree containing a deep copy of this snapshot. */
+    ValueTree createValueTree() const;
+
+    //==============================================================================
+    /** Returns the type of this node. */
+    Identifier getType() const noexcept;
+
+    /** Returns true if the node has this type. */
+    bool hasType (const Identifier& typeName) const noexcept;
+
+    /** Returns the value of a named property, or a void variant if it doesn't exist. */
+    const var& getProperty (const Identifier& name) const noexcept;
+
+    /** Returns the value of a named property, or defaultReturnValue if it doesn't exist. */
+    var getProperty (const Identifier& name, const var& defaultReturnValue) const;
+
+    /** Returns a pointer to the value of a named property, or nullptr if it doesn't exist. */
+    const var* getPropertyPointer (const Identifier& name) const noexcept;
+
+    /** Returns the value of a named property. This is the same as calling getProperty(). */
+    const var& operator[] (const Identifier& name) const noexcept;
+
+    /** Returns true if the node contains a named property. */
+    bool hasProperty (const Identifier& name) const noexcept;
+
+    /** Returns the total number of properties that the node contains. */
+    int getNumProperties() const noexcept;
+
+    /** Returns the identifier of the property with a given index.
+        @see getNumProperties
+    */
+    Identifier getPropertyName (int index) const noexcept;
+
+    //==============================================================================
+    /** Returns the number of child nodes. */
+    int getNumChildren() const noexcept;
+
+    /** Returns one of the node's children.
+        This takes O (log numChildren) time. If the index is out of range, an invalid
+        snapshot is returned.
+    */
+    ValueTreeSnapshot getChild (int index) const;
+
+    /** Returns the first child with the specified type, or an invalid snapshot. */
+    ValueTreeSnapshot getChildWithName (const Identifier& type) const;
+
+    /** Returns the first child that has the given property set to the given value,
+        or an invalid snapshot.
+    */
+    ValueTreeSnapshot getChildWithProperty (const Identifier& propertyName, const var& propertyValue) const;
+
+    /** Calls a function for each child, in order.
+        This is quicker than calling getChild() in a loop, as it visits each child in
+        O (1) amortised time. The function is passed a const ValueTreeSnapshot&.
+    */
+    template <typename Callback>
+    void forEachChild (Callback&& callback) const
+    {
+        visitChildren ([] (void* context, const ValueTreeSnapshot& child)
+                       {
+                           (*static_cast<std::remove_reference_t<Callback>*> (context)) (child);
+                       },
+                       &callback);
+    }
+
+    //==============================================================================
+    /** Returns a copy of this snapshot with the given property changed or added. */
+    [[nodiscard]] ValueTreeSnapshot withProperty (const Identifier& name, const var& newValue) const;
+
+    /** Returns a copy of this snapshot with the given property removed. */
+    [[nodiscard]] ValueTreeSnapshot withoutProperty (const Identifier& name) const;
+
+    /** Returns a copy of this snapshot in which the child at the given index has been
+        replaced by another snapshot.
+        This is what you'll use to apply a change deeper down the tree, e.g.
+        @code
+        auto newRoot = root.withChild (2, root.getChild (2).withProperty ("gain", 0.5f));
+        @endcode
+    */
+    [[nodiscard]] ValueTreeSnapshot withChild (int index, const ValueTreeSnapshot& newChild) const;
+
+    /** Returns a copy of this snapshot with a new child inserted at the given index.
+        If the index is less than zero or greater than the current number of children,
+        the new child is appended.
+    */
+    [[nodiscard]] ValueTreeSnapshot withChildInserted (const ValueTreeSnapshot& newChild, int index) const;
+
+    /** Returns a copy of this snapshot with the child at the given index removed. */
+    [[nodiscard]] ValueTreeSnapshot withChildRemoved (int index) const;
+
+    /** Returns a copy of this snapshot with one of its children moved to a new index. */
+    [[nodiscard]] ValueTreeSnapshot withChildMoved (int currentIndex, int newIndex) const;
+
+private:
+    //==============================================================================
+    class Node;
+    class ChildList;
+    friend class ValueTreeSnapshotPublisher;
+
+    explicit ValueTreeSnapshot (Node*) noexcept;
+    void visitChildren (void (*) (void*, const ValueTreeSnapshot&), void*) const;
+
+    ReferenceCountedObjectPtr<Node> node;
+};
+
+//==============================================================================
+/**
+    Keeps a ValueTreeSnapshot in sync with a ValueTree, and makes the latest snapshot
+    available to other threads.
+
+    The publisher listens to the tree and applies each change to its snapshot, which
+    only re-creates the nodes between the root and the node that changed. Any thread
+    can then call getSnapshot() to obtain the most recently published version, without
+    locking and without ever waiting for the message thread.
+
+    Applying a change costs O (log numChildren) at each level between the root and the
+    changed node. To find that path, the publisher also needs the position of each node
+    on it within its parent. It remembers the positions that it has looked up before, but
+    the first change to a node, or the first change after its siblings have been added,
+    removed or reordered, has to search the parent's children, which is linear in their
+    number.
+
+    @code
+    // on the message thread:
+    ValueTreeSnapshotPublisher publisher (sessionTree);
+
+    // on the audio thread:
+    auto state = publisher.getSnapshot();
+    auto gain = (float) state.getChild (trackIndex)["gain"];
+    @endcode
+
+    The publisher keeps its own reference to a replaced snapshot until every thread that
+    might have been in the middle of fetching it has finished. That is checked each time
+    publish() is called, so an old snapshot is normally released by the next call, or
+    the one after, however busy the readers are.
+
+    Note that when the last reference to an old snapshot is released, the nodes that it
+    no longer shares with any newer snapshot are deleted on whichever thread released it.
+    If that's a problem for a realtime thread, keep hold of the snapshot on that thread
+    and swap it for a new one at a convenient moment.
+
+    @see ValueTreeSnapshot
+
+    @tags{DataStructures}
+*/
+class JUCE_API  ValueTreeSnapshotPublisher  : private ValueTree::Listener
+{
+public:
+    /** Creates a publisher for the given tree.
+
+        If publishAutomatically is true, each change to the tree will be published as
+        soon as it happens. Otherwise, the changes are accumulated until publish() is
+        called, which lets you make a batch of edits visible all at once.
+
+        This must be created, used and deleted on the thread that owns the tree.
+    */
+    explicit ValueTreeSnapshotPublisher (const ValueTree& treeToTrack, bool publishAutomatically = true);
+
+    /** Destructor. */
+    ~ValueTreeSnapshotPublisher() override;
+
+    /** Returns the most recently published snapshot.
+        This is wait-free, and can be called from any thread.
+    */
+    ValueTreeSnapshot getSnapshot() const noexcept;
+
+    /** Returns a snapshot containing all the changes made to the tree so far, including
+        any that haven't yet been published.
+        This must only be called on the thread that owns the tree.
+    */
+    const ValueTreeSnapshot& getPendingSnapshot() const noexcept    { return pending; }
+
+    /** Makes the current state of the tree visible to getSnapshot().
+        This must only be called on the thread that owns the tree.
+    */
+    void publish();
+
+    /** Returns the tree that is being tracked. */
+    const ValueTree& getTree() const noexcept                       { return tree; }
+
+private:
+    //==============================================================================
+    ValueTree tree;
+    ValueTreeSnapshot pending;
+    const bool autoPublish;
+
+    std::atomic<ValueTreeSnapshot::Node*> published { nullptr };
+
+    // Readers register in the counter chosen by the current epoch. Only readers that arrive
+    // before a publish() can be holding the old pointer, and they'll all be counted in one
+    // slot, while newer readers use the other one.
+    std::atomic<uint32> epoch { 0 };
+    mutable std::atomic<int> numActiveReaders[2] {};
+    std::vector<ValueTreeSnapshot::Node*> retired, awaitingRelease;
+
+    std::unordered_map<const ValueTree::SharedObject*, int> childIndexes;
+
+    template <typename Function>
+    void applyChange (const ValueTree&, Function&&);
+    int getIndexInParent (const ValueTree& parent, const ValueTree& child);
+    void forgetChildIndexes (const ValueTree&);
+    void changed();
+    void releaseRetiredSnapshots();
+
+    void valueTreePropertyChanged (ValueTree&, const Identifier&) override;
+    void valueTreeChildAdded (ValueTree&, ValueTree&) override;
+    void valueTreeChildRemoved (ValueTree&, ValueTree&, int) override;
+    void valueTreeChildOrderChanged (ValueTree&, int, int) override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ValueTreeSnapshotPublisher)
+};
+
+} // namespace juce
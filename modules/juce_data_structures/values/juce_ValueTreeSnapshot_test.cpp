@@ -0,0 +1,387 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+class ValueTreeSnapshotTests final : public UnitTest
+{
+public:
+    ValueTreeSnapshotTests()
+        : UnitTest ("ValueTreeSnapshot", UnitTestCategories::values)
+    {}
+
+    // Keeps fetching snapshots until it's stopped, and checks that the "a" and "b"
+    // properties of every child in each one are the same.
+    struct Reader final : public Thread
+    {
+        explicit Reader (ValueTreeSnapshotPublisher& p) : Thread ("snapshot reader"), publisher (p) {}
+
+        void run() override
+        {
+            while (! threadShouldExit())
+            {
+                auto s = publisher.getSnapshot();
+
+                for (int i = 0; i < s.getNumChildren(); ++i)
+                    if (s.getChild (i)["a"] != s.getChild (i)["b"])
+                        consistent = false;
+            }
+        }
+
+        ValueTreeSnapshotPublisher& publisher;
+        std::atomic<bool> consistent { true };
+    };
+
+    static ValueTree createRandomTree (int depth, Random& r)
+    {
+        ValueTree v ("node" + String (r.nextInt (4)));
+
+        for (int i = r.nextInt (8); --i >= 0;)
+        {
+            switch (r.nextInt (4))
+            {
+                case 0: v.setProperty ("p" + String (r.nextInt (10)), r.nextInt(), nullptr); break;
+                case 1: v.setProperty ("p" + String (r.nextInt (10)), String::toHexString (r.nextInt()), nullptr); break;
+                case 2: v.setProperty ("p" + String (r.nextInt (10)), r.nextDouble(), nullptr); break;
+                case 3: if (depth < 4) v.appendChild (createRandomTree (depth + 1, r), nullptr); break;
+                default: break;
+            }
+        }
+
+        return v;
+    }
+
+    void runTest() override
+    {
+        auto r = getRandom();
+
+        beginTest ("Snapshots are equivalent to their source");
+        {
+            for (int i = 0; i < 20; ++i)
+            {
+                auto tree = createRandomTree (0, r);
+                ValueTreeSnapshot snapshot (tree);
+
+                expect (snapshot.isEquivalentTo (tree));
+                expect (snapshot.createValueTree().isEquivalentTo (tree));
+                expect (ValueTreeSnapshot (tree).isEquivalentTo (snapshot));
+            }
+
+            expect (! ValueTreeSnapshot (ValueTree()).isValid());
+            expect (ValueTreeSnapshot().isEquivalentTo (ValueTree()));
+        }
+
+        beginTest ("Edits leave the original untouched and share unchanged nodes");
+        {
+            ValueTree tree ("root");
+
+            for (int i = 0; i < 10; ++i)
+            {
+                ValueTree track ("track");
+                track.setProperty ("index", i, nullptr);
+
+                for (int j = 0; j < 10; ++j)
+                    track.appendChild (ValueTree ("clip", { { "start", j } }), nullptr);
+
+                tree.appendChild (track, nullptr);
+            }
+
+            ValueTreeSnapshot original (tree);
+            auto edited = original.withChild (3, original.getChild (3).withChild (7, original.getChild (3).getChild (7).withProperty ("start", 100)));
+
+            expect (original.isEquivalentTo (tree));
+            expectEquals ((int) original.getChild (3).getChild (7)["start"], 7);
+            expectEquals ((int) edited.getChild (3).getChild (7)["start"], 100);
+
+            expect (edited != original);
+            expect (edited.getChild (3) != original.getChild (3));
+
+            for (int i = 0; i < 10; ++i)
+            {
+                if (i != 3)
+                    expect (edited.getChild (i) == original.getChild (i));
+
+                if (i != 7)
+                    expect (edited.getChild (3).getChild (i) == original.getChild (3).getChild (i));
+            }
+
+            expect (original.withProperty ("missing", var()).hasProperty ("missing"));
+            expect (original.getChild (0).withProperty ("index", 0) == original.getChild (0));
+            expect (! original.getChild (0).withoutProperty ("index").hasProperty ("index"));
+        }
+
+        beginTest ("Child lists match an array after random edits");
+        {
+            ValueTreeSnapshot snapshot ("parent");
+            std::vector<int> expected;
+
+            for (int i = 0; i < 2000; ++i)
+            {
+                auto size = (int) expected.size();
+
+                switch (size == 0 ? 0 : r.nextInt (4))
+                {
+                    case 0:
+                    {
+                        auto index = r.nextInt (size + 1);
+                        snapshot = snapshot.withChildInserted (ValueTreeSnapshot ("child").withProperty ("id", i), index);
+                        expected.insert (expected.begin() + index, i);
+                        break;
+                    }
+
+                    case 1:
+                    {
+                        auto index = r.nextInt (size);
+                        snapshot = snapshot.withChildRemoved (index);
+                        expected.erase (expected.begin() + index);
+                        break;
+                    }
+
+                    case 2:
+                    {
+                        auto from = r.nextInt (size), to = r.nextInt (size);
+                        snapshot = snapshot.withChildMoved (from, to);
+                        auto item = expected[(size_t) from];
+                        expected.erase (expected.begin() + from);
+                        expected.insert (expected.begin() + to, item);
+                        break;
+                    }
+
+                    case 3:
+                    {
+                        auto index = r.nextInt (size);
+                        snapshot = snapshot.withChild (index, ValueTreeSnapshot ("child").withProperty ("id", -i));
+                        expected[(size_t) index] = -i;
+                        break;
+                    }
+
+                    default:
+                        break;
+                }
+            }
+
+            expectEquals (snapshot.getNumChildren(), (int) expected.size());
+
+            auto allMatch = true;
+
+            for (size_t i = 0; i < expected.size(); ++i)
+                allMatch = allMatch && (int) snapshot.getChild ((int) i)["id"] == expected[i];
+
+            expect (allMatch);
+
+            size_t index = 0;
+            snapshot.forEachChild ([&] (const ValueTreeSnapshot& child)
+            {
+                allMatch = allMatch && index < expected.size() && (int) child["id"] == expected[index++];
+            });
+
+            expect (allMatch && index == expected.size());
+        }
+
+        beginTest ("Publisher follows changes to the tree");
+        {
+            auto tree = createRandomTree (0, r);
+            ValueTreeSnapshotPublisher publisher (tree);
+
+            for (int i = 0; i < 200; ++i)
+            {
+                auto target = tree;
+
+                while (target.getNumChildren() > 0 && r.nextBool())
+                    target = target.getChild (r.nextInt (target.getNumChildren()));
+
+                switch (r.nextInt (5))
+                {
+                    case 0:  target.setProperty ("p" + String (r.nextInt (10)), r.nextInt(), nullptr); break;
+                    case 1:  target.removeProperty ("p" + String (r.nextInt (10)), nullptr); break;
+                    case 2:  target.addChild (createRandomTree (3, r), r.nextInt (target.getNumChildren() + 1), nullptr); break;
+                    case 3:  if (target.getNumChildren() > 0) target.removeChild (r.nextInt (target.getNumChildren()), nullptr); break;
+                    case 4:  if (target.getNumChildren() > 0) target.moveChild (r.nextInt (target.getNumChildren()), r.nextInt (target.getNumChildren()), nullptr); break;
+                    default: break;
+                }
+
+                // the publisher remembers where nodes are, so check it keeps up as they move
+                if (i % 10 == 0)
+                    expect (publisher.getSnapshot().isEquivalentTo (tree));
+            }
+
+            expect (publisher.getSnapshot().isEquivalentTo (tree));
+        }
+
+        beginTest ("Manual publishing");
+        {
+            ValueTree tree ("root");
+            ValueTreeSnapshotPublisher publisher (tree, false);
+
+            tree.setProperty ("a", 1, nullptr);
+            expect (! publisher.getSnapshot().hasProperty ("a"));
+            expect (publisher.getPendingSnapshot().hasProperty ("a"));
+
+            publisher.publish();
+            expectEquals ((int) publisher.getSnapshot()["a"], 1);
+        }
+
+        beginTest ("Snapshots can be read while the tree is being edited");
+        {
+            ValueTree tree ("root");
+
+            for (int i = 0; i < 16; ++i)
+                tree.appendChild (ValueTree ("child", { { "a", 0 }, { "b", 0 } }), nullptr);
+
+            ValueTreeSnapshotPublisher publisher (tree, false);
+            Reader reader (publisher);
+            reader.startThread();
+
+            for (int i = 1; i <= 2000; ++i)
+            {
+                auto child = tree.getChild (i % 16);
+                child.setProperty ("a", i, nullptr);
+                child.setProperty ("b", i, nullptr);
+                publisher.publish();
+            }
+
+            reader.stopThread (-1);
+            expect (reader.consistent);
+        }
+
+        beginTest ("Replaced snapshots are released while other threads keep reading");
+        {
+            ValueTree tree ("root");
+            DynamicObject::Ptr object (new DynamicObject());
+            tree.setProperty ("object", object.get(), nullptr);
+
+            ValueTreeSnapshotPublisher publisher (tree);
+            OwnedArray<Reader> readers;
+
+            for (int i = 0; i < 4; ++i)
+                readers.add (new Reader (publisher))->startThread();
+
+            tree.removeProperty ("object", nullptr);
+
+            for (int i = 0; i < 1000 && object->getReferenceCount() > 1; ++i)
+            {
+                tree.setProperty ("counter", i, nullptr);
+                Thread::sleep (1);
+            }
+
+            expectEquals (object->getReferenceCount(), 1);
+
+            for (auto* reader : readers)
+                reader->stopThread (-1);
+        }
+    }
+};
+
+static ValueTreeSnapshotTests valueTreeSnapshotTests;
+
+//==============================================================================
+class ValueTreeSnapshotBenchmarks final : public UnitTest
+{
+public:
+    ValueTreeSnapshotBenchmarks()
+        : UnitTest ("ValueTreeSnapshot benchmarks", UnitTestCategories::benchmarks)
+    {}
+
+    // A session with 100 tracks, each holding 1000 clips, i.e. 100k nodes.
+    static ValueTree createSessionTree()
+    {
+        ValueTree session ("Session");
+
+        for (int t = 0; t < 100; ++t)
+        {
+            ValueTree track ("Track", { { "name", "Track " + String (t) }, { "gain", 1.0 } });
+
+            for (int c = 0; c < 1000; ++c)
+                track.appendChild (ValueTree ("Clip", { { "start", c * 4 }, { "length", 4 }, { "file", "audio.wav" } }), nullptr);
+
+            session.appendChild (track, nullptr);
+        }
+
+        return session;
+    }
+
+    template <typename Fn>
+    double timeInMicroseconds (int numRepeats, Fn&& fn)
+    {
+        auto start = Time::getMillisecondCounterHiRes();
+
+        for (int i = 0; i < numRepeats; ++i)
+            fn (i);
+
+        return (Time::getMillisecondCounterHiRes() - start) * 1000.0 / numRepeats;
+    }
+
+    void runTest() override
+    {
+        beginTest ("100k node session tree");
+
+        auto session = createSessionTree();
+        ValueTreeSnapshot snapshot;
+
+        auto fullCopy = timeInMicroseconds (3, [&] (int) { snapshot = ValueTreeSnapshot (session); });
+        logMessage ("Full snapshot: " + String (fullCopy / 1000.0, 2) + " ms");
+
+        auto r = getRandom();
+
+        auto edit = timeInMicroseconds (10000, [&] (int i)
+        {
+            auto t = r.nextInt (100), c = r.nextInt (1000);
+            auto track = snapshot.getChild (t);
+            snapshot = snapshot.withChild (t, track.withChild (c, track.getChild (c).withProperty ("start", i)));
+        });
+
+        logMessage ("Snapshot edit of a clip: " + String (edit, 2) + " us");
+
+        ValueTreeSnapshotPublisher publisher (session);
+
+        auto tracked = timeInMicroseconds (10000, [&] (int i)
+        {
+            session.getChild (r.nextInt (100)).setProperty ("gain", i * 0.001, nullptr);
+        });
+
+        logMessage ("ValueTree track edit + publish: " + String (tracked, 2) + " us");
+
+        snapshot = {};
+        auto read = timeInMicroseconds (100000, [&] (int) { snapshot = publisher.getSnapshot(); });
+        logMessage ("getSnapshot(): " + String (read * 1000.0, 1) + " ns");
+
+        expect (publisher.getSnapshot().isEquivalentTo (session));
+    }
+};
+
+static ValueTreeSnapshotBenchmarks valueTreeSnapshotBenchmarks;
+
+} // namespace juce
@@ -44,7 +44,9 @@ namespace ValueTreeSynchroniserHelpers
         childAdded       = 3,
         childRemoved     = 4,
         childMoved       = 5,
-        propertyRemoved  = 6
+        propertyRemoved  = 6,
+        batchedChanges   = 7,
+        compactFullSync  = 8
     };
 
     static void getValueTreePath (ValueTree v, const ValueTree& topLevelTree, Array<int>& path)
@@ -99,8 +101,234 @@ namespace ValueTreeSynchroniserHelpers
 
         return v;
     }
+
+    //==============================================================================
+    // The compact encoding used by batched frames and snapshots.
+
+    static void writeVarInt (MemoryOutputStream& stream, uint64 value)
+    {
+        while (value >= 0x80)
+        {
+            stream.writeByte ((char) ((value & 0x7f) | 0x80));
+            value >>= 7;
+        }
+
+        stream.writeByte ((char) value);
+    }
+
+    static bool readVarInt (MemoryInputStream& input, uint64& result)
+    {
+        result = 0;
+
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            if (input.isExhausted())
+                return false;
+
+            auto byte = (uint8) input.readByte();
+            result |= (uint64) (byte & 0x7f) << shift;
+
+            if ((byte & 0x80) == 0)
+                return true;
+        }
+
+        return false;
+    }
+
+    static bool readVarInt (MemoryInputStream& input, int& result, int limit)
+    {
+        uint64 value;
+
+        if (! readVarInt (input, value) || value >= (uint64) limit)
+            return false;
+
+        result = (int) value;
+        return true;
+    }
+
+    static uint64 zigZagEncode (int64 v) noexcept   { return ((uint64) v << 1) ^ (uint64) (v >> 63); }
+    static int64 zigZagDecode (uint64 v) noexcept   { return (int64) (v >> 1) ^ -(int64) (v & 1); }
+
+    enum ValueType
+    {
+        voidValue   = 0,
+        falseValue  = 1,
+        trueValue   = 2,
+        intValue    = 3,
+        int64Value  = 4,
+        doubleValue = 5,
+        stringValue = 6,
+        otherValue  = 7
+    };
+
+    static void writeValue (MemoryOutputStream& stream, const var& v)
+    {
+        if (v.isVoid())
+        {
+            stream.writeByte (voidValue);
+        }
+        else if (v.isBool())
+        {
+            stream.writeByte ((bool) v ? trueValue : falseValue);
+        }
+        else if (v.isInt() || v.isInt64())
+        {
+            stream.writeByte (v.isInt() ? intValue : int64Value);
+            writeVarInt (stream, zigZagEncode ((int64) v));
+        }
+        else if (v.isDouble())
+        {
+            stream.writeByte (doubleValue);
+            stream.writeDouble ((double) v);
+        }
+        else if (v.isString())
+        {
+            auto utf8 = v.toString().toUTF8();
+            auto numBytes = utf8.sizeInBytes() - 1;
+
+            stream.writeByte (stringValue);
+            writeVarInt (stream, (uint64) numBytes);
+            stream.write (utf8.getAddress(), numBytes);
+        }
+        else
+        {
+            stream.writeByte (otherValue);
+            v.writeToStream (stream);
+        }
+    }
+
+    static bool readValue (MemoryInputStream& input, var& result)
+    {
+        uint64 n;
+
+        if (input.isExhausted())
+            return false;
+
+        switch (input.readByte())
+        {
+            case voidValue:     result = var(); return true;
+            case falseValue:    result = false; return true;
+            case trueValue:     result = true;  return true;
+            case intValue:      if (! readVarInt (input, n)) return false; result = (int) zigZagDecode (n); return true;
+            case int64Value:    if (! readVarInt (input, n)) return false; result = zigZagDecode (n); return true;
+            case doubleValue:   if (input.getNumBytesRemaining() < 8) return false; result = input.readDouble(); return true;
+            case otherValue:    result = var::readFromStream (input); return true;
+
+            case stringValue:
+            {
+                if (! readVarInt (input, n) || n > (uint64) input.getNumBytesRemaining())
+                    return false;
+
+                auto* start = static_cast<const char*> (input.getData()) + input.getPosition();
+                result = String::fromUTF8 (start, (int) n);
+                input.skipNextBytes ((int64) n);
+                return true;
+            }
+
+            default:
+                break;
+        }
+
+        return false;
+    }
+
+    template <typename IdentifierToIndex>
+    static void writeCompactTree (MemoryOutputStream& stream, const ValueTree& tree, IdentifierToIndex&& getIndex)
+    {
+        writeVarInt (stream, (uint64) getIndex (tree.getType()));
+        writeVarInt (stream, (uint64) tree.getNumProperties());
+
+        for (int i = 0; i < tree.getNumProperties(); ++i)
+        {
+            auto name = tree.getPropertyName (i);
+            writeVarInt (stream, (uint64) getIndex (name));
+            writeValue (stream, tree.getProperty (name));
+        }
+
+        writeVarInt (stream, (uint64) tree.getNumChildren());
+
+        for (const auto& child : tree)
+            writeCompactTree (stream, child, getIndex);
+    }
+
+    static ValueTree readCompactTree (MemoryInputStream& input, const Array<Identifier>& identifiers, int depth = 0)
+    {
+        int typeIndex, numProperties, numChildren;
+
+        if (depth > 256 // sanity-check
+             || ! readVarInt (input, typeIndex, identifiers.size())
+             || ! readVarInt (input, numProperties, 65536))
+            return {};
+
+        ValueTree tree (identifiers.getReference (typeIndex));
+
+        for (int i = 0; i < numProperties; ++i)
+        {
+            int nameIndex;
+            var value;
+
+            if (! readVarInt (input, nameIndex, identifiers.size()) || ! readValue (input, value))
+                return {};
+
+            tree.setProperty (identifiers.getReference (nameIndex), std::move (value), nullptr);
+        }
+
+        if (! readVarInt (input, numChildren, std::numeric_limits<int>::max()))
+            return {};
+
+        for (int i = 0; i < numChildren; ++i)
+        {
+            auto child = readCompactTree (input, identifiers, depth + 1);
+
+            if (! child.isValid())
+                return {};
+
+            tree.appendChild (child, nullptr);
+        }
+
+        return tree;
+    }
+
+    static void writeIdentifierTable (MemoryOutputStream& stream, const StringArray& names)
+    {
+        writeVarInt (stream, (uint64) names.size());
+
+        for (auto& name : names)
+            stream.writeString (name);
+    }
+
+    static bool readIdentifierTable (MemoryInputStream& input, Array<Identifier>& identifiers)
+    {
+        int numNew;
+
+        if (! readVarInt (input, numNew, 1 << 24))
+            return false;
+
+        for (int i = 0; i < numNew; ++i)
+        {
+            auto name = input.readString();
+
+            if (name.isEmpty())
+                return false;
+
+            identifiers.add (name);
+        }
+
+        return true;
+    }
 }
 
+//==============================================================================
+struct ValueTreeSynchroniser::PendingChange
+{
+    ValueTreeSynchroniserHelpers::ChangeType type;
+    std::vector<int> path;
+    int propertyIndex = 0;
+    var value;
+    int index = 0, newIndex = 0;
+    MemoryBlock encodedChild;
+};
+
 ValueTreeSynchroniser::ValueTreeSynchroniser (const ValueTree& tree)  : valueTree (tree)
 {
     valueTree.addListener (this);
@@ -108,19 +336,200 @@ ValueTreeSynchroniser::ValueTreeSynchroniser (const ValueTree& tree)  : valueTre
 
 ValueTreeSynchroniser::~ValueTreeSynchroniser()
 {
+    cancelPendingUpdate();
     valueTree.removeListener (this);
 }
 
 void ValueTreeSynchroniser::sendFullSyncCallback()
 {
+    using namespace ValueTreeSynchroniserHelpers;
+
     MemoryOutputStream m;
-    writeHeader (m, ValueTreeSynchroniserHelpers::fullSync);
-    valueTree.writeToStream (m);
+
+    if (batching)
+    {
+        pendingChanges.clear();
+        coalescableChanges.clear();
+        identifierIndexes.clear();
+        newIdentifiers.clear();
+
+        MemoryOutputStream tree;
+        writeCompactTree (tree, valueTree, [this] (const Identifier& id) { return getIdentifierIndex (id); });
+
+        writeHeader (m, compactFullSync);
+        writeIdentifierTable (m, newIdentifiers);
+        m << tree.getMemoryBlock();
+        newIdentifiers.clear();
+    }
+    else
+    {
+        writeHeader (m, fullSync);
+        valueTree.writeToStream (m);
+    }
+
     stateChanged (m.getData(), m.getDataSize());
 }
 
+void ValueTreeSynchroniser::setBatchingEnabled (bool shouldBatchChanges)
+{
+    if (batching != shouldBatchChanges)
+    {
+        flush();
+        batching = shouldBatchChanges;
+        identifierIndexes.clear();
+        newIdentifiers.clear();
+    }
+}
+
+int ValueTreeSynchroniser::getIdentifierIndex (const Identifier& identifier)
+{
+    auto name = identifier.toString();
+
+    if (identifierIndexes.contains (name))
+        return identifierIndexes[name];
+
+    auto index = identifierIndexes.size();
+    identifierIndexes.set (name, index);
+    newIdentifiers.add (name);
+    return index;
+}
+
+void ValueTreeSynchroniser::addPendingChange (const ValueTree& changedTree, PendingChange change)
+{
+    using namespace ValueTreeSynchroniserHelpers;
+
+    Array<int> path;
+    getValueTreePath (changedTree, valueTree, path);
+
+    for (int i = path.size(); --i >= 0;)
+        change.path.push_back (path.getUnchecked (i));
+
+    if (change.type == propertyChanged || change.type == propertyRemoved)
+    {
+        // Property changes that happen between two structural changes all commute, so
+        // a later change to the same property can simply replace the earlier one.
+        auto key = std::make_pair (change.path, change.propertyIndex);
+
+        if (auto existing = coalescableChanges.find (key); existing != coalescableChanges.end())
+        {
+            pendingChanges[existing->second] = std::move (change);
+        }
+        else
+        {
+            coalescableChanges.emplace (std::move (key), pendingChanges.size());
+            pendingChanges.push_back (std::move (change));
+        }
+    }
+    else
+    {
+        coalescableChanges.clear();
+        pendingChanges.push_back (std::move (change));
+    }
+
+    triggerAsyncUpdate();
+}
+
+void ValueTreeSynchroniser::flush()
+{
+    using namespace ValueTreeSynchroniserHelpers;
+
+    cancelPendingUpdate();
+
+    if (pendingChanges.empty())
+        return;
+
+    MemoryOutputStream changes;
+    std::vector<int> previousPath;
+
+    for (auto& change : pendingChanges)
+    {
+        changes.writeByte ((char) change.type);
+
+        auto numShared = (size_t) std::distance (change.path.begin(),
+                                                 std::mismatch (change.path.begin(), change.path.end(),
+                                                                previousPath.begin(), previousPath.end()).first);
+
+        writeVarInt (changes, numShared);
+        writeVarInt (changes, change.path.size() - numShared);
+
+        for (auto i = numShared; i < change.path.size(); ++i)
+            writeVarInt (changes, (uint64) change.path[i]);
+
+        previousPath = std::move (change.path);
+
+        switch (change.type)
+        {
+            case propertyChanged:
+                writeVarInt (changes, (uint64) change.propertyIndex);
+                writeValue (changes, change.value);
+                break;
+
+            case propertyRemoved:
+                writeVarInt (changes, (uint64) change.propertyIndex);
+                break;
+
+            case childAdded:
+                writeVarInt (changes, (uint64) change.index);
+                changes << change.encodedChild;
+                break;
+
+            case childRemoved:
+                writeVarInt (changes, (uint64) change.index);
+                break;
+
+            case childMoved:
+                writeVarInt (changes, (uint64) change.index);
+                writeVarInt (changes, (uint64) change.newIndex);
+                break;
+
+            case fullSync:
+            case batchedChanges:
+            case compactFullSync:
+            default:
+                jassertfalse;
+                break;
+        }
+    }
+
+    MemoryOutputStream m;
+    writeHeader (m, batchedChanges);
+    writeIdentifierTable (m, newIdentifiers);
+    writeVarInt (m, pendingChanges.size());
+    m << changes.getMemoryBlock();
+
+    pendingChanges.clear();
+    coalescableChanges.clear();
+    newIdentifiers.clear();
+
+    stateChanged (m.getData(), m.getDataSize());
+}
+
+void ValueTreeSynchroniser::handleAsyncUpdate()
+{
+    flush();
+}
+
 void ValueTreeSynchroniser::valueTreePropertyChanged (ValueTree& vt, const Identifier& property)
 {
+    if (batching)
+    {
+        PendingChange change;
+        change.propertyIndex = getIdentifierIndex (property);
+
+        if (auto* value = vt.getPropertyPointer (property))
+        {
+            change.type = ValueTreeSynchroniserHelpers::propertyChanged;
+            change.value = *value;
+        }
+        else
+        {
+            change.type = ValueTreeSynchroniserHelpers::propertyRemoved;
+        }
+
+        addPendingChange (vt, std::move (change));
+        return;
+    }
+
     MemoryOutputStream m;
 
     if (auto* value = vt.getPropertyPointer (property))
@@ -143,6 +552,20 @@ void ValueTreeSynchroniser::valueTreeChildAdded (ValueTree& parentTree, ValueTre
     const int index = parentTree.indexOf (childTree);
     jassert (index >= 0);
 
+    if (batching)
+    {
+        // The child has to be encoded now, as any later changes to it will follow as separate changes
+        MemoryOutputStream encoded;
+        ValueTreeSynchroniserHelpers::writeCompactTree (encoded, childTree, [this] (const Identifier& id) { return getIdentifierIndex (id); });
+
+        PendingChange change;
+        change.type = ValueTreeSynchroniserHelpers::childAdded;
+        change.index = index;
+        change.encodedChild = encoded.getMemoryBlock();
+        addPendingChange (parentTree, std::move (change));
+        return;
+    }
+
     MemoryOutputStream m;
     ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::childAdded, parentTree);
     m.writeCompressedInt (index);
@@ -152,6 +575,15 @@ void ValueTreeSynchroniser::valueTreeChildAdded (ValueTree& parentTree, ValueTre
 
 void ValueTreeSynchroniser::valueTreeChildRemoved (ValueTree& parentTree, ValueTree&, int oldIndex)
 {
+    if (batching)
+    {
+        PendingChange change;
+        change.type = ValueTreeSynchroniserHelpers::childRemoved;
+        change.index = oldIndex;
+        addPendingChange (parentTree, std::move (change));
+        return;
+    }
+
     MemoryOutputStream m;
     ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::childRemoved, parentTree);
     m.writeCompressedInt (oldIndex);
@@ -160,6 +592,16 @@ void ValueTreeSynchroniser::valueTreeChildRemoved (ValueTree& parentTree, ValueT
 
 void ValueTreeSynchroniser::valueTreeChildOrderChanged (ValueTree& parent, int oldIndex, int newIndex)
 {
+    if (batching)
+    {
+        PendingChange change;
+        change.type = ValueTreeSynchroniserHelpers::childMoved;
+        change.index = oldIndex;
+        change.newIndex = newIndex;
+        addPendingChange (parent, std::move (change));
+        return;
+    }
+
     MemoryOutputStream m;
     ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::childMoved, parent);
     m.writeCompressedInt (oldIndex);
@@ -238,6 +680,9 @@ bool ValueTreeSynchroniser::applyChange (ValueTree& root, const void* data, size
         }
 
         case ValueTreeSynchroniserHelpers::fullSync:
+        case ValueTreeSynchroniserHelpers::batchedChanges:
+        case ValueTreeSynchroniserHelpers::compactFullSync:
+            jassert (type == ValueTreeSynchroniserHelpers::fullSync); // Batched messages need to be decoded by a ValueTreeSynchroniser::Receiver
             break;
 
         default:
@@ -248,4 +693,145 @@ bool ValueTreeSynchroniser::applyChange (ValueTree& root, const void* data, size
     return false;
 }
 
+//==============================================================================
+ValueTreeSynchroniser::Receiver::Receiver() = default;
+ValueTreeSynchroniser::Receiver::~Receiver() = default;
+
+bool ValueTreeSynchroniser::Receiver::applyChange (ValueTree& root, const void* data, size_t dataSize, UndoManager* undoManager)
+{
+    using namespace ValueTreeSynchroniserHelpers;
+
+    MemoryInputStream input (data, dataSize, false);
+    const auto type = (ChangeType) input.readByte();
+
+    if (type == compactFullSync)
+    {
+        identifiers.clearQuick();
+
+        if (! readIdentifierTable (input, identifiers))
+            return false;
+
+        auto newTree = readCompactTree (input, identifiers);
+
+        if (! newTree.isValid())
+            return false;
+
+        root = newTree;
+        return true;
+    }
+
+    if (type != batchedChanges)
+        return ValueTreeSynchroniser::applyChange (root, data, dataSize, undoManager);
+
+    int numChanges;
+
+    if (! readIdentifierTable (input, identifiers)
+         || ! readVarInt (input, numChanges, std::numeric_limits<int>::max()))
+        return false;
+
+    std::vector<int> path;
+
+    for (int i = 0; i < numChanges; ++i)
+    {
+        const auto changeType = (ChangeType) input.readByte();
+        int numShared, numNew;
+
+        if (! readVarInt (input, numShared, (int) path.size() + 1)
+             || ! readVarInt (input, numNew, 65536))
+            return false;
+
+        path.resize ((size_t) numShared);
+
+        for (int j = 0; j < numNew; ++j)
+        {
+            int index;
+
+            if (! readVarInt (input, index, std::numeric_limits<int>::max()))
+                return false;
+
+            path.push_back (index);
+        }
+
+        auto v = root;
+
+        for (auto index : path)
+        {
+            if (! isPositiveAndBelow (index, v.getNumChildren()))
+            {
+                jassertfalse; // Either received some corrupt data, or the trees have drifted out of sync
+                return false;
+            }
+
+            v = v.getChild (index);
+        }
+
+        int propertyIndex, index, newIndex;
+
+        switch (changeType)
+        {
+            case propertyChanged:
+            {
+                var value;
+
+                if (! readVarInt (input, propertyIndex, identifiers.size()) || ! readValue (input, value))
+                    return false;
+
+                v.setProperty (identifiers.getReference (propertyIndex), std::move (value), undoManager);
+                break;
+            }
+
+            case propertyRemoved:
+            {
+                if (! readVarInt (input, propertyIndex, identifiers.size()))
+                    return false;
+
+                v.removeProperty (identifiers.getReference (propertyIndex), undoManager);
+                break;
+            }
+
+            case childAdded:
+            {
+                if (! readVarInt (input, index, v.getNumChildren() + 1))
+                    return false;
+
+                auto child = readCompactTree (input, identifiers);
+
+                if (! child.isValid())
+                    return false;
+
+                v.addChild (child, index, undoManager);
+                break;
+            }
+
+            case childRemoved:
+            {
+                if (! readVarInt (input, index, v.getNumChildren()))
+                    return false;
+
+                v.removeChild (index, undoManager);
+                break;
+            }
+
+            case childMoved:
+            {
+                if (! readVarInt (input, index, v.getNumChildren())
+                     || ! readVarInt (input, newIndex, v.getNumChildren()))
+                    return false;
+
+                v.moveChild (index, newIndex, undoManager);
+                break;
+            }
+
+            case fullSync:
+            case batchedChanges:
+            case compactFullSync:
+            default:
+                jassertfalse; // Seem to have received some corrupt data?
+                return false;
+        }
+    }
+
+    return true;
+}
+
 } // namespace juce
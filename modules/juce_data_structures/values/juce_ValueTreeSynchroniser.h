@@ -49,9 +49,19 @@ namespace juce
     via a network or other means) to a remote destination, where it can be
     applied to a target tree.
 
+    By default, each change to the tree is sent as a separate message. For large
+    trees with lots of activity you can call setBatchingEnabled(), which collects
+    all the changes that happen before the next flush() into a single compact frame.
+    In this mode repeated changes to the same property are coalesced, tree paths are
+    delta-encoded against the previous change in the frame, and Identifiers are only
+    transmitted once and then referred to by their index in a string table that's
+    shared with the receiver. Frames like this have to be decoded by a
+    ValueTreeSynchroniser::Receiver, which remembers that table between messages.
+
     @tags{DataStructures}
 */
-class JUCE_API  ValueTreeSynchroniser  : private ValueTree::Listener
+class JUCE_API  ValueTreeSynchroniser  : private ValueTree::Listener,
+                                         private AsyncUpdater
 {
 public:
     /** Creates a ValueTreeSynchroniser that watches the given tree.
@@ -76,9 +86,36 @@ public:
         encodes the entire ValueTree.
 
         This will internally invoke stateChanged() with the encoded version of the state.
+        If batching is enabled, this sends a compact binary snapshot which also resets
+        the shared string table, and any changes that haven't been flushed yet are
+        discarded, as the snapshot already contains them.
     */
     void sendFullSyncCallback();
 
+    /** Enables or disables batching of changes.
+
+        When batching is enabled, changes are collected and sent together as a single
+        message when flush() is called. A flush is also triggered asynchronously on
+        the message thread after each change, so by default everything that happens
+        within one message-loop callback ends up in the same frame.
+
+        The messages sent in this mode can only be decoded by a Receiver. Because the
+        Receiver has to see every frame in order to keep its string table in sync,
+        you should call sendFullSyncCallback() after enabling batching and whenever a
+        new receiver connects.
+
+        @see flush, Receiver
+    */
+    void setBatchingEnabled (bool shouldBatchChanges);
+
+    /** Returns true if batching has been enabled with setBatchingEnabled(). */
+    bool isBatchingEnabled() const noexcept         { return batching; }
+
+    /** Sends any changes that have been batched up, as a single call to stateChanged().
+        This does nothing if there are no pending changes.
+    */
+    void flush();
+
     /** Applies an encoded change to the given destination tree.
 
         When you implement a receiver for changes that were sent by the stateChanged()
@@ -92,8 +129,54 @@ public:
     /** Returns the root ValueTree that is being observed. */
     const ValueTree& getRoot() noexcept       { return valueTree; }
 
+    //==============================================================================
+    /**
+        Applies the messages produced by a ValueTreeSynchroniser to a target tree.
+
+        Unlike the static applyChange() method, a Receiver keeps hold of the string
+        table that the sender builds up in batching mode, so it can decode batched
+        frames and compact snapshots as well as ordinary change messages. You should
+        use one Receiver for each sender, and pass it every message in the order in
+        which they were sent.
+
+        @tags{DataStructures}
+    */
+    class JUCE_API  Receiver
+    {
+    public:
+        /** Creates a Receiver with an empty string table. */
+        Receiver();
+
+        /** Destructor. */
+        ~Receiver();
+
+        /** Applies an encoded change or frame to the given destination tree.
+            Returns false if the data couldn't be decoded or applied, in which case the
+            trees have probably drifted apart and you should request a full sync.
+        */
+        bool applyChange (ValueTree& target,
+                          const void* encodedChangeData, size_t encodedChangeDataSize,
+                          UndoManager* undoManager);
+
+    private:
+        Array<Identifier> identifiers;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Receiver)
+    };
+
 private:
+    struct PendingChange;
+
     ValueTree valueTree;
+    bool batching = false;
+    std::vector<PendingChange> pendingChanges;
+    std::map<std::pair<std::vector<int>, int>, size_t> coalescableChanges;
+    HashMap<String, int> identifierIndexes;
+    StringArray newIdentifiers;
+
+    int getIdentifierIndex (const Identifier&);
+    void addPendingChange (const ValueTree&, PendingChange);
+    void handleAsyncUpdate() override;
 
     void valueTreePropertyChanged (ValueTree&, const Identifier&) override;
     void valueTreeChildAdded (ValueTree&, ValueTree&) override;
@@ -0,0 +1,254 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+class ValueTreeSynchroniserTests final : public UnitTest
+{
+public:
+    ValueTreeSynchroniserTests()
+        : UnitTest ("ValueTreeSynchroniser", UnitTestCategories::values)
+    {}
+
+    struct Sender final : public ValueTreeSynchroniser
+    {
+        using ValueTreeSynchroniser::ValueTreeSynchroniser;
+
+        void stateChanged (const void* data, size_t size) override
+        {
+            messages.emplace_back (data, size);
+            totalBytes += size;
+        }
+
+        std::vector<MemoryBlock> messages;
+        size_t totalBytes = 0;
+    };
+
+    static ValueTree createTree (int numChildren, int depth)
+    {
+        ValueTree v ("node");
+        v.setProperty ("name", "node" + String (depth), nullptr);
+        v.setProperty ("value", depth * 1.5, nullptr);
+
+        if (depth > 0)
+            for (int i = 0; i < numChildren; ++i)
+                v.appendChild (createTree (numChildren, depth - 1), nullptr);
+
+        return v;
+    }
+
+    static void makeRandomChange (ValueTree& root, Random& r)
+    {
+        auto target = root;
+
+        while (target.getNumChildren() > 0 && r.nextInt (3) != 0)
+            target = target.getChild (r.nextInt (target.getNumChildren()));
+
+        const Identifier property ("p" + String (r.nextInt (5)));
+
+        switch (r.nextInt (9))
+        {
+            case 0:  target.setProperty (property, r.nextInt(), nullptr); break;
+            case 1:  target.setProperty (property, r.nextInt64(), nullptr); break;
+            case 2:  target.setProperty (property, r.nextDouble(), nullptr); break;
+            case 3:  target.setProperty (property, String::toHexString (r.nextInt()) + String (CharPointer_UTF8 ("\xc3\xa9")), nullptr); break;
+            case 4:  target.setProperty (property, r.nextBool(), nullptr); break;
+            case 5:  target.removeProperty (property, nullptr); break;
+            case 6:  target.addChild (createTree (2, r.nextInt (2)), r.nextInt (target.getNumChildren() + 1), nullptr); break;
+            case 7:  if (target.getNumChildren() > 0) target.removeChild (r.nextInt (target.getNumChildren()), nullptr); break;
+            case 8:  if (target.getNumChildren() > 0) target.moveChild (r.nextInt (target.getNumChildren()), r.nextInt (target.getNumChildren()), nullptr); break;
+            default: break;
+        }
+    }
+
+    bool applyAll (ValueTreeSynchroniser::Receiver& receiver, ValueTree& target, Sender& sender)
+    {
+        auto ok = true;
+
+        for (auto& m : sender.messages)
+            ok = receiver.applyChange (target, m.getData(), m.getSize(), nullptr) && ok;
+
+        sender.messages.clear();
+        return ok;
+    }
+
+    void runTest() override
+    {
+        ScopedJuceInitialiser_GUI libraryInitialiser;
+        auto r = getRandom();
+
+        beginTest ("Unbatched changes");
+        {
+            auto source = createTree (3, 2);
+            ValueTree target;
+            Sender sender (source);
+            sender.sendFullSyncCallback();
+
+            for (int i = 0; i < 200; ++i)
+                makeRandomChange (source, r);
+
+            for (auto& m : sender.messages)
+                expect (ValueTreeSynchroniser::applyChange (target, m.getData(), m.getSize(), nullptr));
+
+            expect (target.isEquivalentTo (source));
+        }
+
+        beginTest ("Batched changes");
+        {
+            auto source = createTree (3, 3);
+            ValueTree target;
+            Sender sender (source);
+            ValueTreeSynchroniser::Receiver receiver;
+
+            sender.setBatchingEnabled (true);
+            sender.sendFullSyncCallback();
+            expect (applyAll (receiver, target, sender));
+            expect (target.isEquivalentTo (source));
+
+            for (int frame = 0; frame < 50; ++frame)
+            {
+                for (int i = r.nextInt (20); --i >= 0;)
+                    makeRandomChange (source, r);
+
+                sender.flush();
+                expect (sender.messages.size() <= 1);
+                expect (applyAll (receiver, target, sender));
+                expect (target.isEquivalentTo (source));
+            }
+
+            sender.sendFullSyncCallback();
+            ValueTree lateJoiner;
+            ValueTreeSynchroniser::Receiver lateReceiver;
+            expect (lateReceiver.applyChange (lateJoiner, sender.messages[0].getData(), sender.messages[0].getSize(), nullptr));
+            expect (lateJoiner.isEquivalentTo (source));
+        }
+
+        beginTest ("Repeated property changes are coalesced");
+        {
+            auto source = createTree (4, 2);
+            Sender sender (source);
+            sender.setBatchingEnabled (true);
+
+            for (int i = 0; i < 100; ++i)
+                source.getChild (1).getChild (2).setProperty ("gain", i, nullptr);
+
+            sender.flush();
+            expectEquals ((int) sender.messages.size(), 1);
+            expect (sender.totalBytes < 32);
+        }
+
+        beginTest ("Corrupt frames are rejected");
+        {
+            auto source = createTree (2, 2);
+            ValueTree target;
+            Sender sender (source);
+            ValueTreeSynchroniser::Receiver receiver;
+            sender.setBatchingEnabled (true);
+            sender.sendFullSyncCallback();
+            expect (applyAll (receiver, target, sender));
+
+            source.getChild (1).setProperty ("newProperty", 1, nullptr);
+            sender.flush();
+
+            auto frame = sender.messages[0];
+            expect (! receiver.applyChange (target, frame.getData(), frame.getSize() - 2, nullptr));
+        }
+    }
+};
+
+static ValueTreeSynchroniserTests valueTreeSynchroniserTests;
+
+//==============================================================================
+class ValueTreeSynchroniserBenchmarks final : public UnitTest
+{
+public:
+    ValueTreeSynchroniserBenchmarks()
+        : UnitTest ("ValueTreeSynchroniser benchmarks", UnitTestCategories::benchmarks)
+    {}
+
+    void runTest() override
+    {
+        ScopedJuceInitialiser_GUI libraryInitialiser;
+
+        beginTest ("Meter-style updates to a large tree");
+
+        ValueTree session ("Session");
+
+        for (int t = 0; t < 64; ++t)
+        {
+            ValueTree track ("Track", { { "name", "Track " + String (t) }, { "level", 0.0 } });
+
+            for (int c = 0; c < 200; ++c)
+                track.appendChild (ValueTree ("Clip", { { "start", c * 4 }, { "length", 4 } }), nullptr);
+
+            session.appendChild (track, nullptr);
+        }
+
+        for (auto batched : { false, true })
+        {
+            ValueTreeSynchroniserTests::Sender sender (session);
+            sender.setBatchingEnabled (batched);
+
+            sender.sendFullSyncCallback();
+            auto fullSyncBytes = sender.totalBytes;
+            sender.totalBytes = 0;
+
+            auto start = Time::getMillisecondCounterHiRes();
+
+            // 100 frames, each updating every track's level a few times
+            for (int frame = 0; frame < 100; ++frame)
+            {
+                for (int repeat = 0; repeat < 4; ++repeat)
+                    for (auto track : session)
+                        track.setProperty ("level", frame * 0.01 + repeat, nullptr);
+
+                sender.flush();
+            }
+
+            auto elapsed = Time::getMillisecondCounterHiRes() - start;
+
+            logMessage (String (batched ? "Batched" : "Unbatched")
+                          + ": full sync " + String (fullSyncBytes) + " bytes, "
+                          + "100 frames " + String (sender.totalBytes) + " bytes in "
+                          + String ((int) sender.messages.size()) + " messages, "
+                          + String (elapsed, 2) + " ms");
+        }
+    }
+};
+
+static ValueTreeSynchroniserBenchmarks valueTreeSynchroniserBenchmarks;
+
+} // namespace juce
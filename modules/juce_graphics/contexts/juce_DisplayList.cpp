@@ -0,0 +1,704 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace DisplayListOps
+{
+    struct SetOrigin                { Point<int> offset; };
+    struct AddTransform             { AffineTransform transform; };
+    struct ClipToRectangle          { Rectangle<int> area; };
+    struct ClipToRectangleList      { size_t list; };
+    struct ExcludeClipRectangle     { Rectangle<int> area; };
+    struct ClipToPath               { size_t path; AffineTransform transform; };
+    struct ClipToImageAlpha         { size_t image; AffineTransform transform; };
+    struct SaveState                {};
+    struct RestoreState             {};
+    struct BeginTransparencyLayer   { float opacity; };
+    struct EndTransparencyLayer     {};
+    struct SetFill                  { size_t fill; };
+    struct SetOpacity               { float opacity; };
+    struct SetInterpolationQuality  { Graphics::ResamplingQuality quality; };
+    struct SetFont                  { size_t font; };
+    struct FillAll                  {};
+    struct FillRect                 { Rectangle<int> area; bool replaceExistingContents; };
+    struct FillRectFloat            { Rectangle<float> area; };
+    struct FillRectList             { size_t list; };
+    struct FillPath                 { size_t path; AffineTransform transform; };
+    struct StrokePath               { size_t path; PathStrokeType strokeType; AffineTransform transform; };
+    struct DrawRect                 { Rectangle<float> area; float lineThickness; };
+    struct DrawImage                { size_t image; AffineTransform transform; };
+    struct DrawLine                 { Line<float> line; };
+    struct DrawLineWithThickness    { Line<float> line; float lineThickness; };
+    struct DrawGlyphs               { size_t start, num; AffineTransform transform; };
+    struct DrawRoundedRectangle     { Rectangle<float> area; float cornerSize, lineThickness; };
+    struct FillRoundedRectangle     { Rectangle<float> area; float cornerSize; };
+    struct DrawEllipse              { Rectangle<float> area; float lineThickness; };
+    struct FillEllipse              { Rectangle<float> area; };
+
+    using Op = std::variant<SetOrigin, AddTransform, ClipToRectangle, ClipToRectangleList, ExcludeClipRectangle,
+                            ClipToPath, ClipToImageAlpha, SaveState, RestoreState, BeginTransparencyLayer,
+                            EndTransparencyLayer, SetFill, SetOpacity, SetInterpolationQuality, SetFont,
+                            FillAll, FillRect, FillRectFloat, FillRectList, FillPath, StrokePath, DrawRect,
+                            DrawImage, DrawLine, DrawLineWithThickness, DrawGlyphs, DrawRoundedRectangle,
+                            FillRoundedRectangle, DrawEllipse, FillEllipse>;
+}
+
+//==============================================================================
+struct DisplayList::Data
+{
+    struct Command
+    {
+        DisplayListOps::Op op;
+
+        // The area that a drawing operation might touch, relative to the origin of the
+        // recording. This is empty for operations that only change the context's state,
+        // which must always be replayed.
+        Rectangle<int> bounds;
+    };
+
+    // The operations themselves are kept small by storing anything bulky in these pools,
+    // and referring to it by index.
+    std::vector<Command> commands;
+    std::vector<Path> paths;
+    std::vector<FillType> fills;
+    std::vector<Image> images;
+    std::vector<Font> fonts;
+    std::vector<RectangleList<int>> clipLists;
+    std::vector<RectangleList<float>> rectLists;
+    std::vector<uint16_t> glyphs;
+    std::vector<Point<float>> glyphPositions;
+    Rectangle<int> bounds;
+
+    template <typename Pool, typename Item>
+    static size_t addToPool (Pool& pool, Item&& item)
+    {
+        pool.push_back (std::forward<Item> (item));
+        return pool.size() - 1;
+    }
+
+    void clear()
+    {
+        *this = {};
+    }
+
+    struct Player;
+};
+
+//==============================================================================
+struct DisplayList::Data::Player
+{
+    const Data& data;
+    LowLevelGraphicsContext& target;
+
+    void operator() (const DisplayListOps::SetOrigin& op) const                { target.setOrigin (op.offset); }
+    void operator() (const DisplayListOps::AddTransform& op) const             { target.addTransform (op.transform); }
+    void operator() (const DisplayListOps::ClipToRectangle& op) const          { target.clipToRectangle (op.area); }
+    void operator() (const DisplayListOps::ClipToRectangleList& op) const      { target.clipToRectangleList (data.clipLists[op.list]); }
+    void operator() (const DisplayListOps::ExcludeClipRectangle& op) const     { target.excludeClipRectangle (op.area); }
+    void operator() (const DisplayListOps::ClipToPath& op) const               { target.clipToPath (data.paths[op.path], op.transform); }
+    void operator() (const DisplayListOps::ClipToImageAlpha& op) const         { target.clipToImageAlpha (data.images[op.image], op.transform); }
+    void operator() (const DisplayListOps::SaveState&) const                   { target.saveState(); }
+    void operator() (const DisplayListOps::RestoreState&) const                { target.restoreState(); }
+    void operator() (const DisplayListOps::BeginTransparencyLayer& op) const   { target.beginTransparencyLayer (op.opacity); }
+    void operator() (const DisplayListOps::EndTransparencyLayer&) const        { target.endTransparencyLayer(); }
+    void operator() (const DisplayListOps::SetFill& op) const                  { target.setFill (data.fills[op.fill]); }
+    void operator() (const DisplayListOps::SetOpacity& op) const               { target.setOpacity (op.opacity); }
+    void operator() (const DisplayListOps::SetInterpolationQuality& op) const  { target.setInterpolationQuality (op.quality); }
+    void operator() (const DisplayListOps::SetFont& op) const                  { target.setFont (data.fonts[op.font]); }
+    void operator() (const DisplayListOps::FillAll&) const                     { target.fillAll(); }
+    void operator() (const DisplayListOps::FillRect& op) const                 { target.fillRect (op.area, op.replaceExistingContents); }
+    void operator() (const DisplayListOps::FillRectFloat& op) const            { target.fillRect (op.area); }
+    void operator() (const DisplayListOps::FillRectList& op) const             { target.fillRectList (data.rectLists[op.list]); }
+    void operator() (const DisplayListOps::FillPath& op) const                 { target.fillPath (data.paths[op.path], op.transform); }
+    void operator() (const DisplayListOps::StrokePath& op) const               { target.strokePath (data.paths[op.path], op.strokeType, op.transform); }
+    void operator() (const DisplayListOps::DrawRect& op) const                 { target.drawRect (op.area, op.lineThickness); }
+    void operator() (const DisplayListOps::DrawImage& op) const                { target.drawImage (data.images[op.image], op.transform); }
+    void operator() (const DisplayListOps::DrawLine& op) const                 { target.drawLine (op.line); }
+    void operator() (const DisplayListOps::DrawLineWithThickness& op) const    { target.drawLineWithThickness (op.line, op.lineThickness); }
+    void operator() (const DisplayListOps::DrawRoundedRectangle& op) const     { target.drawRoundedRectangle (op.area, op.cornerSize, op.lineThickness); }
+    void operator() (const DisplayListOps::FillRoundedRectangle& op) const     { target.fillRoundedRectangle (op.area, op.cornerSize); }
+    void operator() (const DisplayListOps::DrawEllipse& op) const              { target.drawEllipse (op.area, op.lineThickness); }
+    void operator() (const DisplayListOps::FillEllipse& op) const              { target.fillEllipse (op.area); }
+
+    void operator() (const DisplayListOps::DrawGlyphs& op) const
+    {
+        target.drawGlyphs ({ data.glyphs.data() + op.start, op.num },
+                           { data.glyphPositions.data() + op.start, op.num },
+                           op.transform);
+    }
+};
+
+//==============================================================================
+class DisplayList::Recorder final : public LowLevelGraphicsContext
+{
+public:
+    Recorder (Data& d, Rectangle<int> area, float scale)
+        : data (d), physicalPixelScaleFactor (scale)
+    {
+        stack.push_back ({ {}, area, Font { FontOptions{} } });
+    }
+
+    bool isVectorDevice() const override                        { return false; }
+    uint64_t getFrameId() const override                        { return 0; }
+
+    std::unique_ptr<ImageType> getPreferredImageTypeForTemporaryImages() const override
+    {
+        return std::make_unique<SoftwareImageType>();
+    }
+
+    //==============================================================================
+    void setOrigin (Point<int> o) override
+    {
+        state().transform = AffineTransform::translation (o).followedBy (state().transform);
+        addState (DisplayListOps::SetOrigin { o });
+    }
+
+    void addTransform (const AffineTransform& t) override
+    {
+        state().transform = t.followedBy (state().transform);
+        addState (DisplayListOps::AddTransform { t });
+    }
+
+    float getPhysicalPixelScaleFactor() const override
+    {
+        return physicalPixelScaleFactor * std::sqrt (std::abs (state().transform.getDeterminant()));
+    }
+
+    //==============================================================================
+    // The clip region is tracked as a bounding rectangle, which may be larger than the
+    // region a real context would end up with. That's fine for deciding what to record,
+    // as it can only mean keeping an operation that turns out to be invisible.
+    bool clipToRectangle (const Rectangle<int>& r) override
+    {
+        addState (DisplayListOps::ClipToRectangle { r });
+        return reduceClip (r.toFloat());
+    }
+
+    bool clipToRectangleList (const RectangleList<int>& list) override
+    {
+        addState (DisplayListOps::ClipToRectangleList { Data::addToPool (data.clipLists, list) });
+        return reduceClip (list.getBounds().toFloat());
+    }
+
+    void excludeClipRectangle (const Rectangle<int>& r) override
+    {
+        addState (DisplayListOps::ExcludeClipRectangle { r });
+    }
+
+    void clipToPath (const Path& path, const AffineTransform& t) override
+    {
+        addState (DisplayListOps::ClipToPath { Data::addToPool (data.paths, path), t });
+        reduceClip (path.getBoundsTransformed (t));
+    }
+
+    void clipToImageAlpha (const Image& image, const AffineTransform& t) override
+    {
+        addState (DisplayListOps::ClipToImageAlpha { Data::addToPool (data.images, image), t });
+        reduceClip (image.getBounds().toFloat().transformedBy (t));
+    }
+
+    bool clipRegionIntersects (const Rectangle<int>& r) override
+    {
+        return toRecordingSpace (r.toFloat()).intersects (state().clip);
+    }
+
+    Rectangle<int> getClipBounds() const override
+    {
+        return state().clip.toFloat().transformedBy (state().transform.inverted()).getSmallestIntegerContainer();
+    }
+
+    bool isClipEmpty() const override
+    {
+        return state().clip.isEmpty();
+    }
+
+    //==============================================================================
+    void saveState() override
+    {
+        stack.push_back (state());
+        addState (DisplayListOps::SaveState{});
+    }
+
+    void restoreState() override
+    {
+        if (stack.size() <= 1)
+        {
+            jassertfalse; // trying to pop with an empty stack!
+            return;
+        }
+
+        stack.pop_back();
+        addState (DisplayListOps::RestoreState{});
+    }
+
+    void beginTransparencyLayer (float opacity) override
+    {
+        stack.push_back (state());
+        addState (DisplayListOps::BeginTransparencyLayer { opacity });
+    }
+
+    void endTransparencyLayer() override
+    {
+        if (stack.size() > 1)
+            stack.pop_back();
+
+        addState (DisplayListOps::EndTransparencyLayer{});
+    }
+
+    //==============================================================================
+    void setFill (const FillType& fill) override
+    {
+        addState (DisplayListOps::SetFill { Data::addToPool (data.fills, fill) });
+    }
+
+    void setOpacity (float opacity) override
+    {
+        addState (DisplayListOps::SetOpacity { opacity });
+    }
+
+    void setInterpolationQuality (Graphics::ResamplingQuality quality) override
+    {
+        addState (DisplayListOps::SetInterpolationQuality { quality });
+    }
+
+    void setFont (const Font& f) override
+    {
+        state().font = f;
+        addState (DisplayListOps::SetFont { Data::addToPool (data.fonts, f) });
+    }
+
+    const Font& getFont() override
+    {
+        return state().font;
+    }
+
+    //==============================================================================
+    void fillAll() override
+    {
+        addDrawing (getClipBounds().toFloat(), DisplayListOps::FillAll{});
+    }
+
+    void fillRect (const Rectangle<int>& r, bool replaceExistingContents) override
+    {
+        addDrawing (r.toFloat(), DisplayListOps::FillRect { r, replaceExistingContents });
+    }
+
+    void fillRect (const Rectangle<float>& r) override
+    {
+        addDrawing (r, DisplayListOps::FillRectFloat { r });
+    }
+
+    void fillRectList (const RectangleList<float>& list) override
+    {
+        addDrawing (list.getBounds(), [&] { return DisplayListOps::FillRectList { Data::addToPool (data.rectLists, list) }; });
+    }
+
+    void fillPath (const Path& path, const AffineTransform& t) override
+    {
+        addDrawing (path.getBoundsTransformed (t), [&] { return DisplayListOps::FillPath { Data::addToPool (data.paths, path), t }; });
+    }
+
+    void strokePath (const Path& path, const PathStrokeType& strokeType, const AffineTransform& t) override
+    {
+        // Mitred joints and end caps can reach a little further than half the line's thickness
+        const auto area = path.getBoundsTransformed (t).expanded (strokeType.getStrokeThickness() * 2.0f);
+        addDrawing (area, [&] { return DisplayListOps::StrokePath { Data::addToPool (data.paths, path), strokeType, t }; });
+    }
+
+    void drawRect (const Rectangle<float>& r, float lineThickness) override
+    {
+        addDrawing (r, DisplayListOps::DrawRect { r, lineThickness });
+    }
+
+    void drawImage (const Image& image, const AffineTransform& t) override
+    {
+        addDrawing (image.getBounds().toFloat().transformedBy (t),
+                    [&] { return DisplayListOps::DrawImage { Data::addToPool (data.images, image), t }; });
+    }
+
+    void drawLine (const Line<float>& line) override
+    {
+        addDrawing (getLineBounds (line, 1.0f), DisplayListOps::DrawLine { line });
+    }
+
+    void drawLineWithThickness (const Line<float>& line, float lineThickness) override
+    {
+        addDrawing (getLineBounds (line, lineThickness), DisplayListOps::DrawLineWithThickness { line, lineThickness });
+    }
+
+    void drawGlyphs (Span<const uint16_t> glyphs, Span<const Point<float>> positions, const AffineTransform& t) override
+    {
+        jassert (glyphs.size() == positions.size());
+
+        if (positions.empty())
+            return;
+
+        // The positions are on the baseline, so rather than measuring every glyph, allow
+        // room for the font's ascent and descent, and a glyph's width after the last one,
+        // plus some slack for glyphs that overhang their neighbours.
+        const auto& font = state().font;
+        const auto slack = font.getHeight() * 0.25f;
+        const auto width = font.getHeight() * jmax (1.0f, font.getHorizontalScale());
+        const auto area = Rectangle<float>::findAreaContainingPoints (positions.data(), (int) positions.size())
+                                           .withTrimmedTop (-(font.getAscent() + slack))
+                                           .withTrimmedBottom (-(font.getDescent() + slack))
+                                           .withTrimmedLeft (-slack)
+                                           .withTrimmedRight (-(width + slack))
+                                           .transformedBy (t);
+
+        addDrawing (area, [&]
+        {
+            const auto start = data.glyphs.size();
+            data.glyphs.insert (data.glyphs.end(), glyphs.begin(), glyphs.end());
+            data.glyphPositions.insert (data.glyphPositions.end(), positions.begin(), positions.end());
+            return DisplayListOps::DrawGlyphs { start, glyphs.size(), t };
+        });
+    }
+
+    void drawRoundedRectangle (const Rectangle<float>& r, float cornerSize, float lineThickness) override
+    {
+        addDrawing (r.expanded (lineThickness), DisplayListOps::DrawRoundedRectangle { r, cornerSize, lineThickness });
+    }
+
+    void fillRoundedRectangle (const Rectangle<float>& r, float cornerSize) override
+    {
+        addDrawing (r, DisplayListOps::FillRoundedRectangle { r, cornerSize });
+    }
+
+    void drawEllipse (const Rectangle<float>& area, float lineThickness) override
+    {
+        addDrawing (area.expanded (lineThickness), DisplayListOps::DrawEllipse { area, lineThickness });
+    }
+
+    void fillEllipse (const Rectangle<float>& area) override
+    {
+        addDrawing (area, DisplayListOps::FillEllipse { area });
+    }
+
+private:
+    struct SavedState
+    {
+        AffineTransform transform;
+        Rectangle<int> clip;
+        Font font;
+    };
+
+    SavedState& state()               { return stack.back(); }
+    const SavedState& state() const   { return stack.back(); }
+
+    Rectangle<int> toRecordingSpace (Rectangle<float> area) const
+    {
+        return area.transformedBy (state().transform).getSmallestIntegerContainer();
+    }
+
+    static Rectangle<float> getLineBounds (const Line<float>& line, float thickness)
+    {
+        return Rectangle<float> (line.getStart(), line.getEnd()).expanded (thickness);
+    }
+
+    bool reduceClip (Rectangle<float> area)
+    {
+        auto& clip = state().clip;
+        clip = clip.getIntersection (toRecordingSpace (area));
+        return ! clip.isEmpty();
+    }
+
+    template <typename Op>
+    void addState (Op op)
+    {
+        data.commands.push_back ({ std::move (op), {} });
+    }
+
+    // The op may be passed as a function which creates it, so that anything it needs to
+    // add to the data's pools is only added if the operation turns out to be visible.
+    template <typename OpOrCreator>
+    void addDrawing (Rectangle<float> area, OpOrCreator&& op)
+    {
+        // Allow an extra pixel all round for anti-aliasing
+        const auto bounds = toRecordingSpace (area).expanded (1).getIntersection (state().clip);
+
+        if (bounds.isEmpty())
+            return;
+
+        data.bounds = data.bounds.getUnion (bounds);
+
+        if constexpr (std::is_invocable_v<OpOrCreator>)
+            data.commands.push_back ({ op(), bounds });
+        else
+            data.commands.push_back ({ std::forward<OpOrCreator> (op), bounds });
+    }
+
+    Data& data;
+    std::vector<SavedState> stack;
+    const float physicalPixelScaleFactor;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Recorder)
+};
+
+//==============================================================================
+DisplayList::DisplayList() : data (std::make_unique<Data>()) {}
+DisplayList::~DisplayList() = default;
+
+DisplayList::DisplayList (DisplayList&&) noexcept = default;
+DisplayList& DisplayList::operator= (DisplayList&&) noexcept = default;
+
+std::unique_ptr<LowLevelGraphicsContext> DisplayList::createRecordingContext (Rectangle<int> area, float physicalPixelScaleFactor)
+{
+    data->clear();
+    return std::make_unique<Recorder> (*data, area, physicalPixelScaleFactor);
+}
+
+void DisplayList::replay (LowLevelGraphicsContext& target) const
+{
+    const auto visibleArea = target.getClipBounds();
+    const Data::Player player { *data, target };
+
+    for (const auto& command : data->commands)
+        if (command.bounds.isEmpty() || command.bounds.intersects (visibleArea))
+            std::visit (player, command.op);
+}
+
+void DisplayList::clear()
+{
+    data->clear();
+}
+
+bool DisplayList::isEmpty() const noexcept
+{
+    return data->commands.empty();
+}
+
+int DisplayList::getNumCommands() const noexcept
+{
+    return (int) data->commands.size();
+}
+
+Rectangle<int> DisplayList::getBounds() const noexcept
+{
+    return data->bounds;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class DisplayListTests final : public UnitTest
+{
+public:
+    DisplayListTests()
+        : UnitTest ("DisplayList", UnitTestCategories::graphics)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Replaying a recording draws the same pixels as the original operations");
+        {
+            const auto direct = render ([] (Graphics& g) { paintScene (g); });
+
+            DisplayList list;
+            record (list, paintScene);
+
+            expect (! list.isEmpty());
+            expect (list.getBounds().contains (Rectangle<int> (10, 10, 100, 60)));
+            expect (imagesMatch (direct, render ([&] (Graphics& g) { list.replay (g.getInternalContext()); })));
+        }
+
+        beginTest ("Replaying into a clipped context only sends the visible operations");
+        {
+            DisplayList list;
+            record (list, [] (Graphics& g)
+            {
+                g.setColour (Colours::red);
+                g.fillRect (10, 10, 20, 20);
+                g.setColour (Colours::green);
+                g.fillRect (100, 100, 20, 20);
+            });
+
+            Image image (Image::ARGB, size, size, true, SoftwareImageType{});
+            CountingContext context (image);
+            context.clipToRectangle ({ 90, 90, 50, 50 });
+            list.replay (context);
+
+            expectEquals (context.numRects, 1);
+            expect (image.getPixelAt (15, 15).isTransparent());
+            expect (image.getPixelAt (110, 110) == Colours::green);
+
+            CountingContext unclipped (image);
+            list.replay (unclipped);
+            expectEquals (unclipped.numRects, 2);
+        }
+
+        beginTest ("Operations which are clipped away aren't recorded");
+        {
+            DisplayList list;
+            record (list, [] (Graphics& g)
+            {
+                g.fillRect (-50, -50, 20, 20);
+                g.fillRect (size + 10, 10, 20, 20);
+
+                Graphics::ScopedSaveState ss (g);
+                g.reduceClipRegion (0, 0, 10, 10);
+                g.fillEllipse (50.0f, 50.0f, 20.0f, 20.0f);
+            });
+
+            expect (list.getBounds().isEmpty());
+            expectEquals (list.getNumCommands(), 3); // save, clip and restore
+        }
+
+        beginTest ("The recording context reports its clip region and scale");
+        {
+            DisplayList list;
+            auto context = list.createRecordingContext ({ 0, 0, 100, 80 }, 2.0f);
+
+            expect (context->getClipBounds() == Rectangle<int> (0, 0, 100, 80));
+            expectEquals (context->getPhysicalPixelScaleFactor(), 2.0f);
+
+            context->saveState();
+            context->setOrigin ({ 20, 10 });
+            expect (context->getClipBounds() == Rectangle<int> (-20, -10, 100, 80));
+            expect (context->clipToRectangle ({ 0, 0, 30, 30 }));
+            expect (context->getClipBounds() == Rectangle<int> (0, 0, 30, 30));
+            expect (! context->clipRegionIntersects ({ 40, 0, 10, 10 }));
+
+            context->addTransform (AffineTransform::scale (2.0f));
+            expectEquals (context->getPhysicalPixelScaleFactor(), 4.0f);
+            expect (context->getClipBounds() == Rectangle<int> (0, 0, 15, 15));
+
+            context->restoreState();
+            expect (context->getClipBounds() == Rectangle<int> (0, 0, 100, 80));
+            expectEquals (context->getPhysicalPixelScaleFactor(), 2.0f);
+        }
+
+        beginTest ("Recording again replaces the previous recording");
+        {
+            DisplayList list;
+            record (list, paintScene);
+            record (list, [] (Graphics& g) { g.fillAll (Colours::blue); });
+
+            expectEquals (list.getNumCommands(), 4); // save, fill, fillAll and restore
+
+            const auto replayed = render ([&] (Graphics& g) { list.replay (g.getInternalContext()); });
+            expect (replayed.getPixelAt (20, 20) == Colours::blue);
+
+            list.clear();
+            expect (list.isEmpty());
+        }
+    }
+
+private:
+    static constexpr auto size = 160;
+
+    struct CountingContext final : public LowLevelGraphicsSoftwareRenderer
+    {
+        using LowLevelGraphicsSoftwareRenderer::LowLevelGraphicsSoftwareRenderer;
+        using LowLevelGraphicsSoftwareRenderer::fillRect;
+
+        void fillRect (const Rectangle<int>& r, bool replace) override
+        {
+            ++numRects;
+            LowLevelGraphicsSoftwareRenderer::fillRect (r, replace);
+        }
+
+        int numRects = 0;
+    };
+
+    static void paintScene (Graphics& g)
+    {
+        g.fillAll (Colours::white);
+
+        g.setColour (Colours::darkgrey);
+        g.fillRoundedRectangle ({ 10.0f, 10.0f, 100.0f, 60.0f }, 6.0f);
+        g.setColour (Colours::orange);
+        g.drawEllipse ({ 20.0f, 20.0f, 40.0f, 40.0f }, 3.0f);
+        g.drawLine ({ 0.0f, 150.0f, 150.0f, 0.0f }, 2.5f);
+
+        {
+            Graphics::ScopedSaveState ss (g);
+            g.addTransform (AffineTransform::rotation (0.3f, 80.0f, 80.0f));
+            g.reduceClipRegion (60, 60, 60, 60);
+            g.setGradientFill (ColourGradient (Colours::red, 60.0f, 60.0f, Colours::blue, 120.0f, 120.0f, false));
+            g.fillRect (40, 40, 100, 100);
+        }
+
+        g.beginTransparencyLayer (0.5f);
+        Path p;
+        p.addStar ({ 120.0f, 120.0f }, 5, 10.0f, 30.0f);
+        g.setColour (Colours::purple);
+        g.strokePath (p, PathStrokeType (4.0f));
+        g.endTransparencyLayer();
+
+        Image image (Image::RGB, 8, 8, false);
+        image.clear (image.getBounds(), Colours::teal);
+        g.drawImageAt (image, 130, 10);
+
+        g.setColour (Colours::black);
+        g.setFont (FontOptions { 14.0f });
+        g.drawText ("Recorded", 10, 120, 100, 20, Justification::centredLeft);
+    }
+
+    template <typename Fn>
+    static void record (DisplayList& list, Fn&& paint)
+    {
+        auto context = list.createRecordingContext ({ size, size });
+        Graphics g (*context);
+        paint (g);
+    }
+
+    template <typename Fn>
+    static Image render (Fn&& paint)
+    {
+        Image image (Image::ARGB, size, size, true, SoftwareImageType{});
+        Graphics g (image);
+        paint (g);
+        return image;
+    }
+
+    static bool imagesMatch (const Image& a, const Image& b)
+    {
+        for (int y = 0; y < a.getHeight(); ++y)
+            for (int x = 0; x < a.getWidth(); ++x)
+                if (a.getPixelAt (x, y) != b.getPixelAt (x, y))
+                    return false;
+
+        return true;
+    }
+};
+
+static DisplayListTests displayListTests;
+
+#endif
+
+} // namespace juce
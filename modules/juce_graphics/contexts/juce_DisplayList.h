@@ -0,0 +1,130 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A recording of drawing operations, which can be played back into any
+    LowLevelGraphicsContext.
+
+    Create a recording context with createRecordingContext(), wrap it in a Graphics
+    object and draw into that as usual. Rather than rendering anything, the calls are
+    stored in a compact list of commands, which replay() then sends on to another
+    context. Drawing a recording costs about the same as drawing the original
+    operations, but skips all the work of working out what to draw - laying out text,
+    building paths and so on - which is often the greater part of a complex paint()
+    method.
+
+    Each drawing command remembers the area that it can touch, so when a recording is
+    replayed into a context that's been clipped to a small region, commands that lie
+    entirely outside the clip region aren't sent at all.
+
+    @code
+    DisplayList list;
+
+    {
+        auto context = list.createRecordingContext (getLocalBounds());
+        Graphics recorder (*context);
+        paintComplicatedBackground (recorder);
+    }
+
+    // ...and then in each paint() callback:
+    list.replay (g.getInternalContext());
+    @endcode
+
+    @see Component::setBufferedToDisplayList
+
+    @tags{Graphics}
+*/
+class JUCE_API  DisplayList
+{
+public:
+    //==============================================================================
+    /** Creates an empty list. */
+    DisplayList();
+
+    /** Destructor. */
+    ~DisplayList();
+
+    DisplayList (DisplayList&&) noexcept;
+    DisplayList& operator= (DisplayList&&) noexcept;
+
+    //==============================================================================
+    /** Clears this list and returns a context which records into it.
+
+        The recording context behaves as though it had been clipped to the given area,
+        and its getPhysicalPixelScaleFactor() returns the scale that's passed in, so
+        code that snaps to physical pixels will record the same operations that it
+        would have drawn into a context with that scale.
+
+        The context holds a reference to this list, so it must be deleted before the
+        list is. The list can be replayed while it's being recorded, but will only
+        contain the operations that have been recorded so far.
+    */
+    std::unique_ptr<LowLevelGraphicsContext> createRecordingContext (Rectangle<int> area,
+                                                                     float physicalPixelScaleFactor = 1.0f);
+
+    /** Sends all the recorded operations to another context.
+
+        The operations are applied relative to the target's current origin and transform,
+        and any changes they make to its state - its fill, font, transform and clip
+        region - will be left in place afterwards, so you'll usually want to surround
+        this call with saveState() and restoreState().
+    */
+    void replay (LowLevelGraphicsContext& target) const;
+
+    /** Removes all the recorded operations. */
+    void clear();
+
+    /** Returns true if nothing has been recorded. */
+    bool isEmpty() const noexcept;
+
+    /** Returns the number of operations that have been recorded. */
+    int getNumCommands() const noexcept;
+
+    /** Returns the area which the recorded drawing operations might touch. */
+    Rectangle<int> getBounds() const noexcept;
+
+private:
+    //==============================================================================
+    class Recorder;
+    struct Data;
+    std::unique_ptr<Data> data;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DisplayList)
+};
+
+} // namespace juce
@@ -806,6 +806,25 @@ void Graphics::drawHorizontalLine (const int y, float left, float right) const
         context.fillRect (Rectangle<float> (left, (float) y, right - left, 1.0f));
 }
 
+void Graphics::fillVerticalSpans (float x, float columnWidth, Span<const float> tops, Span<const float> bottoms) const
+{
+    jassert (tops.size() == bottoms.size());
+
+    if (! (context.isClipEmpty() || tops.empty() || columnWidth <= 0.0f))
+        context.fillVerticalSpans (x, columnWidth, tops, bottoms);
+}
+
+void Graphics::drawPolyline (Span<const Point<float>> points, const PathStrokeType& strokeType) const
+{
+    if (! (context.isClipEmpty() || points.size() < 2))
+        context.drawPolyline (points, strokeType);
+}
+
+void Graphics::drawPolyline (Span<const Point<float>> points, float lineThickness) const
+{
+    drawPolyline (points, PathStrokeType (lineThickness, PathStrokeType::beveled));
+}
+
 void Graphics::drawLine (Line<float> line) const
 {
     context.drawLine (line);
@@ -421,6 +421,25 @@ public:
                          float lineThickness = 1.0f,
                          int dashIndexToStartFrom = 0) const;
 
+    /** Draws a series of connected lines through a set of points.
+
+        This does the same as stroking a Path made of the points, but renderers can
+        draw it without having to create the Path, which makes a difference for long
+        lines such as waveforms and plots.
+
+        @see strokePath, fillVerticalSpans
+    */
+    void drawPolyline (Span<const Point<float>> points, const PathStrokeType& strokeType) const;
+
+    /** Draws a series of connected lines through a set of points, with a given thickness.
+
+        The lines are joined with bevelled corners, which avoids the spikes that mitred
+        joints would leave on the sharp turns of a waveform.
+
+        @see strokePath, fillVerticalSpans
+    */
+    void drawPolyline (Span<const Point<float>> points, float lineThickness = 1.0f) const;
+
     /** Draws a vertical line of pixels at a given x position.
 
         The x position is an integer, but the top and bottom of the line can be sub-pixel
@@ -439,6 +458,22 @@ public:
     */
     void drawHorizontalLine (int y, float left, float right) const;
 
+    /** Fills a row of adjacent vertical spans, such as the columns of a waveform.
+
+        The spans are each columnWidth wide, and the left-hand edge of the first one
+        is at x. Span i runs from tops[i] down to bottoms[i], and is skipped if its
+        bottom isn't below its top. The tops and bottoms can be sub-pixel positions,
+        and will be anti-aliased.
+
+        This does the same as filling a RectangleList containing a rectangle for each
+        span, but is much quicker when there are thousands of them.
+
+        @see drawVerticalLine, drawPolyline
+    */
+    void fillVerticalSpans (float x, float columnWidth,
+                            Span<const float> tops,
+                            Span<const float> bottoms) const;
+
     //==============================================================================
     /** Fills a path using the currently selected colour or brush. */
     void fillPath (const Path& path) const;
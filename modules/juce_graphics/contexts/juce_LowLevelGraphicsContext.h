@@ -129,6 +129,37 @@ public:
         fillPath (p, {});
     }
 
+    /** Fills a row of adjacent vertical spans. @see Graphics::fillVerticalSpans */
+    virtual void fillVerticalSpans (float x, float columnWidth, Span<const float> tops, Span<const float> bottoms)
+    {
+        const auto numColumns = jmin (tops.size(), bottoms.size());
+
+        RectangleList<float> spans;
+        spans.ensureStorageAllocated ((int) numColumns);
+
+        for (size_t i = 0; i < numColumns; ++i)
+            if (tops[i] < bottoms[i])
+                spans.addWithoutMerging ({ x + (float) i * columnWidth, tops[i], columnWidth, bottoms[i] - tops[i] });
+
+        fillRectList (spans);
+    }
+
+    /** Strokes a series of connected lines. @see Graphics::drawPolyline */
+    virtual void drawPolyline (Span<const Point<float>> points, const PathStrokeType& strokeType)
+    {
+        if (points.empty())
+            return;
+
+        Path p;
+        p.preallocateSpace ((int) points.size() * 3);
+        p.startNewSubPath (points.front());
+
+        for (size_t i = 1; i < points.size(); ++i)
+            p.lineTo (points[i]);
+
+        strokePath (p, strokeType, {});
+    }
+
     virtual void setFont (const Font&) = 0;
     virtual const Font& getFont() = 0;
 
@@ -182,6 +182,21 @@ void LowLevelGraphicsSoftwareRenderer::fillPath (const Path& path, const AffineT
     impl->fillPath (path, t);
 }
 
+void LowLevelGraphicsSoftwareRenderer::strokePath (const Path& path, const PathStrokeType& strokeType, const AffineTransform& t)
+{
+    impl->strokePath (path, strokeType, t);
+}
+
+void LowLevelGraphicsSoftwareRenderer::drawPolyline (Span<const Point<float>> points, const PathStrokeType& strokeType)
+{
+    impl->drawPolyline (points, strokeType);
+}
+
+void LowLevelGraphicsSoftwareRenderer::fillVerticalSpans (float x, float columnWidth, Span<const float> tops, Span<const float> bottoms)
+{
+    impl->fillVerticalSpans (x, columnWidth, tops, bottoms);
+}
+
 void LowLevelGraphicsSoftwareRenderer::drawImage (const Image& im, const AffineTransform& t)
 {
     impl->drawImage (im, t);
@@ -215,4 +230,627 @@ void LowLevelGraphicsSoftwareRenderer::drawGlyphs (Span<const uint16_t> glyphs,
     return impl->drawGlyphs (glyphs, positions, t);
 }
 
+void LowLevelGraphicsSoftwareRenderer::setStrokeCacheSize (size_t maxBytes)
+{
+    RenderingHelpers::StrokeCache::getInstance().setMaxMemoryUsage (maxBytes);
+}
+
+size_t LowLevelGraphicsSoftwareRenderer::getStrokeCacheSize()
+{
+    return RenderingHelpers::StrokeCache::getInstance().getMaxMemoryUsage();
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class SoftwareRendererTextTests final : public UnitTest
+{
+public:
+    SoftwareRendererTextTests()  : UnitTest ("LowLevelGraphicsSoftwareRenderer text", UnitTestCategories::graphics)  {}
+
+    void runTest() override
+    {
+        const Font font { FontOptions { getTestTypeface() }.withHeight (17.0f) };
+
+        beginTest ("Glyphs drawn from the atlas match glyphs drawn from edge-tables");
+        {
+            for (auto subPixelOffset : { 0.0f, 0.25f, 0.5f, 0.75f })
+            {
+                const auto draw = [&] (auto&& setUpContext)
+                {
+                    return drawGlyphs (font, [&] (Graphics& g)
+                    {
+                        setUpContext (g);
+                        g.setColour (Colours::darkblue);
+                    }, subPixelOffset);
+                };
+
+                const auto fromAtlas = draw ([] (Graphics&) {});
+                const auto fromEdgeTables = draw ([] (Graphics& g) { g.reduceClipRegion (getPathClip()); });
+
+                expect (! isBlank (fromAtlas));
+                expect (imagesMatch (fromAtlas, fromEdgeTables));
+            }
+        }
+
+        beginTest ("Atlas glyphs respect the fill and clip region");
+        {
+            const auto setUpFill = [] (Graphics& g)
+            {
+                g.excludeClipRegion ({ 40, 0, 13, 100 });
+                g.excludeClipRegion ({ 0, 18, 300, 3 });
+                g.setGradientFill (ColourGradient::horizontal (Colours::red.withAlpha (0.7f), 0.0f, Colours::green, 250.0f));
+            };
+
+            const auto fromAtlas = drawGlyphs (font, setUpFill, 0.5f);
+            const auto fromEdgeTables = drawGlyphs (font, [&] (Graphics& g)
+            {
+                g.reduceClipRegion (getPathClip());
+                setUpFill (g);
+            }, 0.5f);
+
+            expect (! isBlank (fromAtlas));
+            expect (imagesMatch (fromAtlas, fromEdgeTables));
+        }
+
+        beginTest ("Glyph positions are rounded to a quarter of a pixel");
+        {
+            const auto draw = [&] (float offset)
+            {
+                return drawGlyphs (font, [] (Graphics& g) { g.setColour (Colours::black); }, offset);
+            };
+
+            expect (imagesMatch (draw (0.3f), draw (0.25f)));
+            expect (imagesMatch (draw (0.9f), draw (1.0f)));
+            expect (! imagesMatch (draw (0.5f), draw (0.25f)));
+        }
+
+        beginTest ("Clearing the typeface cache clears the atlas");
+        {
+            drawGlyphs (font, [] (Graphics& g) { g.setColour (Colours::black); }, 0.0f);
+            expect (RenderingHelpers::GlyphAtlas::getInstance().getNumGlyphs() > 0);
+
+            Typeface::clearTypefaceCache();
+            expectEquals (RenderingHelpers::GlyphAtlas::getInstance().getNumGlyphs(), 0);
+        }
+    }
+
+private:
+    static Typeface::Ptr getTestTypeface()
+    {
+        return Typeface::createSystemTypefaceFor (FontBinaryData::Karla_Regular_Typo_Off_Offsets_Off,
+                                                  std::size (FontBinaryData::Karla_Regular_Typo_Off_Offsets_Off));
+    }
+
+    // Any clip that isn't a list of rectangles stops the renderer from using the atlas
+    static Path getPathClip()
+    {
+        Path p;
+        p.addRectangle (0.0f, 0.0f, 1000.0f, 1000.0f);
+        return p;
+    }
+
+    template <typename SetUpContext>
+    static Image drawGlyphs (const Font& font, SetUpContext&& setUpContext, float subPixelOffset)
+    {
+        Image image (Image::ARGB, 300, 40, true, SoftwareImageType());
+        Graphics g (image);
+        setUpContext (g);
+
+        std::vector<uint16_t> glyphs;
+        std::vector<Point<float>> positions;
+
+        for (uint16_t i = 0; i < 24; ++i)
+        {
+            glyphs.push_back ((uint16_t) (i + 5));
+            positions.emplace_back (subPixelOffset + (float) i * 11.0f, 25.0f);
+        }
+
+        auto& context = g.getInternalContext();
+        context.setFont (font);
+        context.drawGlyphs (glyphs, positions, {});
+        return image;
+    }
+
+    static bool isBlank (const Image& image)
+    {
+        const Image::BitmapData data (image, Image::BitmapData::readOnly);
+
+        for (int y = 0; y < image.getHeight(); ++y)
+            for (int x = 0; x < image.getWidth(); ++x)
+                if (data.getPixelColour (x, y).getAlpha() != 0)
+                    return false;
+
+        return true;
+    }
+
+    static bool imagesMatch (const Image& a, const Image& b)
+    {
+        const Image::BitmapData dataA (a, Image::BitmapData::readOnly);
+        const Image::BitmapData dataB (b, Image::BitmapData::readOnly);
+
+        for (int y = 0; y < a.getHeight(); ++y)
+        {
+            for (int x = 0; x < a.getWidth(); ++x)
+            {
+                const auto pa = dataA.getPixelColour (x, y).getPixelARGB();
+                const auto pb = dataB.getPixelColour (x, y).getPixelARGB();
+
+                for (auto channel : { &PixelARGB::getAlpha, &PixelARGB::getRed, &PixelARGB::getGreen, &PixelARGB::getBlue })
+                    if (std::abs ((int) (pa.*channel)() - (int) (pb.*channel)()) > 1)
+                        return false;
+            }
+        }
+
+        return true;
+    }
+};
+
+static SoftwareRendererTextTests softwareRendererTextTests;
+
+//==============================================================================
+class TextRenderingBenchmarks final : public UnitTest
+{
+public:
+    TextRenderingBenchmarks()  : UnitTest ("Text rendering benchmarks", UnitTestCategories::benchmarks)  {}
+
+    void runTest() override
+    {
+        beginTest ("Table of text");
+
+        const auto typeface = Font::getDefaultTypefaceForFont (FontOptions{});
+
+        if (typeface == nullptr)
+        {
+            logMessage ("Skipping benchmark: no default typeface found");
+            return;
+        }
+
+        const Font font { FontOptions { typeface }.withHeight (14.0f) };
+
+        logMessage (String (numRows) + " rows of " + String (numColumns) + " cells, times per frame:");
+
+        // Each frame lays out different strings, so that every one has to be shaped
+        logMessage ("Laying out new text: " + timeFrames ([&] (int frame) { layOut (font, frame); }));
+
+        // ...whereas a table that's being repainted lays out the same strings each time
+        logMessage ("Laying out the same text: " + timeFrames ([&] (int) { layOut (font, 0); }));
+
+        const auto arrangement = layOut (font, 0);
+        Image image (Image::ARGB, numColumns * columnWidth, numRows * rowHeight, true, SoftwareImageType());
+
+        logMessage ("Drawing from edge-tables: " + timeFrames ([&] (int)
+        {
+            Graphics g (image);
+            Path p;
+            p.addRectangle (image.getBounds().toFloat());
+            g.reduceClipRegion (p);
+            g.setColour (Colours::black);
+            arrangement.draw (g);
+        }));
+
+        logMessage ("Drawing from the glyph atlas: " + timeFrames ([&] (int)
+        {
+            Graphics g (image);
+            g.setColour (Colours::black);
+            arrangement.draw (g);
+        }));
+    }
+
+private:
+    static constexpr int numRows = 40, numColumns = 4, rowHeight = 20, columnWidth = 150, numFrames = 50;
+
+    template <typename Fn>
+    static String timeFrames (Fn&& fn)
+    {
+        const auto start = Time::getMillisecondCounterHiRes();
+
+        for (int i = 0; i < numFrames; ++i)
+            fn (i);
+
+        return String ((Time::getMillisecondCounterHiRes() - start) / numFrames, 2) + " ms";
+    }
+
+    static GlyphArrangement layOut (const Font& font, int frame)
+    {
+        static constexpr const char* columns[] { "Plug-in ", "Manufacturer ", "VST3 ", "Version 1." };
+
+        GlyphArrangement arrangement;
+
+        for (int row = 0; row < numRows; ++row)
+            for (int column = 0; column < numColumns; ++column)
+                arrangement.addLineOfText (font,
+                                           columns[column] + String (frame * numRows + row),
+                                           (float) (column * columnWidth + 4),
+                                           (float) (row * rowHeight + 15));
+
+        return arrangement;
+    }
+};
+
+static TextRenderingBenchmarks textRenderingBenchmarks;
+
+//==============================================================================
+class SoftwareRendererStrokeTests final : public UnitTest
+{
+public:
+    SoftwareRendererStrokeTests()  : UnitTest ("LowLevelGraphicsSoftwareRenderer strokes", UnitTestCategories::graphics)  {}
+
+    void runTest() override
+    {
+        const auto path = createWaveform (200, { 10.0f, 10.0f, 180.0f, 80.0f });
+        const PathStrokeType stroke (2.5f, PathStrokeType::curved, PathStrokeType::rounded);
+
+        beginTest ("Strokes are drawn the same as the paths created by PathStrokeType");
+        {
+            for (auto transform : { AffineTransform(), AffineTransform::rotation (0.3f, 100.0f, 50.0f).scaled (0.8f) })
+            {
+                const auto stroked = draw ([&] (Graphics& g) { g.strokePath (path, stroke, transform); });
+                const auto filled = draw ([&] (Graphics& g)
+                {
+                    Path p;
+                    stroke.createStrokedPath (p, path, transform);
+                    g.fillPath (p);
+                });
+
+                // The pieces of the stroke overlap on the inside of each bend, where their
+                // anti-aliased edges add up slightly differently from those of a single outline
+                expect (getNumDifferentPixels (stroked, filled) * 25 < getNumDrawnPixels (filled));
+            }
+        }
+
+        beginTest ("Cached strokes match uncached strokes");
+        {
+            const ScopedValueSetter<size_t> cacheSize { cacheSizeSetting, 4 * 1024 * 1024 };
+            LowLevelGraphicsSoftwareRenderer::setStrokeCacheSize (cacheSizeSetting);
+            RenderingHelpers::StrokeCache::getInstance().reset();
+
+            const auto drawAt = [&] (Point<float> offset)
+            {
+                return draw ([&] (Graphics& g) { g.strokePath (path, stroke, AffineTransform::translation (offset)); });
+            };
+
+            const auto first = drawAt ({});
+            expectEquals (RenderingHelpers::StrokeCache::getInstance().getNumEntries(), 1);
+
+            const auto second = drawAt ({});
+            const auto moved = drawAt ({ 5.0f, -3.0f });
+            expectEquals (RenderingHelpers::StrokeCache::getInstance().getNumEntries(), 1);
+
+            const auto movedByFraction = drawAt ({ 5.5f, -3.0f });
+            expectEquals (RenderingHelpers::StrokeCache::getInstance().getNumEntries(), 2);
+
+            LowLevelGraphicsSoftwareRenderer::setStrokeCacheSize (0);
+            expectEquals (RenderingHelpers::StrokeCache::getInstance().getNumEntries(), 0);
+
+            expect (getNumDifferentPixels (first, second) == 0);
+            expect (getNumDifferentPixels (moved, drawAt ({ 5.0f, -3.0f })) == 0);
+            expect (getNumDifferentPixels (movedByFraction, drawAt ({ 5.5f, -3.0f })) == 0);
+        }
+    }
+
+    static Path createWaveform (int numPoints, Rectangle<float> area)
+    {
+        Random random (123);
+        Path p;
+
+        for (int i = 0; i < numPoints; ++i)
+        {
+            const auto x = area.getX() + area.getWidth() * (float) i / (float) (numPoints - 1);
+            const auto level = std::sin ((float) i * 0.05f) * 0.7f + (random.nextFloat() - 0.5f) * 0.6f;
+            const Point<float> point { x, area.getCentreY() + level * area.getHeight() * 0.5f };
+
+            if (i == 0)
+                p.startNewSubPath (point);
+            else
+                p.lineTo (point);
+        }
+
+        return p;
+    }
+
+private:
+    size_t cacheSizeSetting = 0;
+
+    template <typename Fn>
+    static Image draw (Fn&& fn)
+    {
+        Image image (Image::ARGB, 200, 100, true, SoftwareImageType());
+        Graphics g (image);
+        g.setColour (Colours::black);
+        fn (g);
+        return image;
+    }
+
+    static int getNumDrawnPixels (const Image& image)
+    {
+        const Image::BitmapData data (image, Image::BitmapData::readOnly);
+        int numDrawn = 0;
+
+        for (int y = 0; y < image.getHeight(); ++y)
+            for (int x = 0; x < image.getWidth(); ++x)
+                if (data.getPixelColour (x, y).getAlpha() != 0)
+                    ++numDrawn;
+
+        return numDrawn;
+    }
+
+    static int getNumDifferentPixels (const Image& a, const Image& b)
+    {
+        const Image::BitmapData dataA (a, Image::BitmapData::readOnly);
+        const Image::BitmapData dataB (b, Image::BitmapData::readOnly);
+        int numDifferent = 0;
+
+        for (int y = 0; y < a.getHeight(); ++y)
+            for (int x = 0; x < a.getWidth(); ++x)
+                if (std::abs ((int) dataA.getPixelColour (x, y).getAlpha() - (int) dataB.getPixelColour (x, y).getAlpha()) > 64)
+                    ++numDifferent;
+
+        return numDifferent;
+    }
+};
+
+static SoftwareRendererStrokeTests softwareRendererStrokeTests;
+
+//==============================================================================
+class PathStrokingBenchmarks final : public UnitTest
+{
+public:
+    PathStrokingBenchmarks()  : UnitTest ("Path stroking benchmarks", UnitTestCategories::benchmarks)  {}
+
+    void runTest() override
+    {
+        beginTest ("Large polyline");
+
+        const auto path = SoftwareRendererStrokeTests::createWaveform (numPoints, { 0.0f, 0.0f, (float) width, (float) height });
+        const PathStrokeType stroke (1.5f);
+        Image image (Image::ARGB, width, height, true, SoftwareImageType());
+
+        logMessage ("Stroking " + String (numPoints) + " points into " + String (width) + "x" + String (height)
+                    + ", times per frame:");
+
+        logMessage ("Creating a stroked path: " + timeFrames ([&]
+        {
+            Graphics g (image);
+            Path stroked;
+            stroke.createStrokedPath (stroked, path);
+            g.fillPath (stroked);
+        }));
+
+        logMessage ("Stroking directly into an edge-table: " + timeFrames ([&]
+        {
+            Graphics g (image);
+            g.strokePath (path, stroke);
+        }));
+
+        const auto oldCacheSize = LowLevelGraphicsSoftwareRenderer::getStrokeCacheSize();
+        LowLevelGraphicsSoftwareRenderer::setStrokeCacheSize (64 * 1024 * 1024);
+
+        logMessage ("Stroking with the cache: " + timeFrames ([&]
+        {
+            Graphics g (image);
+            g.strokePath (path, stroke);
+        }));
+
+        LowLevelGraphicsSoftwareRenderer::setStrokeCacheSize (oldCacheSize);
+    }
+
+private:
+    static constexpr int numPoints = 20000, width = 1600, height = 400, numFrames = 20;
+
+    template <typename Fn>
+    static String timeFrames (Fn&& fn)
+    {
+        const auto start = Time::getMillisecondCounterHiRes();
+
+        for (int i = 0; i < numFrames; ++i)
+            fn();
+
+        return String ((Time::getMillisecondCounterHiRes() - start) / numFrames, 2) + " ms";
+    }
+};
+
+static PathStrokingBenchmarks pathStrokingBenchmarks;
+
+//==============================================================================
+class SoftwareRendererWaveformTests final : public UnitTest
+{
+public:
+    SoftwareRendererWaveformTests()  : UnitTest ("LowLevelGraphicsSoftwareRenderer waveforms", UnitTestCategories::graphics)  {}
+
+    void runTest() override
+    {
+        Random random (99);
+        std::vector<float> tops, bottoms;
+        std::vector<Point<float>> points;
+
+        for (int i = 0; i < 150; ++i)
+        {
+            const auto centre = 50.0f + std::sin ((float) i * 0.1f) * 20.0f;
+            const auto size = random.nextFloat() * 30.0f;
+            tops.push_back (centre - size);
+            bottoms.push_back (centre + size * 0.7f);
+            points.emplace_back (20.0f + (float) i, centre - size);
+        }
+
+        beginTest ("Vertical spans match the equivalent rectangles");
+        {
+            for (auto transform : { AffineTransform(),
+                                    AffineTransform::scale (1.3f, 0.8f).translated (3.5f, 2.25f),
+                                    AffineTransform::rotation (0.2f) })
+            {
+                const auto spans = draw (transform, [&] (Graphics& g) { g.fillVerticalSpans (10.5f, 1.0f, tops, bottoms); });
+                const auto rectangles = draw (transform, [&] (Graphics& g)
+                {
+                    RectangleList<float> list;
+
+                    for (size_t i = 0; i < tops.size(); ++i)
+                        list.addWithoutMerging ({ 10.5f + (float) i, tops[i], 1.0f, bottoms[i] - tops[i] });
+
+                    g.fillRectList (list);
+                });
+
+                expect (imagesMatch (spans, rectangles, 2));
+            }
+        }
+
+        beginTest ("Polylines match stroked paths");
+        {
+            const PathStrokeType stroke (1.5f, PathStrokeType::beveled);
+
+            for (auto transform : { AffineTransform(), AffineTransform::scale (1.7f).translated (-10.0f, 0.5f) })
+            {
+                const auto polyline = draw (transform, [&] (Graphics& g) { g.drawPolyline (points, stroke); });
+                const auto path = draw (transform, [&] (Graphics& g)
+                {
+                    Path p;
+                    p.startNewSubPath (points.front());
+
+                    for (auto& point : points)
+                        p.lineTo (point);
+
+                    g.strokePath (p, stroke);
+                });
+
+                expect (imagesMatch (polyline, path, 0));
+            }
+        }
+    }
+
+private:
+    template <typename Fn>
+    static Image draw (const AffineTransform& transform, Fn&& fn)
+    {
+        Image image (Image::ARGB, 240, 120, true, SoftwareImageType());
+        Graphics g (image);
+        g.addTransform (transform);
+        g.setColour (Colours::darkgreen);
+        fn (g);
+        return image;
+    }
+
+    static bool imagesMatch (const Image& a, const Image& b, int tolerance)
+    {
+        const Image::BitmapData dataA (a, Image::BitmapData::readOnly);
+        const Image::BitmapData dataB (b, Image::BitmapData::readOnly);
+
+        for (int y = 0; y < a.getHeight(); ++y)
+            for (int x = 0; x < a.getWidth(); ++x)
+                if (std::abs ((int) dataA.getPixelColour (x, y).getAlpha() - (int) dataB.getPixelColour (x, y).getAlpha()) > tolerance)
+                    return false;
+
+        return true;
+    }
+};
+
+static SoftwareRendererWaveformTests softwareRendererWaveformTests;
+
+//==============================================================================
+class WaveformDrawingBenchmarks final : public UnitTest
+{
+public:
+    WaveformDrawingBenchmarks()  : UnitTest ("Waveform drawing benchmarks", UnitTestCategories::benchmarks)  {}
+
+    void runTest() override
+    {
+        beginTest ("Tracks of waveforms");
+
+        Random random (1);
+        std::vector<float> tops, bottoms;
+
+        for (int i = 0; i < width; ++i)
+        {
+            const auto level = std::abs (std::sin ((float) i * 0.01f)) * 0.8f + random.nextFloat() * 0.2f;
+            tops.push_back (0.5f - level * 0.5f);
+            bottoms.push_back (0.5f + level * 0.5f);
+        }
+
+        // Each track scales the same normalised data to fit, as a waveform view would
+        const auto getTrackTransform = [] (int track)
+        {
+            return AffineTransform::scale (1.0f, (float) trackHeight).translated (0.0f, (float) (track * trackHeight));
+        };
+
+        std::vector<std::vector<Point<float>>> trackPoints;
+
+        for (int track = 0; track < numTracks; ++track)
+        {
+            auto& points = trackPoints.emplace_back();
+
+            for (int i = 0; i < width; ++i)
+                points.push_back (Point<float> ((float) i, tops[(size_t) i]).transformedBy (getTrackTransform (track)));
+        }
+
+        Image image (Image::ARGB, width, numTracks * trackHeight, true, SoftwareImageType());
+
+        logMessage (String (numTracks) + " tracks of " + String (width) + " columns, times per frame:");
+
+        logMessage ("Filling a RectangleList: " + timeFrames ([&] (Graphics& g, int track)
+        {
+            RectangleList<float> list;
+            list.ensureStorageAllocated (width);
+            const auto y = (float) (track * trackHeight);
+
+            for (int i = 0; i < width; ++i)
+                list.addWithoutMerging ({ (float) i, y + tops[(size_t) i] * trackHeight,
+                                          1.0f, (bottoms[(size_t) i] - tops[(size_t) i]) * trackHeight });
+
+            g.fillRectList (list);
+        }, image));
+
+        logMessage ("Filling vertical spans: " + timeFrames ([&] (Graphics& g, int track)
+        {
+            Graphics::ScopedSaveState s (g);
+            g.addTransform (getTrackTransform (track));
+            g.fillVerticalSpans (0.0f, 1.0f, tops, bottoms);
+        }, image));
+
+        logMessage ("Stroking a Path: " + timeFrames ([&] (Graphics& g, int track)
+        {
+            const auto& points = trackPoints[(size_t) track];
+
+            Path p;
+            p.preallocateSpace (width * 3);
+            p.startNewSubPath (points.front());
+
+            for (auto& point : points)
+                p.lineTo (point);
+
+            g.strokePath (p, PathStrokeType (1.0f, PathStrokeType::beveled));
+        }, image));
+
+        logMessage ("Drawing a polyline: " + timeFrames ([&] (Graphics& g, int track)
+        {
+            g.drawPolyline (trackPoints[(size_t) track], 1.0f);
+        }, image));
+    }
+
+private:
+    static constexpr int width = 4096, numTracks = 64, trackHeight = 48, numFrames = 5;
+
+    template <typename Fn>
+    static String timeFrames (Fn&& drawTrack, Image& image)
+    {
+        const auto start = Time::getMillisecondCounterHiRes();
+
+        for (int i = 0; i < numFrames; ++i)
+        {
+            image.clear (image.getBounds());
+            Graphics g (image);
+            g.setColour (Colours::black);
+
+            for (int track = 0; track < numTracks; ++track)
+                drawTrack (g, track);
+        }
+
+        return String ((Time::getMillisecondCounterHiRes() - start) / numFrames, 2) + " ms";
+    }
+};
+
+static WaveformDrawingBenchmarks waveformDrawingBenchmarks;
+
+#endif
+
 } // namespace juce
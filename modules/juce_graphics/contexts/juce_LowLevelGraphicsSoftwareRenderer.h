@@ -88,6 +88,9 @@ public:
     void fillRect (const Rectangle<float>& r) override;
     void fillRectList (const RectangleList<float>& list) override;
     void fillPath (const Path& path, const AffineTransform& t) override;
+    void strokePath (const Path& path, const PathStrokeType& strokeType, const AffineTransform& t) override;
+    void drawPolyline (Span<const Point<float>> points, const PathStrokeType& strokeType) override;
+    void fillVerticalSpans (float x, float columnWidth, Span<const float> tops, Span<const float> bottoms) override;
     void drawImage (const Image& im, const AffineTransform& t) override;
     void drawLine (const Line<float>& line) override;
     void setFont (const Font& newFont) override;
@@ -98,6 +101,25 @@ public:
                      Span<const Point<float>> positions,
                      const AffineTransform& t) override;
 
+    //==============================================================================
+    /** Sets the number of bytes that may be used to keep the edge-tables of
+        recently-stroked paths.
+
+        When this is more than zero, each path that's stroked is kept in a cache
+        along with its stroke and transform, so that drawing exactly the same stroke
+        again - even if it's been moved by a whole number of pixels - can skip all
+        the work of turning it into an edge-table. This helps when large, complex
+        paths like waveforms or plots are redrawn without changing, but it costs
+        some time to look up and store each stroke, so it's off by default.
+
+        The cache is shared by all software renderers, and the least recently used
+        tables are discarded when it's full.
+    */
+    static void setStrokeCacheSize (size_t maxBytes);
+
+    /** Returns the size that was set with setStrokeCacheSize(). */
+    static size_t getStrokeCacheSize();
+
 private:
     class Impl;
     std::unique_ptr<Impl> impl;
@@ -0,0 +1,264 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+#if JUCE_INTEL && (defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2))
+ #define JUCE_SIMD_FLOAT4_USE_SSE2 1
+ #if ! JUCE_MSVC
+  #include <emmintrin.h>
+ #endif
+#elif JUCE_ARM && (defined (__ARM_NEON) || defined (__ARM_NEON__) || defined (_M_ARM64)) && ! JUCE_32BIT
+ #define JUCE_SIMD_FLOAT4_USE_NEON 1
+ #if JUCE_MSVC
+  #include <arm64_neon.h>
+ #else
+  #include <arm_neon.h>
+ #endif
+#endif
+
+namespace juce::detail
+{
+
+//==============================================================================
+/*  Four floats that are operated on together, for the inner loops of the software
+    renderer, the image effects and juce_animation's AnimationBatch.
+
+    This is a cut-down version of the juce_dsp module's SIMDRegister, which this
+    module can't depend on. It uses SSE2 or 64-bit ARM NEON where they're available,
+    and otherwise works on the four values in turn. Loops written with it don't rely on the compiler
+    deciding to vectorise them, which GCC won't do at -O2 unless it knows the number
+    of iterations, or at all when the loop makes a floating-point comparison.
+
+    All the loads and stores are unaligned.
+*/
+class SIMDFloat4
+{
+public:
+    static constexpr int size = 4;
+
+    /** Returns a register holding the same value in every lane. */
+    static SIMDFloat4 expand (float v) noexcept
+    {
+       #if JUCE_SIMD_FLOAT4_USE_SSE2
+        return SIMDFloat4 (_mm_set1_ps (v));
+       #elif JUCE_SIMD_FLOAT4_USE_NEON
+        return SIMDFloat4 (vdupq_n_f32 (v));
+       #else
+        return SIMDFloat4 (v, v, v, v);
+       #endif
+    }
+
+    /** Returns a register holding four values, with the first one in the first lane. */
+    static SIMDFloat4 fromValues (float a, float b, float c, float d) noexcept
+    {
+       #if JUCE_SIMD_FLOAT4_USE_SSE2
+        return SIMDFloat4 (_mm_setr_ps (a, b, c, d));
+       #elif JUCE_SIMD_FLOAT4_USE_NEON
+        const float values[] { a, b, c, d };
+        return SIMDFloat4 (vld1q_f32 (values));
+       #else
+        return SIMDFloat4 (a, b, c, d);
+       #endif
+    }
+
+    /** Loads four floats. */
+    static SIMDFloat4 load (const float* source) noexcept
+    {
+       #if JUCE_SIMD_FLOAT4_USE_SSE2
+        return SIMDFloat4 (_mm_loadu_ps (source));
+       #elif JUCE_SIMD_FLOAT4_USE_NEON
+        return SIMDFloat4 (vld1q_f32 (source));
+       #else
+        return SIMDFloat4 (source[0], source[1], source[2], source[3]);
+       #endif
+    }
+
+    /** Loads four bytes as floats. */
+    static SIMDFloat4 loadBytes (const uint8* source) noexcept
+    {
+       #if JUCE_SIMD_FLOAT4_USE_SSE2
+        int32 packed;
+        memcpy (&packed, source, sizeof (packed));
+        const auto zero = _mm_setzero_si128();
+        const auto bytes = _mm_cvtsi32_si128 (packed);
+        return SIMDFloat4 (_mm_cvtepi32_ps (_mm_unpacklo_epi16 (_mm_unpacklo_epi8 (bytes, zero), zero)));
+       #elif JUCE_SIMD_FLOAT4_USE_NEON
+        uint32 packed;
+        memcpy (&packed, source, sizeof (packed));
+        const auto shorts = vmovl_u8 (vreinterpret_u8_u32 (vdup_n_u32 (packed)));
+        return SIMDFloat4 (vcvtq_f32_u32 (vmovl_u16 (vget_low_u16 (shorts))));
+       #else
+        return SIMDFloat4 ((float) source[0], (float) source[1], (float) source[2], (float) source[3]);
+       #endif
+    }
+
+    /** Stores the four values. */
+    void store (float* dest) const noexcept
+    {
+       #if JUCE_SIMD_FLOAT4_USE_SSE2
+        _mm_storeu_ps (dest, value);
+       #elif JUCE_SIMD_FLOAT4_USE_NEON
+        vst1q_f32 (dest, value);
+       #else
+        std::copy (std::begin (value), std::end (value), dest);
+       #endif
+    }
+
+    /** Stores the four values as ints, rounding them towards zero as a cast would. */
+    void storeAsInts (int* dest) const noexcept
+    {
+       #if JUCE_SIMD_FLOAT4_USE_SSE2
+        _mm_storeu_si128 (reinterpret_cast<__m128i*> (dest), _mm_cvttps_epi32 (value));
+       #elif JUCE_SIMD_FLOAT4_USE_NEON
+        vst1q_s32 (dest, vcvtq_s32_f32 (value));
+       #else
+        for (int i = 0; i < size; ++i)
+            dest[i] = (int) value[i];
+       #endif
+    }
+
+    /** Stores the four values as bytes, rounding them towards zero as a cast would.
+        The values must all be between 0 and 255.
+    */
+    void storeAsBytes (uint8* dest) const noexcept
+    {
+       #if JUCE_SIMD_FLOAT4_USE_SSE2
+        const auto ints = _mm_cvttps_epi32 (value);
+        const auto packed = _mm_cvtsi128_si32 (_mm_packus_epi16 (_mm_packs_epi32 (ints, ints), ints));
+        memcpy (dest, &packed, sizeof (packed));
+       #elif JUCE_SIMD_FLOAT4_USE_NEON
+        const auto shorts = vqmovun_s32 (vcvtq_s32_f32 (value));
+        const auto packed = vget_lane_u32 (vreinterpret_u32_u8 (vqmovn_u16 (vcombine_u16 (shorts, shorts))), 0);
+        memcpy (dest, &packed, sizeof (packed));
+       #else
+        for (int i = 0; i < size; ++i)
+            dest[i] = (uint8) value[i];
+       #endif
+    }
+
+    //==============================================================================
+   #if JUCE_SIMD_FLOAT4_USE_SSE2
+    friend SIMDFloat4 operator+ (SIMDFloat4 a, SIMDFloat4 b) noexcept   { return SIMDFloat4 (_mm_add_ps (a.value, b.value)); }
+    friend SIMDFloat4 operator- (SIMDFloat4 a, SIMDFloat4 b) noexcept   { return SIMDFloat4 (_mm_sub_ps (a.value, b.value)); }
+    friend SIMDFloat4 operator* (SIMDFloat4 a, SIMDFloat4 b) noexcept   { return SIMDFloat4 (_mm_mul_ps (a.value, b.value)); }
+    friend SIMDFloat4 operator/ (SIMDFloat4 a, SIMDFloat4 b) noexcept   { return SIMDFloat4 (_mm_div_ps (a.value, b.value)); }
+    friend SIMDFloat4 min (SIMDFloat4 a, SIMDFloat4 b) noexcept         { return SIMDFloat4 (_mm_min_ps (a.value, b.value)); }
+    friend SIMDFloat4 max (SIMDFloat4 a, SIMDFloat4 b) noexcept         { return SIMDFloat4 (_mm_max_ps (a.value, b.value)); }
+    friend SIMDFloat4 abs (SIMDFloat4 a) noexcept                       { return SIMDFloat4 (_mm_andnot_ps (_mm_set1_ps (-0.0f), a.value)); }
+
+    /** Rounds each value towards zero, as a cast to int would. The values must fit in an int. */
+    friend SIMDFloat4 truncate (SIMDFloat4 a) noexcept                  { return SIMDFloat4 (_mm_cvtepi32_ps (_mm_cvttps_epi32 (a.value))); }
+
+    /** Returns ifLess in the lanes where a < b, and ifNotLess in the others. */
+    friend SIMDFloat4 selectWhereLess (SIMDFloat4 a, SIMDFloat4 b, SIMDFloat4 ifLess, SIMDFloat4 ifNotLess) noexcept
+    {
+        const auto mask = _mm_cmplt_ps (a.value, b.value);
+        return SIMDFloat4 (_mm_or_ps (_mm_and_ps (mask, ifLess.value), _mm_andnot_ps (mask, ifNotLess.value)));
+    }
+   #elif JUCE_SIMD_FLOAT4_USE_NEON
+    friend SIMDFloat4 operator+ (SIMDFloat4 a, SIMDFloat4 b) noexcept   { return SIMDFloat4 (vaddq_f32 (a.value, b.value)); }
+    friend SIMDFloat4 operator- (SIMDFloat4 a, SIMDFloat4 b) noexcept   { return SIMDFloat4 (vsubq_f32 (a.value, b.value)); }
+    friend SIMDFloat4 operator* (SIMDFloat4 a, SIMDFloat4 b) noexcept   { return SIMDFloat4 (vmulq_f32 (a.value, b.value)); }
+    friend SIMDFloat4 operator/ (SIMDFloat4 a, SIMDFloat4 b) noexcept   { return SIMDFloat4 (vdivq_f32 (a.value, b.value)); }
+    friend SIMDFloat4 min (SIMDFloat4 a, SIMDFloat4 b) noexcept         { return SIMDFloat4 (vminq_f32 (a.value, b.value)); }
+    friend SIMDFloat4 max (SIMDFloat4 a, SIMDFloat4 b) noexcept         { return SIMDFloat4 (vmaxq_f32 (a.value, b.value)); }
+    friend SIMDFloat4 abs (SIMDFloat4 a) noexcept                       { return SIMDFloat4 (vabsq_f32 (a.value)); }
+
+    /** Rounds each value towards zero, as a cast to int would. The values must fit in an int. */
+    friend SIMDFloat4 truncate (SIMDFloat4 a) noexcept                  { return SIMDFloat4 (vrndq_f32 (a.value)); }
+
+    /** Returns ifLess in the lanes where a < b, and ifNotLess in the others. */
+    friend SIMDFloat4 selectWhereLess (SIMDFloat4 a, SIMDFloat4 b, SIMDFloat4 ifLess, SIMDFloat4 ifNotLess) noexcept
+    {
+        return SIMDFloat4 (vbslq_f32 (vcltq_f32 (a.value, b.value), ifLess.value, ifNotLess.value));
+    }
+   #else
+    friend SIMDFloat4 operator+ (SIMDFloat4 a, SIMDFloat4 b) noexcept   { return forEachLane (a, b, [] (float x, float y) { return x + y; }); }
+    friend SIMDFloat4 operator- (SIMDFloat4 a, SIMDFloat4 b) noexcept   { return forEachLane (a, b, [] (float x, float y) { return x - y; }); }
+    friend SIMDFloat4 operator* (SIMDFloat4 a, SIMDFloat4 b) noexcept   { return forEachLane (a, b, [] (float x, float y) { return x * y; }); }
+    friend SIMDFloat4 operator/ (SIMDFloat4 a, SIMDFloat4 b) noexcept   { return forEachLane (a, b, [] (float x, float y) { return x / y; }); }
+    friend SIMDFloat4 min (SIMDFloat4 a, SIMDFloat4 b) noexcept         { return forEachLane (a, b, [] (float x, float y) { return jmin (x, y); }); }
+    friend SIMDFloat4 max (SIMDFloat4 a, SIMDFloat4 b) noexcept         { return forEachLane (a, b, [] (float x, float y) { return jmax (x, y); }); }
+    friend SIMDFloat4 abs (SIMDFloat4 a) noexcept                       { return forEachLane (a, a, [] (float x, float) { return std::abs (x); }); }
+
+    /** Rounds each value towards zero, as a cast to int would. The values must fit in an int. */
+    friend SIMDFloat4 truncate (SIMDFloat4 a) noexcept                  { return forEachLane (a, a, [] (float x, float) { return (float) (int) x; }); }
+
+    /** Returns ifLess in the lanes where a < b, and ifNotLess in the others. */
+    friend SIMDFloat4 selectWhereLess (SIMDFloat4 a, SIMDFloat4 b, SIMDFloat4 ifLess, SIMDFloat4 ifNotLess) noexcept
+    {
+        for (int i = 0; i < size; ++i)
+            ifLess.value[i] = a.value[i] < b.value[i] ? ifLess.value[i] : ifNotLess.value[i];
+
+        return ifLess;
+    }
+   #endif
+
+    friend SIMDFloat4 operator+ (SIMDFloat4 a, float b) noexcept        { return a + expand (b); }
+    friend SIMDFloat4 operator- (SIMDFloat4 a, float b) noexcept        { return a - expand (b); }
+    friend SIMDFloat4 operator- (float a, SIMDFloat4 b) noexcept        { return expand (a) - b; }
+    friend SIMDFloat4 operator* (SIMDFloat4 a, float b) noexcept        { return a * expand (b); }
+    friend SIMDFloat4 operator* (float a, SIMDFloat4 b) noexcept        { return expand (a) * b; }
+    friend SIMDFloat4 min (SIMDFloat4 a, float b) noexcept              { return min (a, expand (b)); }
+    friend SIMDFloat4 max (SIMDFloat4 a, float b) noexcept              { return max (a, expand (b)); }
+
+    SIMDFloat4& operator+= (SIMDFloat4 other) noexcept                  { return *this = *this + other; }
+    SIMDFloat4& operator-= (SIMDFloat4 other) noexcept                  { return *this = *this - other; }
+
+private:
+   #if JUCE_SIMD_FLOAT4_USE_SSE2
+    explicit SIMDFloat4 (__m128 v) noexcept : value (v) {}
+
+    __m128 value;
+   #elif JUCE_SIMD_FLOAT4_USE_NEON
+    explicit SIMDFloat4 (float32x4_t v) noexcept : value (v) {}
+
+    float32x4_t value;
+   #else
+    SIMDFloat4 (float a, float b, float c, float d) noexcept : value { a, b, c, d } {}
+
+    template <typename Fn>
+    static SIMDFloat4 forEachLane (SIMDFloat4 a, SIMDFloat4 b, Fn&& fn) noexcept
+    {
+        for (int i = 0; i < size; ++i)
+            a.value[i] = fn (a.value[i], b.value[i]);
+
+        return a;
+    }
+
+    float value[size];
+   #endif
+};
+
+} // namespace juce::detail
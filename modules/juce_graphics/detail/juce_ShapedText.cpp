@@ -74,6 +74,11 @@ public:
         return text;
     }
 
+    auto& getOptions() const
+    {
+        return options;
+    }
+
     auto getTextRange (int64 glyphIndex) const
     {
         return simpleShapedText.getTextRange (glyphIndex);
@@ -155,9 +160,107 @@ ShapedText::ShapedText (String text) : ShapedText (std::move (text), {})
 {
 }
 
+//==============================================================================
+namespace
+{
+    /*  Shaping is by far the most expensive part of laying out text, and views such as tables and
+        lists tend to lay out the same strings with the same options on every repaint. Shaped text is
+        immutable, so recently shaped strings are kept here and shared between ShapedText objects.
+
+        Entries are looked up using a hash of the text and options, and are compared in full before
+        being reused, so a collision just costs an extra shaping pass.
+    */
+    template <typename Impl>
+    class ShapedTextCache final : public DeletedAtShutdown,
+                                  public GlyphArrangementCacheBase
+    {
+    public:
+        ShapedTextCache() = default;
+
+        ~ShapedTextCache() override
+        {
+            GlyphCacheRegistry::get().erase (token);
+            clearSingletonInstance();
+        }
+
+        std::shared_ptr<const Impl> get (String text, ShapedTextOptions options)
+        {
+            if (text.length() > maxCachedTextLength)
+                return std::make_shared<const Impl> (std::move (text), std::move (options));
+
+            const auto create = [&] (auto)
+            {
+                return std::make_shared<const Impl> (text, options);
+            };
+
+            const auto key = getHash (text, options);
+            auto result = cache.get (key, create);
+
+            if (result->getText() == text && result->getOptions() == options)
+                return result;
+
+            return create (key);
+        }
+
+        JUCE_DECLARE_SINGLETON_INLINE (ShapedTextCache, false)
+
+    private:
+        static uint64 getHash (const String& text, const ShapedTextOptions& options)
+        {
+            uint64 result = (uint64) text.hashCode64();
+
+            const auto combine = [&] (auto value)
+            {
+                result = (result * 1000003) ^ (uint64) std::hash<decltype (value)>{} (value);
+            };
+
+            const auto combineOptional = [&] (const auto& value)
+            {
+                combine (value.has_value());
+
+                if (value.has_value())
+                    combine (*value);
+            };
+
+            combine (options.getJustification().getFlags());
+            combineOptional (options.getReadingDirection());
+            combineOptional (options.getWordWrapWidth());
+            combineOptional (options.getAlignmentWidth());
+            combineOptional (options.getHeight());
+            combine (options.getFirstLineIndent());
+            combine (options.getLeading());
+            combine (options.getAdditiveLineSpacing());
+            combine (options.isBaselineAtZero());
+            combine (options.getTrailingWhitespacesShouldFit());
+            combine (options.getMaxNumLines());
+            combine (options.getDrawLinesInFull());
+            combine (options.getAllowBreakingInsideWord());
+            combine (options.getEllipsis().hashCode64());
+
+            for (const auto item : options.getFontsForRange())
+            {
+                combine (item.range.getStart());
+                combine (item.range.getEnd());
+                combine (item.value.getTypefaceName().hashCode64());
+                combine (item.value.getTypefaceStyle().hashCode64());
+                combine (item.value.getHeight());
+                combine (item.value.getHorizontalScale());
+                combine (item.value.getExtraKerningFactor());
+            }
+
+            return result;
+        }
+
+        static constexpr int maxCachedTextLength = 1024;
+
+        GlyphCacheRegistry::Token token = GlyphCacheRegistry::get().insert (this);
+        LruCache<uint64, std::shared_ptr<const Impl>, 512> cache;
+    };
+}
+
 ShapedText::ShapedText (String text, Options options)
+    : impl (ShapedTextCache<Impl>::getInstance()->get (std::move (text), std::move (options)))
 {
-    impl = std::make_shared<Impl> (std::move (text), std::move (options));
 }
 
 void ShapedText::draw (const Graphics& g, AffineTransform transform) const
@@ -229,4 +332,62 @@ const JustifiedText& ShapedText::getJustifiedText() const { return impl->getJust
 
 const SimpleShapedText& ShapedText::getSimpleShapedText() const { return impl->getSimpleShapedText(); }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ShapedTextTests final : public UnitTest
+{
+public:
+    ShapedTextTests()  : UnitTest ("ShapedText", UnitTestCategories::text)  {}
+
+    void runTest() override
+    {
+        const auto typeface = Typeface::createSystemTypefaceFor (FontBinaryData::Karla_Regular_Typo_Off_Offsets_Off,
+                                                                 std::size (FontBinaryData::Karla_Regular_Typo_Off_Offsets_Off));
+        const auto options = ShapedTextOptions{}.withFont (FontOptions { typeface }.withHeight (15.0f))
+                                                .withWordWrapWidth (100.0f);
+
+        const auto isShared = [] (const ShapedText& a, const ShapedText& b)
+        {
+            return &a.getSimpleShapedText() == &b.getSimpleShapedText();
+        };
+
+        beginTest ("Text shaped with the same options is shared");
+        {
+            const ShapedText a { "Some text to shape", options };
+            const ShapedText b { "Some text to shape", options };
+
+            expect (isShared (a, b));
+            expectEquals (a.getNumGlyphs(), b.getNumGlyphs());
+        }
+
+        beginTest ("Different text or options are shaped separately");
+        {
+            const ShapedText a { "Some text to shape", options };
+
+            expect (! isShared (a, ShapedText { "Some other text", options }));
+            expect (! isShared (a, ShapedText { "Some text to shape", options.withWordWrapWidth (50.0f) }));
+            expect (! isShared (a, ShapedText { "Some text to shape", options.withFont (FontOptions { typeface }.withHeight (16.0f)) }));
+
+            const ShapedText narrow { "Some text to shape", options.withWordWrapWidth (50.0f) };
+            expect (narrow.getHeight() > a.getHeight());
+        }
+
+        beginTest ("Clearing the typeface cache discards shaped text");
+        {
+            const ShapedText a { "Some text to shape", options };
+            Typeface::clearTypefaceCache();
+            const ShapedText b { "Some text to shape", options };
+
+            expect (! isShared (a, b));
+            expectEquals (a.getNumGlyphs(), b.getNumGlyphs());
+        }
+    }
+};
+
+static ShapedTextTests shapedTextTests;
+
+#endif
+
 } // namespace juce::detail
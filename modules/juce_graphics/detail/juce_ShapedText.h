@@ -110,7 +110,7 @@ public:
 
 private:
     class Impl;
-    std::shared_ptr<Impl> impl;
+    std::shared_ptr<const Impl> impl;
 };
 
 } // namespace juce::detail
@@ -35,6 +35,124 @@
 namespace juce
 {
 
+//==============================================================================
+// Keeps the blurred images of recently drawn path shadows. A shadow's image only depends
+// on the shape of its path and its radius, so paths are moved to the origin before
+// they're looked up, and identical shapes at different whole-pixel positions share
+// an image.
+class PathShadowCache  : private DeletedAtShutdown
+{
+public:
+    PathShadowCache() = default;
+    ~PathShadowCache() override  { clearSingletonInstance(); }
+
+    void setMaxMemoryUsage (size_t newMaxBytes)
+    {
+        const ScopedLock sl (lock);
+        maxBytes = newMaxBytes;
+        removeOldEntries (0);
+    }
+
+    size_t getMaxMemoryUsage() const noexcept   { return maxBytes; }
+
+    /** Returns the shadow image for a path which has been moved to the origin, creating
+        it if needed. Returns an invalid image if the shadow is too big to be cached, in
+        which case the caller should draw it some other way.
+    */
+    template <typename CreateImage>
+    Image get (const Path& path, int radius, int imageTypeID, Rectangle<int> area, CreateImage&& createImage)
+    {
+        const auto size = (size_t) area.getWidth() * (size_t) area.getHeight();
+
+        if (size > maxBytes)
+            return {};
+
+        const auto hash = getHash (path, radius, imageTypeID);
+
+        {
+            const ScopedLock sl (lock);
+
+            for (auto i = entries.begin(); i != entries.end(); ++i)
+            {
+                if (i->hash == hash
+                     && i->radius == radius
+                     && i->imageTypeID == imageTypeID
+                     && i->path == path)
+                {
+                    entries.splice (entries.begin(), entries, i);
+                    return i->image;
+                }
+            }
+        }
+
+        auto image = createImage();
+
+        const ScopedLock sl (lock);
+
+        if (size <= maxBytes)
+        {
+            removeOldEntries (size);
+            entries.push_front ({ hash, path, radius, imageTypeID, image, size });
+            bytesUsed += size;
+        }
+
+        return image;
+    }
+
+    JUCE_DECLARE_SINGLETON_INLINE (PathShadowCache, false)
+
+private:
+    struct Entry
+    {
+        uint64 hash;
+        Path path;
+        int radius, imageTypeID;
+        Image image;
+        size_t size;
+    };
+
+    std::list<Entry> entries;
+    std::atomic<size_t> maxBytes { 0 };
+    size_t bytesUsed = 0;
+    CriticalSection lock;
+
+    void removeOldEntries (size_t spaceNeeded)
+    {
+        while (! entries.empty() && bytesUsed + spaceNeeded > maxBytes)
+        {
+            bytesUsed -= entries.back().size;
+            entries.pop_back();
+        }
+    }
+
+    static uint64 getHash (const Path& path, int radius, int imageTypeID)
+    {
+        uint64 result = 0;
+
+        const auto combine = [&result] (auto value)
+        {
+            result = (result * 1000003) ^ (uint64) std::hash<decltype (value)>{} (value);
+        };
+
+        for (Path::Iterator i (path); i.next();)
+        {
+            combine ((int) i.elementType);
+
+            for (auto v : { i.x1, i.y1, i.x2, i.y2, i.x3, i.y3 })
+                combine (v);
+        }
+
+        combine (path.isUsingNonZeroWinding());
+        combine (radius);
+        combine (imageTypeID);
+
+        return result;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (PathShadowCache)
+};
+
+//==============================================================================
 DropShadow::DropShadow (Colour shadowColour, const int r, Point<int> o) noexcept
     : colour (shadowColour), radius (r), offset (o)
 {
@@ -57,32 +175,66 @@ void DropShadow::drawForImage (Graphics& g, const Image& srcImage) const
     g.drawImageAt (blurred, offset.x, offset.y, true);
 }
 
+static Image createPathShadowImage (const Path& path, int radius, Point<int> pathOffset,
+                                    Rectangle<int> area, const ImageType& imageType)
+{
+    Image pathImage { Image::SingleChannel, area.getWidth(), area.getHeight(), true, imageType };
+    pathImage.setBackupEnabled (false);
+
+    {
+        Graphics g2 (pathImage);
+        g2.setColour (Colours::white);
+        g2.fillPath (path, AffineTransform::translation ((float) (pathOffset.x - area.getX()),
+                                                         (float) (pathOffset.y - area.getY())));
+    }
+
+    pathImage.getPixelData()->applySingleChannelBoxBlurEffect (radius);
+    return pathImage;
+}
+
 void DropShadow::drawForPath (Graphics& g, const Path& path) const
 {
     jassert (radius > 0);
 
-    auto area = (path.getBounds().getSmallestIntegerContainer() + offset)
-            .expanded (radius + 1)
-            .getIntersection (g.getClipBounds().expanded (radius + 1));
+    const auto pathBounds = path.getBounds().getSmallestIntegerContainer();
+    const auto fullArea = (pathBounds + offset).expanded (radius + 1);
+    const auto area = fullArea.getIntersection (g.getClipBounds().expanded (radius + 1));
 
     if (area.getWidth() <= 2 || area.getHeight() <= 2)
         return;
 
     const auto tempImageType = g.getInternalContext().getPreferredImageTypeForTemporaryImages();
-    Image pathImage { Image::SingleChannel, area.getWidth(), area.getHeight(), true, *tempImageType };
-    pathImage.setBackupEnabled (false);
+    g.setColour (colour);
 
+    if (auto* cache = PathShadowCache::getInstance(); cache->getMaxMemoryUsage() > 0)
     {
-        Graphics g2 (pathImage);
-        g2.setColour (Colours::white);
-        g2.fillPath (path, AffineTransform::translation ((float) (offset.x - area.getX()),
-                                                         (float) (offset.y - area.getY())));
+        auto shape = path;
+        shape.applyTransform (AffineTransform::translation (-pathBounds.getPosition().toFloat()));
+
+        const auto localArea = fullArea.withPosition (-(radius + 1), -(radius + 1));
+        const auto image = cache->get (shape, radius, tempImageType->getTypeID(), localArea, [&]
+        {
+            return createPathShadowImage (shape, radius, {}, localArea, *tempImageType);
+        });
+
+        if (image.isValid())
+        {
+            g.drawImageAt (image, fullArea.getX(), fullArea.getY(), true);
+            return;
+        }
     }
 
-    pathImage.getPixelData()->applySingleChannelBoxBlurEffect (radius);
+    g.drawImageAt (createPathShadowImage (path, radius, offset, area, *tempImageType), area.getX(), area.getY(), true);
+}
 
-    g.setColour (colour);
-    g.drawImageAt (pathImage, area.getX(), area.getY(), true);
+void DropShadow::setPathShadowCacheSize (size_t maxBytes)
+{
+    PathShadowCache::getInstance()->setMaxMemoryUsage (maxBytes);
+}
+
+size_t DropShadow::getPathShadowCacheSize()
+{
+    return PathShadowCache::getInstance()->getMaxMemoryUsage();
 }
 
 static void drawShadowSection (Graphics& g, ColourGradient& cg, Rectangle<float> area,
@@ -150,4 +302,78 @@ void DropShadowEffect::applyEffect (Image& image, Graphics& g, float scaleFactor
     g.drawImageAt (image, 0, 0);
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class DropShadowTests final : public UnitTest
+{
+public:
+    DropShadowTests()  : UnitTest ("DropShadow", UnitTestCategories::graphics)  {}
+
+    void runTest() override
+    {
+        const auto previousCacheSize = DropShadow::getPathShadowCacheSize();
+
+        Path star;
+        star.addStar ({ 40.5f, 35.25f }, 5, 10.0f, 25.0f);
+
+        beginTest ("Cached path shadows match uncached ones");
+        {
+            DropShadow::setPathShadowCacheSize (0);
+            const auto expected = drawShadow (star, { 3, 4 });
+
+            DropShadow::setPathShadowCacheSize (1024 * 1024);
+            expect (isSameImage (drawShadow (star, { 3, 4 }), expected));
+            expect (isSameImage (drawShadow (star, { 3, 4 }), expected));
+        }
+
+        beginTest ("Cached path shadows can be moved");
+        {
+            DropShadow::setPathShadowCacheSize (0);
+            const auto expected = drawShadow (star, { -7, 12 });
+
+            DropShadow::setPathShadowCacheSize (1024 * 1024);
+            drawShadow (star, { 3, 4 });
+
+            auto movedStar = star;
+            movedStar.applyTransform (AffineTransform::translation (-10.0f, 8.0f));
+            expect (isSameImage (drawShadow (movedStar, { 3, 4 }), expected));
+        }
+
+        beginTest ("Shadows too big for the cache are still drawn");
+        {
+            DropShadow::setPathShadowCacheSize (0);
+            const auto expected = drawShadow (star, { 3, 4 });
+
+            DropShadow::setPathShadowCacheSize (100);
+            expect (isSameImage (drawShadow (star, { 3, 4 }), expected));
+        }
+
+        DropShadow::setPathShadowCacheSize (previousCacheSize);
+    }
+
+private:
+    static Image drawShadow (const Path& path, Point<int> offset)
+    {
+        Image image (Image::ARGB, 100, 100, true, SoftwareImageType());
+        Graphics g (image);
+        DropShadow (Colours::black, 6, offset).drawForPath (g, path);
+        return image;
+    }
+
+    static bool isSameImage (const Image& a, const Image& b)
+    {
+        for (int y = 0; y < a.getHeight(); ++y)
+            for (int x = 0; x < a.getWidth(); ++x)
+                if (a.getPixelAt (x, y) != b.getPixelAt (x, y))
+                    return false;
+
+        return true;
+    }
+};
+
+static DropShadowTests dropShadowTests;
+
+#endif
+
 } // namespace juce
@@ -60,6 +60,25 @@ struct JUCE_API  DropShadow
     */
     void drawForRectangle (Graphics& g, const Rectangle<int>& area) const;
 
+    /** Sets the number of bytes that may be used to keep the shadows of paths that
+        have been drawn recently with drawForPath().
+
+        Blurring is the slowest part of drawing a shadow, so when the same shapes get
+        their shadows drawn over and over again - for instance, by lots of similar
+        components, or by one that's repainted often - keeping the blurred images means
+        that each shape only needs to be blurred once. A shadow can be reused for the same
+        shape and radius even if the path has been moved by a whole number of pixels, or
+        the shadow's colour or offset has changed.
+
+        Cached shadows are always rendered in full, even when only part of them is going
+        to be visible, so this is off by default. The cache is shared by all shadows, and
+        the least recently used images are discarded when it's full.
+    */
+    static void setPathShadowCacheSize (size_t maxBytes);
+
+    /** Returns the size that was set with setPathShadowCacheSize(). */
+    static size_t getPathShadowCacheSize();
+
     /** The colour with which to render the shadow.
         In most cases you'll probably want to leave this as black with an alpha
         value of around 0.5
@@ -83,9 +102,9 @@ struct JUCE_API  DropShadow
     shadow based on what gets drawn inside it. The shadow will also
     be applied to the component's children.
 
-    For speed, this doesn't use a proper gaussian blur, but cheats by
-    using a simple bilinear filter. If you need a really high-quality
-    shadow, check out ImageConvolutionKernel::createGaussianBlur()
+    For speed, this doesn't use a proper gaussian blur, but approximates one
+    with repeated three-pixel blurs. If you need a really high-quality shadow, check out
+    ImagePixelData::applyGaussianBlurEffect()
 
     @see Component::setComponentEffect
 
@@ -47,72 +47,486 @@ EdgeTable::EdgeTable (Rectangle<int> area, const Path& path, const AffineTransfo
      lineStrideElements (maxEdgesPerLine * 2 + 1)
 {
     allocate();
-    int* t = table.data();
+    clearLineSizes();
 
-    for (int i = bounds.getHeight(); --i >= 0;)
+    PathFlatteningIterator iter (path, transform);
+
+    while (iter.next())
+        addLine (iter.x1, iter.y1, iter.x2, iter.y2);
+
+    sanitiseLevels (path.isUsingNonZeroWinding());
+}
+
+//==============================================================================
+// Builds the outline of a stroke as a set of separate polygons - a quad for each
+// line segment, plus the joints and end-caps - which all wind in the same direction,
+// so that with a non-zero winding rule the table ends up containing their union.
+// This avoids all the work that PathStrokeType does to trace a single continuous
+// outline around the stroke.
+struct EdgeTable::StrokeBuilder
+{
+    StrokeBuilder (EdgeTable& t, const PathStrokeType& strokeType,
+                   const AffineTransform& outputTransform, float extraAccuracy)
+        : table (t),
+          output (outputTransform),
+          applyOutputTransform (! outputTransform.isIdentity()),
+          width (strokeType.getStrokeThickness() * 0.5f),
+          maxMiterExtensionSquared (9.0f * strokeType.getStrokeThickness() * strokeType.getStrokeThickness()),
+          tolerance (Path::defaultToleranceForMeasurement / extraAccuracy),
+          jointStyle (strokeType.getJointStyle()),
+          endStyle (strokeType.getEndStyle())
     {
-        *t = 0;
-        t += lineStrideElements;
+        // Choose the angle between the points of a round joint or cap so that the
+        // polygon never strays further than the tolerance from the true circle
+        maxArcStep = width > tolerance ? 2.0f * std::acos (1.0f - tolerance / width)
+                                       : MathConstants<float>::halfPi;
     }
 
-    auto leftLimit   = scale * static_cast<int64_t> (bounds.getX());
-    auto topLimit    = scale * static_cast<int64_t> (bounds.getY());
-    auto rightLimit  = scale * static_cast<int64_t> (bounds.getRight());
-    auto heightLimit = scale * static_cast<int64_t> (bounds.getHeight());
+    void addPath (const Path& path, const AffineTransform& transform)
+    {
+        Path::Iterator iter (path);
+        Point<float> subPathStart;
 
-    PathFlatteningIterator iter (path, transform);
+        while (iter.next())
+        {
+            switch (iter.elementType)
+            {
+                case Path::Iterator::startNewSubPath:
+                    flushSubPath (false);
+                    subPathStart = Point<float> (iter.x1, iter.y1).transformedBy (transform);
+                    points.push_back (subPathStart);
+                    break;
+
+                case Path::Iterator::lineTo:
+                    startIfNeeded (subPathStart);
+                    points.push_back (Point<float> (iter.x1, iter.y1).transformedBy (transform));
+                    break;
+
+                case Path::Iterator::quadraticTo:
+                    startIfNeeded (subPathStart);
+                    addQuadratic (Point<float> (iter.x1, iter.y1).transformedBy (transform),
+                                  Point<float> (iter.x2, iter.y2).transformedBy (transform));
+                    break;
+
+                case Path::Iterator::cubicTo:
+                    startIfNeeded (subPathStart);
+                    addCubic (Point<float> (iter.x1, iter.y1).transformedBy (transform),
+                              Point<float> (iter.x2, iter.y2).transformedBy (transform),
+                              Point<float> (iter.x3, iter.y3).transformedBy (transform));
+                    break;
+
+                case Path::Iterator::closePath:
+                    flushSubPath (true);
+                    break;
+
+                default:
+                    jassertfalse;
+                    break;
+            }
+        }
 
-    while (iter.next())
+        flushSubPath (false);
+    }
+
+    void addPolyline (Span<const Point<float>> polyline)
     {
-        const auto scaleIterY = [] (auto y)
+        points.assign (polyline.begin(), polyline.end());
+        flushSubPath (false);
+    }
+
+private:
+    EdgeTable& table;
+    const AffineTransform output;
+    const bool applyOutputTransform;
+    const float width, maxMiterExtensionSquared, tolerance;
+    float maxArcStep;
+    const PathStrokeType::JointStyle jointStyle;
+    const PathStrokeType::EndCapStyle endStyle;
+
+    std::vector<Point<float>> points, directions, polygon;
+
+    static constexpr float minSegmentLengthSquared = 0.0001f;
+    static constexpr int maxCurveSegments = 1024;
+
+    void startIfNeeded (Point<float> start)
+    {
+        // a path can carry on drawing after closing a sub-path, in which case
+        // it continues from where that sub-path started
+        if (points.empty())
+            points.push_back (start);
+    }
+
+    // The number of lines needed to flatten a curve is found with Wang's formula,
+    // and each point is then evaluated directly from the curve's polynomial form,
+    // so that rounding errors don't build up along the curve.
+    void addQuadratic (Point<float> control, Point<float> end)
+    {
+        const auto start = points.back();
+        const auto b = (control - start) * 2.0f;
+        const auto a = end - control * 2.0f + start;
+
+        const auto numSegments = getNumCurveSegments (0.25f * juce_hypot (a.x, a.y));
+        const auto step = 1.0f / (float) numSegments;
+        auto* dest = appendPoints (numSegments);
+
+        for (int i = 0; i < numSegments; ++i)
+        {
+            const auto t = (float) (i + 1) * step;
+            dest[i] = { (a.x * t + b.x) * t + start.x,
+                        (a.y * t + b.y) * t + start.y };
+        }
+
+        dest[numSegments - 1] = end;
+    }
+
+    void addCubic (Point<float> control1, Point<float> control2, Point<float> end)
+    {
+        const auto start = points.back();
+        const auto c = (control1 - start) * 3.0f;
+        const auto b = (control2 - control1 * 2.0f + start) * 3.0f;
+        const auto a = end - start + (control1 - control2) * 3.0f;
+
+        const auto d1 = start - control1 * 2.0f + control2;
+        const auto d2 = control1 - control2 * 2.0f + end;
+        const auto numSegments = getNumCurveSegments (0.75f * jmax (juce_hypot (d1.x, d1.y), juce_hypot (d2.x, d2.y)));
+        const auto step = 1.0f / (float) numSegments;
+        auto* dest = appendPoints (numSegments);
+
+        for (int i = 0; i < numSegments; ++i)
         {
-            return static_cast<int64_t> (y * 256.0f + (y >= 0 ? 0.5f : -0.5f));
-        };
+            const auto t = (float) (i + 1) * step;
+            dest[i] = { ((a.x * t + b.x) * t + c.x) * t + start.x,
+                        ((a.y * t + b.y) * t + c.y) * t + start.y };
+        }
+
+        dest[numSegments - 1] = end;
+    }
+
+    int getNumCurveSegments (float scaledSecondDifference) const
+    {
+        const auto n = std::ceil (std::sqrt (scaledSecondDifference / tolerance));
+        return n < (float) maxCurveSegments ? jmax (1, (int) n) : maxCurveSegments;
+    }
+
+    Point<float>* appendPoints (int num)
+    {
+        const auto oldSize = points.size();
+        points.resize (oldSize + (size_t) num);
+        return points.data() + oldSize;
+    }
 
-        auto y1 = scaleIterY (iter.y1);
-        auto y2 = scaleIterY (iter.y2);
+    void flushSubPath (bool isClosed)
+    {
+        removeShortSegments (isClosed);
 
-        if (y1 != y2)
+        if (points.size() > 1)
         {
-            y1 -= topLimit;
-            y2 -= topLimit;
+            const auto numPoints = points.size();
+            const auto numSegments = isClosed ? numPoints : numPoints - 1;
 
-            auto startY = y1;
-            int direction = -1;
+            directions.resize (numSegments);
 
-            if (y1 > y2)
+            for (size_t i = 0; i < numSegments; ++i)
             {
-                std::swap (y1, y2);
-                direction = 1;
-            }
+                const auto start = points[i];
+                const auto end = points[i + 1 < numPoints ? i + 1 : 0];
+                const auto delta = end - start;
+                directions[i] = delta / juce_hypot (delta.x, delta.y);
 
-            if (y1 < 0)
-                y1 = 0;
+                addSegment (start, end, directions[i]);
+            }
 
-            if (y2 > heightLimit)
-                y2 = heightLimit;
+            for (size_t i = 1; i < numSegments; ++i)
+                addJoint (points[i], directions[i - 1], directions[i]);
 
-            if (y1 < y2)
+            if (isClosed)
             {
-                const double startX = 256.0f * iter.x1;
-                const double multiplier = (iter.x2 - iter.x1) / (iter.y2 - iter.y1);
-                auto stepSize = static_cast<int64_t> (jlimit (1, 256, 256 / (1 + (int) std::abs (multiplier))));
+                addJoint (points[0], directions[numSegments - 1], directions[0]);
+            }
+            else
+            {
+                addEndCap (points[0], -directions[0]);
+                addEndCap (points[numPoints - 1], directions[numSegments - 1]);
+            }
+        }
 
-                do
-                {
-                    auto step = jmin (stepSize, y2 - y1, 256 - (y1 & 255));
-                    auto x = static_cast<int64_t> (startX + multiplier * static_cast<double> ((y1 + (step >> 1)) - startY));
-                    auto clampedX = static_cast<int> (jlimit (leftLimit, rightLimit, x));
+        points.clear();
+    }
 
-                    addEdgePoint (clampedX, static_cast<int> (y1 / scale), static_cast<int> (direction * step));
-                    y1 += step;
-                }
-                while (y1 < y2);
+    void removeShortSegments (bool isClosed)
+    {
+        if (points.empty())
+            return;
+
+        size_t numKept = 1;
+
+        for (size_t i = 1; i < points.size(); ++i)
+            if (points[i].getDistanceSquaredFrom (points[numKept - 1]) > minSegmentLengthSquared)
+                points[numKept++] = points[i];
+
+        if (isClosed)
+            while (numKept > 1 && points[numKept - 1].getDistanceSquaredFrom (points[0]) <= minSegmentLengthSquared)
+                --numKept;
+
+        points.resize (numKept);
+    }
+
+    static Point<float> getNormal (Point<float> direction) noexcept
+    {
+        return { -direction.y, direction.x };
+    }
+
+    void addSegment (Point<float> start, Point<float> end, Point<float> direction)
+    {
+        const auto offset = getNormal (direction) * width;
+        addPolygon ({ start + offset, end + offset, end - offset, start - offset });
+    }
+
+    void addJoint (Point<float> centre, Point<float> direction1, Point<float> direction2)
+    {
+        const auto cross = direction1.x * direction2.y - direction1.y * direction2.x;
+        const auto dot = direction1.x * direction2.x + direction1.y * direction2.y;
+
+        if (dot > 0.0f && std::abs (cross) < 1.0e-6f)
+            return;
+
+        // the gap to fill is on the outside of the bend
+        const auto side = cross > 0.0f ? -width : width;
+        const auto corner1 = centre + getNormal (direction1) * side;
+        const auto corner2 = centre + getNormal (direction2) * side;
+
+        if (jointStyle == PathStrokeType::curved)
+        {
+            addArc (centre, corner1 - centre, std::atan2 (cross, dot));
+            return;
+        }
+
+        if (jointStyle == PathStrokeType::mitered && dot > -0.999f)
+        {
+            // the distance from each corner to the tip of the mitre is width * tan (angle / 2)
+            const auto extension = width * std::abs (cross) / (1.0f + dot);
+
+            if (extension * extension < maxMiterExtensionSquared)
+            {
+                addPolygon ({ centre, corner1, corner1 + direction1 * extension, corner2 });
+                return;
             }
         }
+
+        addPolygon ({ centre, corner1, corner2 });
     }
 
-    sanitiseLevels (path.isUsingNonZeroWinding());
+    void addEndCap (Point<float> end, Point<float> outwards)
+    {
+        const auto offset = getNormal (outwards) * width;
+
+        if (endStyle == PathStrokeType::square)
+        {
+            const auto extension = outwards * width;
+            addPolygon ({ end + offset, end + offset + extension, end - offset + extension, end - offset });
+        }
+        else if (endStyle == PathStrokeType::rounded)
+        {
+            addArc (end, offset, -MathConstants<float>::pi);
+        }
+    }
+
+    void addArc (Point<float> centre, Point<float> startOffset, float angle)
+    {
+        const auto numSteps = jmax (1, (int) std::ceil (std::abs (angle) / maxArcStep));
+        const auto step = angle / (float) numSteps;
+        const auto cosStep = std::cos (step), sinStep = std::sin (step);
+
+        polygon.clear();
+        polygon.push_back (centre);
+        polygon.push_back (centre + startOffset);
+
+        auto offset = startOffset;
+
+        for (int i = 0; i < numSteps; ++i)
+        {
+            offset = { offset.x * cosStep - offset.y * sinStep,
+                       offset.x * sinStep + offset.y * cosStep };
+            polygon.push_back (centre + offset);
+        }
+
+        addPolygon (polygon.data(), polygon.size());
+    }
+
+    void addPolygon (std::initializer_list<Point<float>> corners)
+    {
+        polygon.assign (corners);
+        addPolygon (polygon.data(), polygon.size());
+    }
+
+    void addPolygon (Point<float>* corners, size_t numCorners)
+    {
+        if (applyOutputTransform)
+            for (size_t i = 0; i < numCorners; ++i)
+                corners[i].applyTransform (output);
+
+        auto area = 0.0f;
+
+        for (size_t i = 0, j = numCorners - 1; i < numCorners; j = i++)
+            area += (corners[j].x - corners[i].x) * (corners[j].y + corners[i].y);
+
+        // every polygon has to wind the same way, otherwise overlapping
+        // parts of the stroke would cancel each other out
+        if (area > 0.0f)
+        {
+            for (size_t i = 0, j = numCorners - 1; i < numCorners; j = i++)
+                table.addLine (corners[j].x, corners[j].y, corners[i].x, corners[i].y);
+        }
+        else if (area < 0.0f)
+        {
+            for (size_t i = 0, j = numCorners - 1; i < numCorners; j = i++)
+                table.addLine (corners[i].x, corners[i].y, corners[j].x, corners[j].y);
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (StrokeBuilder)
+};
+
+EdgeTable::EdgeTable (Rectangle<int> area, const Path& path, const PathStrokeType& strokeType,
+                      const AffineTransform& pathTransform, const AffineTransform& outputTransform,
+                      float extraAccuracy)
+   : bounds (area),
+     // the stroke of each segment adds a few edges wherever it crosses a line,
+     // so this needs more room than the table for a filled path
+     maxEdgesPerLine (jmax (defaultEdgesPerLine, 8 * (int) std::sqrt (path.data.size()))),
+     lineStrideElements (maxEdgesPerLine * 2 + 1)
+{
+    jassert (extraAccuracy > 0);
+
+    allocate();
+    clearLineSizes();
+
+    if (strokeType.getStrokeThickness() > 0)
+        StrokeBuilder (*this, strokeType, outputTransform, extraAccuracy).addPath (path, pathTransform);
+
+    sanitiseLevels (true);
+}
+
+EdgeTable::EdgeTable (Rectangle<int> area, Span<const Point<float>> polyline, const PathStrokeType& strokeType,
+                      const AffineTransform& outputTransform, float extraAccuracy)
+   : bounds (area),
+     maxEdgesPerLine (jmax (defaultEdgesPerLine, 8 * (int) std::sqrt (polyline.size() * 3))),
+     lineStrideElements (maxEdgesPerLine * 2 + 1)
+{
+    jassert (extraAccuracy > 0);
+
+    allocate();
+    clearLineSizes();
+
+    if (strokeType.getStrokeThickness() > 0)
+        StrokeBuilder (*this, strokeType, outputTransform, extraAccuracy).addPolyline (polyline);
+
+    sanitiseLevels (true);
+}
+
+EdgeTable::EdgeTable (Rectangle<int> area, float x, float columnWidth,
+                      Span<const float> tops, Span<const float> bottoms,
+                      const AffineTransform& transform)
+   : bounds (area),
+     maxEdgesPerLine (defaultEdgesPerLine),
+     lineStrideElements (defaultEdgesPerLine * 2 + 1)
+{
+    jassert (tops.size() == bottoms.size());
+    jassert (exactlyEqual (transform.mat01, 0.0f) && exactlyEqual (transform.mat10, 0.0f)
+              && transform.mat00 > 0 && transform.mat11 > 0);
+
+    const auto numColumns = (int) jmin (tops.size(), bottoms.size());
+    const auto left = x * transform.mat00 + transform.mat02;
+    const auto width = columnWidth * transform.mat00;
+
+    // Only the columns that overlap the clip limits need to be looked at
+    const auto firstColumn = width > 0 ? jlimit (0, numColumns, (int) std::floor (((float) area.getX() - left) / width)) : 0;
+    const auto lastColumn  = width > 0 ? jlimit (0, numColumns, (int) std::ceil (((float) area.getRight() - left) / width)) : 0;
+    const auto numVisible = (size_t) jmax (0, lastColumn - firstColumn);
+
+    HeapBlock<float> columnTops (numVisible), columnBottoms (numVisible);
+
+    const auto yScale = transform.mat11, yOffset = transform.mat12;
+    auto minTop = std::numeric_limits<float>::max();
+    auto maxBottom = std::numeric_limits<float>::lowest();
+
+    for (size_t i = 0; i < numVisible; ++i)
+    {
+        columnTops[i]    = tops   [(size_t) firstColumn + i] * yScale + yOffset;
+        columnBottoms[i] = bottoms[(size_t) firstColumn + i] * yScale + yOffset;
+        minTop    = jmin (minTop, columnTops[i]);
+        maxBottom = jmax (maxBottom, columnBottoms[i]);
+    }
+
+    // The table only needs to cover the rows that the spans touch
+    if (numVisible > 0 && minTop < maxBottom)
+        bounds = bounds.getIntersection (Rectangle<int>::leftTopRightBottom (bounds.getX(), (int) std::floor (minTop),
+                                                                             bounds.getRight(), (int) std::ceil (maxBottom)));
+    else
+        bounds.setHeight (0);
+
+    allocate();
+    clearLineSizes();
+
+    if (bounds.isEmpty())
+        return;
+
+    const auto leftLimit  = scale * bounds.getX();
+    const auto rightLimit = scale * bounds.getRight();
+
+    HeapBlock<int> levels (numVisible), edges (numVisible + 1);
+    HeapBlock<LineItem> points (numVisible + 1);
+
+    for (size_t i = 0; i <= numVisible; ++i)
+        edges[i] = jlimit (leftLimit, rightLimit, roundToInt ((left + (float) ((size_t) firstColumn + i) * width) * (float) scale));
+
+    using detail::SIMDFloat4;
+    constexpr auto numLanes = (size_t) SIMDFloat4::size;
+
+    for (int y = bounds.getY(); y < bounds.getBottom(); ++y)
+    {
+        const auto rowTop = (float) y;
+        const auto rowBottom = rowTop + 1.0f;
+        size_t column = 0;
+
+        // The coverage of the columns is worked out several at a time
+        for (; column + numLanes <= numVisible; column += numLanes)
+        {
+            const auto coverage = min (SIMDFloat4::load (columnBottoms + column), rowBottom)
+                                - max (SIMDFloat4::load (columnTops + column), rowTop);
+
+            (max (min (coverage, 1.0f), 0.0f) * 255.0f + 0.5f).storeAsInts (levels + column);
+        }
+
+        for (; column < numVisible; ++column)
+        {
+            const auto coverage = jmin (columnBottoms[column], rowBottom) - jmax (columnTops[column], rowTop);
+            levels[column] = (int) (jmax (0.0f, jmin (1.0f, coverage)) * 255.0f + 0.5f);
+        }
+
+        // The points go from left to right with absolute levels, which is the form
+        // that sanitiseLevels() would leave them in
+        int numPoints = 0, previousLevel = 0;
+
+        for (size_t i = 0; i < numVisible; ++i)
+        {
+            if (levels[i] != previousLevel && edges[i] < rightLimit)
+            {
+                points[numPoints++] = { edges[i], levels[i] };
+                previousLevel = levels[i];
+            }
+        }
+
+        if (previousLevel != 0)
+            points[numPoints++] = { edges[numVisible], 0 };
+
+        if (numPoints >= maxEdgesPerLine)
+            remapWithExtraSpace (numPoints);
+
+        auto* line = table.data() + lineStrideElements * (y - bounds.getY());
+        line[0] = numPoints;
+        std::copy (points.get(), points.get() + numPoints, reinterpret_cast<LineItem*> (line + 1));
+    }
 }
 
 EdgeTable::EdgeTable (Rectangle<int> rectangleToAdd)
@@ -332,8 +746,8 @@ void EdgeTable::sanitiseLevels (const bool useNonZeroWinding) noexcept
             std::sort (items, itemsEnd);
 
             auto* src = items;
-            auto correctedNum = num;
-            int level = 0;
+            auto* const firstItem = items;
+            int level = 0, previousLevel = 0;
 
             while (src < itemsEnd)
             {
@@ -345,7 +759,6 @@ void EdgeTable::sanitiseLevels (const bool useNonZeroWinding) noexcept
                 {
                     level += src->level;
                     ++src;
-                    --correctedNum;
                 }
 
                 auto corrected = std::abs (level);
@@ -365,13 +778,21 @@ void EdgeTable::sanitiseLevels (const bool useNonZeroWinding) noexcept
                     }
                 }
 
+                // a point that doesn't change the level makes no difference to the
+                // result, and overlapping shapes like strokes can create lots of them
+                if (corrected == previousLevel)
+                    continue;
+
                 items->x = x;
                 items->level = corrected;
                 ++items;
+                previousLevel = corrected;
             }
 
-            lineStart[0] = correctedNum;
-            (items - 1)->level = 0; // force the last level to 0, just in case something went wrong in creating the table
+            lineStart[0] = (int) (items - firstItem);
+
+            if (items != firstItem)
+                (items - 1)->level = 0; // force the last level to 0, just in case something went wrong in creating the table
         }
 
         lineStart += lineStrideElements;
@@ -382,7 +803,6 @@ void EdgeTable::remapTableForNumEdges (const int newNumEdgesPerLine)
 {
     if (newNumEdgesPerLine != maxEdgesPerLine)
     {
-        jassert (newNumEdgesPerLine > maxEdgesPerLine);
         maxEdgesPerLine = newNumEdgesPerLine;
 
         jassert (bounds.getHeight() > 0);
@@ -406,6 +826,61 @@ inline void EdgeTable::remapWithExtraSpace (int numPoints)
     jassert (numPoints < maxEdgesPerLine);
 }
 
+void EdgeTable::addLine (float x1, float y1, float x2, float y2)
+{
+    const auto scaleY = [] (auto y)
+    {
+        return static_cast<int64_t> (y * 256.0f + (y >= 0 ? 0.5f : -0.5f));
+    };
+
+    auto scaledY1 = scaleY (y1);
+    auto scaledY2 = scaleY (y2);
+
+    if (scaledY1 == scaledY2)
+        return;
+
+    auto leftLimit   = scale * static_cast<int64_t> (bounds.getX());
+    auto topLimit    = scale * static_cast<int64_t> (bounds.getY());
+    auto rightLimit  = scale * static_cast<int64_t> (bounds.getRight());
+    auto heightLimit = scale * static_cast<int64_t> (bounds.getHeight());
+
+    scaledY1 -= topLimit;
+    scaledY2 -= topLimit;
+
+    auto startY = scaledY1;
+    int direction = -1;
+
+    if (scaledY1 > scaledY2)
+    {
+        std::swap (scaledY1, scaledY2);
+        direction = 1;
+    }
+
+    if (scaledY1 < 0)
+        scaledY1 = 0;
+
+    if (scaledY2 > heightLimit)
+        scaledY2 = heightLimit;
+
+    if (scaledY1 < scaledY2)
+    {
+        const double startX = 256.0f * x1;
+        const double multiplier = (x2 - x1) / (y2 - y1);
+        auto stepSize = static_cast<int64_t> (jlimit (1, 256, 256 / (1 + (int) std::abs (multiplier))));
+
+        do
+        {
+            auto step = jmin (stepSize, scaledY2 - scaledY1, 256 - (scaledY1 & 255));
+            auto x = static_cast<int64_t> (startX + multiplier * static_cast<double> ((scaledY1 + (step >> 1)) - startY));
+            auto clampedX = static_cast<int> (jlimit (leftLimit, rightLimit, x));
+
+            addEdgePoint (clampedX, static_cast<int> (scaledY1 / scale), static_cast<int> (direction * step));
+            scaledY1 += step;
+        }
+        while (scaledY1 < scaledY2);
+    }
+}
+
 void EdgeTable::optimiseTable()
 {
     int maxLineElements = 0;
@@ -416,6 +891,11 @@ void EdgeTable::optimiseTable()
     remapTableForNumEdges (maxLineElements);
 }
 
+size_t EdgeTable::getMemoryUsage() const noexcept
+{
+    return getEdgeTableAllocationSize (lineStrideElements, bounds.getHeight()) * sizeof (int);
+}
+
 void EdgeTable::addEdgePoint (const int x, const int y, const int winding)
 {
     jassert (y >= 0 && y < bounds.getHeight());
@@ -923,6 +1403,88 @@ public:
             expect (getLevel (filled, { 4, 0 }) == 255);
             expect (getLevel (filled, { 4, 4 }) == 255);
         }
+
+        beginTest ("A stroked EdgeTable should match the table of a path created by PathStrokeType");
+        {
+            Path zigzag;
+            zigzag.startNewSubPath (10.0f, 80.0f);
+
+            for (int i = 1; i < 20; ++i)
+                zigzag.lineTo (10.0f + (float) i * 4.0f, (i % 2) == 0 ? 80.0f : 30.0f + (float) i);
+
+            Path curves;
+            curves.startNewSubPath (15.0f, 50.0f);
+            curves.cubicTo (30.0f, -10.0f, 60.0f, 110.0f, 85.0f, 40.0f);
+            curves.quadraticTo (60.0f, 20.0f, 40.0f, 85.0f);
+
+            Path shapes;
+            shapes.addStar ({ 35.0f, 35.0f }, 5, 10.0f, 25.0f);
+            shapes.addRoundedRectangle (50.0f, 55.0f, 40.0f, 30.0f, 8.0f);
+
+            const auto accuracy = 4.0f;
+            const auto outputTransform = AffineTransform::scale (1.5f).translated (-10.0f, 3.3f);
+
+            for (auto* path : { &zigzag, &curves, &shapes })
+            {
+                for (auto joint : { PathStrokeType::mitered, PathStrokeType::curved, PathStrokeType::beveled })
+                {
+                    for (auto end : { PathStrokeType::butt, PathStrokeType::square, PathStrokeType::rounded })
+                    {
+                        const PathStrokeType stroke (3.0f, joint, end);
+                        const Rectangle<int> area (100, 100);
+
+                        Path strokedPath;
+                        stroke.createStrokedPath (strokedPath, *path, {}, accuracy);
+                        const EdgeTable expected (area, strokedPath, outputTransform);
+                        const EdgeTable actual (area, *path, stroke, {}, outputTransform, accuracy);
+
+                        expect (getNumDifferentPixels (expected, actual, area) <= 5);
+                    }
+                }
+            }
+        }
+
+        beginTest ("An EdgeTable of vertical spans should match the table of the equivalent rectangles");
+        {
+            Random random (42);
+            std::vector<float> tops, bottoms;
+            RectangleList<float> rectangles;
+
+            for (int i = 0; i < 60; ++i)
+            {
+                const auto top = random.nextFloat() * 20.0f;
+                const auto bottom = top + random.nextFloat() * 15.0f;
+                tops.push_back (top);
+                bottoms.push_back (bottom);
+
+                rectangles.addWithoutMerging ({ 2.5f + (float) i * 1.25f, top, 1.25f, bottom - top });
+            }
+
+            const Rectangle<int> area (100, 40);
+            const EdgeTable expected (rectangles);
+            const EdgeTable spans (area, 2.5f, 1.25f, tops, bottoms, {});
+
+            expect (getNumDifferentPixels (expected, spans, area) == 0);
+            expect (spans.getMaximumBounds().getY() == (int) std::floor (rectangles.getBounds().getY()));
+
+            const EdgeTable clipped ({ 20, 5, 30, 10 }, 2.5f, 1.25f, tops, bottoms, {});
+            expect (clipped.getMaximumBounds() == Rectangle<int> (20, 5, 30, 10));
+            expect (getLevel (clipped, { 35, 8 }) == getLevel (spans, { 35, 8 }));
+            expect (getLevel (clipped, { 55, 8 }) == 0);
+        }
+
+        beginTest ("A stroked EdgeTable should clip strokes that lie partly outside its bounds");
+        {
+            Path p;
+            p.startNewSubPath (-50.0f, 5.0f);
+            p.lineTo (50.0f, 5.0f);
+
+            const EdgeTable table ({ 10, 0, 20, 10 }, p, PathStrokeType (4.0f), {}, {});
+
+            expect (table.getMaximumBounds() == Rectangle<int> (10, 0, 20, 10));
+            expect (contains (table, { 15, 4 }));
+            expect (getLevel (table, { 15, 1 }) == 0);
+        }
     }
 
 private:
@@ -1009,6 +1571,26 @@ private:
         return getLevel (et, p) == 255;
     }
 
+    // Counts the pixels whose levels differ noticeably. A few are expected on the inside
+    // of sharp bends, where the pieces of a stroke overlap and their anti-aliased
+    // edges add up slightly differently from those of a single outline.
+    static int getNumDifferentPixels (const EdgeTable& a, const EdgeTable& b, Rectangle<int> area)
+    {
+        EdgeTableFiller fillerA { area.getRight(), area.getBottom() };
+        EdgeTableFiller fillerB { area.getRight(), area.getBottom() };
+        a.iterate (fillerA);
+        b.iterate (fillerB);
+
+        int numDifferent = 0;
+
+        for (int y = area.getY(); y < area.getBottom(); ++y)
+            for (int x = area.getX(); x < area.getRight(); ++x)
+                if (std::abs ((int) fillerA.get (x, y) - (int) fillerB.get (x, y)) > 64)
+                    ++numDifferent;
+
+        return numDifferent;
+    }
+
 };
 
 static EdgeTableTests edgeTableTests;
@@ -35,6 +35,8 @@
 namespace juce
 {
 
+class PathStrokeType;
+
 //==============================================================================
 /**
     A table of horizontal scan-line segments - used for rasterising Paths.
@@ -60,6 +62,65 @@ public:
                const Path& pathToAdd,
                const AffineTransform& transform);
 
+    /** Creates an edge table containing the outline of a stroked path.
+
+        This produces the same shape as calling PathStrokeType::createStrokedPath() and
+        adding the result to a table, but it's much quicker, because the outline goes
+        straight into the table rather than being built up as a new Path and then
+        flattened all over again.
+
+        The stroke's thickness is measured after pathTransform has been applied, and
+        outputTransform is then applied to the stroke's outline, so when drawing into
+        a context that has its own transform, pass the path's transform as the first
+        argument and the context's transform as the second.
+
+        Arrowheads and dashes aren't supported here - use PathStrokeType to create
+        those.
+
+        @param clipLimits               only the region of the stroke that lies within this area will be added
+        @param pathToStroke             the path whose outline should be added to the table
+        @param strokeType               the thickness, joint and end-cap styles to use
+        @param pathTransform            a transform to apply to the path before it's stroked
+        @param outputTransform          a transform to apply to the outline of the stroke
+        @param extraAccuracy            if this is greater than 1.0, curves and round joints are
+                                        broken into more lines, which is needed when the
+                                        outputTransform enlarges the stroke
+    */
+    EdgeTable (Rectangle<int> clipLimits,
+               const Path& pathToStroke,
+               const PathStrokeType& strokeType,
+               const AffineTransform& pathTransform,
+               const AffineTransform& outputTransform,
+               float extraAccuracy = 1.0f);
+
+    /** Creates an edge table containing the outline of a stroked polyline.
+
+        This is the same as the constructor that strokes a Path, but takes the points
+        of a single open sub-path directly, so that long lines such as waveforms don't
+        have to be turned into a Path first.
+    */
+    EdgeTable (Rectangle<int> clipLimits,
+               Span<const Point<float>> polyline,
+               const PathStrokeType& strokeType,
+               const AffineTransform& outputTransform,
+               float extraAccuracy = 1.0f);
+
+    /** Creates an edge table containing a row of vertical spans.
+
+        The spans sit side by side, each one columnWidth wide, with the left-hand edge
+        of the first at x, and span i running from tops[i] down to bottoms[i]. This is
+        the shape of a waveform or a row of level meters, and is much quicker to build
+        than an equivalent table from a RectangleList.
+
+        The transform may only scale and translate the spans - it mustn't rotate or
+        flip them.
+    */
+    EdgeTable (Rectangle<int> clipLimits,
+               float x, float columnWidth,
+               Span<const float> tops,
+               Span<const float> bottoms,
+               const AffineTransform& transform);
+
     /** Creates an edge table containing a rectangle. */
     explicit EdgeTable (Rectangle<int> rectangleToAdd);
 
@@ -91,6 +152,9 @@ public:
     */
     void optimiseTable();
 
+    /** Returns the number of bytes that the table is using. */
+    size_t getMemoryUsage() const noexcept;
+
 
     //==============================================================================
     /** Iterates the lines in the table, for rendering.
@@ -209,10 +273,13 @@ private:
     int maxEdgesPerLine, lineStrideElements;
     bool needToCheckEmptiness = true;
 
+    struct StrokeBuilder;
+
     void allocate();
     void clearLineSizes() noexcept;
     void addEdgePoint (int x, int y, int winding);
     void addEdgePointPair (int x1, int x2, int y, int winding);
+    void addLine (float x1, float y1, float x2, float y2);
     void remapTableForNumEdges (int newNumEdgesPerLine);
     void remapWithExtraSpace (int numPointsNeeded);
     void intersectWithEdgeTableLine (int y, const int* otherLine);
@@ -0,0 +1,194 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#if JUCE_INTEL && (defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2))
+ #define JUCE_IMAGE_ROW_CONVERSION_USE_SSE2 1
+ #if ! JUCE_MSVC
+  #include <emmintrin.h>
+ #endif
+#elif JUCE_ARM && (defined (__ARM_NEON) || defined (__ARM_NEON__) || defined (_M_ARM64)) && ! JUCE_32BIT
+ #define JUCE_IMAGE_ROW_CONVERSION_USE_NEON 1
+ #if JUCE_MSVC
+  #include <arm64_neon.h>
+ #else
+  #include <arm_neon.h>
+ #endif
+#endif
+
+namespace juce
+{
+
+//==============================================================================
+/*  Converts rows of decoded pixels into the Image pixel formats.
+
+    The image decoders produce rows of bytes in R, G, B (, A) order, which need
+    swapping into the platform's byte order, and the alpha needs premultiplying.
+    When the destination pixels are tightly packed and the byte order is B, G, R, A,
+    this is done several pixels at a time with SSE2 or NEON; the results are
+    identical to those of PixelARGB::premultiply().
+*/
+namespace ImageRowConversion
+{
+    constexpr bool isBGRA = PixelARGB::indexB == 0 && PixelARGB::indexG == 1
+                         && PixelARGB::indexR == 2 && PixelARGB::indexA == 3;
+
+    /*  Converts as many whole groups of pixels as it can into tightly-packed BGRA
+        pixels, returning the number that it converted.
+    */
+    static int rgbaToPremultipliedBGRAGroups ([[maybe_unused]] const uint8* src,
+                                              [[maybe_unused]] uint8* dest,
+                                              [[maybe_unused]] int numPixels) noexcept
+    {
+        int i = 0;
+
+       #if JUCE_IMAGE_ROW_CONVERSION_USE_SSE2
+        const auto zero       = _mm_setzero_si128();
+        const auto allOnes    = _mm_set1_epi32 (-1);
+        const auto colours    = _mm_set1_epi32 (0x00ffffff);
+        const auto greenAlpha = _mm_set1_epi32 ((int) 0xff00ff00);
+        const auto redBlue    = _mm_set1_epi32 (0x00ff00ff);
+        const auto opaque     = _mm_set1_epi16 (0xff);
+        const auto rounding   = _mm_set1_epi16 (0x7f);
+        const auto alphaLanes = _mm_set_epi16 (-1, 0, 0, 0, -1, 0, 0, 0);
+
+        // works on two pixels that have been widened to 16 bits per channel
+        const auto premultiply = [&] (__m128i pixels)
+        {
+            const auto alpha = _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (pixels, _MM_SHUFFLE (3, 3, 3, 3)),
+                                                    _MM_SHUFFLE (3, 3, 3, 3));
+            const auto scaled = _mm_srli_epi16 (_mm_add_epi16 (_mm_mullo_epi16 (pixels, alpha), rounding), 8);
+            const auto keep = _mm_or_si128 (_mm_cmpeq_epi16 (alpha, opaque), alphaLanes);
+            return _mm_or_si128 (_mm_and_si128 (keep, pixels), _mm_andnot_si128 (keep, scaled));
+        };
+
+        for (; i + 4 <= numPixels; i += 4)
+        {
+            const auto rgba = _mm_loadu_si128 ((const __m128i*) (src + i * 4));
+            const auto rb = _mm_and_si128 (rgba, redBlue);
+            const auto bgra = _mm_or_si128 (_mm_and_si128 (rgba, greenAlpha),
+                                            _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (rb, _MM_SHUFFLE (2, 3, 0, 1)),
+                                                                 _MM_SHUFFLE (2, 3, 0, 1)));
+
+            if (_mm_movemask_epi8 (_mm_cmpeq_epi8 (_mm_or_si128 (bgra, colours), allOnes)) == 0xffff)
+            {
+                _mm_storeu_si128 ((__m128i*) (dest + i * 4), bgra);
+                continue;
+            }
+
+            const auto low  = premultiply (_mm_unpacklo_epi8 (bgra, zero));
+            const auto high = premultiply (_mm_unpackhi_epi8 (bgra, zero));
+            _mm_storeu_si128 ((__m128i*) (dest + i * 4), _mm_packus_epi16 (low, high));
+        }
+       #elif JUCE_IMAGE_ROW_CONVERSION_USE_NEON
+        const auto opaque = vdupq_n_u8 (0xff);
+        const auto rounding = vdupq_n_u16 (0x7f);
+
+        const auto scale = [&] (uint8x16_t c, uint8x16_t a)
+        {
+            const auto low  = vshrn_n_u16 (vaddq_u16 (vmull_u8 (vget_low_u8 (c),  vget_low_u8 (a)),  rounding), 8);
+            const auto high = vshrn_n_u16 (vaddq_u16 (vmull_u8 (vget_high_u8 (c), vget_high_u8 (a)), rounding), 8);
+            return vcombine_u8 (low, high);
+        };
+
+        for (; i + 16 <= numPixels; i += 16)
+        {
+            const auto rgba = vld4q_u8 (src + i * 4);
+            const auto isOpaque = vceqq_u8 (rgba.val[3], opaque);
+
+            uint8x16x4_t bgra;
+            bgra.val[0] = vbslq_u8 (isOpaque, rgba.val[2], scale (rgba.val[2], rgba.val[3]));
+            bgra.val[1] = vbslq_u8 (isOpaque, rgba.val[1], scale (rgba.val[1], rgba.val[3]));
+            bgra.val[2] = vbslq_u8 (isOpaque, rgba.val[0], scale (rgba.val[0], rgba.val[3]));
+            bgra.val[3] = rgba.val[3];
+            vst4q_u8 (dest + i * 4, bgra);
+        }
+       #endif
+
+        return i;
+    }
+
+    /** Converts 4-byte RGBA pixels into premultiplied PixelARGBs. */
+    static void rgbaToPremultipliedARGB (const uint8* src, uint8* dest, int numPixels, int destPixelStride) noexcept
+    {
+        int i = 0;
+
+        if constexpr (isBGRA)
+        {
+            if (destPixelStride == 4)
+            {
+                i = rgbaToPremultipliedBGRAGroups (src, dest, numPixels);
+                src += i * 4;
+                dest += i * 4;
+            }
+        }
+
+        for (; i < numPixels; ++i)
+        {
+            auto* pixel = reinterpret_cast<PixelARGB*> (dest);
+            pixel->setARGB (src[3], src[0], src[1], src[2]);
+            pixel->premultiply();
+            dest += destPixelStride;
+            src += 4;
+        }
+    }
+
+    /** Converts 3-byte RGB pixels into opaque PixelARGBs. */
+    static void rgbToARGB (const uint8* src, uint8* dest, int numPixels, int destPixelStride) noexcept
+    {
+        if constexpr (isBGRA)
+        {
+            if (destPixelStride == 4)
+            {
+                // writing whole words lets the compiler vectorise this loop
+                for (int i = 0; i < numPixels; ++i)
+                {
+                    writeUnaligned<uint32> (dest, 0xff000000u | ((uint32) src[0] << 16) | ((uint32) src[1] << 8) | src[2]);
+                    dest += 4;
+                    src += 3;
+                }
+
+                return;
+            }
+        }
+
+        for (int i = 0; i < numPixels; ++i)
+        {
+            reinterpret_cast<PixelARGB*> (dest)->setARGB (0xff, src[0], src[1], src[2]);
+            dest += destPixelStride;
+            src += 3;
+        }
+    }
+}
+
+} // namespace juce
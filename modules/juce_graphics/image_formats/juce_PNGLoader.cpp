@@ -422,13 +422,7 @@ namespace PNGHelpers
 
             if (hasAlphaChan)
             {
-                for (int i = (int) width; --i >= 0;)
-                {
-                    ((PixelARGB*) dest)->setARGB (src[3], src[0], src[1], src[2]);
-                    ((PixelARGB*) dest)->premultiply();
-                    dest += destData.pixelStride;
-                    src += 4;
-                }
+                ImageRowConversion::rgbaToPremultipliedARGB (src, dest, width, destData.pixelStride);
             }
             else
             {
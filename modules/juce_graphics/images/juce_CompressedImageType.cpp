@@ -0,0 +1,800 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/*  A lossless codec in the style of QOI ("the Quite OK Image format"), which codes
+    each pixel as a repeat of the previous one, a reference to a recently seen colour,
+    a small difference from the previous one, or the literal value. It's much quicker
+    than zlib at both ends, and compresses flat and smoothly shaded artwork well.
+
+    The pixels are treated as four channels, with the fourth being alpha, and the
+    second channel is the one that the others are predicted from, which is green in
+    every byte order that JUCE uses.
+*/
+namespace TileCodec
+{
+    enum : uint8
+    {
+        opIndex = 0x00,
+        opDiff  = 0x40,
+        opLuma  = 0x80,
+        opRun   = 0xc0,
+        opRGB   = 0xfe,
+        opRGBA  = 0xff,
+        opMask  = 0xc0
+    };
+
+    constexpr int maxRunLength = 62;
+    constexpr int maxBytesPerPixel = 5;
+
+    union Pixel
+    {
+        uint8 c[4];
+        uint32 value;
+    };
+
+    static int getIndexPosition (Pixel p) noexcept
+    {
+        return (p.c[0] * 3 + p.c[1] * 5 + p.c[2] * 7 + p.c[3] * 11) & 63;
+    }
+
+    template <int pixelStride>
+    static Pixel readPixel (const uint8* src) noexcept
+    {
+        Pixel p;
+
+        if constexpr (pixelStride == 4)
+        {
+            memcpy (p.c, src, 4);
+        }
+        else if constexpr (pixelStride == 3)
+        {
+            p.c[0] = src[0]; p.c[1] = src[1]; p.c[2] = src[2]; p.c[3] = 0xff;
+        }
+        else
+        {
+            // copying a single channel into all three colour channels means that small
+            // changes can use the short difference codes
+            p.c[0] = src[0]; p.c[1] = src[0]; p.c[2] = src[0]; p.c[3] = 0xff;
+        }
+
+        return p;
+    }
+
+    template <int pixelStride>
+    static void writePixel (uint8* dest, Pixel p) noexcept
+    {
+        if constexpr (pixelStride == 4)
+            memcpy (dest, p.c, 4);
+        else if constexpr (pixelStride == 3)
+            memcpy (dest, p.c, 3);
+        else
+            dest[0] = p.c[1];
+    }
+
+    template <int pixelStride>
+    static size_t encode (const uint8* src, int numPixels, uint8* const destStart) noexcept
+    {
+        Pixel index[64] = {};
+        Pixel previous;
+        previous.value = 0;
+        previous.c[3] = 0xff;
+
+        auto* dest = destStart;
+        int run = 0;
+
+        for (int i = 0; i < numPixels; ++i, src += pixelStride)
+        {
+            const auto p = readPixel<pixelStride> (src);
+
+            if (p.value == previous.value)
+            {
+                if (++run == maxRunLength || i == numPixels - 1)
+                {
+                    *dest++ = (uint8) (opRun | (run - 1));
+                    run = 0;
+                }
+
+                continue;
+            }
+
+            if (run > 0)
+            {
+                *dest++ = (uint8) (opRun | (run - 1));
+                run = 0;
+            }
+
+            auto& indexed = index[getIndexPosition (p)];
+
+            if (indexed.value == p.value)
+            {
+                *dest++ = (uint8) (opIndex | getIndexPosition (p));
+            }
+            else
+            {
+                indexed = p;
+
+                if (p.c[3] == previous.c[3])
+                {
+                    const auto d0 = (int8) (p.c[0] - previous.c[0]);
+                    const auto d1 = (int8) (p.c[1] - previous.c[1]);
+                    const auto d2 = (int8) (p.c[2] - previous.c[2]);
+                    const auto d0d1 = d0 - d1;
+                    const auto d2d1 = d2 - d1;
+
+                    if (d0 >= -2 && d0 <= 1 && d1 >= -2 && d1 <= 1 && d2 >= -2 && d2 <= 1)
+                    {
+                        *dest++ = (uint8) (opDiff | ((d0 + 2) << 4) | ((d1 + 2) << 2) | (d2 + 2));
+                    }
+                    else if (d1 >= -32 && d1 <= 31 && d0d1 >= -8 && d0d1 <= 7 && d2d1 >= -8 && d2d1 <= 7)
+                    {
+                        *dest++ = (uint8) (opLuma | (d1 + 32));
+                        *dest++ = (uint8) (((d0d1 + 8) << 4) | (d2d1 + 8));
+                    }
+                    else
+                    {
+                        *dest++ = opRGB;
+                        *dest++ = p.c[0];
+                        *dest++ = p.c[1];
+                        *dest++ = p.c[2];
+                    }
+                }
+                else
+                {
+                    *dest++ = opRGBA;
+                    *dest++ = p.c[0];
+                    *dest++ = p.c[1];
+                    *dest++ = p.c[2];
+                    *dest++ = p.c[3];
+                }
+            }
+
+            previous = p;
+        }
+
+        return (size_t) (dest - destStart);
+    }
+
+    template <int pixelStride>
+    static void decode (const uint8* src, size_t numBytes, uint8* dest, int numPixels) noexcept
+    {
+        Pixel index[64] = {};
+        Pixel p;
+        p.value = 0;
+        p.c[3] = 0xff;
+
+        const auto* const end = src + numBytes;
+        int run = 0;
+
+        for (int i = 0; i < numPixels; ++i, dest += pixelStride)
+        {
+            if (run > 0)
+            {
+                --run;
+            }
+            else if (src < end)
+            {
+                const auto op = *src++;
+
+                if (op == opRGB)
+                {
+                    p.c[0] = src[0]; p.c[1] = src[1]; p.c[2] = src[2];
+                    src += 3;
+                }
+                else if (op == opRGBA)
+                {
+                    memcpy (p.c, src, 4);
+                    src += 4;
+                }
+                else
+                {
+                    switch (op & opMask)
+                    {
+                        case opIndex:
+                            p = index[op];
+                            break;
+
+                        case opDiff:
+                            p.c[0] = (uint8) (p.c[0] + ((op >> 4) & 3) - 2);
+                            p.c[1] = (uint8) (p.c[1] + ((op >> 2) & 3) - 2);
+                            p.c[2] = (uint8) (p.c[2] + (op & 3) - 2);
+                            break;
+
+                        case opLuma:
+                        {
+                            const auto d1 = (op & 0x3f) - 32;
+                            const auto next = *src++;
+                            p.c[0] = (uint8) (p.c[0] + d1 - 8 + (next >> 4));
+                            p.c[1] = (uint8) (p.c[1] + d1);
+                            p.c[2] = (uint8) (p.c[2] + d1 - 8 + (next & 15));
+                            break;
+                        }
+
+                        default:
+                            run = op & 0x3f;
+                            break;
+                    }
+                }
+
+                index[getIndexPosition (p)] = p;
+            }
+
+            writePixel<pixelStride> (dest, p);
+        }
+    }
+
+    static MemoryBlock encode (const uint8* src, int numPixels, int pixelStride)
+    {
+        HeapBlock<uint8> buffer ((size_t) numPixels * maxBytesPerPixel);
+
+        const auto size = pixelStride == 4 ? encode<4> (src, numPixels, buffer)
+                        : pixelStride == 3 ? encode<3> (src, numPixels, buffer)
+                                           : encode<1> (src, numPixels, buffer);
+
+        return { buffer, size };
+    }
+
+    static void decode (const MemoryBlock& block, uint8* dest, int numPixels, int pixelStride) noexcept
+    {
+        const auto* src = static_cast<const uint8*> (block.getData());
+
+        if (pixelStride == 4)       decode<4> (src, block.getSize(), dest, numPixels);
+        else if (pixelStride == 3)  decode<3> (src, block.getSize(), dest, numPixels);
+        else                        decode<1> (src, block.getSize(), dest, numPixels);
+    }
+}
+
+//==============================================================================
+class CompressedPixelData final : public ImagePixelData
+{
+public:
+    CompressedPixelData (Image::PixelFormat formatToUse, int w, int h, const CompressedImageOptions& optionsToUse)
+        : ImagePixelData (formatToUse, w, h),
+          options (optionsToUse),
+          pixelStride (formatToUse == Image::RGB ? 3 : ((formatToUse == Image::ARGB) ? 4 : 1)),
+          lineStride (pixelStride * jmax (1, w)),
+          tileHeight (jmin (options.getTileHeight(), jmax (1, h))),
+          tiles ((size_t) ((jmax (1, h) + tileHeight - 1) / tileHeight))
+    {
+    }
+
+    /*  Fills the tiles from some rows of pixels with the same layout as ours, or clears
+        them if the source is null.
+    */
+    void setTiles (const uint8* sourceRows, int sourceLineStride)
+    {
+        HeapBlock<uint8> blank;
+
+        if (sourceRows == nullptr)
+            blank.calloc ((size_t) lineStride * (size_t) tileHeight);
+
+        for (int i = 0; i < (int) tiles.size(); ++i)
+        {
+            if (sourceRows == nullptr)
+            {
+                // every full-height blank tile is the same, so only needs compressing once
+                tiles[(size_t) i] = (i > 0 && getTileRows (i) == tileHeight) ? tiles[0]
+                                                                             : TileCodec::encode (blank, width * getTileRows (i), pixelStride);
+            }
+            else if (sourceLineStride == lineStride)
+            {
+                tiles[(size_t) i] = TileCodec::encode (sourceRows + (size_t) (i * tileHeight) * (size_t) lineStride,
+                                                       width * getTileRows (i), pixelStride);
+            }
+            else
+            {
+                HeapBlock<uint8> rows ((size_t) lineStride * (size_t) getTileRows (i));
+
+                for (int y = 0; y < getTileRows (i); ++y)
+                    memcpy (rows + y * lineStride, sourceRows + (i * tileHeight + y) * sourceLineStride, (size_t) lineStride);
+
+                tiles[(size_t) i] = TileCodec::encode (rows, width * getTileRows (i), pixelStride);
+            }
+        }
+    }
+
+    std::unique_ptr<LowLevelGraphicsContext> createLowLevelContext() override
+    {
+        sendDataChangeMessage();
+        return std::make_unique<LowLevelGraphicsSoftwareRenderer> (Image (*this));
+    }
+
+    void initialiseBitmapData (Image::BitmapData& bitmap, int x, int y, Image::BitmapData::ReadWriteMode mode) override
+    {
+        const auto firstTile = y / tileHeight;
+        const auto lastTile = (y + jmax (1, bitmap.height) - 1) / tileHeight;
+        const auto xOffset = (size_t) x * (size_t) pixelStride;
+
+        bitmap.pixelFormat = pixelFormat;
+        bitmap.lineStride = lineStride;
+        bitmap.pixelStride = pixelStride;
+
+        if (mode == Image::BitmapData::readOnly && firstTile == lastTile)
+        {
+            // The usual case when drawing: point straight into a decoded tile
+            auto tile = getDecodedTile (firstTile);
+            const auto offset = (size_t) (y - firstTile * tileHeight) * (size_t) lineStride + xOffset;
+
+            bitmap.data = tile->pixels + offset;
+            bitmap.size = (size_t) getTileRows (firstTile) * (size_t) lineStride - offset;
+            bitmap.dataReleaser = std::make_unique<TileReleaser> (std::move (tile));
+            return;
+        }
+
+        auto region = std::make_unique<RegionReleaser> (*this, firstTile, lastTile, mode);
+        const auto offset = (size_t) (y - firstTile * tileHeight) * (size_t) lineStride + xOffset;
+
+        bitmap.data = region->pixels + offset;
+        bitmap.size = region->size - offset;
+        bitmap.dataReleaser = std::move (region);
+
+        if (mode != Image::BitmapData::readOnly)
+            sendDataChangeMessage();
+    }
+
+    Ptr clone() override
+    {
+        auto s = new CompressedPixelData (pixelFormat, width, height, options);
+
+        const ScopedLock sl (lock);
+        s->tiles = tiles;
+        return *s;
+    }
+
+    std::unique_ptr<ImageType> createType() const override    { return std::make_unique<CompressedImageType> (options); }
+
+    size_t getMemoryUsage() const
+    {
+        const ScopedLock sl (lock);
+        auto total = sizeof (*this) + cacheSize;
+
+        for (auto& t : tiles)
+            total += t.getSize();
+
+        return total;
+    }
+
+private:
+    //==============================================================================
+    struct DecodedTile final : public ReferenceCountedObject
+    {
+        using Ptr = ReferenceCountedObjectPtr<DecodedTile>;
+
+        DecodedTile (int tileIndex, size_t numBytes)  : index (tileIndex), size (numBytes), pixels (numBytes)  {}
+
+        const int index;
+        const size_t size;
+        HeapBlock<uint8> pixels;
+    };
+
+    // Keeps a tile alive while a BitmapData is reading from it, even if the cache drops it
+    struct TileReleaser final : public Image::BitmapData::BitmapDataReleaser
+    {
+        explicit TileReleaser (DecodedTile::Ptr t)  : tile (std::move (t)) {}
+
+        DecodedTile::Ptr tile;
+    };
+
+    // Assembles a run of tiles into one block of rows, and compresses them again
+    // afterwards if they may have been changed
+    struct RegionReleaser final : public Image::BitmapData::BitmapDataReleaser
+    {
+        RegionReleaser (CompressedPixelData& o, int first, int last, Image::BitmapData::ReadWriteMode m)
+            : owner (o), firstTile (first), lastTile (last), mode (m),
+              size ((size_t) (last * o.tileHeight + o.getTileRows (last) - first * o.tileHeight) * (size_t) o.lineStride),
+              pixels (size)
+        {
+            // Even when writing, the tiles are needed for the rows and columns that
+            // aren't being written to
+            for (int i = firstTile; i <= lastTile; ++i)
+            {
+                auto tile = owner.getDecodedTile (i);
+                memcpy (pixels + (size_t) ((i - firstTile) * owner.tileHeight) * (size_t) owner.lineStride, tile->pixels, tile->size);
+            }
+        }
+
+        ~RegionReleaser() override
+        {
+            if (mode == Image::BitmapData::readOnly)
+                return;
+
+            for (int i = firstTile; i <= lastTile; ++i)
+            {
+                const auto* rows = pixels + (size_t) ((i - firstTile) * owner.tileHeight) * (size_t) owner.lineStride;
+                owner.replaceTile (i, TileCodec::encode (rows, owner.width * owner.getTileRows (i), owner.pixelStride));
+            }
+        }
+
+        CompressedPixelData& owner;
+        const int firstTile, lastTile;
+        const Image::BitmapData::ReadWriteMode mode;
+        const size_t size;
+        HeapBlock<uint8> pixels;
+    };
+
+    //==============================================================================
+    int getTileRows (int tileIndex) const noexcept
+    {
+        return jmin (tileHeight, jmax (1, height) - tileIndex * tileHeight);
+    }
+
+    DecodedTile::Ptr getDecodedTile (int tileIndex)
+    {
+        {
+            const ScopedLock sl (lock);
+
+            for (int i = cache.size(); --i >= 0;)
+            {
+                if (cache.getUnchecked (i)->index == tileIndex)
+                {
+                    cache.move (i, -1); // the end of the list holds the most recently used tiles
+                    return cache.getLast();
+                }
+            }
+        }
+
+        DecodedTile::Ptr tile (new DecodedTile (tileIndex, (size_t) getTileRows (tileIndex) * (size_t) lineStride));
+        MemoryBlock compressed;
+
+        {
+            const ScopedLock sl (lock);
+            compressed = tiles[(size_t) tileIndex];
+        }
+
+        TileCodec::decode (compressed, tile->pixels, width * getTileRows (tileIndex), pixelStride);
+
+        const ScopedLock sl (lock);
+
+        // another thread may have decoded the same tile in the meantime
+        for (auto* cached : cache)
+            if (cached->index == tileIndex)
+                return cached;
+
+        if (tile->size <= options.getMaxCacheSize())
+        {
+            cache.add (tile);
+            cacheSize += tile->size;
+
+            while (cacheSize > options.getMaxCacheSize())
+            {
+                cacheSize -= cache.getFirst()->size;
+                cache.remove (0);
+            }
+        }
+
+        return tile;
+    }
+
+    void replaceTile (int tileIndex, MemoryBlock&& compressed)
+    {
+        const ScopedLock sl (lock);
+        tiles[(size_t) tileIndex] = std::move (compressed);
+
+        for (int i = cache.size(); --i >= 0;)
+        {
+            if (cache.getUnchecked (i)->index == tileIndex)
+            {
+                cacheSize -= cache.getUnchecked (i)->size;
+                cache.remove (i);
+            }
+        }
+    }
+
+    //==============================================================================
+    const CompressedImageOptions options;
+    const int pixelStride, lineStride, tileHeight;
+
+    std::vector<MemoryBlock> tiles;
+    ReferenceCountedArray<DecodedTile> cache;
+    size_t cacheSize = 0;
+    CriticalSection lock;
+
+    JUCE_LEAK_DETECTOR (CompressedPixelData)
+};
+
+//==============================================================================
+CompressedImageType::CompressedImageType (const Options& optionsToUse)  : options (optionsToUse) {}
+CompressedImageType::~CompressedImageType() = default;
+
+ImagePixelData::Ptr CompressedImageType::create (Image::PixelFormat format, int width, int height, bool) const
+{
+    // The tiles are always cleared, as there's no way to leave them uninitialised
+    auto* data = new CompressedPixelData (format, width, height, options);
+    data->setTiles (nullptr, 0);
+    return *data;
+}
+
+int CompressedImageType::getTypeID() const
+{
+    return ByteOrder::makeInt ('c', 'm', 'p', 'r');
+}
+
+Image CompressedImageType::convert (const Image& source) const
+{
+    if (source.isNull() || getTypeID() == source.getPixelData()->createType()->getTypeID())
+        return source;
+
+    const Image::BitmapData src (source, Image::BitmapData::readOnly);
+
+    if (src.data == nullptr)
+        return {};
+
+    auto* data = new CompressedPixelData (src.pixelFormat, src.width, src.height, options);
+    Image result (*data);
+
+    // Compress the source's rows directly when they're laid out in the same way as ours
+    if (src.pixelStride == (src.pixelFormat == Image::RGB ? 3 : (src.pixelFormat == Image::ARGB ? 4 : 1)))
+    {
+        data->setTiles (src.data, src.lineStride);
+        return result;
+    }
+
+    Image::BitmapData (result, Image::BitmapData::writeOnly).convertFrom (src);
+    return result;
+}
+
+size_t CompressedImageType::getMemoryUsage (const Image& image)
+{
+    if (auto* data = dynamic_cast<CompressedPixelData*> (image.getPixelData().get()))
+        return data->getMemoryUsage();
+
+    return 0;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class CompressedImageTypeTests final : public UnitTest
+{
+public:
+    CompressedImageTypeTests()  : UnitTest ("CompressedImageType", UnitTestCategories::graphics)  {}
+
+    void runTest() override
+    {
+        auto rng = getRandom();
+
+        beginTest ("Round trip");
+        {
+            for (auto format : { Image::ARGB, Image::RGB, Image::SingleChannel })
+            {
+                const auto source = createTestImage (rng, format, 1 + rng.nextInt (100), 1 + rng.nextInt (100));
+
+                for (auto tileHeight : { 1, 7, 32, 1000 })
+                {
+                    const auto compressed = CompressedImageType (CompressedImageType::Options{}.withTileHeight (tileHeight)).convert (source);
+
+                    expect (compressed.getFormat() == format);
+                    expect (compressed.getPixelData()->createType()->getTypeID() == CompressedImageType().getTypeID());
+                    expect (imagesAreEqual (compressed, source));
+                    expect (CompressedImageType::getMemoryUsage (compressed) > 0);
+                }
+            }
+
+            expectEquals ((int) CompressedImageType::getMemoryUsage (Image (Image::ARGB, 10, 10, true)), 0);
+        }
+
+        beginTest ("Drawing from a film-strip");
+        {
+            const auto strip = createTestImage (rng, Image::ARGB, 40, 30 * 20);
+
+            for (auto tileHeight : { 30, 13 })
+            {
+                for (auto cacheSize : { (size_t) 0, (size_t) 10000, (size_t) 1000000 })
+                {
+                    const auto compressed = CompressedImageType (CompressedImageType::Options{}.withTileHeight (tileHeight)
+                                                                                               .withMaxCacheSize (cacheSize)).convert (strip);
+                    const auto initialMemoryUsage = CompressedImageType::getMemoryUsage (compressed);
+
+                    for (int frame = 0; frame < 40; ++frame)
+                    {
+                        const auto area = Rectangle<int> (0, (frame % 20) * 30, 40, 30);
+                        expect (imagesAreEqual (drawFrame (compressed, area), drawFrame (strip, area)));
+                    }
+
+                    expect (CompressedImageType::getMemoryUsage (compressed) <= initialMemoryUsage + cacheSize);
+                }
+            }
+        }
+
+        beginTest ("Drawing into an image");
+        {
+            for (auto format : { Image::ARGB, Image::RGB, Image::SingleChannel })
+            {
+                Image software (format, 70, 50, true, SoftwareImageType());
+                Image compressed (format, 70, 50, true, CompressedImageType (CompressedImageType::Options{}.withTileHeight (8)));
+                expect (imagesAreEqual (compressed, software));
+
+                for (auto* image : { &software, &compressed })
+                {
+                    Graphics g (*image);
+                    g.setColour (Colours::red.withAlpha (0.7f));
+                    g.fillEllipse (5.0f, 3.0f, 50.0f, 40.0f);
+                    g.setColour (Colours::blue);
+                    g.drawLine (0.0f, 49.0f, 69.0f, 0.0f, 3.0f);
+
+                    image->setPixelAt (69, 49, Colours::green);
+                    image->multiplyAllAlphas (0.5f);
+                }
+
+                expect (imagesAreEqual (compressed, software));
+
+                auto copy = compressed.createCopy();
+                copy.clear ({ 10, 10, 20, 20 }, Colours::white);
+                expect (imagesAreEqual (compressed, software));
+                expect (! imagesAreEqual (copy, software));
+            }
+        }
+    }
+
+    static Image createTestImage (Random& rng, Image::PixelFormat format, int width, int height)
+    {
+        // a mixture of flat areas, gradients and noise, to exercise all the codes
+        Image image (format, width, height, true, SoftwareImageType());
+        Image::BitmapData data (image, Image::BitmapData::writeOnly);
+
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                const auto band = (y / 5) % 4;
+                const auto colour = band == 0 ? Colours::transparentBlack
+                                  : band == 1 ? Colour ((uint8) x, (uint8) y, (uint8) (x + y), (uint8) 255)
+                                  : band == 2 ? Colour ((uint32) rng.nextInt())
+                                              : Colour ((uint8) (x * 2), (uint8) (x * 3), (uint8) 40, (uint8) (x * 4));
+                data.setPixelColour (x, y, colour);
+            }
+        }
+
+        return image;
+    }
+
+    static Image drawFrame (const Image& strip, Rectangle<int> area)
+    {
+        Image result (Image::ARGB, area.getWidth(), area.getHeight(), true, SoftwareImageType());
+        Graphics g (result);
+        g.fillAll (Colours::white);
+        g.drawImage (strip, 0, 0, area.getWidth(), area.getHeight(), area.getX(), area.getY(), area.getWidth(), area.getHeight());
+        return result;
+    }
+
+    static bool imagesAreEqual (const Image& a, const Image& b)
+    {
+        if (a.getBounds() != b.getBounds() || a.getFormat() != b.getFormat())
+            return false;
+
+        const Image::BitmapData dataA (a, Image::BitmapData::readOnly);
+        const Image::BitmapData dataB (b, Image::BitmapData::readOnly);
+
+        for (int y = 0; y < a.getHeight(); ++y)
+            if (memcmp (dataA.getLinePointer (y), dataB.getLinePointer (y), (size_t) (a.getWidth() * dataA.pixelStride)) != 0)
+                return false;
+
+        return true;
+    }
+};
+
+static CompressedImageTypeTests compressedImageTypeTests;
+
+//==============================================================================
+class CompressedImageTypeBenchmarks final : public UnitTest
+{
+public:
+    CompressedImageTypeBenchmarks()  : UnitTest ("CompressedImageType benchmarks", UnitTestCategories::benchmarks)  {}
+
+    void runTest() override
+    {
+        beginTest ("Film-strip animation");
+
+        constexpr int frameSize = 128, numFrames = 128;
+        const auto strip = createFilmStrip (frameSize, numFrames);
+
+        logMessage ("Film-strip of " + String (numFrames) + " frames of " + String (frameSize) + "x" + String (frameSize) + " pixels");
+        logMessage ("Memory use, then the time to draw a frame when sweeping through them all, and when redrawing the same few:");
+        logMessage ("SoftwareImageType: " + measure (strip, frameSize, numFrames));
+
+        for (auto tileHeight : { 16, frameSize })
+        {
+            for (auto cacheSize : { (size_t) 0, (size_t) 64 * 1024, (size_t) 512 * 1024 })
+            {
+                const auto options = CompressedImageType::Options{}.withTileHeight (tileHeight).withMaxCacheSize (cacheSize);
+
+                logMessage ("CompressedImageType, tile height " + String (tileHeight) + ", cache " + String (cacheSize / 1024) + "KB: "
+                              + measure (CompressedImageType (options).convert (strip), frameSize, numFrames));
+            }
+        }
+    }
+
+private:
+    static Image createFilmStrip (int frameSize, int numFrames)
+    {
+        Image strip (Image::ARGB, frameSize, frameSize * numFrames, true, SoftwareImageType());
+        Graphics g (strip);
+
+        for (int i = 0; i < numFrames; ++i)
+        {
+            const auto area = Rectangle<int> (0, i * frameSize, frameSize, frameSize).toFloat().reduced (4.0f);
+            const auto angle = MathConstants<float>::twoPi * 0.8f * ((float) i / (float) numFrames - 0.5f);
+
+            g.setGradientFill (ColourGradient (Colour (0xff505a64), area.getTopLeft(), Colour (0xff1e2328), area.getBottomRight(), false));
+            g.fillEllipse (area);
+            g.setColour (Colour (0xff8cc8ff));
+            g.drawEllipse (area.reduced (3.0f), 2.0f);
+
+            Path pointer;
+            pointer.addRoundedRectangle (-3.0f, -area.getHeight() * 0.45f, 6.0f, area.getHeight() * 0.3f, 3.0f);
+            g.fillPath (pointer, AffineTransform::rotation (angle).translated (area.getCentre()));
+        }
+
+        return strip;
+    }
+
+    static String measure (const Image& strip, int frameSize, int numFrames)
+    {
+        Image dest (Image::ARGB, frameSize, frameSize, true, SoftwareImageType());
+        Graphics g (dest);
+
+        constexpr int numFramesToDraw = 1024;
+
+        const auto timeFrames = [&] (auto&& getFrame)
+        {
+            const auto start = Time::getMillisecondCounterHiRes();
+
+            for (int i = 0; i < numFramesToDraw; ++i)
+                g.drawImage (strip, 0, 0, frameSize, frameSize, 0, getFrame (i) * frameSize, frameSize, frameSize);
+
+            return String ((Time::getMillisecondCounterHiRes() - start) * 1000.0 / numFramesToDraw, 1) + " us";
+        };
+
+        // sweeping up and down, as a knob being dragged would
+        const auto sweeping = timeFrames ([&] (int i) { return (i / numFrames) % 2 == 0 ? i % numFrames : numFrames - 1 - i % numFrames; });
+
+        // wobbling between neighbouring frames, or repainting while the knob is still
+        const auto redrawing = timeFrames ([&] (int i) { return numFrames / 2 + (i / 16) % 3; });
+        const auto memory = strip.getPixelData()->createType()->getTypeID() == SoftwareImageType().getTypeID()
+                          ? (size_t) Image::BitmapData (strip, Image::BitmapData::readOnly).lineStride * (size_t) strip.getHeight()
+                          : CompressedImageType::getMemoryUsage (strip);
+
+        return String ((double) memory / 1024.0, 1) + " KB, " + sweeping + ", " + redrawing;
+    }
+};
+
+static CompressedImageTypeBenchmarks compressedImageTypeBenchmarks;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Settings for a CompressedImageType.
+
+    @see CompressedImageType
+
+    @tags{Graphics}
+*/
+class JUCE_API  CompressedImageOptions
+{
+public:
+    /** Sets the number of rows of pixels in each of the tiles that the image is
+        compressed in.
+
+        Drawing part of the image decodes all the tiles that it overlaps, so smaller
+        tiles mean that less is decoded, but they compress slightly less well. For a
+        film-strip whose frames are stacked vertically, using the height of a frame
+        means that each frame is a tile of its own, and drawing a frame never decodes
+        any more than that.
+    */
+    [[nodiscard]] CompressedImageOptions withTileHeight (int x) const           { return withMember (*this, &CompressedImageOptions::tileHeight, jmax (1, x)); }
+
+    /** Sets the number of bytes of decoded tiles that each image may keep so that they
+        needn't be decoded again the next time they're drawn.
+
+        The most recently used tiles are kept. A bigger cache uses more memory but less
+        CPU when the same parts of an image are drawn repeatedly; with a cache of 0,
+        every tile is decoded each time it's used.
+    */
+    [[nodiscard]] CompressedImageOptions withMaxCacheSize (size_t x) const      { return withMember (*this, &CompressedImageOptions::maxCacheSize, x); }
+
+    int getTileHeight() const noexcept                                          { return tileHeight; }
+    size_t getMaxCacheSize() const noexcept                                     { return maxCacheSize; }
+
+private:
+    int tileHeight = 32;
+    size_t maxCacheSize = 512 * 1024;
+};
+
+//==============================================================================
+/**
+    An image storage type which keeps the pixels compressed in memory.
+
+    The image is split into horizontal tiles, which are compressed with a fast,
+    lossless codec and decoded when they're needed. The most recently used tiles are
+    kept decoded in a small cache, so that an image which is drawn repeatedly, such as
+    the current frame of a film-strip, costs no more to draw than a software image.
+
+    Typical UI artwork shrinks to a quarter of its size or less, which makes this a
+    good fit for large, rarely changing images like film-strips and backgrounds.
+    Drawing into one of these images is slow, because the affected tiles have to be
+    decoded and compressed again, so it's best to draw a software image and then
+    convert it:
+
+    @code
+    auto strip = CompressedImageType (CompressedImageType::Options{}.withTileHeight (frameHeight))
+                     .convert (ImageCache::getFromMemory (BinaryData::knob_png, BinaryData::knob_pngSize));
+    @endcode
+
+    @see ImageType, SoftwareImageType, ImageCache::setImageType
+
+    @tags{Graphics}
+*/
+class JUCE_API  CompressedImageType   : public ImageType
+{
+public:
+    //==============================================================================
+    using Options = CompressedImageOptions;
+
+    /** Creates a type that makes images with the given settings. */
+    explicit CompressedImageType (const Options& options = {});
+    ~CompressedImageType() override;
+
+    /** Returns the settings that this type uses. */
+    const Options& getOptions() const noexcept      { return options; }
+
+    /** Returns the number of bytes that an image of this type is currently using,
+        including its cache of decoded tiles, or 0 if it's some other type of image.
+    */
+    static size_t getMemoryUsage (const Image& image);
+
+    //==============================================================================
+    ImagePixelData::Ptr create (Image::PixelFormat, int width, int height, bool clearImage) const override;
+    int getTypeID() const override;
+    Image convert (const Image& source) const override;
+
+private:
+    Options options;
+};
+
+} // namespace juce
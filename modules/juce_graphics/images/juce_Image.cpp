@@ -202,38 +202,292 @@ namespace BitmapDataDetail
         return result;
     }
 
-    static void blurDataTriplets (uint8* d, int num, const int delta) noexcept
+    //==============================================================================
+    // Large blurs are split into bands of rows or columns, which are shared between the
+    // threads of this pool. The calling thread works through the bands too, so it'll
+    // finish the whole job itself if the pool is busy.
+    class BlurThreadPool  : private DeletedAtShutdown
     {
-        uint32 last = d[0];
-        d[0] = (uint8) ((d[0] + d[delta] + 1) / 3);
-        d += delta;
+    public:
+        BlurThreadPool() = default;
+        ~BlurThreadPool() override  { clearSingletonInstance(); }
+
+        template <typename Fn>
+        static void forEachBand (int numItems, int64 workPerItem, Fn&& fn)
+        {
+            constexpr int64 minWorkPerBand = 1 << 17;
+            const auto numCpus = SystemStats::getNumCpus();
+            const auto numBands = (int) jmin ((int64) jmin (numItems, numCpus * 4),
+                                              (numItems * workPerItem) / minWorkPerBand);
+
+            if (numCpus <= 1 || numBands <= 1)
+            {
+                fn (Range<int> (0, numItems));
+                return;
+            }
+
+            auto batch = std::make_shared<Batch>();
+            batch->fn = std::forward<Fn> (fn);
+            batch->numItems = numItems;
+            batch->numBands = numBands;
+            batch->numRemaining = numBands;
+
+            auto& pool = getInstance()->pool;
+
+            for (auto i = jmin (numBands - 1, pool.getNumThreads()); --i >= 0;)
+                pool.addJob ([batch] { batch->run(); });
+
+            batch->run();
+            batch->finished.wait();
+        }
 
-        num -= 2;
+        JUCE_DECLARE_SINGLETON_INLINE (BlurThreadPool, false)
 
-        do
+    private:
+        struct Batch
         {
-            const uint32 newLast = d[0];
-            d[0] = (uint8) ((last + d[0] + d[delta] + 1) / 3);
-            d += delta;
-            last = newLast;
+            void run()
+            {
+                for (;;)
+                {
+                    const auto band = nextBand++;
+
+                    if (band >= numBands)
+                        return;
+
+                    fn ({ (int) ((int64) numItems * band / numBands),
+                          (int) ((int64) numItems * (band + 1) / numBands) });
+
+                    if (--numRemaining == 0)
+                        finished.signal();
+                }
+            }
+
+            std::function<void (Range<int>)> fn;
+            int numItems = 0, numBands = 0;
+            std::atomic<int> nextBand { 0 }, numRemaining { 0 };
+            WaitableEvent finished;
+        };
+
+        ThreadPool pool { ThreadPoolOptions{}.withThreadName ("Image blur")
+                                             .withNumberOfThreads (jmax (1, SystemStats::getNumCpus() - 1)) };
+
+        JUCE_DECLARE_NON_COPYABLE (BlurThreadPool)
+    };
+
+    //==============================================================================
+    // Calls laneOp with the index of each group of SIMDFloat4::size items between start and
+    // end, and then itemOp with the index of each item that's left over.
+    template <typename LaneOp, typename ItemOp>
+    static void forEachLaneGroup (int start, int end, LaneOp&& laneOp, ItemOp&& itemOp)
+    {
+        constexpr auto numLanes = detail::SIMDFloat4::size;
+        auto i = start;
+
+        for (; i + numLanes <= end; i += numLanes)
+            laneOp (i);
+
+        for (; i < end; ++i)
+            itemOp (i);
+    }
+
+    // The single-channel blur runs a three-pixel blur along every row and then every column,
+    // 'repetitions' times, with the pixels beyond the ends of a line counting as zero. Each
+    // pass rounds to whole levels, which the float sums here reproduce exactly.
+    //
+    // The lines are blurred SIMDFloat4::size at a time, interleaved so that pixel i of line j
+    // is at lines[i * size + j], and all the repetitions are done before they're written back.
+    static void blurInterleavedLines (float* lines, int length, int repetitions)
+    {
+        using detail::SIMDFloat4;
+        constexpr auto numLanes = SIMDFloat4::size;
+
+        // (sum + 1) * third rounds down to the same whole number as (sum + 1) / 3 does,
+        // for every sum of three levels
+        constexpr auto third = 1.0f / 3.0f;
+        const auto zero = SIMDFloat4::expand (0.0f);
+
+        for (int rep = 0; rep < repetitions; ++rep)
+        {
+            auto previous = zero;
+            auto current = SIMDFloat4::load (lines);
+
+            for (int i = 0; i < length - 1; ++i)
+            {
+                const auto next = SIMDFloat4::load (lines + (i + 1) * numLanes);
+                truncate ((previous + current + next + 1.0f) * third).store (lines + i * numLanes);
+                previous = current;
+                current = next;
+            }
+
+            truncate ((previous + current + 1.0f) * third).store (lines + (length - 1) * numLanes);
         }
-        while (--num > 0);
+    }
 
-        d[0] = (uint8) ((last + d[0] + 1) / 3);
+    static void blurRows (uint8* data, int w, int h, int lineStride, int repetitions)
+    {
+        constexpr auto numLanes = detail::SIMDFloat4::size;
+
+        BlurThreadPool::forEachBand ((h + numLanes - 1) / numLanes, (int64) w * numLanes * repetitions, [=] (Range<int> groups)
+        {
+            std::vector<float> lines ((size_t) (w * numLanes));
+
+            for (auto group = groups.getStart(); group < groups.getEnd(); ++group)
+            {
+                const auto firstRow = group * numLanes;
+                const auto numRows = jmin (numLanes, h - firstRow);
+
+                std::fill (lines.begin(), lines.end(), 0.0f);
+
+                for (int j = 0; j < numRows; ++j)
+                    for (int x = 0; x < w; ++x)
+                        lines[(size_t) (x * numLanes + j)] = data[(firstRow + j) * lineStride + x];
+
+                blurInterleavedLines (lines.data(), w, repetitions);
+
+                for (int j = 0; j < numRows; ++j)
+                    for (int x = 0; x < w; ++x)
+                        data[(firstRow + j) * lineStride + x] = (uint8) lines[(size_t) (x * numLanes + j)];
+            }
+        });
+    }
+
+    static void blurColumns (uint8* data, int w, int h, int lineStride, int repetitions)
+    {
+        using detail::SIMDFloat4;
+        constexpr auto numLanes = SIMDFloat4::size;
+
+        BlurThreadPool::forEachBand ((w + numLanes - 1) / numLanes, (int64) h * numLanes * repetitions, [=] (Range<int> groups)
+        {
+            std::vector<float> lines ((size_t) (h * numLanes));
+
+            for (auto group = groups.getStart(); group < groups.getEnd(); ++group)
+            {
+                const auto firstColumn = group * numLanes;
+                const auto numColumns = jmin (numLanes, w - firstColumn);
+
+                if (numColumns == numLanes)
+                {
+                    for (int y = 0; y < h; ++y)
+                        SIMDFloat4::loadBytes (data + y * lineStride + firstColumn).store (lines.data() + y * numLanes);
+
+                    blurInterleavedLines (lines.data(), h, repetitions);
+
+                    for (int y = 0; y < h; ++y)
+                        SIMDFloat4::load (lines.data() + y * numLanes).storeAsBytes (data + y * lineStride + firstColumn);
+                }
+                else
+                {
+                    std::fill (lines.begin(), lines.end(), 0.0f);
+
+                    for (int y = 0; y < h; ++y)
+                        for (int j = 0; j < numColumns; ++j)
+                            lines[(size_t) (y * numLanes + j)] = data[y * lineStride + firstColumn + j];
+
+                    blurInterleavedLines (lines.data(), h, repetitions);
+
+                    for (int y = 0; y < h; ++y)
+                        for (int j = 0; j < numColumns; ++j)
+                            data[y * lineStride + firstColumn + j] = (uint8) lines[(size_t) (y * numLanes + j)];
+                }
+            }
+        });
     }
 
     static void blurSingleChannelImage (uint8* const data, const int w, const int h,
-                                        const int lineStride, const int repetitions) noexcept
+                                        const int lineStride, const int repetitions)
     {
         jassert (w > 2 && h > 2);
 
-        for (int y = 0; y < h; ++y)
-            for (int i = repetitions; --i >= 0;)
-                blurDataTriplets (data + lineStride * y, w, 1);
+        if (repetitions <= 0)
+            return;
 
-        for (int x = 0; x < w; ++x)
-            for (int i = repetitions; --i >= 0;)
-                blurDataTriplets (data + x, h, lineStride);
+        blurRows (data, w, h, lineStride, repetitions);
+        blurColumns (data, w, h, lineStride, repetitions);
+    }
+
+    //==============================================================================
+    // Produces the same result as ImageConvolutionKernel::createGaussianBlur() followed by
+    // applyToImage(), but as a horizontal and then a vertical pass, which is size / 2 times
+    // less work. The source is the area of the original image which the kernel can reach,
+    // starting at sourceOrigin in image coordinates.
+    static void gaussianBlur (const Image::BitmapData& source, Point<int> sourceOrigin,
+                              const Image::BitmapData& dest, Point<int> destOrigin,
+                              float radius, int size)
+    {
+        jassert (source.pixelFormat == dest.pixelFormat && size > 0);
+        using detail::SIMDFloat4;
+
+        const auto centre = size >> 1;
+        const auto numChannels = dest.pixelStride;
+        const auto rowLength = dest.width * numChannels;
+        const auto offset = destOrigin - sourceOrigin;
+
+        std::vector<float> kernel ((size_t) size);
+        const auto radiusFactor = -1.0 / (2.0 * (double) radius * (double) radius);
+        double total = 0;
+
+        for (int i = 0; i < size; ++i)
+            total += (kernel[(size_t) i] = (float) std::exp (radiusFactor * square (i - centre)));
+
+        for (auto& k : kernel)
+            k = (float) (k / total);
+
+        BlurThreadPool::forEachBand (dest.height, (int64) rowLength * size * 2, [&] (Range<int> rows)
+        {
+            const auto firstSourceRow = jmax (0, offset.y + rows.getStart() - centre);
+            const auto lastSourceRow = jmin (source.height, offset.y + rows.getEnd() + size - 1 - centre);
+
+            std::vector<float> horizontal ((size_t) (jmax (0, lastSourceRow - firstSourceRow) * rowLength));
+            std::vector<float> sourceRow ((size_t) (source.width * numChannels)), sum ((size_t) rowLength);
+
+            for (auto y = firstSourceRow; y < lastSourceRow; ++y)
+            {
+                const auto* in = source.getLinePointer (y);
+                std::copy (in, in + sourceRow.size(), sourceRow.begin());
+
+                auto* out = horizontal.data() + (y - firstSourceRow) * rowLength;
+
+                for (int k = 0; k < size; ++k)
+                {
+                    const auto dx = offset.x + k - centre;
+                    const auto start = jmax (0, -dx) * numChannels;
+                    const auto end = jmin (dest.width, source.width - dx) * numChannels;
+                    const auto shift = dx * numChannels;
+                    const auto weight = kernel[(size_t) k];
+
+                    forEachLaneGroup (start, end,
+                                      [&] (int i) { (SIMDFloat4::load (out + i) + SIMDFloat4::load (sourceRow.data() + (i + shift)) * weight).store (out + i); },
+                                      [&] (int i) { out[i] += weight * sourceRow[(size_t) (i + shift)]; });
+                }
+            }
+
+            for (auto y = rows.getStart(); y < rows.getEnd(); ++y)
+            {
+                std::fill (sum.begin(), sum.end(), 0.0f);
+
+                for (int k = 0; k < size; ++k)
+                {
+                    const auto sourceY = offset.y + y + k - centre;
+
+                    if (sourceY < firstSourceRow || sourceY >= lastSourceRow)
+                        continue;
+
+                    const auto* in = horizontal.data() + (sourceY - firstSourceRow) * rowLength;
+                    const auto weight = kernel[(size_t) k];
+
+                    forEachLaneGroup (0, rowLength,
+                                      [&] (int i) { (SIMDFloat4::load (sum.data() + i) + SIMDFloat4::load (in + i) * weight).store (sum.data() + i); },
+                                      [&] (int i) { sum[(size_t) i] += weight * in[i]; });
+                }
+
+                auto* out = dest.getLinePointer (y);
+
+                forEachLaneGroup (0, rowLength,
+                                  [&] (int i) { min (SIMDFloat4::load (sum.data() + i) + 0.5f, 255.0f).storeAsBytes (out + i); },
+                                  [&] (int i) { out[i] = (uint8) std::min (sum[(size_t) i] + 0.5f, 255.0f); });
+            }
+        });
     }
 
     template <class PixelType>
@@ -420,11 +674,24 @@ void ImagePixelData::applySingleChannelBoxBlurEffectInArea (Rectangle<int> bound
 
 void ImagePixelData::applyGaussianBlurEffectInArea (Rectangle<int> bounds, float radius)
 {
-    ImageConvolutionKernel blurKernel (roundToInt (radius * 2.0f));
-    blurKernel.createGaussianBlur (radius);
+    const auto size = roundToInt (radius * 2.0f);
+    const auto area = bounds.getIntersection ({ width, height });
 
-    Image target { this };
-    blurKernel.applyToImage (target, Image { this }.createCopy(), bounds);
+    if (size <= 0 || area.isEmpty())
+        return;
+
+    const auto centre = size >> 1;
+    const auto sourceArea = Rectangle<int>::leftTopRightBottom (area.getX() - centre,
+                                                                area.getY() - centre,
+                                                                area.getRight() + size - 1 - centre,
+                                                                area.getBottom() + size - 1 - centre)
+                                            .getIntersection ({ width, height });
+
+    const auto source = Image { this }.getClippedImage (sourceArea).createCopy();
+    const Image::BitmapData sourceData (source, Image::BitmapData::readOnly);
+    const Image::BitmapData destData (Image { this }, area, Image::BitmapData::writeOnly);
+
+    BitmapDataDetail::gaussianBlur (sourceData, sourceArea.getPosition(), destData, area.getPosition(), radius, size);
 }
 
 void ImagePixelData::multiplyAllAlphasInArea (Rectangle<int> b, float amount)
@@ -1068,6 +1335,227 @@ public:
 
 static ImagePixelDataClippingTests imagePixelDataClippingTests;
 
+//==============================================================================
+// The blurs that these used to be done with, which the faster ones are checked against
+struct ReferenceBlurs
+{
+    static void applyGaussianBlur (Image& image, Rectangle<int> area, float radius)
+    {
+        ImageConvolutionKernel kernel (roundToInt (radius * 2.0f));
+        kernel.createGaussianBlur (radius);
+        kernel.applyToImage (image, image.createCopy(), area);
+    }
+
+    static void applyBoxBlur (Image& image, int radius)
+    {
+        const Image::BitmapData bm (image, Image::BitmapData::readWrite);
+
+        for (int y = 0; y < bm.height; ++y)
+            for (int i = 2 * radius; --i >= 0;)
+                blurTriplets (bm.getLinePointer (y), bm.width, 1);
+
+        for (int x = 0; x < bm.width; ++x)
+            for (int i = 2 * radius; --i >= 0;)
+                blurTriplets (bm.getPixelPointer (x, 0), bm.height, bm.lineStride);
+    }
+
+    static void blurTriplets (uint8* d, int num, int delta)
+    {
+        uint32 last = d[0];
+        d[0] = (uint8) ((d[0] + d[delta] + 1) / 3);
+        d += delta;
+
+        for (num -= 2; num > 0; --num)
+        {
+            const uint32 newLast = d[0];
+            d[0] = (uint8) ((last + d[0] + d[delta] + 1) / 3);
+            d += delta;
+            last = newLast;
+        }
+
+        d[0] = (uint8) ((last + d[0] + 1) / 3);
+    }
+
+    static Image createTestImage (Image::PixelFormat format, int w, int h)
+    {
+        Image image (format, w, h, true, SoftwareImageType());
+        Graphics g (image);
+        Random r (1234);
+
+        for (int i = 0; i < 20; ++i)
+        {
+            g.setColour (Colour ((uint32) r.nextInt()));
+            g.fillEllipse ((float) r.nextInt (w), (float) r.nextInt (h),
+                           (float) r.nextInt (w / 2), (float) r.nextInt (h / 2));
+        }
+
+        return image;
+    }
+
+    static int getMaxDifference (const Image& a, const Image& b)
+    {
+        const Image::BitmapData da (a, Image::BitmapData::readOnly), db (b, Image::BitmapData::readOnly);
+        int result = 0;
+
+        for (int y = 0; y < da.height; ++y)
+            for (int i = 0; i < da.width * da.pixelStride; ++i)
+                result = jmax (result, std::abs ((int) da.getLinePointer (y)[i] - (int) db.getLinePointer (y)[i]));
+
+        return result;
+    }
+};
+
+class ImageBlurTests final : public UnitTest
+{
+public:
+    ImageBlurTests()  : UnitTest ("Image blurs", UnitTestCategories::graphics)  {}
+
+    void runTest() override
+    {
+        beginTest ("Gaussian blur matches ImageConvolutionKernel");
+        {
+            for (auto format : { Image::ARGB, Image::RGB, Image::SingleChannel })
+            {
+                const auto original = ReferenceBlurs::createTestImage (format, 90, 70);
+
+                for (auto radius : { 0.8f, 2.5f, 6.0f, 11.3f })
+                {
+                    for (auto area : { Rectangle<int> (90, 70), Rectangle<int> (13, 7, 40, 31), Rectangle<int> (-10, 50, 200, 40) })
+                    {
+                        auto expected = original.createCopy();
+                        ReferenceBlurs::applyGaussianBlur (expected, area, radius);
+
+                        auto blurred = original.createCopy();
+                        blurred.getPixelData()->applyGaussianBlurEffectInArea (area, radius);
+
+                        expectLessOrEqual (ReferenceBlurs::getMaxDifference (blurred, expected), 1);
+                    }
+                }
+            }
+        }
+
+        beginTest ("A zero-sized Gaussian blur leaves the image alone");
+        {
+            const auto original = ReferenceBlurs::createTestImage (Image::ARGB, 30, 30);
+            auto blurred = original.createCopy();
+            blurred.getPixelData()->applyGaussianBlurEffect (0.1f);
+
+            expectEquals (ReferenceBlurs::getMaxDifference (blurred, original), 0);
+        }
+
+        beginTest ("Box blur matches repeated three-pixel blurs");
+        {
+            for (auto radius : { 1, 2, 4, 9, 20 })
+            {
+                for (auto size : { Point { 120, 100 }, Point { 13, 9 }, Point { 37, 11 } })
+                {
+                    const auto original = ReferenceBlurs::createTestImage (Image::SingleChannel, size.x, size.y);
+
+                    auto expected = original.createCopy();
+                    ReferenceBlurs::applyBoxBlur (expected, radius);
+
+                    auto blurred = original.createCopy();
+                    blurred.getPixelData()->applySingleChannelBoxBlurEffect (radius);
+
+                    expectEquals (ReferenceBlurs::getMaxDifference (blurred, expected), 0);
+                }
+            }
+        }
+
+        beginTest ("Box blur only changes the given area");
+        {
+            const auto original = ReferenceBlurs::createTestImage (Image::SingleChannel, 60, 60);
+            auto blurred = original.createCopy();
+            blurred.getPixelData()->applySingleChannelBoxBlurEffectInArea ({ 10, 10, 30, 30 }, 3);
+
+            expectEquals (ReferenceBlurs::getMaxDifference (blurred.getClippedImage ({ 40, 0, 20, 60 }),
+                                                            original.getClippedImage ({ 40, 0, 20, 60 })), 0);
+            expectGreaterThan (ReferenceBlurs::getMaxDifference (blurred, original), 0);
+        }
+    }
+};
+
+static ImageBlurTests imageBlurTests;
+
+//==============================================================================
+class ImageBlurBenchmarks final : public UnitTest
+{
+public:
+    ImageBlurBenchmarks()  : UnitTest ("Image blur benchmarks", UnitTestCategories::benchmarks)  {}
+
+    void runTest() override
+    {
+        beginTest ("Gaussian blur");
+
+        for (auto radius : { 3.0f, 10.0f, 30.0f })
+        {
+            const auto original = ReferenceBlurs::createTestImage (Image::ARGB, 800, 600);
+
+            logMessage ("800x600 ARGB image, radius " + String (radius) + ": ImageConvolutionKernel "
+                          + time ([&] (Image& i) { ReferenceBlurs::applyGaussianBlur (i, i.getBounds(), radius); }, original)
+                          + ", applyGaussianBlurEffect "
+                          + time ([&] (Image& i) { i.getPixelData()->applyGaussianBlurEffect (radius); }, original));
+        }
+
+        beginTest ("Box blur");
+
+        for (auto radius : { 4, 16, 40 })
+        {
+            const auto original = ReferenceBlurs::createTestImage (Image::SingleChannel, 800, 600);
+
+            logMessage ("800x600 single-channel image, radius " + String (radius) + ": three-pixel blurs "
+                          + time ([&] (Image& i) { ReferenceBlurs::applyBoxBlur (i, radius); }, original)
+                          + ", applySingleChannelBoxBlurEffect "
+                          + time ([&] (Image& i) { i.getPixelData()->applySingleChannelBoxBlurEffect (radius); }, original));
+        }
+
+        beginTest ("Drop shadows");
+
+        const auto previousCacheSize = DropShadow::getPathShadowCacheSize();
+        Image target (Image::ARGB, 800, 600, true, SoftwareImageType());
+        const DropShadow shadow (Colours::black.withAlpha (0.5f), 12, { 2, 3 });
+
+        Path shape;
+        shape.addRoundedRectangle (0.0f, 0.0f, 120.0f, 40.0f, 6.0f);
+
+        for (auto cacheSize : { (size_t) 0, (size_t) 1024 * 1024 })
+        {
+            DropShadow::setPathShadowCacheSize (cacheSize);
+
+            const auto start = Time::getMillisecondCounterHiRes();
+            Graphics g (target);
+
+            for (int i = 0; i < 100; ++i)
+            {
+                auto button = shape;
+                button.applyTransform (AffineTransform::translation ((float) (i % 5) * 150.0f, (float) (i / 5) * 25.0f));
+                shadow.drawForPath (g, button);
+            }
+
+            logMessage ("100 button shadows, cache " + String (cacheSize / 1024) + "KB: "
+                          + String (Time::getMillisecondCounterHiRes() - start, 2) + "ms");
+        }
+
+        DropShadow::setPathShadowCacheSize (previousCacheSize);
+    }
+
+private:
+    template <typename Fn>
+    static String time (Fn&& blur, const Image& original)
+    {
+        constexpr int numRuns = 5;
+        auto image = original.createCopy();
+        const auto start = Time::getMillisecondCounterHiRes();
+
+        for (int i = 0; i < numRuns; ++i)
+            blur (image);
+
+        return String ((Time::getMillisecondCounterHiRes() - start) / numRuns, 2) + "ms";
+    }
+};
+
+static ImageBlurBenchmarks imageBlurBenchmarks;
+
 #endif
 
 } // namespace juce
@@ -621,8 +621,9 @@ public:
         This blur applies to all channels of the input image. It may be more expensive to
         calculate than a box blur, but should produce higher-quality results.
 
-        The default implementation will modify the image pixel-by-pixel on the CPU, which will be slow.
-        Native image types may provide optimised implementations.
+        The default implementation blurs the rows and then the columns of the image on the CPU,
+        spreading the work of large blurs over several threads. Native image types may provide
+        optimised implementations.
     */
     virtual void applyGaussianBlurEffectInArea (Rectangle<int> bounds, float radius);
 
@@ -637,8 +638,9 @@ public:
         shadows. This is implemented as several box-blurs in series. The results should be visually
         similar to a Gaussian blur, but less accurate.
 
-        The default implementation will modify the image pixel-by-pixel on the CPU, which will be slow.
-        Native image types may provide optimised implementations.
+        The default implementation runs on the CPU, blurring several rows or columns at once and
+        spreading the work of large blurs over several threads. Native image types may provide
+        optimised implementations.
     */
     virtual void applySingleChannelBoxBlurEffectInArea (Rectangle<int> bounds, int radius);
 
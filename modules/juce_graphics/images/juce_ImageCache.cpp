@@ -42,6 +42,7 @@ struct ImageCache::Pimpl     : private Timer,
 
     ~Pimpl() override
     {
+        loaderPool.reset();
         stopTimer();
         clearSingletonInstance();
     }
@@ -101,6 +102,167 @@ struct ImageCache::Pimpl     : private Timer,
             stopTimer();
     }
 
+    //==============================================================================
+    using Loader = std::function<Image()>;
+    using Callback = std::function<void (const Image&)>;
+
+    struct LoadRequest
+    {
+        int64 hashCode;
+        Loader loader;
+    };
+
+    LoadRequest createLoadRequest (const File& file)
+    {
+        return { file.hashCode64(),
+                 [file, type = getImageType()] { return convertToType (type.get(), ImageFileFormat::loadFrom (file)); } };
+    }
+
+    LoadRequest createLoadRequest (const void* imageData, int dataSize)
+    {
+        return { (int64) (pointer_sized_int) imageData,
+                 [imageData, dataSize, type = getImageType()]
+                 {
+                     return convertToType (type.get(), ImageFileFormat::loadFrom (imageData, (size_t) dataSize));
+                 } };
+    }
+
+    std::shared_ptr<const ImageType> getImageType()
+    {
+        const ScopedLock sl (lock);
+        return imageType;
+    }
+
+    static Image convertToType (const ImageType* type, const Image& image)
+    {
+        return type != nullptr ? type->convert (image) : image;
+    }
+
+    Array<Image> loadAll (const std::vector<LoadRequest>& requests)
+    {
+        // Each thread takes the next image that nobody has started on, so the calling
+        // thread can finish the whole set itself if the pool is busy with other work
+        struct Batch
+        {
+            void run()
+            {
+                for (;;)
+                {
+                    const auto index = nextIndex++;
+
+                    if (index >= toLoad.size())
+                        return;
+
+                    auto& request = *toLoad[index];
+                    results[index] = request.loader();
+
+                    if (--numRemaining == 0)
+                        finished.signal();
+                }
+            }
+
+            std::vector<const LoadRequest*> toLoad;
+            std::vector<Image> results;
+            std::atomic<size_t> nextIndex { 0 }, numRemaining { 0 };
+            WaitableEvent finished;
+        };
+
+        Array<Image> loaded;
+        std::map<int64, int> loadIndexes;
+        auto batch = std::make_shared<Batch>();
+
+        for (auto& request : requests)
+        {
+            auto image = getFromHashCode (request.hashCode);
+
+            if (image.isNull() && loadIndexes.find (request.hashCode) == loadIndexes.end())
+            {
+                loadIndexes[request.hashCode] = (int) batch->toLoad.size();
+                batch->toLoad.push_back (&request);
+            }
+
+            loaded.add (image);
+        }
+
+        if (batch->toLoad.empty())
+            return loaded;
+
+        batch->results.resize (batch->toLoad.size());
+        batch->numRemaining = batch->toLoad.size();
+
+        auto& pool = getLoaderPool();
+
+        for (auto i = jmin ((int) batch->toLoad.size() - 1, pool.getNumThreads()); --i >= 0;)
+            pool.addJob ([batch] { batch->run(); });
+
+        batch->run();
+        batch->finished.wait();
+
+        for (size_t i = 0; i < batch->toLoad.size(); ++i)
+            addImageToCache (batch->results[i], batch->toLoad[i]->hashCode);
+
+        for (int i = 0; i < loaded.size(); ++i)
+            if (loaded.getReference (i).isNull())
+                loaded.set (i, batch->results[(size_t) loadIndexes[requests[(size_t) i].hashCode]]);
+
+        return loaded;
+    }
+
+    void loadAsync (LoadRequest request, Callback callback)
+    {
+        jassert (callback != nullptr);
+
+        auto image = getFromHashCode (request.hashCode);
+
+        if (image.isValid())
+        {
+            MessageManager::callAsync ([image, callback = std::move (callback)] { callback (image); });
+            return;
+        }
+
+        {
+            const ScopedLock sl (lock);
+            auto& waiting = pendingCallbacks[request.hashCode];
+            waiting.push_back (std::move (callback));
+
+            if (waiting.size() > 1)
+                return; // this image is already being loaded
+        }
+
+        getLoaderPool().addJob ([this, request = std::move (request)]
+        {
+            auto loaded = request.loader();
+            addImageToCache (loaded, request.hashCode);
+
+            std::vector<Callback> callbacks;
+
+            {
+                const ScopedLock sl (lock);
+                auto found = pendingCallbacks.find (request.hashCode);
+                callbacks = std::move (found->second);
+                pendingCallbacks.erase (found);
+            }
+
+            MessageManager::callAsync ([loaded, callbacks = std::move (callbacks)]
+            {
+                for (auto& c : callbacks)
+                    c (loaded);
+            });
+        });
+    }
+
+    ThreadPool& getLoaderPool()
+    {
+        const ScopedLock sl (lock);
+
+        if (loaderPool == nullptr)
+            loaderPool = std::make_unique<ThreadPool> (ThreadPoolOptions{}.withThreadName ("ImageCache loader")
+                                                                          .withNumberOfThreads (jmax (1, SystemStats::getNumCpus() - 1)));
+
+        return *loaderPool;
+    }
+
+    //==============================================================================
     void releaseUnusedImages()
     {
         const ScopedLock sl (lock);
@@ -121,6 +283,10 @@ struct ImageCache::Pimpl     : private Timer,
     CriticalSection lock;
     unsigned int cacheTimeout = 5000;
 
+    std::shared_ptr<const ImageType> imageType;
+    std::map<int64, std::vector<Callback>> pendingCallbacks;
+    std::unique_ptr<ThreadPool> loaderPool;
+
     JUCE_DECLARE_NON_COPYABLE (Pimpl)
 };
 
@@ -145,7 +311,7 @@ Image ImageCache::getFromFile (const File& file)
 
     if (image.isNull())
     {
-        image = ImageFileFormat::loadFrom (file);
+        image = Pimpl::getInstance()->createLoadRequest (file).loader();
         addImageToCache (image, hashCode);
     }
 
@@ -159,13 +325,56 @@ Image ImageCache::getFromMemory (const void* imageData, const int dataSize)
 
     if (image.isNull())
     {
-        image = ImageFileFormat::loadFrom (imageData, (size_t) dataSize);
+        image = Pimpl::getInstance()->createLoadRequest (imageData, dataSize).loader();
         addImageToCache (image, hashCode);
     }
 
     return image;
 }
 
+//==============================================================================
+Array<Image> ImageCache::getFromFiles (const Array<File>& files)
+{
+    auto* pimpl = Pimpl::getInstance();
+    std::vector<Pimpl::LoadRequest> requests;
+
+    for (auto& file : files)
+        requests.push_back (pimpl->createLoadRequest (file));
+
+    return pimpl->loadAll (requests);
+}
+
+Array<Image> ImageCache::getFromMemory (const Array<InMemoryImage>& imagesToLoad)
+{
+    auto* pimpl = Pimpl::getInstance();
+    std::vector<Pimpl::LoadRequest> requests;
+
+    for (auto& image : imagesToLoad)
+        requests.push_back (pimpl->createLoadRequest (image.data, image.size));
+
+    return pimpl->loadAll (requests);
+}
+
+void ImageCache::getFromFileAsync (const File& file, std::function<void (const Image&)> callback)
+{
+    auto* pimpl = Pimpl::getInstance();
+    pimpl->loadAsync (pimpl->createLoadRequest (file), std::move (callback));
+}
+
+void ImageCache::getFromMemoryAsync (const void* imageData, int dataSize, std::function<void (const Image&)> callback)
+{
+    auto* pimpl = Pimpl::getInstance();
+    pimpl->loadAsync (pimpl->createLoadRequest (imageData, dataSize), std::move (callback));
+}
+
+void ImageCache::setImageType (std::unique_ptr<ImageType> newType)
+{
+    auto* pimpl = Pimpl::getInstance();
+
+    const ScopedLock sl (pimpl->lock);
+    pimpl->imageType = std::move (newType);
+}
+
 void ImageCache::setCacheTimeout (const int millisecs)
 {
     jassert (millisecs >= 0);
@@ -177,4 +386,305 @@ void ImageCache::releaseUnusedImages()
     Pimpl::getInstance()->releaseUnusedImages();
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ImageCacheTests final : public UnitTest
+{
+public:
+    ImageCacheTests()  : UnitTest ("ImageCache", UnitTestCategories::graphics)  {}
+
+    void runTest() override
+    {
+        auto rng = getRandom();
+
+        beginTest ("Row conversion");
+        {
+            for (int numPixels = 0; numPixels < 70; ++numPixels)
+            {
+                HeapBlock<uint8> rgba ((size_t) numPixels * 4 + 1), rgb ((size_t) numPixels * 3 + 1);
+                HeapBlock<PixelARGB> converted ((size_t) numPixels + 1), expected ((size_t) numPixels + 1);
+
+                for (int i = 0; i < numPixels * 4; ++i)
+                    rgba[i] = (uint8) rng.nextInt (256);
+
+                for (int i = 0; i < numPixels * 3; ++i)
+                    rgb[i] = (uint8) rng.nextInt (256);
+
+                // include runs of opaque and transparent pixels as well as random ones
+                for (int i = 0; i < numPixels; ++i)
+                    if (auto kind = (i / 4) % 3; kind != 2)
+                        rgba[i * 4 + 3] = kind == 0 ? 0xff : 0;
+
+                for (int i = 0; i < numPixels; ++i)
+                {
+                    expected[i].setARGB (rgba[i * 4 + 3], rgba[i * 4], rgba[i * 4 + 1], rgba[i * 4 + 2]);
+                    expected[i].premultiply();
+                }
+
+                ImageRowConversion::rgbaToPremultipliedARGB (rgba, (uint8*) converted.get(), numPixels, 4);
+                expect (std::equal (converted.get(), converted + numPixels, expected.get(),
+                                    [] (auto a, auto b) { return a.getNativeARGB() == b.getNativeARGB(); }));
+
+                for (int i = 0; i < numPixels; ++i)
+                    expected[i].setARGB (0xff, rgb[i * 3], rgb[i * 3 + 1], rgb[i * 3 + 2]);
+
+                ImageRowConversion::rgbToARGB (rgb, (uint8*) converted.get(), numPixels, 4);
+                expect (std::equal (converted.get(), converted + numPixels, expected.get(),
+                                    [] (auto a, auto b) { return a.getNativeARGB() == b.getNativeARGB(); }));
+            }
+        }
+
+        beginTest ("PNG decoding");
+        {
+            auto image = createTestImage (rng, 61, 37);
+            const auto png = createImageFile<PNGImageFormat> (image);
+            const auto loaded = ImageFileFormat::loadFrom (png.getData(), png.getSize());
+
+            expect (loaded.getBounds() == image.getBounds());
+
+            // PNGs store unpremultiplied colours, so only the alpha survives exactly
+            for (int y = 0; y < image.getHeight(); ++y)
+                for (int x = 0; x < image.getWidth(); ++x)
+                    expectEquals ((int) loaded.getPixelAt (x, y).getAlpha(), (int) image.getPixelAt (x, y).getAlpha());
+        }
+
+        beginTest ("JPEG decoding for a size");
+        {
+            const auto jpeg = createImageFile<JPEGImageFormat> (createTestImage (rng, 400, 300));
+            const auto decodeForSize = [&] (int w, int h)
+            {
+                MemoryInputStream in (jpeg, false);
+                return JPEGImageFormat().decodeImageForSize (in, w, h).getBounds();
+            };
+
+            expect (decodeForSize (0, 0)     == Rectangle<int> (400, 300));
+            expect (decodeForSize (100, 70)  == Rectangle<int> (100, 75));
+            expect (decodeForSize (120, 20)  == Rectangle<int> (200, 150));
+            expect (decodeForSize (40, 30)   == Rectangle<int> (50, 38));
+            expect (decodeForSize (401, 300) == Rectangle<int> (400, 300));
+        }
+
+        beginTest ("Loading several images at once");
+        {
+            std::vector<const MemoryBlock*> files;
+
+            for (int i = 0; i < 12; ++i)
+                files.push_back (&keepUntilEnd (createImageFile<PNGImageFormat> (createTestImage (rng, 20 + i, 10))));
+
+            files.push_back (&keepUntilEnd (MemoryBlock ("not an image", 12)));
+
+            Array<ImageCache::InMemoryImage> sources;
+
+            for (auto* f : files)
+                sources.add ({ f->getData(), (int) f->getSize() });
+
+            sources.add (sources[3]);
+
+            const auto images = ImageCache::getFromMemory (sources);
+            expectEquals (images.size(), sources.size());
+
+            for (int i = 0; i < 12; ++i)
+                expect (images[i].getBounds() == Rectangle<int> (20 + i, 10));
+
+            expect (images[12].isNull());
+            expect (images[13] == images[3]);
+            expect (ImageCache::getFromMemory (files[5]->getData(), (int) files[5]->getSize()) == images[5]);
+
+           #if JUCE_MODAL_LOOPS_PERMITTED
+            Array<Image> received;
+            const auto callback = [&] (const Image& image) { received.add (image); };
+
+            const auto& jpeg = keepUntilEnd (createImageFile<JPEGImageFormat> (createTestImage (rng, 33, 22)));
+            const auto& png = keepUntilEnd (createImageFile<PNGImageFormat> (createTestImage (rng, 44, 11)));
+
+            ImageCache::getFromMemoryAsync (jpeg.getData(), (int) jpeg.getSize(), callback);
+            ImageCache::getFromMemoryAsync (png.getData(), (int) png.getSize(), callback);
+            ImageCache::getFromMemoryAsync (jpeg.getData(), (int) jpeg.getSize(), callback);
+            ImageCache::getFromMemoryAsync (files[7]->getData(), (int) files[7]->getSize(), callback);
+            expect (received.isEmpty());
+
+            for (int i = 0; i < 500 && received.size() < 4; ++i)
+                MessageManager::getInstance()->runDispatchLoopUntil (10);
+
+            expectEquals (received.size(), 4);
+            expect (received.contains (images[7]));
+
+            const auto numWithBounds = [&] (Rectangle<int> bounds)
+            {
+                return std::count_if (received.begin(), received.end(), [&] (auto& i) { return i.getBounds() == bounds; });
+            };
+
+            expectEquals ((int) numWithBounds ({ 33, 22 }), 2);
+            expectEquals ((int) numWithBounds ({ 44, 11 }), 1);
+           #endif
+        }
+
+        beginTest ("Storing images as another type");
+        {
+            const auto& png = keepUntilEnd (createImageFile<PNGImageFormat> (createTestImage (rng, 30, 20)));
+
+            ImageCache::setImageType (std::make_unique<CompressedImageType>());
+            const auto image = ImageCache::getFromMemory (png.getData(), (int) png.getSize());
+            ImageCache::setImageType (nullptr);
+
+            expect (image.getBounds() == Rectangle<int> (30, 20));
+            expect (image.getPixelData()->createType()->getTypeID() == CompressedImageType().getTypeID());
+        }
+
+        ImageCache::releaseUnusedImages();
+        filesInCache.clear();
+    }
+
+    static Image createTestImage (Random& rng, int width, int height)
+    {
+        Image image (Image::ARGB, width, height, true, SoftwareImageType());
+
+        for (int y = 0; y < height; ++y)
+            for (int x = 0; x < width; ++x)
+                image.setPixelAt (x, y, Colour ((uint32) rng.nextInt()).withAlpha ((uint8) (x * 255 / width)));
+
+        return image;
+    }
+
+    template <typename Format>
+    static MemoryBlock createImageFile (const Image& image)
+    {
+        MemoryOutputStream out;
+        Format().writeImageToStream (image, out);
+        return out.getMemoryBlock();
+    }
+
+private:
+    // ImageCache::getFromMemory() identifies an image by the address of its data, so a file
+    // that's loaded through the cache has to stay allocated until the cache has been
+    // cleared, or a later file could be given the same address and be mistaken for it.
+    const MemoryBlock& keepUntilEnd (MemoryBlock file)
+    {
+        return filesInCache.emplace_back (std::move (file));
+    }
+
+    std::deque<MemoryBlock> filesInCache;
+};
+
+static ImageCacheTests imageCacheTests;
+
+//==============================================================================
+class ImageCacheBenchmarks final : public UnitTest
+{
+public:
+    ImageCacheBenchmarks()  : UnitTest ("ImageCache benchmarks", UnitTestCategories::benchmarks)  {}
+
+    void runTest() override
+    {
+        beginTest ("Loading an editor's images");
+
+        // A set of images like those that a large plug-in editor might load when it opens:
+        // lots of small PNG controls and some large PNG and JPEG backgrounds
+        auto rng = getRandom();
+        std::vector<MemoryBlock> files;
+
+        for (int i = 0; i < 200; ++i)
+            files.push_back (ImageCacheTests::createImageFile<PNGImageFormat> (createSkinImage (rng, 128, 128)));
+
+        for (int i = 0; i < 8; ++i)
+            files.push_back (ImageCacheTests::createImageFile<PNGImageFormat> (createSkinImage (rng, 1600, 1000)));
+
+        for (int i = 0; i < 8; ++i)
+            files.push_back (ImageCacheTests::createImageFile<JPEGImageFormat> (createSkinImage (rng, 1600, 1000)));
+
+        Array<ImageCache::InMemoryImage> sources;
+
+        for (auto& f : files)
+            sources.add ({ f.getData(), (int) f.getSize() });
+
+        ImageCache::releaseUnusedImages();
+
+        logMessage ("ImageCache::getFromMemory, one at a time: " + time ([&]
+        {
+            for (auto& source : sources)
+                expect (ImageCache::getFromMemory (source.data, source.size).isValid());
+
+            ImageCache::releaseUnusedImages();
+        }));
+
+        logMessage ("ImageCache::getFromMemory, all at once: " + time ([&]
+        {
+            for (auto& image : ImageCache::getFromMemory (sources))
+                expect (image.isValid());
+
+            ImageCache::releaseUnusedImages();
+        }));
+
+        beginTest ("Decoding a JPEG at a smaller size");
+
+        const auto& jpeg = files.back();
+
+        logMessage ("JPEGImageFormat::decodeImage: " + time ([&]
+        {
+            MemoryInputStream in (jpeg, false);
+            expect (JPEGImageFormat().decodeImage (in).getWidth() == 1600);
+        }));
+
+        logMessage ("JPEGImageFormat::decodeImageForSize, 1/4: " + time ([&]
+        {
+            MemoryInputStream in (jpeg, false);
+            expect (JPEGImageFormat().decodeImageForSize (in, 400, 250).getWidth() == 400);
+        }));
+
+        beginTest ("Row conversion");
+
+        constexpr int numPixels = 16 * 1024 * 1024;
+        HeapBlock<uint8> rgba ((size_t) numPixels * 4);
+        HeapBlock<PixelARGB> dest ((size_t) numPixels);
+        rng.fillBitsRandomly (rgba, (size_t) numPixels * 4);
+
+        logMessage ("PixelARGB::premultiply: " + time ([&]
+        {
+            const auto* src = rgba.get();
+
+            for (int i = 0; i < numPixels; ++i, src += 4)
+            {
+                dest[i].setARGB (src[3], src[0], src[1], src[2]);
+                dest[i].premultiply();
+            }
+        }));
+
+        logMessage ("ImageRowConversion::rgbaToPremultipliedARGB: " + time ([&]
+        {
+            ImageRowConversion::rgbaToPremultipliedARGB (rgba, (uint8*) dest.get(), numPixels, 4);
+        }));
+    }
+
+private:
+    // Smooth gradients and flat areas with soft edges, which compress like real artwork
+    static Image createSkinImage (Random& rng, int width, int height)
+    {
+        Image image (Image::ARGB, width, height, true);
+        Graphics g (image);
+
+        g.setGradientFill (ColourGradient (Colour ((uint32) rng.nextInt()), 0.0f, 0.0f,
+                                           Colour ((uint32) rng.nextInt()).withAlpha (0.5f), (float) width, (float) height, false));
+        g.fillRoundedRectangle (image.getBounds().reduced (width / 16).toFloat(), (float) width / 8.0f);
+
+        g.setColour (Colour ((uint32) rng.nextInt()));
+        g.drawEllipse (image.getBounds().reduced (width / 4).toFloat(), (float) width / 32.0f);
+
+        return image;
+    }
+
+    template <typename Fn>
+    static String time (Fn&& fn)
+    {
+        const auto start = Time::getMillisecondCounterHiRes();
+        fn();
+        return String (Time::getMillisecondCounterHiRes() - start, 1) + " ms";
+    }
+};
+
+static ImageCacheBenchmarks imageCacheBenchmarks;
+
+#endif
+
 } // namespace juce
@@ -89,6 +89,64 @@ public:
     */
     static Image getFromMemory (const void* imageData, int dataSize);
 
+    //==============================================================================
+    /** Refers to an image file that's held in memory, such as one in BinaryData. */
+    struct InMemoryImage
+    {
+        const void* data = nullptr;
+        int size = 0;
+    };
+
+    /** Loads a set of image files, (or finds them in the cache), decoding the ones that
+        aren't already cached on several threads at once.
+
+        This blocks until all the images are available, but when there are many of
+        them it takes a fraction of the time that calling getFromFile() for each one
+        would, so it's a good way to load all the images that an editor needs before
+        it's shown.
+
+        @returns    the images, in the same order as the files, with an invalid image
+                    for any file that couldn't be loaded
+        @see getFromFile, getFromFileAsync
+    */
+    static Array<Image> getFromFiles (const Array<File>& files);
+
+    /** Loads a set of in-memory image files, (or finds them in the cache), decoding the
+        ones that aren't already cached on several threads at once.
+
+        @returns    the images, in the same order as the sources, with an invalid image
+                    for any that couldn't be loaded
+        @see getFromMemory, getFromMemoryAsync
+    */
+    static Array<Image> getFromMemory (const Array<InMemoryImage>& images);
+
+    /** Loads an image from a file on a background thread, (or finds it in the cache),
+        and then calls a function on the message thread with the result.
+
+        The images are decoded by a set of threads that the cache keeps for this, so a
+        component that needs many images can ask for them all at once and draw each
+        one as it arrives, instead of waiting for them to be decoded in turn. If a file
+        is asked for again while it's still being loaded, it's only decoded once.
+
+        The callback is always called asynchronously, even if the image is already in
+        the cache, and it's given an invalid image if the file couldn't be loaded. If
+        the callback refers to a component, capture it with a Component::SafePointer,
+        as the component may have gone by the time the image arrives.
+
+        @see getFromFile, getFromFiles
+    */
+    static void getFromFileAsync (const File& file, std::function<void (const Image&)> callback);
+
+    /** Loads an image from an in-memory image file on a background thread, (or finds
+        it in the cache), and then calls a function on the message thread with the result.
+
+        The data must stay valid until the callback has been called, which is always the
+        case for BinaryData. See getFromFileAsync() for more details.
+
+        @see getFromMemory, getFromFileAsync
+    */
+    static void getFromMemoryAsync (const void* imageData, int dataSize, std::function<void (const Image&)> callback);
+
     //==============================================================================
     /** Checks the cache for an image with a particular hashcode.
 
@@ -112,6 +170,18 @@ public:
     */
     static void addImageToCache (const Image& image, int64 hashCode);
 
+    /** Sets the type of storage that images are converted to when the cache loads them.
+
+        By default, images are kept in whatever form the image format decoded them
+        into. Using a CompressedImageType can greatly reduce the memory used by an
+        application with lots of large images, at the cost of some CPU when they're
+        drawn. Images that are already cached, or are added with addImageToCache(),
+        aren't affected. Passing nullptr goes back to the default.
+
+        @see CompressedImageType
+    */
+    static void setImageType (std::unique_ptr<ImageType> newType);
+
     /** Changes the amount of time before an unused image will be removed from the cache.
         By default this is about 5 seconds.
     */
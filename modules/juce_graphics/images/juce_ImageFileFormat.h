@@ -195,6 +195,20 @@ public:
     */
     void setQuality (float newQuality);
 
+    /** Decodes an image at a reduced size.
+
+        A JPEG can be shrunk by a factor of 2, 4 or 8 while it's being decoded, which is
+        much quicker than decoding the whole image and scaling it down afterwards. This
+        uses the largest of those reductions that still gives an image of at least
+        minWidth x minHeight pixels, so it can then be drawn or rescaled to the size that
+        you actually need. If there's no such reduction, the image is decoded at its
+        full size.
+
+        @returns    the image, or an invalid image if the stream couldn't be decoded
+        @see decodeImage
+    */
+    Image decodeImageForSize (InputStream& input, int minWidth, int minHeight);
+
     //==============================================================================
     String getFormatName() override;
     bool usesFileExtension (const File&) override;
@@ -166,6 +166,8 @@ extern "C"
 
 #include "native/juce_EventTracing.h"
 #include "images/juce_ImagePixelDataNativeExtensions.h"
+#include "image_formats/juce_ImageRowConversion.h"
+#include "detail/juce_SIMDFloat4.h"
 
 #include "unicode/juce_UnicodeGenerated.cpp"
 #include "unicode/juce_UnicodeUtils.cpp"
@@ -185,9 +187,11 @@ extern "C"
 #include "placement/juce_RectanglePlacement.cpp"
 #include "contexts/juce_GraphicsContext.cpp"
 #include "contexts/juce_LowLevelGraphicsSoftwareRenderer.cpp"
+#include "contexts/juce_DisplayList.cpp"
 #include "images/juce_Image.cpp"
 #include "images/juce_ImageCache.cpp"
 #include "images/juce_ImageConvolutionKernel.cpp"
+#include "images/juce_CompressedImageType.cpp"
 #include "images/juce_ImageFileFormat.cpp"
 #include "image_formats/juce_GIFLoader.cpp"
 #include "image_formats/juce_JPEGLoader.cpp"
@@ -103,6 +103,7 @@
 namespace juce
 {
     class Image;
+    class ImageType;
     class AffineTransform;
     class Path;
     class Font;
@@ -147,7 +148,9 @@ namespace juce
 #include "fonts/juce_GlyphArrangement.h"
 #include "fonts/juce_TextLayout.h"
 #include "contexts/juce_LowLevelGraphicsContext.h"
+#include "contexts/juce_DisplayList.h"
 #include "images/juce_ScaledImage.h"
+#include "images/juce_CompressedImageType.h"
 #include "contexts/juce_LowLevelGraphicsSoftwareRenderer.h"
 #include "effects/juce_ImageEffectFilter.h"
 #include "effects/juce_DropShadowEffect.h"
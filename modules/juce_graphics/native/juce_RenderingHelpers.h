@@ -240,6 +240,577 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GlyphCache)
 };
 
+//==============================================================================
+/** Keeps recently-drawn glyphs as 8-bit alpha masks, packed into a few large pages.
+
+    Drawing a glyph that's already in the atlas only involves blending its mask onto
+    the destination, rather than iterating an edge-table. Each glyph is rendered at
+    four horizontal sub-pixel offsets so that text laid out at fractional positions
+    keeps its spacing, without every new position needing a new mask.
+
+    @tags{Graphics}
+*/
+class GlyphAtlas  : private DeletedAtShutdown
+{
+public:
+    GlyphAtlas() = default;
+
+    ~GlyphAtlas() override
+    {
+        getSingletonPointer() = nullptr;
+    }
+
+    static GlyphAtlas& getInstance()
+    {
+        auto& g = getSingletonPointer();
+
+        if (g == nullptr)
+            g = new GlyphAtlas();
+
+        return *g;
+    }
+
+    //==============================================================================
+    void reset()
+    {
+        const ScopedLock sl (lock);
+        entries.clear();
+        pages.clear();
+    }
+
+    /** Finds or renders the mask for a glyph, and passes an iterator over the parts of it
+        that lie within the clip region to the callback, which should fill it.
+
+        The position is in device space. If the glyph can't be drawn from the atlas - for
+        example because it's too big, or has colour layers - this returns false without
+        calling the callback, and the caller should render the glyph some other way.
+    */
+    template <typename Callback>
+    bool drawGlyph (const Font& font, int glyph, Point<float> position,
+                    const RectangleList<int>& clip, Callback&& callback)
+    {
+        const ScopedTryLock stl (lock);
+
+        if (! stl.isLocked())
+            return false;
+
+        // Positions are rounded to the nearest sub-pixel step horizontally, and to a
+        // whole pixel vertically, which is what the edge-table fallback does too.
+        constexpr auto step = 256 / numSubPixelPositions;
+        const auto fixedX = (int) std::floor (position.x * 256.0f) + step / 2;
+        const auto subPixelPosition = (fixedX & 0xff) / step;
+        const Point origin { fixedX >> 8, roundToInt (position.y) };
+
+        auto* entry = getEntry ({ font, glyph, subPixelPosition });
+
+        if (entry == nullptr)
+            return false;
+
+        const MaskIterator iter (*entry, origin, clip);
+
+        if (iter.isVisible())
+            callback (iter);
+
+        return true;
+    }
+
+    /** Returns the number of glyph masks currently held in the atlas. */
+    int getNumGlyphs() const
+    {
+        const ScopedLock sl (lock);
+        return (int) entries.size();
+    }
+
+    /** Returns the number of bytes used by the atlas pages. */
+    size_t getMemoryUsage() const
+    {
+        const ScopedLock sl (lock);
+        return pages.size() * (size_t) (pageSize * pageSize);
+    }
+
+    static constexpr int pageSize = 512;
+    static constexpr int maxPages = 4;
+    static constexpr int maxGlyphSize = 96;
+    static constexpr int numSubPixelPositions = 4;
+
+private:
+    //==============================================================================
+    struct Key
+    {
+        Font font;
+        int glyph;
+        int subPixelPosition;
+
+        bool operator< (const Key& other) const
+        {
+            const auto tie = [] (const Key& k) { return std::tie (k.glyph, k.subPixelPosition); };
+
+            if (tie (*this) != tie (other))
+                return tie (*this) < tie (other);
+
+            return GraphicsFontHelpers::compareFont (font, other.font);
+        }
+    };
+
+    struct Page
+    {
+        struct Shelf
+        {
+            int y, height, usedWidth;
+        };
+
+        std::optional<Rectangle<int>> allocate (int w, int h)
+        {
+            Shelf* best = nullptr;
+
+            for (auto& s : shelves)
+                if (h <= s.height && h * 2 + 2 >= s.height && s.usedWidth + w <= pageSize)
+                    if (best == nullptr || s.height < best->height)
+                        best = &s;
+
+            if (best == nullptr)
+            {
+                const auto shelfHeight = (h + 3) & ~3;
+
+                if (nextShelfY + shelfHeight > pageSize)
+                    return {};
+
+                best = &shelves.emplace_back (Shelf { nextShelfY, shelfHeight, 0 });
+                nextShelfY += shelfHeight;
+            }
+
+            const Rectangle<int> area (best->usedWidth, best->y, w, h);
+            best->usedWidth += w;
+            return area;
+        }
+
+        void clear()
+        {
+            zeromem (pixels.get(), (size_t) (pageSize * pageSize));
+            shelves.clear();
+            keys.clear();
+            nextShelfY = 0;
+        }
+
+        HeapBlock<uint8> pixels { (size_t) (pageSize * pageSize), true };
+        std::vector<Shelf> shelves;
+        std::vector<Key> keys;
+        int nextShelfY = 0;
+        uint64 lastUsed = 0;
+    };
+
+    struct Entry
+    {
+        Page* page = nullptr;
+        Rectangle<int> area;        // the mask's position within its page
+        Point<int> offset;          // the mask's position relative to the glyph's origin
+        bool isSupported = true;    // false if the glyph must be drawn some other way
+    };
+
+    //==============================================================================
+    // Receives the output of an edge-table and stores the levels in a page.
+    struct MaskWriter
+    {
+        MaskWriter (uint8* pagePixels, Rectangle<int> destArea, Point<int> sourceOrigin)
+            : pixels (pagePixels), area (destArea), origin (sourceOrigin) {}
+
+        void setEdgeTableYPos (int y) noexcept
+        {
+            const auto row = y - origin.y;
+            line = isPositiveAndBelow (row, area.getHeight()) ? pixels + (area.getY() + row) * pageSize + area.getX()
+                                                             : nullptr;
+        }
+
+        void handleEdgeTablePixel (int x, int alphaLevel) noexcept       { handleEdgeTableLine (x, 1, alphaLevel); }
+        void handleEdgeTablePixelFull (int x) noexcept                   { handleEdgeTableLine (x, 1, 255); }
+        void handleEdgeTableLineFull (int x, int width) noexcept         { handleEdgeTableLine (x, width, 255); }
+
+        void handleEdgeTableLine (int x, int width, int alphaLevel) noexcept
+        {
+            if (line == nullptr)
+                return;
+
+            const auto start = jmax (x, origin.x);
+            const auto end = jmin (x + width, origin.x + area.getWidth());
+
+            if (start < end)
+                memset (line + (start - origin.x), alphaLevel, (size_t) (end - start));
+        }
+
+        uint8* pixels;
+        uint8* line = nullptr;
+        Rectangle<int> area;
+        Point<int> origin;
+    };
+
+    //==============================================================================
+    // Feeds the pixels of a mask that lie inside a clip region to an edge-table filler.
+    class MaskIterator
+    {
+    public:
+        MaskIterator (const Entry& entry, Point<int> glyphOrigin, const RectangleList<int>& clipRegion)
+            : source (entry.page->pixels.get() + entry.area.getY() * pageSize + entry.area.getX()),
+              destArea (entry.area.withPosition (glyphOrigin + entry.offset)),
+              clip (clipRegion)
+        {
+        }
+
+        bool isVisible() const noexcept
+        {
+            return ! destArea.isEmpty() && clip.intersects (destArea);
+        }
+
+        template <class Renderer>
+        void iterate (Renderer& r) const noexcept
+        {
+            for (auto& c : clip)
+            {
+                const auto area = c.getIntersection (destArea);
+
+                for (int y = area.getY(); y < area.getBottom(); ++y)
+                {
+                    const auto* levels = source + (y - destArea.getY()) * pageSize;
+                    const auto getLevel = [&] (int x) { return levels[x - destArea.getX()]; };
+                    r.setEdgeTableYPos (y);
+
+                    for (int x = area.getX(); x < area.getRight();)
+                    {
+                        const auto level = getLevel (x);
+                        auto end = x + 1;
+
+                        while (end < area.getRight() && getLevel (end) == level)
+                            ++end;
+
+                        if (level == 255)
+                        {
+                            if (end - x == 1)   r.handleEdgeTablePixelFull (x);
+                            else                r.handleEdgeTableLineFull (x, end - x);
+                        }
+                        else if (level != 0)
+                        {
+                            if (end - x == 1)   r.handleEdgeTablePixel (x, level);
+                            else                r.handleEdgeTableLine (x, end - x, level);
+                        }
+
+                        x = end;
+                    }
+                }
+            }
+        }
+
+    private:
+        const uint8* source;
+        Rectangle<int> destArea;
+        const RectangleList<int>& clip;
+
+        JUCE_DECLARE_NON_COPYABLE (MaskIterator)
+    };
+
+    //==============================================================================
+    const Entry* getEntry (const Key& key)
+    {
+        ++useCounter;
+        auto iter = entries.find (key);
+
+        if (iter == entries.end())
+        {
+            iter = entries.emplace (key, createEntry (key)).first;
+            iter->second.page->keys.push_back (key);
+        }
+
+        auto& entry = iter->second;
+        entry.page->lastUsed = useCounter;
+        return entry.isSupported ? &entry : nullptr;
+    }
+
+    Entry createEntry (const Key& key)
+    {
+        const auto layers = GlyphCache::getInstance().get (key.font, key.glyph);
+
+        if (layers.empty())
+            return { &getCurrentPage(), {}, {} };
+
+        auto* colourLayer = std::get_if<ColourLayer> (&layers.front().layer);
+
+        if (layers.size() != 1 || colourLayer == nullptr || colourLayer->colour.has_value())
+            return { &getCurrentPage(), {}, {}, false };
+
+        auto edgeTable = colourLayer->clip;
+        edgeTable.translate ((float) key.subPixelPosition / (float) numSubPixelPositions, 0);
+
+        // The fractional offset can push the last pixel of each line one step to the right
+        auto bounds = edgeTable.getMaximumBounds();
+        bounds.setWidth (bounds.getWidth() + 1);
+
+        if (bounds.getHeight() <= 0)
+            return { &getCurrentPage(), {}, {} };
+
+        if (bounds.getWidth() > maxGlyphSize || bounds.getHeight() > maxGlyphSize)
+            return { &getCurrentPage(), {}, {}, false };
+
+        auto area = getCurrentPage().allocate (bounds.getWidth(), bounds.getHeight());
+
+        if (! area.has_value())
+            area = addPage().allocate (bounds.getWidth(), bounds.getHeight());
+
+        auto& page = getCurrentPage();
+        MaskWriter writer (page.pixels.get(), *area, bounds.getPosition());
+        edgeTable.iterate (writer);
+
+        return { &page, *area, bounds.getPosition() };
+    }
+
+    Page& getCurrentPage()
+    {
+        return pages.empty() ? addPage() : *pages.back();
+    }
+
+    Page& addPage()
+    {
+        if ((int) pages.size() < maxPages)
+            return *pages.emplace_back (std::make_unique<Page>());
+
+        // Reuse the page that has gone the longest without being drawn from
+        const auto lru = std::min_element (pages.begin(), pages.end(), [] (auto& a, auto& b) { return a->lastUsed < b->lastUsed; });
+        auto page = std::move (*lru);
+        pages.erase (lru);
+
+        for (auto& k : page->keys)
+            entries.erase (k);
+
+        page->clear();
+        return *pages.emplace_back (std::move (page));
+    }
+
+    std::map<Key, Entry> entries;
+    std::vector<std::unique_ptr<Page>> pages;
+    uint64 useCounter = 0;
+    CriticalSection lock;
+
+    static GlyphAtlas*& getSingletonPointer() noexcept
+    {
+        static GlyphAtlas* g = nullptr;
+        return g;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GlyphAtlas)
+};
+
+//==============================================================================
+/** Keeps the edge-tables of recently-stroked paths, so that a path which is drawn
+    over and over again with the same stroke and transform only needs to be turned
+    into an edge-table once.
+
+    Moving a path by whole pixels doesn't stop it matching an earlier entry, because
+    the tables are stored without the integer part of their translation.
+
+    This is empty by default, and only starts keeping tables once it's been given
+    some memory to use by LowLevelGraphicsSoftwareRenderer::setStrokeCacheSize().
+
+    @tags{Graphics}
+*/
+class StrokeCache  : private DeletedAtShutdown
+{
+public:
+    StrokeCache() = default;
+
+    ~StrokeCache() override
+    {
+        getSingletonPointer() = nullptr;
+    }
+
+    static StrokeCache& getInstance()
+    {
+        auto& s = getSingletonPointer();
+
+        if (s == nullptr)
+            s = new StrokeCache();
+
+        return *s;
+    }
+
+    //==============================================================================
+    void setMaxMemoryUsage (size_t newMaxBytes)
+    {
+        const ScopedLock sl (lock);
+        maxBytes = newMaxBytes;
+        removeOldEntries (0);
+    }
+
+    size_t getMaxMemoryUsage() const noexcept   { return maxBytes; }
+
+    /** Returns an area that's guaranteed to contain the whole of a stroke. */
+    static Rectangle<int> getStrokeBounds (const Path& path, const PathStrokeType& strokeType,
+                                           const AffineTransform& pathTransform, const AffineTransform& outputTransform)
+    {
+        return getStrokeBounds (path.getBoundsTransformed (pathTransform), strokeType, outputTransform);
+    }
+
+    /** Returns an area that's guaranteed to contain the whole of a stroke of a path
+        with the given bounds.
+    */
+    static Rectangle<int> getStrokeBounds (Rectangle<float> pathBounds, const PathStrokeType& strokeType,
+                                           const AffineTransform& outputTransform)
+    {
+        // mitred joints can stick out by up to three times the thickness
+        const auto thickness = strokeType.getStrokeThickness();
+        const auto margin = strokeType.getJointStyle() == PathStrokeType::mitered ? thickness * 3.5f : thickness;
+
+        return pathBounds.expanded (margin)
+                         .transformedBy (outputTransform)
+                         .getSmallestIntegerContainer()
+                         .expanded (1);
+    }
+
+    size_t getMemoryUsage() const
+    {
+        const ScopedLock sl (lock);
+        return bytesUsed;
+    }
+
+    int getNumEntries() const
+    {
+        const ScopedLock sl (lock);
+        return (int) entries.size();
+    }
+
+    void reset()
+    {
+        const ScopedLock sl (lock);
+        entries.clear();
+        bytesUsed = 0;
+    }
+
+    /** Returns the table for a stroke, using a cached one if possible, along with the
+        whole-pixel offset at which it needs to be drawn. Returns nullptr if the cache
+        is disabled, in which case the caller should create the table itself.
+    */
+    std::shared_ptr<const EdgeTable> get (const Path& path, const PathStrokeType& strokeType,
+                                          const AffineTransform& pathTransform, const AffineTransform& outputTransform,
+                                          float extraAccuracy, Point<int>& offset)
+    {
+        if (maxBytes == 0)
+            return {};
+
+        // Strokes don't change shape when they're moved, so the translation can be taken
+        // out of the path's transform, and then the whole-pixel part of the overall
+        // translation can be applied to the cached table when it's drawn.
+        const auto strokeTransform = pathTransform.withAbsoluteTranslation (0.0f, 0.0f);
+        const auto fullOutputTransform = AffineTransform::translation (pathTransform.getTranslationX(),
+                                                                       pathTransform.getTranslationY())
+                                                         .followedBy (outputTransform);
+
+        offset = { (int) std::floor (fullOutputTransform.getTranslationX()),
+                   (int) std::floor (fullOutputTransform.getTranslationY()) };
+
+        const auto localTransform = fullOutputTransform.translated (-offset.toFloat());
+        const auto hash = getHash (path, strokeType, strokeTransform, localTransform, extraAccuracy);
+
+        {
+            const ScopedLock sl (lock);
+
+            for (auto i = entries.begin(); i != entries.end(); ++i)
+            {
+                if (i->hash == hash
+                     && i->strokeType == strokeType
+                     && i->pathTransform == strokeTransform
+                     && i->outputTransform == localTransform
+                     && exactlyEqual (i->extraAccuracy, extraAccuracy)
+                     && i->path == path)
+                {
+                    entries.splice (entries.begin(), entries, i);
+                    return i->table;
+                }
+            }
+        }
+
+        const auto bounds = getStrokeBounds (path, strokeType, strokeTransform, localTransform);
+
+        if (bounds.isEmpty())
+            return {};
+
+        auto table = std::make_shared<EdgeTable> (bounds, path, strokeType, strokeTransform, localTransform, extraAccuracy);
+        table->optimiseTable();
+
+        const auto size = table->getMemoryUsage();
+
+        if (size <= maxBytes)
+        {
+            const ScopedLock sl (lock);
+            removeOldEntries (size);
+            entries.push_front ({ hash, path, strokeType, strokeTransform, localTransform, extraAccuracy, table, size });
+            bytesUsed += size;
+        }
+
+        return table;
+    }
+
+private:
+    struct Entry
+    {
+        uint64 hash;
+        Path path;
+        PathStrokeType strokeType;
+        AffineTransform pathTransform, outputTransform;
+        float extraAccuracy;
+        std::shared_ptr<const EdgeTable> table;
+        size_t size;
+    };
+
+    std::list<Entry> entries;
+    std::atomic<size_t> maxBytes { 0 };
+    size_t bytesUsed = 0;
+    CriticalSection lock;
+
+    void removeOldEntries (size_t spaceNeeded)
+    {
+        while (! entries.empty() && bytesUsed + spaceNeeded > maxBytes)
+        {
+            bytesUsed -= entries.back().size;
+            entries.pop_back();
+        }
+    }
+
+    static uint64 getHash (const Path& path, const PathStrokeType& strokeType,
+                           const AffineTransform& pathTransform, const AffineTransform& outputTransform,
+                           float extraAccuracy)
+    {
+        uint64 result = 0;
+
+        const auto combine = [&result] (auto value)
+        {
+            result = (result * 1000003) ^ (uint64) std::hash<decltype (value)>{} (value);
+        };
+
+        for (Path::Iterator i (path); i.next();)
+        {
+            combine ((int) i.elementType);
+
+            for (auto v : { i.x1, i.y1, i.x2, i.y2, i.x3, i.y3 })
+                combine (v);
+        }
+
+        for (auto& t : { pathTransform, outputTransform })
+            for (auto v : { t.mat00, t.mat01, t.mat02, t.mat10, t.mat11, t.mat12 })
+                combine (v);
+
+        combine (strokeType.getStrokeThickness());
+        combine ((int) strokeType.getJointStyle());
+        combine ((int) strokeType.getEndStyle());
+        combine (extraAccuracy);
+
+        return result;
+    }
+
+    static StrokeCache*& getSingletonPointer() noexcept
+    {
+        static StrokeCache* s = nullptr;
+        return s;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (StrokeCache)
+};
+
 //==============================================================================
 /** Calculates the alpha values and positions for rendering the edges of a
     non-pixel-aligned rectangle.
@@ -1571,6 +2142,18 @@ namespace ClipRegions
         EdgeTableRegion (const RectangleList<float>& r) : edgeTable (r) {}
         EdgeTableRegion (Rectangle<int> bounds, const Path& p, const AffineTransform& t) : edgeTable (bounds, p, t) {}
 
+        EdgeTableRegion (Rectangle<int> bounds, const Path& p, const PathStrokeType& s,
+                         const AffineTransform& pathTransform, const AffineTransform& outputTransform, float extraAccuracy)
+            : edgeTable (bounds, p, s, pathTransform, outputTransform, extraAccuracy) {}
+
+        EdgeTableRegion (Rectangle<int> bounds, Span<const Point<float>> points, const PathStrokeType& s,
+                         const AffineTransform& outputTransform, float extraAccuracy)
+            : edgeTable (bounds, points, s, outputTransform, extraAccuracy) {}
+
+        EdgeTableRegion (Rectangle<int> bounds, float x, float columnWidth,
+                         Span<const float> tops, Span<const float> bottoms, const AffineTransform& t)
+            : edgeTable (bounds, x, columnWidth, tops, bottoms, t) {}
+
         EdgeTableRegion (const EdgeTableRegion& other)  : edgeTable (other.edgeTable) {}
         EdgeTableRegion& operator= (const EdgeTableRegion&) = delete;
 
@@ -2262,6 +2845,58 @@ public:
         }
     }
 
+    void strokePath (const Path& path, const PathStrokeType& strokeType, const AffineTransform& t)
+    {
+        if (clip == nullptr)
+            return;
+
+        const auto outputTransform = transform.getTransform();
+        const auto extraAccuracy = transform.getPhysicalPixelScaleFactor();
+        Point<int> offset;
+
+        if (auto cached = StrokeCache::getInstance().get (path, strokeType, t, outputTransform, extraAccuracy, offset))
+        {
+            auto* edgeTableClip = new EdgeTableRegionType (*cached);
+            edgeTableClip->edgeTable.translate ((float) offset.x, offset.y);
+
+            fillShape (*edgeTableClip, false);
+            return;
+        }
+
+        const auto area = clip->getClipBounds().getIntersection (StrokeCache::getStrokeBounds (path, strokeType, t, outputTransform));
+
+        if (! area.isEmpty())
+            fillShape (*new EdgeTableRegionType (area, path, strokeType, t, outputTransform, extraAccuracy), false);
+    }
+
+    void drawPolyline (Span<const Point<float>> points, const PathStrokeType& strokeType)
+    {
+        if (clip == nullptr)
+            return;
+
+        const auto outputTransform = transform.getTransform();
+        const auto pointBounds = Rectangle<float>::findAreaContainingPoints (points.data(), (int) points.size());
+        const auto area = clip->getClipBounds().getIntersection (StrokeCache::getStrokeBounds (pointBounds, strokeType, outputTransform));
+
+        if (! area.isEmpty())
+            fillShape (*new EdgeTableRegionType (area, points, strokeType, outputTransform,
+                                                 transform.getPhysicalPixelScaleFactor()), false);
+    }
+
+    /** Returns false if the spans can't be drawn with the current transform. */
+    bool fillVerticalSpans (float x, float columnWidth, Span<const float> tops, Span<const float> bottoms)
+    {
+        const auto t = transform.getTransform();
+
+        if (! (exactlyEqual (t.mat01, 0.0f) && exactlyEqual (t.mat10, 0.0f) && t.mat00 > 0 && t.mat11 > 0))
+            return false;
+
+        if (clip != nullptr)
+            fillShape (*new EdgeTableRegionType (clip->getClipBounds(), x, columnWidth, tops, bottoms, t), false);
+
+        return true;
+    }
+
     void fillEdgeTable (const EdgeTable& edgeTable, float x, int y)
     {
         if (clip != nullptr)
@@ -2358,21 +2993,8 @@ public:
             {
                 jassert (! replaceContents); // that option is just for solid colours
 
-                auto g2 = *(fillType.gradient);
-                g2.multiplyOpacity (fillType.getOpacity());
-                auto t = transform.getTransformWith (fillType.transform).translated (-0.5f, -0.5f);
-
-                bool isIdentity = t.isOnlyTranslation();
-
-                if (isIdentity)
-                {
-                    // if our translation doesn't involve any distortion, we can speed it up
-                    g2.point1.applyTransform (t);
-                    g2.point2.applyTransform (t);
-                    t = {};
-                }
-
-                shapeToFill->fillAllWithGradient (getThis(), g2, t, isIdentity);
+                auto g = getGradientFill();
+                shapeToFill->fillAllWithGradient (getThis(), g.gradient, g.transform, g.isIdentity);
             }
             else if (fillType.isTiledImage())
             {
@@ -2385,6 +3007,41 @@ public:
         }
     }
 
+    struct GradientFill
+    {
+        ColourGradient gradient;
+        AffineTransform transform;
+        bool isIdentity;
+    };
+
+    GradientFill getGradientFill() const
+    {
+        auto g2 = *(fillType.gradient);
+        g2.multiplyOpacity (fillType.getOpacity());
+        auto t = transform.getTransformWith (fillType.transform).translated (-0.5f, -0.5f);
+
+        bool isIdentity = t.isOnlyTranslation();
+
+        if (isIdentity)
+        {
+            // if our translation doesn't involve any distortion, we can speed it up
+            g2.point1.applyTransform (t);
+            g2.point2.applyTransform (t);
+            t = {};
+        }
+
+        return { g2, t, isIdentity };
+    }
+
+    /** Draws a monochrome glyph from a cache of pre-rendered masks, if the context
+        supports that. The position is in device space. Returns false if the glyph
+        needs to be drawn some other way.
+    */
+    bool drawCachedGlyph (const Font&, int, Point<float>)
+    {
+        return false;
+    }
+
     void cloneClipIfMultiplyReferenced()
     {
         if (clip->getReferenceCount() > 1)
@@ -2457,6 +3114,33 @@ public:
     static void clearGlyphCache()
     {
         GlyphCache::getInstance().reset();
+        GlyphAtlas::getInstance().reset();
+    }
+
+    bool drawCachedGlyph (const Font& f, int glyph, Point<float> position)
+    {
+        // The atlas masks can only be combined with a rectangular clip, and tiled
+        // images are filled through the clip region's own virtual methods.
+        if (fillType.isTiledImage())
+            return false;
+
+        auto* rectangleClip = dynamic_cast<RectangleListRegionType*> (clip.get());
+
+        if (rectangleClip == nullptr)
+            return false;
+
+        return GlyphAtlas::getInstance().drawGlyph (f, glyph, position, rectangleClip->clip, [this] (auto& iter)
+        {
+            if (fillType.isGradient())
+            {
+                auto g = getGradientFill();
+                fillWithGradient (iter, g.gradient, g.transform, g.isIdentity);
+            }
+            else
+            {
+                fillWithSolidColour (iter, fillType.colour.getPixelARGB(), false);
+            }
+        });
     }
 
     //==============================================================================
@@ -2619,6 +3303,14 @@ public:
     void fillRect (const Rectangle<float>& r)                                override { stack->fillRect (r); }
     void fillRectList (const RectangleList<float>& list)                     override { stack->fillRectList (list); }
     void fillPath (const Path& path, const AffineTransform& t)               override { stack->fillPath (path, t); }
+    void strokePath (const Path& path, const PathStrokeType& s, const AffineTransform& t) override { stack->strokePath (path, s, t); }
+    void drawPolyline (Span<const Point<float>> points, const PathStrokeType& s)        override { stack->drawPolyline (points, s); }
+
+    void fillVerticalSpans (float x, float columnWidth, Span<const float> tops, Span<const float> bottoms) override
+    {
+        if (! stack->fillVerticalSpans (x, columnWidth, tops, bottoms))
+            LowLevelGraphicsContext::fillVerticalSpans (x, columnWidth, tops, bottoms);
+    }
     void drawImage (const Image& im, const AffineTransform& t)               override { stack->drawImage (im, t); }
     void drawLine (const Line<float>& line)                                  override { stack->drawLine (line); }
     void setFont (const Font& newFont)                                       override { stack->font = newFont; }
@@ -2641,18 +3333,14 @@ protected:
         if (stack->clip == nullptr)
             return;
 
-        const auto [layers, drawPosition] = [&]
+        if (t.isOnlyTranslation() && ! stack->transform.isRotated)
         {
-            if (t.isOnlyTranslation() && ! stack->transform.isRotated)
-            {
-                auto& cache = RenderingHelpers::GlyphCache::getInstance();
-                const Point pos (t.getTranslationX(), t.getTranslationY());
+            const Point pos (t.getTranslationX(), t.getTranslationY());
 
+            const auto [font, drawPosition] = [&]
+            {
                 if (this->stack->transform.isOnlyTranslated)
-                {
-                    const auto drawPos = pos + stack->transform.offset.toFloat();
-                    return std::tuple (cache.get (stack->font, i), drawPos);
-                }
+                    return std::tuple (stack->font, pos + stack->transform.offset.toFloat());
 
                 auto f = stack->font;
                 f.setHeight (f.getHeight() * stack->transform.complexTransform.mat11);
@@ -2662,17 +3350,24 @@ protected:
                 if (std::abs (xScale - 1.0f) > 0.01f)
                     f.setHorizontalScale (xScale);
 
-                const auto drawPos = stack->transform.transformed (pos);
-                return std::tuple (cache.get (f, i), drawPos);
-            }
+                return std::tuple (f, stack->transform.transformed (pos));
+            }();
+
+            if (! stack->drawCachedGlyph (font, i, drawPosition))
+                drawGlyphLayers (RenderingHelpers::GlyphCache::getInstance().get (font, i), drawPosition);
 
-            const auto fontHeight = stack->font.getHeightInPoints();
-            const auto fontTransform = AffineTransform::scale (fontHeight * stack->font.getHorizontalScale(),
-                                                               fontHeight).followedBy (t);
-            const auto fullTransform = stack->transform.getTransformWith (fontTransform);
-            return std::tuple (stack->font.getTypefacePtr()->getLayersForGlyph (i, fullTransform), Point<float>{});
-        }();
+            return;
+        }
 
+        const auto fontHeight = stack->font.getHeightInPoints();
+        const auto fontTransform = AffineTransform::scale (fontHeight * stack->font.getHorizontalScale(),
+                                                           fontHeight).followedBy (t);
+        const auto fullTransform = stack->transform.getTransformWith (fontTransform);
+        drawGlyphLayers (stack->font.getTypefacePtr()->getLayersForGlyph (i, fullTransform), {});
+    }
+
+    void drawGlyphLayers (std::vector<GlyphLayer> layers, Point<float> drawPosition)
+    {
         const auto initialFill = stack->fillType;
         const ScopeGuard scope { [&] { this->stack->setFillType (initialFill); } };
 
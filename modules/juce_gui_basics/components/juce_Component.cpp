@@ -265,12 +265,276 @@ private:
     ImageEffectFilter* effect;
 };
 
+//==============================================================================
+class Component::DisplayListState
+{
+public:
+    void paint (Graphics& g, Component& c)
+    {
+        content.paint (g, c.getLocalBounds(), [&c] (Graphics& recorder) { c.paint (recorder); });
+    }
+
+    void paintOverChildren (Graphics& g, Component& c)
+    {
+        overChildren.paint (g, c.getLocalBounds(), [&c] (Graphics& recorder) { c.paintOverChildren (recorder); });
+    }
+
+    void invalidate()
+    {
+        content.isValid = overChildren.isValid = false;
+    }
+
+    void releaseResources()
+    {
+        for (auto* layer : { &content, &overChildren })
+        {
+            layer->list.clear();
+            layer->isValid = false;
+        }
+    }
+
+private:
+    struct Layer
+    {
+        template <typename PaintFn>
+        void paint (Graphics& g, Rectangle<int> area, PaintFn&& paintFn)
+        {
+            auto& context = g.getInternalContext();
+
+            // A vector device like a printer should get the original operations, and a
+            // paint() method which recursively paints its own component shouldn't
+            // record over the recording that's already in progress.
+            if (context.isVectorDevice() || isRecording)
+            {
+                paintFn (g);
+                return;
+            }
+
+            const auto contextScale = context.getPhysicalPixelScaleFactor();
+
+            if (! isValid || area != recordedArea || ! approximatelyEqual (scale, contextScale))
+            {
+                const ScopedValueSetter svs { isRecording, true };
+                const auto recordingContext = list.createRecordingContext (area, contextScale);
+                Graphics recorder (*recordingContext);
+                paintFn (recorder);
+
+                isValid = true;
+                recordedArea = area;
+                scale = contextScale;
+            }
+
+            context.saveState();
+            list.replay (context);
+            context.restoreState();
+        }
+
+        DisplayList list;
+        Rectangle<int> recordedArea;
+        float scale = 0.0f;
+        bool isValid = false, isRecording = false;
+    };
+
+    Layer content, overChildren;
+};
+
+//==============================================================================
+/*  A uniform grid covering a component, where each cell holds the z-order indices of the
+    children that overlap it. Moving a child just moves it between cells, but adding,
+    removing or reordering children changes their indices, so the whole grid gets rebuilt
+    the next time it's used.
+*/
+class Component::ChildIndex
+{
+public:
+    void invalidate() noexcept
+    {
+        isValid = false;
+    }
+
+    void childBoundsChanged (const Component& owner, const Component& child)
+    {
+        if (! isValid)
+            return;
+
+        const auto iter = entries.find (&child);
+
+        if (iter == entries.end())
+        {
+            jassertfalse;
+            invalidate();
+            return;
+        }
+
+        auto& entry = iter->second;
+        const auto area = child.getBoundsInParent();
+
+        if (owner.getLocalBounds() != ownerBounds || mustAlwaysBePainted (child, area) != entry.alwaysPainted)
+        {
+            invalidate();
+            return;
+        }
+
+        forEachCell (entry.cells, [index = entry.index] (auto& cell)
+        {
+            const auto pos = std::lower_bound (cell.begin(), cell.end(), index);
+            jassert (pos != cell.end() && *pos == index);
+            cell.erase (pos);
+        });
+
+        entry.cells = getCellRange (area.expanded (1));
+
+        forEachCell (entry.cells, [index = entry.index] (auto& cell)
+        {
+            cell.insert (std::lower_bound (cell.begin(), cell.end(), index), index);
+        });
+    }
+
+    /*  Calls the function with each of the owner's children that might contain the given
+        position, starting with the front-most, until it returns a non-null component.
+    */
+    template <typename Fn>
+    static Component* findChildAt (Component& owner, Point<float> position, Fn&& fn)
+    {
+        const auto& children = owner.childComponentList;
+
+        if (auto* index = owner.getChildIndex())
+        {
+            index->update (owner);
+
+            const auto cellPos = index->getCell (position.toInt());
+            const auto& cell = index->cells[(size_t) (cellPos.y * index->numColumns + cellPos.x)];
+
+            for (auto i = cell.size(); i > 0;)
+                if (auto* result = fn (*children.getUnchecked (cell[--i])))
+                    return result;
+
+            return nullptr;
+        }
+
+        for (int i = children.size(); --i >= 0;)
+            if (auto* result = fn (*children.getUnchecked (i)))
+                return result;
+
+        return nullptr;
+    }
+
+    /*  Finds the z-order indices of the children that need to be painted when the given area
+        of the owner is redrawn. Returns false if that's likely to be most of them, in which
+        case it's quicker to just go through them all.
+    */
+    bool getChildrenToPaint (const Component& owner, Rectangle<int> area, std::vector<int>& result)
+    {
+        update (owner);
+
+        const auto range = getCellRange (area);
+
+        if (range.getWidth() * range.getHeight() * 2 > numColumns * numRows)
+            return false;
+
+        result = alwaysPainted;
+
+        forEachCell (range, [&] (const auto& cell) { result.insert (result.end(), cell.begin(), cell.end()); });
+
+        std::sort (result.begin(), result.end());
+        result.erase (std::unique (result.begin(), result.end()), result.end());
+        return true;
+    }
+
+private:
+    struct Entry
+    {
+        int index;
+        Rectangle<int> cells;
+        bool alwaysPainted;
+    };
+
+    void update (const Component& owner)
+    {
+        if (isValid && owner.getLocalBounds() == ownerBounds)
+            return;
+
+        isValid = true;
+        ownerBounds = owner.getLocalBounds();
+
+        const auto& children = owner.childComponentList;
+        const auto area = (double) ownerBounds.getWidth() * (double) ownerBounds.getHeight();
+
+        // Aim for roughly one child per cell, assuming that they're spread evenly
+        cellSize = jmax (minCellSize, (int) std::ceil (std::sqrt (area / jmax (1, children.size()))));
+        numColumns = jmax (1, (ownerBounds.getWidth()  + cellSize - 1) / cellSize);
+        numRows    = jmax (1, (ownerBounds.getHeight() + cellSize - 1) / cellSize);
+
+        for (auto& cell : cells)
+            cell.clear();
+
+        cells.resize ((size_t) (numColumns * numRows));
+        entries.clear();
+        alwaysPainted.clear();
+
+        for (const auto [index, child] : enumerate (children, int{}))
+        {
+            const auto childArea = child->getBoundsInParent();
+            const Entry entry { index, getCellRange (childArea.expanded (1)), mustAlwaysBePainted (*child, childArea) };
+
+            forEachCell (entry.cells, [index = index] (auto& cell) { cell.push_back (index); });
+
+            if (entry.alwaysPainted)
+                alwaysPainted.push_back (index);
+
+            entries.emplace (child, entry);
+        }
+    }
+
+    // Children that can draw outside the owner's bounds are painted whatever the area
+    bool mustAlwaysBePainted (const Component& child, Rectangle<int> area) const
+    {
+        return child.isPaintingUnclipped() || ! ownerBounds.contains (area);
+    }
+
+    // Positions outside the owner are clamped to the nearest cell
+    Point<int> getCell (Point<int> pos) const
+    {
+        return { jlimit (0, numColumns - 1, pos.x / cellSize),
+                 jlimit (0, numRows    - 1, pos.y / cellSize) };
+    }
+
+    Rectangle<int> getCellRange (Rectangle<int> area) const
+    {
+        if (area.isEmpty())
+            return {};
+
+        const auto topLeft = getCell (area.getPosition());
+        const auto bottomRight = getCell (area.getBottomRight() - Point<int> (1, 1));
+        return Rectangle<int>::leftTopRightBottom (topLeft.x, topLeft.y, bottomRight.x + 1, bottomRight.y + 1);
+    }
+
+    template <typename Fn>
+    void forEachCell (Rectangle<int> range, Fn&& fn)
+    {
+        for (int y = range.getY(); y < range.getBottom(); ++y)
+            for (int x = range.getX(); x < range.getRight(); ++x)
+                fn (cells[(size_t) (y * numColumns + x)]);
+    }
+
+    static constexpr int minCellSize = 16;
+
+    std::vector<std::vector<int>> cells;
+    std::unordered_map<const Component*, Entry> entries;
+    std::vector<int> alwaysPainted;
+    Rectangle<int> ownerBounds;
+    int cellSize = minCellSize, numColumns = 1, numRows = 1;
+    bool isValid = false;
+};
+
 class Component::Data
 {
 public:
     std::unique_ptr<Positioner> positioner;
     AffineTransform affineTransform;
     std::unique_ptr<EffectState> effectState;
+    std::unique_ptr<DisplayListState> displayListState;
+    std::unique_ptr<ChildIndex> childIndex;
     MouseListenerList mouseListeners;
     Array<KeyListener*> keyListeners;
     ComponentPaintDiagnostics* currentDiagnostics{};
@@ -298,11 +562,12 @@ const Array<KeyListener*>* Component::getKeyListeners() const
 class Component::OpaqueLayer
 {
 public:
-    explicit OpaqueLayer (const Component* c)
+    OpaqueLayer (const Component* c, Rectangle<int> clip)
         : currentComponent (c)
     {
         jassert (c != nullptr);
-        appendOpaqueChildren (*c, {}, c->getLocalBounds());
+        clipBounds = c->getLocalBounds().getIntersection (clip);
+        appendOpaqueChildren (*c, {}, clipBounds);
     }
 
     [[nodiscard]] auto pushComponent (Component& component)
@@ -349,6 +614,16 @@ public:
         removeOpaqueChildren (component);
     }
 
+    /*  Returns the area of the component whose children are being painted, in its own
+        coordinates, outside which none of its children have been added to this layer.
+        Children that lie outside both this and the clip region can be skipped without
+        calling pushComponent().
+    */
+    Rectangle<int> getAreaContainingChildren (const Component& parent) const
+    {
+        return (clipBounds - offsetFromOrigin).getIntersection (parent.getLocalBounds());
+    }
+
 private:
     enum class ObscuredBy
     {
@@ -357,9 +632,9 @@ private:
     };
 
     template <ObscuredBy obscuredBy>
-    Rectangle<int> getNonOccludedBoundsForCurrentComponent (Rectangle<int> clipBounds) const
+    Rectangle<int> getNonOccludedBoundsForCurrentComponent (Rectangle<int> areaToCheck) const
     {
-        auto visibleBounds = currentComponent->getLocalBounds().getIntersection (clipBounds);
+        auto visibleBounds = currentComponent->getLocalBounds().getIntersection (areaToCheck);
 
         if (visibleBounds.isEmpty())
             return {};
@@ -472,6 +747,7 @@ private:
 
     int currentPosition{};
     Point<int> offsetFromOrigin{};
+    Rectangle<int> clipBounds;
     const Component* currentComponent;
     Array<OpaqueComponentInfo> opaqueComponents;
 };
@@ -852,6 +1128,43 @@ void Component::setBufferedToImage (bool shouldBeBuffered)
     }
 }
 
+void Component::setBufferedToDisplayList (bool shouldBeBuffered)
+{
+    if (shouldBeBuffered)
+    {
+        if (auto& state = createDataIfNeeded().displayListState; state == nullptr)
+            state = std::make_unique<DisplayListState>();
+    }
+    else if (componentData != nullptr)
+    {
+        componentData->displayListState.reset();
+    }
+}
+
+//==============================================================================
+void Component::setIndexingChildBounds (bool shouldIndexChildBounds)
+{
+    if (shouldIndexChildBounds)
+    {
+        if (auto& index = createDataIfNeeded().childIndex; index == nullptr)
+            index = std::make_unique<ChildIndex>();
+    }
+    else if (componentData != nullptr)
+    {
+        componentData->childIndex.reset();
+    }
+}
+
+bool Component::isIndexingChildBounds() const noexcept
+{
+    return getChildIndex() != nullptr;
+}
+
+auto Component::getChildIndex() const noexcept -> ChildIndex*
+{
+    return componentData != nullptr ? componentData->childIndex.get() : nullptr;
+}
+
 void Component::invalidateCachedImageResources()
 {
     if (componentData == nullptr)
@@ -860,6 +1173,9 @@ void Component::invalidateCachedImageResources()
     if (componentData->cachedImage != nullptr)
         componentData->cachedImage->releaseResources();
 
+    if (componentData->displayListState != nullptr)
+        componentData->displayListState->releaseResources();
+
     if (componentData->effectState != nullptr)
         componentData->effectState->releaseResources();
 }
@@ -875,6 +1191,9 @@ void Component::reorderChildInternal (int sourceIndex, int destIndex)
 
         childComponentList.move (sourceIndex, destIndex);
 
+        if (auto* index = getChildIndex())
+            index->invalidate();
+
         sendFakeMouseMove();
         internalChildrenChanged();
     }
@@ -1105,6 +1424,10 @@ void Component::setBounds (int x, int y, int w, int h)
 
         boundsRelativeToParent.setBounds (x, y, w, h);
 
+        if (parentComponent != nullptr)
+            if (auto* index = parentComponent->getChildIndex())
+                index->childBoundsChanged (*parentComponent, *this);
+
         if (showing)
         {
             if (wasResized)
@@ -1112,9 +1435,13 @@ void Component::setBounds (int x, int y, int w, int h)
             else if (! flags.hasHeavyweightPeerFlag)
                 repaintParent();
         }
-        else if (componentData != nullptr && componentData->cachedImage != nullptr)
+        else if (componentData != nullptr)
         {
-            componentData->cachedImage->invalidateAll();
+            if (componentData->cachedImage != nullptr)
+                componentData->cachedImage->invalidateAll();
+
+            if (componentData->displayListState != nullptr)
+                componentData->displayListState->invalidate();
         }
 
         flags.isMoveCallbackPending = wasMoved;
@@ -1277,6 +1604,11 @@ void Component::setTransform (const AffineTransform& newTransform)
 
     repaint();
     affineTransform = newTransform;
+
+    if (parentComponent != nullptr)
+        if (auto* index = parentComponent->getChildIndex())
+            index->childBoundsChanged (*parentComponent, *this);
+
     repaint();
     sendMovedResizedMessages (false, false);
 }
@@ -1315,14 +1647,14 @@ bool Component::hitTest (int x, int y)
 
     if (flags.allowChildMouseClicksFlag)
     {
-        for (int i = childComponentList.size(); --i >= 0;)
-        {
-            auto& child = *childComponentList.getUnchecked (i);
+        const auto position = Point<int> (x, y).toFloat();
 
-            if (child.isVisible()
-                 && detail::ComponentHelpers::hitTest (child, detail::ComponentHelpers::convertFromParentSpace (child, Point<int> (x, y).toFloat())))
-                return true;
-        }
+        return ChildIndex::findChildAt (*this, position, [&] (Component& child)
+        {
+            return child.isVisible()
+                && detail::ComponentHelpers::hitTest (child, detail::ComponentHelpers::convertFromParentSpace (child, position))
+                     ? &child : nullptr;
+        }) != nullptr;
     }
 
     return false;
@@ -1387,15 +1719,13 @@ Component* Component::getComponentAt (Point<float> position)
 {
     if (flags.visibleFlag && detail::ComponentHelpers::hitTest (*this, position))
     {
-        for (int i = childComponentList.size(); --i >= 0;)
+        const auto findComponentAt = [&] (Component& child)
         {
-            auto* child = childComponentList.getUnchecked (i);
-
-            child = child->getComponentAt (detail::ComponentHelpers::convertFromParentSpace (*child, position));
+            return child.getComponentAt (detail::ComponentHelpers::convertFromParentSpace (child, position));
+        };
 
-            if (child != nullptr)
-                return child;
-        }
+        if (auto* child = ChildIndex::findChildAt (*this, position, findComponentAt))
+            return child;
 
         return this;
     }
@@ -1445,6 +1775,9 @@ void Component::addChildComponent (Component& child, int zOrder)
 
         childComponentList.insert (zOrder, &child);
 
+        if (auto* index = getChildIndex())
+            index->invalidate();
+
         child.internalHierarchyChanged();
         internalChildrenChanged();
     }
@@ -1508,6 +1841,9 @@ Component* Component::removeChildComponent (int index, bool sendParentEvents, bo
         childComponentList.remove (index);
         child->parentComponent = nullptr;
 
+        if (auto* childIndex = getChildIndex())
+            childIndex->invalidate();
+
         detail::ComponentHelpers::releaseAllCachedImageResources (*child);
 
         // (NB: there are obscure situations where child->isShowing() = false, but it still has the focus)
@@ -1875,6 +2211,11 @@ void Component::internalRepaintUnchecked (Rectangle<int> area, bool isEntireComp
     // thread, you'll need to use a MessageManagerLock object to make sure it's thread-safe.
     JUCE_ASSERT_MESSAGE_MANAGER_IS_LOCKED
 
+    // This is done even while the component is hidden, so that it can't reappear
+    // showing a recording of its old appearance
+    if (isEntireComponent && componentData != nullptr && componentData->displayListState != nullptr)
+        componentData->displayListState->invalidate();
+
     if (flags.visibleFlag)
     {
         if (componentData != nullptr && componentData->cachedImage != nullptr)
@@ -1963,47 +2304,70 @@ void Component::paintComponentAndChildren (Graphics& g, OpaqueLayer& opaqueLayer
             g.reduceClipRegion (paintBounds);
 
         const auto diagnosticTimer = diagnostics.paintDuration.createTimer();
-        paint (g);
+
+        if (componentData != nullptr && componentData->displayListState != nullptr)
+            componentData->displayListState->paint (g, *this);
+        else
+            paint (g);
     }
 
-    for (auto* child : getChildren())
+    const auto paintChild = [&] (Component& child)
     {
-        if (! detail::ComponentHelpers::isVisibleWithNonZeroArea (*child))
-            continue;
+        if (! detail::ComponentHelpers::isVisibleWithNonZeroArea (child))
+            return;
 
         ComponentPaintDiagnostics childDiagnostics;
 
         const ScopeGuard scopedListenerCallback { [&]
         {
-            child->componentListeners.call ([&] (auto& l) { l.componentPainted (*child, childDiagnostics); });
+            child.componentListeners.call ([&] (auto& l) { l.componentPainted (child, childDiagnostics); });
         } };
 
         const auto diagnosticTimer = childDiagnostics.totalPaintDuration.createTimer();
 
-        if (child->isTransformed() || child->componentTransparency != 0)
+        if (child.isTransformed() || child.componentTransparency != 0)
         {
             Graphics::ScopedSaveState ss (g);
 
-            if (child->isTransformed())
-                g.addTransform (child->componentData->affineTransform);
+            if (child.isTransformed())
+                g.addTransform (child.componentData->affineTransform);
 
-            child->paintWithinParentContext (g, opaqueLayer, childDiagnostics);
+            child.paintWithinParentContext (g, opaqueLayer, childDiagnostics);
         }
         else
         {
-            const auto componentPopper = opaqueLayer.pushComponent (*child);
+            const auto componentPopper = opaqueLayer.pushComponent (child);
             const auto componentBounds = opaqueLayer.getCurrentComponentBounds (g);
 
             if (componentBounds.isEmpty())
-                continue;
+                return;
 
             Graphics::ScopedSaveState ss (g);
 
-            if (! child->isPaintingUnclipped())
+            if (! child.isPaintingUnclipped())
                 g.reduceClipRegion (componentBounds);
 
-            child->paintWithinParentContext (g, opaqueLayer, childDiagnostics);
+            child.paintWithinParentContext (g, opaqueLayer, childDiagnostics);
         }
+    };
+
+    // Children outside the clip region can't draw anything, and as long as they're also
+    // outside the area that the opaque layer covers, they can be skipped entirely
+    std::vector<int> childrenToPaint;
+
+    if (auto* index = getChildIndex();
+        index != nullptr
+        && index->getChildrenToPaint (*this,
+                                      g.getClipBounds().getUnion (opaqueLayer.getAreaContainingChildren (*this)),
+                                      childrenToPaint))
+    {
+        for (auto i : childrenToPaint)
+            paintChild (*childComponentList.getUnchecked (i));
+    }
+    else
+    {
+        for (auto* child : getChildren())
+            paintChild (*child);
     }
 
     Graphics::ScopedSaveState ss (g);
@@ -2012,12 +2376,16 @@ void Component::paintComponentAndChildren (Graphics& g, OpaqueLayer& opaqueLayer
         g.reduceClipRegion (getLocalBounds());
 
     const auto diagnosticTimer = diagnostics.paintOverChildrenDuration.createTimer();
-    paintOverChildren (g);
+
+    if (componentData != nullptr && componentData->displayListState != nullptr)
+        componentData->displayListState->paintOverChildren (g, *this);
+    else
+        paintOverChildren (g);
 }
 
 void Component::paintEntireComponent (Graphics& g, bool ignoreAlphaLevel)
 {
-    OpaqueLayer opaqueLayer { this };
+    OpaqueLayer opaqueLayer { this, g.getClipBounds() };
 
     // If we are writing into a cached image we don't want to generate a
     // completely independent callback, so we skip the creation of a new
@@ -2075,7 +2443,7 @@ void Component::paintEntireComponent (Graphics& g, bool ignoreAlphaLevel, Opaque
     {
         if (componentTransparency < 255)
         {
-            OpaqueLayer transparentOpaqueLayer { this };
+            OpaqueLayer transparentOpaqueLayer { this, g.getClipBounds() };
             g.beginTransparencyLayer (getAlpha());
             paintComponentAndChildren (g, transparentOpaqueLayer, diagnostics);
             g.endTransparencyLayer();
@@ -2083,7 +2451,7 @@ void Component::paintEntireComponent (Graphics& g, bool ignoreAlphaLevel, Opaque
     }
     else if (isTransformed())
     {
-        OpaqueLayer transformedOpaqueLayer { this };
+        OpaqueLayer transformedOpaqueLayer { this, g.getClipBounds() };
         paintComponentAndChildren (g, transformedOpaqueLayer, diagnostics);
     }
     else
@@ -2099,6 +2467,10 @@ void Component::paintEntireComponent (Graphics& g, bool ignoreAlphaLevel, Opaque
 void Component::setPaintingIsUnclipped (bool shouldPaintWithoutClipping) noexcept
 {
     flags.dontClipGraphicsFlag = shouldPaintWithoutClipping;
+
+    if (parentComponent != nullptr)
+        if (auto* index = parentComponent->getChildIndex())
+            index->invalidate();
 }
 
 bool Component::isPaintingUnclipped() const noexcept
@@ -4257,11 +4629,547 @@ struct ComponentTests  : public UnitTest
             expectEquals (child.numPaintCalls, 2);
             expectEquals (child.numComponentPaintedCalls, 3);
         });
+
+        testCase ("Painting a component that is buffered to a display list only calls paint once", [&]
+        {
+            TestComponent parent;
+            TestComponent child;
+
+            const Rectangle<int> bounds { 0, 0, 100, 100 };
+            parent.setBounds (bounds);
+            child.setBounds (bounds.reduced (25));
+            child.setBufferedToDisplayList (true);
+            parent.addAndMakeVisible (child);
+
+            paintComponentBounds (parent);
+            paintComponentBounds (child);
+            paintComponentBounds (parent);
+
+            expectEquals (parent.numPaintCalls, 3);
+            expectEquals (child.numPaintCalls, 1);
+            expectEquals (child.numPaintOverChildrenCalls, 1);
+            expect (child.lastClipBounds == child.getLocalBounds());
+        });
+
+        testCase ("Repainting the child of a component buffered to a display list doesn't "
+                  "call the component's paint method again", [&]
+        {
+            TestComponent parent;
+            TestComponent child;
+
+            const Rectangle<int> bounds { 0, 0, 100, 100 };
+            parent.setBounds (bounds);
+            child.setBounds (bounds.reduced (25));
+            parent.setBufferedToDisplayList (true);
+            parent.addAndMakeVisible (child);
+
+            paintComponentBounds (parent);
+            child.repaint();
+            paintComponentBounds (child);
+            parent.repaint (10, 10, 20, 20);
+            paintComponentBounds (parent);
+
+            expectEquals (parent.numPaintCalls, 1);
+            expectEquals (child.numPaintCalls, 3);
+        });
+
+        testCase ("Calling repaint on a component buffered to a display list records it again", [&]
+        {
+            TestComponent component;
+            component.setBounds ({ 0, 0, 100, 100 });
+            component.setBufferedToDisplayList (true);
+
+            paintComponentBounds (component);
+            component.repaint();
+            paintComponentBounds (component);
+            paintComponentBounds (component);
+
+            expectEquals (component.numPaintCalls, 2);
+
+            component.setVisible (false);
+            component.repaint();
+            component.setVisible (true);
+            paintComponentBounds (component);
+
+            expectEquals (component.numPaintCalls, 3);
+
+            component.setBufferedToDisplayList (false);
+            paintComponentBounds (component);
+
+            expectEquals (component.numPaintCalls, 4);
+        });
+
+        testCase ("A component buffered to a display list draws the same pixels as one that isn't", [&]
+        {
+            DrawingComponent buffered, unbuffered;
+
+            for (auto* c : { &buffered, &unbuffered })
+                c->setBounds ({ 0, 0, 120, 80 });
+
+            buffered.setBufferedToDisplayList (true);
+
+            for (const auto scale : { 1.0f, 1.5f })
+            {
+                for (const auto& area : { Rectangle<int> { 0, 0, 120, 80 }, Rectangle<int> { 30, 20, 20, 10 } })
+                {
+                    const auto expected = unbuffered.createComponentSnapshot (area, true, scale);
+                    const auto actual = buffered.createComponentSnapshot (area, true, scale);
+
+                    expect (imagesMatch (expected, actual));
+                }
+            }
+
+            expectEquals (buffered.numPaintCalls, 2);
+        });
+
+        testCase ("Resizing a hidden component buffered to a display list records it again at the new size", [&]
+        {
+            Component parent;
+            DrawingComponent buffered, unbuffered;
+
+            parent.setBounds ({ 0, 0, 200, 200 });
+
+            for (auto* c : { &buffered, &unbuffered })
+            {
+                c->setBounds ({ 0, 0, 120, 80 });
+                parent.addAndMakeVisible (c);
+            }
+
+            buffered.setBufferedToDisplayList (true);
+            paintComponentBounds (buffered);
+
+            parent.setVisible (false);
+
+            for (auto* c : { &buffered, &unbuffered })
+                c->setBounds ({ 0, 0, 160, 100 });
+
+            parent.setVisible (true);
+
+            const auto expected = unbuffered.createComponentSnapshot (unbuffered.getLocalBounds());
+            const auto actual = buffered.createComponentSnapshot (buffered.getLocalBounds());
+
+            expect (imagesMatch (expected, actual));
+            expectEquals (buffered.numPaintCalls, 2);
+        });
+
+        testCase ("A component indexing its children finds the same components as one that isn't", [&]
+        {
+            Component parent;
+            OwnedArray<Component> children;
+            Random random { 1 };
+
+            parent.setBounds (0, 0, 300, 200);
+            parent.setVisible (true);
+
+            for (int i = 0; i < 200; ++i)
+            {
+                auto* child = children.add (new Component());
+                child->setBounds (random.nextInt (320) - 10, random.nextInt (220) - 10, random.nextInt (40), random.nextInt (40));
+                parent.addChildComponent (child);
+                child->setVisible (i % 7 != 0);
+            }
+
+            const auto expectSameResults = [&]
+            {
+                std::vector<Component*> expected;
+
+                parent.setIndexingChildBounds (false);
+
+                for (int y = -2; y < 202; y += 3)
+                    for (int x = -2; x < 302; x += 3)
+                        expected.push_back (parent.getComponentAt (Point { (float) x + 0.4f, (float) y - 0.4f }));
+
+                parent.setIndexingChildBounds (true);
+
+                auto iter = expected.begin();
+                int numMismatches = 0;
+
+                for (int y = -2; y < 202; y += 3)
+                    for (int x = -2; x < 302; x += 3)
+                        if (parent.getComponentAt (Point { (float) x + 0.4f, (float) y - 0.4f }) != *iter++)
+                            ++numMismatches;
+
+                expectEquals (numMismatches, 0);
+            };
+
+            parent.setIndexingChildBounds (true);
+            expectSameResults();
+
+            // Keep the index alive while the children change, so that it's updated rather than rebuilt
+            const auto changeChildren = [&] (auto&& change)
+            {
+                parent.setIndexingChildBounds (true);
+                expect (parent.getComponentAt (Point { 1.0f, 1.0f }) != nullptr);
+                change();
+                expectSameResults();
+            };
+
+            changeChildren ([&] { for (auto* c : children) c->setTopLeftPosition (c->getPosition() + Point { random.nextInt (21) - 10, random.nextInt (21) - 10 }); });
+            changeChildren ([&] { children[3]->toFront (false); children[150]->toBack(); });
+            changeChildren ([&] { children[10]->setTransform (AffineTransform::rotation (0.7f, 20.0f, 20.0f).scaled (2.0f)); });
+            changeChildren ([&] { parent.removeChildComponent (children[20]); parent.addAndMakeVisible (children[20], 5); });
+            changeChildren ([&] { parent.setSize (150, 120); });
+            changeChildren ([&] { for (auto* c : children) c->setSize (c->getHeight(), c->getWidth()); });
+        });
+
+        testCase ("A component indexing its children only paints the children in the repainted area", [&]
+        {
+            TestComponent parent;
+            OwnedArray<TestComponent> children;
+
+            parent.setBounds (0, 0, 400, 400);
+            parent.setIndexingChildBounds (true);
+
+            for (int i = 0; i < 400; ++i)
+            {
+                auto* child = children.add (new TestComponent());
+                child->setBounds ((i % 20) * 20, (i / 20) * 20, 20, 20);
+                child->setOpaque (i % 3 == 0);
+                parent.addAndMakeVisible (child);
+            }
+
+            auto* unclipped = children.add (new TestComponent());
+            unclipped->setBounds (300, 300, 10, 10);
+            unclipped->setPaintingIsUnclipped (true);
+            unclipped->setTransform (AffineTransform::translation (5.0f, 5.0f));
+            parent.addAndMakeVisible (unclipped);
+
+            const auto countPaintedChildren = [&]
+            {
+                int total = 0;
+
+                for (auto* c : children)
+                    total += std::exchange (c->numPaintCalls, 0);
+
+                return total;
+            };
+
+            paintComponentBounds (*children[42]);
+            expectEquals (countPaintedChildren(), 1);
+            expect (children[42]->lastClipBounds == children[42]->getLocalBounds());
+
+            parent.createComponentSnapshot ({ 30, 30, 20, 20 });
+            expectEquals (countPaintedChildren(), 4);
+
+            children[42]->setTopLeftPosition (365, 375);
+            parent.createComponentSnapshot ({ 360, 380, 20, 20 });
+            expectEquals (countPaintedChildren(), 2);
+
+            parent.createComponentSnapshot (parent.getLocalBounds());
+            expectEquals (countPaintedChildren(), 401);
+        });
+    }
+
+    struct DrawingComponent : public Component
+    {
+        void paint (Graphics& g) override
+        {
+            ++numPaintCalls;
+
+            g.fillAll (Colours::darkslategrey);
+            g.setColour (Colours::orange);
+            g.drawRoundedRectangle (getLocalBounds().toFloat().reduced (4.0f), 6.0f, 2.0f);
+            g.fillEllipse (20.0f, 20.0f, 30.0f, 30.0f);
+            g.setColour (Colours::white);
+            g.setFont (FontOptions { 13.0f });
+            g.drawText ("Channel", getLocalBounds().removeFromBottom (20), Justification::centred);
+        }
+
+        void paintOverChildren (Graphics& g) override
+        {
+            g.setColour (Colours::red.withAlpha (0.5f));
+            g.drawLine (0.0f, 0.0f, (float) getWidth(), (float) getHeight(), 3.0f);
+        }
+
+        int numPaintCalls = 0;
+    };
+
+    static bool imagesMatch (const Image& a, const Image& b)
+    {
+        if (a.getBounds() != b.getBounds())
+            return false;
+
+        for (int y = 0; y < a.getHeight(); ++y)
+            for (int x = 0; x < a.getWidth(); ++x)
+                if (a.getPixelAt (x, y) != b.getPixelAt (x, y))
+                    return false;
+
+        return true;
     }
 };
 
 static ComponentTests componentTests;
 
+//==============================================================================
+class ComponentDisplayListBenchmarks final : public UnitTest
+{
+public:
+    ComponentDisplayListBenchmarks()
+        : UnitTest ("Component display list benchmarks", UnitTestCategories::benchmarks)
+    {}
+
+    void runTest() override
+    {
+        ScopedJuceInitialiser_GUI libraryInitialiser;
+
+        beginTest ("Mixer with changing meters");
+        {
+            Mixer mixer;
+            Image image (Image::RGB, mixer.getWidth(), mixer.getHeight(), true, SoftwareImageType{});
+
+            // Each frame moves every meter, and redraws just the areas that they cover,
+            // as a peer would after the meters have called repaint()
+            const auto drawFrames = [&]
+            {
+                const auto start = Time::getMillisecondCounterHiRes();
+                Random random { 1 };
+
+                for (int frame = 0; frame < numFrames; ++frame)
+                {
+                    RectangleList<int> dirty;
+
+                    for (auto* strip : mixer.strips)
+                    {
+                        strip->meter.level = random.nextFloat();
+                        dirty.add (mixer.getLocalArea (&strip->meter, strip->meter.getLocalBounds()));
+                    }
+
+                    LowLevelGraphicsSoftwareRenderer context (image, {}, dirty);
+                    Graphics g (context);
+                    mixer.paintEntireComponent (g, true);
+                }
+
+                return (Time::getMillisecondCounterHiRes() - start) * 1000.0 / numFrames;
+            };
+
+            const auto direct = drawFrames();
+            const auto directStripPaints = mixer.getNumStripPaints();
+
+            for (auto* strip : mixer.strips)
+                strip->setBufferedToDisplayList (true);
+
+            const auto buffered = drawFrames();
+            const auto bufferedStripPaints = mixer.getNumStripPaints() - directStripPaints;
+
+            logMessage ("Meter frames: " + String (direct, 1) + "us with paint(), "
+                        + String (buffered, 1) + "us replaying display lists ("
+                        + String (directStripPaints) + " vs " + String (bufferedStripPaints) + " strip paints)");
+
+            expectEquals (bufferedStripPaints, numStrips);
+        }
+    }
+
+private:
+    static constexpr auto numStrips = 32;
+    static constexpr auto numFrames = 200;
+
+    struct Meter final : public Component
+    {
+        void paint (Graphics& g) override
+        {
+            auto area = getLocalBounds().toFloat();
+            g.setColour (Colours::black);
+            g.fillRect (area);
+            g.setGradientFill (ColourGradient::vertical (Colours::red, area.getY(), Colours::green, area.getBottom()));
+            g.fillRect (area.removeFromBottom (area.getHeight() * level));
+        }
+
+        float level = 0.0f;
+    };
+
+    // A channel strip which does the sort of work that makes a real one slow to paint:
+    // gradients, text, and paths for a scale and a knob
+    struct Strip final : public Component
+    {
+        explicit Strip (int index)
+            : Component ("Channel " + String (index + 1))
+        {
+            addAndMakeVisible (meter);
+        }
+
+        void resized() override
+        {
+            meter.setBounds (getLocalBounds().reduced (30, 60).withTrimmedTop (40));
+        }
+
+        void paint (Graphics& g) override
+        {
+            ++numPaints;
+
+            auto area = getLocalBounds().toFloat();
+            g.setGradientFill (ColourGradient::vertical (Colour (0xff3a3f44), 0.0f, Colour (0xff1c1f22), area.getBottom()));
+            g.fillRoundedRectangle (area.reduced (1.0f), 4.0f);
+
+            g.setFont (FontOptions { 11.0f });
+
+            const StringArray labels { "Gain", "High", "Mid", "Low" };
+
+            for (const auto [index, label] : enumerate (labels))
+            {
+                const auto centre = Point { area.getCentreX(), 20.0f + (float) index * 22.0f };
+                Path knob;
+                knob.addCentredArc (centre.x + (index % 2 == 0 ? -18.0f : 18.0f), centre.y, 9.0f, 9.0f, 0.0f,
+                                    -MathConstants<float>::pi * 0.75f, MathConstants<float>::pi * 0.75f, true);
+                g.setColour (Colours::lightblue);
+                g.strokePath (knob, PathStrokeType (2.5f, PathStrokeType::curved, PathStrokeType::rounded));
+                g.setColour (Colours::lightgrey);
+                g.drawText (label, Rectangle<float> (46.0f, 18.0f).withCentre (centre.translated (index % 2 == 0 ? 18.0f : -18.0f, 0.0f)),
+                            Justification::centred);
+            }
+
+            g.setColour (Colours::lightgrey);
+
+            const auto scale = meter.getBounds().toFloat();
+
+            for (int db = 0; db <= 60; db += 6)
+            {
+                const auto y = scale.getY() + scale.getHeight() * (float) db / 60.0f;
+                g.drawHorizontalLine ((int) y, scale.getRight() + 2.0f, scale.getRight() + 8.0f);
+                g.drawText (String (-db), Rectangle<float> (scale.getRight() + 9.0f, y - 6.0f, 20.0f, 12.0f),
+                            Justification::centredLeft);
+            }
+
+            g.drawText (getName(), area.removeFromBottom (24.0f), Justification::centred);
+        }
+
+        Meter meter;
+        int numPaints = 0;
+    };
+
+    struct Mixer final : public Component
+    {
+        Mixer()
+        {
+            for (int i = 0; i < numStrips; ++i)
+                addAndMakeVisible (strips.add (new Strip (i)));
+
+            setBounds (0, 0, numStrips * 90, 400);
+        }
+
+        void resized() override
+        {
+            for (auto* strip : strips)
+                strip->setBounds (strips.indexOf (strip) * 90, 0, 90, getHeight());
+        }
+
+        int getNumStripPaints() const
+        {
+            int total = 0;
+
+            for (auto* strip : strips)
+                total += strip->numPaints;
+
+            return total;
+        }
+
+        OwnedArray<Strip> strips;
+    };
+};
+
+static ComponentDisplayListBenchmarks componentDisplayListBenchmarks;
+
+//==============================================================================
+class ComponentChildIndexBenchmarks final : public UnitTest
+{
+public:
+    ComponentChildIndexBenchmarks()
+        : UnitTest ("Component child index benchmarks", UnitTestCategories::benchmarks)
+    {}
+
+    void runTest() override
+    {
+        ScopedJuceInitialiser_GUI libraryInitialiser;
+
+        beginTest ("Step-sequencer grid");
+        {
+            Grid grid;
+            Image image (Image::RGB, grid.getWidth(), grid.getHeight(), true, SoftwareImageType{});
+
+            const auto findCells = [&]
+            {
+                const auto start = Time::getMillisecondCounterHiRes();
+                Random random { 1 };
+                int numFound = 0;
+
+                for (int i = 0; i < numPoints; ++i)
+                    if (grid.getComponentAt (Point { random.nextFloat(), random.nextFloat() } * (float) grid.getWidth()) != &grid)
+                        ++numFound;
+
+                expectEquals (numFound, numPoints);
+                return (Time::getMillisecondCounterHiRes() - start) * 1000.0 / numPoints;
+            };
+
+            // Each frame redraws a single cell, as a peer would after it has called repaint()
+            const auto drawFrames = [&]
+            {
+                const auto start = Time::getMillisecondCounterHiRes();
+                Random random { 1 };
+
+                for (int frame = 0; frame < numFrames; ++frame)
+                {
+                    auto* cell = grid.getChildComponent (random.nextInt (grid.getNumChildComponents()));
+                    LowLevelGraphicsSoftwareRenderer context (image, {}, { cell->getBounds() });
+                    Graphics g (context);
+                    grid.paintEntireComponent (g, true);
+                }
+
+                return (Time::getMillisecondCounterHiRes() - start) * 1000.0 / numFrames;
+            };
+
+            const auto linearHitTest = findCells();
+            const auto linearPaint = drawFrames();
+
+            grid.setIndexingChildBounds (true);
+
+            const auto indexedHitTest = findCells();
+            const auto indexedPaint = drawFrames();
+
+            logMessage ("getComponentAt: " + String (linearHitTest, 2) + "us searching all children, "
+                        + String (indexedHitTest, 2) + "us with an index");
+            logMessage ("Redrawing one cell: " + String (linearPaint, 1) + "us searching all children, "
+                        + String (indexedPaint, 1) + "us with an index");
+        }
+    }
+
+private:
+    static constexpr auto numColumns = 64;
+    static constexpr auto numRows = 64;
+    static constexpr auto cellSize = 16;
+    static constexpr auto numPoints = 20000;
+    static constexpr auto numFrames = 2000;
+
+    struct Cell final : public Component
+    {
+        void paint (Graphics& g) override
+        {
+            g.setColour (Colours::darkgrey);
+            g.fillRect (getLocalBounds().reduced (1));
+        }
+    };
+
+    struct Grid final : public Component
+    {
+        Grid()
+        {
+            for (int i = 0; i < numColumns * numRows; ++i)
+                addAndMakeVisible (cells.add (new Cell()));
+
+            setBounds (0, 0, numColumns * cellSize, numRows * cellSize);
+            setVisible (true);
+        }
+
+        void resized() override
+        {
+            for (const auto [index, cell] : enumerate (cells, int{}))
+                cell->setBounds ((index % numColumns) * cellSize, (index / numColumns) * cellSize, cellSize, cellSize);
+        }
+
+        OwnedArray<Cell> cells;
+    };
+};
+
+static ComponentChildIndexBenchmarks componentChildIndexBenchmarks;
+
 #endif
 
 } // namespace juce
@@ -1080,6 +1080,33 @@ public:
     */
     Component* getComponentAt (Point<float> position);
 
+    /** Makes this component keep an index of where its children are, so that it can
+        quickly find the ones at a particular position.
+
+        Normally, finding the child under the mouse, or working out which children
+        need to be painted when part of a component is redrawn, means checking each
+        child in turn. That's fine for a few dozen, but for something like a
+        step-sequencer grid made of thousands of buttons it can take a noticeable
+        amount of time on every mouse-move. With this enabled, the component keeps a
+        grid of its children's bounds which is updated as they move, and uses it in
+        getComponentAt(), hitTest() and when painting, so that only the children near
+        a position or inside the area being redrawn are looked at.
+
+        Keeping the index up to date costs a little each time a child is moved, and it
+        has to be rebuilt after children are added, removed or reordered, so it's only
+        worth using for components with a large number of children. Children which lie
+        outside the area being redrawn won't receive a ComponentListener::componentPainted()
+        callback.
+
+        @see getComponentAt, isIndexingChildBounds
+    */
+    void setIndexingChildBounds (bool shouldIndexChildBounds);
+
+    /** Returns true if setIndexingChildBounds() has been used to make this component
+        keep an index of its children's positions.
+    */
+    bool isIndexingChildBounds() const noexcept;
+
     //==============================================================================
     /** Marks the whole component as needing to be redrawn.
 
@@ -1092,6 +1119,8 @@ public:
         If the setBufferedToImage() method has been used to cause this component to use a
         buffer, the repaint() call will invalidate the cached buffer. If setCachedComponentImage()
         has been used to provide a custom image cache, that cache will be invalidated appropriately.
+        If setBufferedToDisplayList() has been used, the component's recorded drawing will be
+        discarded, and its paint() method will be called again.
 
         To redraw just a subsection of the component rather than the whole thing,
         use the repaint (int, int, int, int) method.
@@ -1145,6 +1174,28 @@ public:
     */
     void setBufferedToImage (bool shouldBeBuffered);
 
+    /** Makes the component record what it draws, and play that back rather than calling
+        its paint() method each time it needs to be redrawn.
+
+        When this is enabled, the first time the component is drawn the operations that
+        its paint() and paintOverChildren() methods perform are recorded in a DisplayList,
+        and each redraw after that just replays them, leaving out any that fall outside
+        the area being redrawn. Unlike setBufferedToImage(), this uses very little memory,
+        stays sharp at any scale, and doesn't include the component's children, which are
+        painted as usual - so it's a good fit for a component with an expensive paint()
+        method whose children change often, like a mixer channel strip containing level
+        meters that are redrawn many times a second.
+
+        The recording is only thrown away and made again when repaint() is called without
+        any arguments, or the display's scale changes. Repainting part of the component,
+        whether by calling repaint (area) or because a child component has been
+        repainted, redraws that area from the existing recording, so if the component's
+        appearance has changed you must call repaint() to redraw all of it.
+
+        @see repaint, paint, DisplayList
+    */
+    void setBufferedToDisplayList (bool shouldBeBuffered);
+
     /** Generates a snapshot of part of this component.
 
         This will return a new Image of type imageType, the size of the rectangle specified,
@@ -2669,6 +2720,8 @@ private:
     WeakReference<Component>::Master masterReference;
 
     class EffectState;
+    class DisplayListState;
+    class ChildIndex;
     class MouseListenerList;
     class Data;
     std::unique_ptr<Data> componentData;
@@ -2748,6 +2801,7 @@ private:
     void sendEnablementChangeMessage();
     void sendVisibilityChangeMessage();
     Data& createDataIfNeeded();
+    ChildIndex* getChildIndex() const noexcept;
     const Array<KeyListener*>* getKeyListeners() const;
 
     /* Components aren't allowed to have copy constructors, as this would mess up parent hierarchies.
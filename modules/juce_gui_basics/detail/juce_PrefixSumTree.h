@@ -0,0 +1,155 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::detail
+{
+
+/*  Keeps running totals of a list of non-negative values, such as the heights of the rows
+    in a list, so that the position of any item can be found, an item can be found from a
+    position, and a value can be changed, all in O(log n) time.
+
+    This is a Fenwick tree: each node holds the sum of a power-of-two sized block of values
+    that ends at that node's index.
+*/
+class PrefixSumTree
+{
+public:
+    PrefixSumTree() = default;
+
+    /*  Replaces the contents with the values returned by getValue for each index in the
+        range [0, newSize), in O(n) time.
+    */
+    template <typename Fn>
+    void assign (int newSize, Fn&& getValue)
+    {
+        values.resize ((size_t) newSize);
+        nodes.assign ((size_t) newSize + 1, 0);
+
+        for (int i = 0; i < newSize; ++i)
+        {
+            const auto value = getValue (i);
+            jassert (value >= 0);
+            values[(size_t) i] = value;
+            nodes[(size_t) i + 1] += value;
+
+            if (const auto parent = (i + 1) + lowestBit (i + 1); parent <= newSize)
+                nodes[(size_t) parent] += nodes[(size_t) i + 1];
+        }
+
+        total = newSize > 0 ? getSumBefore (newSize) : 0;
+    }
+
+    void clear()
+    {
+        values.clear();
+        nodes.clear();
+        total = 0;
+    }
+
+    int size() const noexcept                   { return (int) values.size(); }
+    int get (int index) const noexcept          { return values[(size_t) index]; }
+    int getTotal() const noexcept               { return total; }
+
+    void set (int index, int newValue) noexcept
+    {
+        jassert (isPositiveAndBelow (index, size()) && newValue >= 0);
+
+        const auto delta = newValue - std::exchange (values[(size_t) index], newValue);
+
+        if (delta == 0)
+            return;
+
+        total += delta;
+
+        for (auto i = index + 1; i <= size(); i += lowestBit (i))
+            nodes[(size_t) i] += delta;
+    }
+
+    /*  Returns the sum of the values before the given index. */
+    int getSumBefore (int index) const noexcept
+    {
+        jassert (index >= 0 && index <= size());
+
+        int sum = 0;
+
+        for (auto i = index; i > 0; i -= lowestBit (i))
+            sum += nodes[(size_t) i];
+
+        return sum;
+    }
+
+    /*  Returns the index of the item whose span contains the given position, i.e. the index
+        for which getSumBefore (index) <= position < getSumBefore (index + 1). Items with a
+        value of zero are never returned. Returns size() if the position is beyond the total,
+        and -1 if it's negative.
+    */
+    int findIndexContaining (int position) const noexcept
+    {
+        if (position < 0)
+            return -1;
+
+        int index = 0;
+
+        for (auto step = highestBit (size()); step > 0; step >>= 1)
+        {
+            const auto next = index + step;
+
+            if (next <= size() && nodes[(size_t) next] <= position)
+            {
+                index = next;
+                position -= nodes[(size_t) next];
+            }
+        }
+
+        return index;
+    }
+
+private:
+    static int lowestBit (int n) noexcept   { return n & -n; }
+
+    static int highestBit (int n) noexcept
+    {
+        int bit = 1;
+
+        while (bit <= n / 2)
+            bit <<= 1;
+
+        return n > 0 ? bit : 0;
+    }
+
+    std::vector<int> values, nodes;
+    int total = 0;
+};
+
+} // namespace juce::detail
@@ -183,6 +183,7 @@ namespace juce
         class MouseInputSourceImpl;
         class MouseInputSourceList;
         class PointerState;
+        class PrefixSumTree;
         class ScopedMessageBoxImpl;
         class ToolbarItemDragAndDropOverlayComponent;
         class TopLevelWindowManager;
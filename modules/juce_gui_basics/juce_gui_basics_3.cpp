@@ -46,6 +46,7 @@
 #include "detail/juce_ViewportHelpers.h"
 #include "detail/juce_ToolbarItemDragAndDropOverlayComponent.h"
 #include "detail/juce_ButtonAccessibilityHandler.h"
+#include "detail/juce_PrefixSumTree.h"
 
 #include "widgets/juce_ComboBox.cpp"
 #include "widgets/juce_ImageComponent.cpp"
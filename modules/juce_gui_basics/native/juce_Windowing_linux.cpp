@@ -35,6 +35,65 @@
 namespace juce
 {
 
+namespace LinuxRepaintHelpers
+{
+    /*  Combines rectangles whose union costs no more to paint and send than the rectangles do
+        separately, where each rectangle costs its area plus a fixed overhead.
+    */
+    static RectangleList<int> mergeRectangles (const RectangleList<int>& source, int costPerRectangle)
+    {
+        const auto cost = [&] (Rectangle<int> r) { return (int64) r.getWidth() * r.getHeight() + costPerRectangle; };
+
+        std::vector<Rectangle<int>> rects (source.begin(), source.end());
+
+        // Comparing every pair gets expensive for very fragmented regions, so these are only
+        // combined if a single rectangle would be cheaper overall.
+        constexpr size_t maxRectanglesToCompare = 32;
+
+        if (rects.size() > maxRectanglesToCompare)
+        {
+            int64 total = 0;
+
+            for (auto& r : rects)
+                total += cost (r);
+
+            if (cost (source.getBounds()) <= total)
+                return source.getBounds();
+
+            return source;
+        }
+
+        for (auto merged = true; merged;)
+        {
+            merged = false;
+
+            for (size_t i = 0; i < rects.size() && ! merged; ++i)
+            {
+                for (size_t j = i + 1; j < rects.size(); ++j)
+                {
+                    const auto combined = rects[i].getUnion (rects[j]);
+
+                    if (cost (combined) <= cost (rects[i]) + cost (rects[j]))
+                    {
+                        rects[i] = combined;
+                        rects.erase (rects.begin() + (ptrdiff_t) j);
+                        merged = true;
+                        break;
+                    }
+                }
+            }
+        }
+
+        RectangleList<int> result;
+
+        for (auto& r : rects)
+            result.add (r);
+
+        return result;
+    }
+}
+
+//==============================================================================
 class LinuxComponentPeer final : public ComponentPeer,
                                  private XWindowSystemUtilities::XSettings::Listener
 {
@@ -477,38 +536,57 @@ private:
         {
             XWindowSystem::getInstance()->processPendingPaintsForWindow (peer.windowH);
 
-            if (XWindowSystem::getInstance()->getNumPaintsPendingForWindow (peer.windowH) > 0)
+            if (getFreeBuffer() == nullptr)
                 return;
 
             if (! regionsNeedingRepaint.isEmpty())
                 performAnyPendingRepaintsNow();
-            else if (Time::getApproximateMillisecondCounter() > lastTimeImageUsed + 3000)
-                image = Image();
+            else if (Time::getApproximateMillisecondCounter() > lastTimeImageUsed + 3000
+                     && XWindowSystem::getInstance()->getNumPaintsPendingForWindow (peer.windowH) == 0)
+                for (auto& buffer : buffers)
+                    buffer.image = Image();
         }
 
         void repaint (Rectangle<int> area)
         {
+            if (regionsNeedingRepaint.isEmpty())
+                firstRepaintTime = Time::getMillisecondCounterHiRes();
+
             regionsNeedingRepaint.add (area * peer.getPlatformScaleFactor());
         }
 
         void performAnyPendingRepaintsNow()
         {
-            if (XWindowSystem::getInstance()->getNumPaintsPendingForWindow (peer.windowH) > 0)
+            // If the server is still reading both buffers, painting waits for the next
+            // vblank callback rather than blocking until one of them is free.
+            auto* buffer = getFreeBuffer();
+
+            if (buffer == nullptr)
+            {
+               #if JUCE_LINUX_REPAINT_METRICS
+                ++metrics.numDeferredFrames;
+               #endif
+
                 return;
+            }
 
-            auto originalRepaintRegion = regionsNeedingRepaint;
+            const auto regions = LinuxRepaintHelpers::mergeRectangles (regionsNeedingRepaint, costPerRectangle);
             regionsNeedingRepaint.clear();
-            auto totalArea = originalRepaintRegion.getBounds();
+            const auto totalArea = regions.getBounds();
 
             if (! totalArea.isEmpty())
             {
-                const auto wasImageNull = image.isNull();
+                auto& image = buffer->image;
+                const auto wasImageNull = std::all_of (buffers.begin(), buffers.end(), [] (auto& b) { return b.image.isNull(); });
 
-                if (wasImageNull || image.getWidth() < totalArea.getWidth()
-                     || image.getHeight() < totalArea.getHeight())
+                // The buffers cover the window from its origin, so they only need to be
+                // replaced when the window grows.
+                if (image.isNull() || image.getWidth() < totalArea.getRight()
+                     || image.getHeight() < totalArea.getBottom())
                 {
                     image = XWindowSystem::getInstance()->createImage (isSemiTransparentWindow,
-                                                                       totalArea.getWidth(), totalArea.getHeight(),
+                                                                       jmax (totalArea.getRight(), image.getWidth()),
+                                                                       jmax (totalArea.getBottom(), image.getHeight()),
                                                                        useARGBImagesForRendering);
                     if (wasImageNull)
                     {
@@ -530,33 +608,106 @@ private:
                     }
                 }
 
-                RectangleList<int> adjustedList (originalRepaintRegion);
-                adjustedList.offsetAll (-totalArea.getX(), -totalArea.getY());
-
                 if (XWindowSystem::getInstance()->canUseARGBImages())
-                    for (auto& i : originalRepaintRegion)
-                        image.clear (i - totalArea.getPosition());
+                    for (auto& i : regions)
+                        image.clear (i);
 
                 {
                     auto context = peer.getComponent().getLookAndFeel()
-                                     .createGraphicsContext (image, -totalArea.getPosition(), adjustedList);
+                                     .createGraphicsContext (image, {}, regions);
 
                     context->addTransform (AffineTransform::scale ((float) peer.getPlatformScaleFactor()));
                     peer.handlePaint (*context);
                 }
 
-                for (auto& i : originalRepaintRegion)
-                   XWindowSystem::getInstance()->blitToWindow (peer.windowH, image, i, totalArea);
+                auto* windowSystem = XWindowSystem::getInstance();
+                const auto numPendingBeforeBlit = windowSystem->getNumPaintsPendingForWindow (peer.windowH);
+                const auto* last = regions.end() - 1;
+
+                for (auto& i : regions)
+                    windowSystem->blitToWindow (peer.windowH, image, i, {}, &i == last);
+
+                // Only shared-memory images ask to be notified, so a buffer is free again once
+                // the number of completed blits reaches this mark.
+                numBlitsNeedingCompletion += windowSystem->getNumPaintsPendingForWindow (peer.windowH) - numPendingBeforeBlit;
+                buffer->completionMark = numBlitsNeedingCompletion;
+
+               #if JUCE_LINUX_REPAINT_METRICS
+                metrics.addFrame (Time::getMillisecondCounterHiRes() - firstRepaintTime, regions,
+                                  Image::BitmapData (image, Image::BitmapData::readOnly).pixelStride);
+               #endif
             }
 
             lastTimeImageUsed = Time::getApproximateMillisecondCounter();
         }
 
     private:
+        struct BackBuffer
+        {
+            Image image;
+            int64 completionMark = 0;
+        };
+
+        BackBuffer* getFreeBuffer()
+        {
+            const auto numPending = XWindowSystem::getInstance()->getNumPaintsPendingForWindow (peer.windowH);
+            const auto numCompleted = numBlitsNeedingCompletion - numPending;
+
+            for (auto& buffer : buffers)
+                if (buffer.completionMark <= numCompleted)
+                    return &buffer;
+
+            return nullptr;
+        }
+
+        // Sending another rectangle to the server and clipping the paint to it has a fixed cost,
+        // which is roughly the same as pushing this many extra pixels. Rectangles are combined
+        // whenever the area that merging them adds costs less than that.
+        static constexpr int costPerRectangle = 64 * 64;
+
+       #if JUCE_LINUX_REPAINT_METRICS
+        // Define JUCE_LINUX_REPAINT_METRICS=1 to log the time from the first repaint() of each
+        // frame to the frame being sent to the server, and how much data each frame sends.
+        struct Metrics
+        {
+            void addFrame (double latencyMs, const RectangleList<int>& regions, int bytesPerPixel)
+            {
+                int64 numPixels = 0;
+
+                for (auto& r : regions)
+                    numPixels += (int64) r.getWidth() * r.getHeight();
+
+                latency.addValue (latencyMs);
+                kilobytesPushed.addValue ((double) (numPixels * bytesPerPixel) / 1024.0);
+                rectangles.addValue ((double) regions.getNumRectangles());
+
+                const auto now = Time::getMillisecondCounterHiRes();
+
+                if (now > lastReportTime + 5000.0)
+                {
+                    DBG ("Repaints: " << latency.getCount() << " frames, " << numDeferredFrames << " deferred"
+                         << ", latency " << String (latency.getAverage(), 2) << "ms (max " << String (latency.getMaxValue(), 2) << "ms)"
+                         << ", " << String (kilobytesPushed.getAverage(), 1) << "KB pushed per frame (max " << String (kilobytesPushed.getMaxValue(), 1) << "KB)"
+                         << ", " << String (rectangles.getAverage(), 1) << " rectangles per frame");
+
+                    *this = {};
+                }
+            }
+
+            StatisticsAccumulator<double> latency, kilobytesPushed, rectangles;
+            int numDeferredFrames = 0;
+            double lastReportTime = Time::getMillisecondCounterHiRes();
+        };
+
+        Metrics metrics;
+       #endif
+
         LinuxComponentPeer& peer;
         const bool isSemiTransparentWindow;
-        Image image;
+        std::array<BackBuffer, 2> buffers;
+        int64 numBlitsNeedingCompletion = 0;
         uint32 lastTimeImageUsed = 0;
+        double firstRepaintTime = 0.0;
         RectangleList<int> regionsNeedingRepaint;
 
         bool useARGBImagesForRendering = XWindowSystem::getInstance()->canUseARGBImages();
@@ -936,4 +1087,82 @@ void juce_LinuxRemoveRepaintListener (ComponentPeer* peer, Component* dummy)
         linuxPeer->removeOpenGLRepaintListener (dummy);
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class LinuxRepaintHelpersTests final : public UnitTest
+{
+public:
+    LinuxRepaintHelpersTests()  : UnitTest ("LinuxRepaintHelpers", UnitTestCategories::gui)  {}
+
+    void runTest() override
+    {
+        constexpr int cost = 64 * 64;
+
+        const auto covers = [] (const RectangleList<int>& merged, const RectangleList<int>& source)
+        {
+            return std::all_of (source.begin(), source.end(), [&] (auto& r) { return merged.containsRectangle (r); });
+        };
+
+        beginTest ("Nearby small rectangles are merged");
+        {
+            RectangleList<int> source;
+            source.add ({ 10, 10, 8, 8 });
+            source.add ({ 30, 12, 8, 8 });
+            source.add ({ 14, 40, 8, 8 });
+
+            const auto merged = LinuxRepaintHelpers::mergeRectangles (source, cost);
+            expectEquals (merged.getNumRectangles(), 1);
+            expect (merged.getBounds() == source.getBounds());
+        }
+
+        beginTest ("Distant or large rectangles are kept separate");
+        {
+            RectangleList<int> source;
+            source.add ({ 0, 0, 10, 10 });
+            source.add ({ 900, 700, 10, 10 });
+            source.add ({ 0, 300, 400, 100 });
+
+            const auto merged = LinuxRepaintHelpers::mergeRectangles (source, cost);
+            expectEquals (merged.getNumRectangles(), 3);
+            expect (covers (merged, source));
+        }
+
+        beginTest ("Merged rectangles don't overlap");
+        {
+            RectangleList<int> source;
+            source.add ({ 0, 0, 50, 10 });
+            source.add ({ 60, 0, 10, 10 });
+            source.add ({ 0, 200, 300, 60 });
+            source.add ({ 40, 240, 10, 200 });
+
+            const auto merged = LinuxRepaintHelpers::mergeRectangles (source, cost);
+            expect (covers (merged, source));
+
+            for (auto* a = merged.begin(); a != merged.end(); ++a)
+                for (auto* b = a + 1; b != merged.end(); ++b)
+                    expect (! a->intersects (*b));
+        }
+
+        beginTest ("Very fragmented regions");
+        {
+            RectangleList<int> dense, sparse;
+
+            for (int i = 0; i < 100; ++i)
+            {
+                dense.add ({ (i % 10) * 12, (i / 10) * 12, 10, 10 });
+                sparse.add ({ (i % 10) * 300, (i / 10) * 300, 10, 10 });
+            }
+
+            expectEquals (LinuxRepaintHelpers::mergeRectangles (dense, cost).getNumRectangles(), 1);
+            expectEquals (LinuxRepaintHelpers::mergeRectangles (sparse, cost).getNumRectangles(), 100);
+        }
+    }
+};
+
+static LinuxRepaintHelpersTests linuxRepaintHelpersTests;
+
+#endif
+
 } // namespace juce
@@ -1022,12 +1022,12 @@ public:
 
     std::unique_ptr<ImageType> createType() const override     { return std::make_unique<NativeImageType>(); }
 
-    void blitToWindow (::Window window, int dx, int dy, unsigned int dw, unsigned int dh, int sx, int sy)
+    void blitToWindow (::Window window, int dx, int dy, unsigned int dw, unsigned int dh, int sx, int sy, bool notifyOnCompletion)
     {
         XWindowSystemUtilities::ScopedXLock xLock;
 
        #if JUCE_USE_XSHM
-        if (isUsingXShm())
+        if (isUsingXShm() && notifyOnCompletion)
             XWindowSystem::getInstance()->addPendingPaintForWindow (window);
        #endif
 
@@ -1080,7 +1080,8 @@ public:
         // blit results to screen
        #if JUCE_USE_XSHM
         if (isUsingXShm())
-            X11Symbols::getInstance()->xShmPutImage (display, (::Drawable) window, gc, xImage.get(), sx, sy, dx, dy, dw, dh, True);
+            X11Symbols::getInstance()->xShmPutImage (display, (::Drawable) window, gc, xImage.get(), sx, sy, dx, dy, dw, dh,
+                                                     notifyOnCompletion ? True : False);
         else
        #endif
             X11Symbols::getInstance()->xPutImage (display, (::Drawable) window, gc, xImage.get(), sx, sy, dx, dy, dw, dh);
@@ -2209,7 +2210,8 @@ Image XWindowSystem::createImage (bool isSemiTransparent, int width, int height,
                                     false, (unsigned int) visualAndDepth.depth, visualAndDepth.visual));
 }
 
-void XWindowSystem::blitToWindow (::Window windowH, Image image, Rectangle<int> destinationRect, Rectangle<int> totalRect) const
+void XWindowSystem::blitToWindow (::Window windowH, Image image, Rectangle<int> destinationRect,
+                                  Rectangle<int> totalRect, bool notifyOnCompletion) const
 {
     jassert (windowH != 0);
 
@@ -2219,7 +2221,8 @@ void XWindowSystem::blitToWindow (::Window windowH, Image image, Rectangle<int>
                            destinationRect.getX(), destinationRect.getY(),
                            (unsigned int) destinationRect.getWidth(),
                            (unsigned int) destinationRect.getHeight(),
-                           destinationRect.getX() - totalRect.getX(), destinationRect.getY() - totalRect.getY());
+                           destinationRect.getX() - totalRect.getX(), destinationRect.getY() - totalRect.getY(),
+                           notifyOnCompletion);
 }
 
 void XWindowSystem::processPendingPaintsForWindow (::Window windowH)
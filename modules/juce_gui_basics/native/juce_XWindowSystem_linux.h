@@ -217,7 +217,13 @@ public:
     void removePendingPaintForWindow (::Window);
 
     Image createImage (bool isSemiTransparentWindow, int width, int height, bool argb) const;
-    void blitToWindow (::Window, Image, Rectangle<int> destinationRect, Rectangle<int> totalRect) const;
+
+    /*  When the image uses shared memory, notifyOnCompletion adds a pending paint that's removed
+        once the server has finished reading the image. Blits complete in order, so only the last
+        of a batch needs to ask for a notification.
+    */
+    void blitToWindow (::Window, Image, Rectangle<int> destinationRect, Rectangle<int> totalRect,
+                       bool notifyOnCompletion = true) const;
 
     void setScreenSaverEnabled (bool enabled) const;
 
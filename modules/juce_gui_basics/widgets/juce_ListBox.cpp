@@ -371,7 +371,7 @@ public:
         auto newX = content.getX();
         auto newY = content.getY();
         auto newW = jmax (owner.minimumRowWidth, getMaximumVisibleWidth());
-        auto newH = owner.totalItems * owner.getRowHeight();
+        auto newH = owner.getRowTop (owner.totalItems);
 
         if (newY + newH < getMaximumVisibleHeight() && newH > getMaximumVisibleHeight())
             newY = getMaximumVisibleHeight() - newH;
@@ -392,8 +392,14 @@ public:
         {
             auto y = getViewPositionY();
             auto w = content.getWidth();
+            auto visibleH = getMaximumVisibleHeight();
 
-            const auto numNeeded = (size_t) (4 + getMaximumVisibleHeight() / rowH);
+            firstIndex = owner.getRowAtContentY (y);
+            firstWholeIndex = firstIndex + (owner.getRowTop (firstIndex) < y ? 1 : 0);
+            lastWholeIndex = owner.getRowAtContentY (y + visibleH - 1);
+
+            const auto numNeeded = (size_t) (owner.hasVariableRowHeights() ? 4 + lastWholeIndex - firstIndex
+                                                                           : 4 + visibleH / rowH);
             rows.resize (jmin (numNeeded, rows.size()));
 
             while (numNeeded > rows.size())
@@ -402,10 +408,6 @@ public:
                 content.addAndMakeVisible (*rows.back());
             }
 
-            firstIndex = y / rowH;
-            firstWholeIndex = (y + rowH - 1) / rowH;
-            lastWholeIndex = (y + getMaximumVisibleHeight() - 1) / rowH;
-
             const auto startIndex = getIndexOfFirstVisibleRow();
             const auto lastIndex = startIndex + (int) rows.size();
 
@@ -413,7 +415,7 @@ public:
             {
                 if (auto* rowComp = getComponentForRowIfOnscreen (row))
                 {
-                    rowComp->setBounds (0, row * rowH, w, rowH);
+                    rowComp->setBounds (0, owner.getRowTop (row), w, owner.getHeightOfRow (row));
                     rowComp->update (row, owner.isRowSelected (row));
                 }
                 else
@@ -431,14 +433,14 @@ public:
                                               owner.headerComponent->getHeight());
     }
 
-    void selectRow (const int row, const int rowH, const bool dontScroll,
+    void selectRow (const int row, const bool dontScroll,
                     const int lastSelectedRow, const int totalRows, const bool isMouseClick)
     {
         hasUpdated = false;
 
         if (row < firstWholeIndex && ! dontScroll)
         {
-            setViewPosition (getViewPositionX(), row * rowH);
+            setViewPosition (getViewPositionX(), owner.getRowTop (row));
         }
         else if (row >= lastWholeIndex && ! dontScroll)
         {
@@ -449,12 +451,12 @@ public:
                  && ! isMouseClick)
             {
                 setViewPosition (getViewPositionX(),
-                                 jlimit (0, jmax (0, totalRows - rowsOnScreen), row) * rowH);
+                                 owner.getRowTop (jlimit (0, jmax (0, totalRows - rowsOnScreen), row)));
             }
             else
             {
                 setViewPosition (getViewPositionX(),
-                                 jmax (0, (row  + 1) * rowH - getMaximumVisibleHeight()));
+                                 jmax (0, owner.getRowTop (row + 1) - getMaximumVisibleHeight()));
             }
         }
 
@@ -462,16 +464,16 @@ public:
             updateContents();
     }
 
-    void scrollToEnsureRowIsOnscreen (const int row, const int rowH)
+    void scrollToEnsureRowIsOnscreen (const int row)
     {
         if (row < firstWholeIndex)
         {
-            setViewPosition (getViewPositionX(), row * rowH);
+            setViewPosition (getViewPositionX(), owner.getRowTop (row));
         }
         else if (row >= lastWholeIndex)
         {
             setViewPosition (getViewPositionX(),
-                             jmax (0, (row  + 1) * rowH - getMaximumVisibleHeight()));
+                             jmax (0, owner.getRowTop (row + 1) - getMaximumVisibleHeight()));
         }
     }
 
@@ -649,10 +651,11 @@ void ListBox::updateContent()
     checkModelPtrIsValid();
     hasDoneInitialUpdate = true;
     totalItems = (model != nullptr) ? model->getNumRows() : 0;
+    updateRowHeights();
 
     bool selectionChanged = false;
 
-    if (selected.size() > 0 && selected [selected.size() - 1] >= totalItems)
+    if (selected.getTotalRange().getEnd() > totalItems)
     {
         selected.removeRange ({ totalItems, std::numeric_limits<int>::max() });
         lastRowSelected = getSelectedRow (0);
@@ -701,7 +704,7 @@ void ListBox::selectRowInternal (const int row,
             if (getHeight() == 0 || getWidth() == 0)
                 dontScroll = true;
 
-            viewport->selectRow (row, getRowHeight(), dontScroll,
+            viewport->selectRow (row, dontScroll,
                                  lastRowSelected, totalItems, isMouseClick);
 
             lastRowSelected = row;
@@ -850,7 +853,7 @@ int ListBox::getRowContainingPosition (const int x, const int y) const noexcept
 {
     if (isPositiveAndBelow (x, getWidth()))
     {
-        const int row = (viewport->getViewPositionY() + y - viewport->getY()) / rowHeight;
+        const int row = getRowAtContentY (viewport->getViewPositionY() + y - viewport->getY());
 
         if (isPositiveAndBelow (row, totalItems))
             return row;
@@ -862,7 +865,16 @@ int ListBox::getRowContainingPosition (const int x, const int y) const noexcept
 int ListBox::getInsertionIndexForPosition (const int x, const int y) const noexcept
 {
     if (isPositiveAndBelow (x, getWidth()))
-        return jlimit (0, totalItems, (viewport->getViewPositionY() + y + rowHeight / 2 - viewport->getY()) / rowHeight);
+    {
+        const auto contentY = viewport->getViewPositionY() + y - viewport->getY();
+
+        if (rowHeights == nullptr)
+            return jlimit (0, totalItems, (contentY + rowHeight / 2) / rowHeight);
+
+        const auto row = getRowAtContentY (contentY);
+        const auto h = getHeightOfRow (row);
+        return jlimit (0, totalItems, row + (contentY - getRowTop (row) + h / 2 >= h ? 1 : 0));
+    }
 
     return -1;
 }
@@ -882,13 +894,13 @@ int ListBox::getRowNumberOfComponent (const Component* const rowComponent) const
 
 Rectangle<int> ListBox::getRowPosition (int rowNumber, bool relativeToComponentTopLeft) const noexcept
 {
-    auto y = viewport->getY() + rowHeight * rowNumber;
+    auto y = viewport->getY() + getRowTop (rowNumber);
 
     if (relativeToComponentTopLeft)
         y -= viewport->getViewPositionY();
 
     return { viewport->getX(), y,
-             viewport->getViewedComponent()->getWidth(), rowHeight };
+             viewport->getViewedComponent()->getWidth(), getHeightOfRow (rowNumber) };
 }
 
 void ListBox::setVerticalPosition (const double proportion)
@@ -914,7 +926,7 @@ int ListBox::getVisibleRowWidth() const noexcept
 
 void ListBox::scrollToEnsureRowIsOnscreen (const int row)
 {
-    viewport->scrollToEnsureRowIsOnscreen (row, getRowHeight());
+    viewport->scrollToEnsureRowIsOnscreen (row);
 }
 
 //==============================================================================
@@ -922,7 +934,8 @@ bool ListBox::keyPressed (const KeyPress& key)
 {
     checkModelPtrIsValid();
 
-    const int numVisibleRows = viewport->getHeight() / getRowHeight();
+    const int numVisibleRows = rowHeights == nullptr ? viewport->getHeight() / getRowHeight()
+                                                     : jmax (1, getNumRowsOnScreen());
 
     const bool multiple = multipleSelection
                             && lastRowSelected >= 0
@@ -1043,7 +1056,85 @@ void ListBox::setRowHeight (const int newHeight)
 
 int ListBox::getNumRowsOnScreen() const noexcept
 {
-    return viewport->getMaximumVisibleHeight() / rowHeight;
+    if (rowHeights == nullptr)
+        return viewport->getMaximumVisibleHeight() / rowHeight;
+
+    const auto top = viewport->getViewPositionY();
+    const auto firstWholeRow = getRowAtContentY (top) + (getRowTop (getRowAtContentY (top)) < top ? 1 : 0);
+
+    return jmax (0, getRowAtContentY (top + viewport->getMaximumVisibleHeight()) - firstWholeRow);
+}
+
+void ListBox::setVariableRowHeightsEnabled (bool shouldBeEnabled)
+{
+    if (shouldBeEnabled == hasVariableRowHeights())
+        return;
+
+    rowHeights = shouldBeEnabled ? std::make_unique<detail::PrefixSumTree>() : nullptr;
+    updateContent();
+}
+
+void ListBox::updateRowHeight (int rowNumber)
+{
+    if (rowHeights == nullptr || ! isPositiveAndBelow (rowNumber, rowHeights->size()))
+        return;
+
+    const auto newHeight = getHeightFromModel (rowNumber);
+
+    if (newHeight != rowHeights->get (rowNumber))
+    {
+        rowHeights->set (rowNumber, newHeight);
+        viewport->updateVisibleArea (true);
+    }
+}
+
+void ListBox::updateRowHeights()
+{
+    if (rowHeights != nullptr)
+        rowHeights->assign (totalItems, [this] (int row) { return getHeightFromModel (row); });
+}
+
+int ListBox::getHeightFromModel (int rowNumber) const
+{
+    const auto h = model != nullptr ? model->getHeightForRow (rowNumber) : -1;
+    return jmax (1, h >= 0 ? h : rowHeight);
+}
+
+/*  Rows that are past the end of the list, or have a negative index, are treated as having
+    the default height, so that the fixed-height arithmetic still works for them.
+*/
+int ListBox::getRowTop (int rowNumber) const noexcept
+{
+    if (rowHeights == nullptr || rowNumber < 0)
+        return rowNumber * rowHeight;
+
+    const auto numKnown = rowHeights->size();
+
+    if (rowNumber <= numKnown)
+        return rowHeights->getSumBefore (rowNumber);
+
+    return rowHeights->getTotal() + (rowNumber - numKnown) * rowHeight;
+}
+
+int ListBox::getHeightOfRow (int rowNumber) const noexcept
+{
+    if (rowHeights != nullptr && isPositiveAndBelow (rowNumber, rowHeights->size()))
+        return rowHeights->get (rowNumber);
+
+    return rowHeight;
+}
+
+int ListBox::getRowAtContentY (int y) const noexcept
+{
+    if (rowHeights == nullptr || y < 0)
+        return y / rowHeight;
+
+    const auto total = rowHeights->getTotal();
+
+    if (y < total)
+        return rowHeights->findIndexContaining (y);
+
+    return rowHeights->size() + (y - total) / rowHeight;
 }
 
 void ListBox::setMinimumContentWidth (const int newMinimumWidth)
@@ -1259,5 +1350,98 @@ void ListBoxModel::listWasScrolled() {}
 var ListBoxModel::getDragSourceDescription (const SparseSet<int>&)      { return {}; }
 String ListBoxModel::getTooltipForRow (int)                             { return {}; }
 MouseCursor ListBoxModel::getMouseCursorForRow (int)                    { return MouseCursor::NormalCursor; }
+int ListBoxModel::getHeightForRow (int)                                 { return -1; }
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ListBoxTests final : public UnitTest
+{
+public:
+    ListBoxTests()
+        : UnitTest ("ListBox", UnitTestCategories::gui)
+    {}
+
+    void runTest() override
+    {
+        ScopedJuceInitialiser_GUI libraryInitialiser;
+
+        Model model;
+        Random random { 1 };
+
+        for (int i = 0; i < 1000; ++i)
+            model.heights.push_back (i % 7 == 0 ? -1 : 1 + random.nextInt (40));
+
+        ListBox list ({}, &model);
+        list.setBounds (0, 0, 200, 300);
+        list.setVisible (true);
+        list.setRowHeight (10);
+        list.setVariableRowHeightsEnabled (true);
+
+        const auto expectRowsMatchModel = [&]
+        {
+            auto& content = *list.getViewport()->getViewedComponent();
+            auto top = 0;
+
+            for (int row = 0; row < model.getNumRows(); ++row)
+            {
+                const auto height = model.getHeightForRow (row) >= 0 ? model.getHeightForRow (row) : 10;
+                expect (list.getRowPosition (row, false) == Rectangle<int> (0, top, content.getWidth(), height));
+                top += height;
+            }
+
+            expectEquals (content.getHeight(), top);
+
+            for (int y = 0; y < list.getHeight(); ++y)
+            {
+                const auto row = list.getRowContainingPosition (10, y);
+                expect (list.getRowPosition (row, true).contains (10, y));
+            }
+        };
+
+        beginTest ("Rows can have different heights");
+        {
+            expect (list.hasVariableRowHeights());
+            expectRowsMatchModel();
+
+            const auto pos = list.getRowPosition (500, false);
+            expectEquals (list.getInsertionIndexForPosition (10, pos.getY() + pos.getHeight() / 4), 500);
+            expectEquals (list.getInsertionIndexForPosition (10, pos.getBottom() - 1), 501);
+        }
+
+        beginTest ("Changing the height of one row moves the rows below it");
+        {
+            model.heights[5] = 123;
+            list.updateRowHeight (5);
+            expectRowsMatchModel();
+
+            list.scrollToEnsureRowIsOnscreen (900);
+            expectRowsMatchModel();
+            expect (list.getViewport()->getViewArea().contains (list.getRowPosition (900, false)));
+        }
+
+        beginTest ("Turning off variable heights restores the fixed row height");
+        {
+            list.setVariableRowHeightsEnabled (false);
+            expect (! list.hasVariableRowHeights());
+            expectEquals (list.getRowPosition (7, false).getY(), 70);
+            expectEquals (list.getViewport()->getViewedComponent()->getHeight(), model.getNumRows() * 10);
+        }
+    }
+
+private:
+    struct Model final : public ListBoxModel
+    {
+        int getNumRows() override                               { return (int) heights.size(); }
+        void paintListBoxItem (int, Graphics&, int, int, bool) override {}
+        int getHeightForRow (int row) override                  { return heights[(size_t) row]; }
+
+        std::vector<int> heights;
+    };
+};
+
+static ListBoxTests listBoxTests;
+
+#endif
 
 } // namespace juce
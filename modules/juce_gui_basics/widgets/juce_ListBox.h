@@ -178,6 +178,17 @@ public:
     /** You can override this to return a custom mouse cursor for each row. */
     virtual MouseCursor getMouseCursorForRow (int row);
 
+    /** Override this to give rows different heights.
+
+        This is only called if the ListBox has had variable row heights turned on with
+        ListBox::setVariableRowHeightsEnabled(). Returning -1 (which is what the default
+        implementation does) will give the row the height that was set with
+        ListBox::setRowHeight().
+
+        @see ListBox::setVariableRowHeightsEnabled, ListBox::updateRowHeight
+    */
+    virtual int getHeightForRow (int rowNumber);
+
 private:
    #if ! JUCE_DISABLE_ASSERTIONS
     friend class ListBox;
@@ -500,6 +511,35 @@ public:
     */
     int getNumRowsOnScreen() const noexcept;
 
+    /** Allows the rows of the list to have different heights.
+
+        When this is enabled, the list asks its model for the height of each row with
+        ListBoxModel::getHeightForRow() whenever updateContent() is called, and keeps a
+        running total of the heights so that finding the position of a row, or the row at
+        a position, takes O(log n) time however long the list is. This means that it only
+        costs a call to getHeightForRow() per row to use the feature, even for very long lists.
+
+        If the height of a single row changes, call updateRowHeight() rather than
+        updateContent().
+
+        @see ListBoxModel::getHeightForRow, updateRowHeight
+    */
+    void setVariableRowHeightsEnabled (bool shouldBeEnabled);
+
+    /** Returns true if the rows of the list can have different heights.
+        @see setVariableRowHeightsEnabled
+    */
+    bool hasVariableRowHeights() const noexcept         { return rowHeights != nullptr; }
+
+    /** Asks the model for the new height of one of the rows, and updates the layout.
+
+        This only does anything if variable row heights are enabled, and is much quicker
+        than calling updateContent() when only one row has changed.
+
+        @see setVariableRowHeightsEnabled, ListBoxModel::getHeightForRow
+    */
+    void updateRowHeight (int rowNumber);
+
     //==============================================================================
     /** A set of colour IDs to use to change the colour of various aspects of the label.
 
@@ -634,6 +674,7 @@ private:
     std::unique_ptr<ListViewport> viewport;
     std::unique_ptr<Component> headerComponent;
     std::unique_ptr<MouseListener> mouseMoveSelector;
+    std::unique_ptr<detail::PrefixSumTree> rowHeights;
     SparseSet<int> selected;
     int totalItems = 0, rowHeight = 22, minimumRowWidth = 0;
     int outlineThickness = 0;
@@ -649,6 +690,11 @@ private:
     bool hasAccessibleHeaderComponent() const;
     void selectRowInternal (int rowNumber, bool dontScrollToShowThisRow,
                             bool deselectOthersFirst, bool isMouseClick);
+    void updateRowHeights();
+    int getHeightFromModel (int rowNumber) const;
+    int getRowTop (int rowNumber) const noexcept;
+    int getHeightOfRow (int rowNumber) const noexcept;
+    int getRowAtContentY (int y) const noexcept;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ListBox)
 };
@@ -200,6 +200,16 @@ public:
         dragged to other windows. Returns true by default.
     */
     virtual bool mayDragToExternalWindows() const   { return true; }
+
+    /** Override this to give rows different heights.
+
+        This is only called if variable row heights have been turned on with
+        ListBox::setVariableRowHeightsEnabled(). Return -1 to use the height that was set
+        with ListBox::setRowHeight().
+
+        @see ListBoxModel::getHeightForRow
+    */
+    virtual int getHeightForRow (int rowNumber);
 };
 
 
@@ -331,6 +341,8 @@ public:
     /** @internal */
     void listWasScrolled() override;
     /** @internal */
+    int getHeightForRow (int rowNumber) override;
+    /** @internal */
     void tableColumnsChanged (TableHeaderComponent*) override;
     /** @internal */
     void tableColumnsResized (TableHeaderComponent*) override;
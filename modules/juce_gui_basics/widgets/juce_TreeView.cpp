@@ -361,6 +361,10 @@ public:
 
     void updateComponents()
     {
+        // the items will be laid out again shortly, so leave the components where they are until then
+        if (! owner.isLayoutUpToDate())
+            return;
+
         std::set<ItemComponent*> componentsToKeep;
 
         for (auto* treeItem : getAllVisibleItems())
@@ -397,7 +401,7 @@ public:
         for (auto& comp : itemComponents)
         {
             auto& treeItem = comp->getRepresentedItem();
-            comp->setBounds ({ 0, treeItem.y, getWidth(), treeItem.itemHeight });
+            comp->setBounds ({ 0, treeItem.getY(), getWidth(), treeItem.itemHeight });
         }
     }
 
@@ -641,57 +645,48 @@ private:
                                                                                            : nextItem;
     }
 
-    template <typename Fn>
-    static void forEachDepthFirst (TreeViewItem* item, bool includeItem, Fn&& callback)
-    {
-        if (includeItem)
-            callback (item);
-
-        if (item->isOpen())
-            for (auto i = 0; i < item->getNumSubItems(); ++i)
-                forEachDepthFirst (item->getSubItem (i), true, callback);
-    }
-
-    std::vector<TreeViewItem*> collectAllItems() const
-    {
-        size_t count{};
-        forEachDepthFirst (owner.rootItem, owner.rootItemVisible, [&] (auto*) { ++count; });
-
-        std::vector<TreeViewItem*> allItems;
-        allItems.reserve (count);
-        forEachDepthFirst (owner.rootItem, owner.rootItemVisible, [&] (auto* item) { allItems.push_back (item); });
-
-        return allItems;
-    }
-
+    /*  Finds the item at the top of the visible area by descending through the items'
+        layouts, and then steps through the rows from there, so this only visits the items
+        that are on-screen, plus a couple either side.
+    */
     std::vector<TreeViewItem*> getAllVisibleItems() const
     {
-        if (owner.rootItem == nullptr)
+        auto* root = owner.rootItem;
+
+        if (root == nullptr)
             return {};
 
         const auto visibleTop = -getY();
         const auto visibleBottom = visibleTop + getParentHeight();
-        auto allItems = collectAllItems();
+        const auto padding = 2;
 
-        const auto lower = std::lower_bound (allItems.begin(), allItems.end(), visibleTop, [] (TreeViewItem* item, const auto y)
-        {
-            return item->y + item->getItemHeight() < y;
-        });
+        auto* first = root->findItemAtY (visibleTop - root->getY());
 
-        const auto upper = std::upper_bound (allItems.begin(), allItems.end(), visibleBottom, [] (const auto y, TreeViewItem* item)
-        {
-            return y < item->y;
-        });
+        if (first == root && ! owner.rootItemVisible)
+            first = getNextVisibleItem (first, true);
 
-        const std::ptrdiff_t padding = 2;
+        for (int i = 0; i < padding && first != nullptr; ++i)
+            if (auto* previous = getNextVisibleItem (first, false))
+                first = previous;
 
-        const auto frontToErase = std::max (padding, std::distance (allItems.begin(), lower)) - padding;
-        const auto backToErase  = std::max (padding, std::distance (upper, allItems.end()))   - padding;
+        std::vector<TreeViewItem*> items;
 
-        allItems.erase (allItems.begin(), std::next (allItems.begin(), frontToErase));
-        allItems.erase (std::prev (allItems.end(), backToErase), allItems.end());
+        if (first == nullptr)
+            return items;
 
-        return allItems;
+        auto y = first->getY();
+        auto numBelow = 0;
+
+        for (auto* item = first; item != nullptr && numBelow < padding; item = getNextVisibleItem (item, true))
+        {
+            if (y > visibleBottom)
+                ++numBelow;
+
+            items.push_back (item);
+            y += item->itemHeight;
+        }
+
+        return items;
     }
 
     //==============================================================================
@@ -788,9 +783,12 @@ private:
         {
             if (auto* root = owner.rootItem)
             {
-                const auto startY = owner.rootItemVisible ? 0 : -root->itemHeight;
+                const auto indentSize = owner.getIndentSize();
+                const auto indentChanged = std::exchange (owner.lastLayoutIndentSize, indentSize) != indentSize;
+
+                root->updateLayout (std::exchange (owner.needsFullLayout, false) || indentChanged);
 
-                root->updatePositions (startY);
+                const auto startY = root->getY();
                 getViewedComponent()->setSize (jmax (getMaximumVisibleWidth(), root->totalWidth + 50),
                                                root->totalHeight + startY);
             }
@@ -1004,6 +1002,7 @@ void TreeView::setRootItem (TreeViewItem* const newRootItem)
             rootItem->setOpen (true);
         }
 
+        needsFullLayout = true;
         viewport->recalculatePositions (TreeViewport::Async::no, {});
     }
 }
@@ -1024,7 +1023,7 @@ void TreeView::setRootItemVisible (const bool shouldBeVisible)
         rootItem->setOpen (true);
     }
 
-    updateVisibleItems();
+    updateAllItemLayouts();
 }
 
 void TreeView::colourChanged()
@@ -1053,7 +1052,7 @@ void TreeView::setDefaultOpenness (const bool isOpenByDefault)
     if (defaultOpenness != isOpenByDefault)
     {
         defaultOpenness = isOpenByDefault;
-        updateVisibleItems();
+        updateAllItemLayouts();
     }
 }
 
@@ -1067,7 +1066,7 @@ void TreeView::setOpenCloseButtonsVisible (const bool shouldBeVisible)
     if (openCloseButtonsVisible != shouldBeVisible)
     {
         openCloseButtonsVisible = shouldBeVisible;
-        updateVisibleItems();
+        updateAllItemLayouts();
     }
 }
 
@@ -1245,11 +1244,12 @@ void TreeView::scrollToKeepItemVisible (const TreeViewItem* item)
 {
     if (item != nullptr && item->ownerView == this)
     {
-        updateVisibleItems();
+        // only the items that have changed need laying out again, so this is quick enough to do now
+        viewport->recalculatePositions (TreeViewport::Async::no, {});
 
         item = item->getDeepestOpenParentItem();
 
-        auto y = item->y;
+        auto y = item->getY();
         auto viewTop = viewport->getViewPositionY();
 
         if (y < viewTop)
@@ -1367,6 +1367,21 @@ void TreeView::updateVisibleItems (std::optional<Point<int>> viewportPosition)
     viewport->recalculatePositions (TreeViewport::Async::yes, std::move (viewportPosition));
 }
 
+void TreeView::updateAllItemLayouts (std::optional<Point<int>> viewportPosition)
+{
+    needsFullLayout = true;
+    updateVisibleItems (std::move (viewportPosition));
+}
+
+/*  Each item keeps the heights and row counts of its sub-items in a PrefixSumTree, so
+    while these are up-to-date, finding an item's row or position, or the item on a row,
+    doesn't have to visit all the items above it.
+*/
+bool TreeView::isLayoutUpToDate() const noexcept
+{
+    return rootItem == nullptr || (! needsFullLayout && ! rootItem->layoutNeedsUpdate);
+}
+
 //==============================================================================
 void TreeView::showDragHighlight (const InsertPoint& insertPos) noexcept
 {
@@ -1565,6 +1580,42 @@ std::unique_ptr<AccessibilityHandler> TreeView::createAccessibilityHandler()
                                                    AccessibilityHandler::Interfaces { std::make_unique<TableInterface> (*this) });
 }
 
+//==============================================================================
+struct TreeViewItem::SubItemLayout
+{
+    void rebuild (const OwnedArray<TreeViewItem>& items)
+    {
+        heights.assign (items.size(), [&] (int i) { return items.getUnchecked (i)->totalHeight; });
+        rows   .assign (items.size(), [&] (int i) { return items.getUnchecked (i)->numRows; });
+
+        widths.resize ((size_t) items.size());
+        maxWidth = 0;
+
+        for (int i = 0; i < items.size(); ++i)
+            maxWidth = jmax (maxWidth, widths[(size_t) i] = items.getUnchecked (i)->totalWidth);
+    }
+
+    void update (const TreeViewItem& item)
+    {
+        const auto index = item.indexInParent;
+        jassert (isPositiveAndBelow (index, heights.size()));
+
+        heights.set (index, item.totalHeight);
+        rows.set (index, item.numRows);
+
+        const auto oldWidth = std::exchange (widths[(size_t) index], item.totalWidth);
+
+        if (item.totalWidth >= maxWidth)
+            maxWidth = item.totalWidth;
+        else if (oldWidth == maxWidth)
+            maxWidth = *std::max_element (widths.begin(), widths.end());
+    }
+
+    detail::PrefixSumTree heights, rows;
+    std::vector<int> widths;
+    int maxWidth = 0;
+};
+
 //==============================================================================
 TreeViewItem::TreeViewItem()
 {
@@ -1604,7 +1655,7 @@ void TreeViewItem::clearSubItems()
         if (! subItems.isEmpty())
         {
             removeAllSubItemsFromList();
-            treeHasChanged();
+            layoutHasChanged (true);
         }
     }
     else
@@ -1625,7 +1676,6 @@ void TreeViewItem::addSubItem (TreeViewItem* const newItem, const int insertPosi
     {
         newItem->parentItem = nullptr;
         newItem->setOwnerView (ownerView);
-        newItem->y = 0;
         newItem->itemHeight = newItem->getItemHeight();
         newItem->totalHeight = 0;
         newItem->itemWidth = newItem->getItemWidth();
@@ -1635,7 +1685,7 @@ void TreeViewItem::addSubItem (TreeViewItem* const newItem, const int insertPosi
         if (ownerView != nullptr)
         {
             subItems.insert (insertPosition, newItem);
-            treeHasChanged();
+            layoutHasChanged (true);
 
             if (newItem->isOpen())
                 newItem->itemOpennessChanged (true);
@@ -1643,6 +1693,7 @@ void TreeViewItem::addSubItem (TreeViewItem* const newItem, const int insertPosi
         else
         {
             subItems.insert (insertPosition, newItem);
+            markLayoutDirty (true);
 
             if (newItem->isOpen())
                 newItem->itemOpennessChanged (true);
@@ -1655,7 +1706,7 @@ void TreeViewItem::removeSubItem (int index, bool deleteItem)
     if (ownerView != nullptr)
     {
         if (removeSubItemFromList (index, deleteItem))
-            treeHasChanged();
+            layoutHasChanged (true);
     }
     else
     {
@@ -1669,6 +1720,7 @@ bool TreeViewItem::removeSubItemFromList (int index, bool deleteItem)
     {
         child->parentItem = nullptr;
         subItems.remove (index, deleteItem);
+        markLayoutDirty (true);
 
         return true;
     }
@@ -1689,7 +1741,7 @@ void TreeViewItem::setOpenness (Openness newOpenness)
 
     if (isNowOpen != wasOpen)
     {
-        treeHasChanged();
+        layoutHasChanged (false);
         itemOpennessChanged (isNowOpen);
     }
 }
@@ -1859,7 +1911,7 @@ Rectangle<int> TreeViewItem::getItemPosition (const bool relativeToTreeViewTopLe
     if (ownerView != nullptr && width < 0)
         width = ownerView->viewport->getViewWidth() - indentX;
 
-    Rectangle<int> r (indentX, y, jmax (0, width), totalHeight);
+    Rectangle<int> r (indentX, getY(), jmax (0, width), totalHeight);
 
     if (relativeToTreeViewTopLeft && ownerView != nullptr)
         r -= ownerView->viewport->getViewPosition();
@@ -1869,10 +1921,45 @@ Rectangle<int> TreeViewItem::getItemPosition (const bool relativeToTreeViewTopLe
 
 void TreeViewItem::treeHasChanged() const noexcept
 {
+    if (ownerView != nullptr)
+        ownerView->updateAllItemLayouts();
+}
+
+void TreeViewItem::layoutHasChanged (bool subItemsHaveChanged)
+{
+    markLayoutDirty (subItemsHaveChanged);
+
     if (ownerView != nullptr)
         ownerView->updateVisibleItems();
 }
 
+/*  Flags this item and its parents as needing to be laid out again, and adds each one to
+    its parent's list of changed sub-items, so that updateLayout() only has to visit the
+    items that have actually changed. This can stop as soon as it reaches an item that's
+    already been flagged, because that item's parents will have been flagged too.
+*/
+void TreeViewItem::markLayoutDirty (bool subItemsHaveChanged) noexcept
+{
+    if (subItemsHaveChanged)
+    {
+        subItemsChanged = true;
+        changedSubItems.clear();
+    }
+
+    for (auto* item = this; ! std::exchange (item->layoutNeedsUpdate, true); item = item->parentItem)
+    {
+        if (item->parentItem == nullptr)
+            break;
+
+        item->parentItem->changedSubItems.push_back (item);
+    }
+}
+
+bool TreeViewItem::hasUpToDateLayout() const noexcept
+{
+    return ownerView != nullptr && ! ownerView->needsFullLayout && ! layoutNeedsUpdate;
+}
+
 void TreeViewItem::repaintItem() const
 {
     if (ownerView != nullptr && areAllParentsOpen())
@@ -1886,25 +1973,87 @@ bool TreeViewItem::areAllParentsOpen() const noexcept
             || (parentItem->isOpen() && parentItem->areAllParentsOpen());
 }
 
-void TreeViewItem::updatePositions (int newY)
+void TreeViewItem::updateLayout (bool forceUpdate)
 {
-    y = newY;
+    if (! (forceUpdate || layoutNeedsUpdate))
+        return;
+
+    layoutNeedsUpdate = false;
     itemHeight = getItemHeight();
     totalHeight = itemHeight;
     itemWidth = getItemWidth();
     totalWidth = jmax (itemWidth, 0) + getIndentX();
+    numRows = 1;
 
-    if (isOpen())
+    if (! isOpen() || subItems.isEmpty())
     {
-        newY += totalHeight;
+        // the sub-items will all be visited again when this item is next opened
+        subItemLayout.reset();
+        changedSubItems.clear();
+        subItemsChanged = false;
+        return;
+    }
 
-        for (auto* i : subItems)
+    if (forceUpdate || subItemsChanged || subItemLayout == nullptr)
+    {
+        for (int i = 0; i < subItems.size(); ++i)
         {
-            i->updatePositions (newY);
-            newY += i->totalHeight;
-            totalHeight += i->totalHeight;
-            totalWidth = jmax (totalWidth, i->totalWidth);
+            auto* item = subItems.getUnchecked (i);
+            item->indexInParent = i;
+            item->updateLayout (forceUpdate);
         }
+
+        if (subItemLayout == nullptr)
+            subItemLayout = std::make_unique<SubItemLayout>();
+
+        subItemLayout->rebuild (subItems);
+    }
+    else
+    {
+        for (auto* item : changedSubItems)
+        {
+            item->updateLayout (false);
+            subItemLayout->update (*item);
+        }
+    }
+
+    changedSubItems.clear();
+    subItemsChanged = false;
+
+    totalHeight += subItemLayout->heights.getTotal();
+    totalWidth = jmax (totalWidth, subItemLayout->maxWidth);
+    numRows += subItemLayout->rows.getTotal();
+}
+
+int TreeViewItem::getY() const noexcept
+{
+    if (parentItem == nullptr)
+        return ownerView != nullptr && ! ownerView->rootItemVisible ? -itemHeight : 0;
+
+    const auto top = parentItem->getY() + parentItem->itemHeight;
+
+    if (auto* layout = parentItem->subItemLayout.get())
+        if (isPositiveAndBelow (indexInParent, layout->heights.size()))
+            return top + layout->heights.getSumBefore (indexInParent);
+
+    return top;
+}
+
+TreeViewItem* TreeViewItem::findItemAtY (int relativeY) noexcept
+{
+    auto* item = this;
+
+    for (;;)
+    {
+        relativeY -= item->itemHeight;
+        auto* layout = item->subItemLayout.get();
+
+        if (relativeY < 0 || layout == nullptr || ! item->isOpen() || layout->heights.size() != item->subItems.size())
+            return item;
+
+        const auto index = jmin (layout->heights.findIndexContaining (relativeY), item->subItems.size() - 1);
+        relativeY -= layout->heights.getSumBefore (index);
+        item = item->subItems.getUnchecked (index);
     }
 }
 
@@ -1927,6 +2076,8 @@ const TreeViewItem* TreeViewItem::getDeepestOpenParentItem() const noexcept
 void TreeViewItem::setOwnerView (TreeView* const newOwner) noexcept
 {
     ownerView = newOwner;
+    layoutNeedsUpdate = subItemsChanged = true;
+    changedSubItems.clear();
 
     for (auto* i : subItems)
     {
@@ -1975,8 +2126,14 @@ bool TreeViewItem::isLastOfSiblings() const noexcept
 
 int TreeViewItem::getIndexInParent() const noexcept
 {
-    return parentItem == nullptr ? 0
-                                 : parentItem->subItems.indexOf (this);
+    if (parentItem == nullptr)
+        return 0;
+
+    if (isPositiveAndBelow (indexInParent, parentItem->subItems.size())
+         && parentItem->subItems.getUnchecked (indexInParent) == this)
+        return indexInParent;
+
+    return parentItem->subItems.indexOf (this);
 }
 
 TreeViewItem* TreeViewItem::getTopLevelItem() noexcept
@@ -1987,6 +2144,9 @@ TreeViewItem* TreeViewItem::getTopLevelItem() noexcept
 
 int TreeViewItem::getNumRows() const noexcept
 {
+    if (hasUpToDateLayout())
+        return numRows;
+
     int num = 1;
 
     if (isOpen())
@@ -2005,17 +2165,27 @@ TreeViewItem* TreeViewItem::getItemOnRow (int index) noexcept
     {
         --index;
 
+        if (hasUpToDateLayout() && subItemLayout != nullptr)
+        {
+            const auto subItemIndex = subItemLayout->rows.findIndexContaining (index);
+
+            if (auto* i = subItems[subItemIndex])
+                return i->getItemOnRow (index - subItemLayout->rows.getSumBefore (subItemIndex));
+
+            return nullptr;
+        }
+
         for (auto* i : subItems)
         {
             if (index == 0)
                 return i;
 
-            auto numRows = i->getNumRows();
+            auto rowsInItem = i->getNumRows();
 
-            if (numRows > index)
+            if (rowsInItem > index)
                 return i->getItemOnRow (index);
 
-            index -= numRows;
+            index -= rowsInItem;
         }
     }
 
@@ -2066,11 +2236,18 @@ int TreeViewItem::getRowNumberInTree() const noexcept
 
         auto n = 1 + parentItem->getRowNumberInTree();
 
-        auto ourIndex = parentItem->subItems.indexOf (this);
+        auto ourIndex = getIndexInParent();
         jassert (ourIndex >= 0);
 
-        while (--ourIndex >= 0)
-            n += parentItem->subItems [ourIndex]->getNumRows();
+        if (parentItem->hasUpToDateLayout() && parentItem->subItemLayout != nullptr)
+        {
+            n += parentItem->subItemLayout->rows.getSumBefore (ourIndex);
+        }
+        else
+        {
+            while (--ourIndex >= 0)
+                n += parentItem->subItems [ourIndex]->getNumRows();
+        }
 
         if (parentItem->parentItem == nullptr
              && ! ownerView->rootItemVisible)
@@ -2283,4 +2460,233 @@ void TreeViewItem::draw (Graphics& g, int width, bool isMouseOverButton)
     }
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct TreeViewTestItem final : public TreeViewItem
+{
+    explicit TreeViewTestItem (int h = 20, int numLazyChildren = 0)
+        : height (h), numChildrenToCreate (numLazyChildren) {}
+
+    bool mightContainSubItems() override        { return true; }
+    int getItemHeight() const override          { return height; }
+
+    void itemOpennessChanged (bool isNowOpen) override
+    {
+        if (isNowOpen && getNumSubItems() == 0)
+            for (int i = 0; i < numChildrenToCreate; ++i)
+                addSubItem (new TreeViewTestItem());
+    }
+
+    int height, numChildrenToCreate;
+};
+
+class TreeViewTests final : public UnitTest
+{
+public:
+    TreeViewTests()
+        : UnitTest ("TreeView", UnitTestCategories::gui)
+    {}
+
+    void runTest() override
+    {
+        ScopedJuceInitialiser_GUI libraryInitialiser;
+
+        Random random { 1 };
+        TreeView tree;
+        tree.setBounds (0, 0, 300, 400);
+        tree.setVisible (true);
+
+        TreeViewTestItem root;
+        addRandomChildren (random, root, 3);
+        root.setOpen (true);
+        tree.setRootItem (&root);
+
+        beginTest ("Rows and positions match the open items");
+        {
+            expectLayoutMatchesTree (tree);
+        }
+
+        beginTest ("Rows and positions are updated when items are opened, closed, added and removed");
+        {
+            for (int i = 0; i < 200; ++i)
+            {
+                for (int j = 0; j < 5; ++j)
+                {
+                    auto* item = pickRandomItem (random, root);
+
+                    switch (random.nextInt (4))
+                    {
+                        case 0:  item->setOpen (! item->isOpen()); break;
+                        case 1:  item->addSubItem (new TreeViewTestItem (5 + random.nextInt (30)), random.nextInt (item->getNumSubItems() + 1)); break;
+                        case 2:  if (item->getNumSubItems() > 0) item->removeSubItem (random.nextInt (item->getNumSubItems())); break;
+                        default: if (item->getNumSubItems() > 0) item->getSubItem (0)->setOpen (true); break;
+                    }
+                }
+
+                tree.scrollToKeepItemVisible (pickRandomItem (random, root));
+                expectLayoutMatchesTree (tree);
+            }
+        }
+
+        beginTest ("Hiding the root item");
+        {
+            tree.setRootItemVisible (false);
+            tree.scrollToKeepItemVisible (&root);
+            expectLayoutMatchesTree (tree);
+        }
+
+        tree.setRootItem (nullptr);
+    }
+
+private:
+    static void addRandomChildren (Random& random, TreeViewItem& item, int depth)
+    {
+        if (depth == 0)
+            return;
+
+        for (int i = random.nextInt (8); --i >= 0;)
+        {
+            auto* child = new TreeViewTestItem (5 + random.nextInt (30));
+            item.addSubItem (child);
+            child->setOpen (random.nextBool());
+            addRandomChildren (random, *child, depth - 1);
+        }
+    }
+
+    static TreeViewItem* pickRandomItem (Random& random, TreeViewItem& root)
+    {
+        auto* item = &root;
+
+        while (item->getNumSubItems() > 0 && random.nextInt (3) != 0)
+            item = item->getSubItem (random.nextInt (item->getNumSubItems()));
+
+        return item;
+    }
+
+    void expectLayoutMatchesTree (TreeView& tree)
+    {
+        int row = 0, y = 0;
+        auto* root = tree.getRootItem();
+
+        const auto check = [&] (auto& recurse, TreeViewItem& item) -> void
+        {
+            expectEquals (item.getRowNumberInTree(), row);
+            expect (tree.getItemOnRow (row) == &item);
+            expectEquals (item.getItemPosition (false).getY(), y);
+
+            ++row;
+            y += item.getItemHeight();
+
+            if (item.isOpen())
+                for (int i = 0; i < item.getNumSubItems(); ++i)
+                    recurse (recurse, *item.getSubItem (i));
+        };
+
+        if (tree.isRootItemVisible())
+        {
+            check (check, *root);
+        }
+        else if (root->isOpen())
+        {
+            for (int i = 0; i < root->getNumSubItems(); ++i)
+                check (check, *root->getSubItem (i));
+        }
+
+        expectEquals (tree.getNumRowsInTree(), row);
+        expect (tree.getItemOnRow (row) == nullptr);
+        expectEquals (tree.getViewport()->getViewedComponent()->getHeight(), y);
+    }
+};
+
+static TreeViewTests treeViewTests;
+
+//==============================================================================
+class TreeViewBenchmarks final : public UnitTest
+{
+public:
+    TreeViewBenchmarks()
+        : UnitTest ("TreeView benchmarks", UnitTestCategories::benchmarks)
+    {}
+
+    void runTest() override
+    {
+        ScopedJuceInitialiser_GUI libraryInitialiser;
+
+        beginTest ("Scrolling and expanding a tree with a million rows");
+        {
+            TreeView tree;
+            tree.setBounds (0, 0, 400, 800);
+            tree.setVisible (true);
+
+            TreeViewTestItem root (20, numFolders);
+            tree.setRootItem (&root);
+            root.setOpen (true);
+
+            auto start = Time::getMillisecondCounterHiRes();
+
+            for (int i = 0; i < numFolders; ++i)
+            {
+                auto* folder = root.getSubItem (i);
+                static_cast<TreeViewTestItem*> (folder)->numChildrenToCreate = numItemsPerFolder;
+                folder->setOpen (true);
+            }
+
+            tree.scrollToKeepItemVisible (&root);
+            const auto openTime = Time::getMillisecondCounterHiRes() - start;
+            const auto numRows = tree.getNumRowsInTree();
+            expectEquals (numRows, 1 + numFolders * (numItemsPerFolder + 1));
+
+            Random random { 1 };
+            auto* viewport = tree.getViewport();
+            const auto maxY = viewport->getViewedComponent()->getHeight() - viewport->getViewHeight();
+
+            start = Time::getMillisecondCounterHiRes();
+
+            for (int i = 0; i < numScrolls; ++i)
+                viewport->setViewPosition (0, random.nextInt (maxY));
+
+            const auto scrollTime = (Time::getMillisecondCounterHiRes() - start) * 1000.0 / numScrolls;
+
+            start = Time::getMillisecondCounterHiRes();
+
+            for (int i = 0; i < numToggles; ++i)
+            {
+                auto* folder = root.getSubItem (random.nextInt (numFolders));
+                folder->setOpen (! folder->isOpen());
+                tree.scrollToKeepItemVisible (folder);
+            }
+
+            const auto toggleTime = (Time::getMillisecondCounterHiRes() - start) * 1000.0 / numToggles;
+
+            start = Time::getMillisecondCounterHiRes();
+            int total = 0;
+
+            for (int i = 0; i < numLookups; ++i)
+                total += tree.getItemOnRow (random.nextInt (numRows)) != nullptr ? 1 : 0;
+
+            const auto lookupTime = (Time::getMillisecondCounterHiRes() - start) * 1000.0 / numLookups;
+            expect (total > 0);
+
+            logMessage ("Opening " + String (numFolders) + " folders of " + String (numItemsPerFolder) + " items: "
+                        + String (openTime, 1) + "ms");
+            logMessage ("Scrolling: " + String (scrollTime, 1) + "us, expanding or collapsing a folder: "
+                        + String (toggleTime, 1) + "us, getItemOnRow: " + String (lookupTime, 2) + "us");
+
+            tree.setRootItem (nullptr);
+        }
+    }
+
+private:
+    static constexpr auto numFolders = 1000;
+    static constexpr auto numItemsPerFolder = 1000;
+    static constexpr auto numScrolls = 2000;
+    static constexpr auto numToggles = 200;
+    static constexpr auto numLookups = 20000;
+};
+
+static TreeViewBenchmarks treeViewBenchmarks;
+
+#endif
+
 } // namespace juce
@@ -132,6 +132,7 @@ public:
     void sortSubItems (ElementComparator& comparator)
     {
         subItems.sort (comparator);
+        layoutHasChanged (true);
     }
 
     //==============================================================================
@@ -617,8 +618,14 @@ public:
 private:
     //==============================================================================
     friend class TreeView;
-
-    void updatePositions (int);
+    struct SubItemLayout;
+
+    void updateLayout (bool forceUpdate);
+    void markLayoutDirty (bool subItemsHaveChanged) noexcept;
+    void layoutHasChanged (bool subItemsHaveChanged);
+    bool hasUpToDateLayout() const noexcept;
+    int getY() const noexcept;
+    TreeViewItem* findItemAtY (int) noexcept;
     int getIndentX() const noexcept;
     void setOwnerView (TreeView*) noexcept;
     TreeViewItem* getTopLevelItem() noexcept;
@@ -641,11 +648,13 @@ private:
     TreeView* ownerView = nullptr;
     TreeViewItem* parentItem = nullptr;
     OwnedArray<TreeViewItem> subItems;
+    std::unique_ptr<SubItemLayout> subItemLayout;
+    std::vector<TreeViewItem*> changedSubItems;
 
     Openness openness = Openness::opennessDefault;
-    int y = 0, itemHeight = 0, totalHeight = 0, itemWidth = 0, totalWidth = 0, uid = 0;
+    int itemHeight = 0, totalHeight = 0, itemWidth = 0, totalWidth = 0, numRows = 1, indexInParent = -1, uid = 0;
     bool selected = false, redrawNeeded = true, drawLinesInside = false, drawLinesSet = false,
-         drawsInLeftMargin = false, drawsInRightMargin = false;
+         drawsInLeftMargin = false, drawsInRightMargin = false, layoutNeedsUpdate = true, subItemsChanged = true;
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TreeViewItem)
@@ -657,6 +666,12 @@ private:
 
     Use one of these to hold and display a structure of TreeViewItem objects.
 
+    The tree keeps a running total of the heights and row counts of each item's sub-items,
+    so opening, closing, adding or removing an item only needs to lay out that item and
+    its parents again, and scrolling only visits the items that are on-screen. For very
+    large trees, create each item's sub-items when it's opened, in
+    TreeViewItem::itemOpennessChanged(), so that closed branches don't need any items at all.
+
     @tags{GUI}
 */
 class JUCE_API  TreeView  : public Component,
@@ -946,6 +961,8 @@ private:
 
     void itemsChanged() noexcept;
     void updateVisibleItems (std::optional<Point<int>> viewportPosition = {});
+    void updateAllItemLayouts (std::optional<Point<int>> viewportPosition = {});
+    bool isLayoutUpToDate() const noexcept;
     void updateButtonUnderMouse (const MouseEvent&);
     void showDragHighlight (const InsertPoint&) noexcept;
     void hideDragHighlight() noexcept;
@@ -960,8 +977,9 @@ private:
     TreeViewItem* rootItem = nullptr;
     std::unique_ptr<InsertPointHighlight> dragInsertPointHighlight;
     std::unique_ptr<TargetGroupHighlight> dragTargetGroupHighlight;
-    int indentSize = -1;
-    bool defaultOpenness = false, rootItemVisible = true, multiSelectEnabled = false, openCloseButtonsVisible = true;
+    int indentSize = -1, lastLayoutIndentSize = -1;
+    bool defaultOpenness = false, rootItemVisible = true, multiSelectEnabled = false, openCloseButtonsVisible = true,
+         needsFullLayout = true;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TreeView)
 };
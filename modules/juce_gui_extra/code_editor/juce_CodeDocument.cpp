@@ -130,6 +130,8 @@ public:
     }
 
     String line;
+
+    // N.B. lineStartInFile is only up-to-date for lines below CodeDocument::numValidLineStarts
     int lineStartInFile, lineLength, lineLengthWithoutNewLines;
 };
 
@@ -423,7 +425,7 @@ void CodeDocument::Position::setLineAndIndex (const int newLineNum, const int ne
 
             auto& l = *owner->lines.getUnchecked (line);
             indexInLine = l.lineLengthWithoutNewLines;
-            characterPos = l.lineStartInFile + indexInLine;
+            characterPos = owner->getLineStart (line) + indexInLine;
         }
         else
         {
@@ -436,7 +438,7 @@ void CodeDocument::Position::setLineAndIndex (const int newLineNum, const int ne
             else
                 indexInLine = 0;
 
-            characterPos = l.lineStartInFile + indexInLine;
+            characterPos = owner->getLineStart (line) + indexInLine;
         }
     }
 }
@@ -449,40 +451,14 @@ void CodeDocument::Position::setPosition (const int newPosition)
     indexInLine = 0;
     characterPos = 0;
 
-    if (newPosition > 0)
+    if (newPosition > 0 && owner->lines.size() > 0)
     {
-        int lineStart = 0;
-        auto lineEnd = owner->lines.size();
-
-        for (;;)
-        {
-            if (lineEnd - lineStart < 4)
-            {
-                for (int i = lineStart; i < lineEnd; ++i)
-                {
-                    auto& l = *owner->lines.getUnchecked (i);
-                    auto index = newPosition - l.lineStartInFile;
+        line = owner->findLineContainingCharacter (newPosition);
 
-                    if (index >= 0 && (index < l.lineLength || i == lineEnd - 1))
-                    {
-                        line = i;
-                        indexInLine = jmin (l.lineLengthWithoutNewLines, index);
-                        characterPos = l.lineStartInFile + indexInLine;
-                    }
-                }
-
-                break;
-            }
-            else
-            {
-                auto midIndex = (lineStart + lineEnd + 1) / 2;
-
-                if (newPosition >= owner->lines.getUnchecked (midIndex)->lineStartInFile)
-                    lineStart = midIndex;
-                else
-                    lineEnd = midIndex;
-            }
-        }
+        auto& l = *owner->lines.getUnchecked (line);
+        auto lineStart = owner->getLineStart (line);
+        indexInLine = jmin (l.lineLengthWithoutNewLines, newPosition - lineStart);
+        characterPos = lineStart + indexInLine;
     }
 }
 
@@ -623,10 +599,7 @@ String CodeDocument::getTextBetween (const Position& start, const Position& end)
 
 int CodeDocument::getNumCharacters() const noexcept
 {
-    if (auto* lastLine = lines.getLast())
-        return lastLine->lineStartInFile + lastLine->lineLength;
-
-    return 0;
+    return totalCharacters;
 }
 
 String CodeDocument::getLine (const int lineIndex) const noexcept
@@ -873,14 +846,76 @@ void CodeDocument::checkLastLineStatus()
         lines.removeLast();
     }
 
+    invalidateLineStartsFrom (lines.size());
+
     const CodeDocumentLine* const lastLine = lines.getLast();
 
     if (lastLine != nullptr && lastLine->endsWithLineBreak())
     {
         // check that there's an empty line at the end if the preceding one ends in a newline
-        lines.add (new CodeDocumentLine (StringRef(), StringRef(), 0, 0,
-                                         lastLine->lineStartInFile + lastLine->lineLength));
+        lines.add (new CodeDocumentLine (StringRef(), StringRef(), 0, 0, 0));
+    }
+}
+
+//==============================================================================
+// Rather than moving the start of every following line along after each edit, the
+// starts are only recalculated when they're next needed, and only as far as the line
+// that's asked for, so an edit costs the same near the end of a huge document as
+// it does near the start.
+int CodeDocument::getLineStart (const int lineIndex) const noexcept
+{
+    jassert (isPositiveAndBelow (lineIndex, lines.size()));
+
+    if (lineIndex >= numValidLineStarts)
+    {
+        int start = 0;
+
+        if (numValidLineStarts > 0)
+        {
+            auto& previous = *lines.getUnchecked (numValidLineStarts - 1);
+            start = previous.lineStartInFile + previous.lineLength;
+        }
+
+        for (int i = numValidLineStarts; i <= lineIndex; ++i)
+        {
+            auto& l = *lines.getUnchecked (i);
+            l.lineStartInFile = start;
+            start += l.lineLength;
+        }
+
+        numValidLineStarts = lineIndex + 1;
+    }
+
+    return lines.getUnchecked (lineIndex)->lineStartInFile;
+}
+
+int CodeDocument::findLineContainingCharacter (const int characterPos) const noexcept
+{
+    jassert (! lines.isEmpty());
+
+    while (numValidLineStarts < lines.size())
+    {
+        if (numValidLineStarts > 0)
+        {
+            auto& last = *lines.getUnchecked (numValidLineStarts - 1);
+
+            if (last.lineStartInFile + last.lineLength > characterPos)
+                break;
+        }
+
+        getLineStart (numValidLineStarts);
     }
+
+    auto* first = lines.begin();
+    auto* found = std::upper_bound (first, first + numValidLineStarts, characterPos,
+                                    [] (int pos, const CodeDocumentLine* l) { return pos < l->lineStartInFile; });
+
+    return jmax (0, (int) (found - first) - 1);
+}
+
+void CodeDocument::invalidateLineStartsFrom (const int lineIndex) noexcept
+{
+    numValidLineStarts = jmin (numValidLineStarts, jmax (0, lineIndex));
 }
 
 //==============================================================================
@@ -942,29 +977,27 @@ void CodeDocument::insert (const String& text, const int insertPos, const bool u
                                          + firstLine->line.substring (index);
             }
 
-            maximumLineLength = -1;
             Array<CodeDocumentLine*> newLines;
             CodeDocumentLine::createLines (newLines, textInsideOriginalLine);
             jassert (newLines.size() > 0);
 
+            if (firstLine != nullptr && firstLine->lineLength >= maximumLineLength)
+                maximumLineLength = -1;
+            else if (maximumLineLength >= 0)
+                for (auto* l : newLines)
+                    maximumLineLength = jmax (maximumLineLength, l->lineLength);
+
             auto* newFirstLine = newLines.getUnchecked (0);
-            newFirstLine->lineStartInFile = firstLine != nullptr ? firstLine->lineStartInFile : 0;
+            newFirstLine->lineStartInFile = pos.getPosition() - pos.getIndexInLine();
             lines.set (firstAffectedLine, newFirstLine);
 
             if (newLines.size() > 1)
                 lines.insertArray (firstAffectedLine + 1, newLines.getRawDataPointer() + 1, newLines.size() - 1);
 
-            int lineStart = newFirstLine->lineStartInFile;
-
-            for (int i = firstAffectedLine; i < lines.size(); ++i)
-            {
-                auto& l = *lines.getUnchecked (i);
-                l.lineStartInFile = lineStart;
-                lineStart += l.lineLength;
-            }
-
-            checkLastLineStatus();
             auto newTextLength = text.length();
+            totalCharacters += newTextLength;
+            invalidateLineStartsFrom (firstAffectedLine + 1);
+            checkLastLineStatus();
 
             for (auto* p : positionsToMaintain)
                 if (p->getPosition() >= insertPos)
@@ -1022,11 +1055,14 @@ void CodeDocument::remove (const int startPos, const int endPos, const bool undo
         Position startPosition (*this, startPos);
         Position endPosition (*this, endPos);
 
-        maximumLineLength = -1;
         auto firstAffectedLine = startPosition.getLineNumber();
         auto endLine = endPosition.getLineNumber();
         auto& firstLine = *lines.getUnchecked (firstAffectedLine);
 
+        for (int i = firstAffectedLine; i <= endLine && maximumLineLength >= 0; ++i)
+            if (lines.getUnchecked (i)->lineLength >= maximumLineLength)
+                maximumLineLength = -1;
+
         if (firstAffectedLine == endLine)
         {
             firstLine.line = firstLine.line.substring (0, startPosition.getIndexInLine())
@@ -1045,13 +1081,8 @@ void CodeDocument::remove (const int startPos, const int endPos, const bool undo
             lines.removeRange (firstAffectedLine + 1, numLinesToRemove);
         }
 
-        for (int i = firstAffectedLine + 1; i < lines.size(); ++i)
-        {
-            auto& l = *lines.getUnchecked (i);
-            auto& previousLine = *lines.getUnchecked (i - 1);
-            l.lineStartInFile = previousLine.lineStartInFile + previousLine.lineLength;
-        }
-
+        totalCharacters -= endPosition.getPosition() - startPosition.getPosition();
+        invalidateLineStartsFrom (firstAffectedLine + 1);
         checkLastLineStatus();
         auto totalChars = getNumCharacters();
 
@@ -1296,11 +1327,133 @@ struct CodeDocumentTest final : public UnitTest
                 expectEquals (p3.getIndexInLine(), d.getLine (d.getNumLines() - 1).length(), comment3);
             }
         }
+
+        {
+            beginTest ("Line positions after random edits");
+
+            auto r = getRandom();
+            const StringArray fragments { "a", "bc", "\n", "\r\n", "def\n", "\n\n", "ghijklmnop", "q\r\nrs" };
+
+            CodeDocument d;
+            String expected;
+
+            for (int i = 0; i < 2000; ++i)
+            {
+                auto numChars = expected.length();
+
+                if (numChars > 0 && r.nextInt (3) == 0)
+                {
+                    auto start = r.nextInt (numChars);
+                    auto end = jmin (numChars, start + r.nextInt (20) + 1);
+
+                    // Positions can't lie between a \r and \n, so neither can the ends of a deletion
+                    if (CodeDocument::Position (d, start).getPosition() != start
+                         || CodeDocument::Position (d, end).getPosition() != end)
+                        continue;
+
+                    d.deleteSection (start, end);
+                    expected = expected.substring (0, start) + expected.substring (end);
+                }
+                else
+                {
+                    auto pos = CodeDocument::Position (d, r.nextInt (numChars + 1)).getPosition();
+                    auto text = fragments[r.nextInt (fragments.size())];
+                    d.insertText (pos, text);
+                    expected = expected.substring (0, pos) + text + expected.substring (pos);
+                }
+
+                if (i % 50 != 0)
+                    continue;
+
+                expectEquals (d.getNumCharacters(), expected.length());
+                expectEquals (d.getAllContent(), expected);
+
+                int lineStart = 0, longestLine = 0;
+
+                for (int line = 0; line < d.getNumLines(); ++line)
+                {
+                    const CodeDocument::Position p (d, line, 0);
+                    expectEquals (p.getPosition(), lineStart);
+
+                    const CodeDocument::Position q (d, lineStart);
+                    expectEquals (q.getLineNumber(), line);
+                    expectEquals (q.getIndexInLine(), 0);
+
+                    auto length = d.getLine (line).length();
+                    longestLine = jmax (longestLine, length);
+                    lineStart += length;
+                }
+
+                expectEquals (d.getMaximumLineLength(), longestLine);
+            }
+        }
     }
 };
 
 static CodeDocumentTest codeDocumentTests;
 
+//==============================================================================
+class CodeDocumentBenchmarks final : public UnitTest
+{
+public:
+    CodeDocumentBenchmarks()
+        : UnitTest ("CodeDocument benchmarks", UnitTestCategories::benchmarks)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Edit a large document");
+
+        constexpr int numLines = 200000;
+        constexpr int numEdits = 1000;
+
+        String content;
+
+        {
+            MemoryOutputStream mo;
+
+            for (int i = 0; i < numLines; ++i)
+                mo << "    auto value" << i << " = someFunction (argument" << i << ", 1.0f); // comment\n";
+
+            content = mo.toString();
+        }
+
+        CodeDocument d;
+        d.replaceAllContent (content);
+
+        CodeDocument::Position caret (d, 10, 4);
+        caret.setPositionMaintained (true);
+
+        const auto typeText = [&] (const char* label)
+        {
+            auto start = Time::getMillisecondCounterHiRes();
+
+            for (int i = 0; i < numEdits; ++i)
+            {
+                d.insertText (caret, i % 40 == 39 ? "\n" : "x");
+                CodeDocument::Position onScreen (d, caret.getLineNumber() + 30, 0);
+                ignoreUnused (onScreen.getPosition(), d.getNumCharacters());
+            }
+
+            auto elapsed = Time::getMillisecondCounterHiRes() - start;
+            logMessage (String (label) + ": " + String (elapsed * 1000.0 / numEdits, 2) + " us per keystroke in a "
+                          + String (d.getNumCharacters() / (1024 * 1024)) + " MB document");
+        };
+
+        typeText ("Typing near the start");
+
+        caret.setLineAndIndex (numLines / 2, 4);
+        typeText ("Typing in the middle");
+
+        caret.setLineAndIndex (numLines - 10, 4);
+        typeText ("Typing near the end");
+
+        expectEquals (d.getNumCharacters(), content.length() + 3 * numEdits);
+    }
+};
+
+static CodeDocumentBenchmarks codeDocumentBenchmarks;
+
 #endif
 
 } // namespace juce
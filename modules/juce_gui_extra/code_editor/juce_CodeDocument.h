@@ -445,13 +445,17 @@ private:
     Array<Position*> positionsToMaintain;
     UndoManager undoManager;
     int currentActionIndex = 0, indexOfSavedState = -1;
-    int maximumLineLength = -1;
+    int maximumLineLength = -1, totalCharacters = 0;
+    mutable int numValidLineStarts = 0;
     ListenerList<Listener> listeners;
     String newLineChars { "\r\n" };
 
     void insert (const String& text, int insertPos, bool undoable);
     void remove (int startPos, int endPos, bool undoable);
     void checkLastLineStatus();
+    int getLineStart (int lineIndex) const noexcept;
+    int findLineContainingCharacter (int characterPos) const noexcept;
+    void invalidateLineStartsFrom (int lineIndex) noexcept;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CodeDocument)
 };